@@ -507,8 +507,65 @@ static int fetch(av_input *avin, int *limit, int *skip) {
   }
 }
 
+typedef struct twopass_file twopass_file;
+
+/*The two-pass metrics file and any data read from it that the encoder has
+   not consumed yet.*/
+struct twopass_file {
+  /*0 for a one-pass encode, otherwise the current pass (1 or 2).*/
+  int passno;
+  FILE *file;
+  unsigned char buf[80];
+  int buf_pos;
+  int buf_fill;
+};
+
+/*Writes out whatever first-pass data the encoder has produced.*/
+static void twopass_out(twopass_file *tp, daala_enc_ctx *dd) {
+  unsigned char *buf;
+  int bytes;
+  bytes = daala_encode_ctl(dd, OD_2PASS_OUT, &buf, sizeof(buf));
+  if (bytes < 0) {
+    fprintf(stderr, "Could not retrieve first-pass data from encoder.\n");
+    exit(1);
+  }
+  if (fwrite(buf, 1, bytes, tp->file) < (size_t)bytes) {
+    fprintf(stderr, "Could not write to the first-pass data file.\n");
+    exit(1);
+  }
+}
+
+/*Feeds the encoder all the first-pass data it needs before the next frame.*/
+static void twopass_in(twopass_file *tp, daala_enc_ctx *dd) {
+  for (;;) {
+    int bytes;
+    if (tp->buf_pos >= tp->buf_fill) {
+      bytes = daala_encode_ctl(dd, OD_2PASS_IN, NULL, 0);
+      if (bytes < 0) {
+        fprintf(stderr, "Error submitting first-pass data to encoder.\n");
+        exit(1);
+      }
+      if (bytes == 0) break;
+      if (bytes > (int)sizeof(tp->buf)) bytes = (int)sizeof(tp->buf);
+      tp->buf_fill = (int)fread(tp->buf, 1, bytes, tp->file);
+      tp->buf_pos = 0;
+      /*If the file ends early, the encoder makes do without the data.*/
+      if (tp->buf_fill <= 0) break;
+    }
+    bytes = daala_encode_ctl(dd, OD_2PASS_IN, tp->buf + tp->buf_pos,
+     tp->buf_fill - tp->buf_pos);
+    if (bytes < 0) {
+      fprintf(stderr, "Error submitting first-pass data to encoder.\n");
+      exit(1);
+    }
+    if (bytes == 0) break;
+    tp->buf_pos += bytes;
+  }
+}
+
 int fetch_and_process_video(av_input *avin, ogg_page *page,
- ogg_stream_state *vo, daala_enc_ctx *dd, int *limit, int *skip) {
+ ogg_stream_state *vo, daala_enc_ctx *dd, twopass_file *tp, int *limit,
+ int *skip) {
   for (;;) {
     int end_of_input;
     daala_packet dp;
@@ -519,8 +576,11 @@ int fetch_and_process_video(av_input *avin, ogg_page *page,
       return 0;
     }
     end_of_input = fetch(avin, limit, skip);
-    while (daala_encode_packet_out(dd, end_of_input, &dp)) {
+    for (;;) {
       ogg_packet op;
+      if (tp->passno == 2) twopass_in(tp, dd);
+      if (!daala_encode_packet_out(dd, end_of_input, &dp)) break;
+      if (tp->passno == 1) twopass_out(tp, dd);
       daala_to_ogg_packet(&op, &dp);
       ogg_stream_packetin(vo, &op);
     }
@@ -533,7 +593,7 @@ int fetch_and_process_video(av_input *avin, ogg_page *page,
   }
 }
 
-static const char *OPTSTRING = "ho:k:b:v:V:s:S:l:z:d:";
+static const char *OPTSTRING = "ho:k:b:v:V:s:S:l:z:d:t:";
 
 static const struct option OPTIONS[] = {
   { "help", no_argument, NULL, 'h' },
@@ -547,7 +607,10 @@ static const struct option OPTIONS[] = {
   { "skip", required_argument, NULL, 'S' },
   { "limit", required_argument, NULL, 'l' },
   { "complexity", required_argument, NULL, 'z' },
+  { "threads", required_argument, NULL, 't' },
   { "soft-target",no_argument,NULL,0},
+  { "first-pass", required_argument, NULL, 0 },
+  { "second-pass", required_argument, NULL, 0 },
   { "mc-use-chroma", no_argument, NULL, 0 },
   { "no-mc-use-chroma", no_argument, NULL, 0 },
   { "mc-use-satd", no_argument, NULL, 0 },
@@ -556,12 +619,16 @@ static const struct option OPTIONS[] = {
   { "no-activity-masking", no_argument, NULL, 0 },
   { "dering", no_argument, NULL, 0 },
   { "no-dering", no_argument, NULL, 0 },
+  { "parallel-rdo", no_argument, NULL, 0 },
+  { "no-parallel-rdo", no_argument, NULL, 0 },
   { "fpr", no_argument, NULL, 0 },
   { "no-fpr", no_argument, NULL, 0 },
   { "qm", required_argument, NULL, 0 },
   { "mv-res-min", required_argument, NULL, 0 },
   { "mv-level-min", required_argument, NULL, 0 },
   { "mv-level-max", required_argument, NULL, 0 },
+  { "tile-cols-log2", required_argument, NULL, 0 },
+  { "tile-rows-log2", required_argument, NULL, 0 },
   { "version", no_argument, NULL, 0},
   { NULL, 0, NULL, 0 }
 };
@@ -604,12 +671,23 @@ static void usage(void) {
    "                                 target also allows an optional -v\n"
    "                                 setting to specify a minimum allowed\n"
    "                                 quality.\n\n"
+   "     --first-pass <filename>     Perform the first pass of a two-pass\n"
+   "                                 rate-controlled encode, saving the\n"
+   "                                 statistics to the given file.\n"
+   "                                 Requires -V. The output of this pass\n"
+   "                                 can be discarded; it runs at\n"
+   "                                 complexity 2 unless -z is given.\n\n"
+   "     --second-pass <filename>    Perform the second pass of a two-pass\n"
+   "                                 rate-controlled encode, reading the\n"
+   "                                 statistics from the given file.\n"
+   "                                 Requires -V.\n\n"
    "  -s --serial <n>                Specify a serial number for the stream.\n"
    "  -S --skip <n>                  Number of input frames to skip before\n"
    "                                 encoding.\n\n"
    "  -l --limit <n>                 Maximum number of frames to encode.\n"
    "  -z --complexity <n>            Computational complexity: 0...10\n"
    "                                 Fastest: 0, slowest: 10, default: 7\n"
+   "  -t --threads <n>               Number of threads: 1...64, default: 1\n"
    "     --[no-]mc-use-chroma        Control whether the chroma planes should\n"
    "                                 be used in the motion compensation search.\n"
    "                                 --mc-use-chroma is implied by default.\n"
@@ -621,6 +699,10 @@ static void usage(void) {
    "                                 --activity-masking is implied by default.\n"
    "     --[no-]dering               Enable (default) or disable the dering\n"
    "                                 postprocessing filter.\n"
+   "     --[no-]parallel-rdo         Disable (default) or enable deciding\n"
+   "                                 block sizes for each superblock\n"
+   "                                 independently, so that the threads can\n"
+   "                                 share the work.\n"
    "     --[no-]fpr                  Disable (default) or enable full \n"
    "                                 precision references.\n"
    "     --qm <n>                    Select quantization matrix\n"
@@ -633,6 +715,10 @@ static void usage(void) {
    "                                 0 (default) and 6.\n"
    "     --mv-level-max <n>          Maximum motion vectors level between\n"
    "                                 0 and 6 (default).\n"
+   "     --tile-cols-log2 <n>        Split frames into 2^n independently\n"
+   "                                 coded tile columns: 0 (default)...3.\n"
+   "     --tile-rows-log2 <n>        Split frames into 2^n independently\n"
+   "                                 coded tile rows: 0 (default)...3.\n"
    "     --version                   Displays version information.\n"
    " encoder_example accepts only uncompressed YUV4MPEG2 video.\n\n");
   exit(1);
@@ -662,6 +748,8 @@ int main(int argc, char **argv) {
   double video_kbps;
   int soft_target;
   int buf_delay;
+  twopass_file twopass;
+  const char *twopass_filename;
   int video_q;
   long video_r;
   int video_keyframe_rate;
@@ -670,16 +758,20 @@ int main(int argc, char **argv) {
   int skip;
   int limit;
   int complexity;
+  int threads;
   int interactive;
   int mc_use_chroma;
   int mc_use_satd;
   int use_activity_masking;
   int use_dering;
+  int parallel_rdo;
   int use_fpr;
   int qm;
   int mv_res_min;
   int mv_level_min;
   int mv_level_max;
+  int tile_cols_log2;
+  int tile_rows_log2;
   int current_frame_no;
   int output_provided;
   int b_frames;
@@ -705,21 +797,27 @@ int main(int argc, char **argv) {
   video_r = -1;
   buf_delay = -1;
   soft_target = 0;
+  memset(&twopass, 0, sizeof(twopass));
+  twopass_filename = NULL;
   video_keyframe_rate = 256;
   video_bytesout = 0;
   fixedserial = 0;
   skip = 0;
   limit = -1;
-  complexity = 7;
+  complexity = -1;
+  threads = 1;
   mc_use_chroma = 1;
   mc_use_satd = 1;
   use_activity_masking = 1;
   use_dering = 1;
+  parallel_rdo = 0;
   use_fpr = 0;
   qm = 1;
   mv_res_min = 0;
   mv_level_min = 0;
   mv_level_max = 6;
+  tile_cols_log2 = 0;
+  tile_rows_log2 = 0;
   output_provided = 0;
   b_frames = 0;
   while ((c = getopt_long(argc, argv, OPTSTRING, OPTIONS, &loi)) != EOF) {
@@ -811,10 +909,31 @@ int main(int argc, char **argv) {
         }
         break;
       }
+      case 't': {
+        threads = atoi(optarg);
+        if (threads < 1 || threads > 64) {
+          fprintf(stderr,
+           "Illegal number of threads (must be 1...64, inclusive)\n");
+          exit(1);
+        }
+        break;
+      }
       case 0: {
         if (strcmp(OPTIONS[loi].name, "soft-target") == 0) {
           soft_target = 1;
         }
+        else if (strcmp(OPTIONS[loi].name, "first-pass") == 0
+         || strcmp(OPTIONS[loi].name, "second-pass") == 0) {
+          int passno;
+          passno = strcmp(OPTIONS[loi].name, "first-pass") == 0 ? 1 : 2;
+          if (twopass.passno != 0 && twopass.passno != passno) {
+            fprintf(stderr,
+             "Only one of --first-pass or --second-pass may be given.\n");
+            exit(1);
+          }
+          twopass.passno = passno;
+          twopass_filename = optarg;
+        }
         else if (strcmp(OPTIONS[loi].name, "mc-use-chroma") == 0) {
           mc_use_chroma = 1;
         }
@@ -839,6 +958,12 @@ int main(int argc, char **argv) {
         else if (strcmp(OPTIONS[loi].name, "no-dering") == 0) {
           use_dering = 0;
         }
+        else if (strcmp(OPTIONS[loi].name, "parallel-rdo") == 0) {
+          parallel_rdo = 1;
+        }
+        else if (strcmp(OPTIONS[loi].name, "no-parallel-rdo") == 0) {
+          parallel_rdo = 0;
+        }
         else if (strcmp(OPTIONS[loi].name, "fpr") == 0) {
           use_fpr = 1;
         }
@@ -883,6 +1008,20 @@ int main(int argc, char **argv) {
             exit(1);
           }
         }
+        else if (strcmp(OPTIONS[loi].name, "tile-cols-log2") == 0) {
+          tile_cols_log2 = atoi(optarg);
+          if (tile_cols_log2 < 0 || tile_cols_log2 > 3) {
+            fprintf(stderr, "Illegal value for --tile-cols-log2\n");
+            exit(1);
+          }
+        }
+        else if (strcmp(OPTIONS[loi].name, "tile-rows-log2") == 0) {
+          tile_rows_log2 = atoi(optarg);
+          if (tile_rows_log2 < 0 || tile_rows_log2 > 3) {
+            fprintf(stderr, "Illegal value for --tile-rows-log2\n");
+            exit(1);
+          }
+        }
         else if (strcmp(OPTIONS[loi].name, "version") == 0) {
           version();
         }
@@ -899,6 +1038,24 @@ int main(int argc, char **argv) {
       exit(1);
     }
   }
+  if (twopass.passno) {
+    if (video_r <= 0) {
+      fprintf(stderr,
+       "Two-pass encoding requested without a bitrate (-V).\n");
+      exit(1);
+    }
+    twopass.file = fopen(twopass_filename, twopass.passno == 1 ? "wb" : "rb");
+    if (twopass.file == NULL) {
+      fprintf(stderr, "Unable to open two-pass data file '%s'.\n",
+       twopass_filename);
+      exit(1);
+    }
+  }
+  if (complexity < 0) {
+    /*The first pass only needs the statistics, not good compression, so run
+       it fast by default.*/
+    complexity = twopass.passno == 1 ? 2 : 7;
+  }
   if (video_q == -1) {
     if (video_r > 0) {
       /*Rate control uses -v as a minimum quality below which the
@@ -970,6 +1127,8 @@ int main(int argc, char **argv) {
   memcpy(di.plane_info, avin.video_plane_info,
    di.nplanes*sizeof(*di.plane_info));
   di.keyframe_rate = video_keyframe_rate;
+  di.tile_cols_log2 = tile_cols_log2;
+  di.tile_rows_log2 = tile_rows_log2;
   /*TODO: Other crap.*/
   dd = daala_encode_create(&di);
   if (!dd) {
@@ -981,6 +1140,9 @@ int main(int argc, char **argv) {
   /*Set up encoder.*/
   daala_encode_ctl(dd, OD_SET_QUANT, &video_q, sizeof(video_q));
   daala_encode_ctl(dd, OD_SET_COMPLEXITY, &complexity, sizeof(complexity));
+  if (daala_encode_ctl(dd, OD_SET_THREADS, &threads, sizeof(threads))) {
+    fprintf(stderr, "Unable to start %i encoder threads.\n", threads);
+  }
   daala_encode_ctl(dd, OD_SET_MC_CHROMA, &mc_use_chroma,
    sizeof(mc_use_chroma));
   daala_encode_ctl(dd, OD_SET_MC_SATD, &mc_use_satd,
@@ -989,6 +1151,8 @@ int main(int argc, char **argv) {
    sizeof(use_activity_masking));
   daala_encode_ctl(dd, OD_SET_DERING, &use_dering,
    sizeof(use_dering));
+  daala_encode_ctl(dd, OD_SET_PARALLEL_RDO, &parallel_rdo,
+   sizeof(parallel_rdo));
   daala_encode_ctl(dd, OD_SET_MV_RES_MIN, &mv_res_min, sizeof(mv_res_min));
   daala_encode_ctl(dd, OD_SET_QM, &qm, sizeof(qm));
   daala_encode_ctl(dd, OD_SET_MV_LEVEL_MIN, &mv_level_min, sizeof(mv_level_min));
@@ -1006,6 +1170,15 @@ int main(int argc, char **argv) {
       exit(1);
     }
   }
+  if (twopass.passno == 1) {
+    /*Write a placeholder for the summary, which we fill in at the end.*/
+    twopass_out(&twopass, dd);
+  }
+  else if (twopass.passno == 2) {
+    /*Read the summary now, so that it picks the default buffer size before
+       any we set below.*/
+    twopass_in(&twopass, dd);
+  }
   if (soft_target) {
     /*Reverse the default rate control flags to favor a 'long time' strategy.*/
     int arg = OD_RATECTL_CAP_UNDERFLOW;
@@ -1014,7 +1187,8 @@ int main(int argc, char **argv) {
       fprintf(stderr,"Could not set encoder flags for --soft-target\n");
       exit(1);
     }
-    if (buf_delay < 0) {
+    /*In the second pass, keep the whole-file default buffer.*/
+    if (buf_delay < 0 && twopass.passno != 2) {
       if ((video_keyframe_rate*7 >> 1) > 5*avin.video_fps_n/avin.video_fps_d) {
         arg = video_keyframe_rate*7 >> 1;
       }
@@ -1096,7 +1270,7 @@ int main(int argc, char **argv) {
     double video_fps = avin.video_fps_n/avin.video_fps_d;
     size_t bytes_written;
     /*If no more pages are available, we've hit the end of the stream.*/
-    if (!fetch_and_process_video(&avin, &video_page, &vo, dd,
+    if (!fetch_and_process_video(&avin, &video_page, &vo, dd, &twopass,
      limit > -1 ? &limit : NULL, skip > 0 ? &skip : NULL)) {
       break;
     }
@@ -1134,6 +1308,15 @@ int main(int argc, char **argv) {
      (current_frame_no)/time_spent,
      (current_frame_no)/time_spent*60);
   }
+  if (twopass.passno == 1) {
+    /*Go back and replace the placeholder with the real summary.*/
+    if (fseek(twopass.file, 0, SEEK_SET) < 0) {
+      fprintf(stderr, "Unable to seek in the first-pass data file.\n");
+      exit(1);
+    }
+    twopass_out(&twopass, dd);
+  }
+  if (twopass.file != NULL) fclose(twopass.file);
   ogg_stream_clear(&vo);
   daala_encode_free(dd);
   daala_comment_clear(&dc);
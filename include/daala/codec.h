@@ -232,6 +232,13 @@ struct daala_info {
    /** key frame rate defined how often a key frame is emitted by encoder in
     * number of frames. So 10 means every 10th frame is a keyframe.  */
   int keyframe_rate;
+  /** Each frame is split into a grid of (1 << tile_cols_log2) by
+   *  (1 << tile_rows_log2) tiles of superblocks.
+   *  Every tile has its own entropy coder and adaptation state, and never
+   *  predicts from its neighbors, so tiles can be coded in parallel.
+   *  Both default to 0 (one tile per frame) and may be at most 3. */
+  int tile_cols_log2;
+  int tile_rows_log2;
 };
 
 typedef struct {
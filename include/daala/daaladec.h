@@ -46,6 +46,35 @@ extern "C" {
 #define OD_DECCTL_GET_ACCOUNTING   (7009)
 #define OD_DECCTL_SET_ACCOUNTING_ENABLED (7011)
 #define OD_DECCTL_SET_DERING_BUFFER (7013)
+/** Set the number of threads used by the decoder, including the calling
+ *  thread.
+ * With more than one thread, each frame is finished on the worker threads
+ *  while the next packet is decoded, and daala_decode_img_out() only waits
+ *  for it when no other frame is ready.
+ * Calling daala_decode_img_out() once after each packet, rather than until
+ *  it returns 0, lets consecutive frames overlap.
+ * \param[in]  <tt>int</tt>: The number of threads, from 1 (the default) to
+ *              64. The decoded images do not depend on this setting. */
+#define OD_DECCTL_SET_THREADS      (7015)
+/** Decode into frame buffers supplied by the application instead of the
+ *  decoder's own.
+ * Without full precision references, frames are reconstructed directly into
+ *  these buffers and daala_decode_img_out() returns them without copying.
+ * With full precision references, the buffers only hold the output images,
+ *  which are converted straight into them; the references themselves stay
+ *  in the decoder's own memory.
+ * This must be set before the first call to daala_decode_packet_in().
+ * \param[in]  <tt>#daala_frame_buffer_funcs*</tt>: The callbacks, which are
+ *              copied, or <tt>NULL</tt> to use the decoder's own buffers. */
+#define OD_DECCTL_SET_FRAME_BUFFER_FUNCS (7017)
+/** Extend the borders of the reference frames only where the motion vectors
+ *  of later frames reach, instead of all of them as each frame is decoded.
+ * This saves time on static or low-motion content.
+ * It must be set before the first call to daala_decode_packet_in(), and does
+ *  not change the decoded images.
+ * \param[in]  <tt>int</tt>: Non-zero to extend the borders lazily, or 0 (the
+ *              default) to extend all of them. */
+#define OD_DECCTL_SET_LAZY_EDGE_EXT (7019)
 
 
 #define OD_ACCT_FRAME (10)
@@ -90,6 +119,47 @@ typedef struct {
 } od_accounting;
 
 
+/**A frame buffer owned by the application.*/
+typedef struct daala_frame_buffer {
+  /**The image stored in the buffer.
+   * Before calling the get_buffer callback, the decoder fills in everything
+   *  except the data pointer and ystride of each plane, which the callback
+   *  must set.
+   * Each data pointer must point at the top-left pixel of its plane, with at
+   *  least <tt>border >> xdec</tt> pixels of accessible memory to the left
+   *  and right of every row, and <tt>border >> ydec</tt> rows above and
+   *  below the plane.
+   * Data pointers and ystrides must be multiples of 32 bytes.*/
+  daala_image img;
+  /**The number of pixels of padding needed around an unsubsampled plane.*/
+  int border;
+  /**For the application's use; the decoder never touches it.*/
+  void *priv;
+} daala_frame_buffer;
+
+/**Called by the decoder when it needs a new frame buffer.
+ * \param ctx The <tt>ctx</tt> member of #daala_frame_buffer_funcs.
+ * \param fb  The buffer to fill in.
+ * \return 0 on success, or a negative value if no buffer is available, in
+ *          which case daala_decode_packet_in() fails with #OD_EFAULT.*/
+typedef int (*daala_get_buffer_func)(void *ctx, daala_frame_buffer *fb);
+/**Called by the decoder once it no longer reads or writes a buffer obtained
+ *  from the get_buffer callback.
+ * This happens no earlier than the next call to daala_decode_img_out() after
+ *  the buffer's image was returned, if it was, but the application may
+ *  still be displaying that image and must not hand the buffer out again
+ *  until it is done with it.
+ * \param ctx The <tt>ctx</tt> member of #daala_frame_buffer_funcs.
+ * \param fb  The buffer, as filled in by the get_buffer callback.*/
+typedef void (*daala_release_buffer_func)(void *ctx, daala_frame_buffer *fb);
+
+/**The frame buffer pool set with #OD_DECCTL_SET_FRAME_BUFFER_FUNCS.*/
+typedef struct daala_frame_buffer_funcs {
+  daala_get_buffer_func get_buffer;
+  daala_release_buffer_func release_buffer;
+  void *ctx;
+} daala_frame_buffer_funcs;
+
 /**\name Decoder state
    The following data structures are opaque, and their contents are not
     publicly defined by this API.
@@ -284,9 +284,12 @@ void daala_encode_free(daala_enc_ctx *enc);
  *  placeholder content, and sets the encoder into pass 1 mode implicitly.
  * This call sets the encoder to pass 1 mode implicitly.
  * Then, a subsequent call must be made after each call to
- *  daala_encode_img_in() to retrieve the metrics for that frame.
- * An additional, final call must be made to retrieve the summary data,
- *  containing such information as the total number of frames, etc.
+ *  daala_encode_packet_out() that returns a packet to retrieve the metrics for
+ *  the frame it encoded.
+ * An additional, final call must be made once daala_encode_packet_out() has
+ *  been told the stream is over and has returned every packet, to retrieve
+ *  the summary data, containing such information as the total number of
+ *  frames, etc.
  * This must be stored in place of the placeholder data that was returned
  *  in the first call, before the frame metrics data.
  * All of this data must be presented back to the encoder during pass 2 using
@@ -351,6 +354,30 @@ void daala_encode_free(daala_enc_ctx *enc);
  *                        data.
  * \retval OD_EIMPL       Not supported by this implementation.*/
 #define OD_2PASS_IN 4120
+/**Sets the number of threads used by the encoder, including the calling
+ *  thread.
+ * The encoded stream does not depend on this setting.
+ * \param[in] buf <tt>int</tt>: The number of threads.
+ *                 Values must lie in the range 1...64, inclusive.
+ *                 The default is 1.
+ * \retval OD_SUCCESS Success.
+ * \retval OD_EFAULT  \a enc or \a buf is <tt>NULL</tt>, or the threads
+ *                     could not be started (the encoder then uses a single
+ *                     thread).
+ * \retval OD_EINVAL  \a buf_sz is not <tt>sizeof(int)</tt>, or the number
+ *                     of threads is out of range.*/
+#define OD_SET_THREADS 4122
+/** Whether the block-size decisions of each superblock should be made
+ *  independently of the superblocks before it, so that they can be made in
+ *  parallel by the threads set with #OD_SET_THREADS.
+ * This costs a small amount of compression, since the rate estimates no
+ *  longer account for the adaptation of the entropy coder earlier in the
+ *  frame.
+ * The encoded stream depends on this setting, but not on the number of
+ *  threads.
+ * \param[in]  _buf <tt>int</tt>: 0 to decide the superblocks in order (the
+ *                   default), a non-zero value otherwise. */
+#define OD_SET_PARALLEL_RDO 4124
 /*@}*/
 
 /**\name OD_SET_RATE_FLAGS flags
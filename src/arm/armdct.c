@@ -30,8 +30,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 #include "../dct.h"
 #include "armint.h"
 
+/*The sign bit must be shifted down logically, as in OD_UNBIASED_RSHIFT32().*/
 #define OD_UNBIASED_RSHIFT(a, b) \
-  vshrq_n_s32(vaddq_s32(vshlq_n_s32(a, 32 - b), a), b)
+  vshrq_n_s32(vaddq_s32(vreinterpretq_s32_u32( \
+   vshrq_n_u32(vreinterpretq_u32_s32(a), 32 - b)), a), b)
 
 OD_SIMD_INLINE void od_overflow_check_epi32(int32x4_t val, int32_t scale,
  int32_t offset, int idx) {
@@ -66,11 +68,11 @@ OD_SIMD_INLINE void od_transpose4(int32x4_t *t0, int32x4_t *t1,
   a = od_vswpq_u64(vreinterpretq_u64_s32(*t0), vreinterpretq_u64_s32(*t2));
   b = od_vswpq_u64(vreinterpretq_u64_s32(*t1), vreinterpretq_u64_s32(*t3));
   x = vtrnq_s32(vreinterpretq_s32_u64(a.val[0]),
-		vreinterpretq_s32_u64(a.val[1]));
+   vreinterpretq_s32_u64(b.val[0]));
   *t0 = x.val[0];
   *t1 = x.val[1];
-  x = vtrnq_s32(vreinterpretq_s32_u64(b.val[0]),
-		vreinterpretq_s32_u64(b.val[1]));
+  x = vtrnq_s32(vreinterpretq_s32_u64(a.val[1]),
+   vreinterpretq_s32_u64(b.val[1]));
   *t2 = x.val[0];
   *t3 = x.val[1];
 }
@@ -39,4 +39,64 @@ void od_bin_fdct4x4_neon(od_coeff *y, int ystride,
 void od_bin_idct4x4_neon(od_coeff *y, int ystride,
  const od_coeff *x, int xstride);
 
+void od_mc_predict1fmv8_neon(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz);
+void od_mc_predict1fmv16_neon(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full8_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full16_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full_split8_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full_split16_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz);
+
+void od_copy_8x8_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_16x16_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_32x32_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_64x64_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_4x4_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_8x8_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_16x16_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_32x32_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+void od_copy_64x64_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride);
+
+void od_filter_dering_direction_4x4_neon(int16_t *y, int ystride,
+ const int16_t *in, int threshold, int dir);
+void od_filter_dering_direction_8x8_neon(int16_t *y, int ystride,
+ const int16_t *in, int threshold, int dir);
+void od_filter_dering_orthogonal_4x4_neon(int16_t *y, int ystride,
+ const int16_t *in, const int16_t *x, int xstride, int threshold, int dir);
+void od_filter_dering_orthogonal_8x8_neon(int16_t *y, int ystride,
+ const int16_t *in, const int16_t *x, int xstride, int threshold, int dir);
+int od_dir_find8_neon(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift);
+void od_ref_buf_to_coeff8_neon(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+void od_ref_buf_to_coeff16_neon(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+void od_coeff_to_ref_buf8_neon(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
+void od_coeff_to_ref_buf16_neon(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
+
+extern const od_filter_dering_direction_func
+ OD_DERING_DIRECTION_NEON[OD_DERINGSIZES];
+extern const od_filter_dering_orthogonal_func
+ OD_DERING_ORTHOGONAL_NEON[OD_DERINGSIZES];
+
 #endif
@@ -34,6 +34,36 @@ void od_state_opt_vtbl_init_arm(od_state *_state){
   od_state_opt_vtbl_init_c(_state);
   _state->cpu_flags=od_cpu_flags_get();
   if(_state->cpu_flags&OD_CPU_ARM_NEON){
+    if (_state->info.full_precision_references) {
+      _state->opt_vtbl.mc_predict1fmv = od_mc_predict1fmv16_neon;
+      _state->opt_vtbl.mc_blend_full = od_mc_blend_full16_neon;
+      _state->opt_vtbl.mc_blend_full_split = od_mc_blend_full_split16_neon;
+      _state->opt_vtbl.od_copy_nxn[2] = od_copy_4x4_16_neon;
+      _state->opt_vtbl.od_copy_nxn[3] = od_copy_8x8_16_neon;
+      _state->opt_vtbl.od_copy_nxn[4] = od_copy_16x16_16_neon;
+      _state->opt_vtbl.od_copy_nxn[5] = od_copy_32x32_16_neon;
+      _state->opt_vtbl.od_copy_nxn[6] = od_copy_64x64_16_neon;
+    }
+    else {
+      _state->opt_vtbl.mc_predict1fmv = od_mc_predict1fmv8_neon;
+      _state->opt_vtbl.mc_blend_full = od_mc_blend_full8_neon;
+      _state->opt_vtbl.mc_blend_full_split = od_mc_blend_full_split8_neon;
+      _state->opt_vtbl.od_copy_nxn[3] = od_copy_8x8_8_neon;
+      _state->opt_vtbl.od_copy_nxn[4] = od_copy_16x16_8_neon;
+      _state->opt_vtbl.od_copy_nxn[5] = od_copy_32x32_8_neon;
+      _state->opt_vtbl.od_copy_nxn[6] = od_copy_64x64_8_neon;
+    }
+    _state->opt_vtbl.fdct_2d[0] = od_bin_fdct4x4_neon;
+    _state->opt_vtbl.idct_2d[0] = od_bin_idct4x4_neon;
+    OD_COPY(_state->opt_vtbl.dering.filter_dering_direction,
+     OD_DERING_DIRECTION_NEON, OD_DERINGSIZES);
+    OD_COPY(_state->opt_vtbl.dering.filter_dering_orthogonal,
+     OD_DERING_ORTHOGONAL_NEON, OD_DERINGSIZES);
+    _state->opt_vtbl.dering.dir_find8 = od_dir_find8_neon;
+    _state->opt_vtbl.ref_buf_to_coeff8 = od_ref_buf_to_coeff8_neon;
+    _state->opt_vtbl.ref_buf_to_coeff16 = od_ref_buf_to_coeff16_neon;
+    _state->opt_vtbl.coeff_to_ref_buf8 = od_coeff_to_ref_buf8_neon;
+    _state->opt_vtbl.coeff_to_ref_buf16 = od_coeff_to_ref_buf16_neon;
   }
 }
 
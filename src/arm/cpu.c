@@ -30,7 +30,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 #include "armint.h"
 #if defined(OD_ARMASM)
 
-#if defined(_MSC_VER)
+#if defined(__aarch64__) || defined(_M_ARM64)
+/*AArch64 makes Advanced SIMD mandatory, and Linux reports it as "asimd"
+   rather than "neon" in /proc/cpuinfo.*/
+uint32_t od_cpu_flags_get(void){
+  return OD_CPU_ARM_NEON;
+}
+
+#elif defined(_MSC_VER)
 /*For GetExceptionCode() and EXCEPTION_ILLEGAL_INSTRUCTION.*/
 # define WIN32_LEAN_AND_MEAN
 # define WIN32_EXTRA_LEAN
@@ -0,0 +1,385 @@
+/*Daala video codec
+Copyright (c) 2006-2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#if defined(HAVE_CONFIG_H)
+# include "config.h"
+#endif
+
+#include "armint.h"
+#include "cpu.h"
+
+#include <stdio.h>
+
+#if defined(OD_ARMASM)
+#include <arm_neon.h>
+#include "../dering.h"
+
+#if defined(OD_CHECKASM)
+static void od_filter_dering_check(int16_t *y, int ystride,
+ const int16_t *dst, int ln, const char *name) {
+  int i;
+  int j;
+  int failed;
+  failed = 0;
+  for (i = 0; i < 1 << ln; i++) {
+    for (j = 0; j < 1 << ln; j++) {
+      if (dst[i*OD_BSIZE_MAX + j] != y[i*ystride + j]) {
+        fprintf(stderr,"ASM mismatch: 0x%02X!=0x%02X @ (%2i,%2i)\n",
+         dst[i*OD_BSIZE_MAX + j],y[i*ystride + j],i,j);
+        failed = 1;
+      }
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "%s check failed.\n", name);
+  }
+}
+#endif
+
+const od_filter_dering_direction_func
+ OD_DERING_DIRECTION_NEON[OD_DERINGSIZES] = {
+  od_filter_dering_direction_4x4_neon,
+  od_filter_dering_direction_8x8_neon
+};
+
+const od_filter_dering_orthogonal_func
+ OD_DERING_ORTHOGONAL_NEON[OD_DERINGSIZES] = {
+  od_filter_dering_orthogonal_4x4_neon,
+  od_filter_dering_orthogonal_8x8_neon
+};
+
+/*Loads a row of 8 values, or of 4 values repeated twice when ln is 2.*/
+OD_SIMD_INLINE int16x8_t od_dering_load(const int16_t *x, int ln) {
+  int16x4_t v;
+  if (ln == 3) return vld1q_s16(x);
+  v = vld1_s16(x);
+  return vcombine_s16(v, v);
+}
+
+OD_SIMD_INLINE void od_dering_store(int16_t *y, int16x8_t v, int ln) {
+  if (ln == 3) vst1q_s16(y, v);
+  else vst1_s16(y, vget_low_s16(v));
+}
+
+/*Returns p where abs(p) < threshold and 0 elsewhere.
+  The saturating abs keeps -32768 from comparing as negative.*/
+OD_SIMD_INLINE int16x8_t od_dering_mask(int16x8_t p, int16x8_t threshold) {
+  return vandq_s16(p,
+   vreinterpretq_s16_u16(vcltq_s16(vqabsq_s16(p), threshold)));
+}
+
+/*The 16-bit sums wrap exactly like the int16_t sums of
+   od_filter_dering_direction_c() and the rounding shift does not overflow,
+   so the result is bit-exact.*/
+OD_SIMD_INLINE void od_filter_dering_direction_neon(int16_t *y, int ystride,
+ const int16_t *in, int ln, int threshold, int dir) {
+  static const int16_t taps[3] = {3, 2, 1};
+  int16x8_t thresh;
+  int i;
+  int k;
+  thresh = vdupq_n_s16(threshold);
+  for (i = 0; i < 1 << ln; i++) {
+    int16x8_t row;
+    int16x8_t sum;
+    int16x8_t p;
+    row = od_dering_load(&in[i*OD_FILT_BSTRIDE], ln);
+    sum = vdupq_n_s16(0);
+    for (k = 0; k < 3; k++) {
+      p = vsubq_s16(od_dering_load(&in[i*OD_FILT_BSTRIDE
+       + OD_DIRECTION_OFFSETS_TABLE[dir][k]], ln), row);
+      sum = vmlaq_n_s16(sum, od_dering_mask(p, thresh), taps[k]);
+      p = vsubq_s16(od_dering_load(&in[i*OD_FILT_BSTRIDE
+       - OD_DIRECTION_OFFSETS_TABLE[dir][k]], ln), row);
+      sum = vmlaq_n_s16(sum, od_dering_mask(p, thresh), taps[k]);
+    }
+    /*row + ((sum + 8) >> 4)*/
+    od_dering_store(&y[i*ystride], vaddq_s16(row, vrshrq_n_s16(sum, 4)), ln);
+  }
+#if defined(OD_CHECKASM)
+  {
+    int16_t dst[OD_BSIZE_MAX*OD_BSIZE_MAX];
+    od_filter_dering_direction_c(dst, OD_BSIZE_MAX, in, ln, threshold, dir);
+    od_filter_dering_check(y, ystride, dst, ln,
+     "od_filter_dering_direction");
+  }
+#endif
+}
+
+void od_filter_dering_direction_4x4_neon(int16_t *y, int ystride,
+ const int16_t *in, int threshold, int dir) {
+  od_filter_dering_direction_neon(y, ystride, in, 2, threshold, dir);
+}
+
+void od_filter_dering_direction_8x8_neon(int16_t *y, int ystride,
+ const int16_t *in, int threshold, int dir) {
+  od_filter_dering_direction_neon(y, ystride, in, 3, threshold, dir);
+}
+
+OD_SIMD_INLINE void od_filter_dering_orthogonal_neon(int16_t *y,
+ int ystride, const int16_t *in, const int16_t *x, int xstride, int ln,
+ int threshold, int dir) {
+  int16x8_t thresh;
+  int16x8_t thresh3;
+  int offset;
+  int i;
+  int k;
+  if (dir > 0 && dir < 4) offset = OD_FILT_BSTRIDE;
+  else offset = 1;
+  thresh = vdupq_n_s16(threshold);
+  thresh3 = vdupq_n_s16(threshold/3);
+  for (i = 0; i < 1 << ln; i++) {
+    int16x8_t row;
+    int16x8_t athresh;
+    int16x8_t sum;
+    int16x8_t p;
+    int32x4_t lo;
+    int32x4_t hi;
+    row = od_dering_load(&in[i*OD_FILT_BSTRIDE], ln);
+    /*athresh = OD_MINI(threshold, threshold/3
+       + abs(in[i*OD_FILT_BSTRIDE] - x[i*xstride]))
+      Saturating wherever the C code would leave 16 bits only ever selects
+       threshold.*/
+    athresh = vminq_s16(thresh, vqaddq_s16(thresh3,
+     vqabsq_s16(vqsubq_s16(row, od_dering_load(&x[i*xstride], ln)))));
+    sum = vdupq_n_s16(0);
+    for (k = 1; k <= 2; k++) {
+      p = vsubq_s16(od_dering_load(&in[i*OD_FILT_BSTRIDE + k*offset], ln),
+       row);
+      sum = vaddq_s16(sum, od_dering_mask(p, athresh));
+      p = vsubq_s16(od_dering_load(&in[i*OD_FILT_BSTRIDE - k*offset], ln),
+       row);
+      sum = vaddq_s16(sum, od_dering_mask(p, athresh));
+    }
+    /*row + ((3*sum + 8) >> 4), with 3*sum in 32 bits as in C.*/
+    lo = vrshrq_n_s32(vmull_n_s16(vget_low_s16(sum), 3), 4);
+    hi = vrshrq_n_s32(vmull_n_s16(vget_high_s16(sum), 3), 4);
+    od_dering_store(&y[i*ystride],
+     vaddq_s16(row, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi))), ln);
+  }
+#if defined(OD_CHECKASM)
+  {
+    int16_t dst[OD_BSIZE_MAX*OD_BSIZE_MAX];
+    od_filter_dering_orthogonal_c(dst, OD_BSIZE_MAX, in, x, xstride, ln,
+     threshold, dir);
+    od_filter_dering_check(y, ystride, dst, ln,
+     "od_filter_dering_orthogonal");
+  }
+#endif
+}
+
+void od_filter_dering_orthogonal_4x4_neon(int16_t *y, int ystride,
+ const int16_t *in, const int16_t *x, int xstride, int threshold, int dir) {
+  od_filter_dering_orthogonal_neon(y, ystride, in, x, xstride, 2, threshold,
+   dir);
+}
+
+void od_filter_dering_orthogonal_8x8_neon(int16_t *y, int ystride,
+ const int16_t *in, const int16_t *x, int xstride, int threshold, int dir) {
+  od_filter_dering_orthogonal_neon(y, ystride, in, x, xstride, 3, threshold,
+   dir);
+}
+
+#if defined(OD_CHECKASM)
+static void od_dir_find8_check(const od_dering_in *img, int stride,
+ int coeff_shift, int dir, int32_t var) {
+  int32_t var_c;
+  int dir_c;
+  dir_c = od_dir_find8_c(img, stride, &var_c, coeff_shift);
+  if (dir != dir_c || var != var_c) {
+    fprintf(stderr, "ASM mismatch: dir %i!=%i, var %i!=%i\n",
+     dir_c, dir, var_c, var);
+    fprintf(stderr, "od_dir_find8 check failed.\n");
+  }
+}
+#endif
+
+/*Adds row, shifted up by s > 0 lanes, to the 15-lane partial sum in (a, b).*/
+#define OD_DIR_ACCUM(a, b, row, s) \
+  do { \
+    (a) = vaddq_s16(a, vextq_s16(vdupq_n_s16(0), row, 8 - (s))); \
+    (b) = vaddq_s16(b, vextq_s16(row, vdupq_n_s16(0), 8 - (s))); \
+  } \
+  while (0)
+
+/*Weights for the squared partial sums: 840/n for a line of n pixels.
+  The first row is for the 15 lines of directions 0 and 4, the second for the
+   11 lines of the odd directions.*/
+static const int32_t OD_DIR_WEIGHTS_NEON[2][16] = {
+  {840, 420, 280, 210, 168, 140, 120, 105,
+   120, 140, 168, 210, 280, 420, 840, 0},
+  {420, 210, 140, 105, 105, 105, 105, 105,
+   140, 210, 420, 0, 0, 0, 0, 0}
+};
+
+OD_SIMD_INLINE int32x4_t od_dir_cost_neon(int32x4_t cost, int16x8_t p,
+ const int32_t *w) {
+  cost = vmlaq_s32(cost, vmull_s16(vget_low_s16(p), vget_low_s16(p)),
+   vld1q_s32(w));
+  return vmlaq_s32(cost, vmull_s16(vget_high_s16(p), vget_high_s16(p)),
+   vld1q_s32(w + 4));
+}
+
+OD_SIMD_INLINE int32x2_t od_hsum_s32(int32x4_t x0, int32x4_t x1) {
+  return vpadd_s32(vpadd_s32(vget_low_s32(x0), vget_high_s32(x0)),
+   vpadd_s32(vget_low_s32(x1), vget_high_s32(x1)));
+}
+
+/*Computes the costs of directions {0, 5, 6, 7} of od_dir_find8_c().
+  On the transpose of the block with its rows in reverse order, the same
+   lines give directions {4, 1, 2, 3}.
+  The partial sums of 8 values of at most 12 bits fit in 16 bits, and the
+   products wrap like the int arithmetic of the C code.*/
+OD_SIMD_INLINE int32x4_t od_dir_costs_neon(const int16x8_t *lines) {
+  int16x8_t p0a;
+  int16x8_t p0b;
+  int16x8_t p5a;
+  int16x8_t p5b;
+  int16x8_t p6;
+  int16x8_t p7a;
+  int16x8_t p7b;
+  int16x8_t pair;
+  int32x4_t c0;
+  int32x4_t c5;
+  int32x4_t c6;
+  int32x4_t c7;
+  int32x4_t zero;
+  p0b = p5b = p7b = vdupq_n_s16(0);
+  /*Direction 0: row i is shifted by i.*/
+  p0a = lines[0];
+  OD_DIR_ACCUM(p0a, p0b, lines[1], 1);
+  OD_DIR_ACCUM(p0a, p0b, lines[2], 2);
+  OD_DIR_ACCUM(p0a, p0b, lines[3], 3);
+  OD_DIR_ACCUM(p0a, p0b, lines[4], 4);
+  OD_DIR_ACCUM(p0a, p0b, lines[5], 5);
+  OD_DIR_ACCUM(p0a, p0b, lines[6], 6);
+  OD_DIR_ACCUM(p0a, p0b, lines[7], 7);
+  /*Directions 5 and 7 move by one column every two rows, and direction 6
+     sums the columns.*/
+  pair = vaddq_s16(lines[0], lines[1]);
+  p6 = pair;
+  p5a = vextq_s16(vdupq_n_s16(0), pair, 5);
+  p5b = vextq_s16(pair, vdupq_n_s16(0), 5);
+  p7a = pair;
+  pair = vaddq_s16(lines[2], lines[3]);
+  p6 = vaddq_s16(p6, pair);
+  OD_DIR_ACCUM(p5a, p5b, pair, 2);
+  OD_DIR_ACCUM(p7a, p7b, pair, 1);
+  pair = vaddq_s16(lines[4], lines[5]);
+  p6 = vaddq_s16(p6, pair);
+  OD_DIR_ACCUM(p5a, p5b, pair, 1);
+  OD_DIR_ACCUM(p7a, p7b, pair, 2);
+  pair = vaddq_s16(lines[6], lines[7]);
+  p6 = vaddq_s16(p6, pair);
+  p5a = vaddq_s16(p5a, pair);
+  OD_DIR_ACCUM(p7a, p7b, pair, 3);
+  zero = vdupq_n_s32(0);
+  c0 = od_dir_cost_neon(od_dir_cost_neon(zero, p0a, OD_DIR_WEIGHTS_NEON[0]),
+   p0b, OD_DIR_WEIGHTS_NEON[0] + 8);
+  c5 = od_dir_cost_neon(od_dir_cost_neon(zero, p5a, OD_DIR_WEIGHTS_NEON[1]),
+   p5b, OD_DIR_WEIGHTS_NEON[1] + 8);
+  c7 = od_dir_cost_neon(od_dir_cost_neon(zero, p7a, OD_DIR_WEIGHTS_NEON[1]),
+   p7b, OD_DIR_WEIGHTS_NEON[1] + 8);
+  c6 = vmulq_n_s32(vaddq_s32(vmull_s16(vget_low_s16(p6), vget_low_s16(p6)),
+   vmull_s16(vget_high_s16(p6), vget_high_s16(p6))), 105);
+  return vcombine_s32(od_hsum_s32(c0, c5), od_hsum_s32(c6, c7));
+}
+
+/*Transposes the 8x8 block in lines into tlines, with the rows of the result
+   in reverse order.*/
+OD_SIMD_INLINE void od_transpose_rev8x8_s16(int16x8_t *tlines,
+ const int16x8_t *lines) {
+  int16x8x2_t a0;
+  int16x8x2_t a1;
+  int16x8x2_t a2;
+  int16x8x2_t a3;
+  int32x4x2_t b0;
+  int32x4x2_t b1;
+  int32x4x2_t b2;
+  int32x4x2_t b3;
+  a0 = vtrnq_s16(lines[0], lines[1]);
+  a1 = vtrnq_s16(lines[2], lines[3]);
+  a2 = vtrnq_s16(lines[4], lines[5]);
+  a3 = vtrnq_s16(lines[6], lines[7]);
+  b0 = vtrnq_s32(vreinterpretq_s32_s16(a0.val[0]),
+   vreinterpretq_s32_s16(a1.val[0]));
+  b1 = vtrnq_s32(vreinterpretq_s32_s16(a0.val[1]),
+   vreinterpretq_s32_s16(a1.val[1]));
+  b2 = vtrnq_s32(vreinterpretq_s32_s16(a2.val[0]),
+   vreinterpretq_s32_s16(a3.val[0]));
+  b3 = vtrnq_s32(vreinterpretq_s32_s16(a2.val[1]),
+   vreinterpretq_s32_s16(a3.val[1]));
+  tlines[7] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b0.val[0]),
+   vget_low_s32(b2.val[0])));
+  tlines[6] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b1.val[0]),
+   vget_low_s32(b3.val[0])));
+  tlines[5] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b0.val[1]),
+   vget_low_s32(b2.val[1])));
+  tlines[4] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b1.val[1]),
+   vget_low_s32(b3.val[1])));
+  tlines[3] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b0.val[0]),
+   vget_high_s32(b2.val[0])));
+  tlines[2] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b1.val[0]),
+   vget_high_s32(b3.val[0])));
+  tlines[1] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b0.val[1]),
+   vget_high_s32(b2.val[1])));
+  tlines[0] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b1.val[1]),
+   vget_high_s32(b3.val[1])));
+}
+
+int od_dir_find8_neon(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift) {
+  int16x8_t lines[8];
+  int16x8_t tlines[8];
+  int16x8_t shift;
+  int32_t c[8];
+  int32_t cost[8];
+  int i;
+  int dir;
+  /*The 16-bit partial sums need the input to be scaled down to 12 bits.*/
+  if (coeff_shift < OD_COEFF_SHIFT) {
+    return od_dir_find8_c(img, stride, var, coeff_shift);
+  }
+  shift = vdupq_n_s16(-coeff_shift);
+  for (i = 0; i < 8; i++) {
+    lines[i] = vshlq_s16(vld1q_s16(&img[i*stride]), shift);
+  }
+  od_transpose_rev8x8_s16(tlines, lines);
+  vst1q_s32(&c[0], od_dir_costs_neon(lines));
+  vst1q_s32(&c[4], od_dir_costs_neon(tlines));
+  cost[0] = c[0];
+  cost[5] = c[1];
+  cost[6] = c[2];
+  cost[7] = c[3];
+  cost[4] = c[4];
+  cost[1] = c[5];
+  cost[2] = c[6];
+  cost[3] = c[7];
+  dir = od_dir_find8_best(cost, var);
+#if defined(OD_CHECKASM)
+  od_dir_find8_check(img, stride, coeff_shift, dir, *var);
+#endif
+  return dir;
+}
+
+#endif
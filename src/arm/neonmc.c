@@ -0,0 +1,689 @@
+/*Daala video codec
+Copyright (c) 2006-2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "armint.h"
+#include "cpu.h"
+#include "../mc.h"
+#include "../util.h"
+
+#if defined(OD_ARMASM)
+#include <arm_neon.h>
+
+#if defined(OD_CHECKASM)
+static void od_mc_check(const unsigned char *_dst, int _dystride,
+ const unsigned char *dst, int _log_xblk_sz, int _log_yblk_sz, int xstride,
+ const char *name) {
+  int xblk_sz;
+  int yblk_sz;
+  int failed;
+  int i;
+  int j;
+  xblk_sz = 1 << _log_xblk_sz;
+  yblk_sz = 1 << _log_yblk_sz;
+  failed = 0;
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i++) {
+      int _dst_val;
+      int dst_val;
+      if (xstride == 2) {
+        _dst_val = ((const int16_t *)(_dst + j*_dystride))[i];
+        dst_val = ((const int16_t *)dst)[j*xblk_sz + i];
+      }
+      else {
+        _dst_val = _dst[j*_dystride + i];
+        dst_val = dst[j*xblk_sz + i];
+      }
+      if (_dst_val != dst_val) {
+        fprintf(stderr, "ASM mismatch: 0x%04X!=0x%04X @ (%2i,%2i)\n",
+         _dst_val, dst_val, i, j);
+        failed = 1;
+      }
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "%s %ix%i check failed.\n", name,
+     (1 << _log_xblk_sz), (1 << _log_yblk_sz));
+  }
+  OD_ASSERT(!failed);
+}
+#endif
+
+static const int32_t OD_IOTA_NEON[4] = { 0, 1, 2, 3 };
+
+/*Loads 8 pixels, or 4 for blocks only 4 pixels wide.
+  In the latter case the 4 pixels are repeated in the upper half.*/
+OD_SIMD_INLINE uint8x8_t od_mc_load_u8(const unsigned char *src, int n) {
+  uint32_t v;
+  if (n >= 8) return vld1_u8(src);
+  memcpy(&v, src, sizeof(v));
+  return vreinterpret_u8_u32(vdup_n_u32(v));
+}
+
+OD_SIMD_INLINE void od_mc_store_u8(unsigned char *dst, uint8x8_t p, int n) {
+  uint32_t v;
+  if (n >= 8) vst1_u8(dst, p);
+  else {
+    v = vget_lane_u32(vreinterpret_u32_u8(p), 0);
+    memcpy(dst, &v, sizeof(v));
+  }
+}
+
+OD_SIMD_INLINE int16x8_t od_mc_load_s16(const int16_t *src, int n) {
+  int16x4_t v;
+  if (n >= 8) return vld1q_s16(src);
+  v = vld1_s16(src);
+  return vcombine_s16(v, v);
+}
+
+OD_SIMD_INLINE void od_mc_store_s16(int16_t *dst, int16x8_t p, int n) {
+  if (n >= 8) vst1q_s16(dst, p);
+  else vst1_s16(dst, vget_low_s16(p));
+}
+
+/*Block copy functions.
+  w is the width of a row in bytes and must be 8 or a multiple of 16.*/
+OD_SIMD_INLINE void od_copy_nxn_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride, int w, int n) {
+  int i;
+  int j;
+  for (j = 0; j < n; j++) {
+    if (w == 8) vst1_u8(_dst, vld1_u8(_src));
+    else {
+      for (i = 0; i < w; i += 16) vst1q_u8(_dst + i, vld1q_u8(_src + i));
+    }
+    _dst += _dstride;
+    _src += _sstride;
+  }
+}
+
+void od_copy_8x8_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 8, 8);
+}
+
+void od_copy_16x16_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 16, 16);
+}
+
+void od_copy_32x32_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 32, 32);
+}
+
+void od_copy_64x64_8_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 64, 64);
+}
+
+void od_copy_4x4_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 8, 4);
+}
+
+void od_copy_8x8_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 16, 8);
+}
+
+void od_copy_16x16_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 32, 16);
+}
+
+void od_copy_32x32_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 64, 32);
+}
+
+void od_copy_64x64_16_neon(unsigned char *_dst, int _dstride,
+ const unsigned char *_src, int _sstride) {
+  od_copy_nxn_neon(_dst, _dstride, _src, _sstride, 128, 64);
+}
+
+/*Blocks narrower than 4 pixels are left to the C code.
+  The horizontal pass computes 8 (or 4) outputs at a time in 16 bits.
+  The taps can push the running sum out of range, but the biased result
+   always fits in an int16_t, so the wrap-around cancels out exactly.*/
+void od_mc_predict1fmv8_neon(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz) {
+  int16_t buff[(OD_MVBSIZE_MAX + OD_SUBPEL_BUFF_APRON_SZ)*OD_MVBSIZE_MAX];
+  const unsigned char *src_p;
+  const int16_t *fx;
+  const int16_t *fy;
+  int16_t *buff_p;
+  unsigned char *dst_p;
+  int mvxf;
+  int mvyf;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_predict1fmv8_c(state, dst, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  src_p = src + (mvx >> 3) + (mvy >> 3)*systride;
+  mvxf = mvx & 0x07;
+  mvyf = mvy & 0x07;
+  if (!(mvxf || mvyf)) {
+    OD_ASSERT(log_xblk_sz == log_yblk_sz);
+    (*state->opt_vtbl.od_copy_nxn[log_xblk_sz])(dst, xblk_sz, src_p,
+     systride);
+    return;
+  }
+  fx = OD_SUBPEL_FILTER_SET[mvxf];
+  fy = OD_SUBPEL_FILTER_SET[mvyf];
+  buff_p = buff;
+  src_p -= systride*OD_SUBPEL_TOP_APRON_SZ;
+  /*1st stage 1D filtering, Horizontal.*/
+  if (mvxf) {
+    for (j = -OD_SUBPEL_TOP_APRON_SZ;
+     j < yblk_sz + OD_SUBPEL_BOTTOM_APRON_SZ; j++) {
+      for (i = 0; i < xblk_sz; i += 8) {
+        int16x8_t sum;
+        sum = vdupq_n_s16(-(128 << OD_SUBPEL_COEFF_SCALE));
+        for (k = 0; k < OD_SUBPEL_FILTER_TAP_SIZE; k++) {
+          sum = vmlaq_n_s16(sum, vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(
+           src_p + i + k - OD_SUBPEL_TOP_APRON_SZ, xblk_sz))), fx[k]);
+        }
+        od_mc_store_s16(buff_p + i, sum, xblk_sz);
+      }
+      src_p += systride;
+      buff_p += xblk_sz;
+    }
+  }
+  /*The mvx is in integer position.*/
+  else {
+    for (j = -OD_SUBPEL_TOP_APRON_SZ;
+     j < yblk_sz + OD_SUBPEL_BOTTOM_APRON_SZ; j++) {
+      for (i = 0; i < xblk_sz; i += 8) {
+        od_mc_store_s16(buff_p + i, vsubq_s16(vreinterpretq_s16_u16(
+         vshll_n_u8(od_mc_load_u8(src_p + i, xblk_sz),
+         OD_SUBPEL_COEFF_SCALE)), vdupq_n_s16(OD_SUBPEL_COEFF_NORMALIZE)),
+         xblk_sz);
+      }
+      src_p += systride;
+      buff_p += xblk_sz;
+    }
+  }
+  /*2nd stage 1D filtering, Vertical.*/
+  buff_p = buff + xblk_sz*OD_SUBPEL_TOP_APRON_SZ;
+  dst_p = dst;
+  if (mvyf) {
+    for (j = 0; j < yblk_sz; j++) {
+      for (i = 0; i < xblk_sz; i += 8) {
+        int16x8_t p;
+        int32x4_t lo;
+        int32x4_t hi;
+        p = od_mc_load_s16(buff_p + i - OD_SUBPEL_TOP_APRON_SZ*xblk_sz,
+         xblk_sz);
+        lo = vmull_n_s16(vget_low_s16(p), fy[0]);
+        hi = vmull_n_s16(vget_high_s16(p), fy[0]);
+        for (k = 1; k < OD_SUBPEL_FILTER_TAP_SIZE; k++) {
+          p = od_mc_load_s16(buff_p + i + (k - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz,
+           xblk_sz);
+          lo = vmlal_n_s16(lo, vget_low_s16(p), fy[k]);
+          hi = vmlal_n_s16(hi, vget_high_s16(p), fy[k]);
+        }
+        /*OD_SUBPEL_RND_OFFSET3 also restores the bias of 128.*/
+        lo = vshrq_n_s32(vaddq_s32(lo, vdupq_n_s32(OD_SUBPEL_RND_OFFSET3)),
+         OD_SUBPEL_COEFF_SCALE2);
+        hi = vshrq_n_s32(vaddq_s32(hi, vdupq_n_s32(OD_SUBPEL_RND_OFFSET3)),
+         OD_SUBPEL_COEFF_SCALE2);
+        od_mc_store_u8(dst_p + i,
+         vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi))), xblk_sz);
+      }
+      buff_p += xblk_sz;
+      dst_p += xblk_sz;
+    }
+  }
+  /*The mvy is in integer position.*/
+  else {
+    for (j = 0; j < yblk_sz; j++) {
+      for (i = 0; i < xblk_sz; i += 8) {
+        int16x8_t p;
+        /*The rounding shift cannot overflow, unlike adding
+           OD_SUBPEL_RND_OFFSET4 in 16 bits would.*/
+        p = vaddq_s16(vrshrq_n_s16(od_mc_load_s16(buff_p + i, xblk_sz),
+         OD_SUBPEL_COEFF_SCALE), vdupq_n_s16(128));
+        od_mc_store_u8(dst_p + i, vqmovun_s16(p), xblk_sz);
+      }
+      buff_p += xblk_sz;
+      dst_p += xblk_sz;
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX];
+    od_mc_predict1fmv8_c(state, dst_c, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check(dst, xblk_sz, dst_c, log_xblk_sz, log_yblk_sz, 1,
+     "od_mc_predict1fmv8");
+  }
+#endif
+}
+
+/*The 16-bit pixels keep the intermediate rows at 32 bits, so this works on 4
+   outputs at a time.*/
+void od_mc_predict1fmv16_neon(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz) {
+  int32_t buff[(OD_MVBSIZE_MAX + OD_SUBPEL_BUFF_APRON_SZ)*OD_MVBSIZE_MAX];
+  const unsigned char *src_p;
+  const int16_t *fx;
+  const int16_t *fy;
+  int32_t *buff_p;
+  int16_t *dst_p;
+  int32x4_t fpr_max;
+  int mvxf;
+  int mvyf;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_predict1fmv16_c(state, dst, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  src_p = src + (mvx >> 3)*2 + (mvy >> 3)*systride;
+  mvxf = mvx & 0x07;
+  mvyf = mvy & 0x07;
+  if (!(mvxf || mvyf)) {
+    OD_ASSERT(log_xblk_sz == log_yblk_sz);
+    (*state->opt_vtbl.od_copy_nxn[log_xblk_sz])(dst, xblk_sz << 1, src_p,
+     systride);
+    return;
+  }
+  fx = OD_SUBPEL_FILTER_SET[mvxf];
+  fy = OD_SUBPEL_FILTER_SET[mvyf];
+  buff_p = buff;
+  src_p -= systride*OD_SUBPEL_TOP_APRON_SZ;
+  /*1st stage 1D filtering, Horizontal.*/
+  if (mvxf) {
+    for (j = -OD_SUBPEL_TOP_APRON_SZ;
+     j < yblk_sz + OD_SUBPEL_BOTTOM_APRON_SZ; j++) {
+      const int16_t *src16;
+      src16 = (const int16_t *)src_p;
+      for (i = 0; i < xblk_sz; i += 4) {
+        int32x4_t sum;
+        sum = vdupq_n_s32(-(128 << (OD_COEFF_SHIFT + OD_SUBPEL_COEFF_SCALE)));
+        for (k = 0; k < OD_SUBPEL_FILTER_TAP_SIZE; k++) {
+          sum = vmlal_n_s16(sum,
+           vld1_s16(src16 + i + k - OD_SUBPEL_TOP_APRON_SZ), fx[k]);
+        }
+        vst1q_s32(buff_p + i, sum);
+      }
+      src_p += systride;
+      buff_p += xblk_sz;
+    }
+  }
+  /*The mvx is in integer position.*/
+  else {
+    for (j = -OD_SUBPEL_TOP_APRON_SZ;
+     j < yblk_sz + OD_SUBPEL_BOTTOM_APRON_SZ; j++) {
+      const int16_t *src16;
+      src16 = (const int16_t *)src_p;
+      for (i = 0; i < xblk_sz; i += 4) {
+        vst1q_s32(buff_p + i, vshlq_n_s32(vsubl_s16(vld1_s16(src16 + i),
+         vdup_n_s16(128 << OD_COEFF_SHIFT)), OD_SUBPEL_COEFF_SCALE));
+      }
+      src_p += systride;
+      buff_p += xblk_sz;
+    }
+  }
+  /*2nd stage 1D filtering, Vertical.*/
+  fpr_max = vdupq_n_s32((1 << (8 + OD_COEFF_SHIFT)) - 1);
+  buff_p = buff + xblk_sz*OD_SUBPEL_TOP_APRON_SZ;
+  dst_p = (int16_t *)dst;
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i += 4) {
+      int32x4_t sum;
+      if (mvyf) {
+        sum = vmulq_n_s32(vld1q_s32(buff_p + i
+         - OD_SUBPEL_TOP_APRON_SZ*xblk_sz), fy[0]);
+        for (k = 1; k < OD_SUBPEL_FILTER_TAP_SIZE; k++) {
+          sum = vmlaq_n_s32(sum, vld1q_s32(buff_p + i
+           + (k - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz), fy[k]);
+        }
+        sum = vrshrq_n_s32(sum, OD_SUBPEL_COEFF_SCALE2);
+      }
+      /*The mvy is in integer position.*/
+      else sum = vrshrq_n_s32(vld1q_s32(buff_p + i), OD_SUBPEL_COEFF_SCALE);
+      sum = vaddq_s32(sum, vdupq_n_s32(128 << OD_COEFF_SHIFT));
+      sum = vminq_s32(vmaxq_s32(sum, vdupq_n_s32(0)), fpr_max);
+      vst1_s16(dst_p + i, vmovn_s32(sum));
+    }
+    buff_p += xblk_sz;
+    dst_p += xblk_sz;
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_predict1fmv16_c(state, dst_c, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check(dst, xblk_sz << 1, dst_c, log_xblk_sz, log_yblk_sz, 2,
+     "od_mc_predict1fmv16");
+  }
+#endif
+}
+
+/*Blends 4 pixels with the same two-pass interpolation as
+   od_mc_blend_full16_c(), which needs 32 bits.*/
+OD_SIMD_INLINE int32x4_t od_mc_blend_full_s32(int32x4_t p0, int32x4_t p1,
+ int32x4_t p2, int32x4_t p3, int32x4_t wi, int j, int32x4_t log_xblk_sz,
+ int32x4_t log_yblk_sz, int32x4_t round, int32x4_t shift) {
+  int32x4_t a;
+  int32x4_t b;
+  a = vmlaq_s32(vshlq_s32(p0, log_xblk_sz), vsubq_s32(p1, p0), wi);
+  b = vmlaq_s32(vshlq_s32(p3, log_xblk_sz), vsubq_s32(p2, p3), wi);
+  return vshlq_s32(vmlaq_n_s32(vaddq_s32(vshlq_s32(a, log_yblk_sz), round),
+   vsubq_s32(b, a), j), shift);
+}
+
+/*Blends 8 pixels, returning the low 16 bits of each result.*/
+OD_SIMD_INLINE int16x8_t od_mc_blend_full_s16x8(int16x8_t p0, int16x8_t p1,
+ int16x8_t p2, int16x8_t p3, int i, int j, int32x4_t log_xblk_sz,
+ int32x4_t log_yblk_sz, int32x4_t round, int32x4_t shift) {
+  int32x4_t wi;
+  int32x4_t lo;
+  int32x4_t hi;
+  wi = vaddq_s32(vdupq_n_s32(i), vld1q_s32(OD_IOTA_NEON));
+  lo = od_mc_blend_full_s32(vmovl_s16(vget_low_s16(p0)),
+   vmovl_s16(vget_low_s16(p1)), vmovl_s16(vget_low_s16(p2)),
+   vmovl_s16(vget_low_s16(p3)), wi, j, log_xblk_sz, log_yblk_sz,
+   round, shift);
+  wi = vaddq_s32(wi, vdupq_n_s32(4));
+  hi = od_mc_blend_full_s32(vmovl_s16(vget_high_s16(p0)),
+   vmovl_s16(vget_high_s16(p1)), vmovl_s16(vget_high_s16(p2)),
+   vmovl_s16(vget_high_s16(p3)), wi, j, log_xblk_sz, log_yblk_sz,
+   round, shift);
+  return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+void od_mc_blend_full8_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz) {
+  int32x4_t lx;
+  int32x4_t ly;
+  int32x4_t round;
+  int32x4_t shift;
+  int log_blk_sz2;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  if (log_xblk_sz < 2) {
+    od_mc_blend_full8_c(dst, dystride, src, log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2 = log_xblk_sz + log_yblk_sz;
+  lx = vdupq_n_s32(log_xblk_sz);
+  ly = vdupq_n_s32(log_yblk_sz);
+  round = vdupq_n_s32(1 << log_blk_sz2 >> 1);
+  shift = vdupq_n_s32(-log_blk_sz2);
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i += 8) {
+      int16x8_t p;
+      int o;
+      o = j*xblk_sz + i;
+      p = od_mc_blend_full_s16x8(
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[0] + o, xblk_sz))),
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[1] + o, xblk_sz))),
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[2] + o, xblk_sz))),
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[3] + o, xblk_sz))),
+       i, j, lx, ly, round, shift);
+      od_mc_store_u8(dst + i, vmovn_u16(vreinterpretq_u16_s16(p)), xblk_sz);
+    }
+    dst += dystride;
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX];
+    od_mc_blend_full8_c(dst_c, xblk_sz, src, log_xblk_sz, log_yblk_sz);
+    od_mc_check(dst - yblk_sz*dystride, dystride, dst_c,
+     log_xblk_sz, log_yblk_sz, 1, "od_mc_blend_full8");
+  }
+#endif
+}
+
+void od_mc_blend_full16_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz) {
+  const int16_t *src16[4];
+  int32x4_t lx;
+  int32x4_t ly;
+  int32x4_t round;
+  int32x4_t shift;
+  int log_blk_sz2;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_blend_full16_c(dst, dystride, src, log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2 = log_xblk_sz + log_yblk_sz;
+  lx = vdupq_n_s32(log_xblk_sz);
+  ly = vdupq_n_s32(log_yblk_sz);
+  round = vdupq_n_s32(1 << log_blk_sz2 >> 1);
+  shift = vdupq_n_s32(-log_blk_sz2);
+  for (k = 0; k < 4; k++) src16[k] = (const int16_t *)src[k];
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i += 8) {
+      int o;
+      o = j*xblk_sz + i;
+      od_mc_store_s16((int16_t *)dst + i, od_mc_blend_full_s16x8(
+       od_mc_load_s16(src16[0] + o, xblk_sz),
+       od_mc_load_s16(src16[1] + o, xblk_sz),
+       od_mc_load_s16(src16[2] + o, xblk_sz),
+       od_mc_load_s16(src16[3] + o, xblk_sz),
+       i, j, lx, ly, round, shift), xblk_sz);
+    }
+    dst += dystride;
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_blend_full16_c(dst_c, xblk_sz << 1, src, log_xblk_sz, log_yblk_sz);
+    od_mc_check(dst - yblk_sz*dystride, dystride, dst_c,
+     log_xblk_sz, log_yblk_sz, 2, "od_mc_blend_full16");
+  }
+#endif
+}
+
+/*Blends 4 pixels with the weights of od_mc_blend_full_split16_c() at columns
+   wi of the current row.*/
+OD_SIMD_INLINE int32x4_t od_mc_blend_split_s32(int32x4_t p0, int32x4_t p1,
+ int32x4_t p2, int32x4_t p3, int32x4_t wi, const int s0[4],
+ const int dsdi[4], int32x4_t log_blk_sz2p1, int32x4_t round,
+ int32x4_t shift) {
+  int32x4_t a;
+  a = vshlq_s32(p0, log_blk_sz2p1);
+  a = vmlaq_s32(a, vsubq_s32(p1, p0),
+   vmlaq_n_s32(vdupq_n_s32(s0[1]), wi, dsdi[1]));
+  a = vmlaq_s32(a, vsubq_s32(p2, p0),
+   vmlaq_n_s32(vdupq_n_s32(s0[2]), wi, dsdi[2]));
+  a = vmlaq_s32(a, vsubq_s32(p3, p0),
+   vmlaq_n_s32(vdupq_n_s32(s0[3]), wi, dsdi[3]));
+  return vshlq_s32(vaddq_s32(a, round), shift);
+}
+
+/*Blends 8 pixels, returning the low 16 bits of each result, which is how the
+   C code truncates when the weights of non-square blocks extrapolate.*/
+OD_SIMD_INLINE int16x8_t od_mc_blend_split_s16x8(int16x8_t p0, int16x8_t p1,
+ int16x8_t p2, int16x8_t p3, int i, const int s0[4], const int dsdi[4],
+ int32x4_t log_blk_sz2p1, int32x4_t round, int32x4_t shift) {
+  int32x4_t wi;
+  int32x4_t lo;
+  int32x4_t hi;
+  wi = vaddq_s32(vdupq_n_s32(i), vld1q_s32(OD_IOTA_NEON));
+  lo = od_mc_blend_split_s32(vmovl_s16(vget_low_s16(p0)),
+   vmovl_s16(vget_low_s16(p1)), vmovl_s16(vget_low_s16(p2)),
+   vmovl_s16(vget_low_s16(p3)), wi, s0, dsdi, log_blk_sz2p1, round, shift);
+  wi = vaddq_s32(wi, vdupq_n_s32(4));
+  hi = od_mc_blend_split_s32(vmovl_s16(vget_high_s16(p0)),
+   vmovl_s16(vget_high_s16(p1)), vmovl_s16(vget_high_s16(p2)),
+   vmovl_s16(vget_high_s16(p3)), wi, s0, dsdi, log_blk_sz2p1, round, shift);
+  return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+void od_mc_blend_full_split8_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz) {
+  int s0[4];
+  int dsdi[4];
+  int dsdj[4];
+  int ddsdidj[4];
+  int32x4_t l;
+  int32x4_t round;
+  int32x4_t shift;
+  int log_blk_sz2p1;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_blend_full_split8_c(dst, dystride, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2p1 = log_xblk_sz + log_yblk_sz + 1;
+  l = vdupq_n_s32(log_blk_sz2p1);
+  round = vdupq_n_s32(1 << log_blk_sz2p1 >> 1);
+  shift = vdupq_n_s32(-log_blk_sz2p1);
+  od_mc_setup_s_split(s0, dsdi, dsdj, ddsdidj,
+   oc, s, log_xblk_sz, log_yblk_sz);
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i += 8) {
+      int16x8_t p;
+      int o;
+      o = j*xblk_sz + i;
+      p = od_mc_blend_split_s16x8(
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[0] + o, xblk_sz))),
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[1] + o, xblk_sz))),
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[2] + o, xblk_sz))),
+       vreinterpretq_s16_u16(vmovl_u8(od_mc_load_u8(src[3] + o, xblk_sz))),
+       i, s0, dsdi, l, round, shift);
+      od_mc_store_u8(dst + i, vmovn_u16(vreinterpretq_u16_s16(p)), xblk_sz);
+    }
+    dst += dystride;
+    for (k = 0; k < 4; k++) {
+      s0[k] += dsdj[k];
+      dsdi[k] += ddsdidj[k];
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX];
+    od_mc_blend_full_split8_c(dst_c, xblk_sz, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check(dst - yblk_sz*dystride, dystride, dst_c,
+     log_xblk_sz, log_yblk_sz, 1, "od_mc_blend_full_split8");
+  }
+#endif
+}
+
+void od_mc_blend_full_split16_neon(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz) {
+  const int16_t *src16[4];
+  int s0[4];
+  int dsdi[4];
+  int dsdj[4];
+  int ddsdidj[4];
+  int32x4_t l;
+  int32x4_t round;
+  int32x4_t shift;
+  int log_blk_sz2p1;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_blend_full_split16_c(dst, dystride, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2p1 = log_xblk_sz + log_yblk_sz + 1;
+  l = vdupq_n_s32(log_blk_sz2p1);
+  round = vdupq_n_s32(1 << log_blk_sz2p1 >> 1);
+  shift = vdupq_n_s32(-log_blk_sz2p1);
+  od_mc_setup_s_split(s0, dsdi, dsdj, ddsdidj,
+   oc, s, log_xblk_sz, log_yblk_sz);
+  for (k = 0; k < 4; k++) src16[k] = (const int16_t *)src[k];
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i += 8) {
+      int o;
+      o = j*xblk_sz + i;
+      od_mc_store_s16((int16_t *)dst + i, od_mc_blend_split_s16x8(
+       od_mc_load_s16(src16[0] + o, xblk_sz),
+       od_mc_load_s16(src16[1] + o, xblk_sz),
+       od_mc_load_s16(src16[2] + o, xblk_sz),
+       od_mc_load_s16(src16[3] + o, xblk_sz),
+       i, s0, dsdi, l, round, shift), xblk_sz);
+    }
+    dst += dystride;
+    for (k = 0; k < 4; k++) {
+      s0[k] += dsdj[k];
+      dsdi[k] += ddsdidj[k];
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_blend_full_split16_c(dst_c, xblk_sz << 1, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check(dst - yblk_sz*dystride, dystride, dst_c,
+     log_xblk_sz, log_yblk_sz, 2, "od_mc_blend_full_split16");
+  }
+#endif
+}
+
+#endif
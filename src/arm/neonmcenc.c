@@ -0,0 +1,502 @@
+/*Daala video codec
+Copyright (c) 2006-2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include "armenc.h"
+#include "armint.h"
+
+#if defined(OD_ARMASM)
+#include <arm_neon.h>
+
+# if defined(OD_CHECKASM)
+#  include <stdio.h>
+
+static void od_mc_compute_check(int32_t ret, int32_t c_ret, int n,
+ const char *name) {
+  if (ret != c_ret) {
+    fprintf(stderr, "%s %ix%i check failed: %i!=%i\n",
+     name, n, n, ret, c_ret);
+  }
+  OD_ASSERT(ret == c_ret);
+}
+# endif
+
+/*Loads two rows of 4 pixels into one vector.*/
+OD_SIMD_INLINE uint8x8_t od_load_u8_4x2(const unsigned char *p, int stride) {
+  uint32_t a;
+  uint32_t b;
+  memcpy(&a, p, sizeof(a));
+  memcpy(&b, p + stride, sizeof(b));
+  return vreinterpret_u8_u32(vset_lane_u32(b, vdup_n_u32(a), 1));
+}
+
+OD_SIMD_INLINE uint32_t od_hsum_u32(uint32x4_t v) {
+  uint64x2_t s;
+  s = vpaddlq_u32(v);
+  return (uint32_t)(vgetq_lane_u64(s, 0) + vgetq_lane_u64(s, 1));
+}
+
+int32_t od_mc_compute_sad8_4x4_neon(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  uint16x8_t sums;
+  int32_t ret;
+  sums = vabdl_u8(od_load_u8_4x2(src, systride),
+   od_load_u8_4x2(ref, dystride));
+  sums = vabal_u8(sums, od_load_u8_4x2(src + 2*systride, systride),
+   od_load_u8_4x2(ref + 2*dystride, dystride));
+  ret = od_hsum_u32(vpaddlq_u16(sums));
+#if defined(OD_CHECKASM)
+  od_mc_compute_check(ret,
+   od_mc_compute_sad8_c(src, systride, ref, dystride, 4, 4), 4,
+   "od_mc_compute_sad");
+#endif
+  return ret;
+}
+
+/*Handle one nxn block where n is 2^ln and n >= 8.
+  Each row is summed in 16 bits, then widened so a 64x64 block cannot
+   overflow.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sad8_nxn_neon(int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  uint32x4_t sums;
+  int32_t ret;
+  int n;
+  int i;
+  int j;
+  n = 1 << ln;
+  srow = src;
+  drow = ref;
+  sums = vdupq_n_u32(0);
+  for (i = 0; i < n; i++) {
+    uint16x8_t row;
+    if (n == 8) row = vabdl_u8(vld1_u8(srow), vld1_u8(drow));
+    else {
+      row = vdupq_n_u16(0);
+      for (j = 0; j < n; j += 16) {
+        uint8x16_t s;
+        uint8x16_t d;
+        s = vld1q_u8(srow + j);
+        d = vld1q_u8(drow + j);
+        row = vabal_u8(row, vget_low_u8(s), vget_low_u8(d));
+        row = vabal_u8(row, vget_high_u8(s), vget_high_u8(d));
+      }
+    }
+    sums = vpadalq_u16(sums, row);
+    srow += systride;
+    drow += dystride;
+  }
+  ret = od_hsum_u32(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_check(ret,
+   od_mc_compute_sad8_c(src, systride, ref, dystride, n, n), n,
+   "od_mc_compute_sad");
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad8_8x8_neon(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad8_nxn_neon(3, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad8_16x16_neon(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad8_nxn_neon(4, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad8_32x32_neon(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad8_nxn_neon(5, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad8_64x64_neon(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad8_nxn_neon(6, src, systride, ref, dystride);
+}
+
+/*The absolute difference of two int16_t's can need 17 bits, but it is never
+   negative, so it is exact when read back as unsigned.*/
+OD_SIMD_INLINE uint32x4_t od_mc_sad16_x8(uint32x4_t sums, int16x8_t src,
+ int16x8_t ref) {
+  return vpadalq_u16(sums, vreinterpretq_u16_s16(vabdq_s16(src, ref)));
+}
+
+/*Handle one nxn block where n is 2^ln and n >= 4.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sad16_nxn_neon(int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  uint32x4_t sums;
+  int32_t ret;
+  int n;
+  int i;
+  int j;
+  n = 1 << ln;
+  srow = src;
+  drow = ref;
+  sums = vdupq_n_u32(0);
+  if (n == 4) {
+    /*Two rows of four pixels per vector.*/
+    for (i = 0; i < 4; i += 2) {
+      sums = od_mc_sad16_x8(sums,
+       vcombine_s16(vld1_s16((const int16_t *)srow),
+       vld1_s16((const int16_t *)(srow + systride))),
+       vcombine_s16(vld1_s16((const int16_t *)drow),
+       vld1_s16((const int16_t *)(drow + dystride))));
+      srow += 2*systride;
+      drow += 2*dystride;
+    }
+  }
+  else {
+    for (i = 0; i < n; i++) {
+      for (j = 0; j < n; j += 8) {
+        sums = od_mc_sad16_x8(sums, vld1q_s16((const int16_t *)srow + j),
+         vld1q_s16((const int16_t *)drow + j));
+      }
+      srow += systride;
+      drow += dystride;
+    }
+  }
+  ret = od_hsum_u32(sums);
+  ret = (ret + (1 << OD_COEFF_SHIFT >> 1)) >> OD_COEFF_SHIFT;
+#if defined(OD_CHECKASM)
+  od_mc_compute_check(ret,
+   od_mc_compute_sad16_c(src, systride, ref, dystride, n, n), n,
+   "od_mc_compute_sad16");
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad16_4x4_neon(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_neon(2, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_8x8_neon(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_neon(3, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_16x16_neon(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_neon(4, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_32x32_neon(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_neon(5, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_64x64_neon(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_neon(6, src, systride, ref, dystride);
+}
+
+/*The Hadamard transforms below are applied across rows, one vector per row,
+   and transposed in between.
+  Their output order differs from od_mc_hadamard_1d(), but the sum of
+   absolute values does not depend on it.*/
+
+OD_SIMD_INLINE void od_mc_butterfly_s16x4(int16x4_t *a, int16x4_t *b) {
+  int16x4_t t;
+  t = vsub_s16(*a, *b);
+  *a = vadd_s16(*a, *b);
+  *b = t;
+}
+
+OD_SIMD_INLINE void od_mc_hadamard4_s16(int16x4_t r[4]) {
+  od_mc_butterfly_s16x4(&r[0], &r[1]);
+  od_mc_butterfly_s16x4(&r[2], &r[3]);
+  od_mc_butterfly_s16x4(&r[0], &r[2]);
+  od_mc_butterfly_s16x4(&r[1], &r[3]);
+}
+
+OD_SIMD_INLINE void od_transpose4_s16(int16x4_t r[4]) {
+  int16x4x2_t a;
+  int16x4x2_t b;
+  int32x2x2_t c;
+  int32x2x2_t d;
+  a = vtrn_s16(r[0], r[1]);
+  b = vtrn_s16(r[2], r[3]);
+  c = vtrn_s32(vreinterpret_s32_s16(a.val[0]),
+   vreinterpret_s32_s16(b.val[0]));
+  d = vtrn_s32(vreinterpret_s32_s16(a.val[1]),
+   vreinterpret_s32_s16(b.val[1]));
+  r[0] = vreinterpret_s16_s32(c.val[0]);
+  r[1] = vreinterpret_s16_s32(d.val[0]);
+  r[2] = vreinterpret_s16_s32(c.val[1]);
+  r[3] = vreinterpret_s16_s32(d.val[1]);
+}
+
+OD_SIMD_INLINE void od_mc_butterfly_s16x8(int16x8_t *a, int16x8_t *b) {
+  int16x8_t t;
+  t = vsubq_s16(*a, *b);
+  *a = vaddq_s16(*a, *b);
+  *b = t;
+}
+
+OD_SIMD_INLINE void od_mc_butterfly_s32x4(int32x4_t *a, int32x4_t *b) {
+  int32x4_t t;
+  t = vsubq_s32(*a, *b);
+  *a = vaddq_s32(*a, *b);
+  *b = t;
+}
+
+OD_SIMD_INLINE void od_mc_hadamard8_s16(int16x8_t r[8]) {
+  int s;
+  int i;
+  for (s = 1; s < 8; s <<= 1) {
+    for (i = 0; i < 8; i++) {
+      if (!(i & s)) od_mc_butterfly_s16x8(&r[i], &r[i + s]);
+    }
+  }
+}
+
+OD_SIMD_INLINE void od_mc_hadamard8_s32(int32x4_t r[8]) {
+  int s;
+  int i;
+  for (s = 1; s < 8; s <<= 1) {
+    for (i = 0; i < 8; i++) {
+      if (!(i & s)) od_mc_butterfly_s32x4(&r[i], &r[i + s]);
+    }
+  }
+}
+
+OD_SIMD_INLINE void od_transpose8_s16(int16x8_t r[8]) {
+  int16x8x2_t a0;
+  int16x8x2_t a1;
+  int16x8x2_t a2;
+  int16x8x2_t a3;
+  int32x4x2_t b0;
+  int32x4x2_t b1;
+  int32x4x2_t b2;
+  int32x4x2_t b3;
+  a0 = vtrnq_s16(r[0], r[1]);
+  a1 = vtrnq_s16(r[2], r[3]);
+  a2 = vtrnq_s16(r[4], r[5]);
+  a3 = vtrnq_s16(r[6], r[7]);
+  b0 = vtrnq_s32(vreinterpretq_s32_s16(a0.val[0]),
+   vreinterpretq_s32_s16(a1.val[0]));
+  b1 = vtrnq_s32(vreinterpretq_s32_s16(a0.val[1]),
+   vreinterpretq_s32_s16(a1.val[1]));
+  b2 = vtrnq_s32(vreinterpretq_s32_s16(a2.val[0]),
+   vreinterpretq_s32_s16(a3.val[0]));
+  b3 = vtrnq_s32(vreinterpretq_s32_s16(a2.val[1]),
+   vreinterpretq_s32_s16(a3.val[1]));
+  r[0] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b0.val[0]),
+   vget_low_s32(b2.val[0])));
+  r[1] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b1.val[0]),
+   vget_low_s32(b3.val[0])));
+  r[2] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b0.val[1]),
+   vget_low_s32(b2.val[1])));
+  r[3] = vreinterpretq_s16_s32(vcombine_s32(vget_low_s32(b1.val[1]),
+   vget_low_s32(b3.val[1])));
+  r[4] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b0.val[0]),
+   vget_high_s32(b2.val[0])));
+  r[5] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b1.val[0]),
+   vget_high_s32(b3.val[0])));
+  r[6] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b0.val[1]),
+   vget_high_s32(b2.val[1])));
+  r[7] = vreinterpretq_s16_s32(vcombine_s32(vget_high_s32(b1.val[1]),
+   vget_high_s32(b3.val[1])));
+}
+
+/*The 8-bit differences grow to at most 255*16 over a 4x4 transform, so it
+   stays in 16 bits.*/
+int32_t od_mc_compute_satd8_4x4_neon(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  int16x4_t r[4];
+  int32x4_t sums;
+  int32_t satd;
+  int16x8_t d;
+  d = vreinterpretq_s16_u16(vsubl_u8(od_load_u8_4x2(src, systride),
+   od_load_u8_4x2(ref, rystride)));
+  r[0] = vget_low_s16(d);
+  r[1] = vget_high_s16(d);
+  d = vreinterpretq_s16_u16(vsubl_u8(od_load_u8_4x2(src + 2*systride,
+   systride), od_load_u8_4x2(ref + 2*rystride, rystride)));
+  r[2] = vget_low_s16(d);
+  r[3] = vget_high_s16(d);
+  od_mc_hadamard4_s16(r);
+  od_transpose4_s16(r);
+  od_mc_hadamard4_s16(r);
+  sums = vpaddlq_s16(vabsq_s16(vcombine_s16(r[0], r[1])));
+  sums = vpadalq_s16(sums, vabsq_s16(vcombine_s16(r[2], r[3])));
+  satd = od_hsum_u32(vreinterpretq_u32_s32(sums));
+  satd = (satd + (1 << 2 >> 1)) >> 2;
+#if defined(OD_CHECKASM)
+  od_mc_compute_check(satd,
+   od_mc_compute_satd8_4x4_c(src, systride, ref, rystride), 4,
+   "od_mc_compute_satd");
+#endif
+  return satd;
+}
+
+/*The differences of 16-bit pixels (8 + OD_COEFF_SHIFT bits) still fit in 16
+   bits after the vertical transform, but not after the horizontal one.*/
+int32_t od_mc_compute_satd16_4x4_neon(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  int16x4_t r[4];
+  int32x4_t w[4];
+  uint32x4_t sums;
+  int32_t satd;
+  int i;
+  for (i = 0; i < 4; i++) {
+    r[i] = vsub_s16(vld1_s16((const int16_t *)(src + i*systride)),
+     vld1_s16((const int16_t *)(ref + i*rystride)));
+  }
+  od_mc_hadamard4_s16(r);
+  od_transpose4_s16(r);
+  for (i = 0; i < 4; i++) w[i] = vmovl_s16(r[i]);
+  od_mc_butterfly_s32x4(&w[0], &w[1]);
+  od_mc_butterfly_s32x4(&w[2], &w[3]);
+  od_mc_butterfly_s32x4(&w[0], &w[2]);
+  od_mc_butterfly_s32x4(&w[1], &w[3]);
+  sums = vreinterpretq_u32_s32(vabsq_s32(w[0]));
+  for (i = 1; i < 4; i++) {
+    sums = vaddq_u32(sums, vreinterpretq_u32_s32(vabsq_s32(w[i])));
+  }
+  satd = od_hsum_u32(sums);
+  satd = (satd + (1 << (2 + OD_COEFF_SHIFT) >> 1)) >> (2 + OD_COEFF_SHIFT);
+#if defined(OD_CHECKASM)
+  od_mc_compute_check(satd,
+   od_mc_compute_satd16_4x4_c(src, systride, ref, rystride), 4,
+   "od_mc_compute_satd16");
+#endif
+  return satd;
+}
+
+/*The 8-bit differences grow to at most 255*64 over an 8x8 transform, so it
+   stays in 16 bits.*/
+OD_SIMD_INLINE int32_t od_mc_compute_satd8_8x8_part(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  int16x8_t r[8];
+  uint32x4_t sums;
+  int i;
+  for (i = 0; i < 8; i++) {
+    r[i] = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(src + i*systride),
+     vld1_u8(ref + i*rystride)));
+  }
+  od_mc_hadamard8_s16(r);
+  od_transpose8_s16(r);
+  od_mc_hadamard8_s16(r);
+  sums = vdupq_n_u32(0);
+  for (i = 0; i < 8; i++) {
+    sums = vpadalq_u16(sums, vreinterpretq_u16_s16(vabsq_s16(r[i])));
+  }
+  return (od_hsum_u32(sums) + (1 << 3 >> 1)) >> 3;
+}
+
+/*Only the horizontal transform of the 16-bit differences needs 32 bits.*/
+OD_SIMD_INLINE int32_t od_mc_compute_satd16_8x8_part(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  int16x8_t r[8];
+  int32x4_t lo[8];
+  int32x4_t hi[8];
+  uint32x4_t sums;
+  int i;
+  for (i = 0; i < 8; i++) {
+    r[i] = vsubq_s16(vld1q_s16((const int16_t *)(src + i*systride)),
+     vld1q_s16((const int16_t *)(ref + i*rystride)));
+  }
+  od_mc_hadamard8_s16(r);
+  od_transpose8_s16(r);
+  for (i = 0; i < 8; i++) {
+    lo[i] = vmovl_s16(vget_low_s16(r[i]));
+    hi[i] = vmovl_s16(vget_high_s16(r[i]));
+  }
+  od_mc_hadamard8_s32(lo);
+  od_mc_hadamard8_s32(hi);
+  sums = vdupq_n_u32(0);
+  for (i = 0; i < 8; i++) {
+    sums = vaddq_u32(sums, vreinterpretq_u32_s32(vabsq_s32(lo[i])));
+    sums = vaddq_u32(sums, vreinterpretq_u32_s32(vabsq_s32(hi[i])));
+  }
+  return (od_hsum_u32(sums) + (1 << (3 + OD_COEFF_SHIFT) >> 1))
+   >> (3 + OD_COEFF_SHIFT);
+}
+
+/*Perform SATD on 8x8 blocks within src and ref then sum the results of
+   each one.*/
+OD_SIMD_INLINE int32_t od_mc_compute_satd_nxn_neon(int ln, int xstride,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  int32_t satd;
+  int n;
+  int i;
+  int j;
+  n = 1 << ln;
+  satd = 0;
+  for (i = 0; i < n; i += 8) {
+    for (j = 0; j < n; j += 8) {
+      if (xstride == 2) {
+        satd += od_mc_compute_satd16_8x8_part(src + i*systride + 2*j,
+         systride, ref + i*rystride + 2*j, rystride);
+      }
+      else {
+        satd += od_mc_compute_satd8_8x8_part(src + i*systride + j,
+         systride, ref + i*rystride + j, rystride);
+      }
+    }
+  }
+  return satd;
+}
+
+#if defined(OD_CHECKASM)
+# define OD_MC_SATD_CHECK(bits, n, satd) \
+  od_mc_compute_check(satd, od_mc_compute_satd ## bits ## _ ## n ## x ## n ## \
+   _c(src, systride, ref, rystride), n, "od_mc_compute_satd" #bits)
+#else
+# define OD_MC_SATD_CHECK(bits, n, satd)
+#endif
+
+#define OD_MC_COMPUTE_SATD_NEON(bits, xstride, ln, n) \
+int32_t od_mc_compute_satd ## bits ## _ ## n ## x ## n ## _neon( \
+ const unsigned char *src, int systride, \
+ const unsigned char *ref, int rystride) { \
+  int32_t satd; \
+  satd = od_mc_compute_satd_nxn_neon(ln, xstride, src, systride, \
+   ref, rystride); \
+  OD_MC_SATD_CHECK(bits, n, satd); \
+  return satd; \
+}
+
+OD_MC_COMPUTE_SATD_NEON(8, 1, 3, 8)
+OD_MC_COMPUTE_SATD_NEON(8, 1, 4, 16)
+OD_MC_COMPUTE_SATD_NEON(8, 1, 5, 32)
+OD_MC_COMPUTE_SATD_NEON(8, 1, 6, 64)
+OD_MC_COMPUTE_SATD_NEON(16, 2, 3, 8)
+OD_MC_COMPUTE_SATD_NEON(16, 2, 4, 16)
+OD_MC_COMPUTE_SATD_NEON(16, 2, 5, 32)
+OD_MC_COMPUTE_SATD_NEON(16, 2, 6, 64)
+
+#endif
@@ -0,0 +1,173 @@
+/*Daala video codec
+Copyright (c) 2006-2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#if defined(HAVE_CONFIG_H)
+# include "config.h"
+#endif
+
+#include "armint.h"
+#include "cpu.h"
+
+#if defined(OD_ARMASM)
+#include <arm_neon.h>
+
+/*Reference/coefficient conversions.
+  Each of these handles a multiple of 16 (or 8) columns and leaves the rest
+   to the C version.*/
+
+void od_ref_buf_to_coeff8_neon(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  int16x8_t shift;
+  int16x8_t bias;
+  int w16;
+  int x;
+  int y;
+  w16 = w & ~15;
+  shift = vdupq_n_s16(coeff_shift);
+  bias = vdupq_n_s16(128);
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w16; x += 16) {
+      uint8x16_t p;
+      int16x8_t lo;
+      int16x8_t hi;
+      od_coeff *d;
+      p = vld1q_u8(src + y*src_ystride + x);
+      /*(src - 128) << coeff_shift fits in 16 bits for coeff_shift <= 4.*/
+      lo = vshlq_s16(vsubq_s16(vreinterpretq_s16_u16(
+       vmovl_u8(vget_low_u8(p))), bias), shift);
+      hi = vshlq_s16(vsubq_s16(vreinterpretq_s16_u16(
+       vmovl_u8(vget_high_u8(p))), bias), shift);
+      d = dst + y*dst_ystride + x;
+      vst1q_s32(d, vmovl_s16(vget_low_s16(lo)));
+      vst1q_s32(d + 4, vmovl_s16(vget_high_s16(lo)));
+      vst1q_s32(d + 8, vmovl_s16(vget_low_s16(hi)));
+      vst1q_s32(d + 12, vmovl_s16(vget_high_s16(hi)));
+    }
+  }
+  if (w16 < w) {
+    od_ref_buf_to_coeff8_c(dst + w16, dst_ystride,
+     src + w16, src_ystride, coeff_shift, w - w16, h);
+  }
+}
+
+void od_ref_buf_to_coeff16_neon(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  int32x4_t shift;
+  int32x4_t bias;
+  int w8;
+  int x;
+  int y;
+  w8 = w & ~7;
+  shift = vdupq_n_s32(-coeff_shift);
+  bias = vdupq_n_s32((1 << coeff_shift >> 1)
+   - (1 << (8 + OD_COEFF_SHIFT) >> 1));
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w8; x += 8) {
+      int16x8_t p;
+      od_coeff *d;
+      p = vld1q_s16((const int16_t *)(src + y*src_ystride) + x);
+      d = dst + y*dst_ystride + x;
+      vst1q_s32(d, vshlq_s32(vaddw_s16(bias, vget_low_s16(p)), shift));
+      vst1q_s32(d + 4, vshlq_s32(vaddw_s16(bias, vget_high_s16(p)), shift));
+    }
+  }
+  if (w8 < w) {
+    od_ref_buf_to_coeff16_c(dst + w8, dst_ystride,
+     src + 2*w8, src_ystride, coeff_shift, w - w8, h);
+  }
+}
+
+void od_coeff_to_ref_buf8_neon(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h) {
+  int32x4_t shift;
+  int32x4_t round;
+  int32x4_t bias;
+  int w16;
+  int x;
+  int y;
+  w16 = w & ~15;
+  shift = vdupq_n_s32(-coeff_shift);
+  round = vdupq_n_s32(1 << coeff_shift >> 1);
+  bias = vdupq_n_s32(128);
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w16; x += 16) {
+      const od_coeff *s;
+      int32x4_t p0;
+      int32x4_t p1;
+      int32x4_t p2;
+      int32x4_t p3;
+      s = src + y*src_ystride + x;
+      p0 = vaddq_s32(vshlq_s32(vaddq_s32(vld1q_s32(s), round), shift), bias);
+      p1 = vaddq_s32(vshlq_s32(vaddq_s32(vld1q_s32(s + 4), round), shift),
+       bias);
+      p2 = vaddq_s32(vshlq_s32(vaddq_s32(vld1q_s32(s + 8), round), shift),
+       bias);
+      p3 = vaddq_s32(vshlq_s32(vaddq_s32(vld1q_s32(s + 12), round), shift),
+       bias);
+      /*The two saturating narrows clamp to [0, 255] like OD_CLAMP255().*/
+      vst1q_u8(dst + y*dst_ystride + x, vcombine_u8(
+       vqmovun_s16(vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1))),
+       vqmovun_s16(vcombine_s16(vqmovn_s32(p2), vqmovn_s32(p3)))));
+    }
+  }
+  if (w16 < w) {
+    od_coeff_to_ref_buf8_c(dst + w16, dst_ystride,
+     src + w16, src_ystride, coeff_shift, w - w16, h);
+  }
+}
+
+void od_coeff_to_ref_buf16_neon(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h) {
+  int32x4_t shift;
+  int32x4_t bias;
+  int16x8_t zero;
+  int16x8_t max;
+  int w8;
+  int x;
+  int y;
+  w8 = w & ~7;
+  shift = vdupq_n_s32(coeff_shift);
+  bias = vdupq_n_s32(128 << OD_COEFF_SHIFT);
+  zero = vdupq_n_s16(0);
+  max = vdupq_n_s16((1 << (8 + OD_COEFF_SHIFT)) - 1);
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w8; x += 8) {
+      const od_coeff *s;
+      int32x4_t p0;
+      int32x4_t p1;
+      s = src + y*src_ystride + x;
+      p0 = vaddq_s32(vshlq_s32(vld1q_s32(s), shift), bias);
+      p1 = vaddq_s32(vshlq_s32(vld1q_s32(s + 4), shift), bias);
+      /*Saturating to 16 bits first does not change the clamped result.*/
+      vst1q_s16((int16_t *)(dst + y*dst_ystride) + x, vminq_s16(vmaxq_s16(
+       vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1)), zero), max));
+    }
+  }
+  if (w8 < w) {
+    od_coeff_to_ref_buf16_c(dst + 2*w8, dst_ystride,
+     src + w8, src_ystride, coeff_shift, w - w8, h);
+  }
+}
+
+#endif
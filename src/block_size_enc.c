@@ -46,6 +46,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
    used to square integers, but not circles. */
 #define OD_SQUARE(x) ((int)(x)*(int)(x))
 
+const od_block_size_opt_vtbl OD_BLOCK_SIZE_VTBL_C = {
+  od_compute_stats_c,
+  od_psy_log_sum_c
+};
+
 /* Compute statistics used to determine how to split a superblock.
  * @param [in]      img    Image on which to compute the statistics, a margin
  *                          of OD_MAX_OVERLAP pixels is required around the
@@ -53,7 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
  * @param [in]      stride Image stride
  * @param [out]     stats  Computed statistics
  */
-static void od_compute_stats(const signed char *img, int stride,
+void od_compute_stats_c(const signed char *img, int stride,
  od_superblock_stats *stats) {
   const signed char *x;
   int i;
@@ -130,6 +135,38 @@ static void od_compute_stats(const signed char *img, int stride,
   }
 }
 
+/* Approximates log2(t) - 14 in Q(OD_PSY_LOG2_SHIFT) for
+ *  16384 <= t < 1 << 28, truncating t to 16 significant bits.
+ */
+static int32_t od_psy_log2(int32_t t) {
+  int32_t x;
+  int e;
+  OD_ASSERT(t >= 16384 && t < 1 << 28);
+  e = OD_ILOG(t) - 1;
+  x = (int32_t)(((uint32_t)t << (31 - e)) >> 16) & 0x7FFF;
+  x += x*(OD_PSY_LOG2_C1 + (x*(OD_PSY_LOG2_C2 + (x*(OD_PSY_LOG2_C3
+   + (x*(OD_PSY_LOG2_C4 + (x*OD_PSY_LOG2_C5 >> 15)) >> 15)) >> 15)) >> 15))
+   >> 15;
+  return ((e - 14) << OD_PSY_LOG2_SHIFT) + x;
+}
+
+/* Sums log2(1 + noise*inv_var/16384) over an n x n window of inverse
+ *  variances, in Q(OD_PSY_LOG2_SHIFT).
+ */
+int32_t od_psy_log_sum_c(const int32_t *inv_var, int stride, int n,
+ int32_t noise) {
+  int32_t sum;
+  int i;
+  int j;
+  sum = 0;
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j++) {
+      sum += od_psy_log2(16384 + noise*inv_var[i*stride + j]);
+    }
+  }
+  return sum;
+}
+
 /* Number of overlapping 4x4 blocks along one direction of the block. */
 static int od_count_overlapping4x4(int bsize) {
   int non_overlapped_count_4x4;
@@ -222,10 +259,8 @@ static int od_noise_var4x4(od_superblock_stats *img_stats,
  * @param x         x offset of the block inside the 32x32 superblock
  * @param noise     Noise of the block
  */
-static float od_psy_var4x4(od_superblock_stats *psy_stats,
- int bsize, int y, int x, int noise) {
-  int i;
-  int j;
+static float od_psy_var4x4(const od_block_size_opt_vtbl *vtbl,
+ od_superblock_stats *psy_stats, int bsize, int y, int x, int noise) {
   int length;
   int overlap;
   float psy;
@@ -235,13 +270,9 @@ static float od_psy_var4x4(od_superblock_stats *psy_stats,
   length = od_count_overlapping4x4(bsize);
   overlap = od_overlap_var4x4[bsize];
   count = length + 2*overlap;
-  psy = 0;
-  for (i = -overlap; i < length + overlap; i++) {
-    for (j = -overlap; j < length + overlap; j++) {
-      psy += OD_LOG2(1 + noise*psy_stats->invVar4
-       [OD_MAX_OVERLAP + y/2 + i][OD_MAX_OVERLAP + x/2 + j]/16384.f);
-    }
-  }
+  psy = (*vtbl->psy_log_sum)(&psy_stats->invVar4
+   [OD_MAX_OVERLAP + y/2 - overlap][OD_MAX_OVERLAP + x/2 - overlap],
+   OD_SIZE4_SUMS, count, noise)*(1.f/(1 << OD_PSY_LOG2_SHIFT));
   return OD_MAXF(psy/(count*count) - 1.f, 0);
 }
 
@@ -288,10 +319,8 @@ static int od_noise_var8x8(od_superblock_stats *img_stats,
 }
 
 /* Same as `od_psy_var4x4` but using overlapping 8x8 blocks. */
-static float od_psy_var8x8(od_superblock_stats *psy_stats,
- int bsize, int y, int x, int noise) {
-  int i;
-  int j;
+static float od_psy_var8x8(const od_block_size_opt_vtbl *vtbl,
+ od_superblock_stats *psy_stats, int bsize, int y, int x, int noise) {
   int length;
   int overlap;
   float psy;
@@ -302,13 +331,9 @@ static float od_psy_var8x8(od_superblock_stats *psy_stats,
   length = od_count_overlapping8x8(bsize);
   overlap = od_overlap_var8x8[bsize];
   count = length + 2*overlap;
-  psy = 0;
-  for (i = -overlap; i < length + overlap; i++) {
-    for (j = -overlap; j < length + overlap; j++) {
-      psy += OD_LOG2(1 + noise*psy_stats->invVar8
-       [OD_MAX_OVERLAP_8 + y/4 + i][OD_MAX_OVERLAP_8 + x/4 + j]/16384.f);
-    }
-  }
+  psy = (*vtbl->psy_log_sum)(&psy_stats->invVar8
+   [OD_MAX_OVERLAP_8 + y/4 - overlap][OD_MAX_OVERLAP_8 + x/4 - overlap],
+   OD_SIZE8_SUMS, count, noise)*(1.f/(1 << OD_PSY_LOG2_SHIFT));
   return OD_MAXF(psy/(count*count) - 1.f, 0);
 }
 
@@ -316,6 +341,7 @@ static float od_psy_var8x8(od_superblock_stats *psy_stats,
  * activity masking model. The masking at any given point is assumed to be
  * proportional to the local variance. The decision is made using a simple
  * dynamic programming algorithm, working from 8x8 decisions up to 32x32.
+ * @param [in]      vtbl        Optimized statistics functions
  * @param [scratch] bs          Scratch space for computation
  * @param [in]      psy_img     Image on which to compute the psy model
  *                               (should not be a residual)
@@ -328,8 +354,8 @@ static float od_psy_var8x8(od_superblock_stats *psy_stats,
  *                               possible values)
  * @param [in]      q           Quality tuning parameter
  */
-void od_split_superblock(od_block_size_comp *bs,
- const unsigned char *psy_img, int stride,
+void od_split_superblock(const od_block_size_opt_vtbl *vtbl,
+ od_block_size_comp *bs, const unsigned char *psy_img, int stride,
  const unsigned char *pred, int pred_stride,
   int bsize[OD_BSIZE_GRID][OD_BSIZE_GRID], int q) {
   int i;
@@ -351,7 +377,7 @@ void od_split_superblock(od_block_size_comp *bs,
   }
   cg4 = OD_CG4;
   cg8 = OD_CG8;
-  od_compute_stats(&bs->res[2*OD_MAX_OVERLAP][2*OD_MAX_OVERLAP],
+  (*vtbl->compute_stats)(&bs->res[2*OD_MAX_OVERLAP][2*OD_MAX_OVERLAP],
    2*OD_SIZE2_SUMS, &bs->psy_stats);
   if (psy_img == pred || pred == NULL) {
     OD_COPY(&bs->img_stats, &bs->psy_stats, 1);
@@ -367,7 +393,7 @@ void od_split_superblock(od_block_size_comp *bs,
          - (int)p0[i*pred_stride + j], 127);
       }
     }
-    od_compute_stats(&bs->res[2*OD_MAX_OVERLAP][2*OD_MAX_OVERLAP],
+    (*vtbl->compute_stats)(&bs->res[2*OD_MAX_OVERLAP][2*OD_MAX_OVERLAP],
      2*OD_SIZE2_SUMS, &bs->img_stats);
   }
   /* Compute 4x4 masking */
@@ -375,7 +401,7 @@ void od_split_superblock(od_block_size_comp *bs,
     for (j = 0; j < 8; j++) {
       bs->noise4_4[i][j] = od_noise_var4x4(&bs->img_stats,
        OD_BLOCK_4X4, 4*i, 4*j);
-      bs->psy4[i][j] = od_psy_var4x4(&bs->psy_stats,
+      bs->psy4[i][j] = od_psy_var4x4(vtbl, &bs->psy_stats,
        OD_BLOCK_4X4, 4*i, 4*j, bs->noise4_4[i][j]);
     }
   }
@@ -386,7 +412,7 @@ void od_split_superblock(od_block_size_comp *bs,
       float psy4_avg;
       bs->noise4_8[i][j] = od_noise_var4x4(&bs->img_stats,
         OD_BLOCK_8X8, 8*i, 8*j);
-      bs->psy8[i][j] = od_psy_var4x4(&bs->psy_stats,
+      bs->psy8[i][j] = od_psy_var4x4(vtbl, &bs->psy_stats,
        OD_BLOCK_8X8, 8*i, 8*j, bs->noise4_8[i][j]);
       psy4_avg = .25f*(bs->psy4[2*i][2*j] + bs->psy4[2*i][2*j + 1]
        + bs->psy4[2*i + 1][2*j] + bs->psy4[2*i + 1][2*j + 1]);
@@ -410,12 +436,12 @@ void od_split_superblock(od_block_size_comp *bs,
       float gain8_avg;
       bs->noise4_16[i][j] = od_noise_var4x4(&bs->img_stats,
        OD_BLOCK_16X16, 16*i, 16*j);
-      bs->psy16[i][j] = od_psy_var4x4(&bs->psy_stats,
+      bs->psy16[i][j] = od_psy_var4x4(vtbl, &bs->psy_stats,
        OD_BLOCK_16X16, 16*i, 16*j, bs->noise4_16[i][j]);
       bs->noise8_16[i][j] = od_noise_var8x8(&bs->img_stats,
        OD_BLOCK_16X16, 16*i, 16*j);
       bs->psy16[i][j] = OD_MAXF(bs->psy16[i][j], PSY8_FUDGE*
-       od_psy_var8x8(&bs->psy_stats, OD_BLOCK_16X16, 16*i, 16*j,
+       od_psy_var8x8(vtbl, &bs->psy_stats, OD_BLOCK_16X16, 16*i, 16*j,
        bs->noise8_16[i][j]));
       gain8_avg = .25*(bs->dec_gain8[2*i][2*j] + bs->dec_gain8[2*i][2*j + 1]
        + bs->dec_gain8[2*i + 1][2*j] + bs->dec_gain8[2*i + 1][2*j + 1]);
@@ -439,11 +465,12 @@ void od_split_superblock(od_block_size_comp *bs,
     float gain32;
     float gain16_avg;
     bs->noise4_32 = od_noise_var4x4(&bs->img_stats, OD_BLOCK_32X32, 0, 0);
-    bs->psy32 = od_psy_var4x4(&bs->psy_stats,
+    bs->psy32 = od_psy_var4x4(vtbl, &bs->psy_stats,
      OD_BLOCK_32X32, 0, 0, bs->noise4_32);
     bs->noise8_32 = od_noise_var8x8(&bs->img_stats, OD_BLOCK_32X32, 0, 0);
     bs->psy32 = OD_MAXF(bs->psy32, PSY8_FUDGE*
-     od_psy_var8x8(&bs->psy_stats, OD_BLOCK_32X32, 0, 0, bs->noise8_32));
+     od_psy_var8x8(vtbl, &bs->psy_stats, OD_BLOCK_32X32, 0, 0,
+     bs->noise8_32));
     gain16_avg = .25f*(bs->dec_gain16[0][0] + bs->dec_gain16[0][1]
      + bs->dec_gain16[1][0] + bs->dec_gain16[1][1]);
     gain32 = OD_CG32 - psy_lambda*(bs->psy32);
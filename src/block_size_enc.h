@@ -112,8 +112,37 @@ typedef struct {
   float dec_gain16[2][2];
 } od_block_size_comp;
 
-void od_split_superblock(od_block_size_comp *bs,
- const unsigned char *psy_img, int stride,
+/*Number of fractional bits of the log2 sums returned by psy_log_sum.*/
+# define OD_PSY_LOG2_SHIFT (15)
+
+/*Coefficients in Q15 of the polynomial approximation of log2(1 + x) over
+   [0, 1) used by psy_log_sum (the same one as od_log2() in pvq.c).*/
+# define OD_PSY_LOG2_C1 (14482)
+# define OD_PSY_LOG2_C2 (-23234)
+# define OD_PSY_LOG2_C3 (13643)
+# define OD_PSY_LOG2_C4 (-6403)
+# define OD_PSY_LOG2_C5 (1515)
+
+typedef void (*od_compute_stats_func)(const signed char *img, int stride,
+ od_superblock_stats *stats);
+typedef int32_t (*od_psy_log_sum_func)(const int32_t *inv_var, int stride,
+ int n, int32_t noise);
+
+struct od_block_size_opt_vtbl {
+  od_compute_stats_func compute_stats;
+  od_psy_log_sum_func psy_log_sum;
+};
+typedef struct od_block_size_opt_vtbl od_block_size_opt_vtbl;
+
+extern const od_block_size_opt_vtbl OD_BLOCK_SIZE_VTBL_C;
+
+void od_compute_stats_c(const signed char *img, int stride,
+ od_superblock_stats *stats);
+int32_t od_psy_log_sum_c(const int32_t *inv_var, int stride, int n,
+ int32_t noise);
+
+void od_split_superblock(const od_block_size_opt_vtbl *vtbl,
+ od_block_size_comp *bs, const unsigned char *psy_img, int stride,
  const unsigned char *pred, int pred_stride,
   int dec[OD_BSIZE_GRID][OD_BSIZE_GRID], int q);
 
@@ -4919,6 +4919,150 @@ void od_bin_idct64x64(od_coeff *x, int xstride,
   for (i = 0; i < 64; i++) od_bin_idct64(x + i, xstride, z + 64*i);
 }
 
+/*Returns one more than the index of the last row of an n x n block of
+   coefficients that contains a nonzero value, or 0 if the block is all zero.*/
+static int od_coeff_nonzero_rows(const od_coeff *y, int ystride, int n) {
+  int i;
+  int j;
+  for (i = n; i-- > 0;) {
+    const od_coeff *row;
+    od_coeff acc;
+    row = y + ystride*i;
+    acc = 0;
+    /*n is always a multiple of 4.*/
+    for (j = 0; j < n; j += 4) {
+      acc |= row[j] | row[j + 1] | row[j + 2] | row[j + 3];
+    }
+    if (acc) return i + 1;
+  }
+  return 0;
+}
+
+/*The number of distinct columns we are willing to transform in the DC-only
+   path before giving up and running the full transform.
+  In practice the first pass of a DC-only block produces only 2 or 3 distinct
+   values.*/
+#define OD_IDCT_DC_NCOLS_MAX (4)
+
+/*Inverse transforms a block whose only nonzero coefficient is the DC.
+  The first pass reduces to a single 1-D transform of the DC, and each output
+   column is then the 1-D transform of a lone DC value from that result, of
+   which there are only a few distinct ones.
+  Returns 0 (without writing x) if there are too many distinct columns.*/
+static int od_bin_idct_2d_dc(od_coeff *x, int xstride, od_coeff dc, int ln) {
+  od_idct_func_1d idct;
+  od_coeff t[OD_BSIZE_MAX];
+  od_coeff z[OD_BSIZE_MAX];
+  od_coeff cols[OD_IDCT_DC_NCOLS_MAX][OD_BSIZE_MAX];
+  od_coeff vals[OD_IDCT_DC_NCOLS_MAX];
+  unsigned char map[OD_BSIZE_MAX];
+  int rows[OD_IDCT_DC_NCOLS_MAX];
+  int ncols;
+  int nrows;
+  int n;
+  int i;
+  int j;
+  int k;
+  int r;
+  idct = OD_IDCT_1D[ln];
+  n = 4 << ln;
+  t[0] = dc;
+  OD_CLEAR(t + 1, n - 1);
+  (*idct)(z, 1, t);
+  ncols = 0;
+  for (i = 0; i < n; i++) {
+    for (k = 0; k < ncols && vals[k] != z[i]; k++);
+    if (k == ncols) {
+      if (ncols >= OD_IDCT_DC_NCOLS_MAX) return 0;
+      vals[ncols++] = z[i];
+    }
+    map[i] = (unsigned char)k;
+  }
+  for (k = 0; k < ncols; k++) {
+    t[0] = vals[k];
+    (*idct)(cols[k], 1, t);
+  }
+  /*The rows of the output only depend on which values the transformed
+     columns take in that row, and those repeat just as often, so copy any
+     row we have already built.*/
+  nrows = 0;
+  for (j = 0; j < n; j++) {
+    od_coeff *row;
+    row = x + xstride*j;
+    for (r = 0; r < nrows; r++) {
+      for (k = 0; k < ncols && cols[k][j] == cols[k][rows[r]]; k++);
+      if (k == ncols) break;
+    }
+    if (r < nrows) OD_COPY(row, x + xstride*rows[r], n);
+    else {
+      for (k = 0; k < ncols; k++) vals[k] = cols[k][j];
+      for (i = 0; i < n; i++) row[i] = vals[map[i]];
+      if (nrows < OD_IDCT_DC_NCOLS_MAX) rows[nrows++] = j;
+    }
+  }
+  return 1;
+}
+
+/*Inverse transforms a block in which only the first nrows rows of
+   coefficients can be nonzero, using the generic C 1-D transforms.
+  The all-zero rows produce all-zero columns in the first pass, so they are
+   skipped, and only the first nrows inputs of each row of the second pass
+   need to be copied.*/
+static void od_bin_idct_2d_rows(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride, int ln, int nrows) {
+  od_idct_func_1d idct;
+  od_coeff z[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  od_coeff t[OD_BSIZE_MAX];
+  int n;
+  int i;
+  idct = OD_IDCT_1D[ln];
+  n = 4 << ln;
+  for (i = 0; i < nrows; i++) (*idct)(z + i, n, y + ystride*i);
+  OD_CLEAR(t + nrows, n - nrows);
+  for (i = 0; i < n; i++) {
+    OD_COPY(t, z + n*i, nrows);
+    (*idct)(x + i, xstride, t);
+  }
+}
+
+/*The smallest block size for which the DC-only path beats the SIMD versions
+   of the full transform (32x32).*/
+#define OD_IDCT_DC_LN_MIN (3)
+
+void od_bin_idct_2d_sparse(od_dct_func_2d idct_2d, od_coeff *x, int xstride,
+ const od_coeff *y, int ystride, int ln) {
+  int generic;
+  int n;
+  int nrows;
+  int i;
+  OD_ASSERT(ln >= 0 && ln < OD_NBSIZES);
+  generic = idct_2d == OD_IDCT_2D_C[ln];
+  /*Only the DC-only and all-zero cases can beat an optimized transform, and
+     the lowest AC coefficients are enough to rule those out cheaply.*/
+  if (!generic && (ln < OD_IDCT_DC_LN_MIN || y[1] != 0 || y[ystride] != 0)) {
+    (*idct_2d)(x, xstride, y, ystride);
+    return;
+  }
+  n = 4 << ln;
+  nrows = od_coeff_nonzero_rows(y, ystride, n);
+  if (nrows == 0) {
+    /*The transform maps zero to zero exactly.*/
+    for (i = 0; i < n; i++) OD_CLEAR(x + xstride*i, n);
+    return;
+  }
+  if (nrows == 1) {
+    for (i = 1; i < n && y[i] == 0; i++);
+    if (i == n && od_bin_idct_2d_dc(x, xstride, y[0], ln)) return;
+  }
+  /*The reduced transform is plain C, so it only helps when the full
+     transform would be too.*/
+  if (generic && nrows <= n >> 1) {
+    od_bin_idct_2d_rows(x, xstride, y, ystride, ln, nrows);
+    return;
+  }
+  (*idct_2d)(x, xstride, y, ystride);
+}
+
 #if defined(OD_CHECKASM)
 # include <stdio.h>
 
@@ -8822,6 +8966,46 @@ static void dynamic_range(int bszi) {
 
 # endif
 
+/*Checks that od_bin_idct_2d_sparse() matches the full transform on blocks
+   with only a few leading rows of coefficients, including DC-only blocks.*/
+static void check_sparse(int bszi) {
+  od_coeff block[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  od_coeff coefs[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  od_coeff refout[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  od_coeff testout[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  int nrows;
+  int iter;
+  int impl;
+  int i;
+  int n;
+  n = 1 << (OD_LOG_BSIZE0 + bszi);
+  ieee1180_srand(1);
+  for (iter = 0; iter < 1000; iter++) {
+    for (i = 0; i < n*n; i++) {
+      block[i] = ieee1180_rand(255, 255)*OD_COEFF_SCALE;
+    }
+    (*test_fdct_2d[bszi])(coefs, n, block, n);
+    /*Cycle through the DC-only case (nrows == -1), the all-zero case and a
+       range of row counts on both sides of each threshold.*/
+    nrows = iter % (n/2 + 3) - 1;
+    if (nrows < 0) OD_CLEAR(coefs + 1, n*n - 1);
+    else OD_CLEAR(coefs + n*nrows, n*(n - nrows));
+    (*test_idct_2d[bszi])(refout, n, coefs, n);
+    for (impl = 0; impl < 2; impl++) {
+      od_bin_idct_2d_sparse(impl ? OD_IDCT_2D_C[bszi] : test_idct_2d[bszi],
+       testout, n, coefs, n, bszi);
+      for (i = 0; i < n*n; i++) {
+        if (testout[i] != refout[i]) {
+          od_exit_code = EXIT_FAILURE;
+          printf("Sparse %ix%i iDCT mismatch (%s, %i rows) at %i: %i != %i\n",
+           n, n, impl ? "C" : "optimized", nrows, i, testout[i], refout[i]);
+          break;
+        }
+      }
+    }
+  }
+}
+
 static void check_transform(int bszi) {
   od_coeff min[OD_BSIZE_MAX];
   od_coeff max[OD_BSIZE_MAX];
@@ -8927,6 +9111,7 @@ static void check_transform(int bszi) {
   printf("MSE: %.32g\n\n", compute_mse(basis, tbasis, bszi));
   ieee1180_test(bszi);
   check_bias(bszi);
+  check_sparse(bszi);
 }
 
 void run_test(void) {
@@ -8945,16 +9130,16 @@ int main(void) {
     static const od_dct_func_2d OD_FDCT_2D_SSE2[OD_NBSIZES + 1] = {
       od_bin_fdct4x4_sse2,
       od_bin_fdct8x8,
-      od_bin_fdct16x16,
-      od_bin_fdct32x32,
-      od_bin_fdct64x64
+      od_bin_fdct16x16_sse2,
+      od_bin_fdct32x32_sse2,
+      od_bin_fdct64x64_sse2
     };
     static const od_dct_func_2d OD_IDCT_2D_SSE2[OD_NBSIZES + 1] = {
       od_bin_idct4x4_sse2,
       od_bin_idct8x8,
-      od_bin_idct16x16,
-      od_bin_idct32x32,
-      od_bin_idct64x64
+      od_bin_idct16x16_sse2,
+      od_bin_idct32x32_sse2,
+      od_bin_idct64x64_sse2
     };
     test_fdct_2d = OD_FDCT_2D_SSE2;
     test_idct_2d = OD_IDCT_2D_SSE2;
@@ -8967,16 +9152,16 @@ int main(void) {
     static const od_dct_func_2d OD_FDCT_2D_SSE41[OD_NBSIZES + 1] = {
       od_bin_fdct4x4_sse41,
       od_bin_fdct8x8,
-      od_bin_fdct16x16,
-      od_bin_fdct32x32,
-      od_bin_fdct64x64
+      od_bin_fdct16x16_sse41,
+      od_bin_fdct32x32_sse41,
+      od_bin_fdct64x64_sse41
     };
     static const od_dct_func_2d OD_IDCT_2D_SSE41[OD_NBSIZES + 1] = {
       od_bin_idct4x4_sse41,
       od_bin_idct8x8,
-      od_bin_idct16x16,
-      od_bin_idct32x32,
-      od_bin_idct64x64
+      od_bin_idct16x16_sse41,
+      od_bin_idct32x32_sse41,
+      od_bin_idct64x64_sse41
     };
     test_fdct_2d = OD_FDCT_2D_SSE41;
     test_idct_2d = OD_IDCT_2D_SSE41;
@@ -8989,16 +9174,16 @@ int main(void) {
     static const od_dct_func_2d OD_FDCT_2D_AVX2[OD_NBSIZES + 1] = {
       od_bin_fdct4x4_sse41,
       od_bin_fdct8x8_avx2,
-      od_bin_fdct16x16,
-      od_bin_fdct32x32,
-      od_bin_fdct64x64
+      od_bin_fdct16x16_avx2,
+      od_bin_fdct32x32_avx2,
+      od_bin_fdct64x64_avx2
     };
     static const od_dct_func_2d OD_IDCT_2D_AVX2[OD_NBSIZES + 1] = {
       od_bin_idct4x4_sse41,
       od_bin_idct8x8_avx2,
-      od_bin_idct16x16,
-      od_bin_idct32x32,
-      od_bin_idct64x64
+      od_bin_idct16x16_avx2,
+      od_bin_idct32x32_avx2,
+      od_bin_idct64x64_avx2
     };
     test_fdct_2d = OD_FDCT_2D_AVX2;
     test_idct_2d = OD_IDCT_2D_AVX2;
@@ -9007,17 +9192,17 @@ int main(void) {
   }
 # endif
 #endif
-#if defined(OD_ARMASM)
+#if defined(OD_NEON_INTRINSICS)
   if (od_cpu_flags_get() & OD_CPU_ARM_NEON) {
     static const od_dct_func_2d OD_FDCT_2D_NEON[OD_NBSIZES + 1] = {
-      od_bin_fdct4x4,
+      od_bin_fdct4x4_neon,
       od_bin_fdct8x8,
       od_bin_fdct16x16,
       od_bin_fdct32x32,
       od_bin_fdct64x64
     };
     static const od_dct_func_2d OD_IDCT_2D_NEON[OD_NBSIZES + 1] = {
-      od_bin_idct4x4,
+      od_bin_idct4x4_neon,
       od_bin_idct8x8,
       od_bin_idct16x16,
       od_bin_idct32x32,
@@ -9025,6 +9210,7 @@ int main(void) {
     };
     test_fdct_2d = OD_FDCT_2D_NEON;
     test_idct_2d = OD_IDCT_2D_NEON;
+    printf("Testing NEON DCT...\n");
     run_test();
   }
 #endif
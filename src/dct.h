@@ -178,6 +178,14 @@ void od_bin_fdct64x64(od_coeff *y, int ystride,
 void od_bin_idct64x64(od_coeff *x, int xstride,
  const od_coeff *y, int ystride);
 
+/*Applies the 2-D inverse transform of size 4 << ln, taking shortcuts for
+   blocks where only the first few rows of coefficients are nonzero (e.g., DC
+   only blocks, which are common at low rates).
+  The result is bit-exact with the full transform; blocks that are not sparse
+   enough are simply passed to idct_2d.*/
+void od_bin_idct_2d_sparse(od_dct_func_2d idct_2d, od_coeff *x, int xstride,
+ const od_coeff *y, int ystride, int ln);
+
 void od_haar(od_coeff *y, int ystride, const od_coeff *x, int xstride, int ln);
 void od_haar_inv(od_coeff *x, int xstride, const od_coeff *y, int ystride,
  int ln);
@@ -28,11 +28,57 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 # include "state.h"
 
 typedef struct daala_dec_ctx od_dec_ctx;
+typedef struct od_dec_frame  od_dec_frame;
+typedef struct od_dec_fb     od_dec_fb;
 
 /*Constants for the packet state machine specific to the decoder.*/
 /*Next packet to read: Data packet.*/
 # define OD_PACKET_DATA (0)
 
+/*The most frame buffers from the application the decoder can hold at once:
+   one per reference image, one per frame in the output queue, the last frame
+   returned by daala_decode_img_out(), and two more for the frames being
+   decoded and finished.*/
+# define OD_DEC_NFBS (OD_NREF_IMGS + OD_MAX_REORDER + 3)
+
+/*A frame buffer from the application's pool.*/
+struct od_dec_fb {
+  daala_frame_buffer fb;
+  /*The number of references to it held by the decoder, or 0 if it is free.*/
+  int refs;
+};
+
+/*The buffers filled while entropy decoding a frame and read back while it is
+   reconstructed, filtered and stored into its reference image.
+  The latter happens on the worker threads, so with more than one thread two
+   of these alternate, and the next packet is decoded while the previous frame
+   is still being finished.*/
+struct od_dec_frame {
+  od_coeff *ctmp[OD_NPLANES_MAX];
+  od_coeff *dtmp[OD_NPLANES_MAX];
+  unsigned char *bsize;
+  unsigned char *bskip[3];
+  unsigned char *dering_level;
+  /*Whether the buffers above belong to this frame, rather than to the
+     od_state.*/
+  int owned;
+  od_state *state;
+  /*The reference image the frame is reconstructed into.*/
+  int refi;
+  /*With full precision references and application frame buffers, the
+     buffer its output image is converted into.*/
+  od_dec_fb *out_fb;
+  int number;
+  int use_haar_wavelet;
+  int quantizer;
+  int coded_quantizer;
+  /*The number of superblock rows whose inverse transforms are done.*/
+  od_progress recon;
+  /*The number of superblock rows that are postfiltered and ready to be
+     deringed.*/
+  od_progress filtered;
+};
+
 struct daala_dec_ctx {
   od_state state;
   oggbyte_buffer obb;
@@ -58,6 +104,31 @@ struct daala_dec_ctx {
   /*User provided buffer for storing the deringing filter flags per superblock.
     This is set via daala_decode_ctl with OD_DECCTL_SET_DERING_BUFFER.*/
   unsigned char *user_dering;
+  /*Decoder contexts for each tile of a frame, or NULL with a single tile.
+    Each one is refreshed from this context at the start of the tile, and
+     only owns its entropy decoder, adaptation state and CfL scratch buffers.*/
+  struct daala_dec_ctx *tiles;
+  od_coeff *tile_lbuf;
+  /*The entropy coded data of each tile in the current packet.*/
+  unsigned char *tile_data[OD_TILES_MAX];
+  uint32_t tile_bytes[OD_TILES_MAX];
+  /*The two sets of per-frame buffers; the second one is only allocated once
+     frames overlap.*/
+  od_dec_frame *frames;
+  /*The last frame submitted to the worker threads, until it has been added
+     to the output queue, or NULL.*/
+  od_dec_frame *pending;
+  /*The application's frame buffer pool, if get_buffer is not NULL.*/
+  daala_frame_buffer_funcs fb_funcs;
+  od_dec_fb fbs[OD_DEC_NFBS];
+  /*The buffer used by each reference image.*/
+  od_dec_fb *ref_fbs[OD_NREF_IMGS];
+  /*The buffer of the last image returned by daala_decode_img_out().*/
+  od_dec_fb *out_fb;
+  /*The format of output images, used with full precision references.*/
+  daala_image out_fmt;
+  /*Whether daala_decode_packet_in() has been called.*/
+  int started;
 };
 
 # if OD_ACCOUNTING
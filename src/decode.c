@@ -45,9 +45,161 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 #include "quantizer.h"
 #include "accounting.h"
 
+/*Points frame at the per-frame buffers currently used by state.*/
+static void od_dec_frame_bind(od_dec_frame *frame, const od_state *state) {
+  OD_COPY(frame->ctmp, state->ctmp, OD_NPLANES_MAX);
+  OD_COPY(frame->dtmp, state->dtmp, OD_NPLANES_MAX);
+  OD_COPY(frame->bskip, state->bskip, 3);
+  frame->bsize = state->bsize;
+  frame->dering_level = state->dering_level;
+}
+
+static void od_dec_frame_free(od_dec_frame *frame, const od_state *state) {
+  int pli;
+  if (frame->owned) {
+    for (pli = 0; pli < OD_NPLANES_MAX; pli++) {
+      free(frame->ctmp[pli]);
+      free(frame->dtmp[pli]);
+      frame->ctmp[pli] = frame->dtmp[pli] = NULL;
+    }
+    for (pli = 0; pli < 3; pli++) {
+      free(frame->bskip[pli]);
+      frame->bskip[pli] = NULL;
+    }
+    if (frame->bsize) {
+      free(frame->bsize - (OD_BSIZE_GRID*state->bstride + OD_BSIZE_GRID));
+      frame->bsize = NULL;
+    }
+    free(frame->dering_level);
+    frame->dering_level = NULL;
+    frame->owned = 0;
+  }
+}
+
+/*Allocates a second set of per-frame buffers, so that the next frame can be
+   decoded while the worker threads are still using the first one.*/
+static int od_dec_frame_alloc(od_dec_frame *frame, const od_state *state) {
+  int pli;
+  if (frame->owned) return OD_SUCCESS;
+  frame->owned = 1;
+  for (pli = 0; pli < state->info.nplanes; pli++) {
+    int xdec;
+    int ydec;
+    int w;
+    int h;
+    xdec = state->info.plane_info[pli].xdec;
+    ydec = state->info.plane_info[pli].ydec;
+    w = state->frame_width >> xdec;
+    h = state->frame_height >> ydec;
+    frame->ctmp[pli] = (od_coeff *)malloc(w*h*sizeof(*frame->ctmp[pli]));
+    frame->dtmp[pli] = (od_coeff *)malloc(w*h*sizeof(*frame->dtmp[pli]));
+    /*Same size as the od_state's buffer.*/
+    frame->bskip[pli] = (unsigned char *)malloc(sizeof(*frame->bskip)*
+     state->nhsb*state->nvsb<<(2*(OD_NBSIZES-1) - xdec - ydec));
+    if (OD_UNLIKELY(!frame->ctmp[pli] || !frame->dtmp[pli]
+     || !frame->bskip[pli])) {
+      od_dec_frame_free(frame, state);
+      return OD_EFAULT;
+    }
+  }
+  frame->bsize = (unsigned char *)malloc(sizeof(*frame->bsize)*
+   (state->nhsb + 2)*OD_BSIZE_GRID*(state->nvsb + 2)*OD_BSIZE_GRID);
+  if (OD_UNLIKELY(!frame->bsize)) {
+    od_dec_frame_free(frame, state);
+    return OD_EFAULT;
+  }
+  frame->bsize += OD_BSIZE_GRID*state->bstride + OD_BSIZE_GRID;
+  frame->dering_level = (unsigned char *)malloc(state->nhsb*state->nvsb);
+  if (OD_UNLIKELY(!frame->dering_level)) {
+    od_dec_frame_free(frame, state);
+    return OD_EFAULT;
+  }
+  return OD_SUCCESS;
+}
+
+/*Gets a buffer from the application's pool for an image in the format of
+   fmt, with border pixels of padding.*/
+static od_dec_fb *od_dec_fb_get(od_dec_ctx *dec, const daala_image *fmt,
+ int border) {
+  od_dec_fb *fb;
+  int pli;
+  int i;
+  for (i = 0; i < OD_DEC_NFBS && dec->fbs[i].refs > 0; i++);
+  if (OD_UNLIKELY(i >= OD_DEC_NFBS)) return NULL;
+  fb = dec->fbs + i;
+  OD_CLEAR(&fb->fb, 1);
+  fb->fb.img = *fmt;
+  for (pli = 0; pli < fb->fb.img.nplanes; pli++) {
+    fb->fb.img.planes[pli].data = NULL;
+    fb->fb.img.planes[pli].ystride = 0;
+  }
+  fb->fb.border = border;
+  if ((*dec->fb_funcs.get_buffer)(dec->fb_funcs.ctx, &fb->fb) < 0) {
+    return NULL;
+  }
+  for (pli = 0; pli < fb->fb.img.nplanes; pli++) {
+    daala_image_plane *iplane;
+    iplane = fb->fb.img.planes + pli;
+    if (iplane->data == NULL
+     || ((size_t)iplane->data & (OD_PADDING_ALIGN - 1))
+     || (iplane->ystride & (OD_PADDING_ALIGN - 1))
+     || iplane->ystride < ((fb->fb.img.width + 2*border) >> iplane->xdec)*
+     iplane->xstride) {
+      (*dec->fb_funcs.release_buffer)(dec->fb_funcs.ctx, &fb->fb);
+      return NULL;
+    }
+  }
+  fb->refs = 1;
+  return fb;
+}
+
+static void od_dec_fb_unref(od_dec_ctx *dec, od_dec_fb *fb) {
+  if (fb != NULL && --fb->refs == 0) {
+    (*dec->fb_funcs.release_buffer)(dec->fb_funcs.ctx, &fb->fb);
+  }
+}
+
+/*Points reference image refi at a fresh buffer from the application's pool,
+   if there is one.
+  The old buffer may still be waiting in the output queue, so it is never
+   written again.
+  Full precision references are not in the output format, so they always
+   stay in the decoder's own buffers.*/
+static int od_dec_ref_fb_attach(od_dec_ctx *dec, int refi) {
+  daala_image *img;
+  od_dec_fb *fb;
+  int pli;
+  if (dec->fb_funcs.get_buffer == NULL
+   || dec->state.info.full_precision_references) {
+    return OD_SUCCESS;
+  }
+  img = dec->state.ref_imgs + refi;
+  fb = od_dec_fb_get(dec, img, OD_BUFFER_PADDING);
+  if (OD_UNLIKELY(fb == NULL)) return OD_EFAULT;
+  od_dec_fb_unref(dec, dec->ref_fbs[refi]);
+  dec->ref_fbs[refi] = fb;
+  for (pli = 0; pli < img->nplanes; pli++) {
+    img->planes[pli].data = fb->fb.img.planes[pli].data;
+    img->planes[pli].ystride = fb->fb.img.planes[pli].ystride;
+  }
+  return OD_SUCCESS;
+}
+
+/*Hands every buffer the decoder still holds back to the application.*/
+static void od_dec_fbs_release(od_dec_ctx *dec) {
+  int i;
+  for (i = 0; i < OD_DEC_NFBS; i++) {
+    if (dec->fbs[i].refs > 0) {
+      dec->fbs[i].refs = 0;
+      (*dec->fb_funcs.release_buffer)(dec->fb_funcs.ctx, &dec->fbs[i].fb);
+    }
+  }
+}
+
 static int od_dec_init(od_dec_ctx *dec, const daala_info *info,
  const daala_setup_info *setup) {
   int ret;
+  int i;
   OD_UNUSED(setup);
   memset(dec, 0, sizeof(*dec));
   ret = od_state_init(&dec->state, info);
@@ -67,13 +219,55 @@ static int od_dec_init(od_dec_ctx *dec, const daala_info *info,
   od_accounting_init(&dec->acct);
   dec->acct_enabled = 0;
 #endif
+  dec->frames = (od_dec_frame *)calloc(2, sizeof(*dec->frames));
+  if (OD_UNLIKELY(!dec->frames)) {
+    return OD_EFAULT;
+  }
+  /*The first set of per-frame buffers is the one in the od_state.*/
+  od_dec_frame_bind(dec->frames, &dec->state);
+  for (i = 0; i < 2; i++) {
+    dec->frames[i].state = &dec->state;
+    if (OD_UNLIKELY(od_progress_init(&dec->frames[i].recon))) {
+      return OD_EFAULT;
+    }
+    if (OD_UNLIKELY(od_progress_init(&dec->frames[i].filtered))) {
+      return OD_EFAULT;
+    }
+  }
+  if (OD_NTILES(info) > 1) {
+    dec->tiles = (od_dec_ctx *)malloc(OD_NTILES(info)*sizeof(*dec->tiles));
+    dec->tile_lbuf = (od_coeff *)malloc(OD_NTILES(info)*info->nplanes*
+     OD_BSIZE_MAX*OD_BSIZE_MAX*sizeof(*dec->tile_lbuf));
+    if (OD_UNLIKELY(!dec->tiles || !dec->tile_lbuf)) {
+      return OD_EFAULT;
+    }
+  }
   return 0;
 }
 
 static void od_dec_clear(od_dec_ctx *dec) {
+  if (dec->frames != NULL) {
+    /*Let the worker threads finish with the buffers before freeing them.*/
+    od_thread_pool_join(&dec->state.threads);
+    /*Give the od_state back its own buffers.*/
+    dec->state.bsize = dec->frames[0].bsize;
+    dec->state.dering_level = dec->frames[0].dering_level;
+    OD_COPY(dec->state.ctmp, dec->frames[0].ctmp, OD_NPLANES_MAX);
+    OD_COPY(dec->state.dtmp, dec->frames[0].dtmp, OD_NPLANES_MAX);
+    OD_COPY(dec->state.bskip, dec->frames[0].bskip, 3);
+    od_dec_frame_free(dec->frames + 1, &dec->state);
+    od_progress_clear(&dec->frames[0].recon);
+    od_progress_clear(&dec->frames[1].recon);
+    od_progress_clear(&dec->frames[0].filtered);
+    od_progress_clear(&dec->frames[1].filtered);
+    free(dec->frames);
+  }
+  if (dec->fb_funcs.get_buffer != NULL) od_dec_fbs_release(dec);
 #if OD_ACCOUNTING
   od_accounting_clear(&dec->acct);
 #endif
+  free(dec->tiles);
+  free(dec->tile_lbuf);
   od_state_clear(&dec->state);
   od_output_queue_clear(&dec->out);
 }
@@ -167,6 +361,46 @@ int daala_decode_ctl(daala_dec_ctx *dec, int req, void *buf, size_t buf_sz) {
       dec->user_dering = (unsigned char *)buf;
       return OD_SUCCESS;
     }
+    case OD_DECCTL_SET_THREADS: {
+      OD_RETURN_CHECK(dec, OD_EFAULT);
+      OD_RETURN_CHECK(buf, OD_EFAULT);
+      OD_RETURN_CHECK(buf_sz == sizeof(int), OD_EINVAL);
+      return od_state_set_threads(&dec->state, *(const int *)buf);
+    }
+    case OD_DECCTL_SET_LAZY_EDGE_EXT: {
+      OD_RETURN_CHECK(dec, OD_EFAULT);
+      OD_RETURN_CHECK(buf, OD_EFAULT);
+      OD_RETURN_CHECK(buf_sz == sizeof(int), OD_EINVAL);
+      OD_RETURN_CHECK(!dec->started, OD_EINVAL);
+      dec->state.lazy_edge_ext = *(const int *)buf != 0;
+      return OD_SUCCESS;
+    }
+    case OD_DECCTL_SET_FRAME_BUFFER_FUNCS: {
+      const daala_frame_buffer_funcs *funcs;
+      OD_RETURN_CHECK(dec, OD_EFAULT);
+      OD_RETURN_CHECK(buf_sz == sizeof(daala_frame_buffer_funcs), OD_EINVAL);
+      OD_RETURN_CHECK(!dec->started, OD_EINVAL);
+      funcs = (const daala_frame_buffer_funcs *)buf;
+      if (funcs != NULL) {
+        OD_RETURN_CHECK(funcs->get_buffer != NULL
+         && funcs->release_buffer != NULL, OD_EFAULT);
+        if (dec->out.output_img_data != NULL) {
+          /*Output images now go straight to the application's buffers.*/
+          dec->out_fmt = dec->out.images[0];
+          od_output_queue_clear(&dec->out);
+        }
+        dec->fb_funcs = *funcs;
+      }
+      else {
+        if (dec->out.output_img_data == NULL) {
+          int ret;
+          ret = od_output_queue_init(&dec->out, &dec->state);
+          if (OD_UNLIKELY(ret < 0)) return ret;
+        }
+        OD_CLEAR(&dec->fb_funcs, 1);
+      }
+      return OD_SUCCESS;
+    }
     default: return OD_EIMPL;
   }
 }
@@ -187,14 +421,73 @@ static void od_dec_blank_img(daala_image *img) {
   }
 }
 
+/*Waits for the worker threads to finish the last frame submitted to them, if
+   any, and adds it to the output queue.*/
+static void od_dec_finish_pending(daala_dec_ctx *dec) {
+  od_dec_frame *frame;
+  frame = dec->pending;
+  if (frame != NULL) {
+    od_progress_wait(dec->state.ref_rows + frame->refi, dec->state.nvsb);
+    if (dec->fb_funcs.get_buffer == NULL) {
+      od_output_queue_add(&dec->out, dec->state.ref_imgs + frame->refi,
+       frame->number);
+    }
+    else if (frame->out_fb != NULL) {
+      /*The queue takes over our reference to the buffer.*/
+      od_img_copy(&frame->out_fb->fb.img,
+       dec->state.ref_imgs + frame->refi);
+      od_output_queue_add_ref(&dec->out, &frame->out_fb->fb.img,
+       frame->number, frame->out_fb);
+      frame->out_fb = NULL;
+    }
+    else {
+      /*The frame is output straight from its reference buffer.*/
+      od_dec_fb *fb;
+      fb = dec->ref_fbs[frame->refi];
+      fb->refs++;
+      od_output_queue_add_ref(&dec->out, dec->state.ref_imgs + frame->refi,
+       frame->number, fb);
+    }
+    dec->pending = NULL;
+  }
+}
+
+/*Picks the per-frame buffers the next frame is decoded into and points the
+   od_state at them.*/
+static od_dec_frame *od_dec_frame_start(daala_dec_ctx *dec) {
+  od_dec_frame *frame;
+  frame = dec->frames;
+  if (dec->pending == frame) {
+    if (OD_LIKELY(!od_dec_frame_alloc(dec->frames + 1, &dec->state))) {
+      frame++;
+    }
+    /*Out of memory: fall back to finishing frames one at a time.*/
+    else od_dec_finish_pending(dec);
+  }
+  od_progress_reset(&frame->recon, 0);
+  od_progress_reset(&frame->filtered, 0);
+  OD_COPY(dec->state.ctmp, frame->ctmp, OD_NPLANES_MAX);
+  OD_COPY(dec->state.dtmp, frame->dtmp, OD_NPLANES_MAX);
+  OD_COPY(dec->state.bskip, frame->bskip, 3);
+  dec->state.bsize = frame->bsize;
+  dec->state.dering_level = frame->dering_level;
+  return frame;
+}
+
 /*We're decoding an INTER frame, but have no initialized reference
    buffers (i.e., decoding did not start on a key frame).
   We initialize them to a solid gray here.*/
-static void od_dec_init_dummy_frame(daala_dec_ctx *dec) {
+static int od_dec_init_dummy_frame(daala_dec_ctx *dec) {
+  /*Make sure the buffer is not still being written.*/
+  od_dec_finish_pending(dec);
+  if (OD_UNLIKELY(od_dec_ref_fb_attach(dec, 0))) return OD_EFAULT;
   dec->state.ref_imgi[OD_FRAME_GOLD] =
    dec->state.ref_imgi[OD_FRAME_PREV] =
    dec->state.ref_imgi[OD_FRAME_SELF] = 0;
   od_dec_blank_img(dec->state.ref_imgs + dec->state.ref_imgi[OD_FRAME_SELF]);
+  /*That filled the borders, too.*/
+  memset(dec->state.ref_edge_ext[0], 1, dec->state.nvsb + 2);
+  return OD_SUCCESS;
 }
 
 static void od_decode_mv(daala_dec_ctx *dec, int num_refs, od_mv_grid_pt *mvg,
@@ -251,7 +544,7 @@ static void od_decode_mv(daala_dec_ctx *dec, int num_refs, od_mv_grid_pt *mvg,
 /*Block-level decoder context information.
   Global decoder context information is in od_dec_ctx.*/
 struct od_mb_dec_ctx {
-  od_coeff *c;
+  od_state *state;
   od_coeff **d;
   od_coeff *md;
   od_coeff *mc;
@@ -262,6 +555,13 @@ struct od_mb_dec_ctx {
   int qm;
   int use_haar_wavelet;
   int is_golden_frame;
+  /*The superblocks [sbx0, sbx1) x [sby0, sby1) of the tile being decoded.*/
+  int sbx0;
+  int sby0;
+  int sbx1;
+  int sby1;
+  /*The frame that decoded superblocks are handed to for reconstruction.*/
+  od_dec_frame *frame;
 };
 typedef struct od_mb_dec_ctx od_mb_dec_ctx;
 
@@ -284,8 +584,9 @@ static void od_decode_compute_pred(daala_dec_ctx *dec, od_mb_dec_ctx *ctx,
     if (pli == 0 || OD_DISABLE_CFL || ctx->use_haar_wavelet) {
       OD_CLEAR(pred, n*n);
       if (pli == 0 && !ctx->use_haar_wavelet) {
-        od_hv_intra_pred(pred, d, w, bx, by, dec->state.bsize,
-         dec->state.bstride, bs);
+        od_hv_intra_pred(pred, d, w, bx, by,
+         ctx->sbx0 << (OD_NBSIZES - 1), ctx->sby0 << (OD_NBSIZES - 1),
+         dec->state.bsize, dec->state.bstride, bs);
       }
     }
     else {
@@ -486,7 +787,6 @@ static void od_block_decode(daala_dec_ctx *dec, od_mb_dec_ctx *ctx, int bs,
   int w;
   int bo;
   int frame_width;
-  od_coeff *c;
   od_coeff *d;
   od_coeff *md;
   od_coeff *mc;
@@ -508,10 +808,31 @@ static void od_block_decode(daala_dec_ctx *dec, od_mb_dec_ctx *ctx, int bs,
   frame_width = dec->state.frame_width;
   w = frame_width >> xdec;
   bo = (by << 2)*w + (bx << 2);
-  c = ctx->c;
   d = ctx->d[pli];
   md = ctx->md;
   mc = ctx->mc;
+  if (skip == 0 && !is_keyframe && !ctx->use_haar_wavelet) {
+    od_coeff *c;
+    int i;
+    /*A block with neither AC nor DC residual decodes to exactly the transform
+       of its prefiltered MC predictor, and the transform is reversible, so
+       the predictor is already the reconstruction.
+      Copy it straight out and skip the forward and inverse transforms;
+       od_reconstruct_recursive() knows from bskip not to touch it again.
+      Nothing is read from the bitstream for such a block, and d is only used
+       as a predictor in keyframes.*/
+    c = dec->state.ctmp[pli];
+    for (i = 0; i < n; i++) OD_COPY(c + bo + i*w, mc + bo + i*w, n);
+    if (pli == 0 && dec->user_flags != NULL) {
+      unsigned int flags;
+      /*Every band is skipped and none is marked noref, as od_pvq_decode()
+         would have reported.*/
+      flags = 0;
+      for (i = 0; i < OD_BAND_OFFSETS[bs][0]; i++) flags = flags << 2 | 1;
+      dec->user_flags[by*dec->user_fstride + bx] = flags;
+    }
+    return;
+  }
   /*Apply forward transform to MC predictor.*/
   if (!is_keyframe) {
     if (ctx->use_haar_wavelet) {
@@ -588,13 +909,8 @@ static void od_block_decode(daala_dec_ctx *dec, od_mb_dec_ctx *ctx, int bs,
   else {
     od_coding_order_to_raster(&d[bo], w, pred, n);
   }
-  if (ctx->use_haar_wavelet) {
-    od_haar_inv(c + bo, w, d + bo, w, bs + 2);
-  }
-  else {
-    /*Apply the inverse transform.*/
-    (*dec->state.opt_vtbl.idct_2d[bs])(c + bo, w, d + bo, w);
-  }
+  /*The inverse transform is applied later by od_reconstruct_recursive(), so
+    that it can run on a worker thread.*/
 }
 
 #if !OD_DISABLE_HAAR_DC
@@ -610,6 +926,8 @@ static void od_decode_haar_dc_sb(daala_dec_ctx *dec, od_mb_dec_ctx *ctx,
   od_coeff sb_dc_pred;
   od_coeff sb_dc_curr;
   od_coeff *sb_dc_mem;
+  int top;
+  int left;
   OD_UNUSED(ydec);
   d = ctx->d[pli];
   w = dec->state.frame_width >> xdec;
@@ -623,7 +941,10 @@ static void od_decode_haar_dc_sb(daala_dec_ctx *dec, od_mb_dec_ctx *ctx,
   nhsb = dec->state.nhsb;
   sb_dc_mem = dec->state.sb_dc_mem[pli];
   ln = OD_LOG_BSIZE_MAX - xdec;
-  if (by > 0 && bx > 0) {
+  /*Superblocks in other tiles are not available for prediction.*/
+  top = by > ctx->sby0;
+  left = bx > ctx->sbx0;
+  if (top && left) {
     /* These coeffs were LS-optimized on subset 1. */
     if (has_ur) {
       sb_dc_pred = (22*sb_dc_mem[by*nhsb + bx - 1]
@@ -637,8 +958,8 @@ static void od_decode_haar_dc_sb(daala_dec_ctx *dec, od_mb_dec_ctx *ctx,
        + 19*sb_dc_mem[(by - 1)*nhsb + bx] + 16) >> 5;
     }
   }
-  else if (by > 0) sb_dc_pred = sb_dc_mem[(by - 1)*nhsb + bx];
-  else if (bx > 0) sb_dc_pred = sb_dc_mem[by*nhsb + bx - 1];
+  else if (top) sb_dc_pred = sb_dc_mem[(by - 1)*nhsb + bx];
+  else if (left) sb_dc_pred = sb_dc_mem[by*nhsb + bx - 1];
   else sb_dc_pred = 0;
   quant = generic_decode(&dec->ec, &dec->state.adapt.model_dc[pli], -1,
    &dec->state.adapt.ex_sb_dc[pli], 2, "haardc:mag:top");
@@ -648,8 +969,8 @@ static void od_decode_haar_dc_sb(daala_dec_ctx *dec, od_mb_dec_ctx *ctx,
   sb_dc_curr = quant*dc_quant + sb_dc_pred;
   d[(by << ln)*w + (bx << ln)] = sb_dc_curr;
   sb_dc_mem[by*nhsb + bx] = sb_dc_curr;
-  if (by > 0) *ovgrad = sb_dc_mem[(by - 1)*nhsb + bx] - sb_dc_curr;
-  if (bx > 0) *ohgrad = sb_dc_mem[by*nhsb + bx - 1] - sb_dc_curr;
+  if (top) *ovgrad = sb_dc_mem[(by - 1)*nhsb + bx] - sb_dc_curr;
+  if (left) *ohgrad = sb_dc_mem[by*nhsb + bx - 1] - sb_dc_curr;
 }
 #endif
 
@@ -771,8 +1092,9 @@ static void od_decode_recursive(daala_dec_ctx *dec, od_mb_dec_ctx *ctx, int pli,
         }
       }
     }
-    /*Construct the luma predictors for chroma planes.*/
-    if (ctx->l != NULL) {
+    /*Construct the luma predictors for chroma planes.
+      They are only used in keyframes (see od_decode_compute_pred()).*/
+    if (ctx->l != NULL && ctx->is_keyframe) {
       OD_ASSERT(pli > 0);
       od_resample_luma_coeffs(ctx->l, 1 << (bs + OD_LOG_BSIZE0),
        ctx->d[0] + (by << (2 + bsi))*frame_width + (bx << (2 + bsi)),
@@ -804,7 +1126,8 @@ static void od_decode_recursive(daala_dec_ctx *dec, od_mb_dec_ctx *ctx, int pli,
     hfilter = (bx + 1) << (OD_LOG_BSIZE0 + bs) <= dec->state.info.pic_width;
     vfilter = (by + 1) << (OD_LOG_BSIZE0 + bs) <= dec->state.info.pic_height;
     if (!ctx->is_keyframe) {
-      od_prefilter_split(ctx->mc + bo, w, bs, f, hfilter, vfilter);
+      od_prefilter_split(&dec->state.opt_vtbl.filter, ctx->mc + bo, w, bs, f,
+       hfilter, vfilter);
     }
     if (ctx->is_keyframe) {
       od_decode_haar_dc_level(dec, ctx, pli, 2*bx, 2*by, bsi - 1, xdec, &hgrad,
@@ -818,14 +1141,91 @@ static void od_decode_recursive(daala_dec_ctx *dec, od_mb_dec_ctx *ctx, int pli,
      hgrad, vgrad);
     od_decode_recursive(dec, ctx, pli, 2*bx + 1, 2*by + 1, bsi - 1, xdec, ydec,
      hgrad, vgrad);
+  }
+}
+
+/*Replays the block size decisions of od_decode_recursive() to turn the
+   decoded coefficients of a block back into pixels.
+  This only reads the coefficients and skip flags of the block itself and
+   only writes its own pixels, so different superblocks can be reconstructed
+   concurrently, and while the entropy decoder moves on.*/
+static void od_reconstruct_recursive(od_dec_frame *frame, int pli, int bx,
+ int by, int bsi, int xdec) {
+  od_state *state;
+  int obs;
+  int bs;
+  int w;
+  int bo;
+  od_coeff *c;
+  od_coeff *d;
+  state = frame->state;
+  w = state->frame_width >> xdec;
+  c = frame->ctmp[pli];
+  d = frame->dtmp[pli];
+  if (frame->use_haar_wavelet) obs = bsi;
+  else {
+    obs = OD_BLOCK_SIZE4x4(frame->bsize, state->bstride, bx << bsi, by << bsi);
+  }
+  bs = OD_MAXI(obs, xdec);
+  OD_ASSERT(bs <= bsi);
+  if (bs == bsi) {
+    bs -= xdec;
+    bo = (by << (OD_LOG_BSIZE0 + bs))*w + (bx << (OD_LOG_BSIZE0 + bs));
+    if (frame->use_haar_wavelet) {
+      od_haar_inv(c + bo, w, d + bo, w, bs + 2);
+    }
+    /*Fully skipped blocks were already reconstructed by od_block_decode().*/
+    else if (!frame->bskip[pli][(by << bs)*state->skip_stride + (bx << bs)]) {
+      /*Apply the inverse transform.*/
+      od_bin_idct_2d_sparse(state->opt_vtbl.idct_2d[bs], c + bo, w, d + bo, w,
+       bs);
+    }
+  }
+  else {
+    int f;
+    int hfilter;
+    int vfilter;
     bs = bsi - xdec;
+    f = OD_FILT_SIZE(bs - 1, xdec);
     bo = (by << (OD_LOG_BSIZE0 + bs))*w + (bx << (OD_LOG_BSIZE0 + bs));
-    od_postfilter_split(ctx->c + bo, w, bs, f, dec->state.coded_quantizer,
-     &dec->state.bskip[pli][(by << bs)*dec->state.skip_stride + (bx << bs)],
-     dec->state.skip_stride, hfilter, vfilter);
+    hfilter = (bx + 1) << (OD_LOG_BSIZE0 + bs) <= state->info.pic_width;
+    vfilter = (by + 1) << (OD_LOG_BSIZE0 + bs) <= state->info.pic_height;
+    od_reconstruct_recursive(frame, pli, 2*bx + 0, 2*by + 0, bsi - 1, xdec);
+    od_reconstruct_recursive(frame, pli, 2*bx + 1, 2*by + 0, bsi - 1, xdec);
+    od_reconstruct_recursive(frame, pli, 2*bx + 0, 2*by + 1, bsi - 1, xdec);
+    od_reconstruct_recursive(frame, pli, 2*bx + 1, 2*by + 1, bsi - 1, xdec);
+    od_postfilter_split(&state->opt_vtbl.filter, c + bo, w, bs, f,
+     frame->coded_quantizer, &frame->bskip[pli][(by << bs)*state->skip_stride + (bx << bs)],
+     state->skip_stride, hfilter, vfilter);
+  }
+}
+
+/*Reconstructs all the planes of one superblock.*/
+static void od_reconstruct_sb(od_dec_frame *frame, int sbx, int sby) {
+  od_state *state;
+  int pli;
+  state = frame->state;
+  for (pli = 0; pli < state->info.nplanes; pli++) {
+    od_reconstruct_recursive(frame, pli, sbx, sby, OD_NBSIZES - 1,
+     state->info.plane_info[pli].xdec);
   }
 }
 
+/*Thread pool job reconstructing superblock row sby.*/
+static void od_reconstruct_sb_row(void *ctx, int sby) {
+  od_dec_frame *frame;
+  int sbx;
+  frame = (od_dec_frame *)ctx;
+  for (sbx = 0; sbx < frame->state->nhsb; sbx++) {
+    od_reconstruct_sb(frame, sbx, sby);
+  }
+  /*Rows are published in order, so that a single counter tells how many are
+     done.
+    The job for the previous row was queued first, so this cannot deadlock.*/
+  od_progress_wait(&frame->recon, sby);
+  od_progress_set(&frame->recon, sby + 1);
+}
+
 static void od_dec_mv_unpack(daala_dec_ctx *dec, int num_refs) {
   int nhmvbs;
   int nvmvbs;
@@ -918,59 +1318,26 @@ static void od_dec_mv_unpack(daala_dec_ctx *dec, int num_refs) {
   }
 }
 
-static void od_decode_coefficients(od_dec_ctx *dec, od_mb_dec_ctx *mbctx) {
+/*Decodes the superblocks of the tile described by mbctx and reconstructs
+   them, or queues their reconstruction when the frame is a single tile.*/
+static void od_decode_tile(od_dec_ctx *dec, od_mb_dec_ctx *mbctx) {
   int nplanes;
   int pli;
   int xdec;
   int ydec;
   int sby;
   int sbx;
-  int w;
-  int y;
-  int x;
-  int frame_width;
-  int nvsb;
-  int nhsb;
-  int nhdr;
-  int nvdr;
+  int single;
   od_state *state;
-  daala_image *rec;
   state = &dec->state;
-  /*Initialize the data needed for each plane.*/
   nplanes = state->info.nplanes;
-  nhsb = state->nhsb;
-  nvsb = state->nvsb;
-  frame_width = state->frame_width;
-  rec = state->ref_imgs + state->ref_imgi[OD_FRAME_SELF];
-  OD_ACCOUNTING_SET_LOCATION(dec, OD_ACCT_FRAME, 0, 0, 0);
-  /* Map our quantizer; we potentially need it to know what reference
-     resolution we're working at. */
-  dec->state.coded_quantizer =
-   od_ec_dec_uint(&dec->ec, OD_N_CODED_QUANTIZERS, "quantizer");
-  dec->state.quantizer =
-   od_codedquantizer_to_quantizer(dec->state.coded_quantizer);
-  /*Apply the prefilter to the motion-compensated reference.*/
-  if (!mbctx->is_keyframe) {
-    for (pli = 0; pli < nplanes; pli++) {
-      xdec = rec->planes[pli].xdec;
-      ydec = rec->planes[pli].ydec;
-      w = frame_width >> xdec;
-      /*Collect the image data needed for this plane.*/
-      od_ref_plane_to_coeff(state,
-       state->mctmp[pli], OD_LOSSLESS(dec), rec, pli);
-      if (!mbctx->use_haar_wavelet) {
-        od_apply_prefilter_frame_sbs(state->mctmp[pli], w, nhsb, nvsb, xdec,
-         ydec);
-      }
-    }
-  }
-  for (sby = 0; sby < nvsb; sby++) {
-    for (sbx = 0; sbx < nhsb; sbx++) {
+  single = OD_NTILES(&state->info) == 1;
+  for (sby = mbctx->sby0; sby < mbctx->sby1; sby++) {
+    for (sbx = mbctx->sbx0; sbx < mbctx->sbx1; sbx++) {
       for (pli = 0; pli < nplanes; pli++) {
         od_coeff hgrad;
         od_coeff vgrad;
         hgrad = vgrad = 0;
-        mbctx->c = state->ctmp[pli];
         mbctx->d = state->dtmp;
         mbctx->mc = state->mctmp[pli];
         mbctx->md = state->mdtmp[pli];
@@ -979,149 +1346,453 @@ static void od_decode_coefficients(od_dec_ctx *dec, od_mb_dec_ctx *mbctx) {
         ydec = dec->state.info.plane_info[pli].ydec;
         if (mbctx->is_keyframe) {
           od_decode_haar_dc_sb(dec, mbctx, pli, sbx, sby, xdec, ydec,
-           sby > 0 && sbx < nhsb - 1, &hgrad, &vgrad);
+           sby > mbctx->sby0 && sbx < mbctx->sbx1 - 1, &hgrad, &vgrad);
         }
         od_decode_recursive(dec, mbctx, pli, sbx, sby, OD_NBSIZES - 1, xdec,
          ydec, hgrad, vgrad);
       }
+      /*A tile already runs on one of the worker threads, so it reconstructs
+         its own superblocks.*/
+      if (!single) od_reconstruct_sb(mbctx->frame, sbx, sby);
+    }
+    /*Entropy decoding is serial, but the row is now complete in the
+       coefficient domain: hand the inverse transforms and the lapping inside
+       each superblock off to the worker threads.*/
+    if (single) {
+      od_thread_pool_submit(&state->threads, od_reconstruct_sb_row,
+       mbctx->frame, sby);
     }
   }
+}
+
+/*Everything needed to decode the tiles of a frame in parallel.*/
+struct od_dec_tiles_ctx {
+  od_dec_ctx *dec;
+  od_mb_dec_ctx mbctx[OD_TILES_MAX];
+};
+typedef struct od_dec_tiles_ctx od_dec_tiles_ctx;
+
+/*Points a tile's decoder context at the frame being decoded, giving it its own
+   entropy decoder, adaptation state and scratch buffers.*/
+static void od_dec_tile_init(od_dec_ctx *tdec, od_dec_ctx *dec, int tile,
+ int is_keyframe) {
+  int nplanes;
+  int pli;
+  nplanes = dec->state.info.nplanes;
+  OD_COPY(tdec, dec, 1);
+  tdec->tiles = NULL;
+  /*The tile is already running on one of the worker threads, so it does its
+     reconstruction itself instead of queuing more jobs.*/
+  OD_CLEAR(&tdec->state.threads, 1);
+  tdec->state.threads.nthreads = 1;
   for (pli = 0; pli < nplanes; pli++) {
-    xdec = dec->state.info.plane_info[pli].xdec;
-    ydec = dec->state.info.plane_info[pli].ydec;
-    w = frame_width >> xdec;
-    if (!mbctx->use_haar_wavelet) {
-      od_apply_postfilter_frame_sbs(state->ctmp[pli], w, nhsb, nvsb, xdec,
-       ydec, dec->state.coded_quantizer, &dec->state.bskip[pli][0],
-       dec->state.skip_stride);
+    tdec->state.ltmp[pli] = NULL;
+    if (dec->state.lbuf[pli] != NULL) {
+      tdec->state.lbuf[pli] = dec->tile_lbuf +
+       (tile*nplanes + pli)*OD_BSIZE_MAX*OD_BSIZE_MAX;
+    }
+  }
+  od_ec_dec_init(&tdec->ec, dec->tile_data[tile], dec->tile_bytes[tile]);
+  od_adapt_ctx_reset(&tdec->state.adapt, is_keyframe);
+}
+
+static void od_decode_tile_job(void *ctx, int tile) {
+  od_dec_tiles_ctx *tctx;
+  od_dec_ctx *tdec;
+  od_mb_dec_ctx *mbctx;
+  tctx = (od_dec_tiles_ctx *)ctx;
+  tdec = tctx->dec->tiles + tile;
+  mbctx = tctx->mbctx + tile;
+  mbctx->state = &tdec->state;
+  od_decode_tile(tdec, mbctx);
+}
+
+/*Decodes each tile of the frame with its own entropy decoder.*/
+static void od_decode_tiles(od_dec_ctx *dec, od_mb_dec_ctx *mbctx) {
+  od_dec_tiles_ctx tctx;
+  int ntiles;
+  int tile;
+  ntiles = OD_NTILES(&dec->state.info);
+  tctx.dec = dec;
+  for (tile = 0; tile < ntiles; tile++) {
+    tctx.mbctx[tile] = *mbctx;
+    od_state_tile_bounds(&dec->state, tile, &tctx.mbctx[tile].sbx0,
+     &tctx.mbctx[tile].sby0, &tctx.mbctx[tile].sbx1, &tctx.mbctx[tile].sby1);
+  }
+#if OD_ACCOUNTING
+  /*Symbols are recorded in the order they are decoded, so decode the tiles
+     one at a time on this context instead.*/
+  if (dec->acct_enabled) {
+    od_ec_dec ec;
+    od_adapt_ctx *adapt;
+    uint32_t last_tell;
+    adapt = (od_adapt_ctx *)malloc(sizeof(*adapt));
+    if (adapt != NULL) {
+      OD_COPY(&ec, &dec->ec, 1);
+      OD_COPY(adapt, &dec->state.adapt, 1);
+      last_tell = dec->acct.last_tell;
+      for (tile = 0; tile < ntiles; tile++) {
+        od_ec_dec_init(&dec->ec, dec->tile_data[tile], dec->tile_bytes[tile]);
+        dec->ec.acct = &dec->acct;
+        dec->acct.last_tell = 0;
+        od_adapt_ctx_reset(&dec->state.adapt, mbctx->is_keyframe);
+        od_decode_tile(dec, tctx.mbctx + tile);
+      }
+      OD_COPY(&dec->ec, &ec, 1);
+      OD_COPY(&dec->state.adapt, adapt, 1);
+      dec->acct.last_tell = last_tell;
+      free(adapt);
+      return;
     }
   }
+#endif
+  /*This copies the thread pool, so it must be done before any job starts.*/
+  for (tile = 0; tile < ntiles; tile++) {
+    od_dec_tile_init(dec->tiles + tile, dec, tile, mbctx->is_keyframe);
+  }
+  od_thread_pool_run(&dec->state.threads, od_decode_tile_job, &tctx, ntiles);
+}
+
+/*Decodes the deringing level of each superblock.
+  These come after all the coefficients, but do not depend on the filtered
+   image, so they are read before any deringing takes place.*/
+static void od_decode_dering_levels(od_dec_ctx *dec, od_mb_dec_ctx *mbctx) {
+  od_state *state;
+  int nhdr;
+  int nvdr;
+  int sbx;
+  int sby;
+  state = &dec->state;
   nhdr = state->frame_width >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
   nvdr = state->frame_height >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
-  if (!OD_LOSSLESS(dec)) {
-    double base_threshold;
-    int nblocks;
-    nblocks = 1 << (OD_LOG_DERING_GRID - OD_BLOCK_8X8);
-    base_threshold = pow(state->quantizer, 0.84182);
-    for (pli = 0; pli < nplanes; pli++) {
-      int i;
-      int size;
-      xdec = dec->state.info.plane_info[pli].xdec;
-      ydec = dec->state.info.plane_info[pli].ydec;
-      size = nvsb*nhsb*OD_BSIZE_MAX*OD_BSIZE_MAX >> xdec >> ydec;
-      for (i = 0; i < size; i++) {
-        state->etmp[pli][i] = state->ctmp[pli][i];
-      }
+  if (OD_LOSSLESS(dec)) {
+    if (dec->user_dering != NULL) {
+      OD_CLEAR(dec->user_dering, nhdr*nvdr);
     }
-    for (sby = 0; sby < nvdr; sby++) {
-      for (sbx = 0; sbx < nhdr; sbx++) {
-        int level;
-        int c;
-        int i;
-        int j;
-        unsigned char *bskip;
-        state->dering_level[sby*nhdr + sbx] = 0;
-        bskip = dec->state.bskip[0] +
-         (sby << OD_LOG_DERING_GRID)*dec->state.skip_stride +
-         (sbx << OD_LOG_DERING_GRID);
-        for (j = 0; j < 1 << OD_LOG_DERING_GRID; j++) {
-          for (i = 0; i < 1 << OD_LOG_DERING_GRID; i++) {
-            if (!bskip[j*dec->state.skip_stride + i]) {
-              state->dering_level[sby*nhdr + sbx] = 1;
-            }
+    return;
+  }
+  for (sby = 0; sby < nvdr; sby++) {
+    for (sbx = 0; sbx < nhdr; sbx++) {
+      int c;
+      int i;
+      int j;
+      unsigned char *bskip;
+      state->dering_level[sby*nhdr + sbx] = 0;
+      bskip = dec->state.bskip[0] +
+       (sby << OD_LOG_DERING_GRID)*dec->state.skip_stride +
+       (sbx << OD_LOG_DERING_GRID);
+      for (j = 0; j < 1 << OD_LOG_DERING_GRID; j++) {
+        for (i = 0; i < 1 << OD_LOG_DERING_GRID; i++) {
+          if (!bskip[j*dec->state.skip_stride + i]) {
+            state->dering_level[sby*nhdr + sbx] = 1;
           }
         }
-        if (!state->dering_level[sby*nhdr + sbx]) {
-          continue;
-        }
-        if (mbctx->is_keyframe) {
-          int left;
-          int up;
-          left = up = 0;
-          if (sby > 0) {
-            left = up = state->dering_level[(sby - 1)*nhdr + sbx];
-          }
-          if (sbx > 0) {
-            left = state->dering_level[sby*nhdr + (sbx - 1)];
-            if (sby == 0) up = left;
-          }
-          c = up + left;
+      }
+      if (!state->dering_level[sby*nhdr + sbx]) {
+        continue;
+      }
+      if (mbctx->is_keyframe) {
+        int left;
+        int up;
+        left = up = 0;
+        if (sby > 0) {
+          left = up = state->dering_level[(sby - 1)*nhdr + sbx];
         }
-        else c = 0;
-        level = od_decode_cdf_adapt(&dec->ec, state->adapt.dering_cdf[c],
-         OD_DERING_LEVELS, state->adapt.dering_increment, "dering");
-        state->dering_level[sby*nhdr + sbx] = level;
-        if (level) {
-          for (pli = 0; pli < nplanes; pli++) {
-            int16_t buf[OD_BSIZE_MAX*OD_BSIZE_MAX];
-            od_coeff *output;
-            int ln;
-            int n;
-            int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
-            int threshold;
-            xdec = dec->state.info.plane_info[pli].xdec;
-            ydec = dec->state.info.plane_info[pli].ydec;
-            w = frame_width >> xdec;
-            ln = OD_LOG_DERING_GRID + OD_LOG_BSIZE0 - xdec;
-            n = 1 << ln;
-            OD_ASSERT(xdec == ydec);
-            threshold = (int)(OD_DERING_GAIN_TABLE[level]*base_threshold*
-             (pli==0 ? 1 : 0.6));
-            /*buf is used for output so that we don't use filtered pixels in
-              the input to the filter, but because we look past block edges,
-              we do this anyway on the edge pixels. Unfortunately, this limits
-              potential parallelism.*/
-            od_dering(&state->opt_vtbl.dering, buf, n,
-             &state->etmp[pli][(sby << ln)*w +
-             (sbx << ln)], w, nblocks, nblocks, sbx, sby, nhdr, nvdr,
-             xdec, dir, pli, &dec->state.bskip[pli]
-             [(sby << (OD_LOG_DERING_GRID - ydec))*dec->state.skip_stride
-             + (sbx << (OD_LOG_DERING_GRID - xdec))], dec->state.skip_stride,
-             threshold, OD_DERING_CHECK_OVERLAP, OD_COEFF_SHIFT);
-            output = &state->ctmp[pli][(sby << ln)*w + (sbx << ln)];
-            for (y = 0; y < n; y++) {
-              for (x = 0; x < n; x++) {
-                output[y*w + x] = buf[y*n+ x];
-              }
-            }
-          }
+        if (sbx > 0) {
+          left = state->dering_level[sby*nhdr + (sbx - 1)];
+          if (sby == 0) up = left;
         }
+        c = up + left;
       }
+      else c = 0;
+      state->dering_level[sby*nhdr + sbx] = od_decode_cdf_adapt(&dec->ec,
+       state->adapt.dering_cdf[c], OD_DERING_LEVELS,
+       state->adapt.dering_increment, "dering");
     }
-    if (dec->user_dering != NULL) {
-      for (sby = 0; sby < nvdr; sby++) {
-        for (sbx = 0; sbx < nhdr; sbx++) {
-          dec->user_dering[sby*nhdr + sbx] =
-           state->dering_level[sby*nhdr + sbx];
-        }
+  }
+  if (dec->user_dering != NULL) {
+    for (sby = 0; sby < nvdr; sby++) {
+      for (sbx = 0; sbx < nhdr; sbx++) {
+        dec->user_dering[sby*nhdr + sbx] =
+         state->dering_level[sby*nhdr + sbx];
       }
     }
   }
+}
+
+/*Entropy decodes the coefficients of a frame, queuing their reconstruction
+   into mbctx->frame as superblocks complete.*/
+static void od_decode_coefficients(od_dec_ctx *dec, od_mb_dec_ctx *mbctx) {
+  int nplanes;
+  int pli;
+  int nvsb;
+  int nhsb;
+  od_state *state;
+  od_dec_frame *frame;
+  daala_image *rec;
+  state = &dec->state;
+  frame = mbctx->frame;
+  /*Initialize the data needed for each plane.*/
+  nplanes = state->info.nplanes;
+  nhsb = state->nhsb;
+  nvsb = state->nvsb;
+  rec = state->ref_imgs + state->ref_imgi[OD_FRAME_SELF];
+  OD_ACCOUNTING_SET_LOCATION(dec, OD_ACCT_FRAME, 0, 0, 0);
+  /* Map our quantizer; we potentially need it to know what reference
+     resolution we're working at. */
+  dec->state.coded_quantizer =
+   od_ec_dec_uint(&dec->ec, OD_N_CODED_QUANTIZERS, "quantizer");
+  dec->state.quantizer =
+   od_codedquantizer_to_quantizer(dec->state.coded_quantizer);
+  frame->use_haar_wavelet = mbctx->use_haar_wavelet;
+  frame->quantizer = state->quantizer;
+  frame->coded_quantizer = state->coded_quantizer;
+  /*Apply the prefilter to the motion-compensated reference.*/
+  if (!mbctx->is_keyframe) {
+    for (pli = 0; pli < nplanes; pli++) {
+      /*Collect the image data needed for this plane.*/
+      od_ref_plane_to_coeff(state,
+       state->mctmp[pli], OD_LOSSLESS(dec), rec, pli);
+    }
+    if (!mbctx->use_haar_wavelet) {
+      od_state_prefilter_planes(state, state->mctmp, nplanes);
+    }
+  }
+  mbctx->state = state;
+  if (OD_NTILES(&state->info) == 1) {
+    mbctx->sbx0 = mbctx->sby0 = 0;
+    mbctx->sbx1 = nhsb;
+    mbctx->sby1 = nvsb;
+    od_decode_tile(dec, mbctx);
+  }
   else {
-    if (dec->user_dering != NULL) {
-      OD_CLEAR(dec->user_dering, nhdr*nvdr);
+    od_decode_tiles(dec, mbctx);
+    od_progress_set(&frame->recon, nvsb);
+  }
+  od_decode_dering_levels(dec, mbctx);
+}
+
+/*Deringing reads the filtered pixels of the neighboring superblocks, so it
+   works from a copy of them.
+  This makes that copy for superblock row sby.*/
+static void od_dec_copy_sb_row(od_dec_frame *frame, int sby) {
+  od_state *state;
+  int pli;
+  state = frame->state;
+  for (pli = 0; pli < state->info.nplanes; pli++) {
+    od_coeff *src;
+    int16_t *dst;
+    int i;
+    int n;
+    int ydec;
+    int w;
+    ydec = state->info.plane_info[pli].ydec;
+    w = state->frame_width >> state->info.plane_info[pli].xdec;
+    n = w << OD_LOG_BSIZE_MAX >> ydec;
+    src = frame->ctmp[pli] + sby*n;
+    dst = state->etmp[pli] + sby*n;
+    for (i = 0; i < n; i++) dst[i] = src[i];
+  }
+}
+
+/*Applies the deringing filter to superblock row sby.
+  The copy of the rows above and below must already have been made.*/
+static void od_dec_dering_sb_row(od_dec_frame *frame, int sby) {
+  od_state *state;
+  double base_threshold;
+  int nblocks;
+  int nhdr;
+  int nvdr;
+  int nplanes;
+  int sbx;
+  int x;
+  int y;
+  state = frame->state;
+  nplanes = state->info.nplanes;
+  nblocks = 1 << (OD_LOG_DERING_GRID - OD_BLOCK_8X8);
+  base_threshold = pow(frame->quantizer, 0.84182);
+  nhdr = state->frame_width >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+  nvdr = state->frame_height >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+  for (sbx = 0; sbx < nhdr; sbx++) {
+    int level;
+    int pli;
+    level = frame->dering_level[sby*nhdr + sbx];
+    if (!level) continue;
+    for (pli = 0; pli < nplanes; pli++) {
+      int16_t buf[OD_BSIZE_MAX*OD_BSIZE_MAX];
+      od_coeff *output;
+      int ln;
+      int n;
+      int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
+      int threshold;
+      int xdec;
+      int ydec;
+      int w;
+      xdec = state->info.plane_info[pli].xdec;
+      ydec = state->info.plane_info[pli].ydec;
+      w = state->frame_width >> xdec;
+      ln = OD_LOG_DERING_GRID + OD_LOG_BSIZE0 - xdec;
+      n = 1 << ln;
+      OD_ASSERT(xdec == ydec);
+      threshold = (int)(OD_DERING_GAIN_TABLE[level]*base_threshold*
+       (pli==0 ? 1 : 0.6));
+      /*buf is used for output so that we don't use filtered pixels in
+        the input to the filter, but because we look past block edges,
+        we do this anyway on the edge pixels. Unfortunately, this limits
+        potential parallelism.*/
+      od_dering(&state->opt_vtbl.dering, buf, n,
+       &state->etmp[pli][(sby << ln)*w +
+       (sbx << ln)], w, nblocks, nblocks, sbx, sby, nhdr, nvdr,
+       xdec, dir, pli, &frame->bskip[pli]
+       [(sby << (OD_LOG_DERING_GRID - ydec))*state->skip_stride
+       + (sbx << (OD_LOG_DERING_GRID - xdec))], state->skip_stride,
+       threshold, OD_DERING_CHECK_OVERLAP, OD_COEFF_SHIFT);
+      output = &frame->ctmp[pli][(sby << ln)*w + (sbx << ln)];
+      for (y = 0; y < n; y++) {
+        for (x = 0; x < n; x++) {
+          output[y*w + x] = buf[y*n+ x];
+        }
+      }
     }
   }
-  for (pli = 0; pli < nplanes; pli++) {
+}
+
+/*Thread pool job finishing superblock row sby: deringing it and storing the
+   result in the reference image.
+  The rows are deringed concurrently, once the postfilter is done with their
+   neighbors, but made available for motion compensation in order.*/
+static void od_dec_finish_sb_row(void *ctx, int sby) {
+  od_dec_frame *frame;
+  od_state *state;
+  daala_image *rec;
+  int pli;
+  frame = (od_dec_frame *)ctx;
+  state = frame->state;
+  rec = state->ref_imgs + frame->refi;
+  od_progress_wait(&frame->filtered, OD_MINI(sby + 2, state->nvsb));
+  if (frame->quantizer != 0) od_dec_dering_sb_row(frame, sby);
+  for (pli = 0; pli < state->info.nplanes; pli++) {
+    daala_image_plane *iplane;
+    int w;
+    int h;
+    iplane = rec->planes + pli;
+    w = rec->width >> iplane->xdec;
+    h = OD_BSIZE_MAX >> iplane->ydec;
     /*Move/scale/shift reconstructed data values from transform
       storage back into the SELF reference frame.*/
-    od_coeff_to_ref_plane(state, rec, pli,
-     state->ctmp[pli], OD_LOSSLESS(dec));
+    od_coeff_to_ref_buf(state, iplane->data + sby*h*iplane->ystride,
+     iplane->xstride, iplane->ystride, frame->ctmp[pli] + sby*h*w, w,
+     frame->quantizer == 0, w, h);
+  }
+  if (!state->lazy_edge_ext) {
+    od_img_edge_ext_rows(rec, sby << OD_LOG_BSIZE_MAX,
+     (sby + 1) << OD_LOG_BSIZE_MAX);
+  }
+  od_progress_wait(state->ref_rows + frame->refi, sby);
+  od_progress_set(state->ref_rows + frame->refi, sby + 1);
+}
+
+/*Thread pool job running the postfilter, which trails the inverse transforms
+   by a superblock row, and copying each row that is final for deringing.*/
+static void od_dec_filter_frame(void *ctx, int idx) {
+  od_dec_frame *frame;
+  od_state *state;
+  int dering;
+  int nvsb;
+  int sby;
+  int pli;
+  OD_UNUSED(idx);
+  frame = (od_dec_frame *)ctx;
+  state = frame->state;
+  nvsb = state->nvsb;
+  dering = frame->quantizer != 0;
+  for (sby = 0; sby < nvsb; sby++) {
+    od_progress_wait(&frame->recon, sby + 1);
+    if (!frame->use_haar_wavelet) {
+      for (pli = 0; pli < state->info.nplanes; pli++) {
+        od_apply_postfilter_frame_rows(&state->opt_vtbl.filter,
+         frame->ctmp[pli],
+         state->frame_width >> state->info.plane_info[pli].xdec, state->nhsb,
+         sby, sby + 1, state->info.plane_info[pli].xdec,
+         state->info.plane_info[pli].ydec, frame->coded_quantizer,
+         frame->bskip[pli], state->skip_stride);
+      }
+    }
+    /*Row sby - 1 is now final.*/
+    if (sby > 0) {
+      if (dering) od_dec_copy_sb_row(frame, sby - 1);
+      od_progress_set(&frame->filtered, sby);
+    }
+  }
+  if (dering) od_dec_copy_sb_row(frame, nvsb - 1);
+  od_progress_set(&frame->filtered, nvsb);
+}
+
+/*Locates the entropy coded data of each tile in a packet.
+  With more than one tile, a packet holds the frame-level data, then each tile
+   in raster order, then a trailer with the sizes of all of these but the last
+   tile.
+  Each size is a base-128 varint whose least significant group is stored
+   last, and the trailer is read backwards from the end of the packet
+   starting with the size of the frame-level data, so the packet still begins
+   with the frame header.
+  On return, *nbytes is the size of the frame-level data.*/
+static int od_dec_split_tiles(od_dec_ctx *dec, unsigned char *packet,
+ uint32_t *nbytes) {
+  uint32_t sizes[OD_TILES_MAX];
+  uint32_t end;
+  uint32_t total;
+  int ntiles;
+  int i;
+  ntiles = OD_NTILES(&dec->state.info);
+  end = *nbytes;
+  total = 0;
+  for (i = 0; i < ntiles; i++) {
+    uint32_t size;
+    int shift;
+    int b;
+    size = 0;
+    shift = 0;
+    do {
+      if (end == 0 || shift > 28) return OD_EBADPACKET;
+      b = packet[--end];
+      size |= (uint32_t)(b & 0x7F) << shift;
+      shift += 7;
+    }
+    while (b & 0x80);
+    sizes[i] = size;
+    total += size;
+    if (size > end || total > end) return OD_EBADPACKET;
+  }
+  *nbytes = sizes[0];
+  packet += sizes[0];
+  for (i = 0; i < ntiles; i++) {
+    dec->tile_data[i] = packet;
+    dec->tile_bytes[i] = i + 1 < ntiles ? sizes[i + 1] : end - total;
+    packet += dec->tile_bytes[i];
   }
+  return 0;
 }
 
 int daala_decode_packet_in(daala_dec_ctx *dec, const daala_packet *op) {
   int refi;
+  uint32_t nbytes;
   od_mb_dec_ctx mbctx;
-  daala_image *ref_img;
+  od_dec_frame *frame;
   int frame_number;
   int frame_type;
+  int sby;
   if (dec == NULL || op == NULL) return OD_EFAULT;
   if (dec->packet_state != OD_PACKET_DATA) return OD_EINVAL;
+  dec->started = 1;
   if (op->e_o_s) {
     dec->packet_state = OD_PACKET_DONE;
   }
-  od_ec_dec_init(&dec->ec, op->packet, op->bytes);
+  nbytes = op->bytes;
+  if (OD_NTILES(&dec->state.info) > 1) {
+    if (od_dec_split_tiles(dec, op->packet, &nbytes)) return OD_EBADPACKET;
+  }
+  od_ec_dec_init(&dec->ec, op->packet, nbytes);
 #if OD_ACCOUNTING
   if (dec->acct_enabled) {
     od_accounting_reset(&dec->acct);
@@ -1186,14 +1857,29 @@ int daala_decode_packet_in(daala_dec_ctx *dec, const daala_packet *op) {
        initialize one.*/
     if (dec->state.ref_imgi[OD_FRAME_GOLD] < 0 ||
      dec->state.ref_imgi[OD_FRAME_PREV] < 0 ) {
-      od_dec_init_dummy_frame(dec);
+      if (OD_UNLIKELY(od_dec_init_dummy_frame(dec))) return OD_EFAULT;
     }
   }
-  /*Select a free buffer to use for this reference frame.*/
+  frame = od_dec_frame_start(dec);
+  /*Select a free buffer to use for this reference frame.
+    The worker threads may still be writing the previous frame, even if it
+     is not a reference frame.*/
   for (refi = 0; refi == dec->state.ref_imgi[OD_FRAME_GOLD]
    || refi == dec->state.ref_imgi[OD_FRAME_PREV]
-   || refi == dec->state.ref_imgi[OD_FRAME_NEXT]; refi++);
+   || refi == dec->state.ref_imgi[OD_FRAME_NEXT]
+   || (dec->pending != NULL && refi == dec->pending->refi); refi++);
+  OD_ASSERT(refi < OD_NREF_IMGS);
+  if (OD_UNLIKELY(od_dec_ref_fb_attach(dec, refi))) return OD_EFAULT;
+  OD_ASSERT(frame->out_fb == NULL);
+  if (dec->fb_funcs.get_buffer != NULL
+   && dec->state.info.full_precision_references) {
+    frame->out_fb = od_dec_fb_get(dec, &dec->out_fmt, 0);
+    if (OD_UNLIKELY(frame->out_fb == NULL)) return OD_EFAULT;
+  }
   dec->state.ref_imgi[OD_FRAME_SELF] = refi;
+  frame->refi = refi;
+  frame->number = frame_number;
+  mbctx.frame = frame;
   od_adapt_ctx_reset(&dec->state.adapt, mbctx.is_keyframe);
   if (!mbctx.is_keyframe) {
     int num_refs;
@@ -1218,10 +1904,20 @@ int daala_decode_packet_in(daala_dec_ctx *dec, const daala_packet *op) {
        &dec->state.bsize[dec->state.bstride*j], nhsb*OD_BSIZE_GRID);
     }
   }
-  ref_img = dec->state.ref_imgs + dec->state.ref_imgi[OD_FRAME_SELF];
-  od_output_queue_add(&dec->out, ref_img, frame_number);
-  OD_ASSERT(ref_img);
-  od_img_edge_ext(ref_img);
+  /*Hand the rest of the frame off to the worker threads, once they are done
+     with the previous one.
+    Motion compensation from this frame waits for the rows it needs.*/
+  od_dec_finish_pending(dec);
+  od_progress_reset(dec->state.ref_rows + refi, 0);
+  OD_CLEAR(dec->state.ref_edge_ext[refi], dec->state.nvsb + 2);
+  dec->pending = frame;
+  od_thread_pool_submit(&dec->state.threads, od_dec_filter_frame, frame, 0);
+  for (sby = 0; sby < dec->state.nvsb; sby++) {
+    od_thread_pool_submit(&dec->state.threads, od_dec_finish_sb_row, frame,
+     sby);
+  }
+  /*Without worker threads, that finished the frame already.*/
+  if (dec->state.threads.nthreads <= 1) od_dec_finish_pending(dec);
   if (mbctx.is_golden_frame) {
     dec->state.ref_imgi[OD_FRAME_GOLD] =
      dec->state.ref_imgi[OD_FRAME_SELF];
@@ -1250,9 +1946,15 @@ int daala_decode_packet_in(daala_dec_ctx *dec, const daala_packet *op) {
 
 int daala_decode_img_out(daala_dec_ctx *dec, daala_image *img) {
   if (dec == NULL || img == NULL) return OD_EFAULT;
+  if (!od_output_queue_has_next(&dec->out)) od_dec_finish_pending(dec);
   if (od_output_queue_has_next(&dec->out)) {
     od_output_frame *frame;
     frame = od_output_queue_next(&dec->out);
+    if (frame->ref != NULL) {
+      /*Keep the buffer until the next image is returned.*/
+      od_dec_fb_unref(dec, dec->out_fb);
+      dec->out_fb = (od_dec_fb *)frame->ref;
+    }
     *img = *frame->img;
     img->width = dec->state.info.pic_width;
     img->height = dec->state.info.pic_height;
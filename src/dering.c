@@ -32,7 +32,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 
 const od_dering_opt_vtbl OD_DERING_VTBL_C = {
   {od_filter_dering_direction_4x4_c, od_filter_dering_direction_8x8_c},
-  {od_filter_dering_orthogonal_4x4_c, od_filter_dering_orthogonal_8x8_c}
+  {od_filter_dering_orthogonal_4x4_c, od_filter_dering_orthogonal_8x8_c},
+  od_dir_find8_c
 };
 
 /* Generated from gen_filter_tables.c. */
@@ -51,6 +52,29 @@ const double OD_DERING_GAIN_TABLE[OD_DERING_LEVELS] = {
   0, 0.5, 0.707, 1, 1.41, 2
 };
 
+/* Picks the direction with the largest cost from the costs computed by
+   od_dir_find8_c() or one of its SIMD versions. */
+int od_dir_find8_best(const int32_t cost[8], int32_t *var) {
+  int i;
+  int32_t best_cost;
+  int best_dir;
+  best_cost = 0;
+  best_dir = 0;
+  for (i = 0; i < 8; i++) {
+    if (cost[i] > best_cost) {
+      best_cost = cost[i];
+      best_dir = i;
+    }
+  }
+  /* Difference between the optimal variance and the variance along the
+     orthogonal direction. Again, the sum(x^2) terms cancel out. */
+  *var = best_cost - cost[(best_dir + 4) & 7];
+  /* We'd normally divide by 840, but dividing by 1024 is close enough
+     for what we're going to do with this. */
+  *var >>= 10;
+  return best_dir;
+}
+
 /* Detect direction. 0 means 45-degree up-right, 2 is horizontal, and so on.
    The search minimizes the weighted variance along all the lines in a
    particular direction, i.e. the squared error between the input and a
@@ -58,13 +82,11 @@ const double OD_DERING_GAIN_TABLE[OD_DERING_LEVELS] = {
    in a particular direction. Since each direction have the same sum(x^2) term,
    that term is never computed. See Section 2, step 2, of:
    http://jmvalin.ca/notes/intra_paint.pdf */
-static int od_dir_find8(const od_dering_in *img, int stride, int32_t *var,
-    int coeff_shift) {
+int od_dir_find8_c(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift) {
   int i;
   int32_t cost[8] = {0};
   int partial[8][15] = {{0}};
-  int32_t best_cost = 0;
-  int best_dir = 0;
   /* Instead of dividing by n between 2 and 8, we multiply by 3*5*7*8/n.
      The output is then 840 times larger, but we don't care for finding
      the max. */
@@ -109,19 +131,7 @@ static int od_dir_find8(const od_dering_in *img, int stride, int32_t *var,
        + partial[i][10 - j]*partial[i][10 - j])*div_table[2*j + 2];
     }
   }
-  for (i = 0; i < 8; i++) {
-    if (cost[i] > best_cost) {
-      best_cost = cost[i];
-      best_dir = i;
-    }
-  }
-  /* Difference between the optimal variance and the variance along the
-     orthogonal direction. Again, the sum(x^2) terms cancel out. */
-  *var = best_cost - cost[(best_dir + 4) & 7];
-  /* We'd normally divide by 840, but dividing by 1024 is close enough
-     for what we're going to do with this. */
-  *var >>= 10;
-  return best_dir;
+  return od_dir_find8_best(cost, var);
 }
 
 #define OD_DERING_VERY_LARGE (30000)
@@ -279,7 +289,7 @@ void od_dering(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
   if (pli == 0) {
     for (by = 0; by < nvb; by++) {
       for (bx = 0; bx < nhb; bx++) {
-        dir[by][bx] = od_dir_find8(&x[8*by*xstride + 8*bx], xstride,
+        dir[by][bx] = (vtbl->dir_find8)(&x[8*by*xstride + 8*bx], xstride,
          &var[by][bx], coeff_shift);
       }
     }
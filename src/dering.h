@@ -53,10 +53,13 @@ typedef void (*od_filter_dering_direction_func)(int16_t *y, int ystride,
 typedef void (*od_filter_dering_orthogonal_func)(int16_t *y, int ystride,
  const int16_t *in, const od_dering_in *x, int xstride, int threshold,
  int dir);
+typedef int (*od_dir_find8_func)(const od_dering_in *img, int stride,
+ int32_t *var, int coeff_shift);
 
 struct od_dering_opt_vtbl {
   od_filter_dering_direction_func filter_dering_direction[OD_DERINGSIZES];
   od_filter_dering_orthogonal_func filter_dering_orthogonal[OD_DERINGSIZES];
+  od_dir_find8_func dir_find8;
 };
 typedef struct od_dering_opt_vtbl od_dering_opt_vtbl;
 
@@ -66,6 +69,9 @@ void od_dering(const od_dering_opt_vtbl *vtbl, int16_t *y, int ystride,
  int nhsb, int nvsb, int xdec, int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS],
  int pli, unsigned char *bskip, int skip_stride, int threshold, int overlap,
  int coeff_shift);
+int od_dir_find8_best(const int32_t cost[8], int32_t *var);
+int od_dir_find8_c(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift);
 void od_filter_dering_direction_c(int16_t *y, int ystride, const int16_t *in,
  int ln, int threshold, int dir);
 void od_filter_dering_orthogonal_c(int16_t *y, int ystride, const int16_t *in,
@@ -34,6 +34,7 @@ typedef struct od_input_queue od_input_queue;
 typedef struct od_input_frame od_input_frame;
 typedef struct od_iir_bessel2 od_iir_bessel2;
 typedef struct od_rc_state od_rc_state;
+typedef struct od_frame_metrics od_frame_metrics;
 
 # include "../include/daala/daaladec.h"
 # include "../include/daala/daalaenc.h"
@@ -72,6 +73,13 @@ typedef struct od_rc_state od_rc_state;
 # define OD_DQP_P (0)
 # define OD_DQP_B (1)
 
+/* OD_DIST_LP_MID controls the frequency weighting filter used for computing
+   the distortion. For a value X, the filter is [1 X 1]/(X + 2) and
+   is applied both horizontally and vertically. For X=5, the filter is
+   a good approximation for the OD_QM8_Q4_HVS quantization matrix. */
+# define OD_DIST_LP_MID (5)
+# define OD_DIST_LP_NORM (OD_DIST_LP_MID + 2)
+
 /*Rougly how often do golden frames pop.*/
 #define OD_GOLDEN_FRAME_INTERVAL 10
 
@@ -96,8 +104,20 @@ struct od_enc_opt_vtbl {
    int systride, const unsigned char *ref, int dystride);
   int32_t (*mc_compute_satd_64x64)(const unsigned char *src,
    int systride, const unsigned char *ref, int dystride);
+  int (*pvq_search_max)(const int32_t *x, const int32_t *y,
+   const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+   int shift, int n);
+  void (*compute_var_8x8)(int32_t var[9], const od_coeff *x, int stride);
+  void (*compute_dist_lp)(double *lp_energy, const od_coeff *x,
+   const od_coeff *y, int n);
+  struct od_block_size_opt_vtbl block_size;
 };
 
+/*The size of the two-pass summary header, in bytes.*/
+# define OD_RC_2PASS_HDR_SZ (60)
+/*The size of the two-pass metrics of a single frame, in bytes.*/
+# define OD_RC_2PASS_PACKET_SZ (8)
+
 /*A 2nd order low-pass Bessel follower.
   We use this for rate control because it has fast reaction time, but is
    critically damped.*/
@@ -108,6 +128,16 @@ struct od_iir_bessel2{
   int32_t y[2];
 };
 
+/*The first-pass metrics of a single frame.*/
+struct od_frame_metrics {
+  /*The log of the scale factor for the rate model in Q24 format.*/
+  int32_t log_scale;
+  /*The number of bits the frame used in the first pass.*/
+  int32_t bits;
+  /*The frame subtype (an OD_FRAME_NSUBTYPES index).*/
+  int frame_subtype;
+};
+
 /*Rate control setup and working state information.*/
 struct od_rc_state {
   /*The target bit-rate in bits per second.*/
@@ -140,7 +170,9 @@ struct od_rc_state {
   int64_t reservoir_target;
   /*The maximum buffer fullness (total size of the buffer).*/
   int64_t reservoir_max;
-  /*The log of estimated scale factor for the rate model in Q57 format.*/
+  /*The log of estimated scale factor for the rate model in Q57 format.
+    In pass 2 of two-pass mode, this is instead the log of the ratio between
+     the scale factors measured now and in pass 1.*/
   int64_t log_scale[OD_FRAME_NSUBTYPES];
   /*The exponent used in the rate model in Q8 format.*/
   unsigned exp[OD_FRAME_NSUBTYPES];
@@ -158,6 +190,32 @@ struct od_rc_state {
   int inter_delay_target;
   /*The total accumulated estimation bias.*/
   int64_t rate_bias;
+  /*Buffer for the two-pass metrics: the data returned by the last call to
+     od_enc_rc_2pass_out() in pass 1, or the partially-read input in pass 2.*/
+  unsigned char twopass_buffer[OD_RC_2PASS_HDR_SZ];
+  /*The number of bytes in the buffer.*/
+  int twopass_buffer_bytes;
+  /*Pass 1: whether the metrics of the last frame still have to be output.*/
+  int twopass_frame_pending;
+  /*The metrics of the current frame.*/
+  od_frame_metrics cur_metrics;
+  /*The total number of frames of each subtype in the file.*/
+  int32_t frames_total[OD_FRAME_NSUBTYPES];
+  /*The sum of the scale factors of each subtype in the file in Q24 format.*/
+  int64_t scale_sum[OD_FRAME_NSUBTYPES];
+  /*Pass 2: the rate model exponents used in pass 1.*/
+  unsigned twopass_exp[OD_FRAME_NSUBTYPES];
+  /*Pass 2: a circular FIFO of the metrics of the upcoming frames, starting
+     with the current one, or NULL until the summary has been read.*/
+  od_frame_metrics *frame_metrics;
+  int cframe_metrics;
+  int frame_metrics_head;
+  int nframe_metrics;
+  /*Pass 2: the number of frames read into the FIFO so far.*/
+  int64_t frames_read;
+  /*Pass 2: the sum of the scale factors of each subtype in the FIFO in Q24
+     format.*/
+  int64_t scale_window[OD_FRAME_NSUBTYPES];
 };
 
 /*Unsanitized user parameters*/
@@ -233,6 +291,9 @@ struct daala_enc_ctx{
   double pvq_norm_lambda;
   /*The deringing filter RDO lambda.*/
   double dering_lambda;
+  /*The luma distortion of each deringing level for each superblock of the
+     current frame.*/
+  double *dering_dist;
   od_mv_est_ctx *mvest;
   od_params_ctx params;
 #if defined(OD_ENCODER_CHECK)
@@ -246,7 +307,10 @@ struct daala_enc_ctx{
   FILE *bsize_dist_file;
 #endif
   od_block_size_comp *bs;
-  /* These buffers are for saving pixel data during block size RDO. */
+  /* These buffers are for saving pixel data during block size RDO.
+     They must stay together, from mc_orig up to input_queue: tile and
+      parallel RDO contexts have their own, so od_enc_worker_refresh() skips
+      that range. */
   od_coeff mc_orig[OD_NBSIZES-1][OD_BSIZE_MAX*OD_BSIZE_MAX];
   od_coeff c_orig[OD_NBSIZES-1][OD_BSIZE_MAX*OD_BSIZE_MAX];
   od_coeff nosplit[OD_NBSIZES-1][OD_BSIZE_MAX*OD_BSIZE_MAX];
@@ -283,6 +347,20 @@ struct daala_enc_ctx{
   int ani_iter;
 # endif
 #endif
+  /*Encoder contexts for each tile of a frame, or NULL with a single tile.
+    Each one is refreshed from this context at the start of the tile, and
+     only owns its entropy encoder, adaptation state and scratch buffers.*/
+  struct daala_enc_ctx *tiles;
+  od_coeff *tile_lbuf;
+  /*Whether block-size RDO decides each superblock independently, starting
+     from the adaptation state at the start of the frame (OD_SET_PARALLEL_RDO).*/
+  int parallel_rdo;
+  /*Encoder contexts for each thread of a parallel block-size RDO, refreshed
+     from this context at the start of the stage, or NULL if not allocated.*/
+  struct daala_enc_ctx *rdo_workers;
+  int nrdo_workers;
+  /*The number of superblocks decided so far in each row.*/
+  od_progress *rdo_sb_rows;
 };
 
 /** Holds important encoder information so we can roll back decisions */
@@ -352,6 +430,9 @@ int32_t od_mc_compute_satd16_32x32_c(const unsigned char *src, int systride,
  const unsigned char *ref, int dystride);
 int32_t od_mc_compute_satd16_64x64_c(const unsigned char *src, int systride,
  const unsigned char *ref, int dystride);
+void od_compute_var_8x8_c(int32_t var[9], const od_coeff *x, int stride);
+void od_compute_dist_lp_c(double *lp_energy, const od_coeff *x,
+ const od_coeff *y, int n);
 void od_enc_opt_vtbl_init_c(od_enc_ctx *enc);
 
 # if defined(OD_DUMP_IMAGES)
@@ -364,5 +445,8 @@ void od_state_draw_mvs(daala_enc_ctx *enc);
 # if defined(OD_X86ASM)
 void od_enc_opt_vtbl_init_x86(od_enc_ctx *enc);
 # endif
+# if defined(OD_NEON_INTRINSICS)
+void od_enc_opt_vtbl_init_arm(od_enc_ctx *enc);
+# endif
 
 #endif
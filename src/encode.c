@@ -182,11 +182,17 @@ void od_enc_opt_vtbl_init_c(od_enc_ctx *enc) {
     enc->opt_vtbl.mc_compute_satd_64x64 =
       od_mc_compute_satd8_64x64_c;
   }
+  enc->opt_vtbl.pvq_search_max = od_pvq_search_max_c;
+  enc->opt_vtbl.compute_var_8x8 = od_compute_var_8x8_c;
+  enc->opt_vtbl.compute_dist_lp = od_compute_dist_lp_c;
+  OD_COPY(&enc->opt_vtbl.block_size, &OD_BLOCK_SIZE_VTBL_C, 1);
 }
 
 static void od_enc_opt_vtbl_init(od_enc_ctx *enc) {
 #if defined(OD_X86ASM)
   od_enc_opt_vtbl_init_x86(enc);
+#elif defined(OD_NEON_INTRINSICS)
+  od_enc_opt_vtbl_init_arm(enc);
 #else
   od_enc_opt_vtbl_init_c(enc);
 #endif
@@ -364,6 +370,59 @@ od_input_frame *od_input_queue_next(od_input_queue *in, int *last) {
   return NULL;
 }
 
+static void od_enc_rdo_workers_clear(daala_enc_ctx *enc) {
+  int i;
+  if (enc->rdo_sb_rows != NULL) {
+    for (i = 0; i < enc->state.nvsb; i++) {
+      od_progress_clear(enc->rdo_sb_rows + i);
+    }
+    free(enc->rdo_sb_rows);
+    enc->rdo_sb_rows = NULL;
+  }
+  if (enc->rdo_workers != NULL) {
+    for (i = 0; i < enc->nrdo_workers; i++) {
+      od_ec_enc_clear(&enc->rdo_workers[i].ec);
+    }
+    free(enc->rdo_workers);
+    enc->rdo_workers = NULL;
+  }
+  enc->nrdo_workers = 0;
+}
+
+/*Makes sure there is one encoder context per thread of the pool for
+   od_encode_sbs_rdo().
+  Returns the number of contexts, or 0 if they could not be allocated.*/
+static int od_enc_rdo_workers_update(daala_enc_ctx *enc) {
+  int nworkers;
+  int nvsb;
+  int i;
+  nworkers = enc->state.threads.nthreads;
+  if (enc->nrdo_workers == nworkers) return nworkers;
+  od_enc_rdo_workers_clear(enc);
+  nvsb = enc->state.nvsb;
+  enc->rdo_sb_rows = (od_progress *)malloc(sizeof(*enc->rdo_sb_rows)*nvsb);
+  if (OD_UNLIKELY(!enc->rdo_sb_rows)) {
+    return 0;
+  }
+  for (i = 0; i < nvsb; i++) {
+    if (OD_UNLIKELY(od_progress_init(enc->rdo_sb_rows + i) < 0)) {
+      while (i-- > 0) od_progress_clear(enc->rdo_sb_rows + i);
+      free(enc->rdo_sb_rows);
+      enc->rdo_sb_rows = NULL;
+      return 0;
+    }
+  }
+  enc->rdo_workers =
+   (daala_enc_ctx *)malloc(sizeof(*enc->rdo_workers)*nworkers);
+  if (OD_UNLIKELY(!enc->rdo_workers)) {
+    od_enc_rdo_workers_clear(enc);
+    return 0;
+  }
+  for (i = 0; i < nworkers; i++) od_ec_enc_init(&enc->rdo_workers[i].ec, 65025);
+  enc->nrdo_workers = nworkers;
+  return nworkers;
+}
+
 static int od_enc_init(od_enc_ctx *enc, const daala_info *info) {
   int ret;
 #if defined(OD_DUMP_BSIZE_DIST)
@@ -376,6 +435,24 @@ static int od_enc_init(od_enc_ctx *enc, const daala_info *info) {
   od_enc_opt_vtbl_init(enc);
   oggbyte_writeinit(&enc->obb);
   od_ec_enc_init(&enc->ec, 65025);
+  enc->tiles = NULL;
+  enc->tile_lbuf = NULL;
+  enc->parallel_rdo = 0;
+  enc->rdo_workers = NULL;
+  enc->nrdo_workers = 0;
+  enc->rdo_sb_rows = NULL;
+  if (OD_NTILES(info) > 1) {
+    int tile;
+    enc->tiles = (od_enc_ctx *)malloc(OD_NTILES(info)*sizeof(*enc->tiles));
+    enc->tile_lbuf = (od_coeff *)malloc(OD_NTILES(info)*info->nplanes*
+     OD_BSIZE_MAX*OD_BSIZE_MAX*sizeof(*enc->tile_lbuf));
+    if (OD_UNLIKELY(!enc->tiles || !enc->tile_lbuf)) {
+      return OD_EFAULT;
+    }
+    for (tile = 0; tile < OD_NTILES(info); tile++) {
+      od_ec_enc_init(&enc->tiles[tile].ec, 65025);
+    }
+  }
   enc->packet_state = OD_PACKET_INFO_HDR;
   enc->quality = 10;
   enc->complexity = 7;
@@ -392,6 +469,11 @@ static int od_enc_init(od_enc_ctx *enc, const daala_info *info) {
   enc->params.mv_level_min = 0;
   enc->params.mv_level_max = 4;
   enc->bs = (od_block_size_comp *)malloc(sizeof(*enc->bs));
+  enc->dering_dist = (double *)malloc(sizeof(*enc->dering_dist)*
+   enc->state.nhsb*enc->state.nvsb*OD_DERING_LEVELS);
+  if (OD_UNLIKELY(!enc->dering_dist)) {
+    return OD_EFAULT;
+  }
   enc->b_frames = 0;
   enc->frame_delay = enc->b_frames + 1;
   od_input_queue_init(&enc->input_queue, enc);
@@ -503,6 +585,16 @@ static int od_enc_init(od_enc_ctx *enc, const daala_info *info) {
 static void od_enc_clear(od_enc_ctx *enc) {
   od_mv_est_free(enc->mvest);
   od_ec_enc_clear(&enc->ec);
+  if (enc->tiles != NULL) {
+    int tile;
+    for (tile = 0; tile < OD_NTILES(&enc->state.info); tile++) {
+      od_ec_enc_clear(&enc->tiles[tile].ec);
+    }
+    free(enc->tiles);
+  }
+  free(enc->tile_lbuf);
+  od_enc_rdo_workers_clear(enc);
+  od_enc_rc_clear(enc);
   oggbyte_writeclear(&enc->obb);
   od_input_queue_clear(&enc->input_queue);
 #if defined(OD_DUMP_IMAGES)
@@ -543,6 +635,7 @@ void daala_encode_free(daala_enc_ctx *enc) {
     }
 #endif
     free(enc->bs);
+    free(enc->dering_dist);
     od_enc_clear(enc);
     free(enc);
   }
@@ -735,6 +828,19 @@ int daala_encode_ctl(daala_enc_ctx *enc, int req, void *buf, size_t buf_sz) {
       OD_RETURN_CHECK(enc, OD_EFAULT);
       return od_enc_rc_2pass_in(enc, buf, buf_sz);
     }
+    case OD_SET_PARALLEL_RDO: {
+      OD_RETURN_CHECK(enc, OD_EFAULT);
+      OD_RETURN_CHECK(buf, OD_EFAULT);
+      OD_RETURN_CHECK(buf_sz == sizeof(enc->parallel_rdo), OD_EINVAL);
+      enc->parallel_rdo = !!*(const int *)buf;
+      return OD_SUCCESS;
+    }
+    case OD_SET_THREADS: {
+      OD_RETURN_CHECK(enc, OD_EFAULT);
+      OD_RETURN_CHECK(buf, OD_EFAULT);
+      OD_RETURN_CHECK(buf_sz == sizeof(int), OD_EINVAL);
+      return od_state_set_threads(&enc->state, *(const int *)buf);
+    }
     default: return OD_EIMPL;
   }
 }
@@ -852,6 +958,11 @@ struct od_mb_enc_ctx {
   int is_golden_frame;
   int frame_type;
   int q_scaling;
+  /*The superblocks [sbx0, sbx1) x [sby0, sby1) of the tile being encoded.*/
+  int sbx0;
+  int sby0;
+  int sbx1;
+  int sby1;
 };
 typedef struct od_mb_enc_ctx od_mb_enc_ctx;
 
@@ -874,8 +985,9 @@ static void od_encode_compute_pred(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
     if (pli == 0 || OD_DISABLE_CFL || ctx->use_haar_wavelet) {
       OD_CLEAR(pred, n*n);
       if (pli == 0 && !ctx->use_haar_wavelet) {
-        od_hv_intra_pred(pred, d, w, bx, by, enc->state.bsize,
-         enc->state.bstride, bs);
+        od_hv_intra_pred(pred, d, w, bx, by,
+         ctx->sbx0 << (OD_NBSIZES - 1), ctx->sby0 << (OD_NBSIZES - 1),
+         enc->state.bsize, enc->state.bstride, bs);
       }
     }
     else {
@@ -1079,16 +1191,16 @@ static int od_wavelet_quantize(daala_enc_ctx *enc, int ln,
   return 0;
 }
 
-static int od_compute_var_4x4(od_coeff *x, int stride) {
-  int sum;
-  int s2;
+static int32_t od_compute_var_4x4(const od_coeff *x, int stride) {
+  int32_t sum;
+  int32_t s2;
   int i;
   sum = 0;
   s2 = 0;
   for (i = 0; i < 4; i++) {
     int j;
     for (j = 0; j < 4; j++) {
-      int t;
+      int32_t t;
       /* Avoids overflow in the sum^2 below because the pre-filtered input
          can be much larger than +/-128 << OD_COEFF_SHIFT. Shifting the sum
          itself is a bad idea because it leads to large error on low
@@ -1101,15 +1213,69 @@ static int od_compute_var_4x4(od_coeff *x, int stride) {
   return (s2 - (sum*sum >> 4));
 }
 
-/* OD_DIST_LP_MID controls the frequency weighting filter used for computing
-   the distortion. For a value X, the filter is [1 X 1]/(X + 2) and
-   is applied both horizontally and vertically. For X=5, the filter is
-   a good approximation for the OD_QM8_Q4_HVS quantization matrix. */
-#define OD_DIST_LP_MID (5)
-#define OD_DIST_LP_NORM (OD_DIST_LP_MID + 2)
+/*Computes the variances of the 3x3 overlapping 4x4 windows (at even offsets)
+   of an 8x8 block, in raster order.*/
+void od_compute_var_8x8_c(int32_t var[9], const od_coeff *x, int stride) {
+  int i;
+  int j;
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < 3; j++) {
+      var[i*3 + j] = od_compute_var_4x4(x + 2*i*stride + 2*j, stride);
+    }
+  }
+}
+
+/*Applies the OD_DIST_LP_MID low-pass filter to the error x - y of an n x n
+   block and returns the energy of the result for each 8x8 sub-block, in
+   raster order.*/
+void od_compute_dist_lp_c(double *lp_energy, const od_coeff *x,
+ const od_coeff *y, int n) {
+  od_coeff e[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  od_coeff tmp[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  od_coeff e_lp[OD_BSIZE_MAX*OD_BSIZE_MAX];
+  int mid = OD_DIST_LP_MID;
+  int i;
+  int j;
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j++) {
+      e[i*n + j] = x[i*n + j] - y[i*n + j];
+    }
+  }
+  for (i = 0; i < n; i++) {
+    tmp[i*n] = mid*e[i*n] + 2*e[i*n + 1];
+    tmp[i*n + n - 1] = mid*e[i*n + n - 1] + 2*e[i*n + n - 2];
+    for (j = 1; j < n - 1; j++) {
+      tmp[i*n + j] = mid*e[i*n + j] + e[i*n + j - 1] + e[i*n + j + 1];
+    }
+  }
+  for (j = 0; j < n; j++) {
+    e_lp[j] = mid*tmp[j] + 2*tmp[n + j];
+    e_lp[(n - 1)*n + j] = mid*tmp[(n - 1)*n + j] + 2*tmp[(n - 2)*n + j];
+  }
+  for (i = 1; i < n - 1; i++) {
+    for (j = 0; j < n; j++) {
+      e_lp[i*n + j] = mid*tmp[i*n + j] + tmp[(i - 1)*n + j]
+       + tmp[(i + 1)*n + j];
+    }
+  }
+  for (i = 0; i < n; i += 8) {
+    for (j = 0; j < n; j += 8) {
+      double sum;
+      int k;
+      int l;
+      sum = 0;
+      for (k = 0; k < 8; k++) {
+        for (l = 0; l < 8; l++) {
+          sum += e_lp[(i + k)*n + j + l]*(double)e_lp[(i + k)*n + j + l];
+        }
+      }
+      *lp_energy++ = sum;
+    }
+  }
+}
 
 static double od_compute_dist_8x8(daala_enc_ctx *enc, od_coeff *x, od_coeff *y,
- od_coeff *e_lp, int stride) {
+ double lp_energy, int stride) {
   double sum;
   int min_var;
   double mean_var;
@@ -1117,23 +1283,22 @@ static double od_compute_dist_8x8(daala_enc_ctx *enc, od_coeff *x, od_coeff *y,
   double activity;
   double calibration;
   int i;
-  int j;
   double vardist;
   vardist = 0;
   OD_ASSERT(enc->qm != OD_FLAT_QM);
 #if 1
-  min_var = INT_MAX;
-  mean_var = 0;
-  for (i = 0; i < 3; i++) {
-    for (j = 0; j < 3; j++) {
-      int varx;
-      int vary;
-      varx = od_compute_var_4x4(x + 2*i*stride + 2*j, stride);
-      vary = od_compute_var_4x4(y + 2*i*stride + 2*j, stride);
-      min_var = OD_MINI(min_var, varx);
-      mean_var += 1./(1 + varx);
+  {
+    int32_t varx[9];
+    int32_t vary[9];
+    (*enc->opt_vtbl.compute_var_8x8)(varx, x, stride);
+    (*enc->opt_vtbl.compute_var_8x8)(vary, y, stride);
+    min_var = INT_MAX;
+    mean_var = 0;
+    for (i = 0; i < 9; i++) {
+      min_var = OD_MINI(min_var, varx[i]);
+      mean_var += 1./(1 + varx[i]);
       /*The cast to (double) is to avoid an overflow before the sqrt.*/
-      vardist += varx - 2*sqrt(varx*(double)vary) + vary;
+      vardist += varx[i] - 2*sqrt(varx[i]*(double)vary[i]) + vary[i];
     }
   }
   /* We use a different variance statistic depending on whether activity
@@ -1154,12 +1319,7 @@ static double od_compute_dist_8x8(daala_enc_ctx *enc, od_coeff *x, od_coeff *y,
 #else
   activity = 1;
 #endif
-  sum = 0;
-  for (i = 0; i < 8; i++) {
-    for (j = 0; j < 8; j++) {
-      sum += e_lp[i*stride + j]*(double)e_lp[i*stride + j];
-    }
-  }
+  sum = lp_energy;
   /* Normalize the filter to unit DC response and add rough compensation for
      basis magnitude. */
   sum *= 0.92/(OD_DIST_LP_NORM*OD_DIST_LP_NORM*OD_DIST_LP_NORM*OD_DIST_LP_NORM);
@@ -1181,36 +1341,13 @@ static double od_compute_dist(daala_enc_ctx *enc, od_coeff *x, od_coeff *y,
   }
   else {
     int j;
-    od_coeff e[OD_BSIZE_MAX*OD_BSIZE_MAX];
-    od_coeff tmp[OD_BSIZE_MAX*OD_BSIZE_MAX];
-    od_coeff e_lp[OD_BSIZE_MAX*OD_BSIZE_MAX];
-    int mid = OD_DIST_LP_MID;
-    for (i = 0; i < n; i++) {
-      for (j = 0; j < n; j++) {
-        e[i*n + j] = x[i*n + j] - y[i*n + j];
-      }
-    }
-    for (i = 0; i < n; i++) {
-      tmp[i*n] = mid*e[i*n] + 2*e[i*n + 1];
-      tmp[i*n + n - 1] = mid*e[i*n + n - 1] + 2*e[i*n + n - 2];
-      for (j = 1; j < n - 1; j++) {
-        tmp[i*n + j] = mid*e[i*n + j] + e[i*n + j - 1] + e[i*n + j + 1];
-      }
-    }
-    for (j = 0; j < n; j++) {
-      e_lp[j] = mid*tmp[j] + 2*tmp[n + j];
-      e_lp[(n - 1)*n + j] = mid*tmp[(n - 1)*n + j] + 2*tmp[(n - 2)*n + j];
-    }
-    for (i = 1; i < n - 1; i++) {
-      for (j = 0; j < n; j++) {
-        e_lp[i*n + j] = mid*tmp[i*n + j] + tmp[(i - 1)*n + j]
-         + tmp[(i + 1)*n + j];
-      }
-    }
+    double lp_energy[(OD_BSIZE_MAX >> 3)*(OD_BSIZE_MAX >> 3)];
+    OD_ASSERT(n >= 8 && !(n & 7));
+    (*enc->opt_vtbl.compute_dist_lp)(lp_energy, x, y, n);
     for (i = 0; i < n; i += 8) {
       for (j = 0; j < n; j += 8) {
         sum += od_compute_dist_8x8(enc, &x[i*n + j], &y[i*n + j],
-         &e_lp[i*n + j], n);
+         lp_energy[(i >> 3)*(n >> 3) + (j >> 3)], n);
       }
     }
     /* Compensate for the fact that the quantization matrix lowers the
@@ -1394,7 +1531,8 @@ static int od_block_encode(daala_enc_ctx *enc, od_mb_enc_ctx *ctx, int bs,
     od_haar_inv(c + bo, w, d + bo, w, bs + 2);
   }
   else {
-    (*enc->state.opt_vtbl.idct_2d[bs])(c + bo, w, d + bo, w);
+    od_bin_idct_2d_sparse(enc->state.opt_vtbl.idct_2d[bs], c + bo, w, d + bo,
+     w, bs);
   }
 #else
 # if 0
@@ -1446,7 +1584,8 @@ static int od_block_encode(daala_enc_ctx *enc, od_mb_enc_ctx *ctx, int bs,
           d[bo + i*w + j] = md[bo + i*w + j];
         }
       }
-      (*enc->state.opt_vtbl.idct_2d[bs])(c + bo, w, d + bo, w);
+      od_bin_idct_2d_sparse(enc->state.opt_vtbl.idct_2d[bs], c + bo, w,
+       d + bo, w, bs);
     }
   }
   return skip;
@@ -1486,7 +1625,8 @@ static void od_compute_dcts(daala_enc_ctx *enc, od_mb_enc_ctx *ctx, int pli,
     bo = (by << (OD_LOG_BSIZE0 + bs))*w + (bx << (OD_LOG_BSIZE0 + bs));
     hfilter = (bx + 1) << (OD_LOG_BSIZE0 + bs) <= enc->state.info.pic_width;
     vfilter = (by + 1) << (OD_LOG_BSIZE0 + bs) <= enc->state.info.pic_height;
-    od_prefilter_split(ctx->c + bo, w, bs, f, hfilter, vfilter);
+    od_prefilter_split(&enc->state.opt_vtbl.filter, ctx->c + bo, w, bs, f,
+     hfilter, vfilter);
     bsi--;
     bx <<= 1;
     by <<= 1;
@@ -1547,6 +1687,8 @@ static void od_quantize_haar_dc_sb(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
   od_coeff sb_dc_pred;
   od_coeff sb_dc_curr;
   od_coeff *sb_dc_mem;
+  int top;
+  int left;
   OD_UNUSED(ydec);
   d = ctx->d[pli];
   w = enc->state.frame_width >> xdec;
@@ -1560,7 +1702,10 @@ static void od_quantize_haar_dc_sb(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
   nhsb = enc->state.nhsb;
   sb_dc_mem = enc->state.sb_dc_mem[pli];
   ln = OD_LOG_BSIZE_MAX - xdec;
-  if (by > 0 && bx > 0) {
+  /*Superblocks in other tiles are not available for prediction.*/
+  top = by > ctx->sby0;
+  left = bx > ctx->sbx0;
+  if (top && left) {
     /* These coeffs were LS-optimized on subset 1. */
     if (has_ur) {
       sb_dc_pred = (22*sb_dc_mem[by*nhsb + bx - 1]
@@ -1574,8 +1719,8 @@ static void od_quantize_haar_dc_sb(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
        + 19*sb_dc_mem[(by - 1)*nhsb + bx] + 16) >> 5;
     }
   }
-  else if (by > 0) sb_dc_pred = sb_dc_mem[(by - 1)*nhsb + bx];
-  else if (bx > 0) sb_dc_pred = sb_dc_mem[by*nhsb + bx - 1];
+  else if (top) sb_dc_pred = sb_dc_mem[(by - 1)*nhsb + bx];
+  else if (left) sb_dc_pred = sb_dc_mem[by*nhsb + bx - 1];
   else sb_dc_pred = 0;
   dc0 = d[(by << ln)*w + (bx << ln)] - sb_dc_pred;
   quant = OD_DIV_R0(dc0, dc_quant);
@@ -1585,8 +1730,8 @@ static void od_quantize_haar_dc_sb(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
   sb_dc_curr = quant*dc_quant + sb_dc_pred;
   d[(by << ln)*w + (bx << ln)] = sb_dc_curr;
   sb_dc_mem[by*nhsb + bx] = sb_dc_curr;
-  if (by > 0) *ovgrad = sb_dc_mem[(by - 1)*nhsb + bx] - sb_dc_curr;
-  if (bx > 0) *ohgrad = sb_dc_mem[by*nhsb + bx - 1]- sb_dc_curr;
+  if (top) *ovgrad = sb_dc_mem[(by - 1)*nhsb + bx] - sb_dc_curr;
+  if (left) *ohgrad = sb_dc_mem[by*nhsb + bx - 1]- sb_dc_curr;
 }
 #endif
 
@@ -1757,9 +1902,11 @@ static int od_encode_recursive(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
     f = OD_FILT_SIZE(bs - 1, xdec);
     hfilter = (bx + 1) << (OD_LOG_BSIZE0 + bs) <= enc->state.info.pic_width;
     vfilter = (by + 1) << (OD_LOG_BSIZE0 + bs) <= enc->state.info.pic_height;
-    od_prefilter_split(ctx->c + bo, w, bs, f, hfilter, vfilter);
+    od_prefilter_split(&enc->state.opt_vtbl.filter, ctx->c + bo, w, bs, f,
+     hfilter, vfilter);
     if (!ctx->is_keyframe) {
-      od_prefilter_split(ctx->mc + bo, w, bs, f, hfilter, vfilter);
+      od_prefilter_split(&enc->state.opt_vtbl.filter, ctx->mc + bo, w, bs, f,
+       hfilter, vfilter);
     }
     skip_split = 1;
     if (pli == 0) {
@@ -1786,7 +1933,8 @@ static int od_encode_recursive(daala_enc_ctx *enc, od_mb_enc_ctx *ctx,
     skip_split &= od_encode_recursive(enc, ctx, pli, 2*bx + 1, 2*by + 1,
      bsi - 1, xdec, ydec, rdo_only, hgrad, vgrad);
     skip_block = skip_split;
-    od_postfilter_split(ctx->c + bo, w, bs, f, enc->state.coded_quantizer,
+    od_postfilter_split(&enc->state.opt_vtbl.filter, ctx->c + bo, w, bs, f,
+     enc->state.coded_quantizer,
      &enc->state.bskip[pli][(by << bs)*enc->state.skip_stride + (bx << bs)],
      enc->state.skip_stride, hfilter, vfilter);
     if (rdo_only && bsi <= OD_LIMIT_BSIZE_MAX) {
@@ -2415,11 +2563,30 @@ static void od_split_superblocks(daala_enc_ctx *enc, int is_keyframe) {
     for (j = 0; j < nhsb; j++) {
       int bsize[OD_BSIZE_GRID][OD_BSIZE_GRID];
       unsigned char *state_bsize;
+      int qi;
+      int qj;
       state_bsize =
        &state->bsize[i*OD_BSIZE_GRID*state->bstride + j*OD_BSIZE_GRID];
-      od_split_superblock(enc->bs, bimg + j*OD_BSIZE_MAX, istride,
-       is_keyframe ? NULL : rimg + j*OD_BSIZE_MAX, rstride, bsize,
-       state->quantizer);
+      /* `od_split_superblock` only decides how to split a 32x32 block, so
+         run it on each quadrant of the superblock. */
+      for (qi = 0; qi < 2; qi++) {
+        for (qj = 0; qj < 2; qj++) {
+          int qbsize[OD_BSIZE_GRID][OD_BSIZE_GRID];
+          int qoff;
+          qoff = j*OD_BSIZE_MAX + qj*(OD_BSIZE_MAX >> 1);
+          od_split_superblock(&enc->opt_vtbl.block_size, enc->bs,
+           bimg + qi*(OD_BSIZE_MAX >> 1)*istride + qoff, istride,
+           is_keyframe ? NULL :
+           rimg + qi*(OD_BSIZE_MAX >> 1)*rstride + qoff, rstride, qbsize,
+           state->quantizer);
+          for (k = 0; k < OD_BSIZE_GRID >> 1; k++) {
+            for (m = 0; m < OD_BSIZE_GRID >> 1; m++) {
+              bsize[qi*(OD_BSIZE_GRID >> 1) + k][qj*(OD_BSIZE_GRID >> 1) + m]
+               = qbsize[k][m];
+            }
+          }
+        }
+      }
       /* Grab the 4x4 information returned from `od_split_superblock` in bsize
          and store it in the od_state bsize. */
       for (k = 0; k < OD_BSIZE_GRID; k++) {
@@ -2536,6 +2703,450 @@ static int od_compute_superblock_q_scaling(daala_enc_ctx *enc, od_coeff *x,
 
 #define OD_ENCODE_REAL (0)
 #define OD_ENCODE_RDO (1)
+/*Encodes (or, with rdo_only, chooses the block sizes of) one superblock.*/
+static void od_encode_sb(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
+ int sbx, int sby, int rdo_only) {
+  int xdec;
+  int ydec;
+  int pli;
+  int nplanes;
+  od_state *state;
+  state = &enc->state;
+  nplanes = state->info.nplanes;
+  if (rdo_only) nplanes = 1;
+  for (pli = 0; pli < nplanes; pli++) {
+    od_coeff *c_orig;
+    int i;
+    int j;
+    int width;
+    od_rollback_buffer buf;
+    od_coeff hgrad;
+    od_coeff vgrad;
+    width = enc->state.frame_width;
+    hgrad = vgrad = 0;
+    c_orig = enc->c_orig[0];
+    mbctx->c = state->ctmp[pli];
+    mbctx->d = state->dtmp;
+    mbctx->mc = state->mctmp[pli];
+    mbctx->md = state->mdtmp[pli];
+    mbctx->l = state->lbuf[pli];
+    xdec = state->info.plane_info[pli].xdec;
+    ydec = state->info.plane_info[pli].ydec;
+    if (pli == 0 || (rdo_only && mbctx->is_keyframe)) {
+      for (i = 0; i < OD_BSIZE_MAX; i++) {
+        for (j = 0; j < OD_BSIZE_MAX; j++) {
+          c_orig[i*OD_BSIZE_MAX + j] =
+           mbctx->c[(OD_BSIZE_MAX*sby + i)*width + OD_BSIZE_MAX*sbx + j];
+        }
+      }
+    }
+    if (mbctx->is_keyframe) {
+      if (rdo_only) {
+        od_encode_checkpoint(enc, &buf);
+      }
+      od_compute_dcts(enc, mbctx, pli, sbx, sby, OD_NBSIZES - 1, xdec,
+       ydec, mbctx->use_haar_wavelet && !rdo_only);
+      od_quantize_haar_dc_sb(enc, mbctx, pli, sbx, sby, xdec, ydec,
+       sby > mbctx->sby0 && sbx < mbctx->sbx1 - 1, &hgrad, &vgrad);
+      if (rdo_only) {
+        od_encode_rollback(enc, &buf);
+        for (i = 0; i < OD_BSIZE_MAX; i++) {
+          for (j = 0; j < OD_BSIZE_MAX; j++) {
+            mbctx->c[(OD_BSIZE_MAX*sby + i)*width + OD_BSIZE_MAX*sbx + j] =
+             c_orig[i*OD_BSIZE_MAX + j];
+          }
+        }
+      }
+    }
+    if (pli == 0 && !OD_LOSSLESS(enc)) {
+      mbctx->q_scaling =
+       od_compute_superblock_q_scaling(enc, c_orig, OD_BSIZE_MAX);
+    }
+    od_encode_recursive(enc, mbctx, pli, sbx, sby, OD_NBSIZES - 1, xdec,
+     ydec, rdo_only, hgrad, vgrad);
+  }
+}
+
+/*Encodes the superblocks of the tile described by mbctx.*/
+static void od_encode_tile(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
+ int rdo_only) {
+  od_rollback_buffer start;
+  int independent;
+  int sby;
+  int sbx;
+  /*With parallel RDO, each superblock is decided starting from the same
+     adaptation and entropy coder state, exactly as od_encode_sbs_rdo() does,
+     so that the rates it measures do not depend on the other superblocks.*/
+  independent = rdo_only && enc->parallel_rdo;
+  if (independent) od_encode_checkpoint(enc, &start);
+  for (sby = mbctx->sby0; sby < mbctx->sby1; sby++) {
+    for (sbx = mbctx->sbx0; sbx < mbctx->sbx1; sbx++) {
+      if (independent) od_encode_rollback(enc, &start);
+      od_encode_sb(enc, mbctx, sbx, sby, rdo_only);
+    }
+  }
+}
+
+/*Everything needed to encode the tiles of a frame in parallel.*/
+struct od_enc_tiles_ctx {
+  daala_enc_ctx *enc;
+  od_mb_enc_ctx mbctx[OD_TILES_MAX];
+  int rdo_only;
+};
+typedef struct od_enc_tiles_ctx od_enc_tiles_ctx;
+
+/*Copies bytes [start, end) of the encoder context src to dst.*/
+static void od_enc_ctx_copy_range(daala_enc_ctx *dst,
+ const daala_enc_ctx *src, size_t start, size_t end) {
+  OD_ASSERT(start <= end);
+  memcpy((unsigned char *)dst + start, (const unsigned char *)src + start,
+   end - start);
+}
+
+/*Refreshes the encoder context of a tile or of a parallel RDO worker from the
+   main context: the settings, lambdas and frame state are copied, but not
+   what the worker owns.
+  That is its entropy encoder, its adaptation state (which the caller sets
+   up) and the block-size RDO scratch buffers, which make up most of the size
+   of daala_enc_ctx.*/
+static void od_enc_worker_refresh(daala_enc_ctx *wenc,
+ const daala_enc_ctx *enc) {
+  size_t adapt_start;
+  size_t ec_start;
+  size_t scratch_start;
+  adapt_start = offsetof(daala_enc_ctx, state) + offsetof(od_state, adapt);
+  ec_start = offsetof(daala_enc_ctx, ec);
+  scratch_start = offsetof(daala_enc_ctx, mc_orig);
+  OD_ASSERT(adapt_start + sizeof(od_adapt_ctx) <= ec_start);
+  OD_ASSERT(ec_start + sizeof(od_ec_enc) <= scratch_start);
+  od_enc_ctx_copy_range(wenc, enc, 0, adapt_start);
+  od_enc_ctx_copy_range(wenc, enc, adapt_start + sizeof(od_adapt_ctx),
+   ec_start);
+  od_enc_ctx_copy_range(wenc, enc, ec_start + sizeof(od_ec_enc),
+   scratch_start);
+  od_enc_ctx_copy_range(wenc, enc, offsetof(daala_enc_ctx, input_queue),
+   sizeof(*wenc));
+}
+
+/*Points a tile's encoder context at the frame being encoded, keeping its own
+   entropy encoder and giving it fresh adaptation state.*/
+static void od_enc_tile_init(daala_enc_ctx *tenc, daala_enc_ctx *enc,
+ int tile, int is_keyframe) {
+  int nplanes;
+  int pli;
+  nplanes = enc->state.info.nplanes;
+  od_enc_worker_refresh(tenc, enc);
+  od_ec_enc_reset(&tenc->ec);
+  tenc->tiles = NULL;
+  /*The tile is already running on one of the worker threads.*/
+  OD_CLEAR(&tenc->state.threads, 1);
+  tenc->state.threads.nthreads = 1;
+  for (pli = 0; pli < nplanes; pli++) {
+    tenc->state.ltmp[pli] = NULL;
+    if (enc->state.lbuf[pli] != NULL) {
+      tenc->state.lbuf[pli] = enc->tile_lbuf +
+       (tile*nplanes + pli)*OD_BSIZE_MAX*OD_BSIZE_MAX;
+    }
+  }
+  od_adapt_ctx_reset(&tenc->state.adapt, is_keyframe);
+}
+
+static void od_encode_tile_job(void *ctx, int tile) {
+  od_enc_tiles_ctx *tctx;
+  daala_enc_ctx *tenc;
+  od_mb_enc_ctx *mbctx;
+  tctx = (od_enc_tiles_ctx *)ctx;
+  tenc = tctx->enc->tiles + tile;
+  mbctx = tctx->mbctx + tile;
+  od_encode_tile(tenc, mbctx, tctx->rdo_only);
+}
+
+/*Encodes each tile of the frame with its own entropy encoder.*/
+static void od_encode_tiles(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
+ int rdo_only) {
+  od_enc_tiles_ctx tctx;
+  int ntiles;
+  int tile;
+#if defined(OD_DUMP_BSIZE_DIST)
+  double bsize_dist[OD_NPLANES_MAX];
+  int pli;
+  OD_COPY(bsize_dist, enc->bsize_dist, OD_NPLANES_MAX);
+#endif
+  ntiles = OD_NTILES(&enc->state.info);
+  tctx.enc = enc;
+  tctx.rdo_only = rdo_only;
+  for (tile = 0; tile < ntiles; tile++) {
+    tctx.mbctx[tile] = *mbctx;
+    od_state_tile_bounds(&enc->state, tile, &tctx.mbctx[tile].sbx0,
+     &tctx.mbctx[tile].sby0, &tctx.mbctx[tile].sbx1, &tctx.mbctx[tile].sby1);
+    /*This copies the thread pool, so it must be done before any job starts.*/
+    od_enc_tile_init(enc->tiles + tile, enc, tile, mbctx->is_keyframe);
+  }
+  od_thread_pool_run(&enc->state.threads, od_encode_tile_job, &tctx, ntiles);
+#if defined(OD_DUMP_BSIZE_DIST)
+  for (tile = 0; tile < ntiles; tile++) {
+    for (pli = 0; pli < OD_NPLANES_MAX; pli++) {
+      enc->bsize_dist[pli] +=
+       enc->tiles[tile].bsize_dist[pli] - bsize_dist[pli];
+    }
+  }
+#endif
+}
+
+/*Everything needed to choose the block sizes of a frame in parallel.*/
+struct od_enc_rdo_ctx {
+  daala_enc_ctx *enc;
+  od_mb_enc_ctx mbctx[OD_THREADS_MAX];
+  /*The state every superblock starts from.*/
+  od_rollback_buffer start;
+};
+typedef struct od_enc_rdo_ctx od_enc_rdo_ctx;
+
+/*Chooses the block sizes of one row of superblocks.
+  Row sby runs on context sby % nrdo_workers, once the previous row that used
+   that context is finished.*/
+static void od_encode_sbs_rdo_row(void *ctx, int sby) {
+  od_enc_rdo_ctx *rctx;
+  daala_enc_ctx *enc;
+  daala_enc_ctx *wenc;
+  od_mb_enc_ctx *mbctx;
+  int nhsb;
+  int sbx;
+  rctx = (od_enc_rdo_ctx *)ctx;
+  enc = rctx->enc;
+  wenc = enc->rdo_workers + sby % enc->nrdo_workers;
+  mbctx = rctx->mbctx + sby % enc->nrdo_workers;
+  nhsb = enc->state.nhsb;
+  if (sby >= enc->nrdo_workers) {
+    od_progress_wait(enc->rdo_sb_rows + sby - enc->nrdo_workers, nhsb);
+  }
+  for (sbx = 0; sbx < nhsb; sbx++) {
+    /*Keyframes predict the superblock DC from the superblocks up to one
+       column to the right in the row above.*/
+    if (mbctx->is_keyframe && sby > 0) {
+      od_progress_wait(enc->rdo_sb_rows + sby - 1, OD_MINI(sbx + 2, nhsb));
+    }
+    od_encode_rollback(wenc, &rctx->start);
+    od_encode_sb(wenc, mbctx, sbx, sby, OD_ENCODE_RDO);
+    od_progress_set(enc->rdo_sb_rows + sby, sbx + 1);
+  }
+}
+
+/*Chooses the block sizes of every superblock in a single-tile frame on the
+   worker threads.
+  Every superblock starts from the adaptation and entropy coder state at the
+   start of the pass, as in od_encode_tile(), so the decisions do not depend
+   on the order in which they are made or on the number of threads, and each
+   one only writes the block sizes and skip flags of its own superblock.
+  Returns 0 if this could not be done, in which case nothing was changed.*/
+static int od_encode_sbs_rdo(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx) {
+  od_enc_rdo_ctx rctx;
+  int nworkers;
+  int i;
+#if defined(OD_DUMP_BSIZE_DIST)
+  double bsize_dist[OD_NPLANES_MAX];
+  int pli;
+  OD_COPY(bsize_dist, enc->bsize_dist, OD_NPLANES_MAX);
+#endif
+  nworkers = od_enc_rdo_workers_update(enc);
+  if (nworkers <= 0) return 0;
+  rctx.enc = enc;
+  od_encode_checkpoint(enc, &rctx.start);
+  for (i = 0; i < nworkers; i++) {
+    daala_enc_ctx *wenc;
+    wenc = enc->rdo_workers + i;
+    /*The workers continue from the coder state of enc->ec, so their buffers
+       must be at least as large.*/
+    if (wenc->ec.storage < enc->ec.storage
+     || wenc->ec.precarry_storage < enc->ec.precarry_storage) {
+      od_ec_enc_clear(&wenc->ec);
+      od_ec_enc_init(&wenc->ec,
+       OD_MAXI(enc->ec.storage, enc->ec.precarry_storage));
+      if (OD_UNLIKELY(wenc->ec.error)) return 0;
+    }
+    od_enc_worker_refresh(wenc, enc);
+    wenc->tiles = NULL;
+    wenc->rdo_workers = NULL;
+    wenc->nrdo_workers = 0;
+    wenc->rdo_sb_rows = NULL;
+    /*The rows are already running on the worker threads.*/
+    OD_CLEAR(&wenc->state.threads, 1);
+    wenc->state.threads.nthreads = 1;
+    rctx.mbctx[i] = *mbctx;
+  }
+  for (i = 0; i < enc->state.nvsb; i++) {
+    od_progress_reset(enc->rdo_sb_rows + i, 0);
+  }
+  od_thread_pool_run(&enc->state.threads, od_encode_sbs_rdo_row, &rctx,
+   enc->state.nvsb);
+#if defined(OD_DUMP_BSIZE_DIST)
+  for (i = 0; i < nworkers; i++) {
+    for (pli = 0; pli < OD_NPLANES_MAX; pli++) {
+      enc->bsize_dist[pli] +=
+       enc->rdo_workers[i].bsize_dist[pli] - bsize_dist[pli];
+    }
+  }
+#endif
+  return 1;
+}
+
+/*Everything needed to dering the superblock rows of a frame in parallel.*/
+struct od_enc_dering_ctx {
+  daala_enc_ctx *enc;
+  double base_threshold;
+};
+typedef struct od_enc_dering_ctx od_enc_dering_ctx;
+
+/*Measures the luma distortion of each deringing level for the superblocks
+   of row sby that have any coded blocks, and marks those superblocks with a
+   non-zero level.*/
+static void od_enc_dering_eval_row(void *ctx, int sby) {
+  od_enc_dering_ctx *dctx;
+  daala_enc_ctx *enc;
+  od_state *state;
+  int nblocks;
+  int nhdr;
+  int nvdr;
+  int sbx;
+  dctx = (od_enc_dering_ctx *)ctx;
+  enc = dctx->enc;
+  state = &enc->state;
+  nblocks = 1 << (OD_LOG_DERING_GRID - OD_BLOCK_8X8);
+  nhdr = state->frame_width >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+  nvdr = state->frame_height >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+  for (sbx = 0; sbx < nhdr; sbx++) {
+    int ln;
+    int n;
+    int16_t buf[OD_BSIZE_MAX*OD_BSIZE_MAX];
+    od_coeff orig[OD_BSIZE_MAX*OD_BSIZE_MAX];
+    od_coeff out[OD_BSIZE_MAX*OD_BSIZE_MAX];
+    double *dist;
+    int ystride;
+    int xstride;
+    unsigned char *input;
+    od_coeff *output;
+    int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
+    int i;
+    int j;
+    int x;
+    int y;
+    int w;
+    int gi;
+    int pli;
+    int xdec;
+    int ydec;
+    unsigned char *bskip;
+    state->dering_level[sby*nhdr + sbx] = 0;
+    bskip = state->bskip[0] +
+     (sby << OD_LOG_DERING_GRID)*state->skip_stride +
+     (sbx << OD_LOG_DERING_GRID);
+    for (j = 0; j < 1 << OD_LOG_DERING_GRID; j++) {
+      for (i = 0; i < 1 << OD_LOG_DERING_GRID; i++) {
+        if (!bskip[j*state->skip_stride + i]) {
+          state->dering_level[sby*nhdr + sbx] = 1;
+        }
+      }
+    }
+    if (!state->dering_level[sby*nhdr + sbx] || !enc->use_dering) {
+      continue;
+    }
+    pli = 0;
+    xdec = state->info.plane_info[pli].xdec;
+    ydec = state->info.plane_info[pli].ydec;
+    w = state->frame_width >> xdec;
+    OD_ASSERT(xdec == ydec);
+    ln = OD_LOG_DERING_GRID + OD_LOG_BSIZE0 - xdec;
+    n = 1 << ln;
+    xstride = enc->curr_img->planes[pli].xstride;
+    ystride = enc->curr_img->planes[pli].ystride;
+    input = (unsigned char *)&enc->curr_img->planes[pli].
+     data[(sby << ln)*ystride + (sbx << ln)*xstride];
+    output = &state->ctmp[pli][(sby << ln)*w + (sbx << ln)];
+    od_ref_buf_to_coeff(state, orig, n, 0, input, xstride, ystride, n, n);
+    dist = enc->dering_dist + (sby*nhdr + sbx)*OD_DERING_LEVELS;
+    for (y = 0; y < n; y++) {
+      for (x = 0; x < n; x++) {
+        out[y*n + x] = output[y*w + x];
+      }
+    }
+    dist[0] = od_compute_dist(enc, orig, out, n);
+    for (gi = 1; gi < OD_DERING_LEVELS; gi++) {
+      int threshold;
+      threshold = (int)(OD_DERING_GAIN_TABLE[gi]*dctx->base_threshold);
+      od_dering(&state->opt_vtbl.dering, buf, n, &state->etmp[pli]
+       [(sby << ln)*w + (sbx << ln)], w, nblocks, nblocks, sbx, sby,
+       nhdr, nvdr, xdec, dir, pli, &state->bskip[pli]
+       [(sby << (OD_LOG_DERING_GRID - ydec))*state->skip_stride
+       + (sbx << (OD_LOG_DERING_GRID - xdec))], state->skip_stride,
+       threshold, OD_DERING_CHECK_OVERLAP, OD_COEFF_SHIFT);
+      /* Optimize deringing for the block size decision metric. */
+      for (y = 0; y < n; y++) {
+        for (x = 0; x < n; x++) {
+          out[y*n + x] = buf[y*n + x];
+        }
+      }
+      dist[gi] = od_compute_dist(enc, orig, out, n);
+    }
+  }
+}
+
+/*Applies the chosen deringing level to each superblock of row sby.*/
+static void od_enc_dering_apply_row(void *ctx, int sby) {
+  od_enc_dering_ctx *dctx;
+  od_state *state;
+  int nblocks;
+  int nhdr;
+  int nvdr;
+  int sbx;
+  dctx = (od_enc_dering_ctx *)ctx;
+  state = &dctx->enc->state;
+  nblocks = 1 << (OD_LOG_DERING_GRID - OD_BLOCK_8X8);
+  nhdr = state->frame_width >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+  nvdr = state->frame_height >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+  for (sbx = 0; sbx < nhdr; sbx++) {
+    int16_t buf[OD_BSIZE_MAX*OD_BSIZE_MAX];
+    int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
+    int level;
+    int pli;
+    level = state->dering_level[sby*nhdr + sbx];
+    if (!level) continue;
+    /*The luma plane goes first, since it finds the directions the chroma
+       planes reuse.*/
+    for (pli = 0; pli < state->info.nplanes; pli++) {
+      od_coeff *output;
+      int threshold;
+      int xdec;
+      int ydec;
+      int ln;
+      int n;
+      int w;
+      int x;
+      int y;
+      xdec = state->info.plane_info[pli].xdec;
+      ydec = state->info.plane_info[pli].ydec;
+      w = state->frame_width >> xdec;
+      ln = OD_LOG_DERING_GRID + OD_LOG_BSIZE0 - xdec;
+      n = 1 << ln;
+      /* For now we just reduce the threshold on chroma by a fixed
+         amount, but we should make this adaptive. */
+      threshold = (int)(OD_DERING_GAIN_TABLE[level]*dctx->base_threshold*
+       (pli==0 ? 1 : 0.6));
+      od_dering(&state->opt_vtbl.dering, buf, n, &state->etmp[pli]
+       [(sby << ln)*w + (sbx << ln)], w, nblocks, nblocks, sbx, sby,
+       nhdr, nvdr, xdec, dir, pli, &state->bskip[pli]
+       [(sby << (OD_LOG_DERING_GRID - ydec))*state->skip_stride
+       + (sbx << (OD_LOG_DERING_GRID - xdec))], state->skip_stride,
+       threshold, OD_DERING_CHECK_OVERLAP, OD_COEFF_SHIFT);
+      output = &state->ctmp[pli][(sby << ln)*w + (sbx << ln)];
+      for (y = 0; y < n; y++) {
+        for (x = 0; x < n; x++) {
+          output[y*w + x] = buf[y*n + x];
+        }
+      }
+    }
+  }
+}
+
 static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
  int rdo_only) {
   int xdec;
@@ -2562,26 +3173,28 @@ static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
   od_ec_enc_uint(&enc->ec, state->coded_quantizer, OD_N_CODED_QUANTIZERS);
   for (pli = 0; pli < nplanes; pli++) {
     /*Collect the image data needed for this plane.*/
-    xdec = state->info.plane_info[pli].xdec;
-    ydec = state->info.plane_info[pli].ydec;
-    w = frame_width >> xdec;
     od_ref_plane_to_coeff(state, state->ctmp[pli],
      OD_LOSSLESS(enc), enc->curr_img, pli);
-    if (!mbctx->use_haar_wavelet) {
-      od_apply_prefilter_frame_sbs(state->ctmp[pli],
-       w, nhsb, nvsb, xdec, ydec);
+    if (!mbctx->is_keyframe) {
+      od_ref_plane_to_coeff(state,
+       state->mctmp[pli], OD_LOSSLESS(enc), rec, pli);
     }
+  }
+  if (!mbctx->use_haar_wavelet) {
+    od_state_prefilter_planes(state, state->ctmp, nplanes);
     if (!mbctx->is_keyframe) {
+      od_state_prefilter_planes(state, state->mctmp, nplanes);
+    }
+  }
+  if (!mbctx->is_keyframe) {
+    for (pli = 0; pli < nplanes; pli++) {
       int pic_width;
       int pic_height;
       int plane_width;
       int plane_height;
-      od_ref_plane_to_coeff(state,
-       state->mctmp[pli], OD_LOSSLESS(enc), rec, pli);
-      if (!mbctx->use_haar_wavelet) {
-        od_apply_prefilter_frame_sbs(state->mctmp[pli], w, nhsb, nvsb, xdec,
-         ydec);
-      }
+      xdec = state->info.plane_info[pli].xdec;
+      ydec = state->info.plane_info[pli].ydec;
+      w = frame_width >> xdec;
       pic_width = enc->state.info.pic_width >> xdec;
       pic_height = enc->state.info.pic_height >> ydec;
       plane_width = enc->state.frame_width >> xdec;
@@ -2602,61 +3215,16 @@ static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
       }
     }
   }
-  for (sby = 0; sby < nvsb; sby++) {
-    for (sbx = 0; sbx < nhsb; sbx++) {
-      for (pli = 0; pli < nplanes; pli++) {
-        od_coeff *c_orig;
-        int i;
-        int j;
-        int width;
-        od_rollback_buffer buf;
-        od_coeff hgrad;
-        od_coeff vgrad;
-        width = enc->state.frame_width;
-        hgrad = vgrad = 0;
-        c_orig = enc->c_orig[0];
-        mbctx->c = state->ctmp[pli];
-        mbctx->d = state->dtmp;
-        mbctx->mc = state->mctmp[pli];
-        mbctx->md = state->mdtmp[pli];
-        mbctx->l = state->lbuf[pli];
-        xdec = state->info.plane_info[pli].xdec;
-        ydec = state->info.plane_info[pli].ydec;
-        if (pli == 0 || (rdo_only && mbctx->is_keyframe)) {
-          for (i = 0; i < OD_BSIZE_MAX; i++) {
-            for (j = 0; j < OD_BSIZE_MAX; j++) {
-              c_orig[i*OD_BSIZE_MAX + j] =
-               mbctx->c[(OD_BSIZE_MAX*sby + i)*width + OD_BSIZE_MAX*sbx + j];
-            }
-          }
-        }
-        if (mbctx->is_keyframe) {
-          if (rdo_only) {
-            od_encode_checkpoint(enc, &buf);
-          }
-          od_compute_dcts(enc, mbctx, pli, sbx, sby, OD_NBSIZES - 1, xdec,
-           ydec, mbctx->use_haar_wavelet && !rdo_only);
-          od_quantize_haar_dc_sb(enc, mbctx, pli, sbx, sby, xdec, ydec,
-           sby > 0 && sbx < nhsb - 1, &hgrad, &vgrad);
-          if (rdo_only) {
-            od_encode_rollback(enc, &buf);
-            for (i = 0; i < OD_BSIZE_MAX; i++) {
-              for (j = 0; j < OD_BSIZE_MAX; j++) {
-                mbctx->c[(OD_BSIZE_MAX*sby + i)*width + OD_BSIZE_MAX*sbx + j] =
-                 c_orig[i*OD_BSIZE_MAX + j];
-              }
-            }
-          }
-        }
-        if (pli == 0 && !OD_LOSSLESS(enc)) {
-          mbctx->q_scaling =
-           od_compute_superblock_q_scaling(enc, c_orig, OD_BSIZE_MAX);
-        }
-        od_encode_recursive(enc, mbctx, pli, sbx, sby, OD_NBSIZES - 1, xdec,
-         ydec, rdo_only, hgrad, vgrad);
-      }
+  if (OD_NTILES(&state->info) == 1) {
+    mbctx->sbx0 = mbctx->sby0 = 0;
+    mbctx->sbx1 = nhsb;
+    mbctx->sby1 = nvsb;
+    if (!rdo_only || !enc->parallel_rdo || enc->state.threads.nthreads <= 1
+     || !od_encode_sbs_rdo(enc, mbctx)) {
+      od_encode_tile(enc, mbctx, rdo_only);
     }
   }
+  else od_encode_tiles(enc, mbctx, rdo_only);
 #if defined(OD_DUMP_IMAGES)
   if (!rdo_only) {
     /*Dump the lapped frame (before the postfilter has been applied)*/
@@ -2667,22 +3235,15 @@ static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
     od_state_dump_img(&enc->state, rec, "lapped");
   }
 #endif
-  for (pli = 0; pli < nplanes; pli++) {
-    xdec = state->info.plane_info[pli].xdec;
-    ydec = state->info.plane_info[pli].ydec;
-    w = frame_width >> xdec;
-    if (!mbctx->use_haar_wavelet) {
-      od_apply_postfilter_frame_sbs(state->ctmp[pli], w, nhsb, nvsb, xdec,
-       ydec, state->coded_quantizer, &enc->state.bskip[pli][0],
-       enc->state.skip_stride);
-    }
+  if (!mbctx->use_haar_wavelet) {
+    od_state_postfilter_planes(state, state->ctmp, nplanes,
+     state->coded_quantizer, state->bskip);
   }
   if (!rdo_only && !OD_LOSSLESS(enc)) {
+    od_enc_dering_ctx dctx;
     int nhdr;
     int nvdr;
     double base_threshold;
-    int nblocks;
-    nblocks = 1 << (OD_LOG_DERING_GRID - OD_BLOCK_8X8);
     /* The threshold is meant to be the estimated amount of ringing for a given
        quantizer. Ringing is mostly proportional to the quantizer, but we
        use an exponent slightly smaller than unity because as quantization
@@ -2706,50 +3267,20 @@ static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
     }
     nhdr = state->frame_width >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
     nvdr = state->frame_height >> (OD_LOG_DERING_GRID + OD_LOG_BSIZE0);
+    dctx.enc = enc;
+    dctx.base_threshold = base_threshold;
+    /*The filters are evaluated and applied on the worker threads; only the
+       choice of level depends on the adaptation state, so it is made here in
+       raster order.*/
+    od_thread_pool_run(&state->threads, od_enc_dering_eval_row, &dctx, nvdr);
     for (sby = 0; sby < nvdr; sby++) {
       for (sbx = 0; sbx < nhdr; sbx++) {
-        int ln;
-        int n;
-        int16_t buf[OD_BSIZE_MAX*OD_BSIZE_MAX];
-        od_coeff orig[OD_BSIZE_MAX*OD_BSIZE_MAX];
-        double dist;
-        int ystride;
-        int xstride;
-        unsigned char *input;
-        od_coeff *output;
+        double *dist;
         int c;
-        int dir[OD_DERING_NBLOCKS][OD_DERING_NBLOCKS];
-        int i;
-        int j;
-        unsigned char *bskip;
         int best_gi;
-        state->dering_level[sby*nhdr + sbx] = 0;
-        bskip = enc->state.bskip[0] +
-         (sby << OD_LOG_DERING_GRID)*enc->state.skip_stride +
-         (sbx << OD_LOG_DERING_GRID);
-        for (j = 0; j < 1 << OD_LOG_DERING_GRID; j++) {
-          for (i = 0; i < 1 << OD_LOG_DERING_GRID; i++) {
-            if (!bskip[j*enc->state.skip_stride + i]) {
-              state->dering_level[sby*nhdr + sbx] = 1;
-            }
-          }
-        }
         if (!state->dering_level[sby*nhdr + sbx]) {
           continue;
         }
-        pli = 0;
-        xdec = enc->state.info.plane_info[pli].xdec;
-        ydec = enc->state.info.plane_info[pli].ydec;
-        w = frame_width >> xdec;
-        OD_ASSERT(xdec == ydec);
-        ln = OD_LOG_DERING_GRID + OD_LOG_BSIZE0 - xdec;
-        n = 1 << ln;
-        xstride = enc->curr_img->planes[pli].xstride;
-        ystride = enc->curr_img->planes[pli].ystride;
-        input = (unsigned char *)&enc->curr_img->planes[pli].
-         data[(sby << ln)*ystride + (sbx << ln)*xstride];
-        output = &state->ctmp[pli][(sby << ln)*w + (sbx << ln)];
-        od_ref_buf_to_coeff(state, orig, n, 0, input, xstride, ystride, n, n);
         /* Only keyframes have enough superblocks to be worth having a
            context. Attempts to use the neighbours for non-keyframes have
            been a regression so far. */
@@ -2772,38 +3303,15 @@ static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
         if (enc->use_dering) {
           int gi;
           double best_dist;
-          od_coeff out[OD_BSIZE_MAX*OD_BSIZE_MAX];
-          int threshold;
-          for (y = 0; y < n; y++) {
-            for (x = 0; x < n; x++) {
-              out[y*n + x] = output[y*w + x];
-            }
-          }
-          dist = od_compute_dist(enc, orig, out, n);
-          best_dist = dist + enc->dering_lambda*
+          dist = enc->dering_dist + (sby*nhdr + sbx)*OD_DERING_LEVELS;
+          best_dist = dist[0] + enc->dering_lambda*
            od_encode_cdf_cost(0, state->adapt.dering_cdf[c], OD_DERING_LEVELS);
           for (gi = 1; gi < OD_DERING_LEVELS; gi++) {
-            threshold = (int)(OD_DERING_GAIN_TABLE[gi]*base_threshold);
-            od_dering(&state->opt_vtbl.dering, buf, n, &state->etmp[pli]
-             [(sby << ln)*w + (sbx << ln)], w, nblocks, nblocks, sbx, sby,
-             nhdr, nvdr, xdec, dir, pli, &enc->state.bskip[pli]
-             [(sby << (OD_LOG_DERING_GRID - ydec))*enc->state.skip_stride
-             + (sbx << (OD_LOG_DERING_GRID - xdec))], enc->state.skip_stride,
-             threshold, OD_DERING_CHECK_OVERLAP, OD_COEFF_SHIFT);
-            /* Optimize deringing for the block size decision metric. */
-            {
-              od_coeff buf32[OD_BSIZE_MAX*OD_BSIZE_MAX];
-              for (y = 0; y < n; y++) {
-                for (x = 0; x < n; x++) {
-                  buf32[y*n + x] = buf[y*n + x];
-                }
-              }
-              dist = od_compute_dist(enc, orig, buf32, n)
-               + enc->dering_lambda*od_encode_cdf_cost(gi,
-               state->adapt.dering_cdf[c], OD_DERING_LEVELS);
-            }
-            if (dist < best_dist) {
-              best_dist = dist;
+            double d;
+            d = dist[gi] + enc->dering_lambda*od_encode_cdf_cost(gi,
+             state->adapt.dering_cdf[c], OD_DERING_LEVELS);
+            if (d < best_dist) {
+              best_dist = d;
               best_gi = gi;
             }
           }
@@ -2811,34 +3319,9 @@ static void od_encode_coefficients(daala_enc_ctx *enc, od_mb_enc_ctx *mbctx,
         state->dering_level[sby*nhdr + sbx] = best_gi;
         od_encode_cdf_adapt(&enc->ec, best_gi, state->adapt.dering_cdf[c],
          OD_DERING_LEVELS, state->adapt.dering_increment);
-        if (best_gi) {
-          for (pli = 0; pli < nplanes; pli++) {
-            int threshold;
-            xdec = state->info.plane_info[pli].xdec;
-            ydec = state->info.plane_info[pli].ydec;
-            w = frame_width >> xdec;
-            ln = OD_LOG_DERING_GRID + OD_LOG_BSIZE0 - xdec;
-            n = 1 << ln;
-            threshold = (int)(OD_DERING_GAIN_TABLE[best_gi]*base_threshold*
-             (pli==0 ? 1 : 0.6));
-            /* For now we just reduce the threshold on chroma by a fixed
-               amount, but we should make this adaptive. */
-            od_dering(&state->opt_vtbl.dering, buf, n, &state->etmp[pli]
-             [(sby << ln)*w + (sbx << ln)], w, nblocks, nblocks, sbx, sby,
-             nhdr, nvdr, xdec, dir, pli, &enc->state.bskip[pli]
-             [(sby << (OD_LOG_DERING_GRID - ydec))*enc->state.skip_stride
-             + (sbx << (OD_LOG_DERING_GRID - xdec))], enc->state.skip_stride,
-             threshold, OD_DERING_CHECK_OVERLAP, OD_COEFF_SHIFT);
-            output = &state->ctmp[pli][(sby << ln)*w + (sbx << ln)];
-            for (y = 0; y < n; y++) {
-              for (x = 0; x < n; x++) {
-                output[y*w + x] = buf[y*n + x];
-              }
-            }
-          }
-        }
       }
     }
+    od_thread_pool_run(&state->threads, od_enc_dering_apply_row, &dctx, nvdr);
   }
   if (!rdo_only) {
     for (pli = 0; pli < nplanes; pli++) {
@@ -2956,6 +3439,63 @@ static void od_enc_drop_frame(daala_enc_ctx *enc){
    enc->state.nhmvbs + 1, sizeof(**enc->state.mv_grid));
   /*Clear encoder state so that we emit a nil packet*/
   od_ec_enc_reset(&enc->ec);
+  if (enc->tiles != NULL) {
+    int tile;
+    for (tile = 0; tile < OD_NTILES(&enc->state.info); tile++) {
+      od_ec_enc_reset(&enc->tiles[tile].ec);
+    }
+  }
+}
+
+/*Returns the number of bits used so far by the current frame, including all
+   of its tiles.*/
+static long od_enc_tell(daala_enc_ctx *enc) {
+  long bits;
+  bits = od_ec_enc_tell(&enc->ec);
+  if (enc->tiles != NULL) {
+    int tile;
+    for (tile = 0; tile < OD_NTILES(&enc->state.info); tile++) {
+      bits += od_ec_enc_tell(&enc->tiles[tile].ec);
+    }
+  }
+  return bits;
+}
+
+/*Writes a tile size so that od_dec_split_tiles() can read it backwards:
+   the most significant group of 7 bits comes first and is the only one
+   without the continuation bit set.*/
+static void od_enc_write_tile_size(oggbyte_buffer *obb, uint32_t size) {
+  int shift;
+  for (shift = 0; shift < 28 && size >> shift >= 0x80; shift += 7);
+  oggbyte_write1(obb, size >> shift & 0x7F);
+  while (shift > 0) {
+    shift -= 7;
+    oggbyte_write1(obb, (size >> shift & 0x7F) | 0x80);
+  }
+}
+
+/*Finishes the frame-level data and every tile, and lays them out in a single
+   packet as described in od_dec_split_tiles().*/
+static unsigned char *od_enc_tiles_done(daala_enc_ctx *enc, uint32_t *nbytes) {
+  unsigned char *buf;
+  uint32_t sizes[OD_TILES_MAX];
+  int ntiles;
+  int tile;
+  ntiles = OD_NTILES(&enc->state.info);
+  oggbyte_reset(&enc->obb);
+  buf = od_ec_enc_done(&enc->ec, sizes);
+  oggbyte_writecopy(&enc->obb, buf, sizes[0]);
+  for (tile = 0; tile < ntiles; tile++) {
+    uint32_t size;
+    buf = od_ec_enc_done(&enc->tiles[tile].ec, &size);
+    oggbyte_writecopy(&enc->obb, buf, size);
+    if (tile + 1 < ntiles) sizes[tile + 1] = size;
+  }
+  for (tile = ntiles; tile-- > 0;) {
+    od_enc_write_tile_size(&enc->obb, sizes[tile]);
+  }
+  *nbytes = oggbyte_bytes(&enc->obb);
+  return oggbyte_get_buffer(&enc->obb);
 }
 
 /*This function can only return an error code if the enc or img parameters
@@ -3118,7 +3658,7 @@ static int od_encode_frame(daala_enc_ctx *enc, daala_image *img, int frame_type,
         droppable = 1;
       }
     }
-    if (od_enc_rc_update_state(enc, od_ec_enc_tell(&enc->ec),
+    if (od_enc_rc_update_state(enc, od_enc_tell(enc),
      mbctx.is_golden_frame, frame_type, droppable)) {
       /*Nonzero return indicates we busted budget on a droppable frame.*/
       od_enc_drop_frame (enc);
@@ -3294,7 +3834,8 @@ int daala_encode_packet_out(daala_enc_ctx *enc, int last, daala_packet *op) {
     printf("error encoding frame\n");
     return 0;
   }
-  op->packet = od_ec_enc_done(&enc->ec, &nbytes);
+  if (enc->tiles != NULL) op->packet = od_enc_tiles_done(enc, &nbytes);
+  else op->packet = od_ec_enc_done(&enc->ec, &nbytes);
   op->bytes = nbytes;
   OD_LOG((OD_LOG_ENCODER, OD_LOG_INFO, "Output Bytes: %ld (%ld Kbits)",
    op->bytes, op->bytes*8/1024));
@@ -1453,40 +1453,134 @@ void od_thor_deblock_row8(od_coeff *c0, int stride, int q) {
 }
 #endif
 
+static void od_filter_rows_c(od_filter_func filter, od_coeff *c, int stride,
+ int n) {
+  int i;
+  for (i = 0; i < n; i++) {
+    (*filter)(c + i*stride, c + i*stride);
+  }
+}
+
+static void od_filter_cols_c(od_filter_func filter, int f, od_coeff *c,
+ int stride, int n) {
+  int j;
+  for (j = 0; j < n; j++) {
+    int k;
+    od_coeff t[4 << OD_NBSIZES];
+    for (k = 0; k < 4 << f; k++) t[k] = c[stride*k + j];
+    (*filter)(t, t);
+    for (k = 0; k < 4 << f; k++) c[stride*k + j] = t[k];
+  }
+}
+
+void od_pre_filter_rows4_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_pre_filter4, c, stride, n);
+}
+
+void od_pre_filter_rows8_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_pre_filter8, c, stride, n);
+}
+
+void od_pre_filter_rows16_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_pre_filter16, c, stride, n);
+}
+
+void od_pre_filter_rows32_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_pre_filter32, c, stride, n);
+}
+
+void od_pre_filter_cols4_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_pre_filter4, 0, c, stride, n);
+}
+
+void od_pre_filter_cols8_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_pre_filter8, 1, c, stride, n);
+}
+
+void od_pre_filter_cols16_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_pre_filter16, 2, c, stride, n);
+}
+
+void od_pre_filter_cols32_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_pre_filter32, 3, c, stride, n);
+}
+
+void od_post_filter_rows4_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_post_filter4, c, stride, n);
+}
+
+void od_post_filter_rows8_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_post_filter8, c, stride, n);
+}
+
+void od_post_filter_rows16_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_post_filter16, c, stride, n);
+}
+
+void od_post_filter_rows32_c(od_coeff *c, int stride, int n) {
+  od_filter_rows_c(od_post_filter32, c, stride, n);
+}
+
+void od_post_filter_cols4_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_post_filter4, 0, c, stride, n);
+}
+
+void od_post_filter_cols8_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_post_filter8, 1, c, stride, n);
+}
+
+void od_post_filter_cols16_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_post_filter16, 2, c, stride, n);
+}
+
+void od_post_filter_cols32_c(od_coeff *c, int stride, int n) {
+  od_filter_cols_c(od_post_filter32, 3, c, stride, n);
+}
+
+const od_filter_opt_vtbl OD_FILTER_VTBL_C = {
+  {
+    od_pre_filter_rows4_c, od_pre_filter_rows8_c, od_pre_filter_rows16_c,
+    od_pre_filter_rows32_c
+  },
+  {
+    od_pre_filter_cols4_c, od_pre_filter_cols8_c, od_pre_filter_cols16_c,
+    od_pre_filter_cols32_c
+  },
+  {
+    od_post_filter_rows4_c, od_post_filter_rows8_c, od_post_filter_rows16_c,
+    od_post_filter_rows32_c
+  },
+  {
+    od_post_filter_cols4_c, od_post_filter_cols8_c, od_post_filter_cols16_c,
+    od_post_filter_cols32_c
+  }
+};
+
 #define OD_BLOCK_SIZE4x4_DEC(bsize, bstride, bx, by, dec) \
  OD_MAXI(OD_BLOCK_SIZE4x4(bsize, bstride, bx, by), dec)
 
-void od_prefilter_split(od_coeff *c0, int stride, int bs, int f, int hfilter,
- int vfilter) {
+void od_prefilter_split(const od_filter_opt_vtbl *vtbl, od_coeff *c0,
+ int stride, int bs, int f, int hfilter, int vfilter) {
 #if OD_DEBLOCKING
+  OD_UNUSED(vtbl);
 #else
-  int i;
-  int j;
-  od_coeff *c;
   if (hfilter) {
-    c = c0 + ((2 << bs) - (2 << f))*stride;
-    for (j = 0; j < 4 << bs; j++) {
-      int k;
-      od_coeff t[4 << OD_NBSIZES];
-      for (k = 0; k < 4 << f; k++) t[k] = c[stride*k + j];
-      (*OD_PRE_FILTER[f])(t, t);
-      for (k = 0; k < 4 << f; k++) c[stride*k + j] = t[k];
-    }
+    (*vtbl->pre_filter_cols[f])(c0 + ((2 << bs) - (2 << f))*stride, stride,
+     4 << bs);
   }
   if (vfilter) {
-    c = c0 + (2 << bs) - (2 << f);
-    for (i = 0; i < 4 << bs; i++) {
-      (*OD_PRE_FILTER[f])(c + i*stride, c + i*stride);
-    }
+    (*vtbl->pre_filter_rows[f])(c0 + (2 << bs) - (2 << f), stride, 4 << bs);
   }
 #endif
 }
 
-void od_postfilter_split(od_coeff *c0, int stride, int bs, int f, int q,
- unsigned char *skip, int skip_stride, int hfilter, int vfilter) {
+void od_postfilter_split(const od_filter_opt_vtbl *vtbl, od_coeff *c0,
+ int stride, int bs, int f, int q, unsigned char *skip, int skip_stride,
+ int hfilter, int vfilter) {
+#if OD_DEBLOCKING
   int i;
   od_coeff *c;
-#if OD_DEBLOCKING
+  OD_UNUSED(vtbl);
   if (bs==0) return;
   c = c0 + (2 << bs);
   for (i = 0; i < 4 << bs; i += 8) {
@@ -1503,71 +1597,101 @@ void od_postfilter_split(od_coeff *c0, int stride, int bs, int f, int q,
     }
   }
 #else
-  int j;
   OD_UNUSED(q);
   OD_UNUSED(skip);
   OD_UNUSED(skip_stride);
   if (vfilter) {
-    c = c0 + (2 << bs) - (2 << f);
-    for (i = 0; i < 4 << bs; i++) {
-      (*OD_POST_FILTER[f])(c + i*stride, c + i*stride);
-    }
+    (*vtbl->post_filter_rows[f])(c0 + (2 << bs) - (2 << f), stride, 4 << bs);
   }
   if (hfilter) {
-    c = c0 + ((2 << bs) - (2 << f))*stride;
-    for (j = 0; j < 4 << bs; j++) {
-      int k;
-      od_coeff t[4 << OD_NBSIZES];
-      for (k = 0; k < 4 << f; k++) t[k] = c[stride*k + j];
-      (*OD_POST_FILTER[f])(t, t);
-      for (k = 0; k < 4 << f; k++) c[stride*k + j] = t[k];
-    }
+    (*vtbl->post_filter_cols[f])(c0 + ((2 << bs) - (2 << f))*stride, stride,
+     4 << bs);
   }
 #endif
 }
 
-void od_apply_prefilter_frame_sbs(od_coeff *c0, int stride, int nhsb, int nvsb,
- int xdec, int ydec) {
+/*Applies the prefilter across the horizontal superblock edges, for the
+   columns of superblocks [sbx0, sbx1).
+  Different columns do not interact, so they may be filtered concurrently.*/
+void od_apply_prefilter_frame_hedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int sbx0, int sbx1, int nvsb, int xdec, int ydec) {
 #if OD_DEBLOCKING
+  OD_UNUSED(vtbl);
+  OD_UNUSED(c0);
+  OD_UNUSED(stride);
+  OD_UNUSED(sbx0);
+  OD_UNUSED(sbx1);
+  OD_UNUSED(nvsb);
+  OD_UNUSED(xdec);
+  OD_UNUSED(ydec);
 #else
-  int sbx;
   int sby;
-  int i;
-  int j;
   int f;
   od_coeff *c;
   f = OD_FILT_SIZE(OD_NBSIZES - 1, xdec);
-  c = c0 + ((OD_BSIZE_MAX >> ydec) - (2 << f))*stride;
+  c = c0 + ((OD_BSIZE_MAX >> ydec) - (2 << f))*stride
+   + (sbx0 << OD_LOG_BSIZE_MAX >> xdec);
   for (sby = 1; sby < nvsb; sby++) {
-    for (j = 0; j < nhsb << OD_LOG_BSIZE_MAX >> xdec; j++) {
-      int k;
-      od_coeff t[4 << OD_NBSIZES];
-      for (k = 0; k < 4 << f; k++) t[k] = c[stride*k + j];
-      (*OD_PRE_FILTER[f])(t, t);
-      for (k = 0; k < 4 << f; k++) c[stride*k + j] = t[k];
-    }
+    (*vtbl->pre_filter_cols[f])(c, stride,
+     (sbx1 - sbx0) << OD_LOG_BSIZE_MAX >> xdec);
     c += OD_BSIZE_MAX*stride >> ydec;
   }
-  c = c0 + (OD_BSIZE_MAX >> ydec) - (2 << f);
+#endif
+}
+
+/*Applies the prefilter across the vertical superblock edges, for the rows of
+   superblocks [sby0, sby1).
+  This must follow od_apply_prefilter_frame_hedges() on the whole plane, but
+   different rows do not interact, so they may be filtered concurrently.*/
+void od_apply_prefilter_frame_vedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int nhsb, int sby0, int sby1, int xdec, int ydec) {
+#if OD_DEBLOCKING
+  OD_UNUSED(vtbl);
+  OD_UNUSED(c0);
+  OD_UNUSED(stride);
+  OD_UNUSED(nhsb);
+  OD_UNUSED(sby0);
+  OD_UNUSED(sby1);
+  OD_UNUSED(xdec);
+  OD_UNUSED(ydec);
+#else
+  int sbx;
+  int f;
+  od_coeff *c;
+  f = OD_FILT_SIZE(OD_NBSIZES - 1, xdec);
+  c = c0 + (OD_BSIZE_MAX >> ydec) - (2 << f)
+   + (sby0 << OD_LOG_BSIZE_MAX >> ydec)*stride;
   for (sbx = 1; sbx < nhsb; sbx++) {
-    for (i = 0; i < nvsb << OD_LOG_BSIZE_MAX >> ydec; i++) {
-      (*OD_PRE_FILTER[f])(c + i*stride, c + i*stride);
-    }
+    (*vtbl->pre_filter_rows[f])(c, stride,
+     (sby1 - sby0) << OD_LOG_BSIZE_MAX >> ydec);
     c += OD_BSIZE_MAX >> xdec;
   }
 #endif
 }
 
-void od_apply_postfilter_frame_sbs(od_coeff *c0, int stride, int nhsb,
- int nvsb, int xdec, int ydec, int q, unsigned char *skip, int skip_stride) {
-#if OD_DEBLOCKING
+void od_apply_prefilter_frame_sbs(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int nhsb, int nvsb, int xdec, int ydec) {
+  od_apply_prefilter_frame_hedges(vtbl, c0, stride, 0, nhsb, nvsb, xdec,
+   ydec);
+  od_apply_prefilter_frame_vedges(vtbl, c0, stride, nhsb, 0, nvsb, xdec,
+   ydec);
+}
+
+/*Applies the postfilter across the vertical superblock edges, for the rows
+   of superblocks [sby0, sby1).
+  Different rows do not interact, so they may be filtered concurrently.*/
+void od_apply_postfilter_frame_vedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int nhsb, int sby0, int sby1, int xdec, int ydec,
+ int q, unsigned char *skip, int skip_stride) {
   od_coeff *c;
   int sbx;
-  int sby;
+#if OD_DEBLOCKING
+  int i;
+  OD_UNUSED(vtbl);
   c = c0 + (OD_BSIZE_MAX >> ydec);
   for (sbx = 1; sbx < nhsb; sbx++) {
-    int i;
-    for (i = 0; i < nvsb << OD_LOG_BSIZE_MAX >> ydec; i+=8) {
+    for (i = sby0 << OD_LOG_BSIZE_MAX >> ydec;
+     i < sby1 << OD_LOG_BSIZE_MAX >> ydec; i += 8) {
       if (!skip[(i >> 2)*skip_stride + (sbx << 3 >> xdec) - 1]
        || !skip[(i >> 2)*skip_stride + (sbx << 3 >> xdec)]) {
         od_thor_deblock_col8(c + i*stride, stride, q);
@@ -1575,45 +1699,130 @@ void od_apply_postfilter_frame_sbs(od_coeff *c0, int stride, int nhsb,
     }
     c += OD_BSIZE_MAX >> xdec;
   }
-  c = c0 + (OD_BSIZE_MAX >> ydec)*stride;
+#else
+  int f;
+  OD_UNUSED(q);
+  OD_UNUSED(skip);
+  OD_UNUSED(skip_stride);
+  f = OD_FILT_SIZE(OD_NBSIZES - 1, xdec);
+  c = c0 + (OD_BSIZE_MAX >> ydec) - (2 << f)
+   + (sby0 << OD_LOG_BSIZE_MAX >> ydec)*stride;
+  for (sbx = 1; sbx < nhsb; sbx++) {
+    (*vtbl->post_filter_rows[f])(c, stride,
+     (sby1 - sby0) << OD_LOG_BSIZE_MAX >> ydec);
+    c += OD_BSIZE_MAX >> xdec;
+  }
+#endif
+}
+
+/*Applies the postfilter across the horizontal superblock edges, for the
+   columns of superblocks [sbx0, sbx1).
+  This must follow od_apply_postfilter_frame_vedges() on the whole plane, but
+   different columns do not interact, so they may be filtered concurrently.*/
+void od_apply_postfilter_frame_hedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int sbx0, int sbx1, int nvsb, int xdec, int ydec,
+ int q, unsigned char *skip, int skip_stride) {
+  od_coeff *c;
+  int sby;
+#if OD_DEBLOCKING
+  int j;
+  OD_UNUSED(vtbl);
   for (sby = 1; sby < nvsb; sby++) {
-    int j;
-    for (j = 0; j < nhsb << OD_LOG_BSIZE_MAX >> xdec; j+=8) {
+    c = c0 + (sby << OD_LOG_BSIZE_MAX >> ydec)*stride;
+    for (j = sbx0 << OD_LOG_BSIZE_MAX >> xdec;
+     j < sbx1 << OD_LOG_BSIZE_MAX >> xdec; j += 8) {
       if (!skip[((sby << 3 >> xdec) - 1)*skip_stride + (j >> 2)]
        || !skip[(sby << 3 >> xdec)*skip_stride + (j >> 2)]) {
         od_thor_deblock_row8(c + j, stride, q);
       }
     }
-    c += OD_BSIZE_MAX*stride >> ydec;
+  }
+#else
+  int f;
+  OD_UNUSED(q);
+  OD_UNUSED(skip);
+  OD_UNUSED(skip_stride);
+  f = OD_FILT_SIZE(OD_NBSIZES - 1, xdec);
+  for (sby = 1; sby < nvsb; sby++) {
+    c = c0 + ((sby << OD_LOG_BSIZE_MAX >> ydec) - (2 << f))*stride
+     + (sbx0 << OD_LOG_BSIZE_MAX >> xdec);
+    (*vtbl->post_filter_cols[f])(c, stride,
+     (sbx1 - sbx0) << OD_LOG_BSIZE_MAX >> xdec);
+  }
+#endif
+}
+
+/*Applying the postfilter to all the vertical edges first gives the same
+   result as od_apply_postfilter_frame_rows(), since the filter across the
+   edge above a row never reaches the rows below it.*/
+void od_apply_postfilter_frame_sbs(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int nhsb, int nvsb, int xdec, int ydec, int q,
+ unsigned char *skip, int skip_stride) {
+  od_apply_postfilter_frame_vedges(vtbl, c0, stride, nhsb, 0, nvsb, xdec, ydec,
+   q, skip, skip_stride);
+  od_apply_postfilter_frame_hedges(vtbl, c0, stride, 0, nhsb, nvsb, xdec, ydec,
+   q, skip, skip_stride);
+}
+
+/*Applies the part of od_apply_postfilter_frame_sbs() that belongs to the
+   superblock rows [sby0, sby1): the edges between superblocks within those
+   rows, then the edge above each row.
+  The filters applied to different rows do not overlap, so once every row has
+   been processed in order, the result is the same as for the whole frame,
+   and row sby is final as soon as row sby + 1 has been processed.*/
+void od_apply_postfilter_frame_rows(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c0, int stride, int nhsb, int sby0, int sby1, int xdec, int ydec,
+ int q, unsigned char *skip, int skip_stride) {
+#if OD_DEBLOCKING
+  od_coeff *c;
+  int sbx;
+  int sby;
+  OD_UNUSED(vtbl);
+  for (sby = sby0; sby < sby1; sby++) {
+    int i;
+    int j;
+    c = c0 + (OD_BSIZE_MAX >> ydec);
+    for (sbx = 1; sbx < nhsb; sbx++) {
+      for (i = sby << OD_LOG_BSIZE_MAX >> ydec;
+       i < (sby + 1) << OD_LOG_BSIZE_MAX >> ydec; i += 8) {
+        if (!skip[(i >> 2)*skip_stride + (sbx << 3 >> xdec) - 1]
+         || !skip[(i >> 2)*skip_stride + (sbx << 3 >> xdec)]) {
+          od_thor_deblock_col8(c + i*stride, stride, q);
+        }
+      }
+      c += OD_BSIZE_MAX >> xdec;
+    }
+    if (sby > 0) {
+      c = c0 + (sby << OD_LOG_BSIZE_MAX >> ydec)*stride;
+      for (j = 0; j < nhsb << OD_LOG_BSIZE_MAX >> xdec; j += 8) {
+        if (!skip[((sby << 3 >> xdec) - 1)*skip_stride + (j >> 2)]
+         || !skip[(sby << 3 >> xdec)*skip_stride + (j >> 2)]) {
+          od_thor_deblock_row8(c + j, stride, q);
+        }
+      }
+    }
   }
 #else
   int sbx;
   int sby;
-  int i;
-  int j;
   int f;
   od_coeff *c;
   OD_UNUSED(q);
   OD_UNUSED(skip);
   OD_UNUSED(skip_stride);
   f = OD_FILT_SIZE(OD_NBSIZES - 1, xdec);
-  c = c0 + (OD_BSIZE_MAX >> ydec) - (2 << f);
-  for (sbx = 1; sbx < nhsb; sbx++) {
-    for (i = 0; i < nvsb << OD_LOG_BSIZE_MAX >> ydec; i++) {
-      (*OD_POST_FILTER[f])(c + i*stride, c + i*stride);
+  for (sby = sby0; sby < sby1; sby++) {
+    c = c0 + (OD_BSIZE_MAX >> ydec) - (2 << f)
+     + (sby << OD_LOG_BSIZE_MAX >> ydec)*stride;
+    for (sbx = 1; sbx < nhsb; sbx++) {
+      (*vtbl->post_filter_rows[f])(c, stride, OD_BSIZE_MAX >> ydec);
+      c += OD_BSIZE_MAX >> xdec;
     }
-    c += OD_BSIZE_MAX >> xdec;
-  }
-  c = c0 + ((OD_BSIZE_MAX >> ydec) - (2 << f))*stride;
-  for (sby = 1; sby < nvsb; sby++) {
-    for (j = 0; j < nhsb << OD_LOG_BSIZE_MAX >> xdec; j++) {
-      int k;
-      od_coeff t[4 << OD_NBSIZES];
-      for (k = 0; k < 4 << f; k++) t[k] = c[stride*k + j];
-      (*OD_POST_FILTER[f])(t, t);
-      for (k = 0; k < 4 << f; k++) c[stride*k + j] = t[k];
+    if (sby > 0) {
+      c = c0 + ((sby << OD_LOG_BSIZE_MAX >> ydec) - (2 << f))*stride;
+      (*vtbl->post_filter_cols[f])(c, stride,
+       nhsb << OD_LOG_BSIZE_MAX >> xdec);
     }
-    c += OD_BSIZE_MAX*stride >> ydec;
   }
 #endif
 }
@@ -64,6 +64,41 @@ void od_post_filter16(od_coeff _x[16], const od_coeff _y[16]);
 void od_pre_filter32(od_coeff _y[32], const od_coeff _x[32]);
 void od_post_filter32(od_coeff _x[32], const od_coeff _y[32]);
 
+/*Filters n adjacent lines of a plane in place.
+  The row functions filter across a vertical edge: line i starts at
+   c + i*stride and its taps are consecutive coefficients.
+  The column functions filter across a horizontal edge: line j starts at
+   c + j and its taps are stride coefficients apart.
+  n is always a multiple of 4.*/
+typedef void (*od_filter_lines_func)(od_coeff *c, int stride, int n);
+
+struct od_filter_opt_vtbl {
+  od_filter_lines_func pre_filter_rows[OD_NBSIZES];
+  od_filter_lines_func pre_filter_cols[OD_NBSIZES];
+  od_filter_lines_func post_filter_rows[OD_NBSIZES];
+  od_filter_lines_func post_filter_cols[OD_NBSIZES];
+};
+typedef struct od_filter_opt_vtbl od_filter_opt_vtbl;
+
+extern const od_filter_opt_vtbl OD_FILTER_VTBL_C;
+
+void od_pre_filter_rows4_c(od_coeff *c, int stride, int n);
+void od_pre_filter_rows8_c(od_coeff *c, int stride, int n);
+void od_pre_filter_rows16_c(od_coeff *c, int stride, int n);
+void od_pre_filter_rows32_c(od_coeff *c, int stride, int n);
+void od_pre_filter_cols4_c(od_coeff *c, int stride, int n);
+void od_pre_filter_cols8_c(od_coeff *c, int stride, int n);
+void od_pre_filter_cols16_c(od_coeff *c, int stride, int n);
+void od_pre_filter_cols32_c(od_coeff *c, int stride, int n);
+void od_post_filter_rows4_c(od_coeff *c, int stride, int n);
+void od_post_filter_rows8_c(od_coeff *c, int stride, int n);
+void od_post_filter_rows16_c(od_coeff *c, int stride, int n);
+void od_post_filter_rows32_c(od_coeff *c, int stride, int n);
+void od_post_filter_cols4_c(od_coeff *c, int stride, int n);
+void od_post_filter_cols8_c(od_coeff *c, int stride, int n);
+void od_post_filter_cols16_c(od_coeff *c, int stride, int n);
+void od_post_filter_cols32_c(od_coeff *c, int stride, int n);
+
 void od_apply_prefilter_frame(od_coeff *c, int w, int nhsb, int nvsb,
  const unsigned char *bsize, int bstride, int dec);
 void od_apply_postfilter_frame(od_coeff *c, int w, int nhsb, int nvsb,
@@ -77,14 +112,29 @@ void od_apply_postfilter_frame(od_coeff *c, int w, int nhsb, int nvsb,
 #define OD_FILT_SIZE(ln, xdec) (0)
 
 extern const int OD_FILT_SIZE[OD_NBSIZES];
-void od_prefilter_split(od_coeff *c0, int stride, int bs, int f, int hfilter,
- int vfilter);
-void od_postfilter_split(od_coeff *c0, int stride, int bs, int f, int q,
- unsigned char *skip, int skip_stride, int hfilter, int vfilter);
-void od_apply_prefilter_frame_sbs(od_coeff *c, int stride, int nhsb, int nvsb,
- int xdec, int ydec);
-void od_apply_postfilter_frame_sbs(od_coeff *c, int stride, int nhsb, int nvsb,
- int xdec, int ydec, int q, unsigned char *skip, int skip_stride);
+void od_prefilter_split(const od_filter_opt_vtbl *vtbl, od_coeff *c0,
+ int stride, int bs, int f, int hfilter, int vfilter);
+void od_postfilter_split(const od_filter_opt_vtbl *vtbl, od_coeff *c0,
+ int stride, int bs, int f, int q, unsigned char *skip, int skip_stride,
+ int hfilter, int vfilter);
+void od_apply_prefilter_frame_hedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c, int stride, int sbx0, int sbx1, int nvsb, int xdec, int ydec);
+void od_apply_prefilter_frame_vedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c, int stride, int nhsb, int sby0, int sby1, int xdec, int ydec);
+void od_apply_prefilter_frame_sbs(const od_filter_opt_vtbl *vtbl, od_coeff *c,
+ int stride, int nhsb, int nvsb, int xdec, int ydec);
+void od_apply_postfilter_frame_vedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c, int stride, int nhsb, int sby0, int sby1, int xdec, int ydec,
+ int q, unsigned char *skip, int skip_stride);
+void od_apply_postfilter_frame_hedges(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c, int stride, int sbx0, int sbx1, int nvsb, int xdec, int ydec,
+ int q, unsigned char *skip, int skip_stride);
+void od_apply_postfilter_frame_sbs(const od_filter_opt_vtbl *vtbl, od_coeff *c,
+ int stride, int nhsb, int nvsb, int xdec, int ydec, int q,
+ unsigned char *skip, int skip_stride);
+void od_apply_postfilter_frame_rows(const od_filter_opt_vtbl *vtbl,
+ od_coeff *c, int stride, int nhsb, int sby0, int sby1, int xdec, int ydec,
+ int q, unsigned char *skip, int skip_stride);
 void od_apply_filter_sb_rows(od_coeff *c, int stride, int nhsb, int nvsb,
  int xdec, int ydec, int inv, int bs);
 void od_apply_filter_sb_cols(od_coeff *c, int stride, int nhsb, int nvsb,
@@ -193,6 +193,16 @@ int daala_decode_header_in(daala_info *info,
         if (tmpi < 0) return OD_EBADHEADER;
         info->plane_info[pli].ydec = !!tmpi;
       }
+      /*The tile grid was added in version 0.1; older streams use a single
+         tile.*/
+      if (info->version_major > 0 || info->version_minor >= 1) {
+        tmpi = oggbyte_read1(&obb);
+        if (tmpi < 0 || tmpi > OD_TILES_LOG2_MAX) return OD_EBADHEADER;
+        info->tile_cols_log2 = tmpi;
+        tmpi = oggbyte_read1(&obb);
+        if (tmpi < 0 || tmpi > OD_TILES_LOG2_MAX) return OD_EBADHEADER;
+        info->tile_rows_log2 = tmpi;
+      }
       return 2;
     }
     case 0x81:
@@ -64,6 +64,8 @@ int daala_encode_flush_header(daala_enc_ctx *_enc, daala_comment *_dc,
         oggbyte_write1(&_enc->obb, info->plane_info[pli].xdec);
         oggbyte_write1(&_enc->obb, info->plane_info[pli].ydec);
       }
+      oggbyte_write1(&_enc->obb, info->tile_cols_log2);
+      oggbyte_write1(&_enc->obb, info->tile_rows_log2);
       _op->b_o_s = 1;
     }
     break;
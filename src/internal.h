@@ -38,7 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 # endif
 
 # define OD_VERSION_MAJOR (0)
-# define OD_VERSION_MINOR (0)
+# define OD_VERSION_MINOR (1)
 # define OD_VERSION_SUB   (0)
 
 /* PACKAGE_STRING needs to be defined for deterministic builds */
@@ -34,8 +34,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 #include "tf.h"
 #include "state.h"
 
+/*Horizontal/vertical intra prediction from the neighboring block of the same
+   size above or to the left.
+  (bx0, by0) is the first 4x4 block of the current tile: blocks in other tiles
+   are never used.*/
 void od_hv_intra_pred(od_coeff *pred, const od_coeff *d, int w, int bx, int by,
- unsigned char *bsize, int bstride, int bs) {
+ int bx0, int by0, unsigned char *bsize, int bstride, int bs) {
   int i;
   const od_coeff *t;
   double g1;
@@ -44,8 +48,8 @@ void od_hv_intra_pred(od_coeff *pred, const od_coeff *d, int w, int bx, int by,
   int left;
   int n;
   n = 1 << (bs + OD_LOG_BSIZE0);
-  top = by > 0 && OD_BLOCK_SIZE4x4(bsize, bstride, bx, by - 1) == bs;
-  left = bx > 0 && OD_BLOCK_SIZE4x4(bsize, bstride, bx - 1, by) == bs;
+  top = by > by0 && OD_BLOCK_SIZE4x4(bsize, bstride, bx, by - 1) == bs;
+  left = bx > bx0 && OD_BLOCK_SIZE4x4(bsize, bstride, bx - 1, by) == bs;
   t = &d[((by << OD_LOG_BSIZE0))*w + (bx << OD_LOG_BSIZE0)];
   g1 = g2 = 0;
   if (top) for (i = 1; i < 4; i++) g1 += t[-n*w + i]*(double)t[-n*w + i];
@@ -27,7 +27,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 # include "filter.h"
 
 void od_hv_intra_pred(od_coeff *pred, const od_coeff *d, int w, int bx, int by,
- unsigned char *bsize, int bstride, int bs);
+ int bx0, int by0, unsigned char *bsize, int bstride, int bs);
 
 void od_resample_luma_coeffs(od_coeff *l, int lstride,
  const od_coeff *c, int cstride, int xdec, int ydec, int bs, int cbs);
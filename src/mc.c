@@ -1053,7 +1053,7 @@ static void od_mc_blend_multi(od_state *state, unsigned char *dst,
    log_xblk_sz, log_yblk_sz);
 }
 
-static void od_mc_setup_s_split(int s0[4], int dsdi[4], int dsdj[4],
+void od_mc_setup_s_split(int s0[4], int dsdi[4], int dsdj[4],
  int ddsdidj[4], int oc, int s, int log_xblk_sz, int log_yblk_sz) {
   int log_blk_sz2;
   int k;
@@ -1962,8 +1962,8 @@ static void od_mc_blend(od_state *state, unsigned char *dst, int dystride,
 }
 
 
-void od_mc_predict_singleref(od_state *state, unsigned char *dst,
- int dystride, const unsigned char *src, int systride,
+void od_mc_predict_singleref(od_state *state, unsigned char *mc_buf[4],
+ unsigned char *dst, int dystride, const unsigned char *src, int systride,
  const int32_t mvx[4], /* This is x coord for the four
                             motion vectors of the four corners
                             (in rotation not raster order). */
@@ -1974,37 +1974,37 @@ void od_mc_predict_singleref(od_state *state, unsigned char *dst,
  int log_yblk_sz
 ) {
   const unsigned char *pred[4];
-  od_mc_predict1fmv(state, state->mc_buf[0], src, systride,
+  od_mc_predict1fmv(state, mc_buf[0], src, systride,
    mvx[0], mvy[0], log_xblk_sz, log_yblk_sz);
-  pred[0] = state->mc_buf[0];
+  pred[0] = mc_buf[0];
   if (mvx[1] == mvx[0] && mvy[1] == mvy[0]) pred[1] = pred[0];
   else {
-    od_mc_predict1fmv(state, state->mc_buf[1], src, systride,
+    od_mc_predict1fmv(state, mc_buf[1], src, systride,
      mvx[1], mvy[1], log_xblk_sz, log_yblk_sz);
-    pred[1] = state->mc_buf[1];
+    pred[1] = mc_buf[1];
   }
   if (mvx[2] == mvx[0] && mvy[2] == mvy[0]) pred[2] = pred[0];
   else if (mvx[2] == mvx[1] && mvy[2] == mvy[1]) pred[2] = pred[1];
   else {
-    od_mc_predict1fmv(state, state->mc_buf[2], src, systride,
+    od_mc_predict1fmv(state, mc_buf[2], src, systride,
      mvx[2], mvy[2], log_xblk_sz, log_yblk_sz);
-    pred[2] = state->mc_buf[2];
+    pred[2] = mc_buf[2];
   }
   if (mvx[3] == mvx[0] && mvy[3] == mvy[0]) pred[3] = pred[0];
   else if (mvx[3] == mvx[1] && mvy[3] == mvy[1]) pred[3] = pred[1];
   else if (mvx[3] == mvx[2] && mvy[3] == mvy[2]) pred[3] = pred[2];
   else {
-    od_mc_predict1fmv(state, state->mc_buf[3], src, systride,
+    od_mc_predict1fmv(state, mc_buf[3], src, systride,
      mvx[3], mvy[3], log_xblk_sz, log_yblk_sz);
-    pred[3] = state->mc_buf[3];
+    pred[3] = mc_buf[3];
   }
   od_mc_blend(state, dst, dystride, pred,
    oc, s, log_xblk_sz, log_yblk_sz);
 }
 
 /* TODO: Identical MV optimizations like od_mc_predict_singleref. */
-void od_mc_predict(od_state *state, unsigned char *dst,
- int dystride, const unsigned char *src[4], int systride,
+void od_mc_predict(od_state *state, unsigned char *mc_buf[4],
+ unsigned char *dst, int dystride, const unsigned char *src[4], int systride,
  const int32_t mvx[4], const int32_t mvy[4],
  int oc,  /* index of outside corner  */
  int s, /* two split flags that indicate if the corners are split*/
@@ -2012,22 +2012,22 @@ void od_mc_predict(od_state *state, unsigned char *dst,
  int log_yblk_sz) {
   const unsigned char *pred[4];
   if ((src[0] == src[1]) && (src[0] == src[2]) && (src[0] == src[3])) {
-    od_mc_predict_singleref(state, dst, dystride, src[0], systride, mvx, mvy,
-     oc, s, log_xblk_sz, log_yblk_sz);
+    od_mc_predict_singleref(state, mc_buf, dst, dystride, src[0], systride,
+     mvx, mvy, oc, s, log_xblk_sz, log_yblk_sz);
     return;
   }
-  od_mc_predict1fmv(state, state->mc_buf[0], src[0], systride,
+  od_mc_predict1fmv(state, mc_buf[0], src[0], systride,
    mvx[0], mvy[0], log_xblk_sz, log_yblk_sz);
-  pred[0] = state->mc_buf[0];
-  od_mc_predict1fmv(state, state->mc_buf[1], src[1], systride,
+  pred[0] = mc_buf[0];
+  od_mc_predict1fmv(state, mc_buf[1], src[1], systride,
    mvx[1], mvy[1], log_xblk_sz, log_yblk_sz);
-  pred[1] = state->mc_buf[1];
-  od_mc_predict1fmv(state, state->mc_buf[2], src[2], systride,
+  pred[1] = mc_buf[1];
+  od_mc_predict1fmv(state, mc_buf[2], src[2], systride,
    mvx[2], mvy[2], log_xblk_sz, log_yblk_sz);
-  pred[2] = state->mc_buf[2];
-  od_mc_predict1fmv(state, state->mc_buf[3], src[3], systride,
+  pred[2] = mc_buf[2];
+  od_mc_predict1fmv(state, mc_buf[3], src[3], systride,
    mvx[3], mvy[3], log_xblk_sz, log_yblk_sz);
-  pred[3] = state->mc_buf[3];
+  pred[3] = mc_buf[3];
 
   od_mc_blend(state, dst, dystride, pred,
    oc, s, log_xblk_sz, log_yblk_sz);
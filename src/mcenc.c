@@ -1803,15 +1803,25 @@ static int od_mv_est_init_impl(od_mv_est_ctx *est, od_enc_ctx *enc) {
   if (OD_UNLIKELY(!est->dec_heap)) {
     return OD_EFAULT;
   }
+  est->hit_cache = (unsigned char (*)[OD_MC_SEARCH_RANGE*2*2])malloc(
+   sizeof(*est->hit_cache)*OD_MC_SEARCH_RANGE*2*2);
+  if (OD_UNLIKELY(!est->hit_cache)) {
+    return OD_EFAULT;
+  }
   /*Set to UCHAR_MAX so that od_mv_est_clear_hit_cache initializes hit_cache.*/
   est->hit_bit = UCHAR_MAX;
+  OD_COPY(est->mc_buf, enc->state.mc_buf, 5);
   est->mv_res_min = 0;
   est->flags = OD_MC_USE_CHROMA;
   return OD_SUCCESS;
 }
 
+static void od_mv_est_workers_clear(od_mv_est_ctx *est);
+
 static void od_mv_est_clear(od_mv_est_ctx *est) {
   int log_mvb_sz;
+  od_mv_est_workers_clear(est);
+  free(est->hit_cache);
   free(est->dec_heap);
   free(est->col_counts);
   free(est->row_counts);
@@ -1832,6 +1842,120 @@ static int od_mv_est_init(od_mv_est_ctx *est, od_enc_ctx *enc) {
   return ret;
 }
 
+/*Frees the per-thread contexts.*/
+static void od_mv_est_workers_clear(od_mv_est_ctx *est) {
+  int nmvbrows;
+  int i;
+  if (est->mvb_rows != NULL) {
+    nmvbrows = est->enc->state.nvmvbs >> OD_LOG_MVB_DELTA0;
+    for (i = 0; i < nmvbrows; i++) od_progress_clear(est->mvb_rows + i);
+    free(est->mvb_rows);
+    est->mvb_rows = NULL;
+  }
+  if (est->workers != NULL) {
+    for (i = 0; i < est->nworkers; i++) {
+      od_aligned_free(est->workers[i].mc_buf[0]);
+      free(est->workers[i].dp_nodes);
+      free(est->workers[i].hit_cache);
+    }
+    free(est->workers);
+    est->workers = NULL;
+  }
+  est->nworkers = 0;
+}
+
+/*Allocates one context per thread.
+  On failure, od_mv_est_workers_clear() must be called.*/
+static int od_mv_est_workers_init(od_mv_est_ctx *est, int nworkers) {
+  od_state *state;
+  size_t mc_buf_sz;
+  int nmvbrows;
+  int i;
+  int j;
+  state = &est->enc->state;
+  nmvbrows = state->nvmvbs >> OD_LOG_MVB_DELTA0;
+  est->mvb_rows = (od_progress *)malloc(sizeof(*est->mvb_rows)*nmvbrows);
+  if (OD_UNLIKELY(!est->mvb_rows)) {
+    return OD_EFAULT;
+  }
+  for (i = 0; i < nmvbrows; i++) {
+    if (OD_UNLIKELY(od_progress_init(est->mvb_rows + i) < 0)) {
+      while (i-- > 0) od_progress_clear(est->mvb_rows + i);
+      free(est->mvb_rows);
+      est->mvb_rows = NULL;
+      return OD_EFAULT;
+    }
+  }
+  est->workers = (od_mv_est_ctx *)calloc(nworkers, sizeof(*est->workers));
+  if (OD_UNLIKELY(!est->workers)) {
+    return OD_EFAULT;
+  }
+  est->nworkers = nworkers;
+  mc_buf_sz = OD_MVBSIZE_MAX*OD_MVBSIZE_MAX
+   *(state->info.full_precision_references ? 2 : 1);
+  for (i = 0; i < nworkers; i++) {
+    od_mv_est_ctx *worker;
+    worker = est->workers + i;
+    worker->hit_cache = (unsigned char (*)[OD_MC_SEARCH_RANGE*2*2])malloc(
+     sizeof(*worker->hit_cache)*OD_MC_SEARCH_RANGE*2*2);
+    worker->dp_nodes = (od_mv_dp_node *)malloc(
+     sizeof(*worker->dp_nodes)*(OD_MAXI(state->nhmvbs, state->nvmvbs) + 1));
+    worker->mc_buf[0] = (unsigned char *)od_aligned_malloc(5*mc_buf_sz, 32);
+    if (OD_UNLIKELY(!worker->hit_cache || !worker->dp_nodes
+     || !worker->mc_buf[0])) {
+      return OD_EFAULT;
+    }
+    for (j = 1; j < 5; j++) worker->mc_buf[j] = worker->mc_buf[0] + j*mc_buf_sz;
+    worker->hit_bit = UCHAR_MAX;
+  }
+  return OD_SUCCESS;
+}
+
+/*Makes sure there is one context per thread of the encoder's pool.
+  If they cannot be allocated, the search runs on the calling thread.*/
+static void od_mv_est_workers_update(od_mv_est_ctx *est) {
+  int nworkers;
+  nworkers = est->enc->state.threads.nthreads;
+#if defined(OD_DUMP_IMAGES) && defined(OD_ANIMATE)
+  /*The animation draws every step of the search into a single image.*/
+  nworkers = 1;
+#endif
+  if (nworkers <= 1) nworkers = 0;
+  if (est->nworkers == nworkers) return;
+  od_mv_est_workers_clear(est);
+  if (nworkers > 0 && OD_UNLIKELY(od_mv_est_workers_init(est, nworkers) < 0)) {
+    od_mv_est_workers_clear(est);
+  }
+}
+
+/*Copies the current search parameters into each per-thread context, keeping
+   their own scratch space.
+  This must be done before each parallel stage, since the parameters (e.g.,
+   lambda and the distortion metric) change as the search progresses.*/
+static void od_mv_est_workers_sync(od_mv_est_ctx *est) {
+  int i;
+  for (i = 0; i < est->nworkers; i++) {
+    od_mv_est_ctx *worker;
+    unsigned char (*hit_cache)[OD_MC_SEARCH_RANGE*2*2];
+    unsigned hit_bit;
+    od_mv_dp_node *dp_nodes;
+    unsigned char *mc_buf[5];
+    worker = est->workers + i;
+    hit_cache = worker->hit_cache;
+    hit_bit = worker->hit_bit;
+    dp_nodes = worker->dp_nodes;
+    OD_COPY(mc_buf, worker->mc_buf, 5);
+    OD_COPY(worker, est, 1);
+    worker->hit_cache = hit_cache;
+    worker->hit_bit = hit_bit;
+    worker->dp_nodes = dp_nodes;
+    OD_COPY(worker->mc_buf, mc_buf, 5);
+    worker->workers = NULL;
+    worker->nworkers = 0;
+    worker->mvb_rows = NULL;
+  }
+}
+
 /*STAGE 1: INITIAL MV ESTIMATES (via EPZS^2).*/
 
 /*The amount to right shift the minimum error by when inflating it for
@@ -2078,7 +2202,8 @@ static const int OD_SEARCH_STATES[6][13] = {
 /*Clear the cache of motion vectors we've examined.*/
 static void od_mv_est_clear_hit_cache(od_mv_est_ctx *est) {
   if (++est->hit_bit == UCHAR_MAX + 1) {
-    memset(est->hit_cache, 0, sizeof(est->hit_cache));
+    memset(est->hit_cache, 0,
+     sizeof(*est->hit_cache)*OD_MC_SEARCH_RANGE*2*2);
     est->hit_bit = 1;
   }
 }
@@ -2249,13 +2374,13 @@ static int32_t od_mv_est_bma_sad(od_mv_est_ctx *est,
      + (by >> iplane->ydec)*iplane->ystride
      + (bx >> iplane->xdec)*iplane->xstride;
     (*state->opt_vtbl.mc_predict1fmv)
-     (state, state->mc_buf[4], ref_img, iplane->ystride,
+     (state, est->mc_buf[4], ref_img, iplane->ystride,
      mvx*(1 << (2 - iplane->xdec)), mvy*(1 << (2 - iplane->ydec)),
      log_mvb_sz + OD_LOG_MVBSIZE_MIN - iplane->xdec,
      log_mvb_sz + OD_LOG_MVBSIZE_MIN - iplane->ydec);
     /*Then, calculate SAD between a target block and the subpel interpolated
        MC block.*/
-    ret += od_enc_sad(est->enc, state->mc_buf[4],
+    ret += od_enc_sad(est->enc, est->mc_buf[4],
      iplane->xstride << (log_mvb_sz + OD_LOG_MVBSIZE_MIN - iplane->xdec),
      iplane->xstride,
      pli, bx, by, log_mvb_sz + OD_LOG_MVBSIZE_MIN) >> dist_scale;
@@ -2271,18 +2396,18 @@ static int32_t od_mv_est_sad(od_mv_est_ctx *est,
   int xstride;
   state = &est->enc->state;
   xstride = est->enc->curr_img->planes[0].xstride;
-  od_state_pred_block_from_setup(state, state->mc_buf[4],
+  od_state_pred_block_from_setup(state, est->mc_buf, est->mc_buf[4],
    OD_MVBSIZE_MAX*xstride, 0, vx, vy, oc, s, log_mvb_sz);
-  ret = est->compute_distortion(est->enc, state->mc_buf[4],
+  ret = est->compute_distortion(est->enc, est->mc_buf[4],
    OD_MVBSIZE_MAX*xstride, xstride,
    0, vx << OD_LOG_MVBSIZE_MIN, vy << OD_LOG_MVBSIZE_MIN,
    log_mvb_sz + OD_LOG_MVBSIZE_MIN);
   if (est->flags & OD_MC_USE_CHROMA) {
     int pli;
     for (pli = 1; pli < state->info.nplanes; pli++) {
-      od_state_pred_block_from_setup(state, state->mc_buf[4],
+      od_state_pred_block_from_setup(state, est->mc_buf, est->mc_buf[4],
        OD_MVBSIZE_MAX*xstride, pli, vx, vy, oc, s, log_mvb_sz);
-      ret += est->compute_distortion(est->enc, state->mc_buf[4],
+      ret += est->compute_distortion(est->enc, est->mc_buf[4],
        OD_MVBSIZE_MAX*xstride, xstride,
        pli, vx << OD_LOG_MVBSIZE_MIN, vy << OD_LOG_MVBSIZE_MIN,
        log_mvb_sz + OD_LOG_MVBSIZE_MIN) >> OD_MC_CHROMA_SCALE;
@@ -3028,6 +3153,98 @@ static void od_mv_est_init_mv(od_mv_est_ctx *est, int ref, int vx, int vy,
   }
 }
 
+/*Initializes the MVs of the MVB with top-left corner (vx, vy), along with the
+   level 0 vertex at its bottom-right corner.
+  Only vertices on the top and left edges of the frame are shared with the MVBs
+   above and to the left; the rest of each MVB's top and left edges belong to
+   those MVBs.*/
+static void od_mv_est_init_mvb(od_mv_est_ctx *est, int ref, int vx, int vy,
+ int must_update) {
+  int log_mvb_sz;
+  int level;
+  /*Level 0 vertex.*/
+  od_mv_est_init_mv(est, ref, vx + OD_MVB_DELTA0, vy + OD_MVB_DELTA0,
+   must_update);
+  /*All other levels.*/
+  for(log_mvb_sz = OD_LOG_MVB_DELTA0, level = 1;
+   log_mvb_sz-- > 0 && est->level_max >= level; level++) {
+    int cx;
+    int cy;
+    int mvb_sz;
+    mvb_sz = 1 << log_mvb_sz;
+    /*Odd level vertices.*/
+    for (cy = vy + mvb_sz; cy < vy + OD_MVB_DELTA0; cy += 2*mvb_sz) {
+      for( cx = vx + mvb_sz; cx < vx + OD_MVB_DELTA0; cx += 2*mvb_sz) {
+        od_mv_est_init_mv(est, ref, cx, cy, must_update);
+      }
+    }
+    level++;
+    if (est->level_max < level) break;
+    /*Even level vertices.*/
+    /*Add even-level vertices on the top/left edges of the frame as extra
+       vertices in the first row/column of MVBs.
+      Unlike other vertices on the edges of an MVB, they can use parents to
+       the right/below them as predictors (or otherwise they would have no
+       predictors).*/
+    /*Skip the cy == vy row unless we're at the top of the frame.*/
+    for (cy = vy + mvb_sz*!!vy; cy <= vy + OD_MVB_DELTA0; cy += mvb_sz) {
+      /*Even level vertices appear in a quincunx pattern.
+        We want to start every other row at an mvb_sz offset, and also to
+         skip the first column on the rows flush with the edge of the block
+         unless we're on the left edge of the whole frame.*/
+      for( cx = vx + (cy & mvb_sz ? 2*mvb_sz*!!vx : mvb_sz);
+       cx <= vx + OD_MVB_DELTA0; cx += 2*mvb_sz) {
+        od_mv_est_init_mv(est, ref, cx, cy, must_update);
+      }
+    }
+  }
+}
+
+/*Everything needed to run the initial search on the worker threads.*/
+struct od_mv_est_init_ctx {
+  od_mv_est_ctx *est;
+  int ref;
+  int must_update;
+};
+typedef struct od_mv_est_init_ctx od_mv_est_init_ctx;
+
+/*Thread pool job initializing the MVs of one row of MVBs.
+  Besides the level 0 vertices along its top edge, a row of MVBs only depends
+   on the MVs of the row above that are no more than one MVB to its right, so
+   each row starts as soon as the row above is two MVBs ahead.
+  Rows are submitted in order and only wait on earlier rows, which makes the
+   result identical to the serial search.*/
+static void od_mv_est_init_mvb_row(void *ctx, int mvby) {
+  od_mv_est_init_ctx *ictx;
+  od_mv_est_ctx *est;
+  od_mv_est_ctx *worker;
+  int nhmvbs;
+  int ncols;
+  int mvbx;
+  int vy;
+  ictx = (od_mv_est_init_ctx *)ctx;
+  est = ictx->est;
+  nhmvbs = est->enc->state.nhmvbs;
+  ncols = nhmvbs >> OD_LOG_MVB_DELTA0;
+  /*Wait for the last row that used this context to finish with it.*/
+  if (mvby >= est->nworkers) {
+    od_progress_wait(est->mvb_rows + mvby - est->nworkers, ncols);
+  }
+  worker = est->workers + mvby % est->nworkers;
+  vy = mvby << OD_LOG_MVB_DELTA0;
+  if (mvby > 0) od_progress_wait(est->mvb_rows + mvby - 1, OD_MINI(2, ncols));
+  od_mv_est_init_mv(worker, ictx->ref, 0, vy + OD_MVB_DELTA0,
+   ictx->must_update);
+  for (mvbx = 0; mvbx < ncols; mvbx++) {
+    if (mvby > 0) {
+      od_progress_wait(est->mvb_rows + mvby - 1, OD_MINI(mvbx + 2, ncols));
+    }
+    od_mv_est_init_mvb(worker, ictx->ref, mvbx << OD_LOG_MVB_DELTA0, vy,
+     ictx->must_update);
+    od_progress_set(est->mvb_rows + mvby, mvbx + 1);
+  }
+}
+
 static void od_mv_est_init_mvs(od_mv_est_ctx *est, int ref, int must_update) {
   od_state *state;
   int nhmvbs;
@@ -3062,47 +3279,26 @@ static void od_mv_est_init_mvs(od_mv_est_ctx *est, int ref, int must_update) {
   for (vx = 0; vx <= nhmvbs; vx += OD_MVB_DELTA0) {
     od_mv_est_init_mv(est, ref, vx, 0, must_update);
   }
+  if (est->nworkers > 0) {
+    od_mv_est_init_ctx ictx;
+    int nmvbrows;
+    int mvby;
+    ictx.est = est;
+    ictx.ref = ref;
+    ictx.must_update = must_update;
+    nmvbrows = nvmvbs >> OD_LOG_MVB_DELTA0;
+    od_mv_est_workers_sync(est);
+    for (mvby = 0; mvby < nmvbrows; mvby++) {
+      od_progress_reset(est->mvb_rows + mvby, 0);
+    }
+    od_thread_pool_run(&state->threads, od_mv_est_init_mvb_row, &ictx,
+     nmvbrows);
+    return;
+  }
   for (vy = 0; vy < nvmvbs; vy += OD_MVB_DELTA0) {
     od_mv_est_init_mv(est, ref, 0, vy + OD_MVB_DELTA0, must_update);
     for (vx = 0; vx < nhmvbs; vx += OD_MVB_DELTA0) {
-      int log_mvb_sz;
-      int level;
-      /*Level 0 vertex.*/
-      od_mv_est_init_mv(est, ref, vx + OD_MVB_DELTA0, vy + OD_MVB_DELTA0,
-       must_update);
-      /*All other levels.*/
-      for(log_mvb_sz = OD_LOG_MVB_DELTA0, level = 1;
-       log_mvb_sz-- > 0 && est->level_max >= level; level++) {
-        int cx;
-        int cy;
-        int mvb_sz;
-        mvb_sz = 1 << log_mvb_sz;
-        /*Odd level vertices.*/
-        for (cy = vy + mvb_sz; cy < vy + OD_MVB_DELTA0; cy += 2*mvb_sz) {
-          for( cx = vx + mvb_sz; cx < vx + OD_MVB_DELTA0; cx += 2*mvb_sz) {
-            od_mv_est_init_mv(est, ref, cx, cy, must_update);
-          }
-        }
-        level++;
-        if (est->level_max < level) break;
-        /*Even level vertices.*/
-        /*Add even-level vertices on the top/left edges of the frame as extra
-           vertices in the first row/column of MVBs.
-          Unlike other vertices on the edges of an MVB, they can use parents to
-           the right/below them as predictors (or otherwise they would have no
-           predictors).*/
-        /*Skip the cy == vy row unless we're at the top of the frame.*/
-        for (cy = vy + mvb_sz*!!vy; cy <= vy + OD_MVB_DELTA0; cy += mvb_sz) {
-          /*Even level vertices appear in a quincunx pattern.
-            We want to start every other row at an mvb_sz offset, and also to
-             skip the first column on the rows flush with the edge of the block
-             unless we're on the left edge of the whole frame.*/
-          for( cx = vx + (cy & mvb_sz ? 2*mvb_sz*!!vx : mvb_sz);
-           cx <= vx + OD_MVB_DELTA0; cx += 2*mvb_sz) {
-            od_mv_est_init_mv(est, ref, cx, cy, must_update);
-          }
-        }
-      }
+      od_mv_est_init_mvb(est, ref, vx, vy, must_update);
     }
   }
 }
@@ -5497,9 +5693,6 @@ static int32_t od_mv_est_refine_row(od_mv_est_ctx *est,
       dcost += best_cost;
     }
   }
-#if defined(OD_ENABLE_ASSERTIONS) || defined(OD_LOGGING_ENABLED)
-  od_mv_est_check_rd_state(est, mv_res);
-#endif
   return dcost;
 }
 
@@ -6162,37 +6355,121 @@ static int32_t od_mv_est_refine_col(od_mv_est_ctx *est,
       dcost += best_cost;
     }
   }
-#if defined(OD_ENABLE_ASSERTIONS) || defined(OD_LOGGING_ENABLED)
-  od_mv_est_check_rd_state(est, mv_res);
-#endif
   return dcost;
 }
 
+/*The number of sets of rows (or columns) refined one after the other.
+  Refining a row reads the MVs up to 2*OD_MVB_DELTA0 rows away from it and
+   changes the rates and SADs cached up to OD_MVB_DELTA0 rows away.
+  The rows are grouped into stripes of OD_MVB_DELTA0 rows, and every
+   OD_MV_EST_REFINE_NPHASES'th stripe is refined at the same time, so rows
+   refined concurrently never see each other's changes.
+  The stripes are visited in the same order whether or not threads are used,
+   so the result does not depend on the number of threads.*/
+#define OD_MV_EST_REFINE_NPHASES (3)
+
+/*Refines the rows (or columns) in every stripe_step'th stripe, starting with
+   stripe0.*/
+static int32_t od_mv_est_refine_stripes(od_mv_est_ctx *est, int cols,
+ int stripe0, int stripe_step, int log_dsz, int mv_res,
+ const int *pattern_nsites, const od_pattern *pattern) {
+  od_state *state;
+  const unsigned *counts;
+  int32_t dcost;
+  int stripe;
+  int nv;
+  int v;
+  state = &est->enc->state;
+  nv = cols ? state->nhmvbs : state->nvmvbs;
+  counts = cols ? est->col_counts : est->row_counts;
+  dcost = 0;
+  for (stripe = stripe0; stripe << OD_LOG_MVB_DELTA0 <= nv;
+   stripe += stripe_step) {
+    int v1;
+    v1 = OD_MINI(nv + 1, (stripe + 1) << OD_LOG_MVB_DELTA0);
+    for (v = stripe << OD_LOG_MVB_DELTA0; v < v1; v++) {
+      if (counts[v]) {
+        if (cols) {
+          dcost += od_mv_est_refine_col(est, v, log_dsz, mv_res,
+           pattern_nsites, pattern);
+        }
+        else {
+          dcost += od_mv_est_refine_row(est, v, log_dsz, mv_res,
+           pattern_nsites, pattern);
+        }
+      }
+    }
+  }
+  return dcost;
+}
+
+/*Everything needed to run a refinement phase on the worker threads.*/
+struct od_mv_est_refine_ctx {
+  od_mv_est_ctx *est;
+  int cols;
+  int phase;
+  int njobs;
+  int log_dsz;
+  int mv_res;
+  const int *pattern_nsites;
+  const od_pattern *pattern;
+  int32_t dcost[OD_THREADS_MAX];
+};
+typedef struct od_mv_est_refine_ctx od_mv_est_refine_ctx;
+
+static void od_mv_est_refine_job(void *ctx, int idx) {
+  od_mv_est_refine_ctx *rctx;
+  rctx = (od_mv_est_refine_ctx *)ctx;
+  rctx->dcost[idx] = od_mv_est_refine_stripes(rctx->est->workers + idx,
+   rctx->cols, rctx->phase + idx*OD_MV_EST_REFINE_NPHASES,
+   rctx->njobs*OD_MV_EST_REFINE_NPHASES, rctx->log_dsz, rctx->mv_res,
+   rctx->pattern_nsites, rctx->pattern);
+}
+
 static int32_t od_mv_est_refine(od_mv_est_ctx *est, int log_dsz,
  int mv_res, const int *pattern_nsites, const od_pattern *pattern) {
   od_state *state;
+  od_mv_est_refine_ctx rctx;
   int32_t dcost;
-  int nhmvbs;
-  int nvmvbs;
-  int vx;
-  int vy;
+  int cols;
+  int phase;
   state = &est->enc->state;
-  nhmvbs = state->nhmvbs;
-  nvmvbs = state->nvmvbs;
   OD_LOG((OD_LOG_MOTION_ESTIMATION, OD_LOG_DEBUG,
    "Refining with displacements of %0g and 1/%i pel MV resolution.",
    (1 << log_dsz)*0.125, 1 << (3 - mv_res)));
-  dcost = 0;
-  for (vy = 0; vy <= nvmvbs; vy++) {
-    if (est->row_counts[vy]) {
-      dcost += od_mv_est_refine_row(est, vy, log_dsz, mv_res,
-       pattern_nsites, pattern);
-    }
+  if (est->nworkers > 0) {
+    od_mv_est_workers_sync(est);
+    rctx.est = est;
+    rctx.log_dsz = log_dsz;
+    rctx.mv_res = mv_res;
+    rctx.pattern_nsites = pattern_nsites;
+    rctx.pattern = pattern;
   }
-  for (vx = 0; vx <= nhmvbs; vx++) {
-    if (est->col_counts[vx]) {
-      dcost += od_mv_est_refine_col(est, vx, log_dsz, mv_res,
-       pattern_nsites, pattern);
+  dcost = 0;
+  /*Refine all the rows, then all the columns.*/
+  for (cols = 0; cols < 2; cols++) {
+    for (phase = 0; phase < OD_MV_EST_REFINE_NPHASES; phase++) {
+      if (est->nworkers > 0) {
+        int nstripes;
+        int job;
+        nstripes =
+         ((cols ? state->nhmvbs : state->nvmvbs) >> OD_LOG_MVB_DELTA0) + 1;
+        rctx.cols = cols;
+        rctx.phase = phase;
+        rctx.njobs = OD_MINI(est->nworkers,
+         (nstripes - phase + OD_MV_EST_REFINE_NPHASES - 1)
+         /OD_MV_EST_REFINE_NPHASES);
+        od_thread_pool_run(&state->threads, od_mv_est_refine_job, &rctx,
+         rctx.njobs);
+        for (job = 0; job < rctx.njobs; job++) dcost += rctx.dcost[job];
+      }
+      else {
+        dcost += od_mv_est_refine_stripes(est, cols, phase,
+         OD_MV_EST_REFINE_NPHASES, log_dsz, mv_res, pattern_nsites, pattern);
+      }
+#if defined(OD_ENABLE_ASSERTIONS) || defined(OD_LOGGING_ENABLED)
+      od_mv_est_check_rd_state(est, mv_res);
+#endif
     }
   }
   return dcost;
@@ -6466,6 +6743,7 @@ void od_mv_est(od_mv_est_ctx *est, int lambda, int num_refs) {
     od_state_mvs_clear(&est->enc->state);
   }
 #endif
+  od_mv_est_workers_update(est);
   /*Use SAD for stages here after.*/
   est->compute_distortion = od_enc_sad;
   od_mv_est_init_mvs(est, OD_FRAME_PREV, 1);
@@ -190,7 +190,7 @@ struct od_mv_est_ctx {
      initial BMA search.
     Valid halfpel coordinates must be in the range -OD_MC_SEARCH_RANGE*2 to
      OD_MC_SEARCH_RANGE*2, this determines the size of this cache.*/
-  unsigned char hit_cache[OD_MC_SEARCH_RANGE*2*2][OD_MC_SEARCH_RANGE*2*2];
+  unsigned char (*hit_cache)[OD_MC_SEARCH_RANGE*2*2];
   /*The flag used by the current EPZS search iteration.*/
   unsigned hit_bit;
   /*The Lagrangian multiplier used for R-D optimization.*/
@@ -211,6 +211,18 @@ struct od_mv_est_ctx {
      and SATD functions are called for stage 4 (i.e. sub-pel refine).*/
   int32_t (*compute_distortion)(od_enc_ctx *enc, const unsigned char *p,
    int pystride, int pxstride, int pli, int x, int y, int log_blk_sz);
+  /*Scratch buffers for building MC predictions.
+    These are the od_state's own buffers, except in the per-thread contexts
+     below.*/
+  unsigned char *mc_buf[5];
+  /*Per-thread copies of this context, each with its own hit cache, trellis
+     and MC buffers, used to run the search on the worker threads.
+    They share the MV mesh with this context.*/
+  od_mv_est_ctx *workers;
+  int nworkers;
+  /*The number of MVBs finished in each row of MVBs by the threaded initial
+     search, used to keep each row behind the one above it.*/
+  od_progress *mvb_rows;
 };
 
 #endif
@@ -48,6 +48,31 @@ static void od_encode_pvq_codeword(od_ec_enc *ec, od_pvq_codeword_ctx *adapt,
   for (i = 0; i < n; i++) if (in[i]) od_ec_enc_bits(ec, in[i] < 0, 1);
 }
 
+/*Returns the first position j in [0, n) that maximizes
+   xy_rsqrt[y[j]] + (x[j]*rsqrt[y[j]] >> shift) - rate[j].
+  n must be a multiple of 8.
+  This is built even with OD_FLOAT_PVQ, since the encoder vtbl and the SIMD
+   checks refer to it.*/
+int od_pvq_search_max_c(const int32_t *x, const int32_t *y,
+ const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+ int shift, int n) {
+  int32_t best_cost;
+  int pos;
+  int j;
+  pos = 0;
+  best_cost = 0;
+  for (j = 0; j < n; j++) {
+    int32_t cost;
+    cost = xy_rsqrt[y[j]] + (x[j]*rsqrt[y[j]] >> shift) - rate[j];
+    if (j == 0 || cost > best_cost) {
+      best_cost = cost;
+      pos = j;
+    }
+  }
+  return pos;
+}
+
+#if defined(OD_FLOAT_PVQ)
 /* Computes 1/sqrt(i) using a table for small values. */
 static double od_rsqrt_table(int i) {
   static double table[16] = {
@@ -223,6 +248,277 @@ static double pvq_search_rdo_double(const od_val16 *xcoeff, int n, int k,
   return xy/(1e-100 + sqrt(xx*yy));
 }
 
+#else
+
+/*The number of entries in the rsqrt tables of the fixed-point search.
+  They cover the positions holding fewer pulses than this, which is almost
+   all of them.*/
+# define OD_PVQ_RSQRT_TABLE_SIZE (64)
+
+/*Initial guesses for 1/sqrt(t) in Q15, with t in [1, 4) in steps of 1/64,
+   taken at the middle of each step.*/
+static const int16_t OD_PVQ_RSQRT_SEED[192] = {
+  32641, 32391, 32146, 31907, 31673, 31445, 31221, 31002,
+  30787, 30577, 30371, 30169, 29972, 29778, 29587, 29401,
+  29217, 29038, 28861, 28688, 28518, 28350, 28186, 28024,
+  27866, 27709, 27556, 27405, 27256, 27110, 26966, 26825,
+  26686, 26548, 26413, 26280, 26149, 26020, 25893, 25767,
+  25644, 25522, 25402, 25283, 25167, 25051, 24938, 24826,
+  24715, 24606, 24498, 24392, 24287, 24184, 24081, 23980,
+  23881, 23782, 23685, 23589, 23494, 23400, 23307, 23216,
+  23125, 23036, 22947, 22860, 22774, 22688, 22604, 22520,
+  22437, 22356, 22275, 22195, 22116, 22037, 21960, 21883,
+  21808, 21732, 21658, 21585, 21512, 21440, 21368, 21298,
+  21228, 21159, 21090, 21022, 20955, 20888, 20822, 20757,
+  20692, 20628, 20564, 20501, 20439, 20377, 20316, 20255,
+  20195, 20135, 20076, 20017, 19959, 19902, 19845, 19788,
+  19732, 19676, 19621, 19566, 19512, 19458, 19405, 19352,
+  19299, 19247, 19196, 19144, 19093, 19043, 18993, 18943,
+  18894, 18845, 18797, 18749, 18701, 18653, 18606, 18560,
+  18513, 18467, 18422, 18376, 18331, 18287, 18242, 18198,
+  18155, 18111, 18068, 18025, 17983, 17941, 17899, 17857,
+  17816, 17775, 17734, 17694, 17654, 17614, 17574, 17535,
+  17496, 17457, 17418, 17380, 17342, 17304, 17267, 17229,
+  17192, 17155, 17119, 17082, 17046, 17010, 16974, 16939,
+  16904, 16869, 16834, 16799, 16765, 16731, 16697, 16663,
+  16629, 16596, 16563, 16530, 16497, 16465, 16432, 16400
+};
+
+/*Computes 2**(30 + k)/sqrt(v), where k = (OD_ILOG(v) - 1) >> 1, so that the
+   result is in (2**29, 2**30].
+  The seed table is accurate to about 2**-9, and each Newton iteration
+   roughly squares the relative error, so two of them leave it within about
+   2**-28.*/
+static int64_t od_pvq_rsqrt_q30(int32_t v, int k) {
+  uint32_t t;
+  int64_t r;
+  int i;
+  OD_ASSERT(v > 0);
+  /*t is v normalized to [1, 4) in Q30.*/
+  t = (uint32_t)v << (30 - 2*k);
+  r = (int64_t)OD_PVQ_RSQRT_SEED[(t >> 24) - 64] << 15;
+  for (i = 0; i < 2; i++) {
+    int64_t tr2;
+    /*r = r*(3 - t*r*r)/2.*/
+    tr2 = (int64_t)t*(r*r >> 30) >> 30;
+    r = r*(((int64_t)3 << 30) - tr2) >> 31;
+  }
+  return r;
+}
+
+/*Computes 1/sqrt(yy + 2*i + 1) in Q(rshift), i.e., the factor that
+   normalizes the codevector after adding a pulse to a position already
+   holding i of them, and xy times that factor, shifted down by shift.
+  The latter is computed from the Q30 reciprocal rather than the rounded
+   one, since xy is much larger than the x[j] that distinguish the
+   positions.*/
+static int32_t od_pvq_rsqrt(int32_t *xy_rsqrt, int32_t xy, int32_t yy, int i,
+ int shift, int rshift) {
+  int64_t r;
+  int32_t v;
+  int k;
+  int s;
+  OD_ASSERT(shift <= rshift);
+  v = yy + 2*i + 1;
+  k = (OD_ILOG(v) - 1) >> 1;
+  r = od_pvq_rsqrt_q30(v, k);
+  /*r is 1/sqrt(v) in Q(30 + k), and rshift is at most 16 + k.*/
+  s = 30 + k - rshift;
+  OD_ASSERT(s > 0);
+  *xy_rsqrt = (int32_t)(xy*r >> (s + shift));
+  return (int32_t)((r + ((int64_t)1 << (s - 1))) >> s);
+}
+
+/*Finds the position of the next pulse, maximizing
+   (xy + x[j])/sqrt(yy + 2*y[j] + 1) in Q(rshift - shift), minus rate[j].
+  ymax is the largest number of pulses in any position.*/
+static int od_pvq_search_pulse(const od_enc_opt_vtbl *vtbl,
+ const int32_t *x, const int32_t *y, const int32_t *rate, int32_t xy,
+ int32_t yy, int ymax, int shift, int rshift, int n) {
+  int32_t rsqrt[OD_PVQ_RSQRT_TABLE_SIZE];
+  int32_t xy_rsqrt[OD_PVQ_RSQRT_TABLE_SIZE];
+  int i;
+  if (ymax < OD_PVQ_RSQRT_TABLE_SIZE) {
+    for (i = 0; i <= ymax; i++) {
+      rsqrt[i] = od_pvq_rsqrt(xy_rsqrt + i, xy, yy, i, shift, rshift);
+    }
+    return (*vtbl->pvq_search_max)(x, y, rate, rsqrt, xy_rsqrt, shift, n);
+  }
+  else {
+    int32_t best_cost;
+    int pos;
+    int j;
+    /*Too many pulses in one position for the tables, so compute the same
+       costs directly.*/
+    pos = 0;
+    best_cost = 0;
+    for (j = 0; j < n; j++) {
+      int32_t r;
+      int32_t xy_r;
+      int32_t cost;
+      r = od_pvq_rsqrt(&xy_r, xy, yy, y[j], shift, rshift);
+      cost = xy_r + (x[j]*r >> shift) - rate[j];
+      if (j == 0 || cost > best_cost) {
+        best_cost = cost;
+        pos = j;
+      }
+    }
+    return pos;
+  }
+}
+
+/** Find the codepoint on the given PSphere closest to the desired
+ * vector. Fixed-point version of the search, with the same greedy and RDO
+ * steps as the double-precision one. The costs are compared as
+ * (xy + x[j])/sqrt(yy + 2*y[j] + 1), with both terms rounded to 15 bits,
+ * so the inner loop runs in 32-bit SIMD lanes through vtbl->pvq_search_max.
+ *
+ * @param [in]      vtbl    encoder function table
+ * @param [in]      xcoeff  input vector to quantize (x in the math doc)
+ * @param [in]      n       number of dimensions
+ * @param [in]      k       number of pulses
+ * @param [out]     ypulse  optimal codevector found (y in the math doc)
+ * @param [out]     g2      multiplier for the distortion (typically squared
+ *                          gain units)
+ * @param [in] pvq_norm_lambda enc->pvq_norm_lambda for quantized RDO
+ * @param [in]      prev_k  number of pulses already in ypulse that we should
+ *                          reuse for the search (or 0 for a new search)
+ * @return                  cosine distance between x and y (between 0 and 1)
+ */
+static double pvq_search_rdo_fixed(const od_enc_opt_vtbl *vtbl,
+ const od_val16 *xcoeff, int n, int k, od_coeff *ypulse, double g2,
+ double pvq_norm_lambda, int prev_k) {
+  int32_t x[OD_MAX_PVQ_SIZE];
+  int32_t y[OD_MAX_PVQ_SIZE];
+  int32_t rate[OD_MAX_PVQ_SIZE];
+  int64_t xx;
+  int32_t xy;
+  int32_t yy;
+  int32_t xmax;
+  int32_t l1_norm;
+  int ymax;
+  int shift;
+  int rshift;
+  int rdo_pulses;
+  double delta_rate;
+  double accel_rate;
+  int npad;
+  int i;
+  int j;
+  OD_ASSERT(n <= OD_MAX_PVQ_SIZE);
+  /*Keeps xy and yy within 30 bits.*/
+  OD_ASSERT(k < 32768);
+  npad = (n + 7) & ~7;
+  xx = 0;
+  xmax = 0;
+  l1_norm = 0;
+  for (j = 0; j < n; j++) {
+    x[j] = OD_MINI(abs(xcoeff[j]), 32767);
+    xx += x[j]*(int64_t)x[j];
+    xmax = OD_MAXI(xmax, x[j]);
+    l1_norm += x[j];
+  }
+  if (prev_k > 0 && prev_k <= k) {
+    /* We reuse pulses from a previous search so we don't have to search them
+       again. */
+    for (j = 0; j < n; j++) y[j] = abs(ypulse[j]);
+  }
+  else if (k > 2) {
+    double l1_inv;
+    l1_inv = 1./OD_MAXF(l1_norm, 1e-100);
+    for (j = 0; j < n; j++) y[j] = (int32_t)(k*(double)x[j]*l1_inv);
+  }
+  else OD_CLEAR(y, n);
+  xy = yy = 0;
+  ymax = 0;
+  i = 0;
+  for (j = 0; j < n; j++) {
+    xy += x[j]*y[j];
+    yy += y[j]*y[j];
+    ymax = OD_MAXI(ymax, y[j]);
+    i += y[j];
+    rate[j] = 0;
+  }
+  /*Pad to a multiple of 8 with positions whose cost is so low that they
+     never win over position 0.*/
+  for (j = n; j < npad; j++) {
+    x[j] = 0;
+    y[j] = 0;
+    rate[j] = 1 << 30;
+  }
+  rdo_pulses = 1 + k/4;
+  delta_rate = 3./n;
+  accel_rate = 0.;
+  if (k == 1) {
+    if (n == 15) {
+      accel_rate = -8./n;
+      delta_rate = 4.5/n - accel_rate;
+    }
+    else if (n == 8) {
+      accel_rate = 5.7/n;
+      delta_rate = 9.3/n - accel_rate;
+    }
+  }
+  /* Search one pulse at a time. The rsqrt factors fit in 17 bits, and the
+     shift keeps the costs within 30 bits. */
+  for (; i < k - rdo_pulses; i++) {
+    shift = OD_MAXI(0, OD_ILOG(xy + xmax) - 14);
+    rshift = 16 + ((OD_ILOG(yy + 1) - 1) >> 1);
+    j = od_pvq_search_pulse(vtbl, x, y, rate, xy, yy, ymax, shift, rshift,
+     npad);
+    xy += x[j];
+    yy += 2*y[j] + 1;
+    y[j]++;
+    ymax = OD_MAXI(ymax, y[j]);
+  }
+  if (i < k) {
+    double scale;
+    /* Search last pulses with RDO, maximizing
+       2*(xy + x[j])/sqrt(xx*(yy + 2*y[j] + 1)) - lambda*rate[j].
+       We fix the shifts for all of them and scale the rate term by
+       sqrt(xx)/2 to match the first term. */
+    shift = OD_MAXI(0, OD_ILOG(xy + (k - i)*xmax) - 14);
+    rshift = 16 + ((OD_ILOG(yy + 1) - 1) >> 1);
+    scale = pvq_norm_lambda/(1e-30 + g2)
+     *ldexp(sqrt((double)xx), rshift - shift - 1);
+    delta_rate *= scale;
+    accel_rate *= scale;
+    for (j = 0; j < n; j++) {
+      double r;
+      r = OD_CLAMPF(-(double)(1 << 30), j*(delta_rate + j*accel_rate),
+       (double)(1 << 30));
+      /*Round to nearest with a truncation of a non-negative value.*/
+      rate[j] = (int32_t)((int64_t)(r + ((1 << 30) + .5)) - (1 << 30));
+    }
+    for (; i < k; i++) {
+      j = od_pvq_search_pulse(vtbl, x, y, rate, xy, yy, ymax, shift, rshift,
+       npad);
+      xy += x[j];
+      yy += 2*y[j] + 1;
+      y[j]++;
+      ymax = OD_MAXI(ymax, y[j]);
+    }
+  }
+  for (j = 0; j < n; j++) ypulse[j] = xcoeff[j] < 0 ? -y[j] : y[j];
+  return xy/(1e-100 + sqrt((double)xx*yy));
+}
+
+#endif
+
+/*Runs the PVQ search at the precision of the build.*/
+static double pvq_search_rdo(const od_enc_opt_vtbl *vtbl,
+ const od_val16 *xcoeff, int n, int k, od_coeff *ypulse, double g2,
+ double pvq_norm_lambda, int prev_k) {
+#if defined(OD_FLOAT_PVQ)
+  (void)vtbl;
+  return pvq_search_rdo_double(xcoeff, n, k, ypulse, g2, pvq_norm_lambda,
+   prev_k);
+#else
+  return pvq_search_rdo_fixed(vtbl, xcoeff, n, k, ypulse, g2,
+   pvq_norm_lambda, prev_k);
+#endif
+}
+
 /** Encodes the gain so that the return value increases with the
  * distance |x-ref|, so that we can encode a zero when x=ref. The
  * value x=0 is not covered because it is only allowed in the noref
@@ -334,7 +630,8 @@ static int pvq_theta(od_coeff *out, const od_coeff *x0, const od_coeff *r0,
  int n, int q0, od_coeff *y, int *itheta, int *max_theta, int *vk,
  od_val16 beta, double *skip_diff, int nodesync, int is_keyframe, int pli,
  const od_adapt_ctx *adapt, const int16_t *qm,
- const int16_t *qm_inv, double pvq_norm_lambda, int speed) {
+ const int16_t *qm_inv, double pvq_norm_lambda, int speed,
+ const od_enc_opt_vtbl *vtbl) {
   od_val32 g;
   od_val32 gr;
   od_coeff y_tmp[MAXN];
@@ -539,7 +836,7 @@ static int pvq_theta(od_coeff *out, const od_coeff *x0, const od_coeff *r0,
         OD_CLEAR(y_tmp, n-1);
       }
       else if (k != prev_k) {
-        cos_dist = pvq_search_rdo_double(xr, n - 1, k, y_tmp,
+        cos_dist = pvq_search_rdo(vtbl, xr, n - 1, k, y_tmp,
          qcg*(double)cg*sin_prod*OD_CGAIN_SCALE_2, pvq_norm_lambda, prev_k);
       }
       prev_k = k;
@@ -586,7 +883,7 @@ static int pvq_theta(od_coeff *out, const od_coeff *x0, const od_coeff *r0,
       dist = gain_weight*(qcg - cg)*(qcg - cg);
       dist *= OD_CGAIN_SCALE_2;
       if (dist > dist0 && k != 0) continue;
-      cos_dist = pvq_search_rdo_double(x16, n, k, y_tmp,
+      cos_dist = pvq_search_rdo(vtbl, x16, n, k, y_tmp,
        qcg*(double)cg*OD_CGAIN_SCALE_2, pvq_norm_lambda, prev_k);
       prev_k = k;
       /* See Jmspeex' Journal of Dubious Theoretical Results. */
@@ -876,7 +1173,7 @@ int od_pvq_encode(daala_enc_ctx *enc,
      q, y + off[i], &theta[i], &max_theta[i],
      &k[i], beta[i], &skip_diff, nodesync, is_keyframe, pli,
      &enc->state.adapt, qm + off[i], qm_inv + off[i], enc->pvq_norm_lambda,
-     speed);
+     speed, &enc->opt_vtbl);
   }
   od_encode_checkpoint(enc, &buf);
   if (is_keyframe) out[0] = 0;
@@ -43,6 +43,10 @@ void od_encode_quantizer_scaling(daala_enc_ctx *enc, int q_scaling, int bx,
  int by, int skip);
 #endif
 
+int od_pvq_search_max_c(const int32_t *x, const int32_t *y,
+ const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+ int shift, int n);
+
 int od_pvq_encode(daala_enc_ctx *enc, od_coeff *ref, const od_coeff *in,
  od_coeff *out, int q0, int pli, int bs, const od_val16 *beta, int nodesync,
  int is_keyframe, int q_scaling, int bx, int by, const int16_t *qm,
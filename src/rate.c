@@ -433,6 +433,16 @@ static void od_enc_rc_reset(od_enc_ctx *enc) {
     the scale and exp values in OD_GOLDEN_P_FRAME.*/
   enc->rc.exp[OD_GOLDEN_P_FRAME] = enc->rc.exp[OD_P_FRAME];
   enc->rc.log_scale[OD_GOLDEN_P_FRAME] = enc->rc.log_scale[OD_P_FRAME];
+  if (enc->rc.frame_metrics != NULL) {
+    int i;
+    /*In pass 2, the pass 1 scale factors are only meaningful with the
+       exponents pass 1 used, and the scale followers track the correction to
+       them, which starts out at zero.*/
+    for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+      enc->rc.exp[i] = enc->rc.twopass_exp[i];
+      enc->rc.log_scale[i] = 0;
+    }
+  }
   /*We clamp the actual I and B frame delays to a minimum of 10 to work within
      the range of values where later incrementing the delay works as designed.
     10 is not an exact choice, but rather a good working trade-off.*/
@@ -556,8 +566,7 @@ int od_enc_rc_init(od_enc_ctx *enc, long bitrate) {
 }
 
 void od_enc_rc_clear(od_enc_ctx *enc) {
-  /*No-op until we get to two-pass support.*/
-  OD_UNUSED(enc);
+  free(enc->rc.frame_metrics);
 }
 
 /*Scale the number of frames by the number of expected drops/duplicates.*/
@@ -714,6 +723,176 @@ static int frame_type_count(od_enc_ctx *enc, int nframes[OD_FRAME_NSUBTYPES]) {
   return reservoir_frames;
 }
 
+/*The two-pass metrics stream starts with a summary header, followed by the
+   metrics of each frame in coding order.
+  All values are stored little-endian.
+  The summary header (OD_RC_2PASS_HDR_SZ bytes) contains:
+   4 bytes: OD_RC_2PASS_MAGIC.
+   4 bytes: OD_RC_2PASS_VERSION.
+   4 bytes per frame subtype: the number of frames of that subtype.
+   1 byte per frame subtype: the rate model exponent of that subtype.
+   8 bytes per frame subtype: the sum of the scale factors of that subtype in
+    Q24 format.
+  The metrics of each frame (OD_RC_2PASS_PACKET_SZ bytes) contain:
+   4 bytes: the number of bits the frame used in the low 30 bits, and its
+    subtype in the high 2 bits.
+   4 bytes: the log of the scale factor of the frame in Q24 format.*/
+#define OD_RC_2PASS_MAGIC (0x5032444F)
+#define OD_RC_2PASS_VERSION (1)
+
+static void od_rc_buffer_val(od_rc_state *rc, int64_t val, int bytes) {
+  while (bytes-- > 0) {
+    rc->twopass_buffer[rc->twopass_buffer_bytes++] =
+     (unsigned char)(val & 0xFF);
+    val >>= 8;
+  }
+}
+
+static uint64_t od_rc_unbuffer_val(const unsigned char *buf, int bytes) {
+  uint64_t ret;
+  ret = 0;
+  while (bytes-- > 0) ret = ret << 8 | buf[bytes];
+  return ret;
+}
+
+/*Appends data from buf to the two-pass buffer until it holds goal bytes.
+  Returns the updated number of bytes consumed from buf.*/
+static size_t od_rc_buffer_fill(od_rc_state *rc, const unsigned char *buf,
+ size_t bytes, size_t consumed, int goal) {
+  while (rc->twopass_buffer_bytes < goal && consumed < bytes) {
+    rc->twopass_buffer[rc->twopass_buffer_bytes++] = buf[consumed++];
+  }
+  return consumed;
+}
+
+/*The scale factor for a log_scale in Q24 format.
+  Unlike od_bexp64_q24(), this does not saturate: log scales are at most 16,
+   so the result fits in 41 bits, which leaves plenty of room for summing them
+   over a whole file.*/
+static int64_t od_rc_scale_q24(int32_t log_scale) {
+  return od_bexp64((int64_t)log_scale*((int64_t)1 << 33) + OD_Q57(24));
+}
+
+static void od_rc_2pass_push(od_rc_state *rc, const od_frame_metrics *m) {
+  OD_ASSERT(rc->nframe_metrics < rc->cframe_metrics);
+  rc->frame_metrics[(rc->frame_metrics_head + rc->nframe_metrics)%
+   rc->cframe_metrics] = *m;
+  rc->nframe_metrics++;
+  rc->scale_window[m->frame_subtype] += od_rc_scale_q24(m->log_scale);
+}
+
+static void od_rc_2pass_pop(od_rc_state *rc) {
+  od_frame_metrics *m;
+  if (rc->nframe_metrics <= 0) return;
+  m = rc->frame_metrics + rc->frame_metrics_head;
+  rc->scale_window[m->frame_subtype] -= od_rc_scale_q24(m->log_scale);
+  rc->frame_metrics_head = (rc->frame_metrics_head + 1)%rc->cframe_metrics;
+  rc->nframe_metrics--;
+}
+
+/*The number of frames whose metrics pass 2 still wants in its FIFO.
+  That is every frame in the reservoir window, up to the end of the file.*/
+static int od_rc_2pass_frames_needed(od_rc_state *rc) {
+  int64_t nframes_left;
+  int i;
+  nframes_left = -rc->frames_read;
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+    nframes_left += rc->frames_total[i];
+  }
+  return (int)OD_MAXI(OD_MINI(nframes_left,
+   (int64_t)(rc->reservoir_frame_delay - rc->nframe_metrics)), 0);
+}
+
+/*The log of the pass 2 scale correction for a frame subtype in Q57 format.
+  Golden P-frames are measured with the P-frame scale follower.*/
+static int64_t od_rc_2pass_log_corr(od_rc_state *rc, int frame_subtype) {
+  return rc->log_scale[frame_subtype == OD_GOLDEN_P_FRAME ?
+   OD_P_FRAME : frame_subtype];
+}
+
+/*Sets up the pass 2 rate model for the frames in the reservoir window.
+  nframes and log_scale are filled in so that the bits used by each subtype
+   are nframes[i]*e2(log_scale[i] + log_npixels - log_quantizer*exp[i]), as
+   in one-pass mode, but using the summed pass 1 scale factors of the frames
+   in the FIFO.
+  The pass 1 metrics of the current frame are made current, and the log of its
+   corrected scale factor is stored in log_cur_scale.
+  Return: The number of frames in the window.*/
+static int od_rc_2pass_window(od_rc_state *rc, int frame_subtype,
+ int nframes[OD_FRAME_NSUBTYPES], int64_t log_scale[OD_FRAME_NSUBTYPES],
+ int64_t *log_cur_scale) {
+  int64_t scale_window[OD_FRAME_NSUBTYPES];
+  int nwindow;
+  int i;
+  if (rc->nframe_metrics <= 0) {
+    od_frame_metrics m;
+    int64_t scale_sum;
+    int64_t frames_total;
+    /*We ran past the end of the pass 1 data, or the application did not give
+       it to us in time.
+      Make something up from the average scale of this frame subtype (or of
+       all frames, if pass 1 saw none of this subtype).*/
+    scale_sum = rc->scale_sum[frame_subtype];
+    frames_total = rc->frames_total[frame_subtype];
+    if (frames_total <= 0) {
+      scale_sum = frames_total = 0;
+      for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+        scale_sum += rc->scale_sum[i];
+        frames_total += rc->frames_total[i];
+      }
+    }
+    scale_sum /= OD_MAXI(frames_total, 1);
+    m.log_scale = scale_sum > 0 ?
+     od_q57_to_q24(od_blog64(scale_sum) - OD_Q57(24)) : -((int32_t)64 << 24);
+    /*There are no real pass 1 bits to correct the scale against.*/
+    m.bits = 0;
+    m.frame_subtype = frame_subtype;
+    od_rc_2pass_push(rc, &m);
+  }
+  rc->cur_metrics = rc->frame_metrics[rc->frame_metrics_head];
+  nwindow = rc->nframe_metrics;
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+    scale_window[i] = rc->scale_window[i];
+  }
+  if (nwindow > rc->reservoir_frame_delay) {
+    /*The reservoir was shrunk after we had already read further ahead, so
+       only sum over the part of the FIFO it covers.*/
+    nwindow = OD_MAXI(rc->reservoir_frame_delay, 1);
+    OD_CLEAR(scale_window, OD_FRAME_NSUBTYPES);
+    for (i = 0; i < nwindow; i++) {
+      od_frame_metrics *m;
+      m = rc->frame_metrics +
+       (rc->frame_metrics_head + i) % rc->cframe_metrics;
+      scale_window[m->frame_subtype] += od_rc_scale_q24(m->log_scale);
+    }
+  }
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+    if (scale_window[i] > 0) {
+      nframes[i] = 1;
+      log_scale[i] = od_blog64(scale_window[i]) - OD_Q57(24) +
+       od_rc_2pass_log_corr(rc, i);
+    }
+    else {
+      nframes[i] = 0;
+      log_scale[i] = 0;
+    }
+  }
+  *log_cur_scale = (int64_t)rc->cur_metrics.log_scale*((int64_t)1 << 33) +
+   od_rc_2pass_log_corr(rc, frame_subtype);
+  return nwindow;
+}
+
+/*Records the pass 1 metrics of the frame just encoded.*/
+static void od_rc_2pass_record(od_rc_state *rc, int64_t log_scale,
+ long bits, int frame_subtype) {
+  rc->cur_metrics.log_scale = od_q57_to_q24(log_scale);
+  rc->cur_metrics.bits = (int32_t)OD_CLAMPI(0, bits, 0x3FFFFFFF);
+  rc->cur_metrics.frame_subtype = frame_subtype;
+  rc->frames_total[frame_subtype]++;
+  rc->scale_sum[frame_subtype] += od_rc_scale_q24(rc->cur_metrics.log_scale);
+  rc->twopass_frame_pending = 1;
+}
+
 static int quality_to_quantizer(int quality) {
   /*A quality of -1 indicates the value is unset.
     A quality of 0 indicates a request for lossless.
@@ -838,7 +1017,9 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
   else {
     int clamp;
     int reservoir_frames;
-    int nframes[4];
+    int nframes[OD_FRAME_NSUBTYPES];
+    int64_t log_scale[OD_FRAME_NSUBTYPES];
+    int64_t log_cur_scale;
     int64_t rate_bias;
     int64_t rate_total;
     int base_quantizer;
@@ -851,23 +1032,34 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
     /*Figure out how to re-distribute bits so that we hit our fullness target
        before the last keyframe in our current buffer window (after the current
        frame), or the end of the buffer window, whichever comes first.*/
-    /*Single pass only right now.*/
-    /*Count the various types and classes of frames.*/
-    reservoir_frames = frame_type_count(enc, nframes);
-    /*Downgrade the delta frame rate to correspond to the recent drop count
-       history.
-      At the moment, drop frames can only be one frame type at a time:
-       B-frames only if B-frames are in use, otherwise P-frames only.
-      In the event this is extended later, the drop tracking watches all
-       frame types.*/
-    nframes[OD_I_FRAME] = od_rc_scale_drop(&enc->rc, OD_I_FRAME,
-     nframes[OD_I_FRAME]);
-    nframes[OD_P_FRAME] = od_rc_scale_drop(&enc->rc, OD_P_FRAME,
-     nframes[OD_P_FRAME]);
-    nframes[OD_B_FRAME] = od_rc_scale_drop(&enc->rc, OD_B_FRAME,
-     nframes[OD_B_FRAME]);
-    nframes[OD_GOLDEN_P_FRAME] = od_rc_scale_drop(&enc->rc, OD_GOLDEN_P_FRAME,
-     nframes[OD_GOLDEN_P_FRAME]);
+    if (enc->rc.frame_metrics != NULL) {
+      /*In pass 2, the pass 1 metrics tell us the type and relative size of
+         every frame in the window directly.*/
+      reservoir_frames = od_rc_2pass_window(&enc->rc, frame_subtype,
+       nframes, log_scale, &log_cur_scale);
+    }
+    else {
+      /*Count the various types and classes of frames.*/
+      reservoir_frames = frame_type_count(enc, nframes);
+      /*Downgrade the delta frame rate to correspond to the recent drop count
+         history.
+        At the moment, drop frames can only be one frame type at a time:
+         B-frames only if B-frames are in use, otherwise P-frames only.
+        In the event this is extended later, the drop tracking watches all
+         frame types.*/
+      nframes[OD_I_FRAME] = od_rc_scale_drop(&enc->rc, OD_I_FRAME,
+       nframes[OD_I_FRAME]);
+      nframes[OD_P_FRAME] = od_rc_scale_drop(&enc->rc, OD_P_FRAME,
+       nframes[OD_P_FRAME]);
+      nframes[OD_B_FRAME] = od_rc_scale_drop(&enc->rc, OD_B_FRAME,
+       nframes[OD_B_FRAME]);
+      nframes[OD_GOLDEN_P_FRAME] = od_rc_scale_drop(&enc->rc,
+       OD_GOLDEN_P_FRAME, nframes[OD_GOLDEN_P_FRAME]);
+      for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+        log_scale[i] = enc->rc.log_scale[i];
+      }
+      log_cur_scale = enc->rc.log_scale[frame_subtype];
+    }
     /*If we've been missing our target, add a penalty term.*/
     rate_bias = (enc->rc.rate_bias/(enc->state.cur_time + 1000))*
      reservoir_frames;
@@ -896,6 +1088,12 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
       qhi = quality_to_quantizer(enc->quality);
     else
       qhi = lossy_quantizer_max;
+    if (enc->rc.twopass_state == 1 && clamp) {
+      /*Pass 1 keeps the base quantizer it picked for the first frame, so that
+         errors in the rate model skew all of the scale factors it measures
+         the same way, and pass 2 can correct for them with a single ratio.*/
+      qlo = qhi = enc->rc.base_quantizer;
+    }
     base_quantizer = (qlo + qhi) >> 1;
     while (qlo < qhi) {
       int64_t log_base_quantizer;
@@ -927,7 +1125,7 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
          log_quantizer,
          od_blog64(lossy_quantizer_max));
         /* All the fields here are Q57 except for the exponent which is Q6.*/
-        bits += nframes[i]*od_bexp64(enc->rc.log_scale[i] +
+        bits += nframes[i]*od_bexp64(log_scale[i] +
          enc->rc.log_npixels - (log_quantizer >> 6)*enc->rc.exp[i]);
       }
       diff = bits - rate_total;
@@ -976,8 +1174,9 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
     /*The above allocation looks only at the total rate we'll accumulate in
        the next reservoir_frame_delay frames.
       However we could overflow the bit reservoir on the very next frame, so
-       check for that here if we're not using a soft target.*/
-    if (enc->rc.cap_overflow) {
+       check for that here if we're not using a soft target.
+      In pass 1, the reservoir does not matter.*/
+    if (enc->rc.cap_overflow && enc->rc.twopass_state != 1) {
       int64_t margin;
       int64_t soft_limit;
       int64_t log_soft_limit;
@@ -993,8 +1192,7 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
        (enc->rc.reservoir_max - margin);
       log_soft_limit = od_blog64(soft_limit);
       /*If we're predicting we won't use that many bits...*/
-      log_scale_pixels = enc->rc.log_scale[frame_subtype] +
-       enc->rc.log_npixels;
+      log_scale_pixels = log_cur_scale + enc->rc.log_npixels;
       exp = enc->rc.exp[frame_subtype];
       log_qexp = (log_quantizer >> 6)*exp;
       if (log_scale_pixels - log_qexp < log_soft_limit) {
@@ -1009,7 +1207,7 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
       Disabled when a quality bound is set; if we saturate quantizer to the
        maximum possible size when we have a limiting max quality, the
        resulting lambda can cause strange behavior.*/
-    if (enc->quality == -1) {
+    if (enc->quality == -1 && enc->rc.twopass_state != 1) {
       int64_t exp;
       int64_t log_qexp;
       int64_t log_scale_pixels;
@@ -1021,8 +1219,7 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
       log_hard_limit = od_blog64(enc->rc.reservoir_fullness +
        (enc->rc.bits_per_frame >> 1));
       /*If we're predicting we'll use more than this...*/
-      log_scale_pixels = enc->rc.log_scale[frame_subtype] +
-       enc->rc.log_npixels;
+      log_scale_pixels = log_cur_scale + enc->rc.log_npixels;
       exp = enc->rc.exp[frame_subtype];
       log_qexp = (log_quantizer >> 6)*exp;
       if (log_scale_pixels - log_qexp > log_hard_limit) {
@@ -1039,8 +1236,7 @@ void od_enc_rc_select_quantizers_and_lambdas(od_enc_ctx *enc,
     {
       int64_t log_qexp;
       int64_t log_scale_pixels;
-      log_scale_pixels = enc->rc.log_scale[frame_subtype] +
-       enc->rc.log_npixels;
+      log_scale_pixels = log_cur_scale + enc->rc.log_npixels;
       log_qexp = (log_quantizer >> 6)*enc->rc.exp[frame_subtype];
       enc->rc.rate_bias += od_bexp64(log_scale_pixels - log_qexp);
     }
@@ -1095,9 +1291,11 @@ int od_enc_rc_update_state(od_enc_ctx *enc, long bits,
   if (enc->rc.target_bitrate > 0) {
     int64_t log_scale;
     int frame_subtype;
+    long frame_bits;
     /*Track non-golden and golden P frame drops separately.*/
     frame_subtype = is_golden_frame && frame_type == OD_P_FRAME ?
      OD_GOLDEN_P_FRAME : frame_type;
+    frame_bits = bits;
     if (bits <= 0) {
       /*We didn't code any blocks in this frame.*/
       log_scale = OD_Q57(-64);
@@ -1114,6 +1312,13 @@ int od_enc_rc_update_state(od_enc_ctx *enc, long bits,
       log_qexp = (log_qexp >> 6)*(enc->rc.exp[frame_type]);
       log_scale = OD_MINI(log_bits - enc->rc.log_npixels + log_qexp,
        OD_Q57(16));
+      if (enc->rc.frame_metrics != NULL) {
+        /*In pass 2, the scale followers track the correction to the scale
+           measured in pass 1 instead (when there is one to correct).*/
+        log_scale = enc->rc.cur_metrics.bits > 0 ? log_scale -
+         (int64_t)enc->rc.cur_metrics.log_scale*((int64_t)1 << 33) :
+         enc->rc.log_scale[frame_type];
+      }
       /*If this is the first example of the given frame type we've
          seen, we immediately replace the default scale factor guess
          with the estimate we just computed using the first frame.*/
@@ -1147,9 +1352,10 @@ int od_enc_rc_update_state(od_enc_ctx *enc, long bits,
          od_iir_bessel2_update(enc->rc.scalefilter + frame_type,
          od_q57_to_q24(log_scale)) << 33;
       }
-      /*If this frame busts our budget, it must be dropped.*/
-      if (droppable && enc->rc.reservoir_fullness +
-       enc->rc.bits_per_frame < bits) {
+      /*If this frame busts our budget, it must be dropped (except in pass 1,
+         where we only want its statistics).*/
+      if (droppable && enc->rc.twopass_state != 1 &&
+       enc->rc.reservoir_fullness + enc->rc.bits_per_frame < bits) {
         ++enc->rc.prev_drop_count[frame_subtype];
         bits = 0;
         dropped = 1;
@@ -1178,6 +1384,12 @@ int od_enc_rc_update_state(od_enc_ctx *enc, long bits,
       if (enc->rc.frame_count[frame_type] < INT_MAX)
        ++enc->rc.frame_count[frame_type];
     }
+    if (enc->rc.twopass_state == 1) {
+      od_rc_2pass_record(&enc->rc, log_scale, frame_bits, frame_subtype);
+    }
+    else if (enc->rc.frame_metrics != NULL) {
+      od_rc_2pass_pop(&enc->rc);
+    }
     enc->rc.reservoir_fullness += enc->rc.bits_per_frame - bits;
     /*If we're too quick filling the buffer and overflow is capped,
       that rate is lost forever.*/
@@ -1197,24 +1409,154 @@ int od_enc_rc_update_state(od_enc_ctx *enc, long bits,
 }
 
 int od_enc_rc_2pass_out(od_enc_ctx *enc, unsigned char **buf) {
-  OD_UNUSED(enc);
-  OD_UNUSED(buf);
-  if (enc->rc.target_bitrate <= 0 ||
-   (enc->state.cur_time >=0 && enc->rc.twopass_state != 1)) {
+  od_rc_state *rc;
+  rc = &enc->rc;
+  if (rc->target_bitrate <= 0 || rc->twopass_state == 2 ||
+   (rc->twopass_state == 0 && enc->curr_coding_order > 0)) {
     return OD_EINVAL;
   }
-  /* Stub to establish API */
-  return OD_EIMPL;
+  rc->twopass_buffer_bytes = 0;
+  if (rc->twopass_state == 0) {
+    /*Enter pass 1.
+      The summary needs statistics from every frame, so for now we can only
+       return a placeholder for it.*/
+    rc->twopass_state = 1;
+    rc->twopass_frame_pending = 0;
+    OD_CLEAR(rc->frames_total, OD_FRAME_NSUBTYPES);
+    OD_CLEAR(rc->scale_sum, OD_FRAME_NSUBTYPES);
+    od_rc_buffer_val(rc, OD_RC_2PASS_MAGIC, 4);
+    od_rc_buffer_val(rc, OD_RC_2PASS_VERSION, 4);
+    while (rc->twopass_buffer_bytes < OD_RC_2PASS_HDR_SZ) {
+      od_rc_buffer_val(rc, 0, 1);
+    }
+  }
+  else if (rc->twopass_frame_pending) {
+    /*Output the metrics for the last frame encoded.*/
+    od_rc_buffer_val(rc, (uint32_t)rc->cur_metrics.bits |
+     (uint32_t)rc->cur_metrics.frame_subtype << 30, 4);
+    od_rc_buffer_val(rc, (uint32_t)rc->cur_metrics.log_scale, 4);
+    rc->twopass_frame_pending = 0;
+  }
+  else if (enc->input_queue.end_of_input && enc->input_queue.input_size == 0
+   && enc->input_queue.encode_size == 0) {
+    int i;
+    /*Every frame has been encoded: return the real summary.*/
+    od_rc_buffer_val(rc, OD_RC_2PASS_MAGIC, 4);
+    od_rc_buffer_val(rc, OD_RC_2PASS_VERSION, 4);
+    for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+      od_rc_buffer_val(rc, rc->frames_total[i], 4);
+    }
+    for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+      od_rc_buffer_val(rc, rc->exp[i], 1);
+    }
+    for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+      od_rc_buffer_val(rc, rc->scale_sum[i], 8);
+    }
+    OD_ASSERT(rc->twopass_buffer_bytes == OD_RC_2PASS_HDR_SZ);
+  }
+  *buf = rc->twopass_buffer;
+  return rc->twopass_buffer_bytes;
+}
+
+/*Parses the summary header in the two-pass buffer and sets up pass 2.*/
+static int od_rc_2pass_summary_in(od_enc_ctx *enc) {
+  od_rc_state *rc;
+  const unsigned char *p;
+  int32_t frames_total[OD_FRAME_NSUBTYPES];
+  unsigned exp[OD_FRAME_NSUBTYPES];
+  int64_t scale_sum[OD_FRAME_NSUBTYPES];
+  int64_t nframes;
+  int i;
+  rc = &enc->rc;
+  p = rc->twopass_buffer;
+  rc->twopass_buffer_bytes = 0;
+  if (od_rc_unbuffer_val(p, 4) != OD_RC_2PASS_MAGIC ||
+   od_rc_unbuffer_val(p + 4, 4) != OD_RC_2PASS_VERSION) {
+    return OD_ENOTFORMAT;
+  }
+  p += 8;
+  nframes = 0;
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++, p += 4) {
+    uint64_t val;
+    val = od_rc_unbuffer_val(p, 4);
+    if (val > 0x7FFFFFFF) return OD_EBADHEADER;
+    frames_total[i] = (int32_t)val;
+    nframes += val;
+  }
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++, p++) {
+    exp[i] = *p;
+    if (frames_total[i] > 0 && exp[i] == 0) return OD_EBADHEADER;
+  }
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++, p += 8) {
+    uint64_t val;
+    val = od_rc_unbuffer_val(p, 8);
+    if (val >> 63) return OD_EBADHEADER;
+    scale_sum[i] = (int64_t)val;
+  }
+  /*An aborted pass 1 leaves the placeholder, which has no frames.*/
+  if (nframes <= 0 || nframes > INT_MAX) return OD_EBADHEADER;
+  rc->frame_metrics =
+   (od_frame_metrics *)malloc((size_t)nframes*sizeof(*rc->frame_metrics));
+  if (OD_UNLIKELY(!rc->frame_metrics)) return OD_EFAULT;
+  rc->cframe_metrics = (int)nframes;
+  rc->frame_metrics_head = 0;
+  rc->nframe_metrics = 0;
+  rc->frames_read = 0;
+  OD_CLEAR(rc->scale_window, OD_FRAME_NSUBTYPES);
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+    rc->frames_total[i] = frames_total[i];
+    rc->scale_sum[i] = scale_sum[i];
+    rc->twopass_exp[i] = exp[i];
+  }
+  /*By default, the reservoir spans the whole file.*/
+  rc->reservoir_frame_delay = (int)nframes;
+  od_enc_rc_reset(enc);
+  return OD_SUCCESS;
 }
 
 int od_enc_rc_2pass_in(od_enc_ctx *enc, unsigned char *buf, size_t bytes) {
-  OD_UNUSED(enc);
-  OD_UNUSED(buf);
-  OD_UNUSED(bytes);
-  if(enc->rc.target_bitrate <=0 ||
-   (enc->state.cur_time >= 0 && enc->rc.twopass_state != 2)) {
+  od_rc_state *rc;
+  size_t consumed;
+  int needed;
+  rc = &enc->rc;
+  if (rc->target_bitrate <= 0 || rc->twopass_state == 1 ||
+   (rc->twopass_state == 0 && enc->curr_coding_order > 0)) {
     return OD_EINVAL;
   }
-  /* Stub to establish API */
-  return OD_EIMPL;
+  if (rc->twopass_state == 0) {
+    rc->twopass_state = 2;
+    rc->twopass_buffer_bytes = 0;
+  }
+  consumed = 0;
+  if (rc->frame_metrics == NULL) {
+    int ret;
+    if (buf == NULL) return OD_RC_2PASS_HDR_SZ - rc->twopass_buffer_bytes;
+    consumed = od_rc_buffer_fill(rc, buf, bytes, consumed,
+     OD_RC_2PASS_HDR_SZ);
+    if (rc->twopass_buffer_bytes < OD_RC_2PASS_HDR_SZ) return (int)consumed;
+    ret = od_rc_2pass_summary_in(enc);
+    if (ret < 0) return ret;
+  }
+  needed = od_rc_2pass_frames_needed(rc);
+  if (buf == NULL) {
+    return needed > 0 ?
+     needed*OD_RC_2PASS_PACKET_SZ - rc->twopass_buffer_bytes : 0;
+  }
+  while (needed > 0 && consumed < bytes) {
+    od_frame_metrics m;
+    uint32_t val;
+    consumed = od_rc_buffer_fill(rc, buf, bytes, consumed,
+     OD_RC_2PASS_PACKET_SZ);
+    if (rc->twopass_buffer_bytes < OD_RC_2PASS_PACKET_SZ) break;
+    rc->twopass_buffer_bytes = 0;
+    val = (uint32_t)od_rc_unbuffer_val(rc->twopass_buffer, 4);
+    m.bits = (int32_t)(val & 0x3FFFFFFF);
+    m.frame_subtype = (int)(val >> 30);
+    val = (uint32_t)od_rc_unbuffer_val(rc->twopass_buffer + 4, 4);
+    m.log_scale = (int32_t)((int64_t)val - ((int64_t)(val >> 31) << 32));
+    od_rc_2pass_push(rc, &m);
+    rc->frames_read++;
+    needed--;
+  }
+  return (int)consumed;
 }
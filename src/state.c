@@ -26,6 +26,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 # include "config.h"
 #endif
 
+#include <limits.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,6 +36,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 #if defined(OD_X86ASM)
 # include "x86/x86int.h"
 #endif
+#if defined(OD_ARMASM)
+# include "arm/armint.h"
+#endif
 #include "block_size.h"
 #include "dering.h"
 
@@ -248,7 +252,7 @@ static int od_state_ref_imgs_init(od_state *state, int nrefs) {
   int reference_bits;
   int imgi;
   int pli;
-  OD_ASSERT(nrefs == 4);
+  OD_ASSERT(nrefs == OD_NREF_IMGS);
   info = &state->info;
   data_sz = 0;
   /*Reference bit depth is constant over the lifetime of od_state, and by
@@ -299,7 +303,20 @@ static int od_state_ref_imgs_init(od_state *state, int nrefs) {
     }
   }
   /*Mark all of the reference image buffers available.*/
-  for (imgi = 0; imgi < nrefs; imgi++) state->ref_imgi[imgi] = -1;
+  for (imgi = 0; imgi < OD_FRAME_MAX + 1; imgi++) state->ref_imgi[imgi] = -1;
+  state->ref_rows = (od_progress *)malloc(sizeof(*state->ref_rows)*nrefs);
+  if (OD_UNLIKELY(!state->ref_rows)) {
+    return OD_EFAULT;
+  }
+  for (imgi = 0; imgi < nrefs; imgi++) {
+    if (OD_UNLIKELY(od_progress_init(state->ref_rows + imgi))) {
+      while (imgi-- > 0) od_progress_clear(state->ref_rows + imgi);
+      free(state->ref_rows);
+      state->ref_rows = NULL;
+      return OD_EFAULT;
+    }
+    od_progress_reset(state->ref_rows + imgi, INT_MAX);
+  }
   return OD_SUCCESS;
 }
 
@@ -338,14 +355,21 @@ void od_state_opt_vtbl_init_c(od_state *state) {
      OD_COPY_NXN_8_C, OD_LOG_COPYBSIZE_MAX + 1);
   }
   OD_COPY(&state->opt_vtbl.dering, &OD_DERING_VTBL_C, 1);
+  OD_COPY(&state->opt_vtbl.filter, &OD_FILTER_VTBL_C, 1);
   state->opt_vtbl.restore_fpu = od_restore_fpu_c;
   OD_COPY(state->opt_vtbl.fdct_2d, OD_FDCT_2D_C, OD_NBSIZES + 1);
   OD_COPY(state->opt_vtbl.idct_2d, OD_IDCT_2D_C, OD_NBSIZES + 1);
+  state->opt_vtbl.ref_buf_to_coeff8 = od_ref_buf_to_coeff8_c;
+  state->opt_vtbl.ref_buf_to_coeff16 = od_ref_buf_to_coeff16_c;
+  state->opt_vtbl.coeff_to_ref_buf8 = od_coeff_to_ref_buf8_c;
+  state->opt_vtbl.coeff_to_ref_buf16 = od_coeff_to_ref_buf16_c;
 }
 
 static void od_state_opt_vtbl_init(od_state *state) {
 #if defined(OD_X86ASM)
   od_state_opt_vtbl_init_x86(state);
+#elif defined(OD_NEON_INTRINSICS)
+  od_state_opt_vtbl_init_arm(state);
 #else
   od_state_opt_vtbl_init_c(state);
 #endif
@@ -371,7 +395,14 @@ static int od_state_init_impl(od_state *state, const daala_info *info) {
    && !info->full_precision_references) {
     return OD_EINVAL;
   }
+  if (info->tile_cols_log2 < 0 || info->tile_cols_log2 > OD_TILES_LOG2_MAX
+   || info->tile_rows_log2 < 0 || info->tile_rows_log2 > OD_TILES_LOG2_MAX) {
+    return OD_EINVAL;
+  }
   OD_COPY(&state->info, info, 1);
+  if (OD_UNLIKELY(od_thread_pool_init(&state->threads, 1))) {
+    return OD_EFAULT;
+  }
   /*Frame size is a multiple of a super block.*/
   state->frame_width = (info->pic_width + (OD_BSIZE_MAX - 1)) &
    ~(OD_BSIZE_MAX - 1);
@@ -380,7 +411,7 @@ static int od_state_init_impl(od_state *state, const daala_info *info) {
   state->nhmvbs = state->frame_width >> OD_LOG_MVBSIZE_MIN;
   state->nvmvbs = state->frame_height >> OD_LOG_MVBSIZE_MIN;
   od_state_opt_vtbl_init(state);
-  if (OD_UNLIKELY(od_state_ref_imgs_init(state, OD_FRAME_MAX + 1))) {
+  if (OD_UNLIKELY(od_state_ref_imgs_init(state, OD_NREF_IMGS))) {
     return OD_EFAULT;
   }
   if (OD_UNLIKELY(od_state_mvs_init(state))) {
@@ -388,6 +419,11 @@ static int od_state_init_impl(od_state *state, const daala_info *info) {
   }
   state->nhsb = state->frame_width >> OD_LOG_BSIZE_MAX;
   state->nvsb = state->frame_height >> OD_LOG_BSIZE_MAX;
+  state->ref_edge_ext = (unsigned char **)od_calloc_2d(OD_NREF_IMGS,
+   state->nvsb + 2, sizeof(**state->ref_edge_ext));
+  if (OD_UNLIKELY(!state->ref_edge_ext)) {
+    return OD_EFAULT;
+  }
   for (pli = 0; pli < nplanes; pli++) {
     int xdec;
     int ydec;
@@ -511,6 +547,14 @@ void od_state_clear(od_state *state) {
   }
 #endif
   od_free_2d(state->mv_grid);
+  if (state->ref_rows) {
+    int imgi;
+    for (imgi = 0; imgi < OD_NREF_IMGS; imgi++) {
+      od_progress_clear(state->ref_rows + imgi);
+    }
+    free(state->ref_rows);
+  }
+  od_free_2d(state->ref_edge_ext);
   od_aligned_free(state->ref_img_data);
   for (pli = 0; pli < state->info.nplanes; pli++) {
     free(state->sb_dc_mem[pli]);
@@ -530,6 +574,23 @@ void od_state_clear(od_state *state) {
   free(state->sb_q_scaling);
   free(state->qm);
   free(state->qm_inv);
+  od_thread_pool_clear(&state->threads);
+}
+
+/*Changes the number of threads (including the calling one) used by the
+   encoder or decoder.
+  If the new pool cannot be started, we fall back to a single thread.*/
+int od_state_set_threads(od_state *state, int nthreads) {
+  int ret;
+  if (nthreads < 1 || nthreads > OD_THREADS_MAX) return OD_EINVAL;
+  if (nthreads == state->threads.nthreads) return OD_SUCCESS;
+  od_thread_pool_clear(&state->threads);
+  ret = od_thread_pool_init(&state->threads, nthreads);
+  if (OD_UNLIKELY(ret < 0)) {
+    od_thread_pool_clear(&state->threads);
+    od_thread_pool_init(&state->threads, 1);
+  }
+  return ret;
 }
 
 void od_adapt_ctx_reset(od_adapt_ctx *state, int is_keyframe) {
@@ -624,7 +685,9 @@ const int *const OD_VERT_SETUP_DY[4][4] = {
   }
 };
 
-void od_state_pred_block_from_setup(od_state *state,
+/*Builds the prediction of a block from the current MV grid, using mc_buf as
+   scratch space for the four corner predictions.*/
+void od_state_pred_block_from_setup(od_state *state, unsigned char *mc_buf[4],
  unsigned char *buf, int ystride, int pli,
  int vx, int vy, int oc, int s, int log_mvb_sz) {
   daala_image_plane *iplane;
@@ -664,7 +727,7 @@ void od_state_pred_block_from_setup(od_state *state,
     y = vy << (OD_LOG_MVBSIZE_MIN - iplane->ydec);
     src[k] = iplane->data + y*iplane->ystride + x*iplane->xstride;
   }
-  od_mc_predict(state, buf, ystride, src,
+  od_mc_predict(state, mc_buf, buf, ystride, src,
    iplane->ystride, mvx, mvy, oc, s,
    log_mvb_sz + OD_LOG_MVBSIZE_MIN - iplane->xdec,
    log_mvb_sz + OD_LOG_MVBSIZE_MIN - iplane->ydec);
@@ -716,7 +779,7 @@ void od_state_pred_block(od_state *state,
       oc = 0;
       s = 3;
     }
-    od_state_pred_block_from_setup(state,
+    od_state_pred_block_from_setup(state, state->mc_buf,
      buf, ystride, pli, vx, vy, oc, s, log_mvb_sz);
   }
 }
@@ -929,6 +992,117 @@ int od_state_dump_img(od_state *state, daala_image *img, const char *tag) {
 }
 #endif
 
+/*Waits until the reference images hold every superblock row that the
+   prediction of the row of motion-vector blocks starting at vy can read.*/
+static void od_state_mc_wait_refs(od_state *state, int vy) {
+  od_mv_grid_pt **grid;
+  int dy;
+  int y;
+  int rows;
+  int vx;
+  int k;
+  grid = state->mv_grid;
+  dy = 0;
+  for (k = vy; k <= vy + OD_MVB_DELTA0; k++) {
+    for (vx = 0; vx <= state->nhmvbs; vx++) {
+      dy = OD_MAXI(dy, OD_MAXI(grid[k][vx].mv[1], grid[k][vx].mv1[1]));
+    }
+  }
+  /*The last luma row read, with some slack for the subpel filter (which is
+     twice as tall in luma units on decimated chroma planes).*/
+  y = ((vy + OD_MVB_DELTA0) << OD_LOG_MVBSIZE_MIN) + (dy >> 3)
+   + (OD_SUBPEL_FILTER_TAP_SIZE << 1);
+  rows = y >= state->frame_height ?
+   state->nvsb : (y >> OD_LOG_BSIZE_MAX) + 1;
+  for (k = OD_FRAME_GOLD; k <= OD_FRAME_NEXT; k++) {
+    if (state->ref_imgi[k] >= 0) {
+      od_progress_wait(state->ref_rows + state->ref_imgi[k], rows);
+    }
+  }
+}
+
+static void od_img_edge_ext_impl(daala_image *img, int y0, int y1,
+ int top, int bottom);
+
+/*Extends the borders of superblock row sby of reference image refi to the
+   left and right, if they are not already.*/
+static void od_state_mc_ext_sb_row(od_state *state, int refi, int sby) {
+  if (!state->ref_edge_ext[refi][sby + 1]) {
+    od_img_edge_ext_impl(state->ref_imgs + refi, sby << OD_LOG_BSIZE_MAX,
+     (sby + 1) << OD_LOG_BSIZE_MAX, 0, 0);
+    state->ref_edge_ext[refi][sby + 1] = 1;
+  }
+}
+
+/*Extends the borders of the reference images wherever the prediction of the
+   row of motion-vector blocks starting at vy can read them.
+  This must be called after od_state_mc_wait_refs(), which makes sure those
+   rows are final.
+  Each motion vector applies to the blocks around its grid point, which are
+   no larger than OD_MVB_DELTA0 grid cells, and only reads outside of them
+   (by the subpel filter apron) when it is not zero.*/
+static void od_state_mc_ext_refs(od_state *state, int vy) {
+  od_mv_grid_pt **grid;
+  int slack;
+  int xmin;
+  int xmax;
+  int ymin;
+  int ymax;
+  int vx;
+  int k;
+  grid = state->mv_grid;
+  slack = OD_SUBPEL_FILTER_TAP_SIZE << 1;
+  xmin = ymin = INT_MAX;
+  xmax = ymax = INT_MIN;
+  for (k = vy; k <= vy + OD_MVB_DELTA0; k++) {
+    for (vx = 0; vx <= state->nhmvbs; vx++) {
+      const int32_t *mv;
+      int x0;
+      int x1;
+      int i;
+      x0 = OD_MAXI(vx - OD_MVB_DELTA0, 0) << OD_LOG_MVBSIZE_MIN;
+      x1 = (OD_MINI(vx + OD_MVB_DELTA0, state->nhmvbs) << OD_LOG_MVBSIZE_MIN)
+       - 1;
+      for (i = 0; i < 2; i++) {
+        mv = i ? grid[k][vx].mv1 : grid[k][vx].mv;
+        xmin = OD_MINI(xmin, x0 + (mv[0] >> 3) - (mv[0] ? slack : 0));
+        xmax = OD_MAXI(xmax, x1 + (mv[0] >> 3) + (mv[0] ? slack : 0));
+        ymin = OD_MINI(ymin, (mv[1] >> 3) - (mv[1] ? slack : 0));
+        ymax = OD_MAXI(ymax, (mv[1] >> 3) + (mv[1] ? slack : 0));
+      }
+    }
+  }
+  ymin += vy << OD_LOG_MVBSIZE_MIN;
+  ymax += ((vy + OD_MVB_DELTA0) << OD_LOG_MVBSIZE_MIN) - 1;
+  for (k = OD_FRAME_GOLD; k <= OD_FRAME_NEXT; k++) {
+    daala_image *img;
+    unsigned char *ext;
+    int refi;
+    int sby;
+    refi = state->ref_imgi[k];
+    if (refi < 0) continue;
+    img = state->ref_imgs + refi;
+    ext = state->ref_edge_ext[refi];
+    if (xmin < 0 || xmax >= state->frame_width) {
+      for (sby = OD_MAXI(ymin, 0) >> OD_LOG_BSIZE_MAX;
+       sby <= OD_MINI(ymax, state->frame_height - 1) >> OD_LOG_BSIZE_MAX;
+       sby++) {
+        od_state_mc_ext_sb_row(state, refi, sby);
+      }
+    }
+    if (ymin < 0 && !ext[0]) {
+      od_state_mc_ext_sb_row(state, refi, 0);
+      od_img_edge_ext_impl(img, 0, 0, 1, 0);
+      ext[0] = 1;
+    }
+    if (ymax >= state->frame_height && !ext[state->nvsb + 1]) {
+      od_state_mc_ext_sb_row(state, refi, state->nvsb - 1);
+      od_img_edge_ext_impl(img, 0, 0, 0, 1);
+      ext[state->nvsb + 1] = 1;
+    }
+  }
+}
+
 void od_state_mc_predict(od_state *state, daala_image *img_dst) {
   int nhmvbs;
   int nvmvbs;
@@ -938,6 +1112,8 @@ void od_state_mc_predict(od_state *state, daala_image *img_dst) {
   nhmvbs = state->nhmvbs;
   nvmvbs = state->nvmvbs;
   for (vy = 0; vy < nvmvbs; vy += OD_MVB_DELTA0) {
+    od_state_mc_wait_refs(state, vy);
+    if (state->lazy_edge_ext) od_state_mc_ext_refs(state, vy);
     for (vx = 0; vx < nhmvbs; vx += OD_MVB_DELTA0) {
       for (pli = 0; pli < img_dst->nplanes; pli++) {
         daala_image_plane *iplane_dst;
@@ -973,6 +1149,127 @@ void od_state_init_superblock_split(od_state *state, unsigned char bsize) {
   }
 }
 
+/*Computes the superblocks [sbx0, sbx1) x [sby0, sby1) covered by a tile.
+  Tiles are numbered in raster order and split the superblocks as evenly as
+   possible, so a tile may be empty when the grid is finer than the frame.*/
+void od_state_tile_bounds(const od_state *state, int tile,
+ int *sbx0, int *sby0, int *sbx1, int *sby1) {
+  int cols_log2;
+  int rows_log2;
+  int tx;
+  int ty;
+  cols_log2 = state->info.tile_cols_log2;
+  rows_log2 = state->info.tile_rows_log2;
+  tx = tile & ((1 << cols_log2) - 1);
+  ty = tile >> cols_log2;
+  *sbx0 = (tx*state->nhsb) >> cols_log2;
+  *sbx1 = ((tx + 1)*state->nhsb) >> cols_log2;
+  *sby0 = (ty*state->nvsb) >> rows_log2;
+  *sby1 = ((ty + 1)*state->nvsb) >> rows_log2;
+}
+
+/*Everything needed to filter the superblock edges of several planes in
+   parallel.*/
+struct od_filter_planes_ctx {
+  od_state *state;
+  od_coeff **c;
+  unsigned char **skip;
+  int q;
+  int postfilter;
+  /*Whether to filter the horizontal edges (in strips of superblock columns)
+     or the vertical ones (in strips of superblock rows).*/
+  int hedges;
+  int nstrips;
+};
+typedef struct od_filter_planes_ctx od_filter_planes_ctx;
+
+static void od_filter_planes_job(void *ctx, int idx) {
+  od_filter_planes_ctx *fctx;
+  od_state *state;
+  int strip;
+  int pli;
+  int xdec;
+  int ydec;
+  int w;
+  int n;
+  int s0;
+  int s1;
+  fctx = (od_filter_planes_ctx *)ctx;
+  state = fctx->state;
+  pli = idx/fctx->nstrips;
+  strip = idx%fctx->nstrips;
+  xdec = state->info.plane_info[pli].xdec;
+  ydec = state->info.plane_info[pli].ydec;
+  w = state->frame_width >> xdec;
+  n = fctx->hedges ? state->nhsb : state->nvsb;
+  s0 = strip*n/fctx->nstrips;
+  s1 = (strip + 1)*n/fctx->nstrips;
+  if (fctx->postfilter) {
+    if (fctx->hedges) {
+      od_apply_postfilter_frame_hedges(&state->opt_vtbl.filter, fctx->c[pli],
+       w, s0, s1, state->nvsb, xdec, ydec, fctx->q, fctx->skip[pli],
+       state->skip_stride);
+    }
+    else {
+      od_apply_postfilter_frame_vedges(&state->opt_vtbl.filter, fctx->c[pli],
+       w, state->nhsb, s0, s1, xdec, ydec, fctx->q, fctx->skip[pli],
+       state->skip_stride);
+    }
+  }
+  else {
+    if (fctx->hedges) {
+      od_apply_prefilter_frame_hedges(&state->opt_vtbl.filter, fctx->c[pli],
+       w, s0, s1, state->nvsb, xdec, ydec);
+    }
+    else {
+      od_apply_prefilter_frame_vedges(&state->opt_vtbl.filter, fctx->c[pli],
+       w, state->nhsb, s0, s1, xdec, ydec);
+    }
+  }
+}
+
+/*Filters one direction of superblock edges of every plane at once, split into
+   one strip per thread.*/
+static void od_filter_planes(od_filter_planes_ctx *fctx, int nplanes,
+ int hedges) {
+  od_state *state;
+  state = fctx->state;
+  fctx->hedges = hedges;
+  fctx->nstrips = OD_MINI(state->threads.nthreads,
+   hedges ? state->nhsb : state->nvsb);
+  od_thread_pool_run(&state->threads, od_filter_planes_job, fctx,
+   nplanes*fctx->nstrips);
+}
+
+/*Applies the lapping prefilter across the superblock edges of the first
+   nplanes planes of c, using the worker threads.
+  This is equivalent to od_apply_prefilter_frame_sbs() on each plane.*/
+void od_state_prefilter_planes(od_state *state, od_coeff **c, int nplanes) {
+  od_filter_planes_ctx fctx;
+  fctx.state = state;
+  fctx.c = c;
+  fctx.skip = NULL;
+  fctx.q = 0;
+  fctx.postfilter = 0;
+  od_filter_planes(&fctx, nplanes, 1);
+  od_filter_planes(&fctx, nplanes, 0);
+}
+
+/*Applies the lapping postfilter (or deblocking filter) across the superblock
+   edges of the first nplanes planes of c, using the worker threads.
+  This is equivalent to od_apply_postfilter_frame_sbs() on each plane.*/
+void od_state_postfilter_planes(od_state *state, od_coeff **c, int nplanes,
+ int q, unsigned char **skip) {
+  od_filter_planes_ctx fctx;
+  fctx.state = state;
+  fctx.c = c;
+  fctx.skip = skip;
+  fctx.q = q;
+  fctx.postfilter = 1;
+  od_filter_planes(&fctx, nplanes, 0);
+  od_filter_planes(&fctx, nplanes, 1);
+}
+
 /*To avoiding having to special-case superblocks on the edges of the image,
    one superblock of padding is maintained on each side of the image.
   These "dummy" superblocks are notionally not subdivided.
@@ -1032,17 +1329,33 @@ double daala_granule_time(void *encdec, int64_t granpos) {
   return -1;
 }
 
+/*Fills n 16-bit pixels at dst with copies of the one at src.
+  This is simple enough for the compiler to turn into broadcast stores.*/
+static void od_fill_pixels16(unsigned char *dst, const unsigned char *src,
+ int n) {
+  int16_t *dst16;
+  int16_t v;
+  int x;
+  dst16 = (int16_t *)dst;
+  v = *(const int16_t *)src;
+  for (x = 0; x < n; x++) dst16[x] = v;
+}
+
 /*Extend the edge into the padding.*/
 /*This is used on internal and thus planar buffers only.
   We can assume depth == 8 implies xstride == 1 and depth > 8 implies
-   xstride == 2.*/
+   xstride == 2.
+  Only rows [y0, y1) are extended to the left and right, along with the top
+   (bottom) padding if top (bottom) is set, which needs the first (last) row
+   to be extended already or included in [y0, y1).*/
 static void od_img_plane_edge_ext(daala_image_plane *dst_p,
- int plane_width, int plane_height, int horz_padding, int vert_padding) {
+ int plane_width, int plane_height, int horz_padding, int vert_padding,
+ int y0, int y1, int top, int bottom) {
   ptrdiff_t xstride;
   ptrdiff_t ystride;
   unsigned char *dst_data;
   unsigned char *dst;
-  int x;
+  size_t row_sz;
   int y;
   xstride = dst_p->xstride;
   ystride = dst_p->ystride;
@@ -1051,67 +1364,65 @@ static void od_img_plane_edge_ext(daala_image_plane *dst_p,
   OD_ASSERT((horz_padding&1) == 0);
   OD_ASSERT((xstride == 1 && dst_p->bitdepth == 8)
    || (xstride == 2 && dst_p->bitdepth > 8));
-  /*Left side.*/
-  for (y = 0; y < plane_height; y++) {
+  /*Left and right sides.*/
+  for (y = y0; y < y1; y++) {
     dst = dst_data + ystride*y;
-    if(xstride == 1){
-      for (x = 1; x <= horz_padding; x++) {
-        (dst - x)[0] = dst[0];
-      }
+    if (xstride == 1) {
+      memset(dst - horz_padding, dst[0], horz_padding);
+      memset(dst + plane_width, dst[plane_width - 1], horz_padding);
     }
     else {
-      for (x = 1; x <= horz_padding; x++) {
-        (dst - (x << 1))[0] = dst[0];
-        (dst - (x << 1))[1] = dst[1];
-      }
-    }
-  }
-  /*Right side.*/
-  for (y = 0; y < plane_height; y++) {
-    dst = dst_data + ystride*y + xstride*(plane_width - 1);
-    if(xstride == 1){
-      for (x = 1; x <= horz_padding; x++) {
-        dst[x] = dst[0];
-      }
-    }
-    else {
-      for (x = 1; x <= horz_padding; x++) {
-        (dst + (x << 1))[0] = dst[0];
-        (dst + (x << 1))[1] = dst[1];
-      }
+      od_fill_pixels16(dst - (horz_padding << 1), dst, horz_padding);
+      od_fill_pixels16(dst + (plane_width << 1),
+       dst + ((plane_width - 1) << 1), horz_padding);
     }
   }
+  row_sz = (plane_width + 2*horz_padding)*xstride;
   /*Top.*/
-  dst = dst_data - horz_padding*xstride;
-  for (y = 0; y < vert_padding; y++) {
-    for (x = 0; x < (plane_width + 2*horz_padding)*xstride; x++) {
-      (dst - ystride)[x] = dst[x];
+  if (top) {
+    dst = dst_data - horz_padding*xstride;
+    for (y = 1; y <= vert_padding; y++) {
+      memcpy(dst - ystride*y, dst, row_sz);
     }
-    dst -= ystride;
   }
   /*Bottom.*/
-  dst = dst_data - horz_padding*xstride + plane_height*ystride;
-  for (y = 0; y < vert_padding; y++) {
-    for (x = 0; x < (plane_width + 2*horz_padding)*xstride; x++) {
-      dst[x] = (dst - ystride)[x];
+  if (bottom) {
+    dst = dst_data - horz_padding*xstride + (plane_height - 1)*ystride;
+    for (y = 1; y <= vert_padding; y++) {
+      memcpy(dst + ystride*y, dst, row_sz);
     }
-    dst += ystride;
   }
 }
 
-void od_img_edge_ext(daala_image* src) {
+/*Extends the edges of the luma rows [y0, y1) (and the matching chroma rows)
+   to the left and right, and the top and bottom edges if requested.*/
+static void od_img_edge_ext_impl(daala_image *img, int y0, int y1,
+ int top, int bottom) {
   int pli;
-  for (pli = 0; pli < src->nplanes; pli++) {
+  for (pli = 0; pli < img->nplanes; pli++) {
     int xdec;
     int ydec;
-    xdec = (src->planes + pli)->xdec;
-    ydec = (src->planes + pli)->ydec;
-    od_img_plane_edge_ext(&src->planes[pli],
-     src->width >> xdec, src->height >> ydec,
-     OD_BUFFER_PADDING >> xdec, OD_BUFFER_PADDING >> ydec);
+    xdec = (img->planes + pli)->xdec;
+    ydec = (img->planes + pli)->ydec;
+    od_img_plane_edge_ext(&img->planes[pli],
+     img->width >> xdec, img->height >> ydec,
+     OD_BUFFER_PADDING >> xdec, OD_BUFFER_PADDING >> ydec,
+     y0 >> ydec, y1 >> ydec, top, bottom);
   }
 }
 
+void od_img_edge_ext(daala_image* src) {
+  od_img_edge_ext_rows(src, 0, src->height);
+}
+
+/*Extends the edges of the luma rows [y0, y1) (and the matching chroma rows)
+   into the padding, so that the image can be used for prediction as soon as
+   those rows are final.
+  y0 and y1 must be multiples of the chroma decimation.*/
+void od_img_edge_ext_rows(daala_image *img, int y0, int y1) {
+  od_img_edge_ext_impl(img, y0, y1, y0 == 0, y1 == img->height);
+}
+
 int od_output_queue_init(od_output_queue *out, od_state *state) {
   daala_info *info;
   int pli;
@@ -1170,9 +1481,11 @@ int od_output_queue_init(od_output_queue *out, od_state *state) {
 
 void od_output_queue_clear(od_output_queue *out) {
   od_aligned_free(out->output_img_data);
+  out->output_img_data = NULL;
 }
 
-int od_output_queue_add(od_output_queue *out, daala_image *img, int number) {
+static int od_output_queue_insert(od_output_queue *out, daala_image *img,
+ int number, void *ref) {
   od_output_frame frame;
   int index;
   OD_RETURN_CHECK(out, OD_EFAULT);
@@ -1182,11 +1495,13 @@ int od_output_queue_add(od_output_queue *out, daala_image *img, int number) {
   index = out->decode_index;
   OD_ASSERT(!out->decode_used[index]);
   out->decode_used[index] = 1;
-  od_img_copy(&out->images[index], img);
+  if (ref != NULL) out->images[index] = *img;
+  else od_img_copy(&out->images[index], img);
   out->decode_index = OD_REORDER_INDEX(index + 1);
   /* Construct the od_output_frame struct. */
   frame.img = &out->images[index];
   frame.number = number;
+  frame.ref = ref;
   /* Insert it into the output queue in the correct order. */
   index = OD_REORDER_INDEX(number);
   OD_ASSERT(!out->output_used[index]);
@@ -1195,6 +1510,19 @@ int od_output_queue_add(od_output_queue *out, daala_image *img, int number) {
   return OD_SUCCESS;
 }
 
+int od_output_queue_add(od_output_queue *out, daala_image *img, int number) {
+  return od_output_queue_insert(out, img, number, NULL);
+}
+
+/*Adds img to the queue without copying its pixels.
+  The caller must keep them unchanged until the frame is taken out again,
+   and uses ref to tell which buffer that frame was in.*/
+int od_output_queue_add_ref(od_output_queue *out, daala_image *img,
+ int number, void *ref) {
+  OD_RETURN_CHECK(ref, OD_EFAULT);
+  return od_output_queue_insert(out, img, number, ref);
+}
+
 od_output_frame *od_output_queue_next(od_output_queue *out) {
   OD_ASSERT(out);
   if (out->output_used[out->output_index]) {
@@ -1211,14 +1539,41 @@ od_output_frame *od_output_queue_next(od_output_queue *out) {
   return NULL;
 }
 
+/*Converts a block of 8-bit reference pixels to coefficients.*/
+void od_ref_buf_to_coeff8_c(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  int x;
+  int y;
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w; x++) {
+      dst[x] = (src[x] - 128)*(1 << coeff_shift);
+    }
+    dst += dst_ystride;
+    src += src_ystride;
+  }
+}
+
+/*Converts a block of 16-bit (FPR) reference pixels to coefficients.*/
+void od_ref_buf_to_coeff16_c(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  int x;
+  int y;
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w; x++) {
+      dst[x] = (((const int16_t *)src)[x] - (1 << (8 + OD_COEFF_SHIFT) >> 1)
+       + (1 << coeff_shift >> 1)) >> coeff_shift;
+    }
+    dst += dst_ystride;
+    src += src_ystride;
+  }
+}
+
 /*General purpose reference daala_image block to coefficient block
   conversion routine.*/
 void od_ref_buf_to_coeff(od_state *state,
  od_coeff *dst, int dst_ystride, int lossless_p,
  unsigned char *src, int src_xstride, int src_ystride,
  int w, int h) {
-  int x;
-  int y;
   int coeff_shift;
   OD_ASSERT(src_xstride == 1 || src_xstride == 2);
   if (src_xstride == 1) {
@@ -1228,13 +1583,8 @@ void od_ref_buf_to_coeff(od_state *state,
     coeff_shift = lossless_p ?
      (state->info.bitdepth_mode - OD_BITDEPTH_MODE_8)*2 :
      OD_COEFF_SHIFT;
-    for (y = 0; y < h; y++) {
-      for (x = 0; x < w; x++) {
-        dst[x] = (src[x] - 128)*(1 << coeff_shift);
-      }
-      dst += dst_ystride;
-      src += src_ystride;
-    }
+    (*state->opt_vtbl.ref_buf_to_coeff8)(dst, dst_ystride,
+     src, src_ystride, coeff_shift, w, h);
   }
   else {
     /*The references are running at greater than 8 bits, implying FPR.
@@ -1243,14 +1593,8 @@ void od_ref_buf_to_coeff(od_state *state,
     coeff_shift = lossless_p ?
      OD_COEFF_SHIFT - (state->info.bitdepth_mode - OD_BITDEPTH_MODE_8)*2 :
      0;
-    for (y = 0; y < h; y++) {
-      for (x = 0; x < w; x++) {
-        dst[x] = (((int16_t *)src)[x] - (1 << (8 + OD_COEFF_SHIFT) >> 1)
-         + (1 << coeff_shift >> 1)) >> coeff_shift;
-      }
-      dst += dst_ystride;
-      src += src_ystride;
-    }
+    (*state->opt_vtbl.ref_buf_to_coeff16)(dst, dst_ystride,
+     src, src_ystride, coeff_shift, w, h);
   }
 }
 
@@ -1276,14 +1620,42 @@ void od_ref_plane_to_coeff(od_state *state, od_coeff *dst, int lossless_p,
    iplane->data, src_xstride, src_ystride, w, h);
 }
 
+/*Converts a block of coefficients to 8-bit reference pixels.*/
+void od_coeff_to_ref_buf8_c(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h) {
+  int x;
+  int y;
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w; x++) {
+      *(dst + x) =
+       OD_CLAMP255(((src[x] + (1 << coeff_shift >> 1)) >> coeff_shift) + 128);
+    }
+    dst += dst_ystride;
+    src += src_ystride;
+  }
+}
+
+/*Converts a block of coefficients to 16-bit (FPR) reference pixels.*/
+void od_coeff_to_ref_buf16_c(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h) {
+  int x;
+  int y;
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w; x++) {
+      ((int16_t *)dst)[x] =
+        OD_CLAMPFPR(src[x]*(1 << coeff_shift) + (128 << OD_COEFF_SHIFT));
+    }
+    dst += dst_ystride;
+    src += src_ystride;
+  }
+}
+
 /*General purpose coefficient block to reference daala_image block
   conversion routine.*/
 void od_coeff_to_ref_buf(od_state *state,
  unsigned char *dst, int dst_xstride, int dst_ystride,
  od_coeff *src, int src_ystride, int lossless_p,
  int w, int h) {
-  int x;
-  int y;
   int coeff_shift;
   OD_ASSERT(dst_xstride == 1 || dst_xstride == 2);
   if (dst_xstride == 1) {
@@ -1293,15 +1665,8 @@ void od_coeff_to_ref_buf(od_state *state,
     coeff_shift = lossless_p ?
      (state->info.bitdepth_mode - OD_BITDEPTH_MODE_8)*2 :
      OD_COEFF_SHIFT;
-    for (y = 0; y < h; y++) {
-      for (x = 0; x < w; x++) {
-        *(dst + x) =
-         OD_CLAMP255(((src[x] + (1 << coeff_shift >> 1)) >> coeff_shift) +
-         128);
-      }
-      dst += dst_ystride;
-      src += src_ystride;
-    }
+    (*state->opt_vtbl.coeff_to_ref_buf8)(dst, dst_ystride,
+     src, src_ystride, coeff_shift, w, h);
   }
   else {
     /*The references are running at greater than 8 bits, implying FPR.
@@ -1311,14 +1676,8 @@ void od_coeff_to_ref_buf(od_state *state,
     coeff_shift = lossless_p
      ? OD_COEFF_SHIFT - (state->info.bitdepth_mode - OD_BITDEPTH_MODE_8)*2
      : 0;
-    for (y = 0; y < h; y++) {
-      for (x = 0; x < w; x++) {
-        ((int16_t *)dst)[x] =
-          OD_CLAMPFPR(src[x]*(1 << coeff_shift) + (128 << OD_COEFF_SHIFT));
-      }
-      dst += dst_ystride;
-      src += src_ystride;
-    }
+    (*state->opt_vtbl.coeff_to_ref_buf16)(dst, dst_ystride,
+     src, src_ystride, coeff_shift, w, h);
   }
 }
 
@@ -40,6 +40,7 @@ typedef struct od_adapt_ctx      od_adapt_ctx;
 # include "generic_code.h"
 # include "util.h"
 # include "intra.h"
+# include "threadpool.h"
 
 extern const od_coeff OD_DC_QM[OD_NBSIZES - 1][2];
 
@@ -50,6 +51,12 @@ extern const int OD_HAAR_QM[2][OD_LOG_BSIZE_MAX];
 
 #define OD_MAX_CODED_REFS (2)
 
+/*The tile grid may have at most 1 << OD_TILES_LOG2_MAX columns and rows.*/
+# define OD_TILES_LOG2_MAX (3)
+# define OD_TILES_MAX (1 << 2*OD_TILES_LOG2_MAX)
+/*The number of independently coded tiles in each frame.*/
+# define OD_NTILES(info) (1 << ((info)->tile_cols_log2 + (info)->tile_rows_log2))
+
 /*The golden reference frame.*/
 # define OD_FRAME_GOLD (0)
 /*The previous reference frame.*/
@@ -61,6 +68,12 @@ extern const int OD_HAAR_QM[2][OD_LOG_BSIZE_MAX];
 
 # define OD_FRAME_MAX  (3)
 
+/*The number of reference image buffers.
+  There is one more than the number of roles above so that the decoder can
+   still be finishing a frame that no role refers to anymore (e.g., a B frame)
+   while it starts decoding the next one.*/
+# define OD_NREF_IMGS (OD_FRAME_MAX + 2)
+
 /*Frame types.*/
 # define OD_I_FRAME (0)
 # define OD_P_FRAME (1)
@@ -108,6 +121,11 @@ extern const int *const OD_VERT_SETUP_DY[4][4];
  ((OD_UMV_CLAMP + OD_RESAMPLE_PADDING + OD_PADDING_ALIGN - 1) \
  /OD_PADDING_ALIGN*OD_PADDING_ALIGN)
 
+typedef void (*od_ref_buf_to_coeff_func)(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+typedef void (*od_coeff_to_ref_buf_func)(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
+
 /*The shared (encoder and decoder) functions that have accelerated variants.*/
 struct od_state_opt_vtbl{
   void (*mc_predict1fmv)(od_state *state, unsigned char *_dst,
@@ -124,10 +142,15 @@ struct od_state_opt_vtbl{
    const unsigned char *_src[4], int _c, int _s,
    int _log_xblk_sz, int _log_yblk_sz);
   struct od_dering_opt_vtbl dering;
+  struct od_filter_opt_vtbl filter;
   void (*restore_fpu)(void);
   od_dct_func_2d fdct_2d[OD_NBSIZES + 1];
   od_dct_func_2d idct_2d[OD_NBSIZES + 1];
   od_copy_nxn_func od_copy_nxn[OD_LOG_COPYBSIZE_MAX + 1];
+  od_ref_buf_to_coeff_func ref_buf_to_coeff8;
+  od_ref_buf_to_coeff_func ref_buf_to_coeff16;
+  od_coeff_to_ref_buf_func coeff_to_ref_buf8;
+  od_coeff_to_ref_buf_func coeff_to_ref_buf16;
 };
 
 # if defined(OD_DUMP_IMAGES) || defined(OD_DUMP_RECONS)
@@ -179,6 +202,9 @@ typedef struct od_output_frame od_output_frame;
 struct od_output_frame {
   daala_image *img;
   int number;
+  /*The owner of the pixels for frames added by od_output_queue_add_ref(),
+     or NULL.*/
+  void *ref;
 };
 
 typedef struct od_output_queue od_output_queue;
@@ -200,6 +226,8 @@ struct od_output_queue {
 int od_output_queue_init(od_output_queue *out, od_state *state);
 void od_output_queue_clear(od_output_queue *out);
 int od_output_queue_add(od_output_queue *out, daala_image *img, int number);
+int od_output_queue_add_ref(od_output_queue *out, daala_image *img,
+ int number, void *ref);
 #define od_output_queue_has_next(out) \
  ((out)->output_used[(out)->output_index])
 od_output_frame *od_output_queue_next(od_output_queue *out);
@@ -216,7 +244,22 @@ struct od_state{
   int                 ref_imgi[OD_FRAME_MAX+1];
   /** Pointers to the ref images so one can move them around without coping
       them. */
-  daala_image         ref_imgs[OD_FRAME_MAX+1];
+  daala_image         ref_imgs[OD_NREF_IMGS];
+  /** The number of superblock rows of each reference image that are ready to
+      be used for prediction, borders included (unless lazy_edge_ext is
+      set).
+      The decoder finishes frames on its worker threads and resets this when
+       it starts one; otherwise it stays at INT_MAX. */
+  od_progress        *ref_rows;
+  /** Whether the decoder leaves the borders of its reference images to
+      od_state_mc_predict(), which only extends them where the motion
+      vectors of the frame being predicted can read them. */
+  int                 lazy_edge_ext;
+  /** For each reference image, whether the left and right borders of each
+      superblock row are extended (entries 1 to nvsb), along with the top
+      (entry 0) and bottom (entry nvsb + 1) borders.
+      Only used with lazy_edge_ext. */
+  unsigned char     **ref_edge_ext;
   /* ----------------------------------------------------- */
   /** I,P,B frame type of current frame. */
   int frame_type;
@@ -287,26 +330,36 @@ struct od_state{
    assuming 2 possible decimation values (see OD_BASIS_MAG).*/
   int16_t *qm;
   int16_t *qm_inv;
+  /*Worker threads shared by the encoder and decoder stages.*/
+  od_thread_pool threads;
 };
 
 void *od_aligned_malloc(size_t _sz,size_t _align);
 void od_aligned_free(void *_ptr);
 int od_state_init(od_state *_state, const daala_info *_info);
 void od_state_clear(od_state *_state);
+int od_state_set_threads(od_state *_state, int _nthreads);
 
 void od_img_plane_copy(daala_image *dest, daala_image *src, int pli);
 void od_img_copy(daala_image *dest, daala_image *src);
 void od_adapt_ctx_reset(od_adapt_ctx *state, int is_keyframe);
 void od_state_set_mv_res(od_state *state, int mv_res);
-void od_state_pred_block_from_setup(od_state *state, unsigned char *buf,
- int ystride, int pli, int vx, int vy, int c, int s, int log_mvb_sz);
+void od_state_pred_block_from_setup(od_state *state, unsigned char *mc_buf[4],
+ unsigned char *buf, int ystride, int pli, int vx, int vy, int c, int s,
+ int log_mvb_sz);
 void od_state_pred_block(od_state *state, unsigned char *buf,
  int ystride, int xstride, int pli, int vx, int vy, int log_mvb_sz);
 void od_state_mc_predict(od_state *state, daala_image *dst);
 void od_state_init_border(od_state *state);
 void od_state_init_superblock_split(od_state *state, unsigned char bsize);
+void od_state_tile_bounds(const od_state *state, int tile,
+ int *sbx0, int *sby0, int *sbx1, int *sby1);
+void od_state_prefilter_planes(od_state *state, od_coeff **c, int nplanes);
+void od_state_postfilter_planes(od_state *state, od_coeff **c, int nplanes,
+ int q, unsigned char **skip);
 int od_state_dump_yuv(od_state *state, daala_image *img, const char *tag);
 void od_img_edge_ext(daala_image* src);
+void od_img_edge_ext_rows(daala_image *img, int y0, int y1);
 void od_ref_buf_to_coeff(od_state *state,
  od_coeff *dst, int dst_ystride, int lossless_p,
  unsigned char *src, int src_xstride, int src_ystride,
@@ -355,6 +408,14 @@ void od_mc_blend_multi16_c(unsigned char *_dst, int _dystride,
 void od_mc_blend_multi_split16_c(unsigned char *_dst, int _dystride,
  const unsigned char *_src[4], int _c, int _s, int _log_xblk_sz,
  int _log_yblk_sz);
+void od_ref_buf_to_coeff8_c(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+void od_ref_buf_to_coeff16_c(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+void od_coeff_to_ref_buf8_c(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
+void od_coeff_to_ref_buf16_c(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
 void od_restore_fpu(od_state *state);
 
 void od_state_opt_vtbl_init_c(od_state *_state);
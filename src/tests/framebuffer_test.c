@@ -0,0 +1,374 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "daala/daalaenc.h"
+#include "daala/daaladec.h"
+
+/*Decodes a clip with B-frames into frame buffers supplied by the
+   application, and checks that every buffer the decoder gets is released
+   exactly once, and that the output matches decoding into the decoder's own
+   buffers.*/
+
+#define WIDTH (128)
+#define HEIGHT (96)
+#define NFRAMES (8)
+#define NB_FRAMES (2)
+#define MAX_PACKETS (32)
+
+typedef struct {
+  unsigned char *data;
+  long bytes;
+  daala_packet op;
+} stored_packet;
+
+/*The application's side of the frame buffer pool.*/
+typedef struct {
+  int gets;
+  int releases;
+  int live;
+  int max_live;
+  /*Releases of buffers that were not handed out.*/
+  int bad;
+  /*Buffers requested with padding, i.e., for reference images.*/
+  int padded;
+} fb_pool;
+
+static unsigned char planes[NFRAMES][3][WIDTH*HEIGHT];
+
+static void make_clip(void) {
+  unsigned seed;
+  int f;
+  int pli;
+  int x;
+  int y;
+  seed = 12345;
+  for (f = 0; f < NFRAMES; f++) {
+    for (pli = 0; pli < 3; pli++) {
+      int w;
+      int h;
+      w = pli ? WIDTH >> 1 : WIDTH;
+      h = pli ? HEIGHT >> 1 : HEIGHT;
+      for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+          int v;
+          v = ((x + 2*f)*3 + (y + f)*2 + pli*40) & 255;
+          if (((x - 3*f)/16 + (y + f)/16) & 1) v = (v*3) & 255;
+          seed = seed*1103515245 + 12345;
+          v += (int)((seed >> 16) & 7) - 3;
+          if (v < 0) v = 0;
+          if (v > 255) v = 255;
+          planes[f][pli][y*w + x] = (unsigned char)v;
+        }
+      }
+    }
+  }
+}
+
+static int fb_get(void *ctx, daala_frame_buffer *fb) {
+  fb_pool *pool;
+  unsigned char *buf;
+  size_t size;
+  int pli;
+  pool = (fb_pool *)ctx;
+  size = 32;
+  for (pli = 0; pli < fb->img.nplanes; pli++) {
+    daala_image_plane *iplane;
+    int w;
+    int h;
+    iplane = fb->img.planes + pli;
+    w = (fb->img.width + 2*fb->border) >> iplane->xdec;
+    h = (fb->img.height + 2*fb->border) >> iplane->ydec;
+    iplane->ystride = (w*iplane->xstride + 31) & ~31;
+    size += (size_t)iplane->ystride*h;
+  }
+  buf = (unsigned char *)malloc(size);
+  if (buf == NULL) return -1;
+  fb->priv = buf;
+  /*Align the planes to 32 bytes.*/
+  buf += (32 - ((size_t)buf & 31)) & 31;
+  for (pli = 0; pli < fb->img.nplanes; pli++) {
+    daala_image_plane *iplane;
+    int h;
+    iplane = fb->img.planes + pli;
+    h = (fb->img.height + 2*fb->border) >> iplane->ydec;
+    /*The border is a multiple of 32 pixels, so this stays aligned.*/
+    iplane->data = buf + (fb->border >> iplane->ydec)*iplane->ystride
+     + (fb->border >> iplane->xdec)*iplane->xstride;
+    buf += (size_t)iplane->ystride*h;
+  }
+  pool->gets++;
+  pool->live++;
+  if (pool->live > pool->max_live) pool->max_live = pool->live;
+  if (fb->border > 0) pool->padded++;
+  return 0;
+}
+
+static void fb_release(void *ctx, daala_frame_buffer *fb) {
+  fb_pool *pool;
+  pool = (fb_pool *)ctx;
+  if (fb->priv == NULL) {
+    pool->bad++;
+    return;
+  }
+  free(fb->priv);
+  fb->priv = NULL;
+  pool->releases++;
+  pool->live--;
+}
+
+static int store_packet(stored_packet *pk, int *npk, const daala_packet *dp) {
+  if (*npk >= MAX_PACKETS) return 1;
+  pk[*npk].data = (unsigned char *)malloc(dp->bytes);
+  if (pk[*npk].data == NULL) return 1;
+  memcpy(pk[*npk].data, dp->packet, dp->bytes);
+  pk[*npk].bytes = dp->bytes;
+  pk[*npk].op = *dp;
+  pk[*npk].op.packet = pk[*npk].data;
+  (*npk)++;
+  return 0;
+}
+
+static void free_packets(stored_packet *pk, int npk) {
+  int i;
+  for (i = 0; i < npk; i++) free(pk[i].data);
+}
+
+/*Encodes the clip with B-frames, returning the number of packets (headers
+   included), or -1 on failure.*/
+static int encode_clip(stored_packet *pk, int full_precision_references) {
+  daala_info di;
+  daala_comment dc;
+  daala_enc_ctx *enc;
+  daala_packet dp;
+  daala_image img;
+  int b_frames;
+  int quant;
+  int npk;
+  int f;
+  int pli;
+  daala_info_init(&di);
+  di.pic_width = WIDTH;
+  di.pic_height = HEIGHT;
+  di.nplanes = 3;
+  di.timebase_numerator = 30;
+  di.timebase_denominator = 1;
+  di.frame_duration = 1;
+  di.pixel_aspect_numerator = 1;
+  di.pixel_aspect_denominator = 1;
+  di.keyframe_rate = 256;
+  di.full_precision_references = full_precision_references;
+  for (pli = 0; pli < 3; pli++) {
+    di.plane_info[pli].xdec = pli > 0;
+    di.plane_info[pli].ydec = pli > 0;
+  }
+  enc = daala_encode_create(&di);
+  if (enc == NULL) return -1;
+  quant = 20;
+  daala_encode_ctl(enc, OD_SET_QUANT, &quant, sizeof(quant));
+  b_frames = NB_FRAMES;
+  daala_encode_ctl(enc, OD_SET_B_FRAMES, &b_frames, sizeof(b_frames));
+  npk = 0;
+  daala_comment_init(&dc);
+  while (daala_encode_flush_header(enc, &dc, &dp) > 0) {
+    if (store_packet(pk, &npk, &dp)) goto fail;
+  }
+  img.nplanes = 3;
+  img.width = WIDTH;
+  img.height = HEIGHT;
+  for (f = 0; f < NFRAMES; f++) {
+    for (pli = 0; pli < 3; pli++) {
+      img.planes[pli].data = planes[f][pli];
+      img.planes[pli].xdec = img.planes[pli].ydec = pli > 0;
+      img.planes[pli].xstride = 1;
+      img.planes[pli].ystride = pli ? WIDTH >> 1 : WIDTH;
+      img.planes[pli].bitdepth = 8;
+    }
+    if (daala_encode_img_in(enc, &img, 0)) goto fail;
+    while (daala_encode_packet_out(enc, f == NFRAMES - 1, &dp) > 0) {
+      if (store_packet(pk, &npk, &dp)) goto fail;
+    }
+  }
+  daala_encode_free(enc);
+  return npk;
+fail:
+  daala_encode_free(enc);
+  free_packets(pk, npk);
+  return -1;
+}
+
+static unsigned long hash_img(unsigned long h, const daala_image *img) {
+  int pli;
+  int x;
+  int y;
+  for (pli = 0; pli < 3; pli++) {
+    const daala_image_plane *iplane;
+    int w;
+    int hgt;
+    iplane = img->planes + pli;
+    w = pli ? WIDTH >> 1 : WIDTH;
+    hgt = pli ? HEIGHT >> 1 : HEIGHT;
+    for (y = 0; y < hgt; y++) {
+      for (x = 0; x < w; x++) {
+        h = (h ^ iplane->data[y*iplane->ystride + x*iplane->xstride])
+         *16777619UL & 0xFFFFFFFFUL;
+      }
+    }
+  }
+  return h;
+}
+
+/*Decodes the packets, into the application's buffers if pool is not NULL.
+  Returns the number of decoded frames, or -1 on failure.*/
+static int decode_clip(stored_packet *pk, int npk, int nthreads,
+ fb_pool *pool, unsigned long *hash) {
+  daala_info di;
+  daala_comment dc;
+  daala_setup_info *ds;
+  daala_dec_ctx *dec;
+  int ndec;
+  int i;
+  ds = NULL;
+  daala_info_init(&di);
+  daala_comment_init(&dc);
+  for (i = 0; i < npk; i++) {
+    int ret;
+    ret = daala_decode_header_in(&di, &dc, &ds, &pk[i].op);
+    if (ret < 0) i = npk;
+    if (ret <= 0) break;
+  }
+  if (i++ >= npk) {
+    daala_setup_free(ds);
+    daala_comment_clear(&dc);
+    return -1;
+  }
+  dec = daala_decode_create(&di, ds);
+  daala_setup_free(ds);
+  daala_comment_clear(&dc);
+  if (dec == NULL) return -1;
+  if (nthreads > 1) {
+    daala_decode_ctl(dec, OD_DECCTL_SET_THREADS, &nthreads, sizeof(nthreads));
+  }
+  if (pool != NULL) {
+    daala_frame_buffer_funcs funcs;
+    funcs.get_buffer = fb_get;
+    funcs.release_buffer = fb_release;
+    funcs.ctx = pool;
+    if (daala_decode_ctl(dec, OD_DECCTL_SET_FRAME_BUFFER_FUNCS, &funcs,
+     sizeof(funcs))) {
+      daala_decode_free(dec);
+      return -1;
+    }
+  }
+  *hash = 2166136261UL;
+  ndec = 0;
+  for (; i < npk; i++) {
+    daala_image out;
+    if (daala_decode_packet_in(dec, &pk[i].op)) break;
+    /*Take one image per packet, so that several stay queued behind the
+       B-frames.*/
+    if (daala_decode_img_out(dec, &out) == 1) {
+      *hash = hash_img(*hash, &out);
+      ndec++;
+    }
+  }
+  if (i == npk) {
+    daala_image out;
+    while (daala_decode_img_out(dec, &out) == 1) {
+      *hash = hash_img(*hash, &out);
+      ndec++;
+    }
+  }
+  daala_decode_free(dec);
+  return i < npk ? -1 : ndec;
+}
+
+static int run_test(int full_precision_references, int nthreads) {
+  stored_packet pk[MAX_PACKETS];
+  fb_pool pool;
+  unsigned long hash;
+  unsigned long hash_fb;
+  int failed;
+  int npk;
+  int ndec;
+  int ndec_fb;
+  failed = 0;
+  npk = encode_clip(pk, full_precision_references);
+  if (npk < 0) {
+    fprintf(stderr, "Failed to encode the clip.\n");
+    return 1;
+  }
+  memset(&pool, 0, sizeof(pool));
+  ndec = decode_clip(pk, npk, nthreads, NULL, &hash);
+  ndec_fb = decode_clip(pk, npk, nthreads, &pool, &hash_fb);
+  if (ndec != NFRAMES || ndec_fb != NFRAMES) {
+    fprintf(stderr, "Decoded %i frames (%i with frame buffers), expected %i.\n",
+     ndec, ndec_fb, NFRAMES);
+    failed = 1;
+  }
+  else if (hash_fb != hash) {
+    fprintf(stderr, "The output differs with frame buffers.\n");
+    failed = 1;
+  }
+  if (pool.gets == 0 || pool.gets != pool.releases || pool.live != 0
+   || pool.bad != 0) {
+    fprintf(stderr, "%i buffers were got, %i released, %i bad releases.\n",
+     pool.gets, pool.releases, pool.bad);
+    failed = 1;
+  }
+  /*Full precision references stay in the decoder's own memory, so it only
+     asks for output images, which have no padding.*/
+  if (full_precision_references && pool.padded != 0) {
+    fprintf(stderr, "%i reference buffers were requested.\n", pool.padded);
+    failed = 1;
+  }
+  if (failed) {
+    fprintf(stderr, "Failed with%s full precision references and %i "
+     "thread(s).\n", full_precision_references ? "" : "out", nthreads);
+  }
+  free_packets(pk, npk);
+  return failed;
+}
+
+int main(void) {
+  int failed;
+  int fpr;
+  make_clip();
+  failed = 0;
+  for (fpr = 0; fpr < 2; fpr++) {
+    failed |= run_test(fpr, 1);
+    failed |= run_test(fpr, 4);
+  }
+  if (failed) return EXIT_FAILURE;
+  fprintf(stderr, "Frame buffer tests passed.\n");
+  return EXIT_SUCCESS;
+}
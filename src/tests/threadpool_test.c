@@ -0,0 +1,149 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../internal.h"
+#include "../threadpool.h"
+
+#define NJOBS (200)
+
+typedef struct {
+  od_progress progress;
+  od_progress gate;
+  /*The order in which the chained jobs ran, filled in by the jobs
+     themselves.*/
+  int order[NJOBS];
+  int count[NJOBS];
+} test_ctx;
+
+/*Job idx waits for job idx - 1 to publish its progress, so the jobs must
+   run in submission order no matter how many threads pick them up.*/
+static void chained_job(void *_ctx, int idx) {
+  test_ctx *ctx;
+  int pos;
+  ctx = (test_ctx *)_ctx;
+  od_progress_wait(&ctx->progress, idx);
+  pos = od_progress_get(&ctx->progress);
+  ctx->order[pos] = idx;
+  od_progress_set(&ctx->progress, idx + 1);
+}
+
+/*Blocks until the test opens the gate.*/
+static void gated_job(void *_ctx, int idx) {
+  test_ctx *ctx;
+  ctx = (test_ctx *)_ctx;
+  OD_UNUSED(idx);
+  od_progress_wait(&ctx->gate, 1);
+}
+
+/*Independent jobs that each only touch their own slot.*/
+static void counting_job(void *_ctx, int idx) {
+  test_ctx *ctx;
+  ctx = (test_ctx *)_ctx;
+  ctx->count[idx]++;
+}
+
+static int run_test(int nthreads) {
+  od_thread_pool pool;
+  test_ctx ctx;
+  int failed;
+  int i;
+  failed = 0;
+  if (od_thread_pool_init(&pool, nthreads)
+   || od_progress_init(&ctx.progress) || od_progress_init(&ctx.gate)) {
+    fprintf(stderr, "Failed to create a pool of %i threads.\n", nthreads);
+    return 1;
+  }
+  for (i = 0; i < NJOBS; i++) ctx.order[i] = -1;
+  for (i = 0; i < NJOBS; i++) {
+    od_thread_pool_submit(&pool, chained_job, &ctx, i);
+  }
+  od_thread_pool_join(&pool);
+  if (od_progress_get(&ctx.progress) != NJOBS) {
+    fprintf(stderr, "%i threads: progress is %i, expected %i.\n", nthreads,
+     od_progress_get(&ctx.progress), NJOBS);
+    failed = 1;
+  }
+  for (i = 0; i < NJOBS; i++) {
+    if (ctx.order[i] != i) {
+      fprintf(stderr, "%i threads: job %i ran in position %i.\n", nthreads,
+       ctx.order[i], i);
+      failed = 1;
+      break;
+    }
+  }
+  /*The pool must be reusable after a join.*/
+  for (i = 0; i < NJOBS; i++) ctx.count[i] = 0;
+  od_thread_pool_run(&pool, counting_job, &ctx, NJOBS);
+  for (i = 0; i < NJOBS; i++) {
+    if (ctx.count[i] != 1) {
+      fprintf(stderr, "%i threads: job %i ran %i times.\n", nthreads, i,
+       ctx.count[i]);
+      failed = 1;
+      break;
+    }
+  }
+  /*A run must not wait for jobs submitted before it, even when they occupy
+     every worker: the calling thread does the work itself.
+    If it did wait, this would never return.*/
+  if (pool.nthreads > 1) {
+    for (i = 0; i < pool.nthreads - 1; i++) {
+      od_thread_pool_submit(&pool, gated_job, &ctx, i);
+    }
+    for (i = 0; i < NJOBS; i++) ctx.count[i] = 0;
+    od_thread_pool_run(&pool, counting_job, &ctx, NJOBS);
+    for (i = 0; i < NJOBS; i++) {
+      if (ctx.count[i] != 1) {
+        fprintf(stderr, "%i threads: job %i ran %i times behind busy "
+         "workers.\n", nthreads, i, ctx.count[i]);
+        failed = 1;
+        break;
+      }
+    }
+    od_progress_set(&ctx.gate, 1);
+    od_thread_pool_join(&pool);
+  }
+  od_progress_clear(&ctx.gate);
+  od_progress_clear(&ctx.progress);
+  od_thread_pool_clear(&pool);
+  return failed;
+}
+
+int main(void) {
+  static const int NTHREADS[] = { 1, 2, 4, 8 };
+  int failed;
+  int i;
+  failed = 0;
+  for (i = 0; i < (int)(sizeof(NTHREADS)/sizeof(*NTHREADS)); i++) {
+    failed |= run_test(NTHREADS[i]);
+  }
+  if (failed) return EXIT_FAILURE;
+  fprintf(stderr, "Thread pool tests passed.\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,380 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "daala/daalaenc.h"
+#include "daala/daaladec.h"
+
+/*Round-trips a short clip through the encoder and decoder with various tile
+   grids, with and without parallel RDO, and checks that invalid grids are
+   rejected.
+  Built with OD_TILES_LONG_TEST, it runs the full determinism matrix instead:
+   more grids, each encoded from the whole clip with several thread counts.
+  That takes minutes, so it is not part of make check.*/
+
+#define WIDTH (176)
+#define HEIGHT (144)
+/*The length of the clip; each case encodes the first nframes frames of it.*/
+#define NFRAMES (4)
+#define MAX_PACKETS (32)
+/*The decoded clip must be at least this close to the input (in dB).*/
+#define MIN_PSNR (30.0)
+
+typedef struct {
+  unsigned char *data;
+  long bytes;
+  daala_packet op;
+} stored_packet;
+
+static unsigned char planes[NFRAMES][3][WIDTH*HEIGHT];
+
+/*A moving pattern with a little noise, so that the RDO has real choices to
+   make.*/
+static void make_clip(void) {
+  unsigned seed;
+  int f;
+  int pli;
+  int x;
+  int y;
+  seed = 12345;
+  for (f = 0; f < NFRAMES; f++) {
+    for (pli = 0; pli < 3; pli++) {
+      int w;
+      int h;
+      w = pli ? WIDTH >> 1 : WIDTH;
+      h = pli ? HEIGHT >> 1 : HEIGHT;
+      for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+          int v;
+          v = ((x + 2*f)*3 + (y + f)*2 + pli*40) & 255;
+          if (((x - 3*f)/16 + (y + f)/16) & 1) v = (v*3) & 255;
+          seed = seed*1103515245 + 12345;
+          v += (int)((seed >> 16) & 7) - 3;
+          if (v < 0) v = 0;
+          if (v > 255) v = 255;
+          planes[f][pli][y*w + x] = (unsigned char)v;
+        }
+      }
+    }
+  }
+}
+
+static void set_info(daala_info *di, int cols_log2, int rows_log2) {
+  int pli;
+  daala_info_init(di);
+  di->pic_width = WIDTH;
+  di->pic_height = HEIGHT;
+  di->nplanes = 3;
+  di->timebase_numerator = 30;
+  di->timebase_denominator = 1;
+  di->frame_duration = 1;
+  di->pixel_aspect_numerator = 1;
+  di->pixel_aspect_denominator = 1;
+  di->keyframe_rate = 256;
+  for (pli = 0; pli < 3; pli++) {
+    di->plane_info[pli].xdec = pli > 0;
+    di->plane_info[pli].ydec = pli > 0;
+  }
+  di->tile_cols_log2 = cols_log2;
+  di->tile_rows_log2 = rows_log2;
+}
+
+static int store_packet(stored_packet *pk, int *npk, const daala_packet *dp) {
+  if (*npk >= MAX_PACKETS) return 1;
+  pk[*npk].data = (unsigned char *)malloc(dp->bytes);
+  if (pk[*npk].data == NULL) return 1;
+  memcpy(pk[*npk].data, dp->packet, dp->bytes);
+  pk[*npk].bytes = dp->bytes;
+  pk[*npk].op = *dp;
+  pk[*npk].op.packet = pk[*npk].data;
+  (*npk)++;
+  return 0;
+}
+
+static void free_packets(stored_packet *pk, int npk) {
+  int i;
+  for (i = 0; i < npk; i++) free(pk[i].data);
+}
+
+/*Encodes the clip, returning the number of packets (headers included), or
+   -1 on failure.*/
+static int encode_clip(stored_packet *pk, int nframes, int cols_log2,
+ int rows_log2, int quant, int nthreads, int parallel_rdo) {
+  daala_info di;
+  daala_comment dc;
+  daala_enc_ctx *enc;
+  daala_packet dp;
+  daala_image img;
+  int npk;
+  int f;
+  int pli;
+  set_info(&di, cols_log2, rows_log2);
+  enc = daala_encode_create(&di);
+  if (enc == NULL) return -1;
+  daala_encode_ctl(enc, OD_SET_QUANT, &quant, sizeof(quant));
+  if (nthreads > 1) {
+    daala_encode_ctl(enc, OD_SET_THREADS, &nthreads, sizeof(nthreads));
+  }
+  if (parallel_rdo) {
+    daala_encode_ctl(enc, OD_SET_PARALLEL_RDO, &parallel_rdo,
+     sizeof(parallel_rdo));
+  }
+  npk = 0;
+  daala_comment_init(&dc);
+  while (daala_encode_flush_header(enc, &dc, &dp) > 0) {
+    if (store_packet(pk, &npk, &dp)) goto fail;
+  }
+  img.nplanes = 3;
+  img.width = WIDTH;
+  img.height = HEIGHT;
+  for (f = 0; f < nframes; f++) {
+    for (pli = 0; pli < 3; pli++) {
+      img.planes[pli].data = planes[f][pli];
+      img.planes[pli].xdec = img.planes[pli].ydec = pli > 0;
+      img.planes[pli].xstride = 1;
+      img.planes[pli].ystride = pli ? WIDTH >> 1 : WIDTH;
+      img.planes[pli].bitdepth = 8;
+    }
+    if (daala_encode_img_in(enc, &img, 0)) goto fail;
+    while (daala_encode_packet_out(enc, f == nframes - 1, &dp) > 0) {
+      if (store_packet(pk, &npk, &dp)) goto fail;
+    }
+  }
+  daala_encode_free(enc);
+  return npk;
+fail:
+  daala_encode_free(enc);
+  free_packets(pk, npk);
+  return -1;
+}
+
+/*Decodes the packets, returning the PSNR of the clip, or -1 on failure.*/
+static double decode_clip(stored_packet *pk, int npk, int nframes,
+ int nthreads) {
+  daala_info di;
+  daala_comment dc;
+  daala_setup_info *ds;
+  daala_dec_ctx *dec;
+  double sse;
+  long npixels;
+  int ndec;
+  int i;
+  ds = NULL;
+  daala_info_init(&di);
+  daala_comment_init(&dc);
+  for (i = 0; i < npk; i++) {
+    int ret;
+    ret = daala_decode_header_in(&di, &dc, &ds, &pk[i].op);
+    if (ret < 0) i = npk;
+    if (ret <= 0) break;
+  }
+  if (i++ >= npk) {
+    daala_setup_free(ds);
+    daala_comment_clear(&dc);
+    return -1;
+  }
+  dec = daala_decode_create(&di, ds);
+  daala_setup_free(ds);
+  daala_comment_clear(&dc);
+  if (dec == NULL) return -1;
+  if (nthreads > 1) {
+    daala_decode_ctl(dec, OD_DECCTL_SET_THREADS, &nthreads, sizeof(nthreads));
+  }
+  sse = 0;
+  npixels = 0;
+  ndec = 0;
+  for (; i < npk; i++) {
+    daala_image out;
+    if (daala_decode_packet_in(dec, &pk[i].op)) break;
+    while (daala_decode_img_out(dec, &out) == 1) {
+      int pli;
+      if (ndec >= nframes) break;
+      for (pli = 0; pli < 3; pli++) {
+        int w;
+        int h;
+        int x;
+        int y;
+        w = pli ? WIDTH >> 1 : WIDTH;
+        h = pli ? HEIGHT >> 1 : HEIGHT;
+        for (y = 0; y < h; y++) {
+          for (x = 0; x < w; x++) {
+            int d;
+            d = out.planes[pli].data[y*out.planes[pli].ystride
+             + x*out.planes[pli].xstride] - planes[ndec][pli][y*w + x];
+            sse += d*d;
+          }
+        }
+        npixels += w*h;
+      }
+      ndec++;
+    }
+  }
+  daala_decode_free(dec);
+  if (i < npk || ndec != nframes) return -1;
+  return sse > 0 ? 10*log10(255.0*255.0*npixels/sse) : 99;
+}
+
+static int packets_equal(const stored_packet *a, int na,
+ const stored_packet *b, int nb) {
+  int i;
+  if (na != nb) return 0;
+  for (i = 0; i < na; i++) {
+    if (a[i].bytes != b[i].bytes
+     || memcmp(a[i].data, b[i].data, a[i].bytes) != 0) {
+      return 0;
+    }
+  }
+  return 1;
+}
+
+static int test_invalid_grids(void) {
+  static const int BAD[][2] = { { -1, 0 }, { 0, -1 }, { 4, 0 }, { 0, 4 } };
+  stored_packet pk[MAX_PACKETS];
+  daala_info di;
+  daala_comment dc;
+  daala_setup_info *ds;
+  int failed;
+  int npk;
+  int i;
+  failed = 0;
+  for (i = 0; i < (int)(sizeof(BAD)/sizeof(*BAD)); i++) {
+    daala_enc_ctx *enc;
+    set_info(&di, BAD[i][0], BAD[i][1]);
+    enc = daala_encode_create(&di);
+    if (enc != NULL) {
+      fprintf(stderr, "Encoder accepted a %ix%i tile grid (log2).\n",
+       BAD[i][0], BAD[i][1]);
+      daala_encode_free(enc);
+      failed = 1;
+    }
+  }
+  /*A stream whose info header claims too many tiles must be refused by the
+     decoder.
+    The tile grid is stored in the last two bytes of that header.*/
+  npk = encode_clip(pk, 1, 0, 0, 10, 1, 0);
+  if (npk < 1) {
+    fprintf(stderr, "Failed to encode the clip.\n");
+    return 1;
+  }
+  pk[0].data[pk[0].bytes - 1] = 4;
+  ds = NULL;
+  daala_info_init(&di);
+  daala_comment_init(&dc);
+  if (daala_decode_header_in(&di, &dc, &ds, &pk[0].op) != OD_EBADHEADER) {
+    fprintf(stderr, "Decoder accepted a header with 16 tile rows.\n");
+    failed = 1;
+  }
+  daala_setup_free(ds);
+  daala_comment_clear(&dc);
+  free_packets(pk, npk);
+  return failed;
+}
+
+static int test_round_trip(int nframes, int cols_log2, int rows_log2,
+ int quant, int parallel_rdo, int check_threads) {
+#if defined(OD_TILES_LONG_TEST)
+  static const int NTHREADS[] = { 3, 4 };
+#else
+  static const int NTHREADS[] = { 4 };
+#endif
+  stored_packet pk[MAX_PACKETS];
+  stored_packet pk_mt[MAX_PACKETS];
+  double psnr;
+  double psnr_mt;
+  int failed;
+  int npk;
+  int npk_mt;
+  int i;
+  failed = 0;
+  npk = encode_clip(pk, nframes, cols_log2, rows_log2, quant, 1,
+   parallel_rdo);
+  if (npk < 0) {
+    fprintf(stderr, "%ix%i tiles: encoding failed.\n", 1 << cols_log2,
+     1 << rows_log2);
+    return 1;
+  }
+  /*Tiles are coded independently, and so is the RDO of each superblock with
+     parallel RDO, so the stream must not depend on how many threads encode
+     them.*/
+  for (i = 0; check_threads
+   && i < (int)(sizeof(NTHREADS)/sizeof(*NTHREADS)); i++) {
+    npk_mt = encode_clip(pk_mt, nframes, cols_log2, rows_log2, quant,
+     NTHREADS[i], parallel_rdo);
+    if (npk_mt < 0 || !packets_equal(pk, npk, pk_mt, npk_mt)) {
+      fprintf(stderr, "%ix%i tiles%s: the stream differs with %i threads.\n",
+       1 << cols_log2, 1 << rows_log2, parallel_rdo ? ", parallel RDO" : "",
+       NTHREADS[i]);
+      failed = 1;
+    }
+    if (npk_mt >= 0) free_packets(pk_mt, npk_mt);
+  }
+  psnr = decode_clip(pk, npk, nframes, 1);
+  psnr_mt = decode_clip(pk, npk, nframes, 4);
+  if (psnr < MIN_PSNR || psnr_mt != psnr) {
+    fprintf(stderr, "%ix%i tiles: PSNR %f dB (%f dB with 4 threads).\n",
+     1 << cols_log2, 1 << rows_log2, psnr, psnr_mt);
+    failed = 1;
+  }
+  free_packets(pk, npk);
+  return failed;
+}
+
+int main(void) {
+  /*Each case is {frames, tile_cols_log2, tile_rows_log2, quantizer,
+     parallel RDO, compare the stream across thread counts}.
+    The 8x8 grid has more tiles than the clip has superblocks, which leaves
+     some of them empty.
+    Parallel RDO only diverged across thread counts after a few inter frames,
+     so its 1x1 case keeps the whole clip.*/
+#if defined(OD_TILES_LONG_TEST)
+  static const int CASES[][6] = {
+    { 4, 0, 0, 10, 0, 1 }, { 4, 1, 0, 10, 0, 1 }, { 4, 0, 1, 10, 0, 1 },
+    { 4, 1, 1, 10, 0, 1 }, { 4, 2, 1, 10, 0, 1 }, { 4, 3, 3, 10, 0, 1 },
+    { 4, 0, 0, 10, 1, 1 }, { 4, 1, 1, 10, 1, 1 }
+  };
+#else
+  static const int CASES[][6] = {
+    { 2, 0, 0, 10, 0, 1 }, { 2, 1, 1, 10, 0, 1 }, { 2, 3, 3, 10, 0, 0 },
+    { 4, 0, 0, 10, 1, 1 }, { 2, 1, 1, 10, 1, 1 }
+  };
+#endif
+  int failed;
+  int i;
+  make_clip();
+  failed = test_invalid_grids();
+  for (i = 0; i < (int)(sizeof(CASES)/sizeof(*CASES)); i++) {
+    failed |= test_round_trip(CASES[i][0], CASES[i][1], CASES[i][2],
+     CASES[i][3], CASES[i][4], CASES[i][5]);
+  }
+  if (failed) return EXIT_FAILURE;
+  fprintf(stderr, "Tile tests passed.\n");
+  return EXIT_SUCCESS;
+}
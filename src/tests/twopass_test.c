@@ -0,0 +1,307 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../encint.h"
+
+/*Runs a two-pass rate-controlled encode of a synthetic clip whose complexity
+   changes halfway through, and checks the size of the first-pass data and
+   the bitrate the second pass reaches.*/
+
+#define WIDTH (128)
+#define HEIGHT (96)
+#define NFRAMES (30)
+#define FPS (30)
+#define TARGET_BITRATE (200000)
+/*How far the second pass may land from the target, in percent.*/
+#define MAX_ERROR (10)
+
+#define STATS_SZ (OD_RC_2PASS_HDR_SZ + NFRAMES*OD_RC_2PASS_PACKET_SZ)
+
+static unsigned char planes[NFRAMES][3][WIDTH*HEIGHT];
+
+/*The first half of the clip is a slowly panning gradient, the second half
+   adds heavy noise, so the passes have to move bits between the two.*/
+static void make_clip(void) {
+  unsigned seed;
+  int f;
+  int pli;
+  int x;
+  int y;
+  seed = 12345;
+  for (f = 0; f < NFRAMES; f++) {
+    for (pli = 0; pli < 3; pli++) {
+      int w;
+      int h;
+      int noise;
+      w = pli ? WIDTH >> 1 : WIDTH;
+      h = pli ? HEIGHT >> 1 : HEIGHT;
+      noise = f < NFRAMES/2 ? 1 : 31;
+      for (y = 0; y < h; y++) {
+        for (x = 0; x < w; x++) {
+          int v;
+          v = ((x + f)*2 + y + pli*40) & 255;
+          seed = seed*1103515245 + 12345;
+          v += (int)((seed >> 16) % (2*noise + 1)) - noise;
+          if (v < 0) v = 0;
+          if (v > 255) v = 255;
+          planes[f][pli][y*w + x] = (unsigned char)v;
+        }
+      }
+    }
+  }
+}
+
+static daala_enc_ctx *create_encoder(void) {
+  daala_info di;
+  daala_enc_ctx *enc;
+  long bitrate;
+  int complexity;
+  int quant;
+  int pli;
+  daala_info_init(&di);
+  di.pic_width = WIDTH;
+  di.pic_height = HEIGHT;
+  di.nplanes = 3;
+  di.timebase_numerator = FPS;
+  di.timebase_denominator = 1;
+  di.frame_duration = 1;
+  di.pixel_aspect_numerator = 1;
+  di.pixel_aspect_denominator = 1;
+  di.keyframe_rate = 256;
+  for (pli = 0; pli < 3; pli++) {
+    di.plane_info[pli].xdec = pli > 0;
+    di.plane_info[pli].ydec = pli > 0;
+  }
+  enc = daala_encode_create(&di);
+  if (enc == NULL) return NULL;
+  complexity = 2;
+  daala_encode_ctl(enc, OD_SET_COMPLEXITY, &complexity, sizeof(complexity));
+  /*With rate control, the quantizer setting is a quality floor, which we
+     leave as low as it goes, like encoder_example.*/
+  quant = 512;
+  daala_encode_ctl(enc, OD_SET_QUANT, &quant, sizeof(quant));
+  bitrate = TARGET_BITRATE;
+  if (daala_encode_ctl(enc, OD_SET_BITRATE, &bitrate, sizeof(bitrate))) {
+    daala_encode_free(enc);
+    return NULL;
+  }
+  return enc;
+}
+
+static void set_img(daala_image *img, int f) {
+  int pli;
+  img->nplanes = 3;
+  img->width = WIDTH;
+  img->height = HEIGHT;
+  for (pli = 0; pli < 3; pli++) {
+    img->planes[pli].data = planes[f][pli];
+    img->planes[pli].xdec = img->planes[pli].ydec = pli > 0;
+    img->planes[pli].xstride = 1;
+    img->planes[pli].ystride = pli ? WIDTH >> 1 : WIDTH;
+    img->planes[pli].bitdepth = 8;
+  }
+}
+
+/*Appends the first-pass data the encoder has ready to stats, checking that it
+   has the expected size.*/
+static int stats_out(daala_enc_ctx *enc, unsigned char *stats, int *nstats,
+ int expected) {
+  unsigned char *buf;
+  int bytes;
+  bytes = daala_encode_ctl(enc, OD_2PASS_OUT, &buf, sizeof(buf));
+  if (bytes != expected) {
+    fprintf(stderr, "Pass 1 returned %i bytes of data, expected %i.\n",
+     bytes, expected);
+    return 1;
+  }
+  if (*nstats + bytes > STATS_SZ) {
+    fprintf(stderr, "Pass 1 returned more than %i bytes of data.\n",
+     STATS_SZ);
+    return 1;
+  }
+  memcpy(stats + *nstats, buf, bytes);
+  *nstats += bytes;
+  return 0;
+}
+
+/*Runs pass 1, filling in stats.
+  Returns the number of bytes of first-pass data, or -1 on failure.*/
+static int run_pass1(unsigned char *stats) {
+  daala_enc_ctx *enc;
+  daala_comment dc;
+  daala_packet dp;
+  daala_image img;
+  int nstats;
+  int nsummary;
+  int f;
+  enc = create_encoder();
+  if (enc == NULL) return -1;
+  nstats = 0;
+  /*The placeholder for the summary.*/
+  if (stats_out(enc, stats, &nstats, OD_RC_2PASS_HDR_SZ)) goto fail;
+  daala_comment_init(&dc);
+  while (daala_encode_flush_header(enc, &dc, &dp) > 0);
+  for (f = 0; f < NFRAMES; f++) {
+    set_img(&img, f);
+    if (daala_encode_img_in(enc, &img, 0)) goto fail;
+    while (daala_encode_packet_out(enc, f == NFRAMES - 1, &dp) > 0) {
+      if (stats_out(enc, stats, &nstats, OD_RC_2PASS_PACKET_SZ)) goto fail;
+    }
+  }
+  /*Replace the placeholder with the real summary.*/
+  nsummary = 0;
+  if (stats_out(enc, stats, &nsummary, OD_RC_2PASS_HDR_SZ)) goto fail;
+  daala_encode_free(enc);
+  return nstats;
+fail:
+  daala_encode_free(enc);
+  return -1;
+}
+
+/*Feeds the encoder all the first-pass data it needs before the next frame.*/
+static int stats_in(daala_enc_ctx *enc, unsigned char *stats, int nstats,
+ int *pos) {
+  while (*pos < nstats) {
+    int bytes;
+    bytes = daala_encode_ctl(enc, OD_2PASS_IN, NULL, 0);
+    if (bytes <= 0) return bytes;
+    if (bytes > nstats - *pos) bytes = nstats - *pos;
+    bytes = daala_encode_ctl(enc, OD_2PASS_IN, stats + *pos, bytes);
+    if (bytes <= 0) return bytes;
+    *pos += bytes;
+  }
+  return 0;
+}
+
+/*Runs pass 2 from stats.
+  Returns the number of bits in the frame packets, or -1 on failure.*/
+static long run_pass2(unsigned char *stats, int nstats, int *nframes) {
+  daala_enc_ctx *enc;
+  daala_comment dc;
+  daala_packet dp;
+  daala_image img;
+  long bits;
+  int pos;
+  int f;
+  enc = create_encoder();
+  if (enc == NULL) return -1;
+  pos = 0;
+  if (stats_in(enc, stats, nstats, &pos) < 0) goto fail;
+  daala_comment_init(&dc);
+  while (daala_encode_flush_header(enc, &dc, &dp) > 0);
+  bits = 0;
+  *nframes = 0;
+  for (f = 0; f < NFRAMES; f++) {
+    set_img(&img, f);
+    if (daala_encode_img_in(enc, &img, 0)) goto fail;
+    for (;;) {
+      if (stats_in(enc, stats, nstats, &pos) < 0) goto fail;
+      if (daala_encode_packet_out(enc, f == NFRAMES - 1, &dp) <= 0) break;
+      bits += dp.bytes*8;
+      (*nframes)++;
+    }
+  }
+  daala_encode_free(enc);
+  return bits;
+fail:
+  daala_encode_free(enc);
+  return -1;
+}
+
+int main(void) {
+  static unsigned char stats[STATS_SZ];
+  unsigned char placeholder[STATS_SZ];
+  daala_enc_ctx *enc;
+  long bits;
+  long bitrate;
+  long ntotal;
+  int nstats;
+  int nplaceholder;
+  int nframes;
+  int failed;
+  int ret;
+  int i;
+  make_clip();
+  failed = 0;
+  nframes = 0;
+  nstats = run_pass1(stats);
+  if (nstats != STATS_SZ) {
+    fprintf(stderr, "Pass 1 returned %i bytes of data for %i frames, "
+     "expected %i.\n", nstats, NFRAMES, STATS_SZ);
+    return EXIT_FAILURE;
+  }
+  /*The summary starts with a magic number and version, followed by the
+     number of frames of each subtype, least significant byte first.*/
+  ntotal = 0;
+  for (i = 0; i < OD_FRAME_NSUBTYPES; i++) {
+    const unsigned char *p;
+    p = stats + 8 + 4*i;
+    ntotal += p[0] | p[1] << 8 | (long)p[2] << 16 | (long)p[3] << 24;
+  }
+  if (ntotal != NFRAMES) {
+    fprintf(stderr, "The pass 1 summary counts %li frames, expected %i.\n",
+     ntotal, NFRAMES);
+    failed = 1;
+  }
+  /*Pass 2 must refuse the data of an aborted pass 1, which still has the
+     placeholder in place of the summary.*/
+  enc = create_encoder();
+  if (enc == NULL) return EXIT_FAILURE;
+  nplaceholder = 0;
+  failed |= stats_out(enc, placeholder, &nplaceholder, OD_RC_2PASS_HDR_SZ);
+  daala_encode_free(enc);
+  enc = create_encoder();
+  if (enc == NULL) return EXIT_FAILURE;
+  ret = daala_encode_ctl(enc, OD_2PASS_IN, placeholder, OD_RC_2PASS_HDR_SZ);
+  daala_encode_free(enc);
+  if (ret != OD_EBADHEADER) {
+    fprintf(stderr, "Pass 2 accepted the placeholder summary (returned %i).\n",
+     ret);
+    failed = 1;
+  }
+  bits = run_pass2(stats, nstats, &nframes);
+  if (bits < 0 || nframes != NFRAMES) {
+    fprintf(stderr, "Pass 2 failed after %i frames.\n", nframes);
+    return EXIT_FAILURE;
+  }
+  bitrate = bits*FPS/NFRAMES;
+  if (bitrate*100 < TARGET_BITRATE*(100L - MAX_ERROR)
+   || bitrate*100 > TARGET_BITRATE*(100L + MAX_ERROR)) {
+    fprintf(stderr, "Pass 2 used %li bits per second, target %i.\n", bitrate,
+     TARGET_BITRATE);
+    failed = 1;
+  }
+  if (failed) return EXIT_FAILURE;
+  fprintf(stderr, "Two-pass tests passed (%li bits per second, target %i).\n",
+   bitrate, TARGET_BITRATE);
+  return EXIT_SUCCESS;
+}
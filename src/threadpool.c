@@ -0,0 +1,389 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include "internal.h"
+#include "threadpool.h"
+
+#if defined(OD_ENABLE_THREADS)
+
+/*Must be called with the queue mutex held.*/
+static int od_thread_queue_pop(od_thread_queue *queue, od_thread_job *job) {
+  if (queue->njobs <= 0) return 0;
+  *job = queue->jobs[queue->head];
+  queue->head = (queue->head + 1) % queue->jobs_sz;
+  queue->njobs--;
+  return 1;
+}
+
+/*Must be called with the queue mutex held.*/
+static void od_thread_queue_finish(od_thread_queue *queue) {
+  OD_ASSERT(queue->pending > 0);
+  if (--queue->pending == 0) pthread_cond_broadcast(&queue->done_cond);
+}
+
+/*Must be called with the queue mutex held.*/
+static int od_thread_queue_grow(od_thread_queue *queue) {
+  od_thread_job *jobs;
+  int jobs_sz;
+  int i;
+  jobs_sz = OD_MAXI(queue->jobs_sz << 1, 16);
+  jobs = (od_thread_job *)malloc(sizeof(*jobs)*jobs_sz);
+  if (OD_UNLIKELY(!jobs)) return OD_EFAULT;
+  for (i = 0; i < queue->njobs; i++) {
+    jobs[i] = queue->jobs[(queue->head + i) % queue->jobs_sz];
+  }
+  free(queue->jobs);
+  queue->jobs = jobs;
+  queue->jobs_sz = jobs_sz;
+  queue->head = 0;
+  return OD_SUCCESS;
+}
+
+static void *od_thread_pool_worker(void *arg) {
+  od_thread_queue *queue;
+  od_thread_job job;
+  queue = (od_thread_queue *)arg;
+  pthread_mutex_lock(&queue->mutex);
+  for (;;) {
+    while (!queue->njobs && !queue->stop) {
+      pthread_cond_wait(&queue->job_cond, &queue->mutex);
+    }
+    if (!od_thread_queue_pop(queue, &job)) break;
+    pthread_mutex_unlock(&queue->mutex);
+    (*job.func)(job.ctx, job.idx);
+    pthread_mutex_lock(&queue->mutex);
+    od_thread_queue_finish(queue);
+  }
+  pthread_mutex_unlock(&queue->mutex);
+  return NULL;
+}
+
+#endif
+
+/*Starts a pool using a total of nthreads threads (including the caller).
+  On failure the pool is left in a state od_thread_pool_clear() accepts.*/
+int od_thread_pool_init(od_thread_pool *pool, int nthreads) {
+  OD_CLEAR(pool, 1);
+  if (nthreads < 1 || nthreads > OD_THREADS_MAX) return OD_EINVAL;
+  pool->nthreads = 1;
+#if defined(OD_ENABLE_THREADS)
+  if (nthreads > 1) {
+    od_thread_queue *queue;
+    int i;
+    queue = (od_thread_queue *)calloc(1, sizeof(*queue));
+    if (OD_UNLIKELY(!queue)) return OD_EFAULT;
+    if (pthread_mutex_init(&queue->mutex, NULL)) {
+      free(queue);
+      return OD_EFAULT;
+    }
+    if (pthread_cond_init(&queue->job_cond, NULL)) {
+      pthread_mutex_destroy(&queue->mutex);
+      free(queue);
+      return OD_EFAULT;
+    }
+    if (pthread_cond_init(&queue->done_cond, NULL)) {
+      pthread_cond_destroy(&queue->job_cond);
+      pthread_mutex_destroy(&queue->mutex);
+      free(queue);
+      return OD_EFAULT;
+    }
+    pool->queue = queue;
+    pool->workers = (pthread_t *)malloc(sizeof(*pool->workers)*(nthreads - 1));
+    /*nthreads > 1 with no workers tells od_thread_pool_clear() that the
+       queue needs to be destroyed.*/
+    pool->nthreads = nthreads;
+    if (OD_UNLIKELY(!pool->workers)) return OD_EFAULT;
+    for (i = 0; i < nthreads - 1; i++) {
+      if (pthread_create(pool->workers + i, NULL,
+       od_thread_pool_worker, queue)) {
+        return OD_EFAULT;
+      }
+      pool->nworkers++;
+    }
+  }
+#else
+  OD_UNUSED(nthreads);
+#endif
+  return OD_SUCCESS;
+}
+
+void od_thread_pool_clear(od_thread_pool *pool) {
+#if defined(OD_ENABLE_THREADS)
+  if (pool->nthreads > 1) {
+    od_thread_queue *queue;
+    int i;
+    queue = pool->queue;
+    pthread_mutex_lock(&queue->mutex);
+    queue->stop = 1;
+    pthread_cond_broadcast(&queue->job_cond);
+    pthread_mutex_unlock(&queue->mutex);
+    for (i = 0; i < pool->nworkers; i++) pthread_join(pool->workers[i], NULL);
+    pthread_cond_destroy(&queue->done_cond);
+    pthread_cond_destroy(&queue->job_cond);
+    pthread_mutex_destroy(&queue->mutex);
+    free(queue->jobs);
+    free(queue);
+    free(pool->workers);
+  }
+#endif
+  OD_CLEAR(pool, 1);
+}
+
+/*Queues func(ctx, idx) to be run by the pool.
+  Returns immediately; use od_thread_pool_join() to wait for completion.*/
+void od_thread_pool_submit(od_thread_pool *pool, od_thread_func func,
+ void *ctx, int idx) {
+#if defined(OD_ENABLE_THREADS)
+  if (pool->nworkers > 0) {
+    od_thread_queue *queue;
+    od_thread_job *job;
+    queue = pool->queue;
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->njobs < queue->jobs_sz
+     || OD_LIKELY(!od_thread_queue_grow(queue))) {
+      job = queue->jobs + (queue->head + queue->njobs) % queue->jobs_sz;
+      job->func = func;
+      job->ctx = ctx;
+      job->idx = idx;
+      queue->njobs++;
+      queue->pending++;
+      pthread_cond_signal(&queue->job_cond);
+      pthread_mutex_unlock(&queue->mutex);
+      return;
+    }
+    /*Out of memory: fall back to running the job on this thread.
+      Any jobs it depends on have already been queued, so the workers will
+       still make progress.*/
+    pthread_mutex_unlock(&queue->mutex);
+  }
+#else
+  OD_UNUSED(pool);
+#endif
+  (*func)(ctx, idx);
+}
+
+/*Waits until every job submitted so far has finished, helping to run the
+   queued ones on the calling thread.
+  This must not be called from inside a job.*/
+void od_thread_pool_join(od_thread_pool *pool) {
+#if defined(OD_ENABLE_THREADS)
+  if (pool->nworkers > 0) {
+    od_thread_queue *queue;
+    od_thread_job job;
+    queue = pool->queue;
+    pthread_mutex_lock(&queue->mutex);
+    while (od_thread_queue_pop(queue, &job)) {
+      pthread_mutex_unlock(&queue->mutex);
+      (*job.func)(job.ctx, job.idx);
+      pthread_mutex_lock(&queue->mutex);
+      od_thread_queue_finish(queue);
+    }
+    while (queue->pending > 0) {
+      pthread_cond_wait(&queue->done_cond, &queue->mutex);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+  }
+#else
+  OD_UNUSED(pool);
+#endif
+}
+
+#if defined(OD_ENABLE_THREADS)
+/*The jobs of one od_thread_pool_run() call.
+  Whoever is free claims the next index, so the calling thread never has to
+   wait behind jobs that were queued before the batch.*/
+struct od_thread_batch {
+  od_thread_queue *queue;
+  od_thread_func func;
+  void *ctx;
+  int njobs;
+  /*The next index to claim.*/
+  int next;
+  /*The number of indices that have finished.*/
+  int done;
+  /*The calling thread plus the helper jobs that have not run yet.
+    The last one out frees the batch, since helpers may still be queued after
+     the call returns.*/
+  int refs;
+};
+typedef struct od_thread_batch od_thread_batch;
+
+/*Runs indices of the batch until there are none left to claim.*/
+static void od_thread_batch_work(od_thread_batch *batch) {
+  od_thread_queue *queue;
+  int idx;
+  queue = batch->queue;
+  pthread_mutex_lock(&queue->mutex);
+  while (batch->next < batch->njobs) {
+    idx = batch->next++;
+    pthread_mutex_unlock(&queue->mutex);
+    (*batch->func)(batch->ctx, idx);
+    pthread_mutex_lock(&queue->mutex);
+    if (++batch->done == batch->njobs) {
+      pthread_cond_broadcast(&queue->done_cond);
+    }
+  }
+  pthread_mutex_unlock(&queue->mutex);
+}
+
+/*Drops one reference to the batch, freeing it if it was the last.*/
+static void od_thread_batch_unref(od_thread_batch *batch) {
+  od_thread_queue *queue;
+  int refs;
+  queue = batch->queue;
+  pthread_mutex_lock(&queue->mutex);
+  refs = --batch->refs;
+  pthread_mutex_unlock(&queue->mutex);
+  if (refs == 0) free(batch);
+}
+
+static void od_thread_batch_job(void *ctx, int idx) {
+  OD_UNUSED(idx);
+  od_thread_batch_work((od_thread_batch *)ctx);
+  od_thread_batch_unref((od_thread_batch *)ctx);
+}
+#endif
+
+/*Runs func(ctx, i) for 0 <= i < njobs and waits for all of them to finish.
+  Unlike od_thread_pool_join(), this does not wait for jobs submitted before
+   the call, so it may be used while other work is still in flight.
+  Indices are started in increasing order.*/
+void od_thread_pool_run(od_thread_pool *pool, od_thread_func func,
+ void *ctx, int njobs) {
+  int i;
+#if defined(OD_ENABLE_THREADS)
+  if (pool->nworkers > 0 && njobs > 1) {
+    od_thread_queue *queue;
+    od_thread_batch *batch;
+    int nhelpers;
+    batch = (od_thread_batch *)malloc(sizeof(*batch));
+    if (OD_LIKELY(batch != NULL)) {
+      queue = pool->queue;
+      nhelpers = OD_MINI(njobs - 1, pool->nworkers);
+      batch->queue = queue;
+      batch->func = func;
+      batch->ctx = ctx;
+      batch->njobs = njobs;
+      batch->next = 0;
+      batch->done = 0;
+      batch->refs = nhelpers + 1;
+      for (i = 0; i < nhelpers; i++) {
+        od_thread_pool_submit(pool, od_thread_batch_job, batch, i);
+      }
+      od_thread_batch_work(batch);
+      pthread_mutex_lock(&queue->mutex);
+      while (batch->done < njobs) {
+        pthread_cond_wait(&queue->done_cond, &queue->mutex);
+      }
+      pthread_mutex_unlock(&queue->mutex);
+      od_thread_batch_unref(batch);
+      return;
+    }
+  }
+#else
+  OD_UNUSED(pool);
+#endif
+  for (i = 0; i < njobs; i++) (*func)(ctx, i);
+}
+
+int od_progress_init(od_progress *progress) {
+  progress->value = 0;
+#if defined(OD_ENABLE_THREADS)
+  if (pthread_mutex_init(&progress->mutex, NULL)) return OD_EFAULT;
+  if (pthread_cond_init(&progress->cond, NULL)) {
+    pthread_mutex_destroy(&progress->mutex);
+    return OD_EFAULT;
+  }
+#endif
+  return OD_SUCCESS;
+}
+
+void od_progress_clear(od_progress *progress) {
+#if defined(OD_ENABLE_THREADS)
+  pthread_cond_destroy(&progress->cond);
+  pthread_mutex_destroy(&progress->mutex);
+#else
+  OD_UNUSED(progress);
+#endif
+}
+
+/*Unlike od_progress_set(), this may move the counter backwards.
+  It must only be called while no thread is waiting on it.*/
+void od_progress_reset(od_progress *progress, int value) {
+#if defined(OD_ENABLE_THREADS)
+  pthread_mutex_lock(&progress->mutex);
+  progress->value = value;
+  pthread_mutex_unlock(&progress->mutex);
+#else
+  progress->value = value;
+#endif
+}
+
+/*Publishes a new value and wakes any thread waiting for it.
+  Values smaller than the current one are ignored.*/
+void od_progress_set(od_progress *progress, int value) {
+#if defined(OD_ENABLE_THREADS)
+  pthread_mutex_lock(&progress->mutex);
+  if (value > progress->value) {
+    progress->value = value;
+    pthread_cond_broadcast(&progress->cond);
+  }
+  pthread_mutex_unlock(&progress->mutex);
+#else
+  progress->value = OD_MAXI(progress->value, value);
+#endif
+}
+
+int od_progress_get(od_progress *progress) {
+  int value;
+#if defined(OD_ENABLE_THREADS)
+  pthread_mutex_lock(&progress->mutex);
+  value = progress->value;
+  pthread_mutex_unlock(&progress->mutex);
+#else
+  value = progress->value;
+#endif
+  return value;
+}
+
+/*Blocks until the counter reaches at least value.*/
+void od_progress_wait(od_progress *progress, int value) {
+#if defined(OD_ENABLE_THREADS)
+  pthread_mutex_lock(&progress->mutex);
+  while (progress->value < value) {
+    pthread_cond_wait(&progress->cond, &progress->mutex);
+  }
+  pthread_mutex_unlock(&progress->mutex);
+#else
+  /*Without threads, everything this could wait on has already run.*/
+  OD_UNUSED(progress);
+  OD_UNUSED(value);
+  OD_ASSERT(progress->value >= value);
+#endif
+}
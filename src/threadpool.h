@@ -0,0 +1,114 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#if !defined(_threadpool_H)
+# define _threadpool_H (1)
+
+# if defined(OD_ENABLE_THREADS)
+#  include <pthread.h>
+# endif
+
+/*The maximum number of threads (including the calling thread) a pool may
+   use.*/
+# define OD_THREADS_MAX (64)
+
+typedef struct od_thread_job   od_thread_job;
+typedef struct od_thread_queue od_thread_queue;
+typedef struct od_thread_pool  od_thread_pool;
+typedef struct od_progress     od_progress;
+
+/*A unit of work: func(ctx, idx).
+  Jobs submitted to the same pool may run concurrently and in any order, so
+   they must only touch state that is private to idx, or synchronize through
+   an od_progress counter published by a job submitted earlier.*/
+typedef void (*od_thread_func)(void *_ctx, int _idx);
+
+struct od_thread_job {
+  od_thread_func func;
+  void *ctx;
+  int idx;
+};
+
+# if defined(OD_ENABLE_THREADS)
+/*The part of a pool shared with its worker threads.*/
+struct od_thread_queue {
+  pthread_mutex_t mutex;
+  /*Signaled when a job is queued or the pool is shutting down.*/
+  pthread_cond_t job_cond;
+  /*Signaled when the last outstanding job finishes.*/
+  pthread_cond_t done_cond;
+  /*Circular job queue, grown as needed.*/
+  od_thread_job *jobs;
+  int jobs_sz;
+  int head;
+  int njobs;
+  /*The number of jobs queued or still running.*/
+  int pending;
+  int stop;
+};
+# endif
+
+/*A fixed set of worker threads pulling jobs from a shared FIFO queue.
+  The thread that calls od_thread_pool_join() executes queued jobs too, so a
+   pool of nthreads runs nthreads - 1 workers.
+  With a single thread (or when built without thread support), jobs are run
+   immediately by od_thread_pool_submit().
+  Nothing in this struct changes once the pool is started, so it may be
+   copied (e.g., along with an od_state) while jobs are running.*/
+struct od_thread_pool {
+  /*The total number of threads, including the calling thread.*/
+  int nthreads;
+# if defined(OD_ENABLE_THREADS)
+  pthread_t *workers;
+  int nworkers;
+  od_thread_queue *queue;
+# endif
+};
+
+/*A monotonically increasing counter that one thread publishes and others
+   wait on, e.g., the number of rows of a frame that are finished.*/
+struct od_progress {
+  int value;
+# if defined(OD_ENABLE_THREADS)
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+# endif
+};
+
+int od_thread_pool_init(od_thread_pool *_pool, int _nthreads);
+void od_thread_pool_clear(od_thread_pool *_pool);
+void od_thread_pool_submit(od_thread_pool *_pool, od_thread_func _func,
+ void *_ctx, int _idx);
+void od_thread_pool_join(od_thread_pool *_pool);
+void od_thread_pool_run(od_thread_pool *_pool, od_thread_func _func,
+ void *_ctx, int _njobs);
+
+int od_progress_init(od_progress *_progress);
+void od_progress_clear(od_progress *_progress);
+void od_progress_reset(od_progress *_progress, int _value);
+void od_progress_set(od_progress *_progress, int _value);
+int od_progress_get(od_progress *_progress);
+void od_progress_wait(od_progress *_progress, int _value);
+
+#endif
@@ -0,0 +1,232 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86enc.h"
+#include "x86int.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(OD_X86ASM)
+#include <immintrin.h>
+
+#if defined(OD_CHECKASM)
+static void od_compute_stats_check(const signed char *img, int stride,
+ const od_superblock_stats *stats) {
+  od_superblock_stats stats_c;
+  od_compute_stats_c(img, stride, &stats_c);
+  if (memcmp(stats, &stats_c, sizeof(stats_c)) != 0) {
+    fprintf(stderr, "od_compute_stats check failed.\n");
+  }
+}
+
+static void od_psy_log_sum_check(const int32_t *inv_var, int stride, int n,
+ int32_t noise, int32_t sum) {
+  int32_t sum_c;
+  sum_c = od_psy_log_sum_c(inv_var, stride, n, noise);
+  if (sum != sum_c) {
+    fprintf(stderr, "ASM mismatch: sum %li!=%li\n", (long)sum_c, (long)sum);
+    fprintf(stderr, "od_psy_log_sum check failed.\n");
+  }
+}
+#endif
+
+/*Computes the clamped variances and inverse variances of eight blocks of
+   1 << log_n pixels from their sums and sums of squares, as done by
+   od_compute_stats_c().*/
+OD_SIMD_INLINE void od_var_inv_var_epi32(int32_t *var, int32_t *inv_var,
+ __m256i sx, __m256i sxx, int log_n) {
+  __m256i v;
+  __m256i var_floor;
+  v = _mm256_srai_epi32(_mm256_sub_epi32(sxx,
+   _mm256_srai_epi32(_mm256_mullo_epi32(sx, sx), log_n)), 5);
+  var_floor = _mm256_add_epi32(_mm256_set1_epi32(4), _mm256_srai_epi32(
+   _mm256_add_epi32(sx, _mm256_set1_epi32(128 << log_n)), 8));
+  v = _mm256_max_epi32(v, var_floor);
+  _mm256_storeu_si256((__m256i *)var, v);
+  /*The variance is at least 4, so the single-precision quotient is never
+     close enough to the next integer to round up to it, and truncating it
+     matches the integer division.*/
+  _mm256_storeu_si256((__m256i *)inv_var, _mm256_cvttps_epi32(
+   _mm256_div_ps(_mm256_set1_ps(16384), _mm256_cvtepi32_ps(v))));
+}
+
+void od_compute_stats_avx2(const signed char *img, int stride,
+ od_superblock_stats *stats) {
+  const signed char *x;
+  __m256i ones;
+  int i;
+  int j;
+  int off8;
+  ones = _mm256_set1_epi16(1);
+  x = img - OD_BLOCK_OFFSET(stride);
+  /*The last group of each row overlaps the previous one, so that we never
+     read past the margin.*/
+  for (i = 0; i < OD_SIZE2_SUMS; i++) {
+    for (j = 0; j < OD_SIZE2_SUMS; j += 8) {
+      __m256i a;
+      __m256i b;
+      int k;
+      k = OD_MINI(j, OD_SIZE2_SUMS - 8);
+      a = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(x + 2*k)));
+      b = _mm256_cvtepi8_epi16(
+       _mm_loadu_si128((const __m128i *)(x + stride + 2*k)));
+      _mm256_storeu_si256((__m256i *)&stats->Sx2[i][k],
+       _mm256_madd_epi16(_mm256_add_epi16(a, b), ones));
+      _mm256_storeu_si256((__m256i *)&stats->Sxx2[i][k], _mm256_add_epi32(
+       _mm256_madd_epi16(a, a), _mm256_madd_epi16(b, b)));
+    }
+    x += 2*stride;
+  }
+  for (i = 0; i < OD_SIZE4_SUMS; i++) {
+    for (j = 0; j < OD_SIZE4_SUMS; j += 8) {
+      __m256i sx;
+      __m256i sxx;
+      int k;
+      k = OD_MINI(j, OD_SIZE4_SUMS - 8);
+      sx = _mm256_add_epi32(
+       _mm256_add_epi32(_mm256_loadu_si256((__m256i *)&stats->Sx2[i][k]),
+       _mm256_loadu_si256((__m256i *)&stats->Sx2[i][k + 1])),
+       _mm256_add_epi32(_mm256_loadu_si256((__m256i *)&stats->Sx2[i + 1][k]),
+       _mm256_loadu_si256((__m256i *)&stats->Sx2[i + 1][k + 1])));
+      sxx = _mm256_add_epi32(
+       _mm256_add_epi32(_mm256_loadu_si256((__m256i *)&stats->Sxx2[i][k]),
+       _mm256_loadu_si256((__m256i *)&stats->Sxx2[i][k + 1])),
+       _mm256_add_epi32(
+       _mm256_loadu_si256((__m256i *)&stats->Sxx2[i + 1][k]),
+       _mm256_loadu_si256((__m256i *)&stats->Sxx2[i + 1][k + 1])));
+      _mm256_storeu_si256((__m256i *)&stats->Sx4[i][k], sx);
+      _mm256_storeu_si256((__m256i *)&stats->Sxx4[i][k], sxx);
+      od_var_inv_var_epi32(&stats->Var4[i][k], &stats->invVar4[i][k],
+       sx, sxx, 4);
+    }
+  }
+  off8 = OD_MAX_OVERLAP - 2*OD_MAX_OVERLAP_8;
+  OD_ASSERT(off8 >= 0);
+  for (i = 0; i < OD_SIZE8_SUMS; i++) {
+    for (j = 0; j < OD_SIZE8_SUMS; j++) {
+      stats->Sx8[i][j] = stats->Sx4[2*i + off8][2*j + off8]
+       + stats->Sx4[2*i + off8][2*j + 2 + off8]
+       + stats->Sx4[2*i + 2 + off8][2*j + off8]
+       + stats->Sx4[2*i + 2 + off8][2*j + 2 + off8];
+      stats->Sxx8[i][j] = stats->Sxx4[2*i + off8][2*j + off8]
+       + stats->Sxx4[2*i + off8][2*j + 2 + off8]
+       + stats->Sxx4[2*i + 2 + off8][2*j + off8]
+       + stats->Sxx4[2*i + 2 + off8][2*j + 2 + off8];
+    }
+    for (j = 0; j < OD_SIZE8_SUMS; j += 8) {
+      int k;
+      k = OD_MINI(j, OD_SIZE8_SUMS - 8);
+      od_var_inv_var_epi32(&stats->Var8[i][k], &stats->invVar8[i][k],
+       _mm256_loadu_si256((__m256i *)&stats->Sx8[i][k]),
+       _mm256_loadu_si256((__m256i *)&stats->Sxx8[i][k]), 6);
+    }
+  }
+#if defined(OD_CHECKASM)
+  od_compute_stats_check(img, stride, stats);
+#endif
+}
+
+/*Computes od_psy_log2() of each lane of t.*/
+OD_SIMD_INLINE __m256i od_psy_log2_epi32(__m256i t) {
+  __m256i e;
+  __m256i m;
+  __m256i x;
+  __m256i p;
+  /*Normalize t to [1 << 27, 1 << 28), subtracting the shifts from the
+     exponent.*/
+  e = _mm256_set1_epi32(27 - 14);
+  m = _mm256_cmpgt_epi32(_mm256_set1_epi32(1 << 20), t);
+  t = _mm256_blendv_epi8(t, _mm256_slli_epi32(t, 8), m);
+  e = _mm256_add_epi32(e, _mm256_and_si256(m, _mm256_set1_epi32(-8)));
+  m = _mm256_cmpgt_epi32(_mm256_set1_epi32(1 << 24), t);
+  t = _mm256_blendv_epi8(t, _mm256_slli_epi32(t, 4), m);
+  e = _mm256_add_epi32(e, _mm256_and_si256(m, _mm256_set1_epi32(-4)));
+  m = _mm256_cmpgt_epi32(_mm256_set1_epi32(1 << 26), t);
+  t = _mm256_blendv_epi8(t, _mm256_slli_epi32(t, 2), m);
+  e = _mm256_add_epi32(e, _mm256_and_si256(m, _mm256_set1_epi32(-2)));
+  m = _mm256_cmpgt_epi32(_mm256_set1_epi32(1 << 27), t);
+  t = _mm256_blendv_epi8(t, _mm256_slli_epi32(t, 1), m);
+  e = _mm256_add_epi32(e, m);
+  x = _mm256_and_si256(_mm256_srli_epi32(t, 12), _mm256_set1_epi32(0x7FFF));
+  p = _mm256_add_epi32(_mm256_set1_epi32(OD_PSY_LOG2_C4), _mm256_srai_epi32(
+   _mm256_mullo_epi32(x, _mm256_set1_epi32(OD_PSY_LOG2_C5)), 15));
+  p = _mm256_add_epi32(_mm256_set1_epi32(OD_PSY_LOG2_C3),
+   _mm256_srai_epi32(_mm256_mullo_epi32(x, p), 15));
+  p = _mm256_add_epi32(_mm256_set1_epi32(OD_PSY_LOG2_C2),
+   _mm256_srai_epi32(_mm256_mullo_epi32(x, p), 15));
+  p = _mm256_add_epi32(_mm256_set1_epi32(OD_PSY_LOG2_C1),
+   _mm256_srai_epi32(_mm256_mullo_epi32(x, p), 15));
+  x = _mm256_add_epi32(x, _mm256_srai_epi32(_mm256_mullo_epi32(x, p), 15));
+  return _mm256_add_epi32(_mm256_slli_epi32(e, OD_PSY_LOG2_SHIFT), x);
+}
+
+int32_t od_psy_log_sum_avx2(const int32_t *inv_var, int stride, int n,
+ int32_t noise) {
+  __m256i sum;
+  __m256i nz;
+  __m256i base;
+  __m256i mask;
+  __m128i s;
+  int32_t ret;
+  int i;
+  sum = _mm256_setzero_si256();
+  nz = _mm256_set1_epi32(noise);
+  base = _mm256_set1_epi32(16384);
+  mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(n & 7),
+   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  for (i = 0; i < n; i++) {
+    const int32_t *row;
+    __m256i v;
+    int j;
+    row = inv_var + i*stride;
+    for (j = 0; j + 8 <= n; j += 8) {
+      v = _mm256_loadu_si256((const __m256i *)(row + j));
+      sum = _mm256_add_epi32(sum, od_psy_log2_epi32(
+       _mm256_add_epi32(base, _mm256_mullo_epi32(v, nz))));
+    }
+    if (j < n) {
+      /*A zero inverse variance contributes exactly zero, so the masked lanes
+         need no special treatment.*/
+      v = _mm256_maskload_epi32(row + j, mask);
+      sum = _mm256_add_epi32(sum, od_psy_log2_epi32(
+       _mm256_add_epi32(base, _mm256_mullo_epi32(v, nz))));
+    }
+  }
+  s = _mm_add_epi32(_mm256_castsi256_si128(sum),
+   _mm256_extracti128_si256(sum, 1));
+  s = _mm_add_epi32(s, _mm_unpackhi_epi64(s, s));
+  s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+  ret = _mm_cvtsi128_si32(s);
+#if defined(OD_CHECKASM)
+  od_psy_log_sum_check(inv_var, stride, n, noise, ret);
+#endif
+  return ret;
+}
+
+#endif
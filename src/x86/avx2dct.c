@@ -88,5 +88,12 @@ OD_SIMD_INLINE od_m256i mul_epi32_256(od_m256i a, int b1) {
 
 #define od_bin_fdct8x8_x86 od_bin_fdct8x8_avx2
 #define od_bin_idct8x8_x86 od_bin_idct8x8_avx2
+#define od_bin_fdct16x16_x86 od_bin_fdct16x16_avx2
+#define od_bin_idct16x16_x86 od_bin_idct16x16_avx2
+#define od_bin_fdct32x32_x86 od_bin_fdct32x32_avx2
+#define od_bin_idct32x32_x86 od_bin_idct32x32_avx2
+#define od_bin_fdct64x64_x86 od_bin_fdct64x64_avx2
+#define od_bin_idct64x64_x86 od_bin_idct64x64_avx2
 
 #include "x86dct.h"
+#include "x86dctlarge.h"
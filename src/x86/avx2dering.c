@@ -0,0 +1,230 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#if defined(HAVE_CONFIG_H)
+# include "config.h"
+#endif
+
+#include "x86int.h"
+#include "cpu.h"
+
+#include <stdio.h>
+
+#if defined(OD_X86ASM)
+#include <immintrin.h>
+#include "../dering.h"
+
+#if defined(OD_CHECKASM)
+static void od_dir_find8_check(const od_dering_in *img, int stride,
+ int coeff_shift, int dir, int32_t var) {
+  int32_t var_c;
+  int dir_c;
+  dir_c = od_dir_find8_c(img, stride, &var_c, coeff_shift);
+  if (dir != dir_c || var != var_c) {
+    fprintf(stderr, "ASM mismatch: dir %i!=%i, var %i!=%i\n",
+     dir_c, dir, var_c, var);
+    fprintf(stderr, "od_dir_find8 check failed.\n");
+  }
+}
+#endif
+
+/*Adds row, shifted up by s lanes within each 128-bit half, to the 15-lane
+   partial sums in (a, b).*/
+#define OD_DIR_ACCUM(a, b, row, s) \
+  do { \
+    (a) = _mm256_add_epi16(a, _mm256_slli_si256(row, 2*(s))); \
+    (b) = _mm256_add_epi16(b, _mm256_srli_si256(row, 16 - 2*(s))); \
+  } \
+  while (0)
+
+OD_SIMD_INLINE __m256i od_dir_fold_avx2(__m256i pa, __m256i pb, __m256i rev,
+ __m256i wa, __m256i wb) {
+  __m256i lo;
+  __m256i hi;
+  pb = _mm256_shuffle_epi8(pb, rev);
+  lo = _mm256_unpacklo_epi16(pa, pb);
+  hi = _mm256_unpackhi_epi16(pa, pb);
+  return _mm256_add_epi32(_mm256_mullo_epi32(_mm256_madd_epi16(lo, lo), wa),
+   _mm256_mullo_epi32(_mm256_madd_epi16(hi, hi), wb));
+}
+
+OD_SIMD_INLINE __m256i od_hsum4_epi32_avx2(__m256i x0, __m256i x1,
+ __m256i x2, __m256i x3) {
+  __m256i t0;
+  __m256i t1;
+  __m256i t2;
+  __m256i t3;
+  t0 = _mm256_unpacklo_epi32(x0, x1);
+  t1 = _mm256_unpacklo_epi32(x2, x3);
+  t2 = _mm256_unpackhi_epi32(x0, x1);
+  t3 = _mm256_unpackhi_epi32(x2, x3);
+  x0 = _mm256_unpacklo_epi64(t0, t1);
+  x1 = _mm256_unpackhi_epi64(t0, t1);
+  x2 = _mm256_unpacklo_epi64(t2, t3);
+  x3 = _mm256_unpackhi_epi64(t2, t3);
+  return _mm256_add_epi32(_mm256_add_epi32(x0, x1),
+   _mm256_add_epi32(x2, x3));
+}
+
+/*Same as od_dir_costs_sse41(), but with the block in the low half of each
+   line and its reversed transpose in the high half, so that all eight
+   costs come out of one pass: {0, 5, 6, 7, 4, 1, 2, 3}.*/
+OD_SIMD_INLINE __m256i od_dir_costs_avx2(const __m256i *lines) {
+  __m256i p0a;
+  __m256i p0b;
+  __m256i p5a;
+  __m256i p5b;
+  __m256i p6;
+  __m256i p7a;
+  __m256i p7b;
+  __m256i pair;
+  __m256i rev15;
+  __m256i rev11;
+  __m256i w8;
+  p0a = p0b = p5a = p5b = p7a = p7b = _mm256_setzero_si256();
+  OD_DIR_ACCUM(p0a, p0b, lines[0], 0);
+  OD_DIR_ACCUM(p0a, p0b, lines[1], 1);
+  OD_DIR_ACCUM(p0a, p0b, lines[2], 2);
+  OD_DIR_ACCUM(p0a, p0b, lines[3], 3);
+  OD_DIR_ACCUM(p0a, p0b, lines[4], 4);
+  OD_DIR_ACCUM(p0a, p0b, lines[5], 5);
+  OD_DIR_ACCUM(p0a, p0b, lines[6], 6);
+  OD_DIR_ACCUM(p0a, p0b, lines[7], 7);
+  pair = _mm256_add_epi16(lines[0], lines[1]);
+  p6 = pair;
+  OD_DIR_ACCUM(p5a, p5b, pair, 3);
+  OD_DIR_ACCUM(p7a, p7b, pair, 0);
+  pair = _mm256_add_epi16(lines[2], lines[3]);
+  p6 = _mm256_add_epi16(p6, pair);
+  OD_DIR_ACCUM(p5a, p5b, pair, 2);
+  OD_DIR_ACCUM(p7a, p7b, pair, 1);
+  pair = _mm256_add_epi16(lines[4], lines[5]);
+  p6 = _mm256_add_epi16(p6, pair);
+  OD_DIR_ACCUM(p5a, p5b, pair, 1);
+  OD_DIR_ACCUM(p7a, p7b, pair, 2);
+  pair = _mm256_add_epi16(lines[6], lines[7]);
+  p6 = _mm256_add_epi16(p6, pair);
+  OD_DIR_ACCUM(p5a, p5b, pair, 0);
+  OD_DIR_ACCUM(p7a, p7b, pair, 3);
+  rev15 = _mm256_setr_epi8(12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1, 14, 15,
+   12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1, 14, 15);
+  rev11 = _mm256_setr_epi8(4, 5, 2, 3, 0, 1, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+   4, 5, 2, 3, 0, 1, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  w8 = _mm256_set1_epi32(105);
+  p0a = od_dir_fold_avx2(p0a, p0b, rev15,
+   _mm256_setr_epi32(840, 420, 280, 210, 840, 420, 280, 210),
+   _mm256_setr_epi32(168, 140, 120, 105, 168, 140, 120, 105));
+  p5a = od_dir_fold_avx2(p5a, p5b, rev11,
+   _mm256_setr_epi32(420, 210, 140, 105, 420, 210, 140, 105), w8);
+  p7a = od_dir_fold_avx2(p7a, p7b, rev11,
+   _mm256_setr_epi32(420, 210, 140, 105, 420, 210, 140, 105), w8);
+  p6 = _mm256_mullo_epi32(_mm256_madd_epi16(p6, p6), w8);
+  return od_hsum4_epi32_avx2(p0a, p5a, p6, p7a);
+}
+
+/*Transposes the 8x8 block in lines into tlines, with the rows of the result
+   in reverse order.*/
+OD_SIMD_INLINE void od_transpose_rev8x8_epi16(__m128i *tlines,
+ const __m128i *lines) {
+  __m128i a0;
+  __m128i a1;
+  __m128i a2;
+  __m128i a3;
+  __m128i a4;
+  __m128i a5;
+  __m128i a6;
+  __m128i a7;
+  __m128i b0;
+  __m128i b1;
+  __m128i b2;
+  __m128i b3;
+  __m128i b4;
+  __m128i b5;
+  __m128i b6;
+  __m128i b7;
+  a0 = _mm_unpacklo_epi16(lines[0], lines[1]);
+  a1 = _mm_unpackhi_epi16(lines[0], lines[1]);
+  a2 = _mm_unpacklo_epi16(lines[2], lines[3]);
+  a3 = _mm_unpackhi_epi16(lines[2], lines[3]);
+  a4 = _mm_unpacklo_epi16(lines[4], lines[5]);
+  a5 = _mm_unpackhi_epi16(lines[4], lines[5]);
+  a6 = _mm_unpacklo_epi16(lines[6], lines[7]);
+  a7 = _mm_unpackhi_epi16(lines[6], lines[7]);
+  b0 = _mm_unpacklo_epi32(a0, a2);
+  b1 = _mm_unpackhi_epi32(a0, a2);
+  b2 = _mm_unpacklo_epi32(a4, a6);
+  b3 = _mm_unpackhi_epi32(a4, a6);
+  b4 = _mm_unpacklo_epi32(a1, a3);
+  b5 = _mm_unpackhi_epi32(a1, a3);
+  b6 = _mm_unpacklo_epi32(a5, a7);
+  b7 = _mm_unpackhi_epi32(a5, a7);
+  tlines[7] = _mm_unpacklo_epi64(b0, b2);
+  tlines[6] = _mm_unpackhi_epi64(b0, b2);
+  tlines[5] = _mm_unpacklo_epi64(b1, b3);
+  tlines[4] = _mm_unpackhi_epi64(b1, b3);
+  tlines[3] = _mm_unpacklo_epi64(b4, b6);
+  tlines[2] = _mm_unpackhi_epi64(b4, b6);
+  tlines[1] = _mm_unpacklo_epi64(b5, b7);
+  tlines[0] = _mm_unpackhi_epi64(b5, b7);
+}
+
+int od_dir_find8_avx2(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift) {
+  __m128i rows[8];
+  __m128i trows[8];
+  __m256i lines[8];
+  int32_t c[8];
+  int32_t cost[8];
+  int i;
+  int dir;
+  /*The 16-bit partial sums need the input to be scaled down to 12 bits.*/
+  if (coeff_shift < OD_COEFF_SHIFT) {
+    return od_dir_find8_c(img, stride, var, coeff_shift);
+  }
+  for (i = 0; i < 8; i++) {
+    rows[i] = _mm_srai_epi16(_mm_loadu_si128((const __m128i *)&img[i*stride]),
+     coeff_shift);
+  }
+  od_transpose_rev8x8_epi16(trows, rows);
+  for (i = 0; i < 8; i++) {
+    lines[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(rows[i]),
+     trows[i], 1);
+  }
+  _mm256_storeu_si256((__m256i *)c, od_dir_costs_avx2(lines));
+  cost[0] = c[0];
+  cost[5] = c[1];
+  cost[6] = c[2];
+  cost[7] = c[3];
+  cost[4] = c[4];
+  cost[1] = c[5];
+  cost[2] = c[6];
+  cost[3] = c[7];
+  dir = od_dir_find8_best(cost, var);
+#if defined(OD_CHECKASM)
+  od_dir_find8_check(img, stride, coeff_shift, dir, *var);
+#endif
+  return dir;
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86enc.h"
+#include "x86int.h"
+
+#include <stdio.h>
+
+#if defined(OD_X86ASM)
+#include <immintrin.h>
+
+#if defined(OD_CHECKASM)
+static void od_compute_var_8x8_check(const int32_t var[9],
+ const od_coeff *x, int stride) {
+  int32_t var_c[9];
+  int failed;
+  int i;
+  od_compute_var_8x8_c(var_c, x, stride);
+  failed = 0;
+  for (i = 0; i < 9; i++) {
+    if (var[i] != var_c[i]) {
+      fprintf(stderr, "ASM mismatch: var[%i] %li!=%li\n",
+       i, (long)var_c[i], (long)var[i]);
+      failed = 1;
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "od_compute_var_8x8 check failed.\n");
+  }
+}
+
+static void od_compute_dist_lp_check(const double *lp_energy,
+ const od_coeff *x, const od_coeff *y, int n) {
+  double lp_energy_c[(OD_BSIZE_MAX >> 3)*(OD_BSIZE_MAX >> 3)];
+  int failed;
+  int i;
+  od_compute_dist_lp_c(lp_energy_c, x, y, n);
+  failed = 0;
+  for (i = 0; i < (n >> 3)*(n >> 3); i++) {
+    if (lp_energy[i] != lp_energy_c[i]) {
+      fprintf(stderr, "ASM mismatch: lp_energy[%i] %G!=%G\n",
+       i, lp_energy_c[i], lp_energy[i]);
+      failed = 1;
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "od_compute_dist_lp check failed.\n");
+  }
+}
+#endif
+
+void od_compute_var_8x8_avx2(int32_t var[9], const od_coeff *x,
+ int stride) {
+  __m256i s[4];
+  __m256i q[4];
+  __m128i v[3];
+  int i;
+  /*Sum pairs of rows, so that each window is the sum of two pairs.*/
+  for (i = 0; i < 4; i++) {
+    __m256i r0;
+    __m256i r1;
+    r0 = _mm256_srai_epi32(_mm256_loadu_si256(
+     (const __m256i *)(x + 2*i*stride)), 2);
+    r1 = _mm256_srai_epi32(_mm256_loadu_si256(
+     (const __m256i *)(x + (2*i + 1)*stride)), 2);
+    s[i] = _mm256_add_epi32(r0, r1);
+    q[i] = _mm256_add_epi32(_mm256_mullo_epi32(r0, r0),
+     _mm256_mullo_epi32(r1, r1));
+  }
+  for (i = 0; i < 3; i++) {
+    __m256i p;
+    __m128i sum;
+    __m128i s2;
+    /*Sum pairs of columns, giving the four pairs of sums in the low half and
+       the four pairs of sums of squares in the high half.*/
+    p = _mm256_hadd_epi32(_mm256_add_epi32(s[i], s[i + 1]),
+     _mm256_add_epi32(q[i], q[i + 1]));
+    p = _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 1, 2, 0));
+    p = _mm256_add_epi32(p, _mm256_srli_si256(p, 4));
+    sum = _mm256_castsi256_si128(p);
+    s2 = _mm256_extracti128_si256(p, 1);
+    v[i] = _mm_sub_epi32(s2, _mm_srai_epi32(_mm_mullo_epi32(sum, sum), 4));
+  }
+  /*Each store spills one lane that the next one overwrites, except the
+     last.*/
+  _mm_storeu_si128((__m128i *)var, v[0]);
+  _mm_storeu_si128((__m128i *)(var + 3), v[1]);
+  _mm_storel_epi64((__m128i *)(var + 6), v[2]);
+  var[8] = _mm_extract_epi32(v[2], 2);
+#if defined(OD_CHECKASM)
+  od_compute_var_8x8_check(var, x, stride);
+#endif
+}
+
+/*The squares are exact in double precision, and so are their sums for any
+   realistic input, so the order in which they are added does not change the
+   result.*/
+OD_SIMD_INLINE __m256d od_add_sq_epi32_pd(__m256d acc, __m256i v) {
+  __m256d lo;
+  __m256d hi;
+  lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(v));
+  hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1));
+  return _mm256_add_pd(acc,
+   _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+}
+
+void od_compute_dist_lp_avx2(double *lp_energy, const od_coeff *x,
+ const od_coeff *y, int n) {
+  /*The horizontally filtered error, with the second and next-to-last rows
+     mirrored above and below.*/
+  od_coeff tmp[(OD_BSIZE_MAX + 2)*OD_BSIZE_MAX];
+  /*One row of the error, with the same mirroring on the left and right.*/
+  od_coeff e[OD_BSIZE_MAX + 2];
+  __m256i mid;
+  int i;
+  int j;
+  mid = _mm256_set1_epi32(OD_DIST_LP_MID);
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j += 8) {
+      _mm256_storeu_si256((__m256i *)(e + 1 + j), _mm256_sub_epi32(
+       _mm256_loadu_si256((const __m256i *)(x + i*n + j)),
+       _mm256_loadu_si256((const __m256i *)(y + i*n + j))));
+    }
+    e[0] = e[2];
+    e[n + 1] = e[n - 1];
+    for (j = 0; j < n; j += 8) {
+      __m256i t;
+      t = _mm256_mullo_epi32(_mm256_loadu_si256((__m256i *)(e + 1 + j)),
+       mid);
+      t = _mm256_add_epi32(t, _mm256_loadu_si256((__m256i *)(e + j)));
+      t = _mm256_add_epi32(t, _mm256_loadu_si256((__m256i *)(e + 2 + j)));
+      _mm256_storeu_si256((__m256i *)(tmp + (i + 1)*n + j), t);
+    }
+  }
+  OD_COPY(tmp, tmp + 2*n, n);
+  OD_COPY(tmp + (n + 1)*n, tmp + (n - 1)*n, n);
+  for (i = 0; i < n; i += 8) {
+    for (j = 0; j < n; j += 8) {
+      __m256d acc;
+      __m128d sum;
+      int k;
+      acc = _mm256_setzero_pd();
+      for (k = 0; k < 8; k++) {
+        const od_coeff *t;
+        __m256i v;
+        t = tmp + (i + k + 1)*n + j;
+        v = _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *)t), mid);
+        v = _mm256_add_epi32(v, _mm256_loadu_si256((const __m256i *)(t - n)));
+        v = _mm256_add_epi32(v, _mm256_loadu_si256((const __m256i *)(t + n)));
+        acc = od_add_sq_epi32_pd(acc, v);
+      }
+      sum = _mm_add_pd(_mm256_castpd256_pd128(acc),
+       _mm256_extractf128_pd(acc, 1));
+      _mm_storel_pd(lp_energy + (i >> 3)*(n >> 3) + (j >> 3),
+       _mm_add_pd(sum, _mm_unpackhi_pd(sum, sum)));
+    }
+  }
+#if defined(OD_CHECKASM)
+  od_compute_dist_lp_check(lp_energy, x, y, n);
+#endif
+}
+
+#endif
@@ -0,0 +1,773 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include "x86int.h"
+#include "cpu.h"
+#include "../mc.h"
+
+#if defined(OD_X86ASM)
+#include <immintrin.h>
+
+#if defined(OD_AVX2_INTRINSICS)
+
+#if defined(OD_CHECKASM)
+static void od_mc_check_avx2(const unsigned char *dst, int dystride,
+ const unsigned char *dst_c, int row_bytes, int yblk_sz, const char *name) {
+  int failed;
+  int j;
+  failed = 0;
+  for (j = 0; j < yblk_sz; j++) {
+    if (memcmp(dst + j*dystride, dst_c + j*row_bytes, row_bytes) != 0) {
+      fprintf(stderr, "ASM mismatch in row %i\n", j);
+      failed = 1;
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "%s check failed.\n", name);
+  }
+  OD_ASSERT(!failed);
+}
+#endif
+
+/*Fills 3 vectors with pairs of alternating 16 bit values for the 1D filter
+   chosen for the fractional position of x or y mv.*/
+OD_SIMD_INLINE void od_setup_alternating_filter_variables_avx2(
+ __m256i *filter_01, __m256i *filter_23, __m256i *filter_45, int mvf) {
+  const int16_t *f;
+  f = OD_SUBPEL_FILTER_SET[mvf];
+  *filter_01 = _mm256_set1_epi32(
+   (int)((uint16_t)f[0] | (uint32_t)(uint16_t)f[1] << 16));
+  *filter_23 = _mm256_set1_epi32(
+   (int)((uint16_t)f[2] | (uint32_t)(uint16_t)f[3] << 16));
+  *filter_45 = _mm256_set1_epi32(
+   (int)((uint16_t)f[4] | (uint32_t)(uint16_t)f[5] << 16));
+}
+
+/*Applies the horizontal filter to 8 pixels starting at src0 and 8 pixels
+   starting at src1, returning the 16 results (still scaled up by
+   OD_SUBPEL_COEFF_SCALE and centered on 0) in that order.
+  src0 and src1 must each have 2 pixels of apron to the left and 6 to the
+   right readable.*/
+OD_SIMD_INLINE __m256i od_mc_hfilter8_16_avx2(const unsigned char *src0,
+ const unsigned char *src1, __m256i fx01, __m256i fx23, __m256i fx45) {
+  __m256i src_vec;
+  __m256i pairs;
+  __m256i p0;
+  __m256i p1;
+  __m256i p2;
+  __m256i sums03;
+  __m256i sums47;
+  src_vec = _mm256_inserti128_si256(_mm256_castsi128_si256(
+   _mm_loadu_si128((const __m128i *)(src0 - OD_SUBPEL_TOP_APRON_SZ))),
+   _mm_loadu_si128((const __m128i *)(src1 - OD_SUBPEL_TOP_APRON_SZ)), 1);
+  /*Within each 128-bit lane, p0, p1 and p2 hold the pixel pairs
+     0,1 ... 3,4, then 4,5 ... 7,8, then 8,9 ... 11,12, unpacked to 16 bits.*/
+  pairs = _mm256_unpacklo_epi8(src_vec, _mm256_srli_si256(src_vec, 1));
+  p0 = _mm256_unpacklo_epi8(pairs, _mm256_setzero_si256());
+  p1 = _mm256_unpackhi_epi8(pairs, _mm256_setzero_si256());
+  pairs = _mm256_unpackhi_epi8(src_vec, _mm256_srli_si256(src_vec, 1));
+  p2 = _mm256_unpacklo_epi8(pairs, _mm256_setzero_si256());
+  sums03 = _mm256_add_epi32(_mm256_madd_epi16(p0, fx01),
+   _mm256_madd_epi16(_mm256_alignr_epi8(p1, p0, 8), fx23));
+  sums03 = _mm256_add_epi32(sums03, _mm256_madd_epi16(p1, fx45));
+  sums47 = _mm256_add_epi32(_mm256_madd_epi16(p1, fx01),
+   _mm256_madd_epi16(_mm256_alignr_epi8(p2, p1, 8), fx23));
+  sums47 = _mm256_add_epi32(sums47, _mm256_madd_epi16(p2, fx45));
+  sums03 = _mm256_sub_epi32(sums03,
+   _mm256_set1_epi32(128 << OD_SUBPEL_COEFF_SCALE));
+  sums47 = _mm256_sub_epi32(sums47,
+   _mm256_set1_epi32(128 << OD_SUBPEL_COEFF_SCALE));
+  return _mm256_packs_epi32(sums03, sums47);
+}
+
+/*Converts 16 unfiltered pixels to the scale of the horizontal filter output.*/
+OD_SIMD_INLINE __m256i od_mc_hcopy8_16_avx2(__m128i src_vec) {
+  return _mm256_slli_epi16(_mm256_sub_epi16(_mm256_cvtepu8_epi16(src_vec),
+   _mm256_set1_epi16(128)), OD_SUBPEL_COEFF_SCALE);
+}
+
+/*Packs 16 words to bytes with unsigned saturation, in order.*/
+OD_SIMD_INLINE __m128i od_mc_packus16_avx2(__m256i p) {
+  p = _mm256_packus_epi16(p, p);
+  return _mm256_castsi256_si128(_mm256_permute4x64_epi64(p,
+   _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+/*Blocks narrower than 8 pixels are left to the SSE2 version.
+  Both filtering stages store their output contiguously, so blocks only 8
+   pixels wide are processed two rows at a time.*/
+void od_mc_predict1fmv8_avx2(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz) {
+  int mvxf;
+  int mvyf;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int16_t *buff_p;
+  const unsigned char *src_p;
+  int16_t buff[(OD_MVBSIZE_MAX + OD_SUBPEL_BUFF_APRON_SZ)
+   *OD_MVBSIZE_MAX];
+  if (log_xblk_sz < 3) {
+    od_mc_predict1fmv8_sse2(state, dst, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  src_p = src + (mvx >> 3) + (mvy >> 3)*systride;
+  mvxf = mvx & 0x07;
+  mvyf = mvy & 0x07;
+  OD_ASSERT(log_xblk_sz == log_yblk_sz);
+  /*MC with subpel MV?*/
+  if (mvxf || mvyf) {
+    int nrows;
+    /*1st stage 1D filtering, Horizontal.
+      The apron rows are only needed when there is a vertical stage.*/
+    buff_p = buff;
+    nrows = yblk_sz;
+    if (mvyf) {
+      src_p -= systride*OD_SUBPEL_TOP_APRON_SZ;
+      nrows += OD_SUBPEL_BUFF_APRON_SZ;
+    }
+    else buff_p += xblk_sz*OD_SUBPEL_TOP_APRON_SZ;
+    if (mvxf) {
+      __m256i fx01;
+      __m256i fx23;
+      __m256i fx45;
+      od_setup_alternating_filter_variables_avx2(&fx01, &fx23, &fx45, mvxf);
+      if (xblk_sz >= 16) {
+        for (j = 0; j < nrows; j++) {
+          for (i = 0; i < xblk_sz; i += 16) {
+            _mm256_storeu_si256((__m256i *)(buff_p + i),
+             od_mc_hfilter8_16_avx2(src_p + i, src_p + i + 8,
+             fx01, fx23, fx45));
+          }
+          src_p += systride;
+          buff_p += xblk_sz;
+        }
+      }
+      else {
+        for (j = 0; j + 2 <= nrows; j += 2) {
+          _mm256_storeu_si256((__m256i *)buff_p,
+           od_mc_hfilter8_16_avx2(src_p, src_p + systride, fx01, fx23, fx45));
+          src_p += 2*systride;
+          buff_p += 2*xblk_sz;
+        }
+        if (j < nrows) {
+          _mm_storeu_si128((__m128i *)buff_p, _mm256_castsi256_si128(
+           od_mc_hfilter8_16_avx2(src_p, src_p, fx01, fx23, fx45)));
+        }
+      }
+    }
+    /*The mvx is of integer position.*/
+    else {
+      if (xblk_sz >= 16) {
+        for (j = 0; j < nrows; j++) {
+          for (i = 0; i < xblk_sz; i += 16) {
+            _mm256_storeu_si256((__m256i *)(buff_p + i), od_mc_hcopy8_16_avx2(
+             _mm_loadu_si128((const __m128i *)(src_p + i))));
+          }
+          src_p += systride;
+          buff_p += xblk_sz;
+        }
+      }
+      else {
+        for (j = 0; j + 2 <= nrows; j += 2) {
+          _mm256_storeu_si256((__m256i *)buff_p,
+           od_mc_hcopy8_16_avx2(_mm_unpacklo_epi64(
+           _mm_loadl_epi64((const __m128i *)src_p),
+           _mm_loadl_epi64((const __m128i *)(src_p + systride)))));
+          src_p += 2*systride;
+          buff_p += 2*xblk_sz;
+        }
+        if (j < nrows) {
+          _mm_storeu_si128((__m128i *)buff_p, _mm256_castsi256_si128(
+           od_mc_hcopy8_16_avx2(_mm_loadl_epi64((const __m128i *)src_p))));
+        }
+      }
+    }
+    /*2nd stage 1D filtering, Vertical.
+      Both buff and dst have a stride of xblk_sz, so the block can be
+       processed as one contiguous run of pixels.*/
+    buff_p = buff + xblk_sz*OD_SUBPEL_TOP_APRON_SZ;
+    if (mvyf) {
+      __m256i fy01;
+      __m256i fy23;
+      __m256i fy45;
+      __m256i rounding_offset;
+      od_setup_alternating_filter_variables_avx2(&fy01, &fy23, &fy45, mvyf);
+      rounding_offset = _mm256_set1_epi32(OD_SUBPEL_RND_OFFSET3);
+      for (i = 0; i < xblk_sz*yblk_sz; i += 16) {
+        __m256i row0;
+        __m256i row1;
+        __m256i sums_lo;
+        __m256i sums_hi;
+        row0 = _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (0 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz));
+        row1 = _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (1 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz));
+        sums_lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(row0, row1), fy01);
+        sums_hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(row0, row1), fy01);
+        row0 = _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (2 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz));
+        row1 = _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (3 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz));
+        sums_lo = _mm256_add_epi32(sums_lo,
+         _mm256_madd_epi16(_mm256_unpacklo_epi16(row0, row1), fy23));
+        sums_hi = _mm256_add_epi32(sums_hi,
+         _mm256_madd_epi16(_mm256_unpackhi_epi16(row0, row1), fy23));
+        row0 = _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (4 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz));
+        row1 = _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (5 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz));
+        sums_lo = _mm256_add_epi32(sums_lo,
+         _mm256_madd_epi16(_mm256_unpacklo_epi16(row0, row1), fy45));
+        sums_hi = _mm256_add_epi32(sums_hi,
+         _mm256_madd_epi16(_mm256_unpackhi_epi16(row0, row1), fy45));
+        sums_lo = _mm256_srai_epi32(_mm256_add_epi32(sums_lo, rounding_offset),
+         OD_SUBPEL_COEFF_SCALE2);
+        sums_hi = _mm256_srai_epi32(_mm256_add_epi32(sums_hi, rounding_offset),
+         OD_SUBPEL_COEFF_SCALE2);
+        _mm_storeu_si128((__m128i *)(dst + i),
+         od_mc_packus16_avx2(_mm256_packs_epi32(sums_lo, sums_hi)));
+      }
+    }
+    /*The mvy is of integer position.*/
+    else {
+      __m256i rounding_offset4;
+      /*Note the sign!*/
+      rounding_offset4 = _mm256_set1_epi16(-OD_SUBPEL_RND_OFFSET4);
+      for (i = 0; i < xblk_sz*yblk_sz; i += 16) {
+        __m256i p;
+        p = _mm256_loadu_si256((__m256i *)(buff_p + i));
+        /*See od_mc_predict1fmv8_sse2() for the ranges.*/
+        p = _mm256_max_epi16(p, rounding_offset4);
+        p = _mm256_sub_epi16(p, rounding_offset4);
+        p = _mm256_srli_epi16(p, OD_SUBPEL_COEFF_SCALE);
+        _mm_storeu_si128((__m128i *)(dst + i), od_mc_packus16_avx2(p));
+      }
+    }
+  }
+  /*MC with full-pel MV, i.e. integer position.*/
+  else {
+    (*state->opt_vtbl.od_copy_nxn[log_xblk_sz])(dst, xblk_sz, src_p,
+     systride);
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX];
+    od_mc_predict1fmv8_c(state, dst_c, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check_avx2(dst, xblk_sz, dst_c, xblk_sz, yblk_sz,
+     "od_mc_predict1fmv8");
+  }
+#endif
+}
+
+/*Applies the horizontal filter to 8 16-bit pixels starting at src, returning
+   the 8 results (scaled up by OD_SUBPEL_COEFF_SCALE and centered on 0) as
+   32-bit integers.*/
+OD_SIMD_INLINE __m256i od_mc_hfilter16_8_avx2(const int16_t *src,
+ __m256i fx01, __m256i fx23, __m256i fx45) {
+  __m256i src_vec0;
+  __m256i src_vec1;
+  __m256i sums;
+  /*Each 128-bit lane works on 4 pixels exactly like
+     od_mc_multiply_reduce_add_horizontal16_4() in sse2mc.c.*/
+  src_vec0 = _mm256_inserti128_si256(_mm256_castsi128_si256(
+   _mm_loadu_si128((const __m128i *)(src - OD_SUBPEL_TOP_APRON_SZ))),
+   _mm_loadu_si128((const __m128i *)(src + 4 - OD_SUBPEL_TOP_APRON_SZ)), 1);
+  src_vec1 = _mm256_inserti128_si256(_mm256_castsi128_si256(
+   _mm_loadu_si128((const __m128i *)(src + 1 - OD_SUBPEL_TOP_APRON_SZ))),
+   _mm_loadu_si128((const __m128i *)(src + 5 - OD_SUBPEL_TOP_APRON_SZ)), 1);
+  sums = _mm256_add_epi32(
+   _mm256_madd_epi16(_mm256_unpacklo_epi16(src_vec0, src_vec1), fx01),
+   _mm256_madd_epi16(_mm256_unpackhi_epi16(src_vec0, src_vec1), fx45));
+  src_vec0 = _mm256_srli_si256(src_vec0, 4);
+  src_vec1 = _mm256_srli_si256(src_vec1, 4);
+  sums = _mm256_add_epi32(sums,
+   _mm256_madd_epi16(_mm256_unpacklo_epi16(src_vec0, src_vec1), fx23));
+  return _mm256_sub_epi32(sums,
+   _mm256_set1_epi32(128 << (OD_COEFF_SHIFT + OD_SUBPEL_COEFF_SCALE)));
+}
+
+/*Packs 8 32-bit integers to 16 bits, in order, and clamps them to the
+   full-precision reference range.*/
+OD_SIMD_INLINE __m128i od_mc_pack_clampfpr_avx2(__m256i p) {
+  __m128i out;
+  out = _mm_packs_epi32(_mm256_castsi256_si128(p),
+   _mm256_extracti128_si256(p, 1));
+  out = _mm_min_epi16(out, _mm_set1_epi16((1 << (8 + OD_COEFF_SHIFT)) - 1));
+  return _mm_max_epi16(out, _mm_setzero_si128());
+}
+
+void od_mc_predict1fmv16_avx2(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz) {
+  int mvxf;
+  int mvyf;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int32_t *buff_p;
+  const unsigned char *src_p;
+  int16_t *dst16;
+  int32_t buff[(OD_MVBSIZE_MAX + OD_SUBPEL_BUFF_APRON_SZ)
+   *OD_MVBSIZE_MAX];
+  if (log_xblk_sz < 3) {
+    od_mc_predict1fmv16_sse2(state, dst, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  src_p = src + (mvx >> 3)*2 + (mvy >> 3)*systride;
+  dst16 = (int16_t *)dst;
+  mvxf = mvx & 0x07;
+  mvyf = mvy & 0x07;
+  OD_ASSERT(log_xblk_sz == log_yblk_sz);
+  /*MC with subpel MV?*/
+  if (mvxf || mvyf) {
+    int nrows;
+    /*1st stage 1D filtering, Horizontal.*/
+    buff_p = buff;
+    nrows = yblk_sz;
+    if (mvyf) {
+      src_p -= systride*OD_SUBPEL_TOP_APRON_SZ;
+      nrows += OD_SUBPEL_BUFF_APRON_SZ;
+    }
+    else buff_p += xblk_sz*OD_SUBPEL_TOP_APRON_SZ;
+    if (mvxf) {
+      __m256i fx01;
+      __m256i fx23;
+      __m256i fx45;
+      od_setup_alternating_filter_variables_avx2(&fx01, &fx23, &fx45, mvxf);
+      for (j = 0; j < nrows; j++) {
+        for (i = 0; i < xblk_sz; i += 8) {
+          _mm256_storeu_si256((__m256i *)(buff_p + i), od_mc_hfilter16_8_avx2(
+           (const int16_t *)src_p + i, fx01, fx23, fx45));
+        }
+        src_p += systride;
+        buff_p += xblk_sz;
+      }
+    }
+    /*The mvx is of integer position.*/
+    else {
+      for (j = 0; j < nrows; j++) {
+        for (i = 0; i < xblk_sz; i += 8) {
+          __m256i p;
+          p = _mm256_cvtepi16_epi32(
+           _mm_loadu_si128((const __m128i *)((const int16_t *)src_p + i)));
+          p = _mm256_sub_epi32(p, _mm256_set1_epi32(128 << OD_COEFF_SHIFT));
+          _mm256_storeu_si256((__m256i *)(buff_p + i),
+           _mm256_slli_epi32(p, OD_SUBPEL_COEFF_SCALE));
+        }
+        src_p += systride;
+        buff_p += xblk_sz;
+      }
+    }
+    /*2nd stage 1D filtering, Vertical.
+      As in the 8-bit version, the block is one contiguous run of pixels.*/
+    buff_p = buff + xblk_sz*OD_SUBPEL_TOP_APRON_SZ;
+    if (mvyf) {
+      const int16_t *fy;
+      __m256i fy0;
+      __m256i fy1;
+      __m256i fy2;
+      __m256i fy3;
+      __m256i fy4;
+      __m256i fy5;
+      __m256i rounding_offset;
+      fy = OD_SUBPEL_FILTER_SET[mvyf];
+      fy0 = _mm256_set1_epi32(fy[0]);
+      fy1 = _mm256_set1_epi32(fy[1]);
+      fy2 = _mm256_set1_epi32(fy[2]);
+      fy3 = _mm256_set1_epi32(fy[3]);
+      fy4 = _mm256_set1_epi32(fy[4]);
+      fy5 = _mm256_set1_epi32(fy[5]);
+      /*Round, then recenter before scaling down.*/
+      rounding_offset = _mm256_set1_epi32((1 << OD_SUBPEL_COEFF_SCALE2 >> 1)
+       + (128 << (OD_COEFF_SHIFT + OD_SUBPEL_COEFF_SCALE2)));
+      for (i = 0; i < xblk_sz*yblk_sz; i += 8) {
+        __m256i sums;
+        sums = _mm256_mullo_epi32(fy0, _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (0 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz)));
+        sums = _mm256_add_epi32(sums, _mm256_mullo_epi32(fy1,
+         _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (1 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz))));
+        sums = _mm256_add_epi32(sums, _mm256_mullo_epi32(fy2,
+         _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (2 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz))));
+        sums = _mm256_add_epi32(sums, _mm256_mullo_epi32(fy3,
+         _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (3 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz))));
+        sums = _mm256_add_epi32(sums, _mm256_mullo_epi32(fy4,
+         _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (4 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz))));
+        sums = _mm256_add_epi32(sums, _mm256_mullo_epi32(fy5,
+         _mm256_loadu_si256((__m256i *)
+         (buff_p + i + (5 - OD_SUBPEL_TOP_APRON_SZ)*xblk_sz))));
+        sums = _mm256_srai_epi32(_mm256_add_epi32(sums, rounding_offset),
+         OD_SUBPEL_COEFF_SCALE2);
+        _mm_storeu_si128((__m128i *)(dst16 + i),
+         od_mc_pack_clampfpr_avx2(sums));
+      }
+    }
+    /*The mvy is of integer position.*/
+    else {
+      __m256i rounding_offset;
+      rounding_offset = _mm256_set1_epi32((1 << OD_SUBPEL_COEFF_SCALE >> 1)
+       + (128 << (OD_COEFF_SHIFT + OD_SUBPEL_COEFF_SCALE)));
+      for (i = 0; i < xblk_sz*yblk_sz; i += 8) {
+        __m256i p;
+        p = _mm256_loadu_si256((__m256i *)(buff_p + i));
+        p = _mm256_srai_epi32(_mm256_add_epi32(p, rounding_offset),
+         OD_SUBPEL_COEFF_SCALE);
+        _mm_storeu_si128((__m128i *)(dst16 + i), od_mc_pack_clampfpr_avx2(p));
+      }
+    }
+  }
+  /*MC with full-pel MV, i.e. integer position.*/
+  else {
+    (*state->opt_vtbl.od_copy_nxn[log_xblk_sz])(dst, xblk_sz << 1, src_p,
+     systride);
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_predict1fmv16_c(state, dst_c, src, systride, mvx, mvy,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check_avx2(dst, xblk_sz << 1, dst_c, xblk_sz << 1, yblk_sz,
+     "od_mc_predict1fmv16");
+  }
+#endif
+}
+
+/*Computes the weighted sum of 16 pixels from each of 4 images and rounds it,
+   truncating the result to 16 bits like the C code's conversion to int16_t.
+  The pixels and weights must both fit in 16 bits, see od_mc_blend4_epi16()
+   in sse2mc.c.*/
+OD_SIMD_INLINE __m256i od_mc_blend4_avx2(__m256i s0, __m256i s1,
+ __m256i s2, __m256i s3, __m256i w0, __m256i w1, __m256i w2, __m256i w3,
+ __m256i round, int shift) {
+  __m256i lo;
+  __m256i hi;
+  lo = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(s0, s1),
+   _mm256_unpacklo_epi16(w0, w1)), _mm256_madd_epi16(
+   _mm256_unpacklo_epi16(s2, s3), _mm256_unpacklo_epi16(w2, w3)));
+  hi = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(s0, s1),
+   _mm256_unpackhi_epi16(w0, w1)), _mm256_madd_epi16(
+   _mm256_unpackhi_epi16(s2, s3), _mm256_unpackhi_epi16(w2, w3)));
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, round), shift);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, round), shift);
+  lo = _mm256_srai_epi32(_mm256_slli_epi32(lo, 16), 16);
+  hi = _mm256_srai_epi32(_mm256_slli_epi32(hi, 16), 16);
+  return _mm256_packs_epi32(lo, hi);
+}
+
+/*The blends below work on runs of 16 consecutive pixels of the (contiguous)
+   source images, which span several rows for blocks narrower than 16.
+  These return the column and row index of each pixel in such a run.*/
+OD_SIMD_INLINE void od_mc_blend_ij_avx2(__m256i *wi, __m256i *wj, int o,
+ int log_xblk_sz) {
+  __m256i idx;
+  idx = _mm256_add_epi16(_mm256_set1_epi16(o),
+   _mm256_set_epi16(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+  *wi = _mm256_and_si256(idx, _mm256_set1_epi16((1 << log_xblk_sz) - 1));
+  *wj = _mm256_srl_epi16(idx, _mm_cvtsi32_si128(log_xblk_sz));
+}
+
+OD_SIMD_INLINE __m256i od_mc_load_blend16_avx2(const unsigned char *src) {
+  return _mm256_loadu_si256((const __m256i *)src);
+}
+
+/*Loads 16 pixels from each of two 8-bit images, interleaved.*/
+OD_SIMD_INLINE __m256i od_mc_load_pairs8_avx2(const unsigned char *src0,
+ const unsigned char *src1) {
+  __m128i p0;
+  __m128i p1;
+  p0 = _mm_loadu_si128((const __m128i *)src0);
+  p1 = _mm_loadu_si128((const __m128i *)src1);
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(
+   _mm_unpacklo_epi8(p0, p1)), _mm_unpackhi_epi8(p0, p1), 1);
+}
+
+/*Stores a run of 16 8-bit pixels starting at the beginning of a row.*/
+OD_SIMD_INLINE void od_mc_store_blend8_avx2(unsigned char *dst, int dystride,
+ __m256i p, int log_xblk_sz) {
+  __m128i out;
+  out = od_mc_packus16_avx2(p);
+  if (log_xblk_sz >= 4) _mm_storeu_si128((__m128i *)dst, out);
+  else if (log_xblk_sz == 3) {
+    _mm_storel_epi64((__m128i *)dst, out);
+    _mm_storel_epi64((__m128i *)(dst + dystride),
+     _mm_unpackhi_epi64(out, out));
+  }
+  else {
+    *(uint32_t *)dst = _mm_cvtsi128_si32(out);
+    *(uint32_t *)(dst + dystride) = _mm_cvtsi128_si32(_mm_srli_si128(out, 4));
+    *(uint32_t *)(dst + 2*dystride) =
+     _mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+    *(uint32_t *)(dst + 3*dystride) =
+     _mm_cvtsi128_si32(_mm_srli_si128(out, 12));
+  }
+}
+
+/*Stores a run of 16 16-bit pixels starting at the beginning of a row.*/
+OD_SIMD_INLINE void od_mc_store_blend16_avx2(unsigned char *dst, int dystride,
+ __m256i p, int log_xblk_sz) {
+  __m128i lo;
+  __m128i hi;
+  if (log_xblk_sz >= 4) {
+    _mm256_storeu_si256((__m256i *)dst, p);
+    return;
+  }
+  lo = _mm256_castsi256_si128(p);
+  hi = _mm256_extracti128_si256(p, 1);
+  if (log_xblk_sz == 3) {
+    _mm_storeu_si128((__m128i *)dst, lo);
+    _mm_storeu_si128((__m128i *)(dst + dystride), hi);
+  }
+  else {
+    _mm_storel_epi64((__m128i *)dst, lo);
+    _mm_storel_epi64((__m128i *)(dst + dystride), _mm_unpackhi_epi64(lo, lo));
+    _mm_storel_epi64((__m128i *)(dst + 2*dystride), hi);
+    _mm_storel_epi64((__m128i *)(dst + 3*dystride),
+     _mm_unpackhi_epi64(hi, hi));
+  }
+}
+
+/*Computes the split weight of one image for a run of 16 pixels at
+   columns wi and rows wj, along with its increment to the next run.
+  j is the row of the first pixel.*/
+OD_SIMD_INLINE void od_mc_split_weight_avx2(__m256i *w, __m256i *dw,
+ __m256i wi, __m256i wj, int j, int s0, int dsdi, int dsdj, int ddsdidj,
+ int log_xblk_sz) {
+  __m256i dwdi;
+  dwdi = _mm256_add_epi16(_mm256_set1_epi16(dsdi),
+   _mm256_mullo_epi16(wj, _mm256_set1_epi16(ddsdidj)));
+  *w = _mm256_add_epi16(_mm256_mullo_epi16(wi, dwdi),
+   _mm256_add_epi16(_mm256_set1_epi16(s0),
+   _mm256_mullo_epi16(wj, _mm256_set1_epi16(dsdj))));
+  if (log_xblk_sz >= 4) {
+    /*The next run is 16 columns to the right in the same row.*/
+    *dw = _mm256_set1_epi16(16*(dsdi + j*ddsdidj));
+  }
+  else {
+    /*The next run is 16 >> log_xblk_sz rows down in the same columns.*/
+    *dw = _mm256_slli_epi16(_mm256_add_epi16(_mm256_set1_epi16(dsdj),
+     _mm256_mullo_epi16(wi, _mm256_set1_epi16(ddsdidj))), 4 - log_xblk_sz);
+  }
+}
+
+/*This uses the same two passes as od_mc_blend_full8_c(): the horizontal
+   pass fits in 16 bits, and its weights fit in signed bytes, so pmaddubsw
+   can form it directly from the interleaved pixels.
+  Blocks with fewer than 16 pixels, or fewer than 4 columns, use the C
+   versions here and below.*/
+void od_mc_blend_full8_avx2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz) {
+  __m256i round;
+  int log_blk_sz2;
+  int xblk_sz;
+  int yblk_sz;
+  int o;
+  if (log_xblk_sz < 2 || log_xblk_sz + log_yblk_sz < 4) {
+    od_mc_blend_full8_c(dst, dystride, src, log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2 = log_xblk_sz + log_yblk_sz;
+  round = _mm256_set1_epi32(1 << log_blk_sz2 >> 1);
+  for (o = 0; o < xblk_sz*yblk_sz; o += 16) {
+    __m256i wi;
+    __m256i wj;
+    __m256i wx;
+    __m256i wyj;
+    __m256i a;
+    __m256i b;
+    __m256i lo;
+    __m256i hi;
+    od_mc_blend_ij_avx2(&wi, &wj, o, log_xblk_sz);
+    /*Pairs of bytes (xblk_sz - i, i) for the horizontal pass.*/
+    wx = _mm256_add_epi16(_mm256_set1_epi16(xblk_sz),
+     _mm256_sub_epi16(_mm256_slli_epi16(wi, 8), wi));
+    a = _mm256_maddubs_epi16(od_mc_load_pairs8_avx2(src[0] + o, src[1] + o),
+     wx);
+    b = _mm256_maddubs_epi16(od_mc_load_pairs8_avx2(src[3] + o, src[2] + o),
+     wx);
+    wyj = _mm256_sub_epi16(_mm256_set1_epi16(yblk_sz), wj);
+    lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b),
+     _mm256_unpacklo_epi16(wyj, wj));
+    hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b),
+     _mm256_unpackhi_epi16(wyj, wj));
+    lo = _mm256_srai_epi32(_mm256_add_epi32(lo, round), log_blk_sz2);
+    hi = _mm256_srai_epi32(_mm256_add_epi32(hi, round), log_blk_sz2);
+    od_mc_store_blend8_avx2(dst + (o >> log_xblk_sz)*dystride
+     + (o & (xblk_sz - 1)), dystride, _mm256_packs_epi32(lo, hi), log_xblk_sz);
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX];
+    od_mc_blend_full8_c(dst_c, 1 << log_xblk_sz, src,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check_avx2(dst, dystride, dst_c, 1 << log_xblk_sz,
+     1 << log_yblk_sz, "od_mc_blend_full8");
+  }
+#endif
+}
+
+/*The bilinear weights of the 4 corners factor into
+   (xblk_sz - i)*(yblk_sz - j), i*(yblk_sz - j), i*j and (xblk_sz - i)*j,
+   which reproduces the two-pass interpolation of od_mc_blend_full16_c()
+   exactly.*/
+void od_mc_blend_full16_avx2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz) {
+  __m256i round;
+  int log_blk_sz2;
+  int xblk_sz;
+  int yblk_sz;
+  int o;
+  if (log_xblk_sz < 2 || log_xblk_sz + log_yblk_sz < 4) {
+    od_mc_blend_full16_c(dst, dystride, src, log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2 = log_xblk_sz + log_yblk_sz;
+  round = _mm256_set1_epi32(1 << log_blk_sz2 >> 1);
+  for (o = 0; o < xblk_sz*yblk_sz; o += 16) {
+    __m256i wi;
+    __m256i wj;
+    __m256i wxi;
+    __m256i wyj;
+    od_mc_blend_ij_avx2(&wi, &wj, o, log_xblk_sz);
+    wxi = _mm256_sub_epi16(_mm256_set1_epi16(xblk_sz), wi);
+    wyj = _mm256_sub_epi16(_mm256_set1_epi16(yblk_sz), wj);
+    od_mc_store_blend16_avx2(dst + (o >> log_xblk_sz)*dystride
+     + (o & (xblk_sz - 1))*2, dystride, od_mc_blend4_avx2(
+     od_mc_load_blend16_avx2(src[0] + o*2),
+     od_mc_load_blend16_avx2(src[1] + o*2),
+     od_mc_load_blend16_avx2(src[2] + o*2),
+     od_mc_load_blend16_avx2(src[3] + o*2), _mm256_mullo_epi16(wxi, wyj),
+     _mm256_mullo_epi16(wi, wyj), _mm256_mullo_epi16(wi, wj),
+     _mm256_mullo_epi16(wxi, wj), round, log_blk_sz2), log_xblk_sz);
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_blend_full16_c(dst_c, 2 << log_xblk_sz, src,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check_avx2(dst, dystride, dst_c, 2 << log_xblk_sz,
+     1 << log_yblk_sz, "od_mc_blend_full16");
+  }
+#endif
+}
+
+/*The weight the C code implicitly gives the first image is whatever the other
+   three leave, which we compute explicitly here.
+  The weight of image k at (i, j) is
+   s0[k] + j*dsdj[k] + i*(dsdi[k] + j*ddsdidj[k]).
+  It is evaluated directly at the start of each row (or of the whole block,
+   when a run of 16 pixels spans several rows), and stepped by a constant
+   increment from one run to the next.*/
+void od_mc_blend_full_split16_avx2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz) {
+  int s0[4];
+  int dsdi[4];
+  int dsdj[4];
+  int ddsdidj[4];
+  __m256i round;
+  __m256i wsum;
+  __m256i w1;
+  __m256i w2;
+  __m256i w3;
+  __m256i dw1;
+  __m256i dw2;
+  __m256i dw3;
+  int log_blk_sz2p1;
+  int xblk_sz;
+  int yblk_sz;
+  int o;
+  if (log_xblk_sz < 2 || log_xblk_sz + log_yblk_sz < 4) {
+    od_mc_blend_full_split16_c(dst, dystride, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2p1 = log_xblk_sz + log_yblk_sz + 1;
+  round = _mm256_set1_epi32(1 << log_blk_sz2p1 >> 1);
+  wsum = _mm256_set1_epi16(1 << log_blk_sz2p1);
+  od_mc_setup_s_split(s0, dsdi, dsdj, ddsdidj,
+   oc, s, log_xblk_sz, log_yblk_sz);
+  w1 = w2 = w3 = dw1 = dw2 = dw3 = _mm256_setzero_si256();
+  for (o = 0; o < xblk_sz*yblk_sz; o += 16) {
+    if (o == 0 || (log_xblk_sz >= 4 && !(o & (xblk_sz - 1)))) {
+      __m256i wi;
+      __m256i wj;
+      od_mc_blend_ij_avx2(&wi, &wj, o, log_xblk_sz);
+      od_mc_split_weight_avx2(&w1, &dw1, wi, wj, o >> log_xblk_sz,
+       s0[1], dsdi[1], dsdj[1], ddsdidj[1], log_xblk_sz);
+      od_mc_split_weight_avx2(&w2, &dw2, wi, wj, o >> log_xblk_sz,
+       s0[2], dsdi[2], dsdj[2], ddsdidj[2], log_xblk_sz);
+      od_mc_split_weight_avx2(&w3, &dw3, wi, wj, o >> log_xblk_sz,
+       s0[3], dsdi[3], dsdj[3], ddsdidj[3], log_xblk_sz);
+    }
+    od_mc_store_blend16_avx2(dst + (o >> log_xblk_sz)*dystride
+     + (o & (xblk_sz - 1))*2, dystride, od_mc_blend4_avx2(
+     od_mc_load_blend16_avx2(src[0] + o*2),
+     od_mc_load_blend16_avx2(src[1] + o*2),
+     od_mc_load_blend16_avx2(src[2] + o*2),
+     od_mc_load_blend16_avx2(src[3] + o*2), _mm256_sub_epi16(_mm256_sub_epi16(
+     _mm256_sub_epi16(wsum, w1), w2), w3), w1, w2, w3,
+     round, log_blk_sz2p1), log_xblk_sz);
+    w1 = _mm256_add_epi16(w1, dw1);
+    w2 = _mm256_add_epi16(w2, dw2);
+    w3 = _mm256_add_epi16(w3, dw3);
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_blend_full_split16_c(dst_c, 2 << log_xblk_sz, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_check_avx2(dst, dystride, dst_c, 2 << log_xblk_sz,
+     1 << log_yblk_sz, "od_mc_blend_full_split16");
+  }
+#endif
+}
+
+#endif
+#endif
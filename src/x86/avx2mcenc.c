@@ -0,0 +1,814 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include "x86enc.h"
+#include "x86int.h"
+
+#if defined(OD_X86ASM)
+#include <immintrin.h>
+
+/*Adds up the four 64-bit partial sums left by _mm256_sad_epu8().*/
+OD_SIMD_INLINE int32_t od_mm256_sad_sum(__m256i sums) {
+  __m128i sum;
+  sum = _mm_add_epi64(_mm256_castsi256_si128(sums),
+   _mm256_extracti128_si256(sums, 1));
+  sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+  return _mm_cvtsi128_si32(sum);
+}
+
+/*Loads 16 bytes from each of two rows into the two halves of a vector.*/
+OD_SIMD_INLINE __m256i od_mm256_loadu2_si128(const unsigned char *lo,
+ const unsigned char *hi) {
+  return _mm256_inserti128_si256(
+   _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)lo)),
+   _mm_loadu_si128((const __m128i *)hi), 1);
+}
+
+/*Loads 8 bytes from each of four rows.*/
+OD_SIMD_INLINE __m256i od_mm256_loadl4_epi64(const unsigned char *p,
+ int stride) {
+  __m128i lo;
+  __m128i hi;
+  lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+   _mm_loadl_epi64((const __m128i *)(p + stride)));
+  hi = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(p + 2*stride)),
+   _mm_loadl_epi64((const __m128i *)(p + 3*stride)));
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+int32_t od_mc_compute_sad8_4x4_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  __m128i src_vec;
+  __m128i ref_vec;
+  __m128i sums;
+  int32_t ret;
+  src_vec = _mm_setr_epi32(*(const int32_t *)(src + 0*systride),
+   *(const int32_t *)(src + 1*systride), *(const int32_t *)(src + 2*systride),
+   *(const int32_t *)(src + 3*systride));
+  ref_vec = _mm_setr_epi32(*(const int32_t *)(ref + 0*dystride),
+   *(const int32_t *)(ref + 1*dystride), *(const int32_t *)(ref + 2*dystride),
+   *(const int32_t *)(ref + 3*dystride));
+  sums = _mm_sad_epu8(src_vec, ref_vec);
+  sums = _mm_add_epi64(sums, _mm_unpackhi_epi64(sums, sums));
+  ret = _mm_cvtsi128_si32(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad8_check(src, systride, ref, dystride, 4, 4, ret);
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad8_8x8_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  __m256i sums;
+  int32_t ret;
+  sums = _mm256_sad_epu8(od_mm256_loadl4_epi64(src, systride),
+   od_mm256_loadl4_epi64(ref, dystride));
+  sums = _mm256_add_epi64(sums,
+   _mm256_sad_epu8(od_mm256_loadl4_epi64(src + 4*systride, systride),
+   od_mm256_loadl4_epi64(ref + 4*dystride, dystride)));
+  ret = od_mm256_sad_sum(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad8_check(src, systride, ref, dystride, 8, 8, ret);
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad8_16x16_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  __m256i sums;
+  int32_t ret;
+  int i;
+  srow = src;
+  drow = ref;
+  sums = _mm256_setzero_si256();
+  /*Two rows at a time.*/
+  for (i = 0; i < 16; i += 2) {
+    sums = _mm256_add_epi64(sums,
+     _mm256_sad_epu8(od_mm256_loadu2_si128(srow, srow + systride),
+     od_mm256_loadu2_si128(drow, drow + dystride)));
+    srow += 2*systride;
+    drow += 2*dystride;
+  }
+  ret = od_mm256_sad_sum(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad8_check(src, systride, ref, dystride, 16, 16, ret);
+#endif
+  return ret;
+}
+
+/*Handle one nxn block where n is 2^ln and n >= 32.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sad8_nxn_avx2(const int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  __m256i sums;
+  int32_t ret;
+  int n;
+  int i;
+  int j;
+  n = 1 << ln;
+  OD_ASSERT(n >= 32);
+  srow = src;
+  drow = ref;
+  sums = _mm256_setzero_si256();
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j += 32) {
+      sums = _mm256_add_epi64(sums,
+       _mm256_sad_epu8(_mm256_loadu_si256((const __m256i *)(srow + j)),
+       _mm256_loadu_si256((const __m256i *)(drow + j))));
+    }
+    srow += systride;
+    drow += dystride;
+  }
+  ret = od_mm256_sad_sum(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad8_check(src, systride, ref, dystride, n, n, ret);
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad8_32x32_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad8_nxn_avx2(5, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad8_64x64_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad8_nxn_avx2(6, src, systride, ref, dystride);
+}
+
+/*Returns the absolute differences of sixteen pairs of 16-bit values, widened
+   to 32 bits and added pairwise into eight lanes.
+  max - min is never negative, so it is exact when read back as unsigned.*/
+OD_SIMD_INLINE __m256i od_mc_sad16_x16(__m256i src, __m256i ref) {
+  __m256i d;
+  d = _mm256_sub_epi16(_mm256_max_epi16(src, ref), _mm256_min_epi16(src, ref));
+  return _mm256_add_epi32(_mm256_unpacklo_epi16(d, _mm256_setzero_si256()),
+   _mm256_unpackhi_epi16(d, _mm256_setzero_si256()));
+}
+
+/*Sums the eight 32-bit lanes and applies the same rounding as
+   od_mc_compute_sad16_c().*/
+OD_SIMD_INLINE int32_t od_mc_sad16_round(__m256i sums) {
+  __m128i sum;
+  int32_t ret;
+  sum = _mm_add_epi32(_mm256_castsi256_si128(sums),
+   _mm256_extracti128_si256(sums, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(0, 1, 2, 3)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  ret = _mm_cvtsi128_si32(sum);
+  return (ret + (1 << OD_COEFF_SHIFT >> 1)) >> OD_COEFF_SHIFT;
+}
+
+int32_t od_mc_compute_sad16_4x4_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  int32_t ret;
+  /*A row of four 16-bit pixels is 8 bytes, so the whole block fits in one
+     vector.*/
+  ret = od_mc_sad16_round(od_mc_sad16_x16(od_mm256_loadl4_epi64(src, systride),
+   od_mm256_loadl4_epi64(ref, dystride)));
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad16_check(src, systride, ref, dystride, 4, 4, ret);
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad16_8x8_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  __m256i sums;
+  int32_t ret;
+  int i;
+  srow = src;
+  drow = ref;
+  sums = _mm256_setzero_si256();
+  /*Two rows at a time.*/
+  for (i = 0; i < 8; i += 2) {
+    sums = _mm256_add_epi32(sums,
+     od_mc_sad16_x16(od_mm256_loadu2_si128(srow, srow + systride),
+     od_mm256_loadu2_si128(drow, drow + dystride)));
+    srow += 2*systride;
+    drow += 2*dystride;
+  }
+  ret = od_mc_sad16_round(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad16_check(src, systride, ref, dystride, 8, 8, ret);
+#endif
+  return ret;
+}
+
+/*Handle one nxn block where n is 2^ln and n >= 16.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sad16_nxn_avx2(const int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  __m256i sums;
+  int32_t ret;
+  int n;
+  int i;
+  int j;
+  n = 1 << ln;
+  OD_ASSERT(n >= 16);
+  srow = src;
+  drow = ref;
+  sums = _mm256_setzero_si256();
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < 2*n; j += 32) {
+      sums = _mm256_add_epi32(sums,
+       od_mc_sad16_x16(_mm256_loadu_si256((const __m256i *)(srow + j)),
+       _mm256_loadu_si256((const __m256i *)(drow + j))));
+    }
+    srow += systride;
+    drow += dystride;
+  }
+  ret = od_mc_sad16_round(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad16_check(src, systride, ref, dystride, n, n, ret);
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad16_16x16_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_avx2(4, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_32x32_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_avx2(5, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_64x64_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_avx2(6, src, systride, ref, dystride);
+}
+
+OD_SIMD_INLINE void od_mc_butterfly_2x2_32x4(__m128i *t0, __m128i *t1,
+ __m128i *t2, __m128i *t3) {
+  __m128i a;
+  __m128i b;
+  __m128i c;
+  __m128i d;
+  /*a = t0 + t1, c = (t0 + t1) - (t1 + t1) = t0 - t1
+    b = t2 + t3, d = (t2 + t3) - (t3 + t3) = t2 - t3*/
+  a = _mm_add_epi32(*t0, *t1);
+  c = _mm_add_epi32(*t1, *t1);
+  c = _mm_sub_epi32(a, c);
+  b = _mm_add_epi32(*t2, *t3);
+  d = _mm_add_epi32(*t3, *t3);
+  d = _mm_sub_epi32(b, d);
+  *t0 = a;
+  *t1 = b;
+  *t2 = c;
+  *t3 = d;
+}
+
+/*Transpose 4 vectors with 4 32-bit values.*/
+OD_SIMD_INLINE void od_transpose32x4(__m128i *t0, __m128i *t1,
+ __m128i *t2, __m128i *t3) {
+  __m128i a;
+  __m128i b;
+  __m128i c;
+  __m128i d;
+  a = _mm_unpacklo_epi32(*t0, *t1);
+  b = _mm_unpacklo_epi32(*t2, *t3);
+  c = _mm_unpackhi_epi32(*t0, *t1);
+  d = _mm_unpackhi_epi32(*t2, *t3);
+  *t0 = _mm_unpacklo_epi64(a, b);
+  *t1 = _mm_unpackhi_epi64(a, b);
+  *t2 = _mm_unpacklo_epi64(c, d);
+  *t3 = _mm_unpackhi_epi64(c, d);
+}
+
+/*Returns the sum of the absolute values of the 2D Hadamard transform of the
+   4x4 block of 32-bit differences in a, b, c and d.*/
+OD_SIMD_INLINE int32_t od_mc_hadamard_sum_4x4(__m128i a, __m128i b,
+ __m128i c, __m128i d) {
+  __m128i sums;
+  /*Vertical 1D transform.*/
+  od_mc_butterfly_2x2_32x4(&a, &b, &c, &d);
+  od_mc_butterfly_2x2_32x4(&a, &b, &c, &d);
+  od_transpose32x4(&a, &b, &c, &d);
+  /*Horizontal 1D transform.*/
+  od_mc_butterfly_2x2_32x4(&a, &b, &c, &d);
+  od_mc_butterfly_2x2_32x4(&a, &b, &c, &d);
+  /*Take the sum of all the absolute values.*/
+  sums = _mm_add_epi32(_mm_add_epi32(_mm_abs_epi32(a), _mm_abs_epi32(b)),
+   _mm_add_epi32(_mm_abs_epi32(c), _mm_abs_epi32(d)));
+  /*Sum the elements of the vector.*/
+  sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(0, 1, 2, 3)));
+  sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sums);
+}
+
+OD_SIMD_INLINE __m128i od_load_convert_subtract8_x4(const unsigned char *src_p,
+ const unsigned char *ref_p) {
+  return _mm_sub_epi32(
+   _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t *)src_p)),
+   _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t *)ref_p)));
+}
+
+OD_SIMD_INLINE __m128i od_load_convert_subtract16_x4(const unsigned char *src_p,
+ const unsigned char *ref_p) {
+  return _mm_sub_epi32(
+   _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)src_p)),
+   _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)ref_p)));
+}
+
+int32_t od_mc_compute_satd8_4x4_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  const int ln = 2;
+  int32_t satd;
+  satd = od_mc_hadamard_sum_4x4(
+   od_load_convert_subtract8_x4(src + 0*systride, ref + 0*rystride),
+   od_load_convert_subtract8_x4(src + 1*systride, ref + 1*rystride),
+   od_load_convert_subtract8_x4(src + 2*systride, ref + 2*rystride),
+   od_load_convert_subtract8_x4(src + 3*systride, ref + 3*rystride));
+  satd = (satd + (1 << ln >> 1)) >> ln;
+#if defined(OD_CHECKASM)
+  {
+    int32_t c_satd;
+    c_satd = od_mc_compute_satd8_4x4_c(src, systride, ref, rystride);
+    if (satd != c_satd) {
+      fprintf(stderr, "od_mc_compute_satd %ix%i check failed: %i!=%i\n",
+       4, 4, satd, c_satd);
+    }
+  }
+#endif
+  return satd;
+}
+
+int32_t od_mc_compute_satd16_4x4_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  const int ln = 2;
+  int32_t satd;
+  satd = od_mc_hadamard_sum_4x4(
+   od_load_convert_subtract16_x4(src + 0*systride, ref + 0*rystride),
+   od_load_convert_subtract16_x4(src + 1*systride, ref + 1*rystride),
+   od_load_convert_subtract16_x4(src + 2*systride, ref + 2*rystride),
+   od_load_convert_subtract16_x4(src + 3*systride, ref + 3*rystride));
+  satd = (satd + (1 << (ln + OD_COEFF_SHIFT) >> 1)) >> (ln + OD_COEFF_SHIFT);
+#if defined(OD_CHECKASM)
+  {
+    int32_t c_satd;
+    c_satd = od_mc_compute_satd16_4x4_c(src, systride, ref, rystride);
+    if (satd != c_satd) {
+      fprintf(stderr, "od_mc_compute_satd %ix%i check failed: %i!=%i\n",
+       4, 4, satd, c_satd);
+    }
+  }
+#endif
+  return satd;
+}
+
+OD_SIMD_INLINE void od_mc_butterfly_2x2_32x8(__m256i *t0, __m256i *t1,
+ __m256i *t2, __m256i *t3) {
+  __m256i a;
+  __m256i b;
+  __m256i c;
+  __m256i d;
+  /*a = t0 + t1, c = (t0 + t1) - (t1 + t1) = t0 - t1
+    b = t2 + t3, d = (t2 + t3) - (t3 + t3) = t2 - t3*/
+  a = _mm256_add_epi32(*t0, *t1);
+  c = _mm256_add_epi32(*t1, *t1);
+  c = _mm256_sub_epi32(a, c);
+  b = _mm256_add_epi32(*t2, *t3);
+  d = _mm256_add_epi32(*t3, *t3);
+  d = _mm256_sub_epi32(b, d);
+  *t0 = a;
+  *t1 = b;
+  *t2 = c;
+  *t3 = d;
+}
+
+/*Transpose 8 vectors with 8 32-bit values.*/
+OD_SIMD_INLINE void od_transpose32x8(__m256i *t0, __m256i *t1,
+ __m256i *t2, __m256i *t3, __m256i *t4, __m256i *t5,
+ __m256i *t6, __m256i *t7) {
+  __m256i a0;
+  __m256i b0;
+  __m256i c0;
+  __m256i d0;
+  __m256i e0;
+  __m256i f0;
+  __m256i g0;
+  __m256i h0;
+  __m256i a1;
+  __m256i b1;
+  __m256i c1;
+  __m256i d1;
+  __m256i e1;
+  __m256i f1;
+  __m256i g1;
+  __m256i h1;
+  /*0011|4455*/
+  a0 = _mm256_unpacklo_epi32(*t0, *t1);
+  b0 = _mm256_unpacklo_epi32(*t2, *t3);
+  c0 = _mm256_unpacklo_epi32(*t4, *t5);
+  d0 = _mm256_unpacklo_epi32(*t6, *t7);
+  /*2233|6677*/
+  e0 = _mm256_unpackhi_epi32(*t0, *t1);
+  f0 = _mm256_unpackhi_epi32(*t2, *t3);
+  g0 = _mm256_unpackhi_epi32(*t4, *t5);
+  h0 = _mm256_unpackhi_epi32(*t6, *t7);
+  /*0000|4444*/
+  a1 = _mm256_unpacklo_epi64(a0, b0);
+  b1 = _mm256_unpacklo_epi64(c0, d0);
+  /*1111|5555*/
+  c1 = _mm256_unpackhi_epi64(a0, b0);
+  d1 = _mm256_unpackhi_epi64(c0, d0);
+  /*2222|6666*/
+  e1 = _mm256_unpacklo_epi64(e0, f0);
+  f1 = _mm256_unpacklo_epi64(g0, h0);
+  /*3333|7777*/
+  g1 = _mm256_unpackhi_epi64(e0, f0);
+  h1 = _mm256_unpackhi_epi64(g0, h0);
+  *t0 = _mm256_permute2x128_si256(a1, b1, 0x20);
+  *t1 = _mm256_permute2x128_si256(c1, d1, 0x20);
+  *t2 = _mm256_permute2x128_si256(e1, f1, 0x20);
+  *t3 = _mm256_permute2x128_si256(g1, h1, 0x20);
+  *t4 = _mm256_permute2x128_si256(a1, b1, 0x31);
+  *t5 = _mm256_permute2x128_si256(c1, d1, 0x31);
+  *t6 = _mm256_permute2x128_si256(e1, f1, 0x31);
+  *t7 = _mm256_permute2x128_si256(g1, h1, 0x31);
+}
+
+/*Returns the sum of the absolute values of the 2D Hadamard transform of the
+   8x8 block of 32-bit differences in a...h.*/
+OD_SIMD_INLINE int32_t od_mc_hadamard_sum_8x8(__m256i a, __m256i b,
+ __m256i c, __m256i d, __m256i e, __m256i f, __m256i g, __m256i h) {
+  __m128i sum;
+  /*Vertical 1D transform.*/
+  od_mc_butterfly_2x2_32x8(&a, &b, &c, &d);
+  od_mc_butterfly_2x2_32x8(&e, &f, &g, &h);
+  od_mc_butterfly_2x2_32x8(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_32x8(&c, &d, &g, &h);
+  od_mc_butterfly_2x2_32x8(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_32x8(&c, &d, &g, &h);
+  od_transpose32x8(&a, &c, &b, &d, &e, &g, &f, &h);
+  /*Horizontal 1D transform.*/
+  od_mc_butterfly_2x2_32x8(&a, &b, &c, &d);
+  od_mc_butterfly_2x2_32x8(&e, &f, &g, &h);
+  od_mc_butterfly_2x2_32x8(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_32x8(&c, &d, &g, &h);
+  od_mc_butterfly_2x2_32x8(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_32x8(&c, &d, &g, &h);
+  /*Take the sum of all the absolute values.*/
+  a = _mm256_add_epi32(_mm256_abs_epi32(a), _mm256_abs_epi32(b));
+  c = _mm256_add_epi32(_mm256_abs_epi32(c), _mm256_abs_epi32(d));
+  e = _mm256_add_epi32(_mm256_abs_epi32(e), _mm256_abs_epi32(f));
+  g = _mm256_add_epi32(_mm256_abs_epi32(g), _mm256_abs_epi32(h));
+  a = _mm256_add_epi32(_mm256_add_epi32(a, c), _mm256_add_epi32(e, g));
+  /*Sum the elements of the vector.*/
+  sum = _mm_add_epi32(_mm256_castsi256_si128(a),
+   _mm256_extracti128_si256(a, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(0, 1, 2, 3)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+OD_SIMD_INLINE __m256i od_load_convert_subtract8_x8(const unsigned char *src_p,
+ const unsigned char *ref_p) {
+  return _mm256_sub_epi32(
+   _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src_p)),
+   _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)ref_p)));
+}
+
+OD_SIMD_INLINE __m256i od_load_convert_subtract16_x8(
+ const unsigned char *src_p, const unsigned char *ref_p) {
+  return _mm256_sub_epi32(
+   _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src_p)),
+   _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)ref_p)));
+}
+
+int32_t od_mc_compute_satd8_8x8_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  const int ln = 3;
+  int32_t satd;
+  satd = od_mc_hadamard_sum_8x8(
+   od_load_convert_subtract8_x8(src + 0*systride, ref + 0*rystride),
+   od_load_convert_subtract8_x8(src + 1*systride, ref + 1*rystride),
+   od_load_convert_subtract8_x8(src + 2*systride, ref + 2*rystride),
+   od_load_convert_subtract8_x8(src + 3*systride, ref + 3*rystride),
+   od_load_convert_subtract8_x8(src + 4*systride, ref + 4*rystride),
+   od_load_convert_subtract8_x8(src + 5*systride, ref + 5*rystride),
+   od_load_convert_subtract8_x8(src + 6*systride, ref + 6*rystride),
+   od_load_convert_subtract8_x8(src + 7*systride, ref + 7*rystride));
+  satd = (satd + (1 << ln >> 1)) >> ln;
+#if defined(OD_CHECKASM)
+  {
+    int32_t c_satd;
+    c_satd = od_mc_compute_satd8_8x8_c(src, systride, ref, rystride);
+    if (satd != c_satd) {
+      fprintf(stderr, "od_mc_compute_satd %ix%i check failed: %i!=%i\n",
+       8, 8, satd, c_satd);
+    }
+  }
+#endif
+  return satd;
+}
+
+OD_SIMD_INLINE void od_mc_butterfly_2x2_16x16(__m256i *t0, __m256i *t1,
+ __m256i *t2, __m256i *t3) {
+  __m256i a;
+  __m256i b;
+  __m256i c;
+  __m256i d;
+  /*a = t0 + t1, c = (t0 + t1) - (t1 + t1) = t0 - t1
+    b = t2 + t3, d = (t2 + t3) - (t3 + t3) = t2 - t3*/
+  a = _mm256_add_epi16(*t0, *t1);
+  c = _mm256_add_epi16(*t1, *t1);
+  c = _mm256_sub_epi16(a, c);
+  b = _mm256_add_epi16(*t2, *t3);
+  d = _mm256_add_epi16(*t3, *t3);
+  d = _mm256_sub_epi16(b, d);
+  *t0 = a;
+  *t1 = b;
+  *t2 = c;
+  *t3 = d;
+}
+
+/*Transpose the two 8x8 blocks of 16-bit values held in the two halves of 8
+   vectors.*/
+OD_SIMD_INLINE void od_transpose16x8x2(__m256i *t0, __m256i *t1,
+ __m256i *t2, __m256i *t3, __m256i *t4, __m256i *t5,
+ __m256i *t6, __m256i *t7) {
+  __m256i a0;
+  __m256i b0;
+  __m256i c0;
+  __m256i d0;
+  __m256i e0;
+  __m256i f0;
+  __m256i g0;
+  __m256i h0;
+  __m256i a1;
+  __m256i b1;
+  __m256i c1;
+  __m256i d1;
+  __m256i e1;
+  __m256i f1;
+  __m256i g1;
+  __m256i h1;
+  /*00112233*/
+  a0 = _mm256_unpacklo_epi16(*t0, *t1);
+  b0 = _mm256_unpacklo_epi16(*t2, *t3);
+  c0 = _mm256_unpacklo_epi16(*t4, *t5);
+  d0 = _mm256_unpacklo_epi16(*t6, *t7);
+  /*44556677*/
+  e0 = _mm256_unpackhi_epi16(*t0, *t1);
+  f0 = _mm256_unpackhi_epi16(*t2, *t3);
+  g0 = _mm256_unpackhi_epi16(*t4, *t5);
+  h0 = _mm256_unpackhi_epi16(*t6, *t7);
+  /*00001111*/
+  a1 = _mm256_unpacklo_epi32(a0, b0);
+  b1 = _mm256_unpacklo_epi32(c0, d0);
+  /*22223333*/
+  c1 = _mm256_unpackhi_epi32(a0, b0);
+  d1 = _mm256_unpackhi_epi32(c0, d0);
+  /*44445555*/
+  e1 = _mm256_unpacklo_epi32(e0, f0);
+  f1 = _mm256_unpacklo_epi32(g0, h0);
+  /*66667777*/
+  g1 = _mm256_unpackhi_epi32(e0, f0);
+  h1 = _mm256_unpackhi_epi32(g0, h0);
+  *t0 = _mm256_unpacklo_epi64(a1, b1);
+  *t1 = _mm256_unpackhi_epi64(a1, b1);
+  *t2 = _mm256_unpacklo_epi64(c1, d1);
+  *t3 = _mm256_unpackhi_epi64(c1, d1);
+  *t4 = _mm256_unpacklo_epi64(e1, f1);
+  *t5 = _mm256_unpackhi_epi64(e1, f1);
+  *t6 = _mm256_unpacklo_epi64(g1, h1);
+  *t7 = _mm256_unpackhi_epi64(g1, h1);
+}
+
+OD_SIMD_INLINE __m256i od_load_convert_subtract8_x16(
+ const unsigned char *src_p, const unsigned char *ref_p) {
+  return _mm256_sub_epi16(
+   _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)src_p)),
+   _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)ref_p)));
+}
+
+/*Computes the SATD of two horizontally adjacent 8x8 blocks, one in each half
+   of the vectors, and returns the sum of the two.
+  8-bit differences leave enough headroom to do this with 16-bit values, as
+   in od_mc_compute_satd8_8x8_part() for SSE2.*/
+OD_SIMD_INLINE int32_t od_mc_compute_satd8_16x8_part(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  const int ln = 3;
+  __m256i a;
+  __m256i b;
+  __m256i c;
+  __m256i d;
+  __m256i e;
+  __m256i f;
+  __m256i g;
+  __m256i h;
+  __m128i sums;
+  int32_t satd0;
+  int32_t satd1;
+  a = od_load_convert_subtract8_x16(src + 0*systride, ref + 0*rystride);
+  b = od_load_convert_subtract8_x16(src + 1*systride, ref + 1*rystride);
+  c = od_load_convert_subtract8_x16(src + 2*systride, ref + 2*rystride);
+  d = od_load_convert_subtract8_x16(src + 3*systride, ref + 3*rystride);
+  e = od_load_convert_subtract8_x16(src + 4*systride, ref + 4*rystride);
+  f = od_load_convert_subtract8_x16(src + 5*systride, ref + 5*rystride);
+  g = od_load_convert_subtract8_x16(src + 6*systride, ref + 6*rystride);
+  h = od_load_convert_subtract8_x16(src + 7*systride, ref + 7*rystride);
+  /*Vertical 1D transform.*/
+  od_mc_butterfly_2x2_16x16(&a, &b, &c, &d);
+  od_mc_butterfly_2x2_16x16(&e, &f, &g, &h);
+  od_mc_butterfly_2x2_16x16(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_16x16(&c, &d, &g, &h);
+  od_mc_butterfly_2x2_16x16(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_16x16(&c, &d, &g, &h);
+  od_transpose16x8x2(&a, &c, &b, &d, &e, &g, &f, &h);
+  /*Horizontal 1D transform.*/
+  od_mc_butterfly_2x2_16x16(&a, &b, &c, &d);
+  od_mc_butterfly_2x2_16x16(&e, &f, &g, &h);
+  od_mc_butterfly_2x2_16x16(&a, &b, &e, &f);
+  od_mc_butterfly_2x2_16x16(&c, &d, &g, &h);
+  /*Merge the final butterfly stage with the absolute values and the first
+     stage of accumulation, using (abs(a+b)+abs(a-b))/2=max(abs(a),abs(b)).
+    This calculates (abs(a+b)+abs(a-b))/2-0x7FFF, so an offset must be added
+     to each block's sum before rounding.*/
+  a = _mm256_sub_epi16(_mm256_max_epi16(a, b),
+   _mm256_adds_epi16(_mm256_add_epi16(a, b), _mm256_set1_epi16(0x7FFF)));
+  e = _mm256_sub_epi16(_mm256_max_epi16(e, f),
+   _mm256_adds_epi16(_mm256_add_epi16(e, f), _mm256_set1_epi16(0x7FFF)));
+  c = _mm256_sub_epi16(_mm256_max_epi16(c, d),
+   _mm256_adds_epi16(_mm256_add_epi16(c, d), _mm256_set1_epi16(0x7FFF)));
+  g = _mm256_sub_epi16(_mm256_max_epi16(g, h),
+   _mm256_adds_epi16(_mm256_add_epi16(g, h), _mm256_set1_epi16(0x7FFF)));
+  a = _mm256_add_epi16(a, e);
+  c = _mm256_add_epi16(c, g);
+  /*Widen to 32 bits before the values can overflow.*/
+  a = _mm256_madd_epi16(a, _mm256_set1_epi16(1));
+  c = _mm256_madd_epi16(c, _mm256_set1_epi16(1));
+  a = _mm256_add_epi32(a, c);
+  /*Sum the elements of each half separately, so each block can be rounded
+     like the C version.*/
+  a = _mm256_add_epi32(a, _mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3)));
+  a = _mm256_add_epi32(a, _mm256_shuffle_epi32(a, _MM_SHUFFLE(2, 3, 0, 1)));
+  sums = _mm256_castsi256_si128(a);
+  satd0 = _mm_cvtsi128_si32(sums);
+  sums = _mm256_extracti128_si256(a, 1);
+  satd1 = _mm_cvtsi128_si32(sums);
+  /*Subtract the offset (32) and round.*/
+  satd0 = (satd0 - 32 + (1 << (ln - 1) >> 1)) >> (ln - 1);
+  satd1 = (satd1 - 32 + (1 << (ln - 1) >> 1)) >> (ln - 1);
+  return satd0 + satd1;
+}
+
+/*Perform SATD on pairs of 8x8 blocks within src and ref then sum the results
+   of each one.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sum_8x8_satd8_avx2(int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  int n;
+  int i;
+  int j;
+  int32_t satd;
+  n = 1 << ln;
+  OD_ASSERT(n >= 16);
+  satd = 0;
+  for (i = 0; i < n; i += 8) {
+    for (j = 0; j < n; j += 16) {
+      satd += od_mc_compute_satd8_16x8_part(src + i*systride + j, systride,
+       ref + i*rystride + j, rystride);
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    int32_t c_satd;
+    c_satd = (*(ln == 4 ? od_mc_compute_satd8_16x16_c :
+     ln == 5 ? od_mc_compute_satd8_32x32_c : od_mc_compute_satd8_64x64_c))(
+     src, systride, ref, rystride);
+    if (satd != c_satd) {
+      fprintf(stderr, "od_mc_compute_satd %ix%i check failed: %i!=%i\n",
+       n, n, satd, c_satd);
+    }
+  }
+#endif
+  return satd;
+}
+
+int32_t od_mc_compute_satd8_16x16_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd8_avx2(4, src, systride, ref, rystride);
+}
+
+int32_t od_mc_compute_satd8_32x32_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd8_avx2(5, src, systride, ref, rystride);
+}
+
+int32_t od_mc_compute_satd8_64x64_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd8_avx2(6, src, systride, ref, rystride);
+}
+
+/*16-bit differences need all 32 bits, so each 8x8 block fills one vector
+   per row.*/
+OD_SIMD_INLINE int32_t od_mc_compute_satd16_8x8_part(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  const int ln = 3;
+  int32_t satd;
+  satd = od_mc_hadamard_sum_8x8(
+   od_load_convert_subtract16_x8(src + 0*systride, ref + 0*rystride),
+   od_load_convert_subtract16_x8(src + 1*systride, ref + 1*rystride),
+   od_load_convert_subtract16_x8(src + 2*systride, ref + 2*rystride),
+   od_load_convert_subtract16_x8(src + 3*systride, ref + 3*rystride),
+   od_load_convert_subtract16_x8(src + 4*systride, ref + 4*rystride),
+   od_load_convert_subtract16_x8(src + 5*systride, ref + 5*rystride),
+   od_load_convert_subtract16_x8(src + 6*systride, ref + 6*rystride),
+   od_load_convert_subtract16_x8(src + 7*systride, ref + 7*rystride));
+  /*Shift and round.*/
+  return (satd + (1 << (ln + OD_COEFF_SHIFT) >> 1)) >> (ln + OD_COEFF_SHIFT);
+}
+
+/*Perform SATD on 8x8 blocks within src and ref then sum the results of
+   each one.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sum_8x8_satd16_avx2(int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  int n;
+  int i;
+  int j;
+  int32_t satd;
+  n = 1 << ln;
+  OD_ASSERT(n >= 8);
+  satd = 0;
+  for (i = 0; i < n; i += 8) {
+    for (j = 0; j < n; j += 8) {
+      satd += od_mc_compute_satd16_8x8_part(
+       src + i*systride + 2*j, systride, ref + i*rystride + 2*j, rystride);
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    int32_t c_satd;
+    c_satd = (*(ln == 3 ? od_mc_compute_satd16_8x8_c :
+     ln == 4 ? od_mc_compute_satd16_16x16_c :
+     ln == 5 ? od_mc_compute_satd16_32x32_c : od_mc_compute_satd16_64x64_c))(
+     src, systride, ref, rystride);
+    if (satd != c_satd) {
+      fprintf(stderr, "od_mc_compute_satd %ix%i check failed: %i!=%i\n",
+       n, n, satd, c_satd);
+    }
+  }
+#endif
+  return satd;
+}
+
+int32_t od_mc_compute_satd16_8x8_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd16_avx2(3, src, systride, ref, rystride);
+}
+
+int32_t od_mc_compute_satd16_16x16_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd16_avx2(4, src, systride, ref, rystride);
+}
+
+int32_t od_mc_compute_satd16_32x32_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd16_avx2(5, src, systride, ref, rystride);
+}
+
+int32_t od_mc_compute_satd16_64x64_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int rystride) {
+  return od_mc_compute_sum_8x8_satd16_avx2(6, src, systride, ref, rystride);
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86enc.h"
+#include "x86int.h"
+#include "../pvq_encoder.h"
+
+#include <stdio.h>
+
+#if defined(OD_X86ASM)
+#include <immintrin.h>
+
+#if defined(OD_CHECKASM)
+static void od_pvq_search_max_check(const int32_t *x, const int32_t *y,
+ const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+ int shift, int n, int pos) {
+  int pos_c;
+  pos_c = od_pvq_search_max_c(x, y, rate, rsqrt, xy_rsqrt, shift, n);
+  if (pos != pos_c) {
+    fprintf(stderr, "ASM mismatch: pos %i!=%i\n", pos_c, pos);
+    fprintf(stderr, "od_pvq_search_max check failed.\n");
+  }
+}
+#endif
+
+/*Returns the first lane index in idx among the lanes of cost holding their
+   maximum.*/
+OD_SIMD_INLINE int od_pvq_argmax_epi32(__m256i cost, __m256i idx) {
+  __m256i m;
+  m = _mm256_max_epi32(cost, _mm256_permute2x128_si256(cost, cost, 0x01));
+  m = _mm256_max_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+  m = _mm256_max_epi32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+  /*Lanes that do not hold the maximum get an index larger than any other.*/
+  idx = _mm256_or_si256(idx, _mm256_andnot_si256(
+   _mm256_cmpeq_epi32(cost, m), _mm256_set1_epi32(0x7FFFFFFF)));
+  idx = _mm256_min_epi32(idx, _mm256_permute2x128_si256(idx, idx, 0x01));
+  idx = _mm256_min_epi32(idx,
+   _mm256_shuffle_epi32(idx, _MM_SHUFFLE(1, 0, 3, 2)));
+  idx = _mm256_min_epi32(idx,
+   _mm256_shuffle_epi32(idx, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(_mm256_castsi256_si128(idx));
+}
+
+int od_pvq_search_max_avx2(const int32_t *x, const int32_t *y,
+ const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+ int shift, int n) {
+  __m256i best_cost;
+  __m256i best_idx;
+  __m256i idx;
+  __m128i sh;
+  int pos;
+  int j;
+  /*Every cost is larger than INT32_MIN, so each lane takes its first one.*/
+  best_cost = _mm256_set1_epi32(-0x7FFFFFFF - 1);
+  best_idx = _mm256_setzero_si256();
+  idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  sh = _mm_cvtsi32_si128(shift);
+  for (j = 0; j < n; j += 8) {
+    __m256i yv;
+    __m256i r;
+    __m256i cost;
+    __m256i gt;
+    yv = _mm256_loadu_si256((const __m256i *)(y + j));
+    r = _mm256_i32gather_epi32((const int *)rsqrt, yv, 4);
+    cost = _mm256_i32gather_epi32((const int *)xy_rsqrt, yv, 4);
+    r = _mm256_sra_epi32(_mm256_mullo_epi32(
+     _mm256_loadu_si256((const __m256i *)(x + j)), r), sh);
+    cost = _mm256_sub_epi32(_mm256_add_epi32(cost, r),
+     _mm256_loadu_si256((const __m256i *)(rate + j)));
+    /*Strictly greater, so each lane keeps its first maximum.*/
+    gt = _mm256_cmpgt_epi32(cost, best_cost);
+    best_cost = _mm256_max_epi32(best_cost, cost);
+    best_idx = _mm256_blendv_epi8(best_idx, idx, gt);
+    idx = _mm256_add_epi32(idx, _mm256_set1_epi32(8));
+  }
+  pos = od_pvq_argmax_epi32(best_cost, best_idx);
+#if defined(OD_CHECKASM)
+  od_pvq_search_max_check(x, y, rate, rsqrt, xy_rsqrt, shift, n, pos);
+#endif
+  return pos;
+}
+
+#endif
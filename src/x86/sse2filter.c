@@ -0,0 +1,312 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+
+#if defined(HAVE_CONFIG_H)
+# include "config.h"
+#endif
+
+#include "x86int.h"
+
+#include <stdio.h>
+
+#if defined(OD_X86ASM)
+#include <emmintrin.h>
+#include "../filter.h"
+
+/*The lapping filters work on 4 lines at a time, one per 32-bit lane.
+  Only the 4-point filters are vectorized, since that is the only size
+   OD_FILT_SIZE() currently selects.*/
+
+OD_SIMD_INLINE __m128i od_filter_mullo_epi32(__m128i a, int b1) {
+  __m128i b;
+  __m128i lo;
+  __m128i hi;
+  b = _mm_set1_epi32(b1);
+  lo = _mm_mul_epu32(a, b);
+  hi = _mm_mul_epu32(_mm_srli_si128(a, 4), b);
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(lo, _MM_SHUFFLE(0, 0, 2, 0)),
+   _mm_shuffle_epi32(hi, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/*Computes a*64/d with the truncating division of the C code.
+  Every quotient of a 32-bit integer by d is exact or at least 1/d away from
+   the next integer, so a double precision division rounds to a value with
+   the same integer part.*/
+OD_SIMD_INLINE __m128i od_filter_div_epi32(__m128i a, int d) {
+  __m128d dd;
+  __m128i lo;
+  __m128i hi;
+  dd = _mm_set1_pd(d);
+  a = _mm_slli_epi32(a, 6);
+  lo = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a), dd));
+  hi = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(a, 8)),
+   dd));
+  return _mm_unpacklo_epi64(lo, hi);
+}
+
+OD_SIMD_INLINE void od_filter_transpose4(__m128i *t0, __m128i *t1,
+ __m128i *t2, __m128i *t3) {
+  __m128i a;
+  __m128i b;
+  __m128i c;
+  __m128i d;
+  a = _mm_unpacklo_epi32(*t0, *t1);
+  b = _mm_unpacklo_epi32(*t2, *t3);
+  c = _mm_unpackhi_epi32(*t0, *t1);
+  d = _mm_unpackhi_epi32(*t2, *t3);
+  *t0 = _mm_unpacklo_epi64(a, b);
+  *t1 = _mm_unpackhi_epi64(a, b);
+  *t2 = _mm_unpacklo_epi64(c, d);
+  *t3 = _mm_unpackhi_epi64(c, d);
+}
+
+/*See od_pre_filter4() for the scalar version.*/
+OD_SIMD_INLINE void od_pre_filter4_kernel(__m128i *x0, __m128i *x1,
+ __m128i *x2, __m128i *x3) {
+  __m128i t0;
+  __m128i t1;
+  __m128i t2;
+  __m128i t3;
+  __m128i zero;
+  zero = _mm_setzero_si128();
+  t3 = _mm_sub_epi32(*x0, *x3);
+  t2 = _mm_sub_epi32(*x1, *x2);
+  t1 = _mm_sub_epi32(*x1, _mm_srai_epi32(t2, 1));
+  t0 = _mm_sub_epi32(*x0, _mm_srai_epi32(t3, 1));
+  /*s0; the compare yields -1 in the lanes where t2 > 0.*/
+  t2 = _mm_srai_epi32(od_filter_mullo_epi32(t2, OD_FILTER_PARAMS4[0]), 6);
+  t2 = _mm_sub_epi32(t2, _mm_cmpgt_epi32(t2, zero));
+  /*s1*/
+  t3 = _mm_srai_epi32(od_filter_mullo_epi32(t3, OD_FILTER_PARAMS4[1]), 6);
+  t3 = _mm_sub_epi32(t3, _mm_cmpgt_epi32(t3, zero));
+  /*p0*/
+  t3 = _mm_add_epi32(t3, _mm_srai_epi32(_mm_add_epi32(
+   od_filter_mullo_epi32(t2, OD_FILTER_PARAMS4[2]), _mm_set1_epi32(32)), 6));
+  /*u0*/
+  t2 = _mm_add_epi32(t2, _mm_srai_epi32(_mm_add_epi32(
+   od_filter_mullo_epi32(t3, OD_FILTER_PARAMS4[3]), _mm_set1_epi32(32)), 6));
+  t0 = _mm_add_epi32(t0, _mm_srai_epi32(t3, 1));
+  t1 = _mm_add_epi32(t1, _mm_srai_epi32(t2, 1));
+  *x0 = t0;
+  *x1 = t1;
+  *x2 = _mm_sub_epi32(t1, t2);
+  *x3 = _mm_sub_epi32(t0, t3);
+}
+
+/*See od_post_filter4() for the scalar version.*/
+OD_SIMD_INLINE void od_post_filter4_kernel(__m128i *y0, __m128i *y1,
+ __m128i *y2, __m128i *y3) {
+  __m128i t0;
+  __m128i t1;
+  __m128i t2;
+  __m128i t3;
+  t3 = _mm_sub_epi32(*y0, *y3);
+  t2 = _mm_sub_epi32(*y1, *y2);
+  t1 = _mm_sub_epi32(*y1, _mm_srai_epi32(t2, 1));
+  t0 = _mm_sub_epi32(*y0, _mm_srai_epi32(t3, 1));
+  t2 = _mm_sub_epi32(t2, _mm_srai_epi32(_mm_add_epi32(
+   od_filter_mullo_epi32(t3, OD_FILTER_PARAMS4[3]), _mm_set1_epi32(32)), 6));
+  t3 = _mm_sub_epi32(t3, _mm_srai_epi32(_mm_add_epi32(
+   od_filter_mullo_epi32(t2, OD_FILTER_PARAMS4[2]), _mm_set1_epi32(32)), 6));
+  t3 = od_filter_div_epi32(t3, OD_FILTER_PARAMS4[1]);
+  t2 = od_filter_div_epi32(t2, OD_FILTER_PARAMS4[0]);
+  t0 = _mm_add_epi32(t0, _mm_srai_epi32(t3, 1));
+  t1 = _mm_add_epi32(t1, _mm_srai_epi32(t2, 1));
+  *y0 = t0;
+  *y1 = t1;
+  *y2 = _mm_sub_epi32(t1, t2);
+  *y3 = _mm_sub_epi32(t0, t3);
+}
+
+#if defined(OD_CHECKASM)
+static void od_filter_lines4_check(const od_coeff *c, int stride,
+ const od_coeff ref[16], int cols, int post) {
+  int i;
+  int k;
+  int failed;
+  failed = 0;
+  for (i = 0; i < 4; i++) {
+    od_coeff t[4];
+    for (k = 0; k < 4; k++) t[k] = ref[4*i + k];
+    if (post) od_post_filter4(t, t);
+    else od_pre_filter4(t, t);
+    for (k = 0; k < 4; k++) {
+      od_coeff v;
+      v = cols ? c[k*stride + i] : c[i*stride + k];
+      if (v != t[k]) {
+        fprintf(stderr, "ASM mismatch: 0x%08X!=0x%08X @ (%i,%i)\n",
+         (unsigned)t[k], (unsigned)v, i, k);
+        failed = 1;
+      }
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "od_%s_filter4 %s check failed.\n",
+     post ? "post" : "pre", cols ? "column" : "row");
+  }
+}
+
+/*Saves the input of 4 lines, one line of 4 taps after another.*/
+static void od_filter_lines4_save(od_coeff ref[16], const od_coeff *c,
+ int stride, int cols) {
+  int i;
+  int k;
+  for (i = 0; i < 4; i++) {
+    for (k = 0; k < 4; k++) {
+      ref[4*i + k] = cols ? c[k*stride + i] : c[i*stride + k];
+    }
+  }
+}
+#endif
+
+/*Rows are loaded 4 at a time and transposed so that each lane holds one
+   row.*/
+void od_pre_filter_rows4_sse2(od_coeff *c, int stride, int n) {
+  int i;
+  for (i = 0; i < n; i += 4) {
+    od_coeff *p;
+    __m128i x0;
+    __m128i x1;
+    __m128i x2;
+    __m128i x3;
+#if defined(OD_CHECKASM)
+    od_coeff ref[16];
+#endif
+    p = c + i*stride;
+#if defined(OD_CHECKASM)
+    od_filter_lines4_save(ref, p, stride, 0);
+#endif
+    x0 = _mm_loadu_si128((__m128i *)(p + 0*stride));
+    x1 = _mm_loadu_si128((__m128i *)(p + 1*stride));
+    x2 = _mm_loadu_si128((__m128i *)(p + 2*stride));
+    x3 = _mm_loadu_si128((__m128i *)(p + 3*stride));
+    od_filter_transpose4(&x0, &x1, &x2, &x3);
+    od_pre_filter4_kernel(&x0, &x1, &x2, &x3);
+    od_filter_transpose4(&x0, &x1, &x2, &x3);
+    _mm_storeu_si128((__m128i *)(p + 0*stride), x0);
+    _mm_storeu_si128((__m128i *)(p + 1*stride), x1);
+    _mm_storeu_si128((__m128i *)(p + 2*stride), x2);
+    _mm_storeu_si128((__m128i *)(p + 3*stride), x3);
+#if defined(OD_CHECKASM)
+    od_filter_lines4_check(p, stride, ref, 0, 0);
+#endif
+  }
+}
+
+void od_post_filter_rows4_sse2(od_coeff *c, int stride, int n) {
+  int i;
+  for (i = 0; i < n; i += 4) {
+    od_coeff *p;
+    __m128i y0;
+    __m128i y1;
+    __m128i y2;
+    __m128i y3;
+#if defined(OD_CHECKASM)
+    od_coeff ref[16];
+#endif
+    p = c + i*stride;
+#if defined(OD_CHECKASM)
+    od_filter_lines4_save(ref, p, stride, 0);
+#endif
+    y0 = _mm_loadu_si128((__m128i *)(p + 0*stride));
+    y1 = _mm_loadu_si128((__m128i *)(p + 1*stride));
+    y2 = _mm_loadu_si128((__m128i *)(p + 2*stride));
+    y3 = _mm_loadu_si128((__m128i *)(p + 3*stride));
+    od_filter_transpose4(&y0, &y1, &y2, &y3);
+    od_post_filter4_kernel(&y0, &y1, &y2, &y3);
+    od_filter_transpose4(&y0, &y1, &y2, &y3);
+    _mm_storeu_si128((__m128i *)(p + 0*stride), y0);
+    _mm_storeu_si128((__m128i *)(p + 1*stride), y1);
+    _mm_storeu_si128((__m128i *)(p + 2*stride), y2);
+    _mm_storeu_si128((__m128i *)(p + 3*stride), y3);
+#if defined(OD_CHECKASM)
+    od_filter_lines4_check(p, stride, ref, 0, 1);
+#endif
+  }
+}
+
+/*Adjacent columns are already in adjacent lanes, so no transpose is
+   needed.*/
+void od_pre_filter_cols4_sse2(od_coeff *c, int stride, int n) {
+  int j;
+  for (j = 0; j < n; j += 4) {
+    od_coeff *p;
+    __m128i x0;
+    __m128i x1;
+    __m128i x2;
+    __m128i x3;
+#if defined(OD_CHECKASM)
+    od_coeff ref[16];
+#endif
+    p = c + j;
+#if defined(OD_CHECKASM)
+    od_filter_lines4_save(ref, p, stride, 1);
+#endif
+    x0 = _mm_loadu_si128((__m128i *)(p + 0*stride));
+    x1 = _mm_loadu_si128((__m128i *)(p + 1*stride));
+    x2 = _mm_loadu_si128((__m128i *)(p + 2*stride));
+    x3 = _mm_loadu_si128((__m128i *)(p + 3*stride));
+    od_pre_filter4_kernel(&x0, &x1, &x2, &x3);
+    _mm_storeu_si128((__m128i *)(p + 0*stride), x0);
+    _mm_storeu_si128((__m128i *)(p + 1*stride), x1);
+    _mm_storeu_si128((__m128i *)(p + 2*stride), x2);
+    _mm_storeu_si128((__m128i *)(p + 3*stride), x3);
+#if defined(OD_CHECKASM)
+    od_filter_lines4_check(p, stride, ref, 1, 0);
+#endif
+  }
+}
+
+void od_post_filter_cols4_sse2(od_coeff *c, int stride, int n) {
+  int j;
+  for (j = 0; j < n; j += 4) {
+    od_coeff *p;
+    __m128i y0;
+    __m128i y1;
+    __m128i y2;
+    __m128i y3;
+#if defined(OD_CHECKASM)
+    od_coeff ref[16];
+#endif
+    p = c + j;
+#if defined(OD_CHECKASM)
+    od_filter_lines4_save(ref, p, stride, 1);
+#endif
+    y0 = _mm_loadu_si128((__m128i *)(p + 0*stride));
+    y1 = _mm_loadu_si128((__m128i *)(p + 1*stride));
+    y2 = _mm_loadu_si128((__m128i *)(p + 2*stride));
+    y3 = _mm_loadu_si128((__m128i *)(p + 3*stride));
+    od_post_filter4_kernel(&y0, &y1, &y2, &y3);
+    _mm_storeu_si128((__m128i *)(p + 0*stride), y0);
+    _mm_storeu_si128((__m128i *)(p + 1*stride), y1);
+    _mm_storeu_si128((__m128i *)(p + 2*stride), y2);
+    _mm_storeu_si128((__m128i *)(p + 3*stride), y3);
+#if defined(OD_CHECKASM)
+    od_filter_lines4_check(p, stride, ref, 1, 1);
+#endif
+  }
+}
+
+#endif
@@ -923,6 +923,209 @@ void od_mc_predict1fmv16_sse2(od_state *state, unsigned char *dst,
 #endif
 }
 
+#if defined(OD_CHECKASM)
+static void od_mc_blend16_check(const unsigned char *_dst, int _dystride,
+ const unsigned char *dst, int _log_xblk_sz, int _log_yblk_sz,
+ const char *name) {
+  int xblk_sz;
+  int yblk_sz;
+  int failed;
+  int i;
+  int j;
+  xblk_sz = 1 << _log_xblk_sz;
+  yblk_sz = 1 << _log_yblk_sz;
+  failed = 0;
+  for (j = 0; j < yblk_sz; j++) {
+    for (i = 0; i < xblk_sz; i++) {
+      int _dst_val;
+      int dst_val;
+      _dst_val = ((const int16_t *)(_dst + j*_dystride))[i];
+      dst_val = ((const int16_t *)dst)[j*xblk_sz + i];
+      if (_dst_val != dst_val) {
+        fprintf(stderr, "ASM mismatch: 0x%04X!=0x%04X @ (%2i,%2i)\n",
+         _dst_val, dst_val, i, j);
+        failed = 1;
+      }
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "%s %ix%i check failed.\n", name,
+     (1 << _log_xblk_sz), (1 << _log_yblk_sz));
+  }
+  OD_ASSERT(!failed);
+}
+#endif
+
+/*Computes the weighted sum of 8 pixels from each of 4 images and rounds it.
+  The weights of each pixel must sum to 1 << shift, and must fit in 16 bits
+   along with the pixels, so that pmaddwd can form the products.*/
+OD_SIMD_INLINE __m128i od_mc_blend4_epi16(__m128i s0, __m128i s1,
+ __m128i s2, __m128i s3, __m128i w0, __m128i w1, __m128i w2, __m128i w3,
+ __m128i round, int shift) {
+  __m128i lo;
+  __m128i hi;
+  lo = _mm_add_epi32(
+   _mm_madd_epi16(_mm_unpacklo_epi16(s0, s1), _mm_unpacklo_epi16(w0, w1)),
+   _mm_madd_epi16(_mm_unpacklo_epi16(s2, s3), _mm_unpacklo_epi16(w2, w3)));
+  hi = _mm_add_epi32(
+   _mm_madd_epi16(_mm_unpackhi_epi16(s0, s1), _mm_unpackhi_epi16(w0, w1)),
+   _mm_madd_epi16(_mm_unpackhi_epi16(s2, s3), _mm_unpackhi_epi16(w2, w3)));
+  lo = _mm_srai_epi32(_mm_add_epi32(lo, round), shift);
+  hi = _mm_srai_epi32(_mm_add_epi32(hi, round), shift);
+  /*Sign-extend the low 16 bits first so the saturating pack truncates like
+     the C code's conversion to int16_t, which matters when the split weights
+     of non-square blocks extrapolate.*/
+  lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+  hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+  return _mm_packs_epi32(lo, hi);
+}
+
+/*Loads 8 pixels, or 4 for blocks only 4 pixels wide.*/
+OD_SIMD_INLINE __m128i od_mc_load_blend16(const int16_t *src, int xblk_sz) {
+  return xblk_sz >= 8 ? _mm_loadu_si128((const __m128i *)src)
+   : _mm_loadl_epi64((const __m128i *)src);
+}
+
+OD_SIMD_INLINE void od_mc_store_blend16(int16_t *dst, __m128i p,
+ int xblk_sz) {
+  if (xblk_sz >= 8) _mm_storeu_si128((__m128i *)dst, p);
+  else _mm_storel_epi64((__m128i *)dst, p);
+}
+
+/*The bilinear weights of the 4 corners factor into
+   (xblk_sz - i)*(yblk_sz - j), i*(yblk_sz - j), i*j and (xblk_sz - i)*j,
+   which reproduces the two-pass interpolation of od_mc_blend_full16_c()
+   exactly.*/
+void od_mc_blend_full16_sse2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz) {
+  const int16_t *src16[4];
+  __m128i round;
+  __m128i iota;
+  int log_blk_sz2;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_blend_full16_c(dst, dystride, src, log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2 = log_xblk_sz + log_yblk_sz;
+  round = _mm_set1_epi32(1 << log_blk_sz2 >> 1);
+  iota = _mm_set_epi16(7, 6, 5, 4, 3, 2, 1, 0);
+  for (k = 0; k < 4; k++) src16[k] = (const int16_t *)src[k];
+  for (j = 0; j < yblk_sz; j++) {
+    __m128i wj;
+    __m128i wyj;
+    int16_t *dst16;
+    wj = _mm_set1_epi16(j);
+    wyj = _mm_set1_epi16(yblk_sz - j);
+    dst16 = (int16_t *)(dst + j*dystride);
+    for (i = 0; i < xblk_sz; i += 8) {
+      __m128i wi;
+      __m128i wxi;
+      __m128i p;
+      int o;
+      wi = _mm_add_epi16(_mm_set1_epi16(i), iota);
+      wxi = _mm_sub_epi16(_mm_set1_epi16(xblk_sz), wi);
+      o = j*xblk_sz + i;
+      p = od_mc_blend4_epi16(od_mc_load_blend16(src16[0] + o, xblk_sz),
+       od_mc_load_blend16(src16[1] + o, xblk_sz),
+       od_mc_load_blend16(src16[2] + o, xblk_sz),
+       od_mc_load_blend16(src16[3] + o, xblk_sz),
+       _mm_mullo_epi16(wxi, wyj), _mm_mullo_epi16(wi, wyj),
+       _mm_mullo_epi16(wi, wj), _mm_mullo_epi16(wxi, wj), round, log_blk_sz2);
+      od_mc_store_blend16(dst16 + i, p, xblk_sz);
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_blend_full16_c(dst_c, xblk_sz << 1, src, log_xblk_sz, log_yblk_sz);
+    od_mc_blend16_check(dst, dystride, dst_c, log_xblk_sz, log_yblk_sz,
+     "od_mc_blend_full16");
+  }
+#endif
+}
+
+/*The weight od_mc_blend_full_split16_c() implicitly gives the first image is
+   whatever the other three leave, which we compute explicitly here.*/
+void od_mc_blend_full_split16_sse2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz) {
+  const int16_t *src16[4];
+  int s0[4];
+  int dsdi[4];
+  int dsdj[4];
+  int ddsdidj[4];
+  __m128i round;
+  __m128i iota;
+  __m128i wsum;
+  int log_blk_sz2p1;
+  int xblk_sz;
+  int yblk_sz;
+  int i;
+  int j;
+  int k;
+  if (log_xblk_sz < 2) {
+    od_mc_blend_full_split16_c(dst, dystride, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    return;
+  }
+  xblk_sz = 1 << log_xblk_sz;
+  yblk_sz = 1 << log_yblk_sz;
+  log_blk_sz2p1 = log_xblk_sz + log_yblk_sz + 1;
+  round = _mm_set1_epi32(1 << log_blk_sz2p1 >> 1);
+  wsum = _mm_set1_epi16(1 << log_blk_sz2p1);
+  iota = _mm_set_epi16(7, 6, 5, 4, 3, 2, 1, 0);
+  od_mc_setup_s_split(s0, dsdi, dsdj, ddsdidj,
+   oc, s, log_xblk_sz, log_yblk_sz);
+  for (k = 0; k < 4; k++) src16[k] = (const int16_t *)src[k];
+  for (j = 0; j < yblk_sz; j++) {
+    int16_t *dst16;
+    dst16 = (int16_t *)(dst + j*dystride);
+    for (i = 0; i < xblk_sz; i += 8) {
+      __m128i wi;
+      __m128i w1;
+      __m128i w2;
+      __m128i w3;
+      __m128i p;
+      int o;
+      wi = _mm_add_epi16(_mm_set1_epi16(i), iota);
+      w1 = _mm_add_epi16(_mm_set1_epi16(s0[1]),
+       _mm_mullo_epi16(wi, _mm_set1_epi16(dsdi[1])));
+      w2 = _mm_add_epi16(_mm_set1_epi16(s0[2]),
+       _mm_mullo_epi16(wi, _mm_set1_epi16(dsdi[2])));
+      w3 = _mm_add_epi16(_mm_set1_epi16(s0[3]),
+       _mm_mullo_epi16(wi, _mm_set1_epi16(dsdi[3])));
+      o = j*xblk_sz + i;
+      p = od_mc_blend4_epi16(od_mc_load_blend16(src16[0] + o, xblk_sz),
+       od_mc_load_blend16(src16[1] + o, xblk_sz),
+       od_mc_load_blend16(src16[2] + o, xblk_sz),
+       od_mc_load_blend16(src16[3] + o, xblk_sz),
+       _mm_sub_epi16(_mm_sub_epi16(_mm_sub_epi16(wsum, w1), w2), w3),
+       w1, w2, w3, round, log_blk_sz2p1);
+      od_mc_store_blend16(dst16 + i, p, xblk_sz);
+    }
+    for (k = 0; k < 4; k++) {
+      s0[k] += dsdj[k];
+      dsdi[k] += ddsdidj[k];
+    }
+  }
+#if defined(OD_CHECKASM)
+  {
+    unsigned char dst_c[OD_MVBSIZE_MAX*OD_MVBSIZE_MAX*2];
+    od_mc_blend_full_split16_c(dst_c, xblk_sz << 1, src, oc, s,
+     log_xblk_sz, log_yblk_sz);
+    od_mc_blend16_check(dst, dystride, dst_c, log_xblk_sz, log_yblk_sz,
+     "od_mc_blend_full_split16");
+  }
+#endif
+}
+
 #endif
 
 #if defined(OD_GCC_INLINE_ASSEMBLY)
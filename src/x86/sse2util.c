@@ -28,16 +28,20 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
 
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "x86int.h"
 #include "cpu.h"
 #include "../mc.h"
 #include "../util.h"
+#include "../state.h"
 
 /*Block copy functions. Copying of overlapping regions has undefined
    behavior. Only 16x16, 32x32, 64x64 show a SIMD improvement.*/
 
 #if defined(OD_X86ASM)
+#include <emmintrin.h>
+
 #define OD_IM_LOAD_1(_rega, _regb, _regc, _regd) \
   "#OD_IM_LOAD_1\n\t" \
   "movdqu (%[src]), " _rega "\n\t" \
@@ -151,4 +155,224 @@ void od_copy_64x64_8_sse2(unsigned char *_dst, int _dstride,
   }
 }
 
+/*Reference/coefficient conversions.
+  Each of these handles a multiple of 16 (or 8) columns and leaves the rest
+   to the C version.*/
+
+#if defined(OD_CHECKASM)
+static void od_ref_buf_to_coeff_check(od_ref_buf_to_coeff_func conv_c,
+ const char *name, const od_coeff *_dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  od_coeff *dst;
+  int failed;
+  int x;
+  int y;
+  dst = (od_coeff *)malloc(sizeof(*dst)*w*h);
+  if (dst == NULL) return;
+  (*conv_c)(dst, w, src, src_ystride, coeff_shift, w, h);
+  failed = 0;
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w; x++) {
+      if (_dst[y*dst_ystride + x] != dst[y*w + x]) {
+        fprintf(stderr, "ASM mismatch: %i!=%i @ (%2i,%2i)\n",
+         _dst[y*dst_ystride + x], dst[y*w + x], x, y);
+        failed = 1;
+      }
+    }
+  }
+  free(dst);
+  if (failed) {
+    fprintf(stderr, "%s %ix%i (shift %i) check failed.\n",
+     name, w, h, coeff_shift);
+  }
+  OD_ASSERT(!failed);
+}
+
+/*xstride is the size of a pixel in bytes.*/
+static void od_coeff_to_ref_buf_check(od_coeff_to_ref_buf_func conv_c,
+ const char *name, const unsigned char *_dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h,
+ int xstride) {
+  unsigned char *dst;
+  int failed;
+  int x;
+  int y;
+  dst = (unsigned char *)malloc(w*xstride*h);
+  if (dst == NULL) return;
+  (*conv_c)(dst, w*xstride, src, src_ystride, coeff_shift, w, h);
+  failed = 0;
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w*xstride; x++) {
+      if (_dst[y*dst_ystride + x] != dst[y*w*xstride + x]) {
+        fprintf(stderr, "ASM mismatch: 0x%02X!=0x%02X @ (%2i,%2i)\n",
+         _dst[y*dst_ystride + x], dst[y*w*xstride + x], x/xstride, y);
+        failed = 1;
+      }
+    }
+  }
+  free(dst);
+  if (failed) {
+    fprintf(stderr, "%s %ix%i (shift %i) check failed.\n",
+     name, w, h, coeff_shift);
+  }
+  OD_ASSERT(!failed);
+}
+#endif
+
+void od_ref_buf_to_coeff8_sse2(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  __m128i shift;
+  __m128i bias;
+  __m128i zero;
+  int w16;
+  int x;
+  int y;
+  w16 = w & ~15;
+  shift = _mm_cvtsi32_si128(coeff_shift);
+  bias = _mm_set1_epi16(128);
+  zero = _mm_setzero_si128();
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w16; x += 16) {
+      __m128i p;
+      __m128i lo;
+      __m128i hi;
+      p = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x));
+      /*(src - 128) << coeff_shift fits in 16 bits for coeff_shift <= 4.*/
+      lo = _mm_sll_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(p, zero), bias),
+       shift);
+      hi = _mm_sll_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(p, zero), bias),
+       shift);
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x),
+       _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16));
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x + 4),
+       _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16));
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x + 8),
+       _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16));
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x + 12),
+       _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16));
+    }
+  }
+  if (w16 < w) {
+    od_ref_buf_to_coeff8_c(dst + w16, dst_ystride,
+     src + w16, src_ystride, coeff_shift, w - w16, h);
+  }
+#if defined(OD_CHECKASM)
+  od_ref_buf_to_coeff_check(od_ref_buf_to_coeff8_c, "od_ref_buf_to_coeff8",
+   dst, dst_ystride, src, src_ystride, coeff_shift, w, h);
+#endif
+}
+
+void od_ref_buf_to_coeff16_sse2(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h) {
+  __m128i shift;
+  __m128i bias;
+  int w8;
+  int x;
+  int y;
+  w8 = w & ~7;
+  shift = _mm_cvtsi32_si128(coeff_shift);
+  bias = _mm_set1_epi32((1 << coeff_shift >> 1)
+   - (1 << (8 + OD_COEFF_SHIFT) >> 1));
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w8; x += 8) {
+      __m128i p;
+      __m128i lo;
+      __m128i hi;
+      p = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + 2*x));
+      lo = _mm_srai_epi32(_mm_unpacklo_epi16(p, p), 16);
+      hi = _mm_srai_epi32(_mm_unpackhi_epi16(p, p), 16);
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x),
+       _mm_sra_epi32(_mm_add_epi32(lo, bias), shift));
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x + 4),
+       _mm_sra_epi32(_mm_add_epi32(hi, bias), shift));
+    }
+  }
+  if (w8 < w) {
+    od_ref_buf_to_coeff16_c(dst + w8, dst_ystride,
+     src + 2*w8, src_ystride, coeff_shift, w - w8, h);
+  }
+#if defined(OD_CHECKASM)
+  od_ref_buf_to_coeff_check(od_ref_buf_to_coeff16_c, "od_ref_buf_to_coeff16",
+   dst, dst_ystride, src, src_ystride, coeff_shift, w, h);
+#endif
+}
+
+void od_coeff_to_ref_buf8_sse2(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h) {
+  __m128i shift;
+  __m128i round;
+  __m128i bias;
+  int w16;
+  int x;
+  int y;
+  w16 = w & ~15;
+  shift = _mm_cvtsi32_si128(coeff_shift);
+  round = _mm_set1_epi32(1 << coeff_shift >> 1);
+  bias = _mm_set1_epi32(128);
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w16; x += 16) {
+      __m128i p0;
+      __m128i p1;
+      __m128i p2;
+      __m128i p3;
+      p0 = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x));
+      p1 = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x + 4));
+      p2 = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x + 8));
+      p3 = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x + 12));
+      p0 = _mm_add_epi32(_mm_sra_epi32(_mm_add_epi32(p0, round), shift), bias);
+      p1 = _mm_add_epi32(_mm_sra_epi32(_mm_add_epi32(p1, round), shift), bias);
+      p2 = _mm_add_epi32(_mm_sra_epi32(_mm_add_epi32(p2, round), shift), bias);
+      p3 = _mm_add_epi32(_mm_sra_epi32(_mm_add_epi32(p3, round), shift), bias);
+      /*The two saturating packs clamp to [0, 255] like OD_CLAMP255().*/
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + x), _mm_packus_epi16(
+       _mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+    }
+  }
+  if (w16 < w) {
+    od_coeff_to_ref_buf8_c(dst + w16, dst_ystride,
+     src + w16, src_ystride, coeff_shift, w - w16, h);
+  }
+#if defined(OD_CHECKASM)
+  od_coeff_to_ref_buf_check(od_coeff_to_ref_buf8_c, "od_coeff_to_ref_buf8",
+   dst, dst_ystride, src, src_ystride, coeff_shift, w, h, 1);
+#endif
+}
+
+void od_coeff_to_ref_buf16_sse2(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h) {
+  __m128i shift;
+  __m128i bias;
+  __m128i zero;
+  __m128i max;
+  int w8;
+  int x;
+  int y;
+  w8 = w & ~7;
+  shift = _mm_cvtsi32_si128(coeff_shift);
+  bias = _mm_set1_epi32(128 << OD_COEFF_SHIFT);
+  zero = _mm_setzero_si128();
+  max = _mm_set1_epi16((1 << (8 + OD_COEFF_SHIFT)) - 1);
+  for (y = 0; y < h; y++) {
+    for (x = 0; x < w8; x += 8) {
+      __m128i p0;
+      __m128i p1;
+      p0 = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x));
+      p1 = _mm_loadu_si128((const __m128i *)(src + y*src_ystride + x + 4));
+      p0 = _mm_add_epi32(_mm_sll_epi32(p0, shift), bias);
+      p1 = _mm_add_epi32(_mm_sll_epi32(p1, shift), bias);
+      /*Saturating to 16 bits first does not change the clamped result.*/
+      _mm_storeu_si128((__m128i *)(dst + y*dst_ystride + 2*x),
+       _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(p0, p1), zero), max));
+    }
+  }
+  if (w8 < w) {
+    od_coeff_to_ref_buf16_c(dst + 2*w8, dst_ystride,
+     src + w8, src_ystride, coeff_shift, w - w8, h);
+  }
+#if defined(OD_CHECKASM)
+  od_coeff_to_ref_buf_check(od_coeff_to_ref_buf16_c, "od_coeff_to_ref_buf16",
+   dst, dst_ystride, src, src_ystride, coeff_shift, w, h, 2);
+#endif
+}
+
 #endif
@@ -0,0 +1,236 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86enc.h"
+#include "x86int.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(OD_X86ASM)
+#include <smmintrin.h>
+
+#if defined(OD_CHECKASM)
+static void od_compute_stats_check(const signed char *img, int stride,
+ const od_superblock_stats *stats) {
+  od_superblock_stats stats_c;
+  od_compute_stats_c(img, stride, &stats_c);
+  if (memcmp(stats, &stats_c, sizeof(stats_c)) != 0) {
+    fprintf(stderr, "od_compute_stats check failed.\n");
+  }
+}
+
+static void od_psy_log_sum_check(const int32_t *inv_var, int stride, int n,
+ int32_t noise, int32_t sum) {
+  int32_t sum_c;
+  sum_c = od_psy_log_sum_c(inv_var, stride, n, noise);
+  if (sum != sum_c) {
+    fprintf(stderr, "ASM mismatch: sum %li!=%li\n", (long)sum_c, (long)sum);
+    fprintf(stderr, "od_psy_log_sum check failed.\n");
+  }
+}
+#endif
+
+/*Computes the clamped variances and inverse variances of four blocks of
+   1 << log_n pixels from their sums and sums of squares, as done by
+   od_compute_stats_c().*/
+OD_SIMD_INLINE void od_var_inv_var_epi32(int32_t *var, int32_t *inv_var,
+ __m128i sx, __m128i sxx, int log_n) {
+  __m128i v;
+  __m128i var_floor;
+  v = _mm_srai_epi32(_mm_sub_epi32(sxx,
+   _mm_srai_epi32(_mm_mullo_epi32(sx, sx), log_n)), 5);
+  var_floor = _mm_add_epi32(_mm_set1_epi32(4), _mm_srai_epi32(
+   _mm_add_epi32(sx, _mm_set1_epi32(128 << log_n)), 8));
+  v = _mm_max_epi32(v, var_floor);
+  _mm_storeu_si128((__m128i *)var, v);
+  /*The variance is at least 4, so the single-precision quotient is never
+     close enough to the next integer to round up to it, and truncating it
+     matches the integer division.*/
+  _mm_storeu_si128((__m128i *)inv_var, _mm_cvttps_epi32(
+   _mm_div_ps(_mm_set1_ps(16384), _mm_cvtepi32_ps(v))));
+}
+
+void od_compute_stats_sse41(const signed char *img, int stride,
+ od_superblock_stats *stats) {
+  const signed char *x;
+  __m128i ones;
+  int i;
+  int j;
+  int off8;
+  ones = _mm_set1_epi16(1);
+  x = img - OD_BLOCK_OFFSET(stride);
+  /*The last group of each row overlaps the previous one, so that we never
+     read past the margin.*/
+  for (i = 0; i < OD_SIZE2_SUMS; i++) {
+    for (j = 0; j < OD_SIZE2_SUMS; j += 8) {
+      __m128i r0;
+      __m128i r1;
+      __m128i a;
+      __m128i b;
+      int k;
+      k = OD_MINI(j, OD_SIZE2_SUMS - 8);
+      r0 = _mm_loadu_si128((const __m128i *)(x + 2*k));
+      r1 = _mm_loadu_si128((const __m128i *)(x + stride + 2*k));
+      a = _mm_cvtepi8_epi16(r0);
+      b = _mm_cvtepi8_epi16(r1);
+      _mm_storeu_si128((__m128i *)&stats->Sx2[i][k],
+       _mm_madd_epi16(_mm_add_epi16(a, b), ones));
+      _mm_storeu_si128((__m128i *)&stats->Sxx2[i][k],
+       _mm_add_epi32(_mm_madd_epi16(a, a), _mm_madd_epi16(b, b)));
+      a = _mm_cvtepi8_epi16(_mm_srli_si128(r0, 8));
+      b = _mm_cvtepi8_epi16(_mm_srli_si128(r1, 8));
+      _mm_storeu_si128((__m128i *)&stats->Sx2[i][k + 4],
+       _mm_madd_epi16(_mm_add_epi16(a, b), ones));
+      _mm_storeu_si128((__m128i *)&stats->Sxx2[i][k + 4],
+       _mm_add_epi32(_mm_madd_epi16(a, a), _mm_madd_epi16(b, b)));
+    }
+    x += 2*stride;
+  }
+  for (i = 0; i < OD_SIZE4_SUMS; i++) {
+    for (j = 0; j < OD_SIZE4_SUMS; j += 4) {
+      __m128i sx;
+      __m128i sxx;
+      int k;
+      k = OD_MINI(j, OD_SIZE4_SUMS - 4);
+      sx = _mm_add_epi32(
+       _mm_add_epi32(_mm_loadu_si128((__m128i *)&stats->Sx2[i][k]),
+       _mm_loadu_si128((__m128i *)&stats->Sx2[i][k + 1])),
+       _mm_add_epi32(_mm_loadu_si128((__m128i *)&stats->Sx2[i + 1][k]),
+       _mm_loadu_si128((__m128i *)&stats->Sx2[i + 1][k + 1])));
+      sxx = _mm_add_epi32(
+       _mm_add_epi32(_mm_loadu_si128((__m128i *)&stats->Sxx2[i][k]),
+       _mm_loadu_si128((__m128i *)&stats->Sxx2[i][k + 1])),
+       _mm_add_epi32(_mm_loadu_si128((__m128i *)&stats->Sxx2[i + 1][k]),
+       _mm_loadu_si128((__m128i *)&stats->Sxx2[i + 1][k + 1])));
+      _mm_storeu_si128((__m128i *)&stats->Sx4[i][k], sx);
+      _mm_storeu_si128((__m128i *)&stats->Sxx4[i][k], sxx);
+      od_var_inv_var_epi32(&stats->Var4[i][k], &stats->invVar4[i][k],
+       sx, sxx, 4);
+    }
+  }
+  off8 = OD_MAX_OVERLAP - 2*OD_MAX_OVERLAP_8;
+  OD_ASSERT(off8 >= 0);
+  for (i = 0; i < OD_SIZE8_SUMS; i++) {
+    for (j = 0; j < OD_SIZE8_SUMS; j++) {
+      stats->Sx8[i][j] = stats->Sx4[2*i + off8][2*j + off8]
+       + stats->Sx4[2*i + off8][2*j + 2 + off8]
+       + stats->Sx4[2*i + 2 + off8][2*j + off8]
+       + stats->Sx4[2*i + 2 + off8][2*j + 2 + off8];
+      stats->Sxx8[i][j] = stats->Sxx4[2*i + off8][2*j + off8]
+       + stats->Sxx4[2*i + off8][2*j + 2 + off8]
+       + stats->Sxx4[2*i + 2 + off8][2*j + off8]
+       + stats->Sxx4[2*i + 2 + off8][2*j + 2 + off8];
+    }
+    for (j = 0; j < OD_SIZE8_SUMS; j += 4) {
+      int k;
+      k = OD_MINI(j, OD_SIZE8_SUMS - 4);
+      od_var_inv_var_epi32(&stats->Var8[i][k], &stats->invVar8[i][k],
+       _mm_loadu_si128((__m128i *)&stats->Sx8[i][k]),
+       _mm_loadu_si128((__m128i *)&stats->Sxx8[i][k]), 6);
+    }
+  }
+#if defined(OD_CHECKASM)
+  od_compute_stats_check(img, stride, stats);
+#endif
+}
+
+/*Computes od_psy_log2() of each lane of t.*/
+OD_SIMD_INLINE __m128i od_psy_log2_epi32(__m128i t) {
+  __m128i e;
+  __m128i m;
+  __m128i x;
+  __m128i p;
+  /*Normalize t to [1 << 27, 1 << 28), subtracting the shifts from the
+     exponent.*/
+  e = _mm_set1_epi32(27 - 14);
+  m = _mm_cmplt_epi32(t, _mm_set1_epi32(1 << 20));
+  t = _mm_blendv_epi8(t, _mm_slli_epi32(t, 8), m);
+  e = _mm_add_epi32(e, _mm_and_si128(m, _mm_set1_epi32(-8)));
+  m = _mm_cmplt_epi32(t, _mm_set1_epi32(1 << 24));
+  t = _mm_blendv_epi8(t, _mm_slli_epi32(t, 4), m);
+  e = _mm_add_epi32(e, _mm_and_si128(m, _mm_set1_epi32(-4)));
+  m = _mm_cmplt_epi32(t, _mm_set1_epi32(1 << 26));
+  t = _mm_blendv_epi8(t, _mm_slli_epi32(t, 2), m);
+  e = _mm_add_epi32(e, _mm_and_si128(m, _mm_set1_epi32(-2)));
+  m = _mm_cmplt_epi32(t, _mm_set1_epi32(1 << 27));
+  t = _mm_blendv_epi8(t, _mm_slli_epi32(t, 1), m);
+  e = _mm_add_epi32(e, m);
+  x = _mm_and_si128(_mm_srli_epi32(t, 12), _mm_set1_epi32(0x7FFF));
+  p = _mm_add_epi32(_mm_set1_epi32(OD_PSY_LOG2_C4), _mm_srai_epi32(
+   _mm_mullo_epi32(x, _mm_set1_epi32(OD_PSY_LOG2_C5)), 15));
+  p = _mm_add_epi32(_mm_set1_epi32(OD_PSY_LOG2_C3),
+   _mm_srai_epi32(_mm_mullo_epi32(x, p), 15));
+  p = _mm_add_epi32(_mm_set1_epi32(OD_PSY_LOG2_C2),
+   _mm_srai_epi32(_mm_mullo_epi32(x, p), 15));
+  p = _mm_add_epi32(_mm_set1_epi32(OD_PSY_LOG2_C1),
+   _mm_srai_epi32(_mm_mullo_epi32(x, p), 15));
+  x = _mm_add_epi32(x, _mm_srai_epi32(_mm_mullo_epi32(x, p), 15));
+  return _mm_add_epi32(_mm_slli_epi32(e, OD_PSY_LOG2_SHIFT), x);
+}
+
+int32_t od_psy_log_sum_sse41(const int32_t *inv_var, int stride, int n,
+ int32_t noise) {
+  __m128i sum;
+  __m128i nz;
+  __m128i base;
+  int32_t ret;
+  int i;
+  sum = _mm_setzero_si128();
+  nz = _mm_set1_epi32(noise);
+  base = _mm_set1_epi32(16384);
+  for (i = 0; i < n; i++) {
+    const int32_t *row;
+    __m128i v;
+    int j;
+    row = inv_var + i*stride;
+    for (j = 0; j + 4 <= n; j += 4) {
+      v = _mm_loadu_si128((const __m128i *)(row + j));
+      sum = _mm_add_epi32(sum,
+       od_psy_log2_epi32(_mm_add_epi32(base, _mm_mullo_epi32(v, nz))));
+    }
+    if (j < n) {
+      /*A zero inverse variance contributes exactly zero, so pad with zeros
+         rather than reading past the end of the row.*/
+      if (n - j == 1) v = _mm_cvtsi32_si128(row[j]);
+      else v = _mm_loadl_epi64((const __m128i *)(row + j));
+      if (n - j == 3) v = _mm_insert_epi32(v, row[j + 2], 2);
+      sum = _mm_add_epi32(sum,
+       od_psy_log2_epi32(_mm_add_epi32(base, _mm_mullo_epi32(v, nz))));
+    }
+  }
+  sum = _mm_add_epi32(sum, _mm_unpackhi_epi64(sum, sum));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  ret = _mm_cvtsi128_si32(sum);
+#if defined(OD_CHECKASM)
+  od_psy_log_sum_check(inv_var, stride, n, noise, ret);
+#endif
+  return ret;
+}
+
+#endif
@@ -0,0 +1,206 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86enc.h"
+#include "x86int.h"
+
+#include <stdio.h>
+
+#if defined(OD_X86ASM)
+#include <smmintrin.h>
+
+#if defined(OD_CHECKASM)
+static void od_compute_var_8x8_check(const int32_t var[9],
+ const od_coeff *x, int stride) {
+  int32_t var_c[9];
+  int failed;
+  int i;
+  od_compute_var_8x8_c(var_c, x, stride);
+  failed = 0;
+  for (i = 0; i < 9; i++) {
+    if (var[i] != var_c[i]) {
+      fprintf(stderr, "ASM mismatch: var[%i] %li!=%li\n",
+       i, (long)var_c[i], (long)var[i]);
+      failed = 1;
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "od_compute_var_8x8 check failed.\n");
+  }
+}
+
+static void od_compute_dist_lp_check(const double *lp_energy,
+ const od_coeff *x, const od_coeff *y, int n) {
+  double lp_energy_c[(OD_BSIZE_MAX >> 3)*(OD_BSIZE_MAX >> 3)];
+  int failed;
+  int i;
+  od_compute_dist_lp_c(lp_energy_c, x, y, n);
+  failed = 0;
+  for (i = 0; i < (n >> 3)*(n >> 3); i++) {
+    if (lp_energy[i] != lp_energy_c[i]) {
+      fprintf(stderr, "ASM mismatch: lp_energy[%i] %G!=%G\n",
+       i, lp_energy_c[i], lp_energy[i]);
+      failed = 1;
+    }
+  }
+  if (failed) {
+    fprintf(stderr, "od_compute_dist_lp check failed.\n");
+  }
+}
+#endif
+
+/*Returns the sums of each run of four columns starting at an even column,
+   given column sums for columns 0...3 in lo and 4...7 in hi.
+  Only the first three lanes of the result are meaningful.*/
+OD_SIMD_INLINE __m128i od_sum_4x4_cols(__m128i lo, __m128i hi) {
+  __m128i p;
+  p = _mm_hadd_epi32(lo, hi);
+  return _mm_add_epi32(p, _mm_srli_si128(p, 4));
+}
+
+void od_compute_var_8x8_sse41(int32_t var[9], const od_coeff *x,
+ int stride) {
+  __m128i s_lo[4];
+  __m128i s_hi[4];
+  __m128i q_lo[4];
+  __m128i q_hi[4];
+  __m128i v[3];
+  int i;
+  /*Sum pairs of rows, so that each window is the sum of two pairs.*/
+  for (i = 0; i < 4; i++) {
+    __m128i r0_lo;
+    __m128i r0_hi;
+    __m128i r1_lo;
+    __m128i r1_hi;
+    r0_lo = _mm_srai_epi32(_mm_loadu_si128(
+     (const __m128i *)(x + 2*i*stride)), 2);
+    r0_hi = _mm_srai_epi32(_mm_loadu_si128(
+     (const __m128i *)(x + 2*i*stride + 4)), 2);
+    r1_lo = _mm_srai_epi32(_mm_loadu_si128(
+     (const __m128i *)(x + (2*i + 1)*stride)), 2);
+    r1_hi = _mm_srai_epi32(_mm_loadu_si128(
+     (const __m128i *)(x + (2*i + 1)*stride + 4)), 2);
+    s_lo[i] = _mm_add_epi32(r0_lo, r1_lo);
+    s_hi[i] = _mm_add_epi32(r0_hi, r1_hi);
+    q_lo[i] = _mm_add_epi32(_mm_mullo_epi32(r0_lo, r0_lo),
+     _mm_mullo_epi32(r1_lo, r1_lo));
+    q_hi[i] = _mm_add_epi32(_mm_mullo_epi32(r0_hi, r0_hi),
+     _mm_mullo_epi32(r1_hi, r1_hi));
+  }
+  for (i = 0; i < 3; i++) {
+    __m128i sum;
+    __m128i s2;
+    sum = od_sum_4x4_cols(_mm_add_epi32(s_lo[i], s_lo[i + 1]),
+     _mm_add_epi32(s_hi[i], s_hi[i + 1]));
+    s2 = od_sum_4x4_cols(_mm_add_epi32(q_lo[i], q_lo[i + 1]),
+     _mm_add_epi32(q_hi[i], q_hi[i + 1]));
+    v[i] = _mm_sub_epi32(s2, _mm_srai_epi32(_mm_mullo_epi32(sum, sum), 4));
+  }
+  /*Each store spills one lane that the next one overwrites, except the
+     last.*/
+  _mm_storeu_si128((__m128i *)var, v[0]);
+  _mm_storeu_si128((__m128i *)(var + 3), v[1]);
+  _mm_storel_epi64((__m128i *)(var + 6), v[2]);
+  var[8] = _mm_extract_epi32(v[2], 2);
+#if defined(OD_CHECKASM)
+  od_compute_var_8x8_check(var, x, stride);
+#endif
+}
+
+/*The squares are exact in double precision, and so are their sums for any
+   realistic input, so the order in which they are added does not change the
+   result.*/
+OD_SIMD_INLINE __m128d od_add_sq_epi32_pd(__m128d acc, __m128i v) {
+  __m128d lo;
+  __m128d hi;
+  lo = _mm_cvtepi32_pd(v);
+  hi = _mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v));
+  return _mm_add_pd(acc,
+   _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+}
+
+void od_compute_dist_lp_sse41(double *lp_energy, const od_coeff *x,
+ const od_coeff *y, int n) {
+  /*The horizontally filtered error, with the second and next-to-last rows
+     mirrored above and below.*/
+  od_coeff tmp[(OD_BSIZE_MAX + 2)*OD_BSIZE_MAX];
+  /*One row of the error, with the same mirroring on the left and right.*/
+  od_coeff e[OD_BSIZE_MAX + 2];
+  __m128i mid;
+  int i;
+  int j;
+  mid = _mm_set1_epi32(OD_DIST_LP_MID);
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j += 4) {
+      _mm_storeu_si128((__m128i *)(e + 1 + j), _mm_sub_epi32(
+       _mm_loadu_si128((const __m128i *)(x + i*n + j)),
+       _mm_loadu_si128((const __m128i *)(y + i*n + j))));
+    }
+    e[0] = e[2];
+    e[n + 1] = e[n - 1];
+    for (j = 0; j < n; j += 4) {
+      __m128i t;
+      t = _mm_mullo_epi32(_mm_loadu_si128((__m128i *)(e + 1 + j)), mid);
+      t = _mm_add_epi32(t, _mm_loadu_si128((__m128i *)(e + j)));
+      t = _mm_add_epi32(t, _mm_loadu_si128((__m128i *)(e + 2 + j)));
+      _mm_storeu_si128((__m128i *)(tmp + (i + 1)*n + j), t);
+    }
+  }
+  OD_COPY(tmp, tmp + 2*n, n);
+  OD_COPY(tmp + (n + 1)*n, tmp + (n - 1)*n, n);
+  for (i = 0; i < n; i += 8) {
+    for (j = 0; j < n; j += 8) {
+      __m128d acc;
+      int k;
+      acc = _mm_setzero_pd();
+      for (k = 0; k < 8; k++) {
+        const od_coeff *t;
+        __m128i lo;
+        __m128i hi;
+        t = tmp + (i + k + 1)*n + j;
+        lo = _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)t), mid);
+        hi = _mm_mullo_epi32(_mm_loadu_si128((const __m128i *)(t + 4)), mid);
+        lo = _mm_add_epi32(lo, _mm_loadu_si128((const __m128i *)(t - n)));
+        hi = _mm_add_epi32(hi,
+         _mm_loadu_si128((const __m128i *)(t - n + 4)));
+        lo = _mm_add_epi32(lo, _mm_loadu_si128((const __m128i *)(t + n)));
+        hi = _mm_add_epi32(hi,
+         _mm_loadu_si128((const __m128i *)(t + n + 4)));
+        acc = od_add_sq_epi32_pd(acc, lo);
+        acc = od_add_sq_epi32_pd(acc, hi);
+      }
+      _mm_storel_pd(lp_energy + (i >> 3)*(n >> 3) + (j >> 3),
+       _mm_add_pd(acc, _mm_unpackhi_pd(acc, acc)));
+    }
+  }
+#if defined(OD_CHECKASM)
+  od_compute_dist_lp_check(lp_energy, x, y, n);
+#endif
+}
+
+#endif
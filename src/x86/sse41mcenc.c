@@ -0,0 +1,131 @@
+/*Daala video codec
+Copyright (c) 2016 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS “AS IS”
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "x86enc.h"
+#include "x86int.h"
+
+#if defined(OD_X86ASM)
+#include <smmintrin.h>
+
+/*Returns the absolute differences of eight pairs of 16-bit values, widened to
+   32 bits and added pairwise into four lanes.
+  The difference of two int16_t's can need 17 bits, but max - min is never
+   negative, so it is exact when read back as unsigned.*/
+OD_SIMD_INLINE __m128i od_mc_sad16_x8(__m128i src, __m128i ref) {
+  __m128i d;
+  d = _mm_sub_epi16(_mm_max_epi16(src, ref), _mm_min_epi16(src, ref));
+  return _mm_add_epi32(_mm_cvtepu16_epi32(d),
+   _mm_unpackhi_epi16(d, _mm_setzero_si128()));
+}
+
+/*Sums the four 32-bit lanes and applies the same rounding as
+   od_mc_compute_sad16_c().*/
+OD_SIMD_INLINE int32_t od_mc_sad16_round(__m128i sums) {
+  int32_t ret;
+  sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(0, 1, 2, 3)));
+  sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+  ret = _mm_cvtsi128_si32(sums);
+  return (ret + (1 << OD_COEFF_SHIFT >> 1)) >> OD_COEFF_SHIFT;
+}
+
+int32_t od_mc_compute_sad16_4x4_sse41(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  __m128i sums;
+  int32_t ret;
+  /*Two rows of four pixels per vector.*/
+  sums = od_mc_sad16_x8(
+   _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)src),
+   _mm_loadl_epi64((const __m128i *)(src + systride))),
+   _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)ref),
+   _mm_loadl_epi64((const __m128i *)(ref + dystride))));
+  sums = _mm_add_epi32(sums, od_mc_sad16_x8(
+   _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(src + 2*systride)),
+   _mm_loadl_epi64((const __m128i *)(src + 3*systride))),
+   _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(ref + 2*dystride)),
+   _mm_loadl_epi64((const __m128i *)(ref + 3*dystride)))));
+  ret = od_mc_sad16_round(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad16_check(src, systride, ref, dystride, 4, 4, ret);
+#endif
+  return ret;
+}
+
+/*Handle one nxn block where n is 2^ln and n >= 8.*/
+OD_SIMD_INLINE int32_t od_mc_compute_sad16_nxn_sse41(const int ln,
+ const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  const unsigned char *srow;
+  const unsigned char *drow;
+  __m128i sums;
+  int32_t ret;
+  int n;
+  int i;
+  int j;
+  n = 1 << ln;
+  OD_ASSERT(n >= 8);
+  srow = src;
+  drow = ref;
+  sums = _mm_setzero_si128();
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < 2*n; j += 16) {
+      sums = _mm_add_epi32(sums,
+       od_mc_sad16_x8(_mm_loadu_si128((const __m128i *)(srow + j)),
+       _mm_loadu_si128((const __m128i *)(drow + j))));
+    }
+    srow += systride;
+    drow += dystride;
+  }
+  ret = od_mc_sad16_round(sums);
+#if defined(OD_CHECKASM)
+  od_mc_compute_sad16_check(src, systride, ref, dystride, n, n, ret);
+#endif
+  return ret;
+}
+
+int32_t od_mc_compute_sad16_8x8_sse41(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_sse41(3, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_16x16_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_sse41(4, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_32x32_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_sse41(5, src, systride, ref, dystride);
+}
+
+int32_t od_mc_compute_sad16_64x64_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride) {
+  return od_mc_compute_sad16_nxn_sse41(6, src, systride, ref, dystride);
+}
+
+#endif
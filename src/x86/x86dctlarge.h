@@ -0,0 +1,4440 @@
+/*Daala video codec
+Copyright (c) 2002-2013 Daala project contributors.  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+- Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+- Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.*/
+
+/* This file should not be compiled as its own unit. Instead, it is included
+   into avx2dct.c and sse2dct.c after x86dct.h.
+   The 1D kernels are the ones from dct.c, run on 8 columns at a time, so the
+   results are bit-exact with the C versions. */
+
+static void fdct16_kernel(od_m256i y[16], const od_m256i x[16]) {
+  /*83 adds, 16 shifts, 33 "muls".
+    See od_bin_fdct16() for the derivation.*/
+  od_m256i t0;
+  od_m256i t1;
+  od_m256i t1h;
+  od_m256i t2;
+  od_m256i t2h;
+  od_m256i t3;
+  od_m256i t4;
+  od_m256i t5;
+  od_m256i t6;
+  od_m256i t7;
+  od_m256i t8;
+  od_m256i t8h;
+  od_m256i t9;
+  od_m256i ta;
+  od_m256i tah;
+  od_m256i tb;
+  od_m256i tbh;
+  od_m256i tc;
+  od_m256i tch;
+  od_m256i td;
+  od_m256i tdh;
+  od_m256i te;
+  od_m256i tf;
+  od_m256i tfh;
+  /*Initial permutation:*/
+  t0 = x[0];
+  t8 = x[1];
+  t4 = x[2];
+  tc = x[3];
+  te = x[4];
+  ta = x[5];
+  t6 = x[6];
+  t2 = x[7];
+  t3 = x[8];
+  td = x[9];
+  t9 = x[10];
+  tf = x[11];
+  t1 = x[12];
+  t7 = x[13];
+  tb = x[14];
+  t5 = x[15];
+  /*+1/-1 butterflies:*/
+  t5 = od_mm256_sub_epi32(t0, t5);
+  t8 = od_mm256_add_epi32(t8, tb);
+  t7 = od_mm256_sub_epi32(t4, t7);
+  tc = od_mm256_add_epi32(tc, t1);
+  tf = od_mm256_sub_epi32(te, tf);
+  ta = od_mm256_add_epi32(ta, t9);
+  td = od_mm256_sub_epi32(t6, td);
+  t2 = od_mm256_add_epi32(t2, t3);
+  t0 = od_mm256_sub_epi32(t0, od_mm256_unbiased_rshift32(t5, 1));
+  t8h = od_mm256_unbiased_rshift32(t8, 1);
+  tb = od_mm256_sub_epi32(t8h, tb);
+  t4 = od_mm256_sub_epi32(t4, od_mm256_unbiased_rshift32(t7, 1));
+  tch = od_mm256_unbiased_rshift32(tc, 1);
+  t1 = od_mm256_sub_epi32(tch, t1);
+  te = od_mm256_sub_epi32(te, od_mm256_unbiased_rshift32(tf, 1));
+  tah = od_mm256_unbiased_rshift32(ta, 1);
+  t9 = od_mm256_sub_epi32(tah, t9);
+  t6 = od_mm256_sub_epi32(t6, od_mm256_unbiased_rshift32(td, 1));
+  t2h = od_mm256_unbiased_rshift32(t2, 1);
+  t3 = od_mm256_sub_epi32(t2h, t3);
+  /*+ Embedded 8-point type-II DCT.*/
+  t0 = od_mm256_add_epi32(t0, t2h);
+  t6 = od_mm256_sub_epi32(t8h, t6);
+  t4 = od_mm256_add_epi32(t4, tah);
+  te = od_mm256_sub_epi32(tch, te);
+  t2 = od_mm256_sub_epi32(t0, t2);
+  t8 = od_mm256_sub_epi32(t8, t6);
+  ta = od_mm256_sub_epi32(t4, ta);
+  tc = od_mm256_sub_epi32(tc, te);
+  /*|-+ Embedded 4-point type-II DCT.*/
+  tc = od_mm256_sub_epi32(t0, tc);
+  t8 = od_mm256_add_epi32(t8, t4);
+  t8h = od_mm256_unbiased_rshift32(t8, 1);
+  t4 = od_mm256_sub_epi32(t8h, t4);
+  t0 = od_mm256_sub_epi32(t0, od_mm256_unbiased_rshift32(tc, 1));
+  /*|-|-+ Embedded 2-point type-II DCT.*/
+  t0 = od_mm256_add_epi32(t0, t8h);
+  t8 = od_mm256_sub_epi32(t0, t8);
+  /*|-|-+ Embedded 2-point type-IV DST.*/
+  /*32013/32768 ~= 4*sin(\frac{\pi}{8}) - 2*tan(\frac{\pi}{8}) ~=
+     0.70230660471416898931046248770220*/
+  od_mm256_overflow_check(t4, 23013, 16384, 18);
+  tc = OD_DCT_MLS_EPI32(tc, t4, 23013, 16384, 15);
+  /*10703/16384 ~= \sqrt{1/2}*cos(\frac{\pi}{8})) ~=
+     0.65328148243818826392832158671359*/
+  od_mm256_overflow_check(tc, 10703, 8192, 19);
+  t4 = OD_DCT_MLA_EPI32(t4, tc, 10703, 8192, 14);
+  /*9147/8192 ~= 4*sin(\frac{\pi}{8}) - tan(\frac{\pi}{8}) ~=
+     1.1165201670872640381121512119119*/
+  od_mm256_overflow_check(t4, 9147, 4096, 20);
+  tc = OD_DCT_MLS_EPI32(tc, t4, 9147, 4096, 13);
+  /*|-+ Embedded 4-point type-IV DST.*/
+  /*13573/32768 ~= \sqrt{2} - 1 ~= 0.41421356237309504880168872420970*/
+  od_mm256_overflow_check(ta, 13573, 16384, 21);
+  t6 = OD_DCT_MLA_EPI32(t6, ta, 13573, 16384, 15);
+  /*11585/16384 ~= \sqrt{\frac{1}{2}} ~= 0.70710678118654752440084436210485*/
+  od_mm256_overflow_check(t6, 11585, 8192, 22);
+  ta = OD_DCT_MLS_EPI32(ta, t6, 11585, 8192, 14);
+  /*13573/32768 ~= \sqrt{2} - 1 ~= 0.41421356237309504880168872420970*/
+  od_mm256_overflow_check(ta, 13573, 16384, 23);
+  t6 = OD_DCT_MLA_EPI32(t6, ta, 13573, 16384, 15);
+  ta = od_mm256_add_epi32(ta, te);
+  t2 = od_mm256_add_epi32(t2, t6);
+  te = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(ta, 1), te);
+  t6 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(t2, 1), t6);
+  /*2775/2048 ~= \frac{\sqrt{2} - cos(\frac{\pi}{16})}{2sin(\frac{\pi}{16})}
+     ~= 1.1108400393486273201524536919723*/
+  od_mm256_overflow_check(t2, 2275, 1024, 24);
+  te = OD_DCT_MLA_EPI32(te, t2, 2275, 1024, 11);
+  /*9041/32768 ~= \sqrt{2}sin(\frac{\pi}{16}) ~=
+     0.27589937928294301233595756366937*/
+  od_mm256_overflow_check(te, 9041, 16384, 25);
+  t2 = OD_DCT_MLS_EPI32(t2, te, 9041, 16384, 15);
+  /*2873/2048 ~=
+     \frac{cos(\frac{\pi}{16}) - \sqrt{\frac{1}{2}}}{sin(\frac{\pi}{16})} ~=
+     1.4028297067142967321050338435598*/
+  od_mm256_overflow_check(t2, 2873, 1024, 26);
+  te = OD_DCT_MLS_EPI32(te, t2, 2873, 1024, 11);
+  /*8593/16384 ~=
+    \frac{\sqrt{2} - cos(\frac{3\pi}{16})}{2sin(\frac{3\pi}{16})} ~=
+    0.52445569924008942966043945081053*/
+  od_mm256_overflow_check(ta, 8593, 8192, 27);
+  t6 = OD_DCT_MLS_EPI32(t6, ta, 8593, 8192, 14);
+  /*12873/16384 ~= \sqrt{2}sin(\frac{3\pi}{16}) ~=
+     0.78569495838710218127789736765722*/
+  od_mm256_overflow_check(t6, 12873, 8192, 28);
+  ta = OD_DCT_MLA_EPI32(ta, t6, 12873, 8192, 14);
+  /*7335/32768
+     ~=\frac{cos(\frac{3\pi}{16})-\sqrt{\frac{1}{2}}}{sin(\frac{3\pi}{16})}
+     ~=0.22384718209265507914012811666071*/
+  od_mm256_overflow_check(ta, 7335, 16384, 29);
+  t6 = OD_DCT_MLA_EPI32(t6, ta, 7335, 16384, 15);
+  /*+ Embedded 8-point type-IV DST.*/
+  /*1035/2048 ~=
+    \frac{\sqrt{2} - cos(\frac{7\pi}{32})}{2sin(\frac{7\pi}{32})} ~=
+    0.50536719493782972897642806316664*/
+  od_mm256_overflow_check(t5, 1035, 1024, 30);
+  t3 = OD_DCT_MLA_EPI32(t3, t5, 1035, 1024, 11);
+  /*14699/16384 ~= \sqrt{2}sin(\frac{7\pi}{32}) ~=
+     0.89716758634263628425064138922084*/
+  od_mm256_overflow_check(t3, 14699, 8192, 31);
+  t5 = OD_DCT_MLS_EPI32(t5, t3, 14699, 8192, 14);
+  /*851/8192 ~=
+    \frac{cos(\frac{7\pi}{32}) - \sqrt{\frac{1}{2}}}{sin(\frac{7\pi}{32}} ~=
+    0.10388456785615844342131055214354*/
+  od_mm256_overflow_check(t5, 851, 4096, 32);
+  t3 = OD_DCT_MLS_EPI32(t3, t5, 851, 4096, 13);
+  /*17515/32768 ~=
+     \frac{\sqrt{2} - cos(\frac{11\pi}{32})}{2sin(\frac{11\pi}{32})} ~=
+     0.53452437516842143578098634302964*/
+  od_mm256_overflow_check(td, 17515, 16384, 33);
+  tb = OD_DCT_MLA_EPI32(tb, td, 17515, 16384, 15);
+  /*20435/16384 ~= \sqrt{2}sin(\frac{11\pi}{32}) ~=
+     1.2472250129866712325719902627977*/
+  od_mm256_overflow_check(tb, 20435, 8192, 34);
+  td = OD_DCT_MLS_EPI32(td, tb, 20435, 8192, 14);
+  /*4379/16384 ~= \frac{\sqrt{\frac{1}{2}}
+     - cos(\frac{11\pi}{32})}{sin(\frac{11\pi}{32})} ~=
+     0.26726880719302561523614336238196*/
+  od_mm256_overflow_check(td, 4379, 8192, 35);
+  tb = OD_DCT_MLA_EPI32(tb, td, 4379, 8192, 14);
+  /*12905/16384 ~=
+     \frac{\sqrt{2} - cos(\frac{3\pi}{32})}{2sin(\frac{3\pi}{32})} ~=
+     0.78762894232967441973847776796517*/
+  od_mm256_overflow_check(t7, 12905, 8192, 36);
+  t9 = OD_DCT_MLA_EPI32(t9, t7, 12905, 8192, 14);
+  /*3363/8192 ~= \sqrt{2}sin(\frac{3\pi}{32}) ~=
+     0.41052452752235738115636923775513*/
+  od_mm256_overflow_check(t9, 3363, 4096, 37);
+  t7 = OD_DCT_MLS_EPI32(t7, t9, 3363, 4096, 13);
+  /*14101/16384 ~=
+     \frac{cos(\frac{3\pi}{32}) - \sqrt{\frac{1}{2}}}{sin(\frac{3\pi}{32})} ~=
+     0.86065016213948579370059934044795*/
+  od_mm256_overflow_check(t7, 14101, 8192, 38);
+  t9 = OD_DCT_MLS_EPI32(t9, t7, 14101, 8192, 14);
+  /*5417/8192 ~=
+     \frac{\sqrt{2} - cos(\frac{15\pi}{32})}{2sin(\frac{15\pi}{32})} ~=
+     0.66128246684651710406296283785232*/
+  od_mm256_overflow_check(tf, 5417, 4096, 39);
+  t1 = OD_DCT_MLA_EPI32(t1, tf, 5417, 4096, 13);
+  /*23059/16384 ~= \sqrt{2}sin(\frac{15\pi}{32}) ~=
+     1.4074037375263824590260782229840*/
+  od_mm256_overflow_check(t1, 23059, 8192, 40);
+  tf = OD_DCT_MLS_EPI32(tf, t1, 23059, 8192, 14);
+  /*20055/32768 ~=
+    \frac{\sqrt{\frac{1}{2}} - cos(\frac{15\pi}{32})}{sin(\frac{15\pi}{32})} ~=
+    0.61203676516793497752436407720666*/
+  od_mm256_overflow_check(tf, 20055, 16384, 41);
+  t1 = OD_DCT_MLA_EPI32(t1, tf, 20055, 16384, 15);
+  tf = od_mm256_sub_epi32(t3, tf);
+  td = od_mm256_add_epi32(td, t9);
+  tfh = od_mm256_unbiased_rshift32(tf, 1);
+  t3 = od_mm256_sub_epi32(t3, tfh);
+  tdh = od_mm256_unbiased_rshift32(td, 1);
+  t9 = od_mm256_sub_epi32(tdh, t9);
+  t1 = od_mm256_add_epi32(t1, t5);
+  tb = od_mm256_sub_epi32(t7, tb);
+  t1h = od_mm256_unbiased_rshift32(t1, 1);
+  t5 = od_mm256_sub_epi32(t1h, t5);
+  tbh = od_mm256_unbiased_rshift32(tb, 1);
+  t7 = od_mm256_sub_epi32(t7, tbh);
+  t3 = od_mm256_add_epi32(t3, tbh);
+  t5 = od_mm256_sub_epi32(tdh, t5);
+  t9 = od_mm256_add_epi32(t9, tfh);
+  t7 = od_mm256_sub_epi32(t1h, t7);
+  tb = od_mm256_sub_epi32(tb, t3);
+  td = od_mm256_sub_epi32(td, t5);
+  tf = od_mm256_sub_epi32(t9, tf);
+  t1 = od_mm256_sub_epi32(t1, t7);
+  /*10947/16384 ~= \frac{1 - cos(\frac{3\pi}{8})}{sin(\frac{3\pi}{8})} ~=
+     0.66817863791929891999775768652308*/
+  od_mm256_overflow_check(tb, 10947, 8192, 42);
+  t5 = OD_DCT_MLS_EPI32(t5, tb, 10947, 8192, 14);
+  /*15137/16384 ~= sin(\frac{3\pi}{8}) ~= 0.92387953251128675612818318939679*/
+  od_mm256_overflow_check(t5, 15137, 8192, 43);
+  tb = OD_DCT_MLA_EPI32(tb, t5, 15137, 8192, 14);
+  /*10947/16384 ~= \frac{1 - cos(\frac{3\pi}{8})}{sin(\frac{3\pi}{8})} ~=
+     0.66817863791929891999775768652308*/
+  od_mm256_overflow_check(tb, 10947, 8192, 44);
+  t5 = OD_DCT_MLS_EPI32(t5, tb, 10947, 8192, 14);
+  /*21895/32768 ~= \frac{1 - cos(\frac{3\pi}{8})}{sin(\frac{3\pi}{8})} ~=
+     0.66817863791929891999775768652308*/
+  od_mm256_overflow_check(t3, 21895, 16384, 45);
+  td = OD_DCT_MLA_EPI32(td, t3, 21895, 16384, 15);
+  /*15137/16384 ~= sin(\frac{3\pi}{8}) ~= 0.92387953251128675612818318939679*/
+  od_mm256_overflow_check(td, 15137, 8192, 46);
+  t3 = OD_DCT_MLS_EPI32(t3, td, 15137, 8192, 14);
+  /*10947/16384 ~= \frac{1 - cos(\frac{3\pi}{8})}{sin(\frac{3\pi}{8})} ~=
+     0.66817863791929891999775768652308*/
+  od_mm256_overflow_check(t3, 10947, 8192, 47);
+  td = OD_DCT_MLA_EPI32(td, t3, 10947, 8192, 14);
+  /*13573/32768 ~= \sqrt{2} - 1 ~= 0.41421356237309504880168872420970*/
+  od_mm256_overflow_check(tf, 13573, 16384, 48);
+  t1 = OD_DCT_MLS_EPI32(t1, tf, 13573, 16384, 15);
+  /*11585/16384 ~= \sqrt{\frac{1}{2}} ~= 0.70710678118654752440084436210485*/
+  od_mm256_overflow_check(t1, 11585, 8192, 49);
+  tf = OD_DCT_MLA_EPI32(tf, t1, 11585, 8192, 14);
+  /*13573/32768 ~= \sqrt{2} - 1 ~= 0.41421356237309504880168872420970*/
+  od_mm256_overflow_check(tf, 13573, 16384, 50);
+  t1 = OD_DCT_MLS_EPI32(t1, tf, 13573, 16384, 15);
+  y[0] = t0;
+  y[1] = t1;
+  y[2] = t2;
+  y[3] = t3;
+  y[4] = t4;
+  y[5] = t5;
+  y[6] = t6;
+  y[7] = t7;
+  y[8] = t8;
+  y[9] = t9;
+  y[10] = ta;
+  y[11] = tb;
+  y[12] = tc;
+  y[13] = td;
+  y[14] = te;
+  y[15] = tf;
+}
+
+static void idct16_kernel(od_m256i x[16], const od_m256i y[16]) {
+  od_m256i t0;
+  od_m256i t1;
+  od_m256i t1h;
+  od_m256i t2;
+  od_m256i t2h;
+  od_m256i t3;
+  od_m256i t4;
+  od_m256i t5;
+  od_m256i t6;
+  od_m256i t7;
+  od_m256i t8;
+  od_m256i t8h;
+  od_m256i t9;
+  od_m256i ta;
+  od_m256i tah;
+  od_m256i tb;
+  od_m256i tbh;
+  od_m256i tc;
+  od_m256i tch;
+  od_m256i td;
+  od_m256i tdh;
+  od_m256i te;
+  od_m256i tf;
+  od_m256i tfh;
+  t0 = y[0];
+  t1 = y[1];
+  t2 = y[2];
+  t3 = y[3];
+  t4 = y[4];
+  t5 = y[5];
+  t6 = y[6];
+  t7 = y[7];
+  t8 = y[8];
+  t9 = y[9];
+  ta = y[10];
+  tb = y[11];
+  tc = y[12];
+  td = y[13];
+  te = y[14];
+  tf = y[15];
+  t1 = OD_DCT_MLA_EPI32(t1, tf, 13573, 16384, 15);
+  tf = OD_DCT_MLS_EPI32(tf, t1, 11585, 8192, 14);
+  t1 = od_mm256_add_epi32(OD_DCT_MLA_EPI32(t1, tf, 13573, 16384, 15), t7);
+  td = OD_DCT_MLS_EPI32(td, t3, 10947, 8192, 14);
+  t3 = OD_DCT_MLA_EPI32(t3, td, 15137, 8192, 14);
+  t5 = OD_DCT_MLA_EPI32(t5, tb, 10947, 8192, 14);
+  tb = OD_DCT_MLS_EPI32(tb, t5, 15137, 8192, 14);
+  t5 = OD_DCT_MLA_EPI32(t5, tb, 10947, 8192, 14);
+  td = OD_DCT_MLS_EPI32(od_mm256_add_epi32(td, t5), t3, 21895, 16384, 15);
+  tf = od_mm256_sub_epi32(t9, tf);
+  tb = od_mm256_add_epi32(tb, t3);
+  tfh = od_mm256_unbiased_rshift32(tf, 1);
+  t9 = od_mm256_sub_epi32(t9, tfh);
+  tbh = od_mm256_unbiased_rshift32(tb, 1);
+  t3 = od_mm256_add_epi32(t3, od_mm256_sub_epi32(tfh, tbh));
+  t1h = od_mm256_unbiased_rshift32(t1, 1);
+  t7 = od_mm256_add_epi32(od_mm256_sub_epi32(t1h, t7), tbh);
+  tdh = od_mm256_unbiased_rshift32(td, 1);
+  t5 = od_mm256_add_epi32(t5, od_mm256_sub_epi32(t1h, tdh));
+  t9 = od_mm256_sub_epi32(tdh, t9);
+  td = od_mm256_sub_epi32(td, t9);
+  tf = od_mm256_sub_epi32(t3, tf);
+  t1 = od_mm256_sub_epi32(OD_DCT_MLS_EPI32(t1, tf, 20055, 16384, 15), t5);
+  tf = OD_DCT_MLA_EPI32(tf, t1, 23059, 8192, 14);
+  t1 = OD_DCT_MLS_EPI32(t1, tf, 5417, 4096, 13);
+  tb = od_mm256_sub_epi32(t7, tb);
+  t9 = OD_DCT_MLA_EPI32(t9, t7, 14101, 8192, 14);
+  t7 = OD_DCT_MLA_EPI32(t7, t9, 3363, 4096, 13);
+  t9 = OD_DCT_MLS_EPI32(t9, t7, 12905, 8192, 14);
+  tb = OD_DCT_MLS_EPI32(tb, td, 4379, 8192, 14);
+  td = OD_DCT_MLA_EPI32(td, tb, 20435, 8192, 14);
+  tb = OD_DCT_MLS_EPI32(tb, td, 17515, 16384, 15);
+  t3 = OD_DCT_MLA_EPI32(t3, t5, 851, 4096, 13);
+  t5 = OD_DCT_MLA_EPI32(t5, t3, 14699, 8192, 14);
+  t3 = OD_DCT_MLS_EPI32(t3, t5, 1035, 1024, 11);
+  t6 = OD_DCT_MLS_EPI32(t6, ta, 7335, 16384, 15);
+  ta = OD_DCT_MLS_EPI32(ta, t6, 12873, 8192, 14);
+  te = OD_DCT_MLA_EPI32(te, t2, 2873, 1024, 11);
+  t2 = OD_DCT_MLA_EPI32(t2, te, 9041, 16384, 15);
+  t6 = OD_DCT_MLS_EPI32(
+   od_mm256_sub_epi32(od_mm256_unbiased_rshift32(t2, 1), t6),
+   ta, 8593, 8192, 14);
+  te = OD_DCT_MLA_EPI32(
+   od_mm256_sub_epi32(od_mm256_unbiased_rshift32(ta, 1), te),
+   t2, 2275, 1024, 11);
+  t2 = od_mm256_sub_epi32(t2, t6);
+  ta = od_mm256_sub_epi32(ta, te);
+  t6 = OD_DCT_MLS_EPI32(t6, ta, 13573, 16384, 15);
+  ta = OD_DCT_MLA_EPI32(ta, t6, 11585, 8192, 14);
+  t6 = OD_DCT_MLS_EPI32(t6, ta, 13573, 16384, 15);
+  tc = OD_DCT_MLA_EPI32(tc, t4, 9147, 4096, 13);
+  t4 = OD_DCT_MLS_EPI32(t4, tc, 10703, 8192, 14);
+  tc = OD_DCT_MLA_EPI32(tc, t4, 23013, 16384, 15);
+  t8 = od_mm256_sub_epi32(t0, t8);
+  t8h = od_mm256_unbiased_rshift32(t8, 1);
+  t0 = od_mm256_sub_epi32(t0,
+   od_mm256_sub_epi32(t8h, od_mm256_unbiased_rshift32(tc, 1)));
+  t4 = od_mm256_sub_epi32(t8h, t4);
+  t8 = od_mm256_add_epi32(t8, od_mm256_sub_epi32(t6, t4));
+  tc = od_mm256_add_epi32(od_mm256_sub_epi32(t0, tc), te);
+  ta = od_mm256_sub_epi32(t4, ta);
+  t2 = od_mm256_sub_epi32(t0, t2);
+  tch = od_mm256_unbiased_rshift32(tc, 1);
+  te = od_mm256_sub_epi32(tch, te);
+  tah = od_mm256_unbiased_rshift32(ta, 1);
+  t4 = od_mm256_sub_epi32(t4, tah);
+  t8h = od_mm256_unbiased_rshift32(t8, 1);
+  t6 = od_mm256_sub_epi32(t8h, t6);
+  t2h = od_mm256_unbiased_rshift32(t2, 1);
+  t0 = od_mm256_sub_epi32(t0, t2h);
+  t3 = od_mm256_sub_epi32(t2h, t3);
+  t6 = od_mm256_add_epi32(t6, od_mm256_unbiased_rshift32(td, 1));
+  t9 = od_mm256_sub_epi32(tah, t9);
+  te = od_mm256_add_epi32(te, od_mm256_unbiased_rshift32(tf, 1));
+  t1 = od_mm256_sub_epi32(tch, t1);
+  t4 = od_mm256_add_epi32(t4, od_mm256_unbiased_rshift32(t7, 1));
+  tb = od_mm256_sub_epi32(t8h, tb);
+  t0 = od_mm256_add_epi32(t0, od_mm256_unbiased_rshift32(t5, 1));
+  x[0] = t0;
+  x[1] = od_mm256_sub_epi32(t8, tb);
+  x[2] = t4;
+  x[3] = od_mm256_sub_epi32(tc, t1);
+  x[4] = te;
+  x[5] = od_mm256_sub_epi32(ta, t9);
+  x[6] = t6;
+  x[7] = od_mm256_sub_epi32(t2, t3);
+  x[8] = t3;
+  x[9] = od_mm256_sub_epi32(t6, td);
+  x[10] = t9;
+  x[11] = od_mm256_sub_epi32(te, tf);
+  x[12] = t1;
+  x[13] = od_mm256_sub_epi32(t4, t7);
+  x[14] = tb;
+  x[15] = od_mm256_sub_epi32(t0, t5);
+}
+
+#define OD_MM256_FDCT_2(t0, t1) \
+  /* Embedded 2-point orthonormal Type-II fDCT. */ \
+  do { \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(t1, 13573, 16384, 100); \
+    t0 = OD_DCT_MLS_EPI32(t0, t1, 13573, 16384, 15); \
+    /* 5793/8192 ~= Sin[pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(t0, 5793, 4096, 101); \
+    t1 = OD_DCT_MLA_EPI32(t1, t0, 5793, 4096, 13); \
+    /* 3393/8192 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(t1, 3393, 4096, 102); \
+    t0 = OD_DCT_MLS_EPI32(t0, t1, 3393, 4096, 13); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_2(t0, t1) \
+  /* Embedded 2-point orthonormal Type-II iDCT. */ \
+  do { \
+    /* 3393/8192 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t1, 3393, 4096, 13); \
+    /* 5793/8192 ~= Sin[pi/4] ~= 0.707106781186547 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, t0, 5793, 4096, 13); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t1, 13573, 16384, 15); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_2_ASYM(p0, p1, p1h) \
+  /* Embedded 2-point asymmetric Type-II fDCT. */ \
+  do { \
+    p0 = od_mm256_add_epi32(p0, p1h); \
+    p1 = od_mm256_sub_epi32(p0, p1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_2_ASYM(p0, p1, p1h) \
+  /* Embedded 2-point asymmetric Type-II iDCT. */ \
+  do { \
+    p1 = od_mm256_sub_epi32(p0, p1); \
+    p1h = od_mm256_unbiased_rshift32(p1, 1); \
+    p0 = od_mm256_sub_epi32(p0, p1h); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_2(t0, t1) \
+  /* Embedded 2-point orthonormal Type-IV fDST. */ \
+  do { \
+    /* 10947/16384 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(t1, 10947, 8192, 103); \
+    t0 = OD_DCT_MLS_EPI32(t0, t1, 10947, 8192, 14); \
+    /* 473/512 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(t0, 473, 256, 104); \
+    t1 = OD_DCT_MLA_EPI32(t1, t0, 473, 256, 9); \
+    /* 10947/16384 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(t1, 10947, 8192, 105); \
+    t0 = OD_DCT_MLS_EPI32(t0, t1, 10947, 8192, 14); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_2(t0, t1) \
+  /* Embedded 2-point orthonormal Type-IV iDST. */ \
+  do { \
+    /* 10947/16384 ~= Tan[3*Pi/16]) ~= 0.668178637919299 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t1, 10947, 8192, 14); \
+    /* 473/512 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, t0, 473, 256, 9); \
+    /* 10947/16384 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t1, 10947, 8192, 14); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_2_ASYM(p0, p1) \
+  /* Embedded 2-point asymmetric Type-IV fDST. */ \
+  do { \
+    /* 11507/16384 ~= 4*Sin[Pi/8] - 2*Tan[Pi/8] ~= 0.702306604714169 */ \
+    od_mm256_overflow_check(p1, 11507, 8192, 187); \
+    p0 = OD_DCT_MLS_EPI32(p0, p1, 11507, 8192, 14); \
+    /* 669/1024 ~= Cos[Pi/8]/Sqrt[2] ~= 0.653281482438188 */ \
+    od_mm256_overflow_check(p0, 669, 512, 188); \
+    p1 = OD_DCT_MLA_EPI32(p1, p0, 669, 512, 10); \
+    /* 4573/4096 ~= 4*Sin[Pi/8] - Tan[Pi/8] ~= 1.11652016708726 */ \
+    od_mm256_overflow_check(p1, 4573, 2048, 189); \
+    p0 = OD_DCT_MLS_EPI32(p0, p1, 4573, 2048, 12); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_2_ASYM(p0, p1) \
+  /* Embedded 2-point asymmetric Type-IV iDST. */ \
+  do { \
+    /* 4573/4096 ~= 4*Sin[Pi/8] - Tan[Pi/8] ~= 1.11652016708726 */ \
+    p0 = OD_DCT_MLA_EPI32(p0, p1, 4573, 2048, 12); \
+    /* 669/1024 ~= Cos[Pi/8]/Sqrt[2] ~= 0.653281482438188 */ \
+    p1 = OD_DCT_MLS_EPI32(p1, p0, 669, 512, 10); \
+    /* 11507/16384 ~= 4*Sin[Pi/8] - 2*Tan[Pi/8] ~= 0.702306604714169 */ \
+    p0 = OD_DCT_MLA_EPI32(p0, p1, 11507, 8192, 14); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_4(q0, q2, q1, q3) \
+  /* Embedded 4-point orthonormal Type-II fDCT. */ \
+  do { \
+    od_m256i q2h; \
+    od_m256i q3h; \
+    q3 = od_mm256_sub_epi32(q0, q3); \
+    q3h = od_mm256_unbiased_rshift32(q3, 1); \
+    q0 = od_mm256_sub_epi32(q0, q3h); \
+    q2 = od_mm256_add_epi32(q2, q1); \
+    q2h = od_mm256_unbiased_rshift32(q2, 1); \
+    q1 = od_mm256_sub_epi32(q2h, q1); \
+    OD_MM256_FDCT_2_ASYM(q0, q2, q2h); \
+    OD_MM256_FDST_2_ASYM(q3, q1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_4(q0, q2, q1, q3) \
+  /* Embedded 4-point orthonormal Type-II iDCT. */ \
+  do { \
+    od_m256i q1h; \
+    od_m256i q3h; \
+    OD_MM256_IDST_2_ASYM(q3, q2); \
+    OD_MM256_IDCT_2_ASYM(q0, q1, q1h); \
+    q3h = od_mm256_unbiased_rshift32(q3, 1); \
+    q0 = od_mm256_add_epi32(q0, q3h); \
+    q3 = od_mm256_sub_epi32(q0, q3); \
+    q2 = od_mm256_sub_epi32(q1h, q2); \
+    q1 = od_mm256_sub_epi32(q1, q2); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_4_ASYM(t0, t2, t2h, t1, t3, t3h) \
+  /* Embedded 4-point asymmetric Type-II fDCT. */ \
+  do { \
+    t0 = od_mm256_add_epi32(t0, t3h); \
+    t3 = od_mm256_sub_epi32(t0, t3); \
+    t1 = od_mm256_sub_epi32(t2h, t1); \
+    t2 = od_mm256_sub_epi32(t1, t2); \
+    OD_MM256_FDCT_2(t0, t2); \
+    OD_MM256_FDST_2(t3, t1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_4_ASYM(t0, t2, t1, t1h, t3, t3h) \
+  /* Embedded 4-point asymmetric Type-II iDCT. */ \
+  do { \
+    OD_MM256_IDST_2(t3, t2); \
+    OD_MM256_IDCT_2(t0, t1); \
+    t1 = od_mm256_sub_epi32(t2, t1); \
+    t1h = od_mm256_unbiased_rshift32(t1, 1); \
+    t2 = od_mm256_sub_epi32(t1h, t2); \
+    t3 = od_mm256_sub_epi32(t0, t3); \
+    t3h = od_mm256_unbiased_rshift32(t3, 1); \
+    t0 = od_mm256_sub_epi32(t0, t3h); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_4(q0, q2, q1, q3) \
+  /* Embedded 4-point orthonormal Type-IV fDST. */ \
+  do { \
+    od_m256i q0h; \
+    od_m256i q1h; \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(q1, 13573, 16384, 190); \
+    q2 = OD_DCT_MLA_EPI32(q2, q1, 13573, 16384, 15); \
+    /* 5793/8192 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(q2, 5793, 4096, 191); \
+    q1 = OD_DCT_MLS_EPI32(q1, q2, 5793, 4096, 13); \
+    /* 3393/8192 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(q1, 3393, 4096, 192); \
+    q2 = OD_DCT_MLA_EPI32(q2, q1, 3393, 4096, 13); \
+    q0 = od_mm256_add_epi32(q0, q2); \
+    q0h = od_mm256_unbiased_rshift32(q0, 1); \
+    q2 = od_mm256_sub_epi32(q0h, q2); \
+    q1 = od_mm256_add_epi32(q1, q3); \
+    q1h = od_mm256_unbiased_rshift32(q1, 1); \
+    q3 = od_mm256_sub_epi32(q3, q1h); \
+    /* 537/1024 ~= (1/Sqrt[2] - Cos[3*Pi/16]/2)/Sin[3*Pi/16] ~=
+        0.524455699240090 */ \
+    od_mm256_overflow_check(q1, 537, 512, 193); \
+    q2 = OD_DCT_MLS_EPI32(q2, q1, 537, 512, 10); \
+    /* 1609/2048 ~= Sqrt[2]*Sin[3*Pi/16] ~= 0.785694958387102 */ \
+    od_mm256_overflow_check(q2, 1609, 1024, 194); \
+    q1 = OD_DCT_MLA_EPI32(q1, q2, 1609, 1024, 11); \
+    /* 7335/32768 ~= (1/Sqrt[2] - Cos[3*Pi/16])/Sin[3*Pi/16] ~=
+        0.223847182092655 */ \
+    od_mm256_overflow_check(q1, 7335, 16384, 195); \
+    q2 = OD_DCT_MLA_EPI32(q2, q1, 7335, 16384, 15); \
+    /* 5091/8192 ~= (1/Sqrt[2] - Cos[7*Pi/16]/2)/Sin[7*Pi/16] ~=
+        0.6215036383171189 */ \
+    od_mm256_overflow_check(q0, 5091, 4096, 196); \
+    q3 = OD_DCT_MLA_EPI32(q3, q0, 5091, 4096, 13); \
+    /* 5681/4096 ~= Sqrt[2]*Sin[7*Pi/16] ~= 1.38703984532215 */ \
+    od_mm256_overflow_check(q3, 5681, 2048, 197); \
+    q0 = OD_DCT_MLS_EPI32(q0, q3, 5681, 2048, 12); \
+    /* 4277/8192 ~= (1/Sqrt[2] - Cos[7*Pi/16])/Sin[7*Pi/16] ~=
+        0.52204745462729 */ \
+    od_mm256_overflow_check(q0, 4277, 4096, 198); \
+    q3 = OD_DCT_MLA_EPI32(q3, q0, 4277, 4096, 13); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_4(q0, q2, q1, q3) \
+  /* Embedded 4-point orthonormal Type-IV iDST. */ \
+  do { \
+    od_m256i q0h; \
+    od_m256i q2h; \
+    /* 4277/8192 ~= (1/Sqrt[2] - Cos[7*Pi/16])/Sin[7*Pi/16] ~=
+        0.52204745462729 */ \
+    q3 = OD_DCT_MLS_EPI32(q3, q0, 4277, 4096, 13); \
+    /* 5681/4096 ~= Sqrt[2]*Sin[7*Pi/16] ~= 1.38703984532215 */ \
+    q0 = OD_DCT_MLA_EPI32(q0, q3, 5681, 2048, 12); \
+    /* 5091/8192 ~= (1/Sqrt[2] - Cos[7*Pi/16]/2)/Sin[7*Pi/16] ~=
+        0.6215036383171189 */ \
+    q3 = OD_DCT_MLS_EPI32(q3, q0, 5091, 4096, 13); \
+    /* 7335/32768 ~= (1/Sqrt[2] - Cos[3*Pi/16])/Sin[3*Pi/16] ~=
+        0.223847182092655 */ \
+    q1 = OD_DCT_MLS_EPI32(q1, q2, 7335, 16384, 15); \
+    /* 1609/2048 ~= Sqrt[2]*Sin[3*Pi/16] ~= 0.785694958387102 */ \
+    q2 = OD_DCT_MLS_EPI32(q2, q1, 1609, 1024, 11); \
+    /* 537/1024 ~= (1/Sqrt[2] - Cos[3*Pi/16]/2)/Sin[3*Pi/16] ~=
+        0.524455699240090 */ \
+    q1 = OD_DCT_MLA_EPI32(q1, q2, 537, 512, 10); \
+    q2h = od_mm256_unbiased_rshift32(q2, 1); \
+    q3 = od_mm256_add_epi32(q3, q2h); \
+    q2 = od_mm256_sub_epi32(q2, q3); \
+    q0h = od_mm256_unbiased_rshift32(q0, 1); \
+    q1 = od_mm256_sub_epi32(q0h, q1); \
+    q0 = od_mm256_sub_epi32(q0, q1); \
+    /* 3393/8192 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    q1 = OD_DCT_MLS_EPI32(q1, q2, 3393, 4096, 13); \
+    /* 5793/8192 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    q2 = OD_DCT_MLA_EPI32(q2, q1, 5793, 4096, 13); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    q1 = OD_DCT_MLS_EPI32(q1, q2, 13573, 16384, 15); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_4_ASYM(t0, t0h, t2, t1, t3) \
+  /* Embedded 4-point asymmetric Type-IV fDST. */ \
+  do { \
+    /* 7489/8192 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    od_mm256_overflow_check(t1, 7489, 4096, 106); \
+    t2 = OD_DCT_MLS_EPI32(t2, t1, 7489, 4096, 13); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    od_mm256_overflow_check(t1, 11585, 8192, 107); \
+    t1 = OD_DCT_MLA_EPI32(t1, t2, 11585, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    od_mm256_overflow_check(t1, 19195, 16384, 108); \
+    t2 = OD_DCT_MLA_EPI32(t2, t1, 19195, 16384, 15); \
+    t3 = od_mm256_add_epi32(t3, od_mm256_unbiased_rshift32(t2, 1)); \
+    t2 = od_mm256_sub_epi32(t2, t3); \
+    t1 = od_mm256_sub_epi32(t0h, t1); \
+    t0 = od_mm256_sub_epi32(t0, t1); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(t0, 6723, 4096, 109); \
+    t3 = OD_DCT_MLA_EPI32(t3, t0, 6723, 4096, 13); \
+    /* 8035/8192 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    od_mm256_overflow_check(t3, 8035, 4096, 110); \
+    t0 = OD_DCT_MLS_EPI32(t0, t3, 8035, 4096, 13); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(t0, 6723, 4096, 111); \
+    t3 = OD_DCT_MLA_EPI32(t3, t0, 6723, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    od_mm256_overflow_check(t1, 8757, 8192, 112); \
+    t2 = OD_DCT_MLA_EPI32(t2, t1, 8757, 8192, 14); \
+    /* 6811/8192 ~= Sin[5*Pi/16] ~= 0.831469612302545 */ \
+    od_mm256_overflow_check(t2, 6811, 4096, 113); \
+    t1 = OD_DCT_MLS_EPI32(t1, t2, 6811, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    od_mm256_overflow_check(t1, 8757, 8192, 114); \
+    t2 = OD_DCT_MLA_EPI32(t2, t1, 8757, 8192, 14); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_4_ASYM(t0, t0h, t2, t1, t3) \
+  /* Embedded 4-point asymmetric Type-IV iDST. */ \
+  do { \
+    /* 8757/16384 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, t2, 8757, 8192, 14); \
+    /* 6811/8192 ~= Sin[5*Pi/16] ~= 0.831469612302545 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, t1, 6811, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, t2, 8757, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    t3 = OD_DCT_MLS_EPI32(t3, t0, 6723, 4096, 13); \
+    /* 8035/8192 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t3, 8035, 4096, 13); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    t3 = OD_DCT_MLS_EPI32(t3, t0, 6723, 4096, 13); \
+    t0 = od_mm256_add_epi32(t0, t2); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t2 = od_mm256_sub_epi32(t0h, t2); \
+    t1 = od_mm256_add_epi32(t1, t3); \
+    t3 = od_mm256_sub_epi32(t3, od_mm256_unbiased_rshift32(t1, 1)); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, t2, 19195, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    t2 = OD_DCT_MLS_EPI32(t2, t1, 11585, 8192, 14); \
+    /* 7489/8192 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t2, 7489, 4096, 13); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_8(r0, r4, r2, r6, r1, r5, r3, r7) \
+  /* Embedded 8-point orthonormal Type-II fDCT. */ \
+  do { \
+    od_m256i r4h; \
+    od_m256i r5h; \
+    od_m256i r6h; \
+    od_m256i r7h; \
+    r7 = od_mm256_sub_epi32(r0, r7); \
+    r7h = od_mm256_unbiased_rshift32(r7, 1); \
+    r0 = od_mm256_sub_epi32(r0, r7h); \
+    r6 = od_mm256_add_epi32(r6, r1); \
+    r6h = od_mm256_unbiased_rshift32(r6, 1); \
+    r1 = od_mm256_sub_epi32(r6h, r1); \
+    r5 = od_mm256_sub_epi32(r2, r5); \
+    r5h = od_mm256_unbiased_rshift32(r5, 1); \
+    r2 = od_mm256_sub_epi32(r2, r5h); \
+    r4 = od_mm256_add_epi32(r4, r3); \
+    r4h = od_mm256_unbiased_rshift32(r4, 1); \
+    r3 = od_mm256_sub_epi32(r4h, r3); \
+    OD_MM256_FDCT_4_ASYM(r0, r4, r4h, r2, r6, r6h); \
+    OD_MM256_FDST_4_ASYM(r7, r7h, r3, r5, r1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_8(r0, r4, r2, r6, r1, r5, r3, r7) \
+  /* Embedded 8-point orthonormal Type-II iDCT. */ \
+  do { \
+    od_m256i r1h; \
+    od_m256i r3h; \
+    od_m256i r5h; \
+    od_m256i r7h; \
+    OD_MM256_IDST_4_ASYM(r7, r7h, r5, r6, r4); \
+    OD_MM256_IDCT_4_ASYM(r0, r2, r1, r1h, r3, r3h); \
+    r0 = od_mm256_add_epi32(r0, r7h); \
+    r7 = od_mm256_sub_epi32(r0, r7); \
+    r6 = od_mm256_sub_epi32(r1h, r6); \
+    r1 = od_mm256_sub_epi32(r1, r6); \
+    r5h = od_mm256_unbiased_rshift32(r5, 1); \
+    r2 = od_mm256_add_epi32(r2, r5h); \
+    r5 = od_mm256_sub_epi32(r2, r5); \
+    r4 = od_mm256_sub_epi32(r3h, r4); \
+    r3 = od_mm256_sub_epi32(r3, r4); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_8_ASYM(r0, r4, r4h, r2, r6, r6h, r1, r5, r5h, r3, r7, r7h) \
+  /* Embedded 8-point asymmetric Type-II fDCT. */ \
+  do { \
+    r0 = od_mm256_add_epi32(r0, r7h); \
+    r7 = od_mm256_sub_epi32(r0, r7); \
+    r1 = od_mm256_sub_epi32(r6h, r1); \
+    r6 = od_mm256_sub_epi32(r6, r1); \
+    r2 = od_mm256_add_epi32(r2, r5h); \
+    r5 = od_mm256_sub_epi32(r2, r5); \
+    r3 = od_mm256_sub_epi32(r4h, r3); \
+    r4 = od_mm256_sub_epi32(r4, r3); \
+    OD_MM256_FDCT_4(r0, r4, r2, r6); \
+    OD_MM256_FDST_4(r7, r3, r5, r1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_8_ASYM(r0, r4, r2, r6, r1, r1h, r5, r5h, r3, r3h, r7, r7h) \
+  /* Embedded 8-point asymmetric Type-II iDCT. */ \
+  do { \
+    OD_MM256_IDST_4(r7, r5, r6, r4); \
+    OD_MM256_IDCT_4(r0, r2, r1, r3); \
+    r7 = od_mm256_sub_epi32(r0, r7); \
+    r7h = od_mm256_unbiased_rshift32(r7, 1); \
+    r0 = od_mm256_sub_epi32(r0, r7h); \
+    r1 = od_mm256_add_epi32(r1, r6); \
+    r1h = od_mm256_unbiased_rshift32(r1, 1); \
+    r6 = od_mm256_sub_epi32(r1h, r6); \
+    r5 = od_mm256_sub_epi32(r2, r5); \
+    r5h = od_mm256_unbiased_rshift32(r5, 1); \
+    r2 = od_mm256_sub_epi32(r2, r5h); \
+    r3 = od_mm256_add_epi32(r3, r4); \
+    r3h = od_mm256_unbiased_rshift32(r3, 1); \
+    r4 = od_mm256_sub_epi32(r3h, r4); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_8(t0, t4, t2, t6, t1, t5, t3, t7) \
+  /* Embedded 8-point orthonormal Type-IV fDST. */ \
+  do { \
+    od_m256i t0h; \
+    od_m256i t2h; \
+    od_m256i t5h; \
+    od_m256i t7h; \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(t1, 13573, 16384, 115); \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(t6, 11585, 8192, 116); \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(t1, 13573, 16384, 117); \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 13573, 16384, 15); \
+    /* 21895/32768 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(t2, 21895, 16384, 118); \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 21895, 16384, 15); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(t5, 15137, 8192, 119); \
+    t2 = OD_DCT_MLA_EPI32(t2, t5, 15137, 8192, 14); \
+    /* 10947/16384 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(t2, 10947, 8192, 120); \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 10947, 8192, 14); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    od_mm256_overflow_check(t3, 3259, 8192, 121); \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 3259, 8192, 14); \
+    /* 3135/8192 ~= Sin[Pi/8] ~= 0.382683432365090 */ \
+    od_mm256_overflow_check(t4, 3135, 4096, 122); \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 3135, 4096, 13); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    od_mm256_overflow_check(t3, 3259, 8192, 123); \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 3259, 8192, 14); \
+    t7 = od_mm256_add_epi32(t7, t1); \
+    t7h = od_mm256_unbiased_rshift32(t7, 1); \
+    t1 = od_mm256_sub_epi32(t1, t7h); \
+    t2 = od_mm256_sub_epi32(t3, t2); \
+    t2h = od_mm256_unbiased_rshift32(t2, 1); \
+    t3 = od_mm256_sub_epi32(t3, t2h); \
+    t0 = od_mm256_sub_epi32(t0, t6); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t6 = od_mm256_add_epi32(t6, t0h); \
+    t5 = od_mm256_sub_epi32(t4, t5); \
+    t5h = od_mm256_unbiased_rshift32(t5, 1); \
+    t4 = od_mm256_sub_epi32(t4, t5h); \
+    t1 = od_mm256_add_epi32(t1, t5h); \
+    t5 = od_mm256_sub_epi32(t1, t5); \
+    t4 = od_mm256_add_epi32(t4, t0h); \
+    t0 = od_mm256_sub_epi32(t0, t4); \
+    t6 = od_mm256_sub_epi32(t6, t2h); \
+    t2 = od_mm256_add_epi32(t2, t6); \
+    t3 = od_mm256_sub_epi32(t3, t7h); \
+    t7 = od_mm256_add_epi32(t7, t3); \
+    /* TODO: Can we move this into another operation */ \
+    t7 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t7); \
+    /* 7425/8192 ~= Tan[15*Pi/64] ~= 0.906347169019147 */ \
+    od_mm256_overflow_check(t7, 7425, 4096, 124); \
+    t0 = OD_DCT_MLS_EPI32(t0, t7, 7425, 4096, 13); \
+    /* 8153/8192 ~= Sin[15*Pi/32] ~= 0.995184726672197 */ \
+    od_mm256_overflow_check(t0, 8153, 4096, 125); \
+    t7 = OD_DCT_MLA_EPI32(t7, t0, 8153, 4096, 13); \
+    /* 7425/8192 ~= Tan[15*Pi/64] ~= 0.906347169019147 */ \
+    od_mm256_overflow_check(t7, 7425, 4096, 126); \
+    t0 = OD_DCT_MLS_EPI32(t0, t7, 7425, 4096, 13); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.148335987538347 */ \
+    od_mm256_overflow_check(t1, 4861, 16384, 127); \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 4861, 16384, 15); \
+    /* 1189/4096 ~= Sin[3*Pi/32] ~= 0.290284677254462 */ \
+    od_mm256_overflow_check(t6, 1189, 2048, 128); \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 1189, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.148335987538347 */ \
+    od_mm256_overflow_check(t1, 4861, 16384, 129); \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 4861, 16384, 15); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.599376933681924 */ \
+    od_mm256_overflow_check(t5, 2455, 2048, 130); \
+    t2 = OD_DCT_MLS_EPI32(t2, t5, 2455, 2048, 12); \
+    /* 7225/8192 ~= Sin[11*Pi/32] ~= 0.881921264348355 */ \
+    od_mm256_overflow_check(t2, 7225, 4096, 131); \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 7225, 4096, 13); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.599376933681924 */ \
+    od_mm256_overflow_check(t5, 2455, 2048, 132); \
+    t2 = OD_DCT_MLS_EPI32(t2, t5, 2455, 2048, 12); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.357805721314524 */ \
+    od_mm256_overflow_check(t3, 11725, 16384, 133); \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 11725, 16384, 15); \
+    /* 5197/8192 ~= Sin[7*Pi/32] ~= 0.634393284163645 */ \
+    od_mm256_overflow_check(t4, 5197, 4096, 134); \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 5197, 4096, 13); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.357805721314524 */ \
+    od_mm256_overflow_check(t3, 11725, 16384, 135); \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 11725, 16384, 15); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_8(t0, t4, t2, t6, t1, t5, t3, t7) \
+  /* Embedded 8-point orthonormal Type-IV iDST. */ \
+  do { \
+    od_m256i t0h; \
+    od_m256i t2h; \
+    od_m256i t5h_; \
+    od_m256i t7h_; \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.357805721314524 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 11725, 16384, 15); \
+    /* 5197/8192 ~= Sin[7*Pi/32] ~= 0.634393284163645 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 5197, 4096, 13); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.357805721314524 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 11725, 16384, 15); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.599376933681924 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, t5, 2455, 2048, 12); \
+    /* 7225/8192 ~= Sin[11*Pi/32] ~= 0.881921264348355 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 7225, 4096, 13); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.599376933681924 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, t5, 2455, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.148335987538347 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 4861, 16384, 15); \
+    /* 1189/4096 ~= Sin[3*Pi/32] ~= 0.290284677254462 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 1189, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.148335987538347 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 4861, 16384, 15); \
+    /* 7425/8192 ~= Tan[15*Pi/64] ~= 0.906347169019147 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t7, 7425, 4096, 13); \
+    /* 8153/8192 ~= Sin[15*Pi/32] ~= 0.995184726672197 */ \
+    t7 = OD_DCT_MLS_EPI32(t7, t0, 8153, 4096, 13); \
+    /* 7425/8192 ~= Tan[15*Pi/64] ~= 0.906347169019147 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t7, 7425, 4096, 13); \
+    /* TODO: Can we move this into another operation */ \
+    t7 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t7); \
+    t7 = od_mm256_sub_epi32(t7, t6); \
+    t7h_ = od_mm256_unbiased_rshift32(t7, 1); \
+    t6 = od_mm256_add_epi32(t6, t7h_); \
+    t2 = od_mm256_sub_epi32(t2, t3); \
+    t2h = od_mm256_unbiased_rshift32(t2, 1); \
+    t3 = od_mm256_add_epi32(t3, t2h); \
+    t0 = od_mm256_add_epi32(t0, t1); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t1 = od_mm256_sub_epi32(t1, t0h); \
+    t5 = od_mm256_sub_epi32(t4, t5); \
+    t5h_ = od_mm256_unbiased_rshift32(t5, 1); \
+    t4 = od_mm256_sub_epi32(t4, t5h_); \
+    t1 = od_mm256_add_epi32(t1, t5h_); \
+    t5 = od_mm256_sub_epi32(t1, t5); \
+    t3 = od_mm256_sub_epi32(t3, t0h); \
+    t0 = od_mm256_add_epi32(t0, t3); \
+    t6 = od_mm256_add_epi32(t6, t2h); \
+    t2 = od_mm256_sub_epi32(t6, t2); \
+    t4 = od_mm256_add_epi32(t4, t7h_); \
+    t7 = od_mm256_sub_epi32(t7, t4); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 3259, 8192, 14); \
+    /* 3135/8192 ~= Sin[Pi/8] ~= 0.382683432365090 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 3135, 4096, 13); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 3259, 8192, 14); \
+    /* 10947/16384 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 10947, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t2 = OD_DCT_MLS_EPI32(t2, t5, 15137, 8192, 14); \
+    /* 21895/32768 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 21895, 16384, 15); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 13573, 16384, 15); \
+  } \
+  while (0)
+
+/* Rewrite this so that t0h can be passed in. */
+#define OD_MM256_FDST_8_ASYM(t0, t4, t2, t6, t1, t5, t3, t7) \
+  /* Embedded 8-point asymmetric Type-IV fDST. */ \
+  do { \
+    od_m256i t0h; \
+    od_m256i t2h; \
+    od_m256i t5h; \
+    od_m256i t7h; \
+    /* 1035/2048 ~= (Sqrt[2] - Cos[7*Pi/32])/(2*Sin[7*Pi/32]) ~=
+        0.505367194937830 */ \
+    od_mm256_overflow_check(t1, 1035, 1024, 199); \
+    t6 = OD_DCT_MLA_EPI32(t6, t1, 1035, 1024, 11); \
+    /* 3675/4096 ~= Sqrt[2]*Sin[7*Pi/32] ~= 0.897167586342636 */ \
+    od_mm256_overflow_check(t6, 3675, 2048, 200); \
+    t1 = OD_DCT_MLS_EPI32(t1, t6, 3675, 2048, 12); \
+    /* 851/8192 ~= (Cos[7*Pi/32] - 1/Sqrt[2])/Sin[7*Pi/32] ~=
+        0.103884567856159 */ \
+    od_mm256_overflow_check(t1, 851, 4096, 201); \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 851, 4096, 13); \
+    /* 4379/8192 ~= (Sqrt[2] - Sin[5*Pi/32])/(2*Cos[5*Pi/32]) ~=
+        0.534524375168421 */ \
+    od_mm256_overflow_check(t2, 4379, 4096, 202); \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 4379, 4096, 13); \
+    /* 10217/8192 ~= Sqrt[2]*Cos[5*Pi/32] ~= 1.24722501298667 */ \
+    od_mm256_overflow_check(t5, 10217, 4096, 203); \
+    t2 = OD_DCT_MLS_EPI32(t2, t5, 10217, 4096, 13); \
+    /* 4379/16384 ~= (1/Sqrt[2] - Sin[5*Pi/32])/Cos[5*Pi/32] ~=
+        0.267268807193026 */ \
+    od_mm256_overflow_check(t2, 4379, 8192, 204); \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 4379, 8192, 14); \
+    /* 12905/16384 ~= (Sqrt[2] - Cos[3*Pi/32])/(2*Sin[3*Pi/32]) ~=
+        0.787628942329675 */ \
+    od_mm256_overflow_check(t3, 12905, 8192, 205); \
+    t4 = OD_DCT_MLA_EPI32(t4, t3, 12905, 8192, 14); \
+    /* 3363/8192 ~= Sqrt[2]*Sin[3*Pi/32] ~= 0.410524527522357 */ \
+    od_mm256_overflow_check(t4, 3363, 4096, 206); \
+    t3 = OD_DCT_MLS_EPI32(t3, t4, 3363, 4096, 13); \
+    /* 3525/4096 ~= (Cos[3*Pi/32] - 1/Sqrt[2])/Sin[3*Pi/32] ~=
+        0.860650162139486 */ \
+    od_mm256_overflow_check(t3, 3525, 2048, 207); \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 3525, 2048, 12); \
+    /* 5417/8192 ~= (Sqrt[2] - Sin[Pi/32])/(2*Cos[Pi/32]) ~=
+        0.661282466846517 */ \
+    od_mm256_overflow_check(t0, 5417, 4096, 208); \
+    t7 = OD_DCT_MLA_EPI32(t7, t0, 5417, 4096, 13); \
+    /* 5765/4096 ~= Sqrt[2]*Cos[Pi/32] ~= 1.40740373752638 */ \
+    od_mm256_overflow_check(t7, 5765, 2048, 209); \
+    t0 = OD_DCT_MLS_EPI32(t0, t7, 5765, 2048, 12); \
+    /* 2507/4096 ~= (1/Sqrt[2] - Sin[Pi/32])/Cos[Pi/32] ~=
+        0.612036765167935 */ \
+    od_mm256_overflow_check(t0, 2507, 2048, 210); \
+    t7 = OD_DCT_MLA_EPI32(t7, t0, 2507, 2048, 12); \
+    t0 = od_mm256_add_epi32(t0, t1); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t1 = od_mm256_sub_epi32(t1, t0h); \
+    t2 = od_mm256_sub_epi32(t2, t3); \
+    t2h = od_mm256_unbiased_rshift32(t2, 1); \
+    t3 = od_mm256_add_epi32(t3, t2h); \
+    t5 = od_mm256_sub_epi32(t5, t4); \
+    t5h = od_mm256_unbiased_rshift32(t5, 1); \
+    t4 = od_mm256_add_epi32(t4, t5h); \
+    t7 = od_mm256_add_epi32(t7, t6); \
+    t7h = od_mm256_unbiased_rshift32(t7, 1); \
+    t6 = od_mm256_sub_epi32(t7h, t6); \
+    t4 = od_mm256_sub_epi32(t7h, t4); \
+    t7 = od_mm256_sub_epi32(t7, t4); \
+    t1 = od_mm256_add_epi32(t1, t5h); \
+    t5 = od_mm256_sub_epi32(t1, t5); \
+    t6 = od_mm256_add_epi32(t6, t2h); \
+    t2 = od_mm256_sub_epi32(t6, t2); \
+    t3 = od_mm256_sub_epi32(t3, t0h); \
+    t0 = od_mm256_add_epi32(t0, t3); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    od_mm256_overflow_check(t6, 3259, 8192, 211); \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 3259, 8192, 14); \
+    /* 3135/8192 ~= Sin[Pi/8] ~= 0.382683432365090 */ \
+    od_mm256_overflow_check(t1, 3135, 4096, 212); \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 3135, 4096, 13); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    od_mm256_overflow_check(t6, 3259, 8192, 213); \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 3259, 8192, 14); \
+    /* 2737/4096 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(t2, 2737, 2048, 214); \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 2737, 2048, 12); \
+    /* 473/512 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(t5, 473, 256, 215); \
+    t2 = OD_DCT_MLS_EPI32(t2, t5, 473, 256, 9); \
+    /* 2737/4096 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(t2, 2737, 2048, 216); \
+    t5 = OD_DCT_MLA_EPI32(t5, t2, 2737, 2048, 12); \
+    /* 3393/8192 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(t4, 3393, 4096, 217); \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 3393, 4096, 13); \
+    /* 5793/8192 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(t3, 5793, 4096, 218); \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 5793, 4096, 13); \
+    /* 3393/8192 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(t4, 3393, 4096, 219); \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 3393, 4096, 13); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_8_ASYM(t0, t4, t2, t6, t1, t5, t3, t7) \
+  /* Embedded 8-point asymmetric Type-IV iDST. */ \
+  do { \
+    od_m256i t0h; \
+    od_m256i t2h; \
+    od_m256i t5h__; \
+    od_m256i t7h__; \
+    /* 3393/8192 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 3393, 4096, 13); \
+    /* 5793/8192 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 5793, 4096, 13); \
+    /* 3393/8192 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, t1, 3393, 4096, 13); \
+    /* 2737/4096 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 2737, 2048, 12); \
+    /* 473/512 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, t5, 473, 256, 9); \
+    /* 2737/4096 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 2737, 2048, 12); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 3259, 8192, 14); \
+    /* 3135/8192 ~= Sin[Pi/8] ~= 0.382683432365090 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 3135, 4096, 13); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, t3, 3259, 8192, 14); \
+    t0 = od_mm256_sub_epi32(t0, t6); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t6 = od_mm256_add_epi32(t6, t0h); \
+    t2 = od_mm256_sub_epi32(t3, t2); \
+    t2h = od_mm256_unbiased_rshift32(t2, 1); \
+    t3 = od_mm256_sub_epi32(t3, t2h); \
+    t5 = od_mm256_sub_epi32(t4, t5); \
+    t5h__ = od_mm256_unbiased_rshift32(t5, 1); \
+    t4 = od_mm256_sub_epi32(t4, t5h__); \
+    t7 = od_mm256_add_epi32(t7, t1); \
+    t7h__ = od_mm256_unbiased_rshift32(t7, 1); \
+    t1 = od_mm256_sub_epi32(t7h__, t1); \
+    t3 = od_mm256_sub_epi32(t7h__, t3); \
+    t7 = od_mm256_sub_epi32(t7, t3); \
+    t1 = od_mm256_sub_epi32(t1, t5h__); \
+    t5 = od_mm256_add_epi32(t5, t1); \
+    t6 = od_mm256_sub_epi32(t6, t2h); \
+    t2 = od_mm256_add_epi32(t2, t6); \
+    t4 = od_mm256_add_epi32(t4, t0h); \
+    t0 = od_mm256_sub_epi32(t0, t4); \
+    /* 2507/4096 ~= (1/Sqrt[2] - Sin[Pi/32])/Cos[Pi/32] ~=
+        0.612036765167935 */ \
+    t7 = OD_DCT_MLS_EPI32(t7, t0, 2507, 2048, 12); \
+    /* 5765/4096 ~= Sqrt[2]*Cos[Pi/32] ~= 1.40740373752638 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, t7, 5765, 2048, 12); \
+    /* 5417/8192 ~= (Sqrt[2] - Sin[Pi/32])/(2*Cos[Pi/32]) ~=
+        0.661282466846517 */ \
+    t7 = OD_DCT_MLS_EPI32(t7, t0, 5417, 4096, 13); \
+    /* 3525/4096 ~= (Cos[3*Pi/32] - 1/Sqrt[2])/Sin[3*Pi/32] ~=
+        0.860650162139486 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, t6, 3525, 2048, 12); \
+    /* 3363/8192 ~= Sqrt[2]*Sin[3*Pi/32] ~= 0.410524527522357 */ \
+    t6 = OD_DCT_MLA_EPI32(t6, t1, 3363, 4096, 13); \
+    /* 12905/16384 ~= (1/Sqrt[2] - Cos[3*Pi/32]/1)/Sin[3*Pi/32] ~=
+        0.787628942329675 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, t6, 12905, 8192, 14); \
+    /* 4379/16384 ~= (1/Sqrt[2] - Sin[5*Pi/32])/Cos[5*Pi/32] ~=
+        0.267268807193026 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 4379, 8192, 14); \
+    /* 10217/8192 ~= Sqrt[2]*Cos[5*Pi/32] ~= 1.24722501298667 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, t5, 10217, 4096, 13); \
+    /* 4379/8192 ~= (Sqrt[2] - Sin[5*Pi/32])/(2*Cos[5*Pi/32]) ~=
+        0.534524375168421 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, t2, 4379, 4096, 13); \
+    /* 851/8192 ~= (Cos[7*Pi/32] - 1/Sqrt[2])/Sin[7*Pi/32] ~=
+        0.103884567856159 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, t4, 851, 4096, 13); \
+    /* 3675/4096 ~= Sqrt[2]*Sin[7*Pi/32] ~= 0.897167586342636 */ \
+    t4 = OD_DCT_MLA_EPI32(t4, t3, 3675, 2048, 12); \
+    /* 1035/2048 ~= (Sqrt[2] - Cos[7*Pi/32])/(2*Sin[7*Pi/32]) ~=
+        0.505367194937830 */ \
+    t3 = OD_DCT_MLS_EPI32(t3, t4, 1035, 1024, 11); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_16(s0, s8, s4, sc, s2, sa, s6, se, \
+ s1, s9, s5, sd, s3, sb, s7, sf) \
+  /* Embedded 16-point orthonormal Type-II fDCT. */ \
+  do { \
+    od_m256i s8h; \
+    od_m256i sah; \
+    od_m256i sch; \
+    od_m256i seh; \
+    od_m256i sfh; \
+    sf = od_mm256_sub_epi32(s0, sf); \
+    sfh = od_mm256_unbiased_rshift32(sf, 1); \
+    s0 = od_mm256_sub_epi32(s0, sfh); \
+    se = od_mm256_add_epi32(se, s1); \
+    seh = od_mm256_unbiased_rshift32(se, 1); \
+    s1 = od_mm256_sub_epi32(seh, s1); \
+    sd = od_mm256_sub_epi32(s2, sd); \
+    s2 = od_mm256_sub_epi32(s2, od_mm256_unbiased_rshift32(sd, 1)); \
+    sc = od_mm256_add_epi32(sc, s3); \
+    sch = od_mm256_unbiased_rshift32(sc, 1); \
+    s3 = od_mm256_sub_epi32(sch, s3); \
+    sb = od_mm256_sub_epi32(s4, sb); \
+    s4 = od_mm256_sub_epi32(s4, od_mm256_unbiased_rshift32(sb, 1)); \
+    sa = od_mm256_add_epi32(sa, s5); \
+    sah = od_mm256_unbiased_rshift32(sa, 1); \
+    s5 = od_mm256_sub_epi32(sah, s5); \
+    s9 = od_mm256_sub_epi32(s6, s9); \
+    s6 = od_mm256_sub_epi32(s6, od_mm256_unbiased_rshift32(s9, 1)); \
+    s8 = od_mm256_add_epi32(s8, s7); \
+    s8h = od_mm256_unbiased_rshift32(s8, 1); \
+    s7 = od_mm256_sub_epi32(s8h, s7); \
+    OD_MM256_FDCT_8_ASYM(s0, s8, s8h, s4, sc, sch, s2, sa, sah, s6, se, seh); \
+    OD_MM256_FDST_8_ASYM(sf, s7, sb, s3, sd, s5, s9, s1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_16(s0, s8, s4, sc, s2, sa, s6, se, \
+ s1, s9, s5, sd, s3, sb, s7, sf) \
+  /* Embedded 16-point orthonormal Type-II iDCT. */ \
+  do { \
+    od_m256i s1h; \
+    od_m256i s3h; \
+    od_m256i s5h; \
+    od_m256i s7h; \
+    od_m256i sfh; \
+    OD_MM256_IDST_8_ASYM(sf, sb, sd, s9, se, sa, sc, s8); \
+    OD_MM256_IDCT_8_ASYM(s0, s4, s2, s6, s1, s1h, s5, s5h, s3, s3h, s7, s7h); \
+    sfh = od_mm256_unbiased_rshift32(sf, 1); \
+    s0 = od_mm256_add_epi32(s0, sfh); \
+    sf = od_mm256_sub_epi32(s0, sf); \
+    se = od_mm256_sub_epi32(s1h, se); \
+    s1 = od_mm256_sub_epi32(s1, se); \
+    s2 = od_mm256_add_epi32(s2, od_mm256_unbiased_rshift32(sd, 1)); \
+    sd = od_mm256_sub_epi32(s2, sd); \
+    sc = od_mm256_sub_epi32(s3h, sc); \
+    s3 = od_mm256_sub_epi32(s3, sc); \
+    s4 = od_mm256_add_epi32(s4, od_mm256_unbiased_rshift32(sb, 1)); \
+    sb = od_mm256_sub_epi32(s4, sb); \
+    sa = od_mm256_sub_epi32(s5h, sa); \
+    s5 = od_mm256_sub_epi32(s5, sa); \
+    s6 = od_mm256_add_epi32(s6, od_mm256_unbiased_rshift32(s9, 1)); \
+    s9 = od_mm256_sub_epi32(s6, s9); \
+    s8 = od_mm256_sub_epi32(s7h, s8); \
+    s7 = od_mm256_sub_epi32(s7, s8); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_16_ASYM(t0, t8, t8h, t4, tc, tch, t2, ta, tah, t6, te, teh, \
+ t1, t9, t9h, t5, td, tdh, t3, tb, tbh, t7, tf, tfh) \
+  /* Embedded 16-point asymmetric Type-II fDCT. */ \
+  do { \
+    t0 = od_mm256_add_epi32(t0, tfh); \
+    tf = od_mm256_sub_epi32(t0, tf); \
+    t1 = od_mm256_sub_epi32(t1, teh); \
+    te = od_mm256_add_epi32(te, t1); \
+    t2 = od_mm256_add_epi32(t2, tdh); \
+    td = od_mm256_sub_epi32(t2, td); \
+    t3 = od_mm256_sub_epi32(t3, tch); \
+    tc = od_mm256_add_epi32(tc, t3); \
+    t4 = od_mm256_add_epi32(t4, tbh); \
+    tb = od_mm256_sub_epi32(t4, tb); \
+    t5 = od_mm256_sub_epi32(t5, tah); \
+    ta = od_mm256_add_epi32(ta, t5); \
+    t6 = od_mm256_add_epi32(t6, t9h); \
+    t9 = od_mm256_sub_epi32(t6, t9); \
+    t7 = od_mm256_sub_epi32(t7, t8h); \
+    t8 = od_mm256_add_epi32(t8, t7); \
+    OD_MM256_FDCT_8(t0, t8, t4, tc, t2, ta, t6, te); \
+    OD_MM256_FDST_8(tf, t7, tb, t3, td, t5, t9, t1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_16_ASYM(t0, t8, t4, tc, t2, ta, t6, te, \
+ t1, t1h, t9, t9h, t5, t5h, td, tdh, t3, t3h, tb, tbh, t7, t7h, tf, tfh) \
+  /* Embedded 16-point asymmetric Type-II iDCT. */ \
+  do { \
+    OD_MM256_IDST_8(tf, tb, td, t9, te, ta, tc, t8); \
+    OD_MM256_IDCT_8(t0, t4, t2, t6, t1, t5, t3, t7); \
+    t1 = od_mm256_sub_epi32(t1, te); \
+    t1h = od_mm256_unbiased_rshift32(t1, 1); \
+    te = od_mm256_add_epi32(te, t1h); \
+    t9 = od_mm256_sub_epi32(t6, t9); \
+    t9h = od_mm256_unbiased_rshift32(t9, 1); \
+    t6 = od_mm256_sub_epi32(t6, t9h); \
+    t5 = od_mm256_sub_epi32(t5, ta); \
+    t5h = od_mm256_unbiased_rshift32(t5, 1); \
+    ta = od_mm256_add_epi32(ta, t5h); \
+    td = od_mm256_sub_epi32(t2, td); \
+    tdh = od_mm256_unbiased_rshift32(td, 1); \
+    t2 = od_mm256_sub_epi32(t2, tdh); \
+    t3 = od_mm256_sub_epi32(t3, tc); \
+    t3h = od_mm256_unbiased_rshift32(t3, 1); \
+    tc = od_mm256_add_epi32(tc, t3h); \
+    tb = od_mm256_sub_epi32(t4, tb); \
+    tbh = od_mm256_unbiased_rshift32(tb, 1); \
+    t4 = od_mm256_sub_epi32(t4, tbh); \
+    t7 = od_mm256_sub_epi32(t7, t8); \
+    t7h = od_mm256_unbiased_rshift32(t7, 1); \
+    t8 = od_mm256_add_epi32(t8, t7h); \
+    tf = od_mm256_sub_epi32(t0, tf); \
+    tfh = od_mm256_unbiased_rshift32(tf, 1); \
+    t0 = od_mm256_sub_epi32(t0, tfh); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_16(s0, s8, s4, sc, s2, sa, s6, se, \
+ s1, s9, s5, sd, s3, sb, s7, sf) \
+  /* Embedded 16-point orthonormal Type-IV fDST. */ \
+  do { \
+    od_m256i s0h; \
+    od_m256i s2h; \
+    od_m256i sdh; \
+    od_m256i sfh; \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(s3, 13573, 16384, 220); \
+    s1 = OD_DCT_MLA_EPI32(s1, se, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(s1, 11585, 8192, 221); \
+    se = OD_DCT_MLS_EPI32(se, s1, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(s3, 13573, 16384, 222); \
+    s1 = OD_DCT_MLA_EPI32(s1, se, 13573, 16384, 15); \
+    /* 21895/32768 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(s2, 21895, 16384, 223); \
+    sd = OD_DCT_MLA_EPI32(sd, s2, 21895, 16384, 15); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(sd, 15137, 16384, 224); \
+    s2 = OD_DCT_MLS_EPI32(s2, sd, 15137, 8192, 14); \
+    /* 21895/32768 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    od_mm256_overflow_check(s2, 21895, 16384, 225); \
+    sd = OD_DCT_MLA_EPI32(sd, s2, 21895, 16384, 15); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    od_mm256_overflow_check(s3, 3259, 8192, 226); \
+    sc = OD_DCT_MLA_EPI32(sc, s3, 3259, 8192, 14); \
+    /* 3135/8192 ~= Sin[Pi/8] ~= 0.382683432365090 */ \
+    od_mm256_overflow_check(sc, 3135, 4096, 227); \
+    s3 = OD_DCT_MLS_EPI32(s3, sc, 3135, 4096, 13); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    od_mm256_overflow_check(s3, 3259, 8192, 228); \
+    sc = OD_DCT_MLA_EPI32(sc, s3, 3259, 8192, 14); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(s5, 13573, 16384, 229); \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(sa, 11585, 8192, 230); \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[Pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(s5, 13573, 16384, 231); \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 13573, 16384, 15); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(s9, 13573, 16384, 232); \
+    s6 = OD_DCT_MLA_EPI32(s6, s9, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[pi/4] ~= 0.707106781186547 */ \
+    od_mm256_overflow_check(s6, 11585, 8192, 233); \
+    s9 = OD_DCT_MLS_EPI32(s9, s6, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    od_mm256_overflow_check(s9, 13573, 16384, 234); \
+    s6 = OD_DCT_MLA_EPI32(s6, s9, 13573, 16384, 15); \
+    sf = od_mm256_add_epi32(sf, se); \
+    sfh = od_mm256_unbiased_rshift32(sf, 1); \
+    se = od_mm256_sub_epi32(sfh, se); \
+    s0 = od_mm256_add_epi32(s0, s1); \
+    s0h = od_mm256_unbiased_rshift32(s0, 1); \
+    s1 = od_mm256_sub_epi32(s0h, s1); \
+    s2 = od_mm256_sub_epi32(s3, s2); \
+    s2h = od_mm256_unbiased_rshift32(s2, 1); \
+    s3 = od_mm256_sub_epi32(s3, s2h); \
+    sd = od_mm256_sub_epi32(sd, sc); \
+    sdh = od_mm256_unbiased_rshift32(sd, 1); \
+    sc = od_mm256_add_epi32(sc, sdh); \
+    sa = od_mm256_sub_epi32(s4, sa); \
+    s4 = od_mm256_sub_epi32(s4, od_mm256_unbiased_rshift32(sa, 1)); \
+    s5 = od_mm256_add_epi32(s5, sb); \
+    sb = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(s5, 1), sb); \
+    s8 = od_mm256_add_epi32(s8, s6); \
+    s6 = od_mm256_sub_epi32(s6, od_mm256_unbiased_rshift32(s8, 1)); \
+    s7 = od_mm256_sub_epi32(s9, s7); \
+    s9 = od_mm256_sub_epi32(s9, od_mm256_unbiased_rshift32(s7, 1)); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(sb, 6723, 4096, 235); \
+    s4 = OD_DCT_MLA_EPI32(s4, sb, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    od_mm256_overflow_check(s4, 16069, 8192, 236); \
+    sb = OD_DCT_MLS_EPI32(sb, s4, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32]) ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(sb, 6723, 4096, 237); \
+    s4 = OD_DCT_MLA_EPI32(s4, sb, 6723, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32]) ~= 0.534511135950792 */ \
+    od_mm256_overflow_check(s5, 8757, 8192, 238); \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 8757, 8192, 14); \
+    /* 6811/8192 ~= Sin[5*Pi/16] ~= 0.831469612302545 */ \
+    od_mm256_overflow_check(sa, 6811, 4096, 239); \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 6811, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    od_mm256_overflow_check(s5, 8757, 8192, 240); \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 8757, 8192, 14); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    od_mm256_overflow_check(s9, 2485, 4096, 241); \
+    s6 = OD_DCT_MLA_EPI32(s6, s9, 2485, 4096, 13); \
+    /* 4551/8192 ~= Sin[3*Pi/16] ~= 0.555570233019602 */ \
+    od_mm256_overflow_check(s6, 4551, 4096, 242); \
+    s9 = OD_DCT_MLS_EPI32(s9, s6, 4551, 4096, 13); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    od_mm256_overflow_check(s9, 2485, 4096, 243); \
+    s6 = OD_DCT_MLA_EPI32(s6, s9, 2485, 4096, 13); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    od_mm256_overflow_check(s8, 3227, 16384, 244); \
+    s7 = OD_DCT_MLA_EPI32(s7, s8, 3227, 16384, 15); \
+    /* 6393/32768 ~= Sin[Pi/16] ~= 0.19509032201612825 */ \
+    od_mm256_overflow_check(s7, 6393, 16384, 245); \
+    s8 = OD_DCT_MLS_EPI32(s8, s7, 6393, 16384, 15); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    od_mm256_overflow_check(s8, 3227, 16384, 246); \
+    s7 = OD_DCT_MLA_EPI32(s7, s8, 3227, 16384, 15); \
+    s1 = od_mm256_sub_epi32(s1, s2h); \
+    s2 = od_mm256_add_epi32(s2, s1); \
+    se = od_mm256_add_epi32(se, sdh); \
+    sd = od_mm256_sub_epi32(se, sd); \
+    s3 = od_mm256_add_epi32(s3, sfh); \
+    sf = od_mm256_sub_epi32(sf, s3); \
+    sc = od_mm256_sub_epi32(s0h, sc); \
+    s0 = od_mm256_sub_epi32(s0, sc); \
+    sb = od_mm256_add_epi32(sb, od_mm256_unbiased_rshift32(s8, 1)); \
+    s8 = od_mm256_sub_epi32(sb, s8); \
+    s4 = od_mm256_add_epi32(s4, od_mm256_unbiased_rshift32(s7, 1)); \
+    s7 = od_mm256_sub_epi32(s7, s4); \
+    s6 = od_mm256_add_epi32(s6, od_mm256_unbiased_rshift32(s5, 1)); \
+    s5 = od_mm256_sub_epi32(s6, s5); \
+    s9 = od_mm256_sub_epi32(s9, od_mm256_unbiased_rshift32(sa, 1)); \
+    sa = od_mm256_add_epi32(sa, s9); \
+    s8 = od_mm256_add_epi32(s8, s0); \
+    s0 = od_mm256_sub_epi32(s0, od_mm256_unbiased_rshift32(s8, 1)); \
+    sf = od_mm256_add_epi32(sf, s7); \
+    s7 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(sf, 1), s7); \
+    s1 = od_mm256_sub_epi32(s1, s6); \
+    s6 = od_mm256_add_epi32(s6, od_mm256_unbiased_rshift32(s1, 1)); \
+    s9 = od_mm256_add_epi32(s9, se); \
+    se = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(s9, 1), se); \
+    s2 = od_mm256_add_epi32(s2, sa); \
+    sa = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(s2, 1), sa); \
+    s5 = od_mm256_add_epi32(s5, sd); \
+    sd = od_mm256_sub_epi32(sd, od_mm256_unbiased_rshift32(s5, 1)); \
+    s4 = od_mm256_sub_epi32(sc, s4); \
+    sc = od_mm256_sub_epi32(sc, od_mm256_unbiased_rshift32(s4, 1)); \
+    s3 = od_mm256_sub_epi32(s3, sb); \
+    sb = od_mm256_add_epi32(sb, od_mm256_unbiased_rshift32(s3, 1)); \
+    /* 2799/4096 ~= (1/Sqrt[2] - Cos[31*Pi/64]/2)/Sin[31*Pi/64] ~=
+        0.6833961245841154 */ \
+    od_mm256_overflow_check(sf, 2799, 2048, 247); \
+    s0 = OD_DCT_MLS_EPI32(s0, sf, 2799, 2048, 12); \
+    /* 2893/2048 ~= Sqrt[2]*Sin[31*Pi/64] ~= 1.4125100802019777 */ \
+    od_mm256_overflow_check(s0, 2893, 1024, 248); \
+    sf = OD_DCT_MLA_EPI32(sf, s0, 2893, 1024, 11); \
+    /* 5397/8192 ~= (Cos[Pi/4] - Cos[31*Pi/64])/Sin[31*Pi/64] ~=
+        0.6588326996993819 */ \
+    od_mm256_overflow_check(sf, 5397, 4096, 249); \
+    s0 = OD_DCT_MLS_EPI32(s0, sf, 5397, 4096, 13); \
+    /* 41/64 ~= (1/Sqrt[2] - Cos[29*Pi/64]/2)/Sin[29*Pi/64] ~=
+        0.6406758931036793 */ \
+    od_mm256_overflow_check(s1, 41, 32, 250); \
+    se = OD_DCT_MLA_EPI32(se, s1, 41, 32, 6); \
+    /* 2865/2048 ~= Sqrt[2]*Sin[29*Pi/64] ~= 1.3989068359730783 */ \
+    od_mm256_overflow_check(se, 2865, 1024, 251); \
+    s1 = OD_DCT_MLS_EPI32(s1, se, 2865, 1024, 11); \
+    /* 4641/8192 ~= (1/Sqrt[2] - Cos[29*Pi/64])/Sin[29*Pi/64] ~=
+        0.5665078993345056 */ \
+    od_mm256_overflow_check(s1, 4641, 4096, 252); \
+    se = OD_DCT_MLA_EPI32(se, s1, 4641, 4096, 13); \
+    /* 2473/4096 ~= (1/Sqrt[2] - Cos[27*Pi/64]/2)/Sin[27*Pi/64] ~=
+        0.603709096285651 */ \
+    od_mm256_overflow_check(s2, 2473, 2048, 253); \
+    sd = OD_DCT_MLA_EPI32(sd, s2, 2473, 2048, 12); \
+    /* 5619/4096 ~= Sqrt[2]*Sin[27*Pi/64] ~= 1.371831354193494 */ \
+    od_mm256_overflow_check(sd, 5619, 2048, 254); \
+    s2 = OD_DCT_MLS_EPI32(s2, sd, 5619, 2048, 12); \
+    /* 7839/16384 ~= (1/Sqrt[2] - Cos[27*Pi/64])/Sin[27*Pi/64] ~=
+        0.47846561618999817 */ \
+    od_mm256_overflow_check(s2, 7839, 8192, 255); \
+    sd = OD_DCT_MLA_EPI32(sd, s2, 7839, 8192, 14); \
+    /* 5747/8192 ~= (1/Sqrt[2] - Cos[7*Pi/64]/2)/Sin[7*Pi/64] ~=
+        0.7015193429405162 */ \
+    od_mm256_overflow_check(s3, 5747, 4096, 256); \
+    sc = OD_DCT_MLS_EPI32(sc, s3, 5747, 4096, 13); \
+    /* 3903/8192 ~= Sqrt[2]*Sin[7*Pi/64] ~= 0.47643419969316125 */ \
+    od_mm256_overflow_check(sc, 3903, 4096, 257); \
+    s3 = OD_DCT_MLA_EPI32(s3, sc, 3903, 4096, 13); \
+    /* 5701/8192 ~= (1/Sqrt[2] - Cos[7*Pi/64])/Sin[7*Pi/64] ~=
+        0.6958870433047222 */ \
+    od_mm256_overflow_check(s3, 5701, 4096, 258); \
+    sc = OD_DCT_MLA_EPI32(sc, s3, 5701, 4096, 13); \
+    /* 4471/8192 ~= (1/Sqrt[2] - Cos[23*Pi/64]/2)/Sin[23*Pi/64] ~=
+        0.5457246432276498 */ \
+    od_mm256_overflow_check(s4, 4471, 4096, 259); \
+    sb = OD_DCT_MLA_EPI32(sb, s4, 4471, 4096, 13); \
+    /* 1309/1024 ~= Sqrt[2]*Sin[23*Pi/64] ~= 1.278433918575241 */ \
+    od_mm256_overflow_check(sb, 1309, 512, 260); \
+    s4 = OD_DCT_MLS_EPI32(s4, sb, 1309, 512, 10); \
+    /* 5067/16384 ~= (1/Sqrt[2] - Cos[23*Pi/64])/Sin[23*Pi/64] ~=
+        0.30924225528198984 */ \
+    od_mm256_overflow_check(s4, 5067, 8192, 261); \
+    sb = OD_DCT_MLA_EPI32(sb, s4, 5067, 8192, 14); \
+    /* 2217/4096 ~= (1/Sqrt[2] - Cos[11*Pi/64]/2)/Sin[11*Pi/64] ~=
+        0.5412195895259334 */ \
+    od_mm256_overflow_check(s5, 2217, 2048, 262); \
+    sa = OD_DCT_MLS_EPI32(sa, s5, 2217, 2048, 12); \
+    /* 1489/2048 ~= Sqrt[2]*Sin[11*Pi/64] ~= 0.72705107329128 */ \
+    od_mm256_overflow_check(sa, 1489, 1024, 263); \
+    s5 = OD_DCT_MLA_EPI32(s5, sa, 1489, 1024, 11); \
+    /* 75/256 ~= (1/Sqrt[2] - Cos[11*Pi/64])/Sin[11*Pi/64] ~=
+        0.2929800132658202 */ \
+    od_mm256_overflow_check(s5, 75, 128, 264); \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 75, 128, 8); \
+    /* 2087/4096 ~= (1/Sqrt[2] - Cos[19*Pi/64]/2)/Sin[19*Pi/64] ~=
+        0.5095285002941893 */ \
+    od_mm256_overflow_check(s9, 2087, 2048, 265); \
+    s6 = OD_DCT_MLS_EPI32(s6, s9, 2087, 2048, 12); \
+    /* 4653/4096 ~= Sqrt[2]*Sin[19*Pi/64] ~= 1.1359069844201428 */ \
+    od_mm256_overflow_check(s6, 4653, 2048, 266); \
+    s9 = OD_DCT_MLA_EPI32(s9, s6, 4653, 2048, 12); \
+    /* 4545/32768 ~= (1/Sqrt[2] - Cos[19*Pi/64])/Sin[19*Pi/64] ~=
+        0.13870322715817154 */ \
+    od_mm256_overflow_check(s9, 4545, 16384, 267); \
+    s6 = OD_DCT_MLS_EPI32(s6, s9, 4545, 16384, 15); \
+    /* 2053/4096 ~= (1/Sqrt[2] - Cos[15*Pi/64]/2)/Sin[15*Pi/64] ~=
+        0.5012683042634027 */ \
+    od_mm256_overflow_check(s8, 2053, 2048, 268); \
+    s7 = OD_DCT_MLA_EPI32(s7, s8, 2053, 2048, 12); \
+    /* 1945/2048 ~= Sqrt[2]*Sin[15*Pi/64] ~= 0.9497277818777543 */ \
+    od_mm256_overflow_check(s7, 1945, 1024, 269); \
+    s8 = OD_DCT_MLS_EPI32(s8, s7, 1945, 1024, 11); \
+    /* 1651/32768 ~= (1/Sqrt[2] - Cos[15*Pi/64])/Sin[15*Pi/64] ~=
+        0.05039668360333519 */ \
+    od_mm256_overflow_check(s8, 1651, 16384, 270); \
+    s7 = OD_DCT_MLS_EPI32(s7, s8, 1651, 16384, 15); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_16(s0, s8, s4, sc, s2, sa, s6, se, \
+ s1, s9, s5, sd, s3, sb, s7, sf) \
+  /* Embedded 16-point orthonormal Type-IV iDST. */ \
+  do { \
+    od_m256i s0h; \
+    od_m256i s4h; \
+    od_m256i sbh; \
+    od_m256i sfh; \
+    /* 1651/32768 ~= (1/Sqrt[2] - Cos[15*Pi/64])/Sin[15*Pi/64] ~=
+        0.05039668360333519 */ \
+    se = OD_DCT_MLA_EPI32(se, s1, 1651, 16384, 15); \
+    /* 1945/2048 ~= Sqrt[2]*Sin[15*Pi/64] ~= 0.9497277818777543 */ \
+    s1 = OD_DCT_MLA_EPI32(s1, se, 1945, 1024, 11); \
+    /* 2053/4096 ~= (1/Sqrt[2] - Cos[15*Pi/64]/2)/Sin[15*Pi/64] ~=
+        0.5012683042634027 */ \
+    se = OD_DCT_MLS_EPI32(se, s1, 2053, 2048, 12); \
+    /* 4545/32768 ~= (1/Sqrt[2] - Cos[19*Pi/64])/Sin[19*Pi/64] ~=
+        0.13870322715817154 */ \
+    s6 = OD_DCT_MLA_EPI32(s6, s9, 4545, 16384, 15); \
+    /* 4653/32768 ~= Sqrt[2]*Sin[19*Pi/64] ~= 1.1359069844201428 */ \
+    s9 = OD_DCT_MLS_EPI32(s9, s6, 4653, 2048, 12); \
+    /* 2087/4096 ~= (1/Sqrt[2] - Cos[19*Pi/64]/2)/Sin[19*Pi/64] ~=
+        0.5095285002941893 */ \
+    s6 = OD_DCT_MLA_EPI32(s6, s9, 2087, 2048, 12); \
+    /* 75/256 ~= (1/Sqrt[2] - Cos[11*Pi/64])/Sin[11*Pi/64] ~=
+        0.2929800132658202 */ \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 75, 128, 8); \
+    /* 1489/2048 ~= Sqrt[2]*Sin[11*Pi/64] ~= 0.72705107329128 */ \
+    sa = OD_DCT_MLS_EPI32(sa, s5, 1489, 1024, 11); \
+    /* 2217/4096 ~= (1/Sqrt[2] - Cos[11*Pi/64]/2)/Sin[11*Pi/64] ~=
+        0.5412195895259334 */ \
+    s5 = OD_DCT_MLA_EPI32(s5, sa, 2217, 2048, 12); \
+    /* 5067/16384 ~= (1/Sqrt[2] - Cos[23*Pi/64])/Sin[23*Pi/64] ~=
+        0.30924225528198984 */ \
+    sd = OD_DCT_MLS_EPI32(sd, s2, 5067, 8192, 14); \
+    /* 1309/1024 ~= Sqrt[2]*Sin[23*Pi/64] ~= 1.278433918575241 */ \
+    s2 = OD_DCT_MLA_EPI32(s2, sd, 1309, 512, 10); \
+    /* 4471/8192 ~= (1/Sqrt[2] - Cos[23*Pi/64]/2)/Sin[23*Pi/64] ~=
+        0.5457246432276498 */ \
+    sd = OD_DCT_MLS_EPI32(sd, s2, 4471, 4096, 13); \
+    /* 5701/8192 ~= (1/Sqrt[2] - Cos[7*Pi/64])/Sin[7*Pi/64] ~=
+        0.6958870433047222 */ \
+    s3 = OD_DCT_MLS_EPI32(s3, sc, 5701, 4096, 13); \
+    /* 3903/8192 ~= Sqrt[2]*Sin[7*Pi/64] ~= 0.47643419969316125 */ \
+    sc = OD_DCT_MLS_EPI32(sc, s3, 3903, 4096, 13); \
+    /* 5747/8192 ~= (1/Sqrt[2] - Cos[7*Pi/64]/2)/Sin[7*Pi/64] ~=
+        0.7015193429405162 */ \
+    s3 = OD_DCT_MLA_EPI32(s3, sc, 5747, 4096, 13); \
+    /* 7839/16384 ~= (1/Sqrt[2] - Cos[27*Pi/64])/Sin[27*Pi/64] ~=
+        0.47846561618999817 */ \
+    sb = OD_DCT_MLS_EPI32(sb, s4, 7839, 8192, 14); \
+    /* 5619/4096 ~= Sqrt[2]*Sin[27*Pi/64] ~= 1.371831354193494 */ \
+    s4 = OD_DCT_MLA_EPI32(s4, sb, 5619, 2048, 12); \
+    /* 2473/4096 ~= (1/Sqrt[2] - Cos[27*Pi/64]/2)/Sin[27*Pi/64] ~=
+        0.603709096285651 */ \
+    sb = OD_DCT_MLS_EPI32(sb, s4, 2473, 2048, 12); \
+    /* 4641/8192 ~= (1/Sqrt[2] - Cos[29*Pi/64])/Sin[29*Pi/64] ~=
+        0.5665078993345056 */ \
+    s7 = OD_DCT_MLS_EPI32(s7, s8, 4641, 4096, 13); \
+    /* 2865/2048 ~= Sqrt[2]*Sin[29*Pi/64] ~= 1.3989068359730783 */ \
+    s8 = OD_DCT_MLA_EPI32(s8, s7, 2865, 1024, 11); \
+    /* 41/64 ~= (1/Sqrt[2] - Cos[29*Pi/64]/2)/Sin[29*Pi/64] ~=
+        0.6406758931036793 */ \
+    s7 = OD_DCT_MLS_EPI32(s7, s8, 41, 32, 6); \
+    /* 5397/8192 ~= (Cos[Pi/4] - Cos[31*Pi/64])/Sin[31*Pi/64] ~=
+        0.6588326996993819 */ \
+    s0 = OD_DCT_MLA_EPI32(s0, sf, 5397, 4096, 13); \
+    /* 2893/2048 ~= Sqrt[2]*Sin[31*Pi/64] ~= 1.4125100802019777 */ \
+    sf = OD_DCT_MLS_EPI32(sf, s0, 2893, 1024, 11); \
+    /* 2799/4096 ~= (1/Sqrt[2] - Cos[31*Pi/64]/2)/Sin[31*Pi/64] ~=
+        0.6833961245841154 */ \
+    s0 = OD_DCT_MLA_EPI32(s0, sf, 2799, 2048, 12); \
+    sd = od_mm256_sub_epi32(sd, od_mm256_unbiased_rshift32(sc, 1)); \
+    sc = od_mm256_add_epi32(sc, sd); \
+    s3 = od_mm256_add_epi32(s3, od_mm256_unbiased_rshift32(s2, 1)); \
+    s2 = od_mm256_sub_epi32(s3, s2); \
+    sb = od_mm256_add_epi32(sb, od_mm256_unbiased_rshift32(sa, 1)); \
+    sa = od_mm256_sub_epi32(sa, sb); \
+    s5 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(s4, 1), s5); \
+    s4 = od_mm256_sub_epi32(s4, s5); \
+    s7 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(s9, 1), s7); \
+    s9 = od_mm256_sub_epi32(s9, s7); \
+    s6 = od_mm256_sub_epi32(s6, od_mm256_unbiased_rshift32(s8, 1)); \
+    s8 = od_mm256_add_epi32(s8, s6); \
+    se = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(sf, 1), se); \
+    sf = od_mm256_sub_epi32(sf, se); \
+    s0 = od_mm256_add_epi32(s0, od_mm256_unbiased_rshift32(s1, 1)); \
+    s1 = od_mm256_sub_epi32(s1, s0); \
+    s5 = od_mm256_sub_epi32(s5, s9); \
+    s9 = od_mm256_add_epi32(s9, od_mm256_unbiased_rshift32(s5, 1)); \
+    sa = od_mm256_sub_epi32(s6, sa); \
+    s6 = od_mm256_sub_epi32(s6, od_mm256_unbiased_rshift32(sa, 1)); \
+    se = od_mm256_add_epi32(se, s2); \
+    s2 = od_mm256_sub_epi32(s2, od_mm256_unbiased_rshift32(se, 1)); \
+    s1 = od_mm256_sub_epi32(sd, s1); \
+    sd = od_mm256_sub_epi32(sd, od_mm256_unbiased_rshift32(s1, 1)); \
+    s0 = od_mm256_add_epi32(s0, s3); \
+    s0h = od_mm256_unbiased_rshift32(s0, 1); \
+    s3 = od_mm256_sub_epi32(s0h, s3); \
+    sf = od_mm256_add_epi32(sf, sc); \
+    sfh = od_mm256_unbiased_rshift32(sf, 1); \
+    sc = od_mm256_sub_epi32(sc, sfh); \
+    sb = od_mm256_sub_epi32(s7, sb); \
+    sbh = od_mm256_unbiased_rshift32(sb, 1); \
+    s7 = od_mm256_sub_epi32(s7, sbh); \
+    s4 = od_mm256_sub_epi32(s4, s8); \
+    s4h = od_mm256_unbiased_rshift32(s4, 1); \
+    s8 = od_mm256_add_epi32(s8, s4h); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    se = OD_DCT_MLS_EPI32(se, s1, 3227, 16384, 15); \
+    /* 6393/32768 ~= Sin[Pi/16] ~= 0.19509032201612825 */ \
+    s1 = OD_DCT_MLA_EPI32(s1, se, 6393, 16384, 15); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    se = OD_DCT_MLS_EPI32(se, s1, 3227, 16384, 15); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    s6 = OD_DCT_MLS_EPI32(s6, s9, 2485, 4096, 13); \
+    /* 4551/8192 ~= Sin[3*Pi/16] ~= 0.555570233019602 */ \
+    s9 = OD_DCT_MLA_EPI32(s9, s6, 4551, 4096, 13); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    s6 = OD_DCT_MLS_EPI32(s6, s9, 2485, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 8757, 8192, 14); \
+    /* 6811/8192 ~= Sin[5*Pi/16] ~= 0.831469612302545 */ \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 6811, 4096, 13); \
+    /* 8757/16384 ~= Tan[5*Pi/32]) ~= 0.534511135950792 */ \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 8757, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32]) ~= 0.820678790828660 */ \
+    s2 = OD_DCT_MLS_EPI32(s2, sd, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    sd = OD_DCT_MLA_EPI32(sd, s2, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    s2 = OD_DCT_MLS_EPI32(s2, sd, 6723, 4096, 13); \
+    s9 = od_mm256_add_epi32(s9, od_mm256_unbiased_rshift32(se, 1)); \
+    se = od_mm256_sub_epi32(s9, se); \
+    s6 = od_mm256_add_epi32(s6, od_mm256_unbiased_rshift32(s1, 1)); \
+    s1 = od_mm256_sub_epi32(s1, s6); \
+    sd = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(sa, 1), sd); \
+    sa = od_mm256_sub_epi32(sa, sd); \
+    s2 = od_mm256_add_epi32(s2, od_mm256_unbiased_rshift32(s5, 1)); \
+    s5 = od_mm256_sub_epi32(s2, s5); \
+    s3 = od_mm256_sub_epi32(s3, sbh); \
+    sb = od_mm256_add_epi32(sb, s3); \
+    sc = od_mm256_add_epi32(sc, s4h); \
+    s4 = od_mm256_sub_epi32(sc, s4); \
+    s8 = od_mm256_sub_epi32(s0h, s8); \
+    s0 = od_mm256_sub_epi32(s0, s8); \
+    s7 = od_mm256_sub_epi32(sfh, s7); \
+    sf = od_mm256_sub_epi32(sf, s7); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    s6 = OD_DCT_MLS_EPI32(s6, s9, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[pi/4] ~= 0.707106781186547 */ \
+    s9 = OD_DCT_MLA_EPI32(s9, s6, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    s6 = OD_DCT_MLS_EPI32(s6, s9, 13573, 16384, 15); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[pi/4] ~= 0.707106781186547 */ \
+    sa = OD_DCT_MLA_EPI32(sa, s5, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    s5 = OD_DCT_MLS_EPI32(s5, sa, 13573, 16384, 15); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    s3 = OD_DCT_MLS_EPI32(s3, sc, 3259, 8192, 14); \
+    /* 3135/8192 ~= Sin[Pi/8] ~= 0.382683432365090 */ \
+    sc = OD_DCT_MLA_EPI32(sc, s3, 3135, 4096, 13); \
+    /* 3259/16384 ~= Tan[Pi/16] ~= 0.198912367379658 */ \
+    s3 = OD_DCT_MLS_EPI32(s3, sc, 3259, 8192, 14); \
+    /* 21895/32768 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    sb = OD_DCT_MLS_EPI32(sb, s4, 21895, 16384, 15); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    s4 = OD_DCT_MLA_EPI32(s4, sb, 15137, 8192, 14); \
+    /* 21895/32768 ~= Tan[3*Pi/16] ~= 0.668178637919299 */ \
+    sb = OD_DCT_MLS_EPI32(sb, s4, 21895, 16384, 15); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    s8 = OD_DCT_MLS_EPI32(s8, s7, 13573, 16384, 15); \
+    /* 11585/16384 ~= Sin[pi/4] ~= 0.707106781186547 */ \
+    s7 = OD_DCT_MLA_EPI32(s7, s8, 11585, 8192, 14); \
+    /* 13573/32768 ~= Tan[pi/8] ~= 0.414213562373095 */ \
+    s8 = OD_DCT_MLS_EPI32(s8, s7, 13573, 16384, 15); \
+  } \
+  while (0)
+
+/* TODO: rewrite this to match OD_MM256_FDST_16. */
+#define OD_MM256_FDST_16_ASYM(t0, t0h, t8, t4, t4h, tc, t2, ta, t6, te, \
+ t1, t9, t5, td, t3, tb, t7, t7h, tf) \
+  /* Embedded 16-point asymmetric Type-IV fDST. */ \
+  do { \
+    od_m256i t2h; \
+    od_m256i t3h; \
+    od_m256i t6h; \
+    od_m256i t8h; \
+    od_m256i t9h; \
+    od_m256i tch; \
+    od_m256i tdh; \
+    /* TODO: Can we move these into another operation */ \
+    t8 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t8); \
+    t9 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t9); \
+    ta = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ta); \
+    tb = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tb); \
+    td = od_mm256_sub_epi32(od_mm256_set1_epi32(0), td); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    od_mm256_overflow_check(te, 13573, 8192, 136); \
+    t1 = OD_DCT_MLS_EPI32(t1, te, 13573, 8192, 14); \
+    /* 11585/32768 ~= Sin[Pi/4]/2 ~= 0.353553390593274 */ \
+    od_mm256_overflow_check(t1, 11585, 16384, 137); \
+    te = OD_DCT_MLA_EPI32(te, t1, 11585, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    od_mm256_overflow_check(te, 13573, 8192, 138); \
+    t1 = OD_DCT_MLS_EPI32(t1, te, 13573, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(td, 4161, 8192, 139); \
+    t2 = OD_DCT_MLA_EPI32(t2, td, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(t2, 15137, 8192, 140); \
+    td = OD_DCT_MLS_EPI32(td, t2, 15137, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(td, 14341, 8192, 141); \
+    t2 = OD_DCT_MLA_EPI32(t2, td, 14341, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(t3, 14341, 8192, 142); \
+    tc = OD_DCT_MLS_EPI32(tc, t3, 14341, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(tc, 15137, 8192, 143); \
+    t3 = OD_DCT_MLA_EPI32(t3, tc, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(t3, 4161, 8192, 144); \
+    tc = OD_DCT_MLS_EPI32(tc, t3, 4161, 8192, 14); \
+    te = od_mm256_sub_epi32(t0h, te); \
+    t0 = od_mm256_sub_epi32(t0, te); \
+    tf = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(t1, 1), tf); \
+    t1 = od_mm256_sub_epi32(t1, tf); \
+    /* TODO: Can we move this into another operation */ \
+    tc = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tc); \
+    t2 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(tc, 1), t2); \
+    tc = od_mm256_sub_epi32(tc, t2); \
+    t3 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(td, 1), t3); \
+    td = od_mm256_sub_epi32(t3, td); \
+    /* 7489/8192 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    od_mm256_overflow_check(t6, 7489, 4096, 145); \
+    t9 = OD_DCT_MLS_EPI32(t9, t6, 7489, 4096, 13); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    od_mm256_overflow_check(t9, 11585, 8192, 146); \
+    t6 = OD_DCT_MLA_EPI32(t6, t9, 11585, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    od_mm256_overflow_check(t6, 19195, 16384, 147); \
+    t9 = OD_DCT_MLA_EPI32(t9, t6, 19195, 16384, 15); \
+    t8 = od_mm256_add_epi32(t8, od_mm256_unbiased_rshift32(t9, 1)); \
+    t9 = od_mm256_sub_epi32(t9, t8); \
+    t6 = od_mm256_sub_epi32(t7h, t6); \
+    t7 = od_mm256_sub_epi32(t7, t6); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(t7, 6723, 4096, 148); \
+    t8 = OD_DCT_MLA_EPI32(t8, t7, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    od_mm256_overflow_check(t8, 16069, 8192, 149); \
+    t7 = OD_DCT_MLS_EPI32(t7, t8, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32]) ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(t7, 6723, 4096, 150); \
+    t8 = OD_DCT_MLA_EPI32(t8, t7, 6723, 4096, 13); \
+    /* 17515/32768 ~= Tan[5*Pi/32]) ~= 0.534511135950792 */ \
+    od_mm256_overflow_check(t6, 17515, 16384, 151); \
+    t9 = OD_DCT_MLA_EPI32(t9, t6, 17515, 16384, 15); \
+    /* 13623/16384 ~= Sin[5*Pi/16] ~= 0.831469612302545 */ \
+    od_mm256_overflow_check(t9, 13623, 8192, 152); \
+    t6 = OD_DCT_MLS_EPI32(t6, t9, 13623, 8192, 14); \
+    /* 17515/32768 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    od_mm256_overflow_check(t6, 17515, 16384, 153); \
+    t9 = OD_DCT_MLA_EPI32(t9, t6, 17515, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    od_mm256_overflow_check(ta, 13573, 8192, 154); \
+    t5 = OD_DCT_MLA_EPI32(t5, ta, 13573, 8192, 14); \
+    /* 11585/32768 ~= Sin[Pi/4]/2 ~= 0.353553390593274 */ \
+    od_mm256_overflow_check(t5, 11585, 16384, 155); \
+    ta = OD_DCT_MLS_EPI32(ta, t5, 11585, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    od_mm256_overflow_check(ta, 13573, 8192, 156); \
+    t5 = OD_DCT_MLA_EPI32(t5, ta, 13573, 8192, 14); \
+    tb = od_mm256_add_epi32(tb, od_mm256_unbiased_rshift32(t5, 1)); \
+    t5 = od_mm256_sub_epi32(tb, t5); \
+    ta = od_mm256_add_epi32(ta, t4h); \
+    t4 = od_mm256_sub_epi32(t4, ta); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    od_mm256_overflow_check(t5, 2485, 4096, 157); \
+    ta = OD_DCT_MLA_EPI32(ta, t5, 2485, 4096, 13); \
+    /* 18205/32768 ~= Sin[3*Pi/16] ~= 0.555570233019602 */ \
+    od_mm256_overflow_check(ta, 18205, 16384, 158); \
+    t5 = OD_DCT_MLS_EPI32(t5, ta, 18205, 16384, 15); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    od_mm256_overflow_check(t5, 2485, 4096, 159); \
+    ta = OD_DCT_MLA_EPI32(ta, t5, 2485, 4096, 13); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(t4, 6723, 4096, 160); \
+    tb = OD_DCT_MLS_EPI32(tb, t4, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    od_mm256_overflow_check(tb, 16069, 8192, 161); \
+    t4 = OD_DCT_MLA_EPI32(t4, tb, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    od_mm256_overflow_check(t4, 6723, 4096, 162); \
+    tb = OD_DCT_MLS_EPI32(tb, t4, 6723, 4096, 13); \
+    /* TODO: Can we move this into another operation */ \
+    t5 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t5); \
+    tc = od_mm256_sub_epi32(tc, tf); \
+    tch = od_mm256_unbiased_rshift32(tc, 1); \
+    tf = od_mm256_add_epi32(tf, tch); \
+    t3 = od_mm256_add_epi32(t3, t0); \
+    t3h = od_mm256_unbiased_rshift32(t3, 1); \
+    t0 = od_mm256_sub_epi32(t0, t3h); \
+    td = od_mm256_sub_epi32(td, t1); \
+    tdh = od_mm256_unbiased_rshift32(td, 1); \
+    t1 = od_mm256_add_epi32(t1, tdh); \
+    t2 = od_mm256_add_epi32(t2, te); \
+    t2h = od_mm256_unbiased_rshift32(t2, 1); \
+    te = od_mm256_sub_epi32(te, t2h); \
+    t8 = od_mm256_add_epi32(t8, t4); \
+    t8h = od_mm256_unbiased_rshift32(t8, 1); \
+    t4 = od_mm256_sub_epi32(t8h, t4); \
+    t7 = od_mm256_sub_epi32(tb, t7); \
+    t7h = od_mm256_unbiased_rshift32(t7, 1); \
+    tb = od_mm256_sub_epi32(t7h, tb); \
+    t6 = od_mm256_sub_epi32(t6, ta); \
+    t6h = od_mm256_unbiased_rshift32(t6, 1); \
+    ta = od_mm256_add_epi32(ta, t6h); \
+    t9 = od_mm256_sub_epi32(t5, t9); \
+    t9h = od_mm256_unbiased_rshift32(t9, 1); \
+    t5 = od_mm256_sub_epi32(t5, t9h); \
+    t0 = od_mm256_sub_epi32(t0, t7h); \
+    t7 = od_mm256_add_epi32(t7, t0); \
+    tf = od_mm256_add_epi32(tf, t8h); \
+    t8 = od_mm256_sub_epi32(t8, tf); \
+    te = od_mm256_sub_epi32(te, t6h); \
+    t6 = od_mm256_add_epi32(t6, te); \
+    t1 = od_mm256_add_epi32(t1, t9h); \
+    t9 = od_mm256_sub_epi32(t9, t1); \
+    tb = od_mm256_sub_epi32(tb, tch); \
+    tc = od_mm256_add_epi32(tc, tb); \
+    t4 = od_mm256_add_epi32(t4, t3h); \
+    t3 = od_mm256_sub_epi32(t3, t4); \
+    ta = od_mm256_sub_epi32(ta, tdh); \
+    td = od_mm256_add_epi32(td, ta); \
+    t5 = od_mm256_sub_epi32(t2h, t5); \
+    t2 = od_mm256_sub_epi32(t2, t5); \
+    /* TODO: Can we move these into another operation */ \
+    t8 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t8); \
+    t9 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t9); \
+    ta = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ta); \
+    tb = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tb); \
+    tc = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tc); \
+    td = od_mm256_sub_epi32(od_mm256_set1_epi32(0), td); \
+    tf = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tf); \
+    /* 7799/8192 ~= Tan[31*Pi/128] ~= 0.952079146700925 */ \
+    od_mm256_overflow_check(tf, 7799, 4096, 163); \
+    t0 = OD_DCT_MLS_EPI32(t0, tf, 7799, 4096, 13); \
+    /* 4091/4096 ~= Sin[31*Pi/64] ~= 0.998795456205172 */ \
+    od_mm256_overflow_check(t0, 4091, 2048, 164); \
+    tf = OD_DCT_MLA_EPI32(tf, t0, 4091, 2048, 12); \
+    /* 7799/8192 ~= Tan[31*Pi/128] ~= 0.952079146700925 */ \
+    od_mm256_overflow_check(tf, 7799, 4096, 165); \
+    t0 = OD_DCT_MLS_EPI32(t0, tf, 7799, 4096, 13); \
+    /* 2417/32768 ~= Tan[3*Pi/128] ~= 0.0737644315224493 */ \
+    od_mm256_overflow_check(te, 2417, 16384, 166); \
+    t1 = OD_DCT_MLA_EPI32(t1, te, 2417, 16384, 15); \
+    /* 601/4096 ~= Sin[3*Pi/64] ~= 0.146730474455362 */ \
+    od_mm256_overflow_check(t1, 601, 2048, 167); \
+    te = OD_DCT_MLS_EPI32(te, t1, 601, 2048, 12); \
+    /* 2417/32768 ~= Tan[3*Pi/128] ~= 0.0737644315224493 */ \
+    od_mm256_overflow_check(te, 2417, 16384, 168); \
+    t1 = OD_DCT_MLA_EPI32(t1, te, 2417, 16384, 15); \
+    /* 14525/32768 ~= Tan[17*Pi/128] ~= 0.443269513890864 */ \
+    od_mm256_overflow_check(t8, 14525, 16384, 169); \
+    t7 = OD_DCT_MLS_EPI32(t7, t8, 14525, 16384, 15); \
+    /* 3035/4096 ~= Sin[17*Pi/64] ~= 0.740951125354959 */ \
+    od_mm256_overflow_check(t7, 3035, 2048, 170); \
+    t8 = OD_DCT_MLA_EPI32(t8, t7, 3035, 2048, 12); \
+    /* 7263/16384 ~= Tan[17*Pi/128] ~= 0.443269513890864 */ \
+    od_mm256_overflow_check(t8, 7263, 8192, 171); \
+    t7 = OD_DCT_MLS_EPI32(t7, t8, 7263, 8192, 14); \
+    /* 6393/8192 ~= Tan[27*Pi/128] ~= 0.780407659653944 */ \
+    od_mm256_overflow_check(td, 6393, 4096, 172); \
+    t2 = OD_DCT_MLS_EPI32(t2, td, 6393, 4096, 13); \
+    /* 3973/4096 ~= Sin[27*Pi/64] ~= 0.970031253194544 */ \
+    od_mm256_overflow_check(t2, 3973, 2048, 173); \
+    td = OD_DCT_MLA_EPI32(td, t2, 3973, 2048, 12); \
+    /* 6393/8192 ~= Tan[27*Pi/128] ~= 0.780407659653944 */ \
+    od_mm256_overflow_check(td, 6393, 4096, 174); \
+    t2 = OD_DCT_MLS_EPI32(t2, td, 6393, 4096, 13); \
+    /* 9281/16384 ~= Tan[21*Pi/128] ~= 0.566493002730344 */ \
+    od_mm256_overflow_check(ta, 9281, 8192, 175); \
+    t5 = OD_DCT_MLS_EPI32(t5, ta, 9281, 8192, 14); \
+    /* 7027/8192 ~= Sin[21*Pi/64] ~= 0.857728610000272 */ \
+    od_mm256_overflow_check(t5, 7027, 4096, 176); \
+    ta = OD_DCT_MLA_EPI32(ta, t5, 7027, 4096, 13); \
+    /* 9281/16384 ~= Tan[21*Pi/128] ~= 0.566493002730344 */ \
+    od_mm256_overflow_check(ta, 9281, 8192, 177); \
+    t5 = OD_DCT_MLS_EPI32(t5, ta, 9281, 8192, 14); \
+    /* 11539/16384 ~= Tan[25*Pi/128] ~= 0.704279460865044 */ \
+    od_mm256_overflow_check(tc, 11539, 8192, 178); \
+    t3 = OD_DCT_MLS_EPI32(t3, tc, 11539, 8192, 14); \
+    /* 7713/8192 ~= Sin[25*Pi/64] ~= 0.941544065183021 */ \
+    od_mm256_overflow_check(t3, 7713, 4096, 179); \
+    tc = OD_DCT_MLA_EPI32(tc, t3, 7713, 4096, 13); \
+    /* 11539/16384 ~= Tan[25*Pi/128] ~= 0.704279460865044 */ \
+    od_mm256_overflow_check(tc, 11539, 8192, 180); \
+    t3 = OD_DCT_MLS_EPI32(t3, tc, 11539, 8192, 14); \
+    /* 10375/16384 ~= Tan[23*Pi/128] ~= 0.633243016177569 */ \
+    od_mm256_overflow_check(tb, 10375, 8192, 181); \
+    t4 = OD_DCT_MLS_EPI32(t4, tb, 10375, 8192, 14); \
+    /* 7405/8192 ~= Sin[23*Pi/64] ~= 0.903989293123443 */ \
+    od_mm256_overflow_check(t4, 7405, 4096, 182); \
+    tb = OD_DCT_MLA_EPI32(tb, t4, 7405, 4096, 13); \
+    /* 10375/16384 ~= Tan[23*Pi/128] ~= 0.633243016177569 */ \
+    od_mm256_overflow_check(tb, 10375, 8192, 183); \
+    t4 = OD_DCT_MLS_EPI32(t4, tb, 10375, 8192, 14); \
+    /* 8247/16384 ~= Tan[19*Pi/128] ~= 0.503357699799294 */ \
+    od_mm256_overflow_check(t9, 8247, 8192, 184); \
+    t6 = OD_DCT_MLS_EPI32(t6, t9, 8247, 8192, 14); \
+    /* 1645/2048 ~= Sin[19*Pi/64] ~= 0.803207531480645 */ \
+    od_mm256_overflow_check(t6, 1645, 1024, 185); \
+    t9 = OD_DCT_MLA_EPI32(t9, t6, 1645, 1024, 11); \
+    /* 8247/16384 ~= Tan[19*Pi/128] ~= 0.503357699799294 */ \
+    od_mm256_overflow_check(t9, 8247, 8192, 186); \
+    t6 = OD_DCT_MLS_EPI32(t6, t9, 8247, 8192, 14); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_16_ASYM(t0, t0h, t8, t4, tc, t2, t2h, ta, t6, te, teh, \
+ t1, t9, t5, td, t3, tb, t7, tf) \
+  /* Embedded 16-point asymmetric Type-IV iDST. */ \
+  do { \
+    od_m256i t1h_; \
+    od_m256i t3h_; \
+    od_m256i t4h; \
+    od_m256i t6h; \
+    od_m256i t9h_; \
+    od_m256i tbh_; \
+    od_m256i tch; \
+    /* 8247/16384 ~= Tan[19*Pi/128] ~= 0.503357699799294 */ \
+    t6 = OD_DCT_MLA_EPI32(t6, t9, 8247, 8192, 14); \
+    /* 1645/2048 ~= Sin[19*Pi/64] ~= 0.803207531480645 */ \
+    t9 = OD_DCT_MLS_EPI32(t9, t6, 1645, 1024, 11); \
+    /* 8247/16384 ~= Tan[19*Pi/128] ~= 0.503357699799294 */ \
+    t6 = OD_DCT_MLA_EPI32(t6, t9, 8247, 8192, 14); \
+    /* 10375/16384 ~= Tan[23*Pi/128] ~= 0.633243016177569 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, td, 10375, 8192, 14); \
+    /* 7405/8192 ~= Sin[23*Pi/64] ~= 0.903989293123443 */ \
+    td = OD_DCT_MLS_EPI32(td, t2, 7405, 4096, 13); \
+    /* 10375/16384 ~= Tan[23*Pi/128] ~= 0.633243016177569 */ \
+    t2 = OD_DCT_MLA_EPI32(t2, td, 10375, 8192, 14); \
+    /* 11539/16384 ~= Tan[25*Pi/128] ~= 0.704279460865044 */ \
+    tc = OD_DCT_MLA_EPI32(tc, t3, 11539, 8192, 14); \
+    /* 7713/8192 ~= Sin[25*Pi/64] ~= 0.941544065183021 */ \
+    t3 = OD_DCT_MLS_EPI32(t3, tc, 7713, 4096, 13); \
+    /* 11539/16384 ~= Tan[25*Pi/128] ~= 0.704279460865044 */ \
+    tc = OD_DCT_MLA_EPI32(tc, t3, 11539, 8192, 14); \
+    /* 9281/16384 ~= Tan[21*Pi/128] ~= 0.566493002730344 */ \
+    ta = OD_DCT_MLA_EPI32(ta, t5, 9281, 8192, 14); \
+    /* 7027/8192 ~= Sin[21*Pi/64] ~= 0.857728610000272 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, ta, 7027, 4096, 13); \
+    /* 9281/16384 ~= Tan[21*Pi/128] ~= 0.566493002730344 */ \
+    ta = OD_DCT_MLA_EPI32(ta, t5, 9281, 8192, 14); \
+    /* 6393/8192 ~= Tan[27*Pi/128] ~= 0.780407659653944 */ \
+    t4 = OD_DCT_MLA_EPI32(t4, tb, 6393, 4096, 13); \
+    /* 3973/4096 ~= Sin[27*Pi/64] ~= 0.970031253194544 */ \
+    tb = OD_DCT_MLS_EPI32(tb, t4, 3973, 2048, 12); \
+    /* 6393/8192 ~= Tan[27*Pi/128] ~= 0.780407659653944 */ \
+    t4 = OD_DCT_MLA_EPI32(t4, tb, 6393, 4096, 13); \
+    /* 7263/16384 ~= Tan[17*Pi/128] ~= 0.443269513890864 */ \
+    te = OD_DCT_MLA_EPI32(te, t1, 7263, 8192, 14); \
+    /* 3035/4096 ~= Sin[17*Pi/64] ~= 0.740951125354959 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, te, 3035, 2048, 12); \
+    /* 14525/32768 ~= Tan[17*Pi/128] ~= 0.443269513890864 */ \
+    te = OD_DCT_MLA_EPI32(te, t1, 14525, 16384, 15); \
+    /* 2417/32768 ~= Tan[3*Pi/128] ~= 0.0737644315224493 */ \
+    t8 = OD_DCT_MLS_EPI32(t8, t7, 2417, 16384, 15); \
+    /* 601/4096 ~= Sin[3*Pi/64] ~= 0.146730474455362 */ \
+    t7 = OD_DCT_MLA_EPI32(t7, t8, 601, 2048, 12); \
+    /* 2417/32768 ~= Tan[3*Pi/128] ~= 0.0737644315224493 */ \
+    t8 = OD_DCT_MLS_EPI32(t8, t7, 2417, 16384, 15); \
+    /* 7799/8192 ~= Tan[31*Pi/128] ~= 0.952079146700925 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, tf, 7799, 4096, 13); \
+    /* 4091/4096 ~= Sin[31*Pi/64] ~= 0.998795456205172 */ \
+    tf = OD_DCT_MLS_EPI32(tf, t0, 4091, 2048, 12); \
+    /* 7799/8192 ~= Tan[31*Pi/128] ~= 0.952079146700925 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, tf, 7799, 4096, 13); \
+    /* TODO: Can we move these into another operation */ \
+    t1 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t1); \
+    t3 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t3); \
+    t5 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t5); \
+    t9 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t9); \
+    tb = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tb); \
+    td = od_mm256_sub_epi32(od_mm256_set1_epi32(0), td); \
+    tf = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tf); \
+    t4 = od_mm256_add_epi32(t4, ta); \
+    t4h = od_mm256_unbiased_rshift32(t4, 1); \
+    ta = od_mm256_sub_epi32(t4h, ta); \
+    tb = od_mm256_sub_epi32(tb, t5); \
+    tbh_ = od_mm256_unbiased_rshift32(tb, 1); \
+    t5 = od_mm256_add_epi32(t5, tbh_); \
+    tc = od_mm256_add_epi32(tc, t2); \
+    tch = od_mm256_unbiased_rshift32(tc, 1); \
+    t2 = od_mm256_sub_epi32(t2, tch); \
+    t3 = od_mm256_sub_epi32(t3, td); \
+    t3h_ = od_mm256_unbiased_rshift32(t3, 1); \
+    td = od_mm256_add_epi32(td, t3h_); \
+    t9 = od_mm256_add_epi32(t9, t8); \
+    t9h_ = od_mm256_unbiased_rshift32(t9, 1); \
+    t8 = od_mm256_sub_epi32(t8, t9h_); \
+    t6 = od_mm256_sub_epi32(t6, t7); \
+    t6h = od_mm256_unbiased_rshift32(t6, 1); \
+    t7 = od_mm256_add_epi32(t7, t6h); \
+    t1 = od_mm256_add_epi32(t1, tf); \
+    t1h_ = od_mm256_unbiased_rshift32(t1, 1); \
+    tf = od_mm256_sub_epi32(tf, t1h_); \
+    te = od_mm256_sub_epi32(te, t0); \
+    teh = od_mm256_unbiased_rshift32(te, 1); \
+    t0 = od_mm256_add_epi32(t0, teh); \
+    ta = od_mm256_add_epi32(ta, t9h_); \
+    t9 = od_mm256_sub_epi32(ta, t9); \
+    t5 = od_mm256_sub_epi32(t5, t6h); \
+    t6 = od_mm256_add_epi32(t6, t5); \
+    td = od_mm256_sub_epi32(teh, td); \
+    te = od_mm256_sub_epi32(td, te); \
+    t2 = od_mm256_sub_epi32(t1h_, t2); \
+    t1 = od_mm256_sub_epi32(t1, t2); \
+    t7 = od_mm256_add_epi32(t7, t4h); \
+    t4 = od_mm256_sub_epi32(t4, t7); \
+    t8 = od_mm256_sub_epi32(t8, tbh_); \
+    tb = od_mm256_add_epi32(tb, t8); \
+    t0 = od_mm256_add_epi32(t0, tch); \
+    tc = od_mm256_sub_epi32(tc, t0); \
+    tf = od_mm256_sub_epi32(tf, t3h_); \
+    t3 = od_mm256_add_epi32(t3, tf); \
+    /* TODO: Can we move this into another operation */ \
+    ta = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ta); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    td = OD_DCT_MLA_EPI32(td, t2, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    t2 = OD_DCT_MLS_EPI32(t2, td, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.820678790828660 */ \
+    td = OD_DCT_MLA_EPI32(td, t2, 6723, 4096, 13); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, ta, 2485, 4096, 13); \
+    /* 18205/32768 ~= Sin[3*Pi/16] ~= 0.555570233019602 */ \
+    ta = OD_DCT_MLA_EPI32(ta, t5, 18205, 16384, 15); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, ta, 2485, 4096, 13); \
+    t2 = od_mm256_add_epi32(t2, t5); \
+    t2h = od_mm256_unbiased_rshift32(t2, 1); \
+    t5 = od_mm256_sub_epi32(t5, t2h); \
+    ta = od_mm256_sub_epi32(td, ta); \
+    td = od_mm256_sub_epi32(td, od_mm256_unbiased_rshift32(ta, 1)); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    ta = OD_DCT_MLS_EPI32(ta, t5, 13573, 8192, 14); \
+    /* 11585/32768 ~= Sin[Pi/4]/2 ~= 0.353553390593274 */ \
+    t5 = OD_DCT_MLA_EPI32(t5, ta, 11585, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    ta = OD_DCT_MLS_EPI32(ta, t5, 13573, 8192, 14); \
+    /* 17515/32768 ~= Tan[5*Pi/32] ~= 0.534511135950792 */ \
+    t9 = OD_DCT_MLS_EPI32(t9, t6, 17515, 16384, 15); \
+    /* 13623/16384 ~= Sin[5*Pi/16] ~= 0.831469612302545 */ \
+    t6 = OD_DCT_MLA_EPI32(t6, t9, 13623, 8192, 14); \
+    /* 17515/32768 ~= Tan[5*Pi/32]) ~= 0.534511135950792 */ \
+    t9 = OD_DCT_MLS_EPI32(t9, t6, 17515, 16384, 15); \
+    /* 6723/8192 ~= Tan[7*Pi/32]) ~= 0.820678790828660 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, te, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.980785280403230 */ \
+    te = OD_DCT_MLA_EPI32(te, t1, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32]) ~= 0.820678790828660 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, te, 6723, 4096, 13); \
+    te = od_mm256_add_epi32(te, t6); \
+    teh = od_mm256_unbiased_rshift32(te, 1); \
+    t6 = od_mm256_sub_epi32(teh, t6); \
+    t9 = od_mm256_add_epi32(t9, t1); \
+    t1 = od_mm256_sub_epi32(t1, od_mm256_unbiased_rshift32(t9, 1)); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    t9 = OD_DCT_MLS_EPI32(t9, t6, 19195, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, t9, 11585, 8192, 14); \
+    /* 7489/8192 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    t9 = OD_DCT_MLA_EPI32(t9, t6, 7489, 4096, 13); \
+    tb = od_mm256_sub_epi32(tc, tb); \
+    tc = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(tb, 1), tc); \
+    t3 = od_mm256_add_epi32(t3, t4); \
+    t4 = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(t3, 1), t4); \
+    /* TODO: Can we move this into another operation */ \
+    t3 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t3); \
+    t8 = od_mm256_add_epi32(t8, tf); \
+    tf = od_mm256_sub_epi32(od_mm256_unbiased_rshift32(t8, 1), tf); \
+    t0 = od_mm256_add_epi32(t0, t7); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t7 = od_mm256_sub_epi32(t0h, t7); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, tc, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    tc = OD_DCT_MLS_EPI32(tc, t3, 15137, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, tc, 14341, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, tb, 14341, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    tb = OD_DCT_MLA_EPI32(tb, t4, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, tb, 4161, 8192, 14); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    t8 = OD_DCT_MLA_EPI32(t8, t7, 13573, 8192, 14); \
+    /* 11585/32768 ~= Sin[Pi/4]/2 ~= 0.353553390593274 */ \
+    t7 = OD_DCT_MLS_EPI32(t7, t8, 11585, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    t8 = OD_DCT_MLA_EPI32(t8, t7, 13573, 8192, 14); \
+    /* TODO: Can we move these into another operation */ \
+    t1 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t1); \
+    t5 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t5); \
+    t9 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t9); \
+    tb = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tb); \
+    td = od_mm256_sub_epi32(od_mm256_set1_epi32(0), td); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_32(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, t6, tm, \
+ te, tu, t1, th, t9, tp, t5, tl, td, tt, t3, tj, tb, tr, t7, tn, tf, tv) \
+  /* Embedded 32-point orthonormal Type-II fDCT. */ \
+  do { \
+    od_m256i tgh; \
+    od_m256i thh; \
+    od_m256i tih; \
+    od_m256i tkh; \
+    od_m256i tmh; \
+    od_m256i tnh; \
+    od_m256i toh; \
+    od_m256i tqh; \
+    od_m256i tsh; \
+    od_m256i tuh; \
+    od_m256i tvh; \
+    tv = od_mm256_sub_epi32(t0, tv); \
+    tvh = od_mm256_unbiased_rshift32(tv, 1); \
+    t0 = od_mm256_sub_epi32(t0, tvh); \
+    tu = od_mm256_add_epi32(tu, t1); \
+    tuh = od_mm256_unbiased_rshift32(tu, 1); \
+    t1 = od_mm256_sub_epi32(tuh, t1); \
+    tt = od_mm256_sub_epi32(t2, tt); \
+    t2 = od_mm256_sub_epi32(t2, od_mm256_unbiased_rshift32(tt, 1)); \
+    ts = od_mm256_add_epi32(ts, t3); \
+    tsh = od_mm256_unbiased_rshift32(ts, 1); \
+    t3 = od_mm256_sub_epi32(tsh, t3); \
+    tr = od_mm256_sub_epi32(t4, tr); \
+    t4 = od_mm256_sub_epi32(t4, od_mm256_unbiased_rshift32(tr, 1)); \
+    tq = od_mm256_add_epi32(tq, t5); \
+    tqh = od_mm256_unbiased_rshift32(tq, 1); \
+    t5 = od_mm256_sub_epi32(tqh, t5); \
+    tp = od_mm256_sub_epi32(t6, tp); \
+    t6 = od_mm256_sub_epi32(t6, od_mm256_unbiased_rshift32(tp, 1)); \
+    to = od_mm256_add_epi32(to, t7); \
+    toh = od_mm256_unbiased_rshift32(to, 1); \
+    t7 = od_mm256_sub_epi32(toh, t7); \
+    tn = od_mm256_sub_epi32(t8, tn); \
+    tnh = od_mm256_unbiased_rshift32(tn, 1); \
+    t8 = od_mm256_sub_epi32(t8, tnh); \
+    tm = od_mm256_add_epi32(tm, t9); \
+    tmh = od_mm256_unbiased_rshift32(tm, 1); \
+    t9 = od_mm256_sub_epi32(tmh, t9); \
+    tl = od_mm256_sub_epi32(ta, tl); \
+    ta = od_mm256_sub_epi32(ta, od_mm256_unbiased_rshift32(tl, 1)); \
+    tk = od_mm256_add_epi32(tk, tb); \
+    tkh = od_mm256_unbiased_rshift32(tk, 1); \
+    tb = od_mm256_sub_epi32(tkh, tb); \
+    tj = od_mm256_sub_epi32(tc, tj); \
+    tc = od_mm256_sub_epi32(tc, od_mm256_unbiased_rshift32(tj, 1)); \
+    ti = od_mm256_add_epi32(ti, td); \
+    tih = od_mm256_unbiased_rshift32(ti, 1); \
+    td = od_mm256_sub_epi32(tih, td); \
+    th = od_mm256_sub_epi32(te, th); \
+    thh = od_mm256_unbiased_rshift32(th, 1); \
+    te = od_mm256_sub_epi32(te, thh); \
+    tg = od_mm256_add_epi32(tg, tf); \
+    tgh = od_mm256_unbiased_rshift32(tg, 1); \
+    tf = od_mm256_sub_epi32(tgh, tf); \
+    OD_MM256_FDCT_16_ASYM(t0, tg, tgh, t8, to, toh, t4, tk, tkh, tc, ts, tsh, \
+     t2, ti, tih, ta, tq, tqh, t6, tm, tmh, te, tu, tuh); \
+    OD_MM256_FDST_16_ASYM(tv, tvh, tf, tn, tnh, t7, tr, tb, tj, t3, \
+     tt, td, tl, t5, tp, t9, th, thh, t1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_32(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, t6, tm, \
+ te, tu, t1, th, t9, tp, t5, tl, td, tt, t3, tj, tb, tr, t7, tn, tf, tv) \
+  /* Embedded 32-point orthonormal Type-II iDCT. */ \
+  do { \
+    od_m256i t1h; \
+    od_m256i t3h; \
+    od_m256i t5h; \
+    od_m256i t7h; \
+    od_m256i t9h; \
+    od_m256i tbh; \
+    od_m256i tdh; \
+    od_m256i tfh; \
+    od_m256i thh; \
+    od_m256i tth; \
+    od_m256i tvh; \
+    OD_MM256_IDST_16_ASYM(tv, tvh, tn, tr, tj, tt, tth, tl, tp, th, thh, \
+     tu, tm, tq, ti, ts, tk, to, tg); \
+    OD_MM256_IDCT_16_ASYM(t0, t8, t4, tc, t2, ta, t6, te, \
+     t1, t1h, t9, t9h, t5, t5h, td, tdh, t3, t3h, tb, tbh, t7, t7h, tf, tfh); \
+    tu = od_mm256_sub_epi32(t1h, tu); \
+    t1 = od_mm256_sub_epi32(t1, tu); \
+    te = od_mm256_add_epi32(te, thh); \
+    th = od_mm256_sub_epi32(te, th); \
+    tm = od_mm256_sub_epi32(t9h, tm); \
+    t9 = od_mm256_sub_epi32(t9, tm); \
+    t6 = od_mm256_add_epi32(t6, od_mm256_unbiased_rshift32(tp, 1)); \
+    tp = od_mm256_sub_epi32(t6, tp); \
+    tq = od_mm256_sub_epi32(t5h, tq); \
+    t5 = od_mm256_sub_epi32(t5, tq); \
+    ta = od_mm256_add_epi32(ta, od_mm256_unbiased_rshift32(tl, 1)); \
+    tl = od_mm256_sub_epi32(ta, tl); \
+    ti = od_mm256_sub_epi32(tdh, ti); \
+    td = od_mm256_sub_epi32(td, ti); \
+    t2 = od_mm256_add_epi32(t2, tth); \
+    tt = od_mm256_sub_epi32(t2, tt); \
+    ts = od_mm256_sub_epi32(t3h, ts); \
+    t3 = od_mm256_sub_epi32(t3, ts); \
+    tc = od_mm256_add_epi32(tc, od_mm256_unbiased_rshift32(tj, 1)); \
+    tj = od_mm256_sub_epi32(tc, tj); \
+    tk = od_mm256_sub_epi32(tbh, tk); \
+    tb = od_mm256_sub_epi32(tb, tk); \
+    t4 = od_mm256_add_epi32(t4, od_mm256_unbiased_rshift32(tr, 1)); \
+    tr = od_mm256_sub_epi32(t4, tr); \
+    to = od_mm256_sub_epi32(t7h, to); \
+    t7 = od_mm256_sub_epi32(t7, to); \
+    t8 = od_mm256_add_epi32(t8, od_mm256_unbiased_rshift32(tn, 1)); \
+    tn = od_mm256_sub_epi32(t8, tn); \
+    tg = od_mm256_sub_epi32(tfh, tg); \
+    tf = od_mm256_sub_epi32(tf, tg); \
+    t0 = od_mm256_add_epi32(t0, tvh); \
+    tv = od_mm256_sub_epi32(t0, tv); \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_32_ASYM(t0, tg, tgh, t8, to, toh, t4, tk, tkh, tc, ts, tsh, \
+ t2, ti, tih, ta, tq, tqh, t6, tm, tmh, te, tu, tuh, t1, th, thh, \
+ t9, tp, tph, t5, tl, tlh, td, tt, tth, t3, tj, tjh, tb, tr, trh, \
+ t7, tn, tnh, tf, tv, tvh) \
+  /* Embedded 32-point asymmetric Type-II fDCT. */ \
+  do { \
+    t0 = od_mm256_add_epi32(t0, tvh); \
+    tv = od_mm256_sub_epi32(t0, tv); \
+    t1 = od_mm256_sub_epi32(tuh, t1); \
+    tu = od_mm256_sub_epi32(tu, t1); \
+    t2 = od_mm256_add_epi32(t2, tth); \
+    tt = od_mm256_sub_epi32(t2, tt); \
+    t3 = od_mm256_sub_epi32(tsh, t3); \
+    ts = od_mm256_sub_epi32(ts, t3); \
+    t4 = od_mm256_add_epi32(t4, trh); \
+    tr = od_mm256_sub_epi32(t4, tr); \
+    t5 = od_mm256_sub_epi32(tqh, t5); \
+    tq = od_mm256_sub_epi32(tq, t5); \
+    t6 = od_mm256_add_epi32(t6, tph); \
+    tp = od_mm256_sub_epi32(t6, tp); \
+    t7 = od_mm256_sub_epi32(toh, t7); \
+    to = od_mm256_sub_epi32(to, t7); \
+    t8 = od_mm256_add_epi32(t8, tnh); \
+    tn = od_mm256_sub_epi32(t8, tn); \
+    t9 = od_mm256_sub_epi32(tmh, t9); \
+    tm = od_mm256_sub_epi32(tm, t9); \
+    ta = od_mm256_add_epi32(ta, tlh); \
+    tl = od_mm256_sub_epi32(ta, tl); \
+    tb = od_mm256_sub_epi32(tkh, tb); \
+    tk = od_mm256_sub_epi32(tk, tb); \
+    tc = od_mm256_add_epi32(tc, tjh); \
+    tj = od_mm256_sub_epi32(tc, tj); \
+    td = od_mm256_sub_epi32(tih, td); \
+    ti = od_mm256_sub_epi32(ti, td); \
+    te = od_mm256_add_epi32(te, thh); \
+    th = od_mm256_sub_epi32(te, th); \
+    tf = od_mm256_sub_epi32(tgh, tf); \
+    tg = od_mm256_sub_epi32(tg, tf); \
+    OD_MM256_FDCT_16(t0, tg, t8, to, t4, tk, tc, ts, \
+     t2, ti, ta, tq, t6, tm, te, tu); \
+    OD_MM256_FDST_16(tv, tf, tn, t7, tr, tb, tj, t3, \
+     tt, td, tl, t5, tp, t9, th, t1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_32_ASYM(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, \
+ t6, tm, te, tu, t1, t1h, th, thh, t9, t9h, tp, tph, t5, t5h, tl, tlh, \
+ td, tdh, tt, tth, t3, t3h, tj, tjh, tb, tbh, tr, trh, t7, t7h, tn, tnh, \
+ tf, tfh, tv, tvh) \
+  /* Embedded 32-point asymmetric Type-II iDCT. */ \
+  do { \
+    OD_MM256_IDST_16(tv, tn, tr, tj, tt, tl, tp, th, \
+     tu, tm, tq, ti, ts, tk, to, tg); \
+    OD_MM256_IDCT_16(t0, t8, t4, tc, t2, ta, t6, te, \
+     t1, t9, t5, td, t3, tb, t7, tf); \
+    tv = od_mm256_sub_epi32(t0, tv); \
+    tvh = od_mm256_unbiased_rshift32(tv, 1); \
+    t0 = od_mm256_sub_epi32(t0, tvh); \
+    t1 = od_mm256_add_epi32(t1, tu); \
+    t1h = od_mm256_unbiased_rshift32(t1, 1); \
+    tu = od_mm256_sub_epi32(t1h, tu); \
+    tt = od_mm256_sub_epi32(t2, tt); \
+    tth = od_mm256_unbiased_rshift32(tt, 1); \
+    t2 = od_mm256_sub_epi32(t2, tth); \
+    t3 = od_mm256_add_epi32(t3, ts); \
+    t3h = od_mm256_unbiased_rshift32(t3, 1); \
+    ts = od_mm256_sub_epi32(t3h, ts); \
+    tr = od_mm256_sub_epi32(t4, tr); \
+    trh = od_mm256_unbiased_rshift32(tr, 1); \
+    t4 = od_mm256_sub_epi32(t4, trh); \
+    t5 = od_mm256_add_epi32(t5, tq); \
+    t5h = od_mm256_unbiased_rshift32(t5, 1); \
+    tq = od_mm256_sub_epi32(t5h, tq); \
+    tp = od_mm256_sub_epi32(t6, tp); \
+    tph = od_mm256_unbiased_rshift32(tp, 1); \
+    t6 = od_mm256_sub_epi32(t6, tph); \
+    t7 = od_mm256_add_epi32(t7, to); \
+    t7h = od_mm256_unbiased_rshift32(t7, 1); \
+    to = od_mm256_sub_epi32(t7h, to); \
+    tn = od_mm256_sub_epi32(t8, tn); \
+    tnh = od_mm256_unbiased_rshift32(tn, 1); \
+    t8 = od_mm256_sub_epi32(t8, tnh); \
+    t9 = od_mm256_add_epi32(t9, tm); \
+    t9h = od_mm256_unbiased_rshift32(t9, 1); \
+    tm = od_mm256_sub_epi32(t9h, tm); \
+    tl = od_mm256_sub_epi32(ta, tl); \
+    tlh = od_mm256_unbiased_rshift32(tl, 1); \
+    ta = od_mm256_sub_epi32(ta, tlh); \
+    tb = od_mm256_add_epi32(tb, tk); \
+    tbh = od_mm256_unbiased_rshift32(tb, 1); \
+    tk = od_mm256_sub_epi32(tbh, tk); \
+    tj = od_mm256_sub_epi32(tc, tj); \
+    tjh = od_mm256_unbiased_rshift32(tj, 1); \
+    tc = od_mm256_sub_epi32(tc, tjh); \
+    td = od_mm256_add_epi32(td, ti); \
+    tdh = od_mm256_unbiased_rshift32(td, 1); \
+    ti = od_mm256_sub_epi32(tdh, ti); \
+    th = od_mm256_sub_epi32(te, th); \
+    thh = od_mm256_unbiased_rshift32(th, 1); \
+    te = od_mm256_sub_epi32(te, thh); \
+    tf = od_mm256_add_epi32(tf, tg); \
+    tfh = od_mm256_unbiased_rshift32(tf, 1); \
+    tg = od_mm256_sub_epi32(tfh, tg); \
+  } \
+  while (0)
+
+#define OD_MM256_FDST_32_ASYM(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, t6, \
+ tm, te, tu, t1, th, t9, tp, t5, tl, td, tt, t3, tj, tb, tr, t7, tn, tf, tv) \
+  /* Embedded 32-point asymmetric Type-IV fDST. */ \
+  do { \
+    od_m256i t0h; \
+    od_m256i t1h; \
+    od_m256i t4h; \
+    od_m256i t5h; \
+    od_m256i tqh; \
+    od_m256i trh; \
+    od_m256i tuh; \
+    od_m256i tvh; \
+    \
+    tu = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tu); \
+    \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    od_mm256_overflow_check(tq, 13573, 8192, 271); \
+    t5 = OD_DCT_MLS_EPI32(t5, tq, 13573, 8192, 14); \
+    /* 11585/32768 ~= Sin[Pi/4]/2 ~= 0.353553390593274 */ \
+    od_mm256_overflow_check(t5, 11585, 16384, 272); \
+    tq = OD_DCT_MLA_EPI32(tq, t5, 11585, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    od_mm256_overflow_check(tq, 13573, 8192, 273); \
+    t5 = OD_DCT_MLS_EPI32(t5, tq, 13573, 8192, 14); \
+    /* 29957/32768 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    od_mm256_overflow_check(t6, 29957, 16384, 274); \
+    tp = OD_DCT_MLA_EPI32(tp, t6, 29957, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    od_mm256_overflow_check(tp, 11585, 8192, 275); \
+    t6 = OD_DCT_MLS_EPI32(t6, tp, 11585, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    od_mm256_overflow_check(t6, 19195, 16384, 276); \
+    tp = OD_DCT_MLS_EPI32(tp, t6, 19195, 16384, 15); \
+    /* 29957/32768 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    od_mm256_overflow_check(t1, 29957, 16384, 277); \
+    tu = OD_DCT_MLA_EPI32(tu, t1, 29957, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    od_mm256_overflow_check(tu, 11585, 8192, 278); \
+    t1 = OD_DCT_MLS_EPI32(t1, tu, 11585, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    od_mm256_overflow_check(t1, 19195, 16384, 279); \
+    tu = OD_DCT_MLS_EPI32(tu, t1, 19195, 16384, 15); \
+    /* 28681/32768 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(t2, 28681, 16384, 280); \
+    tt = OD_DCT_MLA_EPI32(tt, t2, 28681, 16384, 15); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(tt, 15137, 8192, 281); \
+    t2 = OD_DCT_MLS_EPI32(t2, tt, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(t2, 4161, 8192, 282); \
+    tt = OD_DCT_MLA_EPI32(tt, t2, 4161, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(ts, 4161, 8192, 283); \
+    t3 = OD_DCT_MLA_EPI32(t3, ts, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(t3, 15137, 8192, 284); \
+    ts = OD_DCT_MLS_EPI32(ts, t3, 15137, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(ts, 14341, 8192, 285); \
+    t3 = OD_DCT_MLA_EPI32(t3, ts, 14341, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    od_mm256_overflow_check(tm, 19195, 16384, 286); \
+    t9 = OD_DCT_MLS_EPI32(t9, tm, 19195, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    od_mm256_overflow_check(t9, 11585, 8192, 287); \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 11585, 8192, 14); \
+    /* 7489/8192 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    od_mm256_overflow_check(tm, 7489, 4096, 288); \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 7489, 4096, 13); \
+    /* 3259/8192 ~= 2*Tan[Pi/16] ~= 0.397824734759316 */ \
+    od_mm256_overflow_check(tl, 3259, 4096, 289); \
+    ta = OD_DCT_MLA_EPI32(ta, tl, 3259, 4096, 13); \
+    /* 3135/16384 ~= Sin[Pi/8]/2 ~= 0.1913417161825449 */ \
+    od_mm256_overflow_check(ta, 3135, 8192, 290); \
+    tl = OD_DCT_MLS_EPI32(tl, ta, 3135, 8192, 14); \
+    /* 3259/8192 ~= 2*Tan[Pi/16] ~= 0.397824734759316 */ \
+    od_mm256_overflow_check(tl, 3259, 4096, 291); \
+    ta = OD_DCT_MLA_EPI32(ta, tl, 3259, 4096, 13); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(tk, 4161, 8192, 292); \
+    tb = OD_DCT_MLA_EPI32(tb, tk, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(tb, 15137, 8192, 293); \
+    tk = OD_DCT_MLS_EPI32(tk, tb, 15137, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(tk, 14341, 8192, 294); \
+    tb = OD_DCT_MLA_EPI32(tb, tk, 14341, 8192, 14); \
+    /* 29957/32768 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    od_mm256_overflow_check(te, 29957, 16384, 295); \
+    th = OD_DCT_MLA_EPI32(th, te, 29957, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    od_mm256_overflow_check(th, 11585, 8192, 296); \
+    te = OD_DCT_MLS_EPI32(te, th, 11585, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    od_mm256_overflow_check(te, 19195, 16384, 297); \
+    th = OD_DCT_MLS_EPI32(th, te, 19195, 16384, 15); \
+    /* 28681/32768 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(tc, 28681, 16384, 298); \
+    tj = OD_DCT_MLA_EPI32(tj, tc, 28681, 16384, 15); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(tj, 15137, 8192, 299); \
+    tc = OD_DCT_MLS_EPI32(tc, tj, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(tc, 4161, 8192, 300); \
+    tj = OD_DCT_MLA_EPI32(tj, tc, 4161, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    od_mm256_overflow_check(ti, 4161, 8192, 301); \
+    td = OD_DCT_MLA_EPI32(td, ti, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    od_mm256_overflow_check(td, 15137, 8192, 302); \
+    ti = OD_DCT_MLS_EPI32(ti, td, 15137, 8192, 14); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    od_mm256_overflow_check(ti, 14341, 8192, 303); \
+    td = OD_DCT_MLA_EPI32(td, ti, 14341, 8192, 14); \
+    \
+    t1 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t1); \
+    t2 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t2); \
+    t3 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t3); \
+    td = od_mm256_sub_epi32(od_mm256_set1_epi32(0), td); \
+    tg = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tg); \
+    to = od_mm256_sub_epi32(od_mm256_set1_epi32(0), to); \
+    ts = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ts); \
+    \
+    tr = od_mm256_sub_epi32(tr, od_mm256_unbiased_rshift32(t5, 1)); \
+    t5 = od_mm256_add_epi32(t5, tr); \
+    tq = od_mm256_sub_epi32(tq, od_mm256_unbiased_rshift32(t4, 1)); /* pass */ \
+    t4 = od_mm256_add_epi32(t4, tq); \
+    t6 = od_mm256_sub_epi32(t6, od_mm256_unbiased_rshift32(t7, 1)); \
+    t7 = od_mm256_add_epi32(t7, t6); \
+    to = od_mm256_sub_epi32(to, od_mm256_unbiased_rshift32(tp, 1)); /* pass */ \
+    tp = od_mm256_add_epi32(tp, to); \
+    t1 = od_mm256_add_epi32(t1, od_mm256_unbiased_rshift32(t0, 1)); /* pass */ \
+    t0 = od_mm256_sub_epi32(t0, t1); \
+    tv = od_mm256_sub_epi32(tv, od_mm256_unbiased_rshift32(tu, 1)); \
+    tu = od_mm256_add_epi32(tu, tv); \
+    t3 = od_mm256_sub_epi32(t3, od_mm256_unbiased_rshift32(tt, 1)); \
+    tt = od_mm256_add_epi32(tt, t3); \
+    t2 = od_mm256_add_epi32(t2, od_mm256_unbiased_rshift32(ts, 1)); \
+    ts = od_mm256_sub_epi32(ts, t2); \
+    t9 = od_mm256_sub_epi32(t9, od_mm256_unbiased_rshift32(t8, 1)); /* pass */ \
+    t8 = od_mm256_add_epi32(t8, t9); \
+    tn = od_mm256_add_epi32(tn, od_mm256_unbiased_rshift32(tm, 1)); \
+    tm = od_mm256_sub_epi32(tm, tn); \
+    tb = od_mm256_add_epi32(tb, od_mm256_unbiased_rshift32(ta, 1)); \
+    ta = od_mm256_sub_epi32(ta, tb); \
+    tl = od_mm256_sub_epi32(tl, od_mm256_unbiased_rshift32(tk, 1)); \
+    tk = od_mm256_add_epi32(tk, tl); \
+    te = od_mm256_sub_epi32(te, od_mm256_unbiased_rshift32(tf, 1)); /* pass */ \
+    tf = od_mm256_add_epi32(tf, te); \
+    tg = od_mm256_sub_epi32(tg, od_mm256_unbiased_rshift32(th, 1)); \
+    th = od_mm256_add_epi32(th, tg); \
+    tc = od_mm256_sub_epi32(tc, od_mm256_unbiased_rshift32(ti, 1)); \
+    ti = od_mm256_add_epi32(ti, tc); \
+    td = od_mm256_add_epi32(td, od_mm256_unbiased_rshift32(tj, 1)); \
+    tj = od_mm256_sub_epi32(tj, td); \
+    \
+    t4 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t4); \
+    \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.8206787908286602 */ \
+    od_mm256_overflow_check(tr, 6723, 4096, 304); \
+    t4 = OD_DCT_MLA_EPI32(t4, tr, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.9807852804032304 */ \
+    od_mm256_overflow_check(t4, 16069, 8192, 305); \
+    tr = OD_DCT_MLS_EPI32(tr, t4, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.8206787908286602 */ \
+    od_mm256_overflow_check(tr, 6723, 4096, 306); \
+    t4 = OD_DCT_MLA_EPI32(t4, tr, 6723, 4096, 13); \
+    /* 17515/32768 ~= Tan[5*Pi/32] ~= 0.5345111359507916 */ \
+    od_mm256_overflow_check(tq, 17515, 16384, 307); \
+    t5 = OD_DCT_MLA_EPI32(t5, tq, 17515, 16384, 15); \
+    /* 13623/16384 ~= Sin[5*Pi/16] ~= 0.8314696123025452 */ \
+    od_mm256_overflow_check(t5, 13623, 8192, 308); \
+    tq = OD_DCT_MLS_EPI32(tq, t5, 13623, 8192, 14); \
+    /* 17515/32768 ~= Tan[5*Pi/32] ~= 0.5345111359507916 */ \
+    od_mm256_overflow_check(tq, 17515, 16384, 309); \
+    t5 = OD_DCT_MLA_EPI32(t5, tq, 17515, 16384, 15); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    od_mm256_overflow_check(to, 3227, 16384, 310); \
+    t7 = OD_DCT_MLA_EPI32(t7, to, 3227, 16384, 15); \
+    /* 6393/32768 ~= Sin[Pi/16] ~= 0.19509032201612825 */ \
+    od_mm256_overflow_check(t7, 6393, 16384, 311); \
+    to = OD_DCT_MLS_EPI32(to, t7, 6393, 16384, 15); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    od_mm256_overflow_check(to, 3227, 16384, 312); \
+    t7 = OD_DCT_MLA_EPI32(t7, to, 3227, 16384, 15); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    od_mm256_overflow_check(tp, 2485, 4096, 313); \
+    t6 = OD_DCT_MLA_EPI32(t6, tp, 2485, 4096, 13); \
+    /* 18205/32768 ~= Sin[3*Pi/16] ~= 0.555570233019602 */ \
+    od_mm256_overflow_check(t6, 18205, 16384, 314); \
+    tp = OD_DCT_MLS_EPI32(tp, t6, 18205, 16384, 15); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    od_mm256_overflow_check(tp, 2485, 4096, 315); \
+    t6 = OD_DCT_MLA_EPI32(t6, tp, 2485, 4096, 13); \
+    \
+    t5 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t5); \
+    \
+    tr = od_mm256_add_epi32(tr, to); \
+    trh = od_mm256_unbiased_rshift32(tr, 1); \
+    to = od_mm256_sub_epi32(to, trh); \
+    t4 = od_mm256_add_epi32(t4, t7); \
+    t4h = od_mm256_unbiased_rshift32(t4, 1); \
+    t7 = od_mm256_sub_epi32(t7, t4h); \
+    t5 = od_mm256_add_epi32(t5, tp); \
+    t5h = od_mm256_unbiased_rshift32(t5, 1); \
+    tp = od_mm256_sub_epi32(tp, t5h); \
+    tq = od_mm256_add_epi32(tq, t6); \
+    tqh = od_mm256_unbiased_rshift32(tq, 1); \
+    t6 = od_mm256_sub_epi32(t6, tqh); \
+    t0 = od_mm256_sub_epi32(t0, t3); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t3 = od_mm256_add_epi32(t3, t0h); \
+    tv = od_mm256_sub_epi32(tv, ts); \
+    tvh = od_mm256_unbiased_rshift32(tv, 1); \
+    ts = od_mm256_add_epi32(ts, tvh); \
+    tu = od_mm256_add_epi32(tu, tt); \
+    tuh = od_mm256_unbiased_rshift32(tu, 1); \
+    tt = od_mm256_sub_epi32(tt, tuh); \
+    t1 = od_mm256_sub_epi32(t1, t2); \
+    t1h = od_mm256_unbiased_rshift32(t1, 1); \
+    t2 = od_mm256_add_epi32(t2, t1h); \
+    t8 = od_mm256_add_epi32(t8, tb); \
+    tb = od_mm256_sub_epi32(tb, od_mm256_unbiased_rshift32(t8, 1)); \
+    tn = od_mm256_add_epi32(tn, tk); \
+    tk = od_mm256_sub_epi32(tk, od_mm256_unbiased_rshift32(tn, 1)); \
+    t9 = od_mm256_add_epi32(t9, tl); \
+    tl = od_mm256_sub_epi32(tl, od_mm256_unbiased_rshift32(t9, 1)); \
+    tm = od_mm256_sub_epi32(tm, ta); \
+    ta = od_mm256_add_epi32(ta, od_mm256_unbiased_rshift32(tm, 1)); \
+    tc = od_mm256_sub_epi32(tc, tf); \
+    tf = od_mm256_add_epi32(tf, od_mm256_unbiased_rshift32(tc, 1)); \
+    tj = od_mm256_add_epi32(tj, tg); \
+    tg = od_mm256_sub_epi32(tg, od_mm256_unbiased_rshift32(tj, 1)); \
+    td = od_mm256_sub_epi32(td, te); \
+    te = od_mm256_add_epi32(te, od_mm256_unbiased_rshift32(td, 1)); \
+    ti = od_mm256_add_epi32(ti, th); \
+    th = od_mm256_sub_epi32(th, od_mm256_unbiased_rshift32(ti, 1)); \
+    \
+    t9 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t9); \
+    tl = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tl); \
+    \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    od_mm256_overflow_check(tn, 805, 8192, 316); \
+    t8 = OD_DCT_MLA_EPI32(t8, tn, 805, 8192, 14); \
+    /* 803/8192 ~= Sin[Pi/32] ~= 0.0980171403295606 */ \
+    od_mm256_overflow_check(t8, 803, 4096, 317); \
+    tn = OD_DCT_MLS_EPI32(tn, t8, 803, 4096, 13); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    od_mm256_overflow_check(tn, 805, 8192, 318); \
+    t8 = OD_DCT_MLA_EPI32(t8, tn, 805, 8192, 14); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    od_mm256_overflow_check(tb, 11725, 16384, 319); \
+    tk = OD_DCT_MLA_EPI32(tk, tb, 11725, 16384, 15); \
+    /* 5197/8192 ~= Sin[7*Pi/32] ~= 0.6343932841636455 */ \
+    od_mm256_overflow_check(tk, 5197, 4096, 320); \
+    tb = OD_DCT_MLS_EPI32(tb, tk, 5197, 4096, 13); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    od_mm256_overflow_check(tb, 11725, 16384, 321); \
+    tk = OD_DCT_MLA_EPI32(tk, tb, 11725, 16384, 15); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.5993769336819237 */ \
+    od_mm256_overflow_check(tl, 2455, 2048, 322); \
+    ta = OD_DCT_MLA_EPI32(ta, tl, 2455, 2048, 12); \
+    /* 14449/16384 ~= Sin[11*Pi/32] ~= 0.881921264348355 */ \
+    od_mm256_overflow_check(ta, 14449, 8192, 323); \
+    tl = OD_DCT_MLS_EPI32(tl, ta, 14449, 8192, 14); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.5993769336819237 */ \
+    od_mm256_overflow_check(tl, 2455, 2048, 324); \
+    ta = OD_DCT_MLA_EPI32(ta, tl, 2455, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    od_mm256_overflow_check(tm, 4861, 16384, 325); \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 4861, 16384, 15); \
+    /* 1189/4096 ~= Sin[3*Pi/32] ~= 0.29028467725446233 */ \
+    od_mm256_overflow_check(t9, 1189, 2048, 326); \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 1189, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    od_mm256_overflow_check(tm, 4861, 16384, 327); \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 4861, 16384, 15); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    od_mm256_overflow_check(tg, 805, 8192, 328); \
+    tf = OD_DCT_MLA_EPI32(tf, tg, 805, 8192, 14); \
+    /* 803/8192 ~= Sin[Pi/32] ~= 0.0980171403295606 */ \
+    od_mm256_overflow_check(tf, 803, 4096, 329); \
+    tg = OD_DCT_MLS_EPI32(tg, tf, 803, 4096, 13); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    od_mm256_overflow_check(tg, 805, 8192, 330); \
+    tf = OD_DCT_MLA_EPI32(tf, tg, 805, 8192, 14); \
+    /* 2931/8192 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    od_mm256_overflow_check(tj, 2931, 4096, 331); \
+    tc = OD_DCT_MLA_EPI32(tc, tj, 2931, 4096, 13); \
+    /* 5197/8192 ~= Sin[7*Pi/32] ~= 0.6343932841636455 */ \
+    od_mm256_overflow_check(tc, 5197, 4096, 332); \
+    tj = OD_DCT_MLS_EPI32(tj, tc, 5197, 4096, 13); \
+    /* 2931/8192 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    od_mm256_overflow_check(tj, 2931, 4096, 333); \
+    tc = OD_DCT_MLA_EPI32(tc, tj, 2931, 4096, 13); \
+    /* 513/2048 ~= Tan[5*Pi/64] ~= 0.25048696019130545 */ \
+    od_mm256_overflow_check(ti, 513, 1024, 334); \
+    td = OD_DCT_MLA_EPI32(td, ti, 513, 1024, 11); \
+    /* 7723/16384 ~= Sin[5*Pi/32] ~= 0.47139673682599764 */ \
+    od_mm256_overflow_check(td, 7723, 8192, 335); \
+    ti = OD_DCT_MLS_EPI32(ti, td, 7723, 8192, 14); \
+    /* 513/2048 ~= Tan[5*Pi/64] ~= 0.25048696019130545 */ \
+    od_mm256_overflow_check(ti, 513, 1024, 336); \
+    td = OD_DCT_MLA_EPI32(td, ti, 513, 1024, 11); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    od_mm256_overflow_check(th, 4861, 16384, 337); \
+    te = OD_DCT_MLA_EPI32(te, th, 4861, 16384, 15); \
+    /* 1189/4096 ~= Sin[3*Pi/32] ~= 0.29028467725446233 */ \
+    od_mm256_overflow_check(te, 1189, 2048, 338); \
+    th = OD_DCT_MLS_EPI32(th, te, 1189, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    od_mm256_overflow_check(th, 4861, 16384, 339); \
+    te = OD_DCT_MLA_EPI32(te, th, 4861, 16384, 15); \
+    \
+    ta = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ta); \
+    tb = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tb); \
+    \
+    tt = od_mm256_add_epi32(tt, t5h); \
+    t5 = od_mm256_sub_epi32(t5, tt); \
+    t2 = od_mm256_sub_epi32(t2, tqh); \
+    tq = od_mm256_add_epi32(tq, t2); \
+    tp = od_mm256_add_epi32(tp, t1h); \
+    t1 = od_mm256_sub_epi32(t1, tp); \
+    t6 = od_mm256_sub_epi32(t6, tuh); \
+    tu = od_mm256_add_epi32(tu, t6); \
+    t7 = od_mm256_add_epi32(t7, tvh); \
+    tv = od_mm256_sub_epi32(tv, t7); \
+    to = od_mm256_add_epi32(to, t0h); \
+    t0 = od_mm256_sub_epi32(t0, to); \
+    t3 = od_mm256_sub_epi32(t3, t4h); \
+    t4 = od_mm256_add_epi32(t4, t3); \
+    ts = od_mm256_add_epi32(ts, trh); \
+    tr = od_mm256_sub_epi32(tr, ts); \
+    tf = od_mm256_sub_epi32(tf, od_mm256_unbiased_rshift32(tn, 1)); \
+    tn = od_mm256_add_epi32(tn, tf); \
+    tg = od_mm256_sub_epi32(tg, od_mm256_unbiased_rshift32(t8, 1)); \
+    t8 = od_mm256_add_epi32(t8, tg); \
+    tk = od_mm256_add_epi32(tk, od_mm256_unbiased_rshift32(tc, 1)); \
+    tc = od_mm256_sub_epi32(tc, tk); \
+    tb = od_mm256_add_epi32(tb, od_mm256_unbiased_rshift32(tj, 1)); \
+    tj = od_mm256_sub_epi32(tj, tb); \
+    ta = od_mm256_add_epi32(ta, od_mm256_unbiased_rshift32(ti, 1)); \
+    ti = od_mm256_sub_epi32(ti, ta); \
+    tl = od_mm256_add_epi32(tl, od_mm256_unbiased_rshift32(td, 1)); \
+    td = od_mm256_sub_epi32(td, tl); \
+    te = od_mm256_sub_epi32(te, od_mm256_unbiased_rshift32(tm, 1)); \
+    tm = od_mm256_add_epi32(tm, te); \
+    th = od_mm256_sub_epi32(th, od_mm256_unbiased_rshift32(t9, 1)); \
+    t9 = od_mm256_add_epi32(t9, th); \
+    ta = od_mm256_sub_epi32(ta, t5); \
+    t5 = od_mm256_add_epi32(t5, od_mm256_unbiased_rshift32(ta, 1)); \
+    tq = od_mm256_sub_epi32(tq, tl); \
+    tl = od_mm256_add_epi32(tl, od_mm256_unbiased_rshift32(tq, 1)); \
+    t2 = od_mm256_sub_epi32(t2, ti); \
+    ti = od_mm256_add_epi32(ti, od_mm256_unbiased_rshift32(t2, 1)); \
+    td = od_mm256_sub_epi32(td, tt); \
+    tt = od_mm256_add_epi32(tt, od_mm256_unbiased_rshift32(td, 1)); \
+    tm = od_mm256_add_epi32(tm, tp); \
+    tp = od_mm256_sub_epi32(tp, od_mm256_unbiased_rshift32(tm, 1)); \
+    t6 = od_mm256_add_epi32(t6, t9); \
+    t9 = od_mm256_sub_epi32(t9, od_mm256_unbiased_rshift32(t6, 1)); \
+    te = od_mm256_sub_epi32(te, tu); \
+    tu = od_mm256_add_epi32(tu, od_mm256_unbiased_rshift32(te, 1)); \
+    t1 = od_mm256_sub_epi32(t1, th); \
+    th = od_mm256_add_epi32(th, od_mm256_unbiased_rshift32(t1, 1)); \
+    t0 = od_mm256_sub_epi32(t0, tg); \
+    tg = od_mm256_add_epi32(tg, od_mm256_unbiased_rshift32(t0, 1)); \
+    tf = od_mm256_add_epi32(tf, tv); \
+    tv = od_mm256_sub_epi32(tv, od_mm256_unbiased_rshift32(tf, 1)); \
+    t8 = od_mm256_sub_epi32(t8, t7); \
+    t7 = od_mm256_add_epi32(t7, od_mm256_unbiased_rshift32(t8, 1)); \
+    to = od_mm256_sub_epi32(to, tn); \
+    tn = od_mm256_add_epi32(tn, od_mm256_unbiased_rshift32(to, 1)); \
+    t4 = od_mm256_sub_epi32(t4, tk); \
+    tk = od_mm256_add_epi32(tk, od_mm256_unbiased_rshift32(t4, 1)); \
+    tb = od_mm256_sub_epi32(tb, tr); \
+    tr = od_mm256_add_epi32(tr, od_mm256_unbiased_rshift32(tb, 1)); \
+    t3 = od_mm256_sub_epi32(t3, tj); \
+    tj = od_mm256_add_epi32(tj, od_mm256_unbiased_rshift32(t3, 1)); \
+    tc = od_mm256_sub_epi32(tc, ts); \
+    ts = od_mm256_add_epi32(ts, od_mm256_unbiased_rshift32(tc, 1)); \
+    \
+    tr = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tr); \
+    ts = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ts); \
+    tt = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tt); \
+    tu = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tu); \
+    \
+    /* 2847/4096 ~= (1/Sqrt[2] - Cos[63*Pi/128]/2)/Sin[63*Pi/128] ~=
+        0.6950455016354713 */ \
+    od_mm256_overflow_check(t0, 2847, 2048, 340); \
+    tv = OD_DCT_MLA_EPI32(tv, t0, 2847, 2048, 12); \
+    /* 5791/4096 ~= Sqrt[2]*Sin[63*Pi/128] ~= 1.413787627688534 */ \
+    od_mm256_overflow_check(tv, 5791, 2048, 341); \
+    t0 = OD_DCT_MLS_EPI32(t0, tv, 5791, 2048, 12); \
+    /* 5593/8192 ~= (1/Sqrt[2] - Cos[63*Pi/128])/Sin[63*Pi/128] ~=
+        0.6827711905810085 */ \
+    od_mm256_overflow_check(t0, 5593, 4096, 342); \
+    tv = OD_DCT_MLA_EPI32(tv, t0, 5593, 4096, 13); \
+    /* 4099/8192 ~= (1/Sqrt[2] - Cos[31*Pi/128]/2)/Sin[31*Pi/128] ~=
+        0.5003088539809675 */ \
+    od_mm256_overflow_check(tf, 4099, 4096, 343); \
+    tg = OD_DCT_MLS_EPI32(tg, tf, 4099, 4096, 13); \
+    /* 1997/2048 ~= Sqrt[2]*Sin[31*Pi/128] ~= 0.9751575901732918 */ \
+    od_mm256_overflow_check(tg, 1997, 1024, 344); \
+    tf = OD_DCT_MLA_EPI32(tf, tg, 1997, 1024, 11); \
+    /* -815/32768 ~= (1/Sqrt[2] - Cos[31*Pi/128])/Sin[31*Pi/128] ~=
+        -0.02485756913896231 */ \
+    od_mm256_overflow_check(tf, 815, 16384, 345); \
+    tg = OD_DCT_MLA_EPI32(tg, tf, 815, 16384, 15); \
+    /* 2527/4096 ~= (1/Sqrt[2] - Cos[17*Pi/128]/2)/Sin[17*Pi/128] ~=
+        0.6169210657818165 */ \
+    od_mm256_overflow_check(t8, 2527, 2048, 346); \
+    tn = OD_DCT_MLS_EPI32(tn, t8, 2527, 2048, 12); \
+    /* 4695/8192 ~= Sqrt[2]*Sin[17*Pi/128] ~= 0.5730977622997507 */ \
+    od_mm256_overflow_check(tn, 4695, 4096, 347); \
+    t8 = OD_DCT_MLA_EPI32(t8, tn, 4695, 4096, 13); \
+    /* -4187/8192 ~= (1/Sqrt[2] - Cos[17*Pi/128])/Sin[17*Pi/128] ~=
+        -0.5110608601827629 */ \
+    od_mm256_overflow_check(t8, 4187, 4096, 348); \
+    tn = OD_DCT_MLA_EPI32(tn, t8, 4187, 4096, 13); \
+    /* 5477/8192 ~= (1/Sqrt[2] - Cos[15*Pi/128]/2)/Sin[15*Pi/128] ~=
+        0.6685570995525147 */ \
+    od_mm256_overflow_check(to, 5477, 4096, 349); \
+    t7 = OD_DCT_MLA_EPI32(t7, to, 5477, 4096, 13); \
+    /* 4169/8192 ~= Sqrt[2]*Sin[15*Pi/128] ~= 0.5089684416985407 */ \
+    od_mm256_overflow_check(t7, 4169, 4096, 350); \
+    to = OD_DCT_MLS_EPI32(to, t7, 4169, 4096, 13); \
+    /* -2571/4096 ~= (1/Sqrt[2] - Cos[15*Pi/128])/Sin[15*Pi/128] ~=
+        -0.6276441593165217 */ \
+    od_mm256_overflow_check(to, 2571, 2048, 351); \
+    t7 = OD_DCT_MLS_EPI32(t7, to, 2571, 2048, 12); \
+    /* 5331/8192 ~= (1/Sqrt[2] - Cos[59*Pi/128]/2)/Sin[59*Pi/128] ~=
+        0.6507957303604222 */ \
+    od_mm256_overflow_check(t2, 5331, 4096, 352); \
+    tt = OD_DCT_MLA_EPI32(tt, t2, 5331, 4096, 13); \
+    /* 5749/4096 ~= Sqrt[2]*Sin[59*Pi/128] ~= 1.4035780182072333 */ \
+    od_mm256_overflow_check(tt, 5749, 2048, 353); \
+    t2 = OD_DCT_MLS_EPI32(t2, tt, 5749, 2048, 12); \
+    /* 2413/4096 ~= (1/Sqrt[2] - Cos[59*Pi/128])/Sin[59*Pi/128] ~=
+        0.5891266122920528 */ \
+    od_mm256_overflow_check(t2, 2413, 2048, 354); \
+    tt = OD_DCT_MLA_EPI32(tt, t2, 2413, 2048, 12); \
+    /* 4167/8192 ~= (1/Sqrt[2] - Cos[27*Pi/128]/2)/Sin[27*Pi/128] ~=
+        0.5086435289805458 */ \
+    od_mm256_overflow_check(td, 4167, 4096, 355); \
+    ti = OD_DCT_MLS_EPI32(ti, td, 4167, 4096, 13); \
+    /* 891/1024 ~= Sqrt[2]*Sin[27*Pi/128] ~= 0.8700688593994939 */ \
+    od_mm256_overflow_check(ti, 891, 512, 356); \
+    td = OD_DCT_MLA_EPI32(td, ti, 891, 512, 10); \
+    /* -4327/32768 ~= (1/Sqrt[2] - Cos[27*Pi/128])/Sin[27*Pi/128] ~=
+        -0.13204726103773165 */ \
+    od_mm256_overflow_check(td, 4327, 16384, 357); \
+    ti = OD_DCT_MLA_EPI32(ti, td, 4327, 16384, 15); \
+    /* 2261/4096 ~= (1/Sqrt[2] - Cos[21*Pi/128]/2)/Sin[21*Pi/128] ~=
+        0.5519664910950994 */ \
+    od_mm256_overflow_check(ta, 2261, 2048, 358); \
+    tl = OD_DCT_MLS_EPI32(tl, ta, 2261, 2048, 12); \
+    /* 2855/4096 ~= Sqrt[2]*Sin[21*Pi/128] ~= 0.6970633083205415 */ \
+    od_mm256_overflow_check(tl, 2855, 2048, 359); \
+    ta = OD_DCT_MLA_EPI32(ta, tl, 2855, 2048, 12); \
+    /* -5417/16384 ~= (1/Sqrt[2] - Cos[21*Pi/128])/Sin[21*Pi/128] ~=
+        -0.3306569439519963 */ \
+    od_mm256_overflow_check(ta, 5417, 8192, 360); \
+    tl = OD_DCT_MLA_EPI32(tl, ta, 5417, 8192, 14); \
+    /* 3459/4096 ~= (1/Sqrt[2] - Cos[11*Pi/128]/2)/Sin[11*Pi/128] ~=
+        0.8444243553292501 */ \
+    od_mm256_overflow_check(tq, 3459, 2048, 361); \
+    t5 = OD_DCT_MLA_EPI32(t5, tq, 3459, 2048, 12); \
+    /* 1545/4096 ~= Sqrt[2]*Sin[11*Pi/128] ~= 0.37718879887892737 */ \
+    od_mm256_overflow_check(t5, 1545, 2048, 362); \
+    tq = OD_DCT_MLS_EPI32(tq, t5, 1545, 2048, 12); \
+    /* -1971/2048 ~= (1/Sqrt[2] - Cos[11*Pi/128])/Sin[11*Pi/128] ~=
+        -0.9623434853244648 */ \
+    od_mm256_overflow_check(tq, 1971, 1024, 363); \
+    t5 = OD_DCT_MLS_EPI32(t5, tq, 1971, 1024, 11); \
+    /* 323/512 ~= (1/Sqrt[2] - Cos[57*Pi/128]/2)/Sin[57*Pi/128] ~=
+        0.6309143839894504 */ \
+    od_mm256_overflow_check(t3, 323, 256, 364); \
+    ts = OD_DCT_MLA_EPI32(ts, t3, 323, 256, 9); \
+    /* 5707/4096 ~= Sqrt[2]*Sin[57*Pi/128] ~= 1.3933930045694292 */ \
+    od_mm256_overflow_check(ts, 5707, 2048, 365); \
+    t3 = OD_DCT_MLS_EPI32(t3, ts, 5707, 2048, 12); \
+    /* 2229/4096 ~= (1/Sqrt[2] - Cos[57*Pi/128])/Sin[57*Pi/128] ~=
+        0.5441561539205226 */ \
+    od_mm256_overflow_check(t3, 2229, 2048, 366); \
+    ts = OD_DCT_MLA_EPI32(ts, t3, 2229, 2048, 12); \
+    /* 1061/2048 ~= (1/Sqrt[2] - Cos[25*Pi/128]/2)/Sin[25*Pi/128] ~=
+        0.5180794213368158 */ \
+    od_mm256_overflow_check(tc, 1061, 1024, 367); \
+    tj = OD_DCT_MLS_EPI32(tj, tc, 1061, 1024, 11); \
+    /* 6671/8192 ~= Sqrt[2]*Sin[25*Pi/128] ~= 0.8143157536286402 */ \
+    od_mm256_overflow_check(tj, 6671, 4096, 368); \
+    tc = OD_DCT_MLA_EPI32(tc, tj, 6671, 4096, 13); \
+    /* -6287/32768 ~= (1/Sqrt[2] - Cos[25*Pi/128])/Sin[25*Pi/128] ~=
+        -0.19186603041023065 */ \
+    od_mm256_overflow_check(tc, 6287, 16384, 369); \
+    tj = OD_DCT_MLA_EPI32(tj, tc, 6287, 16384, 15); \
+    /* 4359/8192 ~= (1/Sqrt[2] - Cos[23*Pi/128]/2)/Sin[23*Pi/128] ~=
+        0.5321145141202145 */ \
+    od_mm256_overflow_check(tb, 4359, 4096, 370); \
+    tk = OD_DCT_MLS_EPI32(tk, tb, 4359, 4096, 13); \
+    /* 3099/4096 ~= Sqrt[2]*Sin[23*Pi/128] ~= 0.7566008898816587 */ \
+    od_mm256_overflow_check(tk, 3099, 2048, 371); \
+    tb = OD_DCT_MLA_EPI32(tb, tk, 3099, 2048, 12); \
+    /* -2109/8192 ~= (1/Sqrt[2] - Cos[23*Pi/128])/Sin[23*Pi/128] ~=
+        -0.2574717698598901 */ \
+    od_mm256_overflow_check(tb, 2109, 4096, 372); \
+    tk = OD_DCT_MLA_EPI32(tk, tb, 2109, 4096, 13); \
+    /* 5017/8192 ~= (1/Sqrt[2] - Cos[55*Pi/128]/2)/Sin[55*Pi/128] ~=
+        0.6124370775787037 */ \
+    od_mm256_overflow_check(t4, 5017, 4096, 373); \
+    tr = OD_DCT_MLA_EPI32(tr, t4, 5017, 4096, 13); \
+    /* 1413/1024 ~= Sqrt[2]*Sin[55*Pi/128] ~= 1.3798511851368045 */ \
+    od_mm256_overflow_check(tr, 1413, 512, 374); \
+    t4 = OD_DCT_MLS_EPI32(t4, tr, 1413, 512, 10); \
+    /* 8195/16384 ~= (1/Sqrt[2] - Cos[55*Pi/128])/Sin[55*Pi/128] ~=
+        0.5001583229201391 */ \
+    od_mm256_overflow_check(t4, 8195, 8192, 375); \
+    tr = OD_DCT_MLA_EPI32(tr, t4, 8195, 8192, 14); \
+    /* 2373/4096 ~= (1/Sqrt[2] - Cos[19*Pi/128]/2)/Sin[19*Pi/128] ~=
+        0.5793773719823809 */ \
+    od_mm256_overflow_check(tm, 2373, 2048, 376); \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 2373, 2048, 12); \
+    /* 5209/8192 ~= Sqrt[2]*Sin[19*Pi/128] ~= 0.6358464401941452 */ \
+    od_mm256_overflow_check(t9, 5209, 4096, 377); \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 5209, 4096, 13); \
+    /* -3391/8192 ~= (1/Sqrt[2] - Cos[19*Pi/128])/Sin[19*Pi/128] ~=
+        -0.41395202418930155 */ \
+    od_mm256_overflow_check(tm, 3391, 4096, 378); \
+    t9 = OD_DCT_MLS_EPI32(t9, tm, 3391, 4096, 13); \
+    /* 1517/2048 ~= (1/Sqrt[2] - Cos[13*Pi/128]/2)/Sin[13*Pi/128] ~=
+        0.7406956190518837 */ \
+    od_mm256_overflow_check(t6, 1517, 1024, 379); \
+    tp = OD_DCT_MLS_EPI32(tp, t6, 1517, 1024, 11); \
+    /* 1817/4096 ~= Sqrt[2]*Sin[13*Pi/128] ~= 0.4436129715409088 */ \
+    od_mm256_overflow_check(tp, 1817, 2048, 380); \
+    t6 = OD_DCT_MLA_EPI32(t6, tp, 1817, 2048, 12); \
+    /* -6331/8192 ~= (1/Sqrt[2] - Cos[13*Pi/128])/Sin[13*Pi/128] ~=
+        -0.772825983107003 */ \
+    od_mm256_overflow_check(t6, 6331, 4096, 381); \
+    tp = OD_DCT_MLA_EPI32(tp, t6, 6331, 4096, 13); \
+    /* 515/1024 ~= (1/Sqrt[2] - Cos[29*Pi/128]/2)/Sin[29*Pi/128] ~=
+        0.5029332763556925 */ \
+    od_mm256_overflow_check(te, 515, 512, 382); \
+    th = OD_DCT_MLS_EPI32(th, te, 515, 512, 10); \
+    /* 7567/8192 ~= Sqrt[2]*Sin[29*Pi/128] ~= 0.9237258930790229 */ \
+    od_mm256_overflow_check(th, 7567, 4096, 383); \
+    te = OD_DCT_MLA_EPI32(te, th, 7567, 4096, 13); \
+    /* -2513/32768 ~= (1/Sqrt[2] - Cos[29*Pi/128])/Sin[29*Pi/128] ~=
+        -0.07670567731102484 */ \
+    od_mm256_overflow_check(te, 2513, 16384, 384); \
+    th = OD_DCT_MLA_EPI32(th, te, 2513, 16384, 15); \
+    /* 2753/4096 ~= (1/Sqrt[2] - Cos[61*Pi/128]/2)/Sin[61*Pi/128] ~=
+        0.6721457072988726 */ \
+    od_mm256_overflow_check(t1, 2753, 2048, 385); \
+    tu = OD_DCT_MLA_EPI32(tu, t1, 2753, 2048, 12); \
+    /* 5777/4096 ~= Sqrt[2]*Sin[61*Pi/128] ~= 1.4103816894602614 */ \
+    od_mm256_overflow_check(tu, 5777, 2048, 386); \
+    t1 = OD_DCT_MLS_EPI32(t1, tu, 5777, 2048, 12); \
+    /* 1301/2048 ~= (1/Sqrt[2] - Cos[61*Pi/128])/Sin[61*Pi/128] ~=
+        0.6352634915376478 */ \
+    od_mm256_overflow_check(t1, 1301, 1024, 387); \
+    tu = OD_DCT_MLA_EPI32(tu, t1, 1301, 1024, 11); \
+  } \
+  while (0)
+
+#define OD_MM256_IDST_32_ASYM(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, t6, \
+ tm, te, tu, t1, th, t9, tp, t5, tl, td, tt, t3, tj, tb, tr, t7, tn, tf, tv) \
+  /* Embedded 32-point asymmetric Type-IV iDST. */ \
+  do { \
+    od_m256i t0h; \
+    od_m256i t4h; \
+    od_m256i tbh; \
+    od_m256i tfh; \
+    od_m256i tgh; \
+    od_m256i tkh; \
+    od_m256i trh; \
+    od_m256i tvh; \
+    /* 1301/2048 ~= (1/Sqrt[2] - Cos[61*Pi/128])/Sin[61*Pi/128] ~=
+        0.6352634915376478 */ \
+    tf = OD_DCT_MLS_EPI32(tf, tg, 1301, 1024, 11); \
+    /* 5777/4096 ~= Sqrt[2]*Sin[61*Pi/128] ~= 1.4103816894602614 */ \
+    tg = OD_DCT_MLA_EPI32(tg, tf, 5777, 2048, 12); \
+    /* 2753/4096 ~= (1/Sqrt[2] - Cos[61*Pi/128]/2)/Sin[61*Pi/128] ~=
+        0.6721457072988726 */ \
+    tf = OD_DCT_MLS_EPI32(tf, tg, 2753, 2048, 12); \
+    /* -2513/32768 ~= (1/Sqrt[2] - Cos[29*Pi/128])/Sin[29*Pi/128] ~=
+        -0.07670567731102484 */ \
+    th = OD_DCT_MLS_EPI32(th, te, 2513, 16384, 15); \
+    /* 7567/8192 ~= Sqrt[2]*Sin[29*Pi/128] ~= 0.9237258930790229 */ \
+    te = OD_DCT_MLS_EPI32(te, th, 7567, 4096, 13); \
+    /* 515/1024 ~= (1/Sqrt[2] - Cos[29*Pi/128]/2)/Sin[29*Pi/128] ~=
+        0.5029332763556925 */ \
+    th = OD_DCT_MLA_EPI32(th, te, 515, 512, 10); \
+    /* -6331/8192 ~= (1/Sqrt[2] - Cos[13*Pi/128])/Sin[13*Pi/128] ~=
+        -0.772825983107003 */ \
+    tj = OD_DCT_MLS_EPI32(tj, tc, 6331, 4096, 13); \
+    /* 1817/4096 ~= Sqrt[2]*Sin[13*Pi/128] ~= 0.4436129715409088 */ \
+    tc = OD_DCT_MLS_EPI32(tc, tj, 1817, 2048, 12); \
+    /* 1517/2048 ~= (1/Sqrt[2] - Cos[13*Pi/128]/2)/Sin[13*Pi/128] ~=
+        0.7406956190518837 */ \
+    tj = OD_DCT_MLA_EPI32(tj, tc, 1517, 1024, 11); \
+    /* -3391/8192 ~= (1/Sqrt[2] - Cos[19*Pi/128])/Sin[19*Pi/128] ~=
+        -0.41395202418930155 */ \
+    ti = OD_DCT_MLA_EPI32(ti, td, 3391, 4096, 13); \
+    /* 5209/8192 ~= Sqrt[2]*Sin[19*Pi/128] ~= 0.6358464401941452 */ \
+    td = OD_DCT_MLA_EPI32(td, ti, 5209, 4096, 13); \
+    /* 2373/4096 ~= (1/Sqrt[2] - Cos[19*Pi/128]/2)/Sin[19*Pi/128] ~=
+        0.5793773719823809 */ \
+    ti = OD_DCT_MLS_EPI32(ti, td, 2373, 2048, 12); \
+    /* 8195/16384 ~= (1/Sqrt[2] - Cos[55*Pi/128])/Sin[55*Pi/128] ~=
+        0.5001583229201391 */ \
+    tr = OD_DCT_MLS_EPI32(tr, t4, 8195, 8192, 14); \
+    /* 1413/1024 ~= Sqrt[2]*Sin[55*Pi/128] ~= 1.3798511851368045 */ \
+    t4 = OD_DCT_MLA_EPI32(t4, tr, 1413, 512, 10); \
+    /* 5017/8192 ~= (1/Sqrt[2] - Cos[55*Pi/128]/2)/Sin[55*Pi/128] ~=
+        0.6124370775787037 */ \
+    tr = OD_DCT_MLS_EPI32(tr, t4, 5017, 4096, 13); \
+    /* -2109/8192 ~= (1/Sqrt[2] - Cos[23*Pi/128])/Sin[23*Pi/128] ~=
+        -0.2574717698598901 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, tq, 2109, 4096, 13); \
+    /* 3099/4096 ~= Sqrt[2]*Sin[23*Pi/128] ~= 0.7566008898816587 */ \
+    tq = OD_DCT_MLS_EPI32(tq, t5, 3099, 2048, 12); \
+    /* 4359/8192 ~= (1/Sqrt[2] - Cos[23*Pi/128]/2)/Sin[23*Pi/128] ~=
+        0.5321145141202145 */ \
+    t5 = OD_DCT_MLA_EPI32(t5, tq, 4359, 4096, 13); \
+    /* -6287/32768 ~= (1/Sqrt[2] - Cos[25*Pi/128])/Sin[25*Pi/128] ~=
+        -0.19186603041023065 */ \
+    tp = OD_DCT_MLS_EPI32(tp, t6, 6287, 16384, 15); \
+    /* 6671/8192 ~= Sqrt[2]*Sin[25*Pi/128] ~= 0.8143157536286402 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, tp, 6671, 4096, 13); \
+    /* 1061/2048 ~= (1/Sqrt[2] - Cos[25*Pi/128]/2)/Sin[25*Pi/128] ~=
+        0.5180794213368158 */ \
+    tp = OD_DCT_MLA_EPI32(tp, t6, 1061, 1024, 11); \
+    /* 2229/4096 ~= (1/Sqrt[2] - Cos[57*Pi/128])/Sin[57*Pi/128] ~=
+        0.5441561539205226 */ \
+    t7 = OD_DCT_MLS_EPI32(t7, to, 2229, 2048, 12); \
+    /* 5707/4096 ~= Sqrt[2]*Sin[57*Pi/128] ~= 1.3933930045694292 */ \
+    to = OD_DCT_MLA_EPI32(to, t7, 5707, 2048, 12); \
+    /* 323/512 ~= (1/Sqrt[2] - Cos[57*Pi/128]/2)/Sin[57*Pi/128] ~=
+        0.6309143839894504 */ \
+    t7 = OD_DCT_MLS_EPI32(t7, to, 323, 256, 9); \
+    /* -1971/2048 ~= (1/Sqrt[2] - Cos[11*Pi/128])/Sin[11*Pi/128] ~=
+        -0.9623434853244648 */ \
+    tk = OD_DCT_MLA_EPI32(tk, tb, 1971, 1024, 11); \
+    /* 1545/4096 ~= Sqrt[2]*Sin[11*Pi/128] ~= 0.37718879887892737 */ \
+    tb = OD_DCT_MLA_EPI32(tb, tk, 1545, 2048, 12); \
+    /* 3459/4096 ~= (1/Sqrt[2] - Cos[11*Pi/128]/2)/Sin[11*Pi/128] ~=
+        0.8444243553292501 */ \
+    tk = OD_DCT_MLS_EPI32(tk, tb, 3459, 2048, 12); \
+    /* -5417/16384 ~= (1/Sqrt[2] - Cos[21*Pi/128])/Sin[21*Pi/128] ~=
+        -0.3306569439519963 */ \
+    tl = OD_DCT_MLS_EPI32(tl, ta, 5417, 8192, 14); \
+    /* 2855/4096 ~= Sqrt[2]*Sin[21*Pi/128] ~= 0.6970633083205415 */ \
+    ta = OD_DCT_MLS_EPI32(ta, tl, 2855, 2048, 12); \
+    /* 2261/4096 ~= (1/Sqrt[2] - Cos[21*Pi/128]/2)/Sin[21*Pi/128] ~=
+        0.5519664910950994 */ \
+    tl = OD_DCT_MLA_EPI32(tl, ta, 2261, 2048, 12); \
+    /* -4327/32768 ~= (1/Sqrt[2] - Cos[27*Pi/128])/Sin[27*Pi/128] ~=
+        -0.13204726103773165 */ \
+    t9 = OD_DCT_MLS_EPI32(t9, tm, 4327, 16384, 15); \
+    /* 891/1024 ~= Sqrt[2]*Sin[27*Pi/128] ~= 0.8700688593994939 */ \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 891, 512, 10); \
+    /* 4167/8192 ~= (1/Sqrt[2] - Cos[27*Pi/128]/2)/Sin[27*Pi/128] ~=
+        0.5086435289805458 */ \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 4167, 4096, 13); \
+    /* 2413/4096 ~= (1/Sqrt[2] - Cos[59*Pi/128])/Sin[59*Pi/128] ~=
+        0.5891266122920528 */ \
+    tn = OD_DCT_MLS_EPI32(tn, t8, 2413, 2048, 12); \
+    /* 5749/4096 ~= Sqrt[2]*Sin[59*Pi/128] ~= 1.4035780182072333 */ \
+    t8 = OD_DCT_MLA_EPI32(t8, tn, 5749, 2048, 12); \
+    /* 5331/8192 ~= (1/Sqrt[2] - Cos[59*Pi/128]/2)/Sin[59*Pi/128] ~=
+        0.6507957303604222 */ \
+    tn = OD_DCT_MLS_EPI32(tn, t8, 5331, 4096, 13); \
+    /* -2571/4096 ~= (1/Sqrt[2] - Cos[15*Pi/128])/Sin[15*Pi/128] ~=
+        -0.6276441593165217 */ \
+    ts = OD_DCT_MLA_EPI32(ts, t3, 2571, 2048, 12); \
+    /* 4169/8192 ~= Sqrt[2]*Sin[15*Pi/128] ~= 0.5089684416985407 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, ts, 4169, 4096, 13); \
+    /* 5477/8192 ~= (1/Sqrt[2] - Cos[15*Pi/128]/2)/Sin[15*Pi/128] ~=
+        0.6685570995525147 */ \
+    ts = OD_DCT_MLS_EPI32(ts, t3, 5477, 4096, 13); \
+    /* -4187/8192 ~= (1/Sqrt[2] - Cos[17*Pi/128])/Sin[17*Pi/128] ~=
+        -0.5110608601827629 */ \
+    tt = OD_DCT_MLS_EPI32(tt, t2, 4187, 4096, 13); \
+    /* 4695/8192 ~= Sqrt[2]*Sin[17*Pi/128] ~= 0.5730977622997507 */ \
+    t2 = OD_DCT_MLS_EPI32(t2, tt, 4695, 4096, 13); \
+    /* 2527/4096 ~= (1/Sqrt[2] - Cos[17*Pi/128]/2)/Sin[17*Pi/128] ~=
+        0.6169210657818165 */ \
+    tt = OD_DCT_MLA_EPI32(tt, t2, 2527, 2048, 12); \
+    /* -815/32768 ~= (1/Sqrt[2] - Cos[31*Pi/128])/Sin[31*Pi/128] ~=
+        -0.02485756913896231 */ \
+    t1 = OD_DCT_MLS_EPI32(t1, tu, 815, 16384, 15); \
+    /* 1997/2048 ~= Sqrt[2]*Sin[31*Pi/128] ~= 0.9751575901732918 */ \
+    tu = OD_DCT_MLS_EPI32(tu, t1, 1997, 1024, 11); \
+    /* 4099/8192 ~= (1/Sqrt[2] - Cos[31*Pi/128]/2)/Sin[31*Pi/128] ~=
+        0.5003088539809675 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, tu, 4099, 4096, 13); \
+    /* 5593/8192 ~= (1/Sqrt[2] - Cos[63*Pi/128])/Sin[63*Pi/128] ~=
+        0.6827711905810085 */ \
+    tv = OD_DCT_MLS_EPI32(tv, t0, 5593, 4096, 13); \
+    /* 5791/4096 ~= Sqrt[2]*Sin[63*Pi/128] ~= 1.413787627688534 */ \
+    t0 = OD_DCT_MLA_EPI32(t0, tv, 5791, 2048, 12); \
+    /* 2847/4096 ~= (1/Sqrt[2] - Cos[63*Pi/128]/2)/Sin[63*Pi/128] ~=
+        0.6950455016354713 */ \
+    tv = OD_DCT_MLS_EPI32(tv, t0, 2847, 2048, 12); \
+    \
+    t7 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t7); \
+    tf = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tf); \
+    tn = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tn); \
+    tr = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tr); \
+    \
+    t7 = od_mm256_sub_epi32(t7, od_mm256_unbiased_rshift32(t6, 1)); \
+    t6 = od_mm256_add_epi32(t6, t7); \
+    tp = od_mm256_sub_epi32(tp, od_mm256_unbiased_rshift32(to, 1)); \
+    to = od_mm256_add_epi32(to, tp); \
+    tr = od_mm256_sub_epi32(tr, od_mm256_unbiased_rshift32(tq, 1)); \
+    tq = od_mm256_add_epi32(tq, tr); \
+    t5 = od_mm256_sub_epi32(t5, od_mm256_unbiased_rshift32(t4, 1)); \
+    t4 = od_mm256_add_epi32(t4, t5); \
+    tt = od_mm256_sub_epi32(tt, od_mm256_unbiased_rshift32(t3, 1)); \
+    t3 = od_mm256_add_epi32(t3, tt); \
+    ts = od_mm256_sub_epi32(ts, od_mm256_unbiased_rshift32(t2, 1)); \
+    t2 = od_mm256_add_epi32(t2, ts); \
+    tv = od_mm256_add_epi32(tv, od_mm256_unbiased_rshift32(tu, 1)); \
+    tu = od_mm256_sub_epi32(tu, tv); \
+    t1 = od_mm256_sub_epi32(t1, od_mm256_unbiased_rshift32(t0, 1)); \
+    t0 = od_mm256_add_epi32(t0, t1); \
+    th = od_mm256_sub_epi32(th, od_mm256_unbiased_rshift32(tg, 1)); \
+    tg = od_mm256_add_epi32(tg, th); \
+    tf = od_mm256_sub_epi32(tf, od_mm256_unbiased_rshift32(te, 1)); \
+    te = od_mm256_add_epi32(te, tf); \
+    ti = od_mm256_add_epi32(ti, od_mm256_unbiased_rshift32(tc, 1)); \
+    tc = od_mm256_sub_epi32(tc, ti); \
+    tj = od_mm256_add_epi32(tj, od_mm256_unbiased_rshift32(td, 1)); \
+    td = od_mm256_sub_epi32(td, tj); \
+    tn = od_mm256_sub_epi32(tn, od_mm256_unbiased_rshift32(tm, 1)); \
+    tm = od_mm256_add_epi32(tm, tn); \
+    t9 = od_mm256_sub_epi32(t9, od_mm256_unbiased_rshift32(t8, 1)); \
+    t8 = od_mm256_add_epi32(t8, t9); \
+    tl = od_mm256_sub_epi32(tl, od_mm256_unbiased_rshift32(tb, 1)); \
+    tb = od_mm256_add_epi32(tb, tl); \
+    tk = od_mm256_sub_epi32(tk, od_mm256_unbiased_rshift32(ta, 1)); \
+    ta = od_mm256_add_epi32(ta, tk); \
+    \
+    ti = od_mm256_sub_epi32(ti, th); \
+    th = od_mm256_add_epi32(th, od_mm256_unbiased_rshift32(ti, 1)); \
+    td = od_mm256_sub_epi32(td, te); \
+    te = od_mm256_add_epi32(te, od_mm256_unbiased_rshift32(td, 1)); \
+    tm = od_mm256_add_epi32(tm, tl); \
+    tl = od_mm256_sub_epi32(tl, od_mm256_unbiased_rshift32(tm, 1)); \
+    t9 = od_mm256_add_epi32(t9, ta); \
+    ta = od_mm256_sub_epi32(ta, od_mm256_unbiased_rshift32(t9, 1)); \
+    tp = od_mm256_add_epi32(tp, tq); \
+    tq = od_mm256_sub_epi32(tq, od_mm256_unbiased_rshift32(tp, 1)); \
+    t6 = od_mm256_add_epi32(t6, t5); \
+    t5 = od_mm256_sub_epi32(t5, od_mm256_unbiased_rshift32(t6, 1)); \
+    t2 = od_mm256_sub_epi32(t2, t1); \
+    t1 = od_mm256_add_epi32(t1, od_mm256_unbiased_rshift32(t2, 1)); \
+    tt = od_mm256_sub_epi32(tt, tu); \
+    tu = od_mm256_add_epi32(tu, od_mm256_unbiased_rshift32(tt, 1)); \
+    tr = od_mm256_add_epi32(tr, t7); \
+    trh = od_mm256_unbiased_rshift32(tr, 1); \
+    t7 = od_mm256_sub_epi32(t7, trh); \
+    t4 = od_mm256_sub_epi32(t4, to); \
+    t4h = od_mm256_unbiased_rshift32(t4, 1); \
+    to = od_mm256_add_epi32(to, t4h); \
+    t0 = od_mm256_add_epi32(t0, t3); \
+    t0h = od_mm256_unbiased_rshift32(t0, 1); \
+    t3 = od_mm256_sub_epi32(t3, t0h); \
+    tv = od_mm256_add_epi32(tv, ts); \
+    tvh = od_mm256_unbiased_rshift32(tv, 1); \
+    ts = od_mm256_sub_epi32(ts, tvh); \
+    tf = od_mm256_sub_epi32(tf, tc); \
+    tfh = od_mm256_unbiased_rshift32(tf, 1); \
+    tc = od_mm256_add_epi32(tc, tfh); \
+    tg = od_mm256_add_epi32(tg, tj); \
+    tgh = od_mm256_unbiased_rshift32(tg, 1); \
+    tj = od_mm256_sub_epi32(tj, tgh); \
+    tb = od_mm256_sub_epi32(tb, t8); \
+    tbh = od_mm256_unbiased_rshift32(tb, 1); \
+    t8 = od_mm256_add_epi32(t8, tbh); \
+    tk = od_mm256_add_epi32(tk, tn); \
+    tkh = od_mm256_unbiased_rshift32(tk, 1); \
+    tn = od_mm256_sub_epi32(tn, tkh); \
+    \
+    ta = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ta); \
+    tq = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tq); \
+    \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    te = OD_DCT_MLS_EPI32(te, th, 4861, 16384, 15); \
+    /* 1189/4096 ~= Sin[3*Pi/32] ~= 0.29028467725446233 */ \
+    th = OD_DCT_MLA_EPI32(th, te, 1189, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    te = OD_DCT_MLS_EPI32(te, th, 4861, 16384, 15); \
+    /* 513/2048 ~= Tan[5*Pi/64] ~= 0.25048696019130545 */ \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 513, 1024, 11); \
+    /* 7723/16384 ~= Sin[5*Pi/32] ~= 0.47139673682599764 */ \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 7723, 8192, 14); \
+    /* 513/2048 ~= Tan[5*Pi/64] ~= 0.25048696019130545 */ \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 513, 1024, 11); \
+    /* 2931/8192 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, tp, 2931, 4096, 13); \
+    /* 5197/8192 ~= Sin[7*Pi/32] ~= 0.6343932841636455 */ \
+    tp = OD_DCT_MLA_EPI32(tp, t6, 5197, 4096, 13); \
+    /* 2931/8192 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    t6 = OD_DCT_MLS_EPI32(t6, tp, 2931, 4096, 13); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    tu = OD_DCT_MLS_EPI32(tu, t1, 805, 8192, 14); \
+    /* 803/8192 ~= Sin[Pi/32] ~= 0.0980171403295606 */ \
+    t1 = OD_DCT_MLA_EPI32(t1, tu, 803, 4096, 13); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    tu = OD_DCT_MLS_EPI32(tu, t1, 805, 8192, 14); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    ti = OD_DCT_MLS_EPI32(ti, td, 4861, 16384, 15); \
+    /* 1189/4096 ~= Sin[3*Pi/32] ~= 0.29028467725446233 */ \
+    td = OD_DCT_MLA_EPI32(td, ti, 1189, 2048, 12); \
+    /* 4861/32768 ~= Tan[3*Pi/64] ~= 0.14833598753834742 */ \
+    ti = OD_DCT_MLS_EPI32(ti, td, 4861, 16384, 15); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.5993769336819237 */ \
+    ta = OD_DCT_MLS_EPI32(ta, tl, 2455, 2048, 12); \
+    /* 14449/16384 ~= Sin[11*Pi/32] ~= 0.881921264348355 */ \
+    tl = OD_DCT_MLA_EPI32(tl, ta, 14449, 8192, 14); \
+    /* 2455/4096 ~= Tan[11*Pi/64] ~= 0.5993769336819237 */ \
+    ta = OD_DCT_MLS_EPI32(ta, tl, 2455, 2048, 12); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, tq, 11725, 16384, 15); \
+    /* 5197/8192 ~= Sin[7*Pi/32] ~= 0.6343932841636455 */ \
+    tq = OD_DCT_MLA_EPI32(tq, t5, 5197, 4096, 13); \
+    /* 11725/32768 ~= Tan[7*Pi/64] ~= 0.3578057213145241 */ \
+    t5 = OD_DCT_MLS_EPI32(t5, tq, 11725, 16384, 15); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    t2 = OD_DCT_MLS_EPI32(t2, tt, 805, 8192, 14); \
+    /* 803/8192 ~= Sin[Pi/32] ~= 0.0980171403295606 */ \
+    tt = OD_DCT_MLA_EPI32(tt, t2, 803, 4096, 13); \
+    /* 805/16384 ~= Tan[Pi/64] ~= 0.04912684976946793 */ \
+    t2 = OD_DCT_MLS_EPI32(t2, tt, 805, 8192, 14); \
+    \
+    tl = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tl); \
+    ti = od_mm256_sub_epi32(od_mm256_set1_epi32(0), ti); \
+    \
+    th = od_mm256_add_epi32(th, od_mm256_unbiased_rshift32(t9, 1)); \
+    t9 = od_mm256_sub_epi32(t9, th); \
+    te = od_mm256_sub_epi32(te, od_mm256_unbiased_rshift32(tm, 1)); \
+    tm = od_mm256_add_epi32(tm, te); \
+    t1 = od_mm256_add_epi32(t1, od_mm256_unbiased_rshift32(tp, 1)); \
+    tp = od_mm256_sub_epi32(tp, t1); \
+    tu = od_mm256_sub_epi32(tu, od_mm256_unbiased_rshift32(t6, 1)); \
+    t6 = od_mm256_add_epi32(t6, tu); \
+    ta = od_mm256_sub_epi32(ta, od_mm256_unbiased_rshift32(td, 1)); \
+    td = od_mm256_add_epi32(td, ta); \
+    tl = od_mm256_add_epi32(tl, od_mm256_unbiased_rshift32(ti, 1)); \
+    ti = od_mm256_sub_epi32(ti, tl); \
+    t5 = od_mm256_add_epi32(t5, od_mm256_unbiased_rshift32(tt, 1)); \
+    tt = od_mm256_sub_epi32(tt, t5); \
+    tq = od_mm256_add_epi32(tq, od_mm256_unbiased_rshift32(t2, 1)); \
+    t2 = od_mm256_sub_epi32(t2, tq); \
+    \
+    t8 = od_mm256_sub_epi32(t8, tgh); \
+    tg = od_mm256_add_epi32(tg, t8); \
+    tn = od_mm256_add_epi32(tn, tfh); \
+    tf = od_mm256_sub_epi32(tf, tn); \
+    t7 = od_mm256_sub_epi32(t7, tvh); \
+    tv = od_mm256_add_epi32(tv, t7); \
+    to = od_mm256_sub_epi32(to, t0h); \
+    t0 = od_mm256_add_epi32(t0, to); \
+    tc = od_mm256_add_epi32(tc, tbh); \
+    tb = od_mm256_sub_epi32(tb, tc); \
+    tj = od_mm256_add_epi32(tj, tkh); \
+    tk = od_mm256_sub_epi32(tk, tj); \
+    ts = od_mm256_add_epi32(ts, t4h); \
+    t4 = od_mm256_sub_epi32(t4, ts); \
+    t3 = od_mm256_add_epi32(t3, trh); \
+    tr = od_mm256_sub_epi32(tr, t3); \
+    \
+    tk = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tk); \
+    \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    tc = OD_DCT_MLS_EPI32(tc, tj, 2485, 4096, 13); \
+    /* 18205/32768 ~= Sin[3*Pi/16] ~= 0.555570233019602 */ \
+    tj = OD_DCT_MLA_EPI32(tj, tc, 18205, 16384, 15); \
+    /* 2485/8192 ~= Tan[3*Pi/32] ~= 0.303346683607342 */ \
+    tc = OD_DCT_MLS_EPI32(tc, tj, 2485, 4096, 13); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    ts = OD_DCT_MLS_EPI32(ts, t3, 3227, 16384, 15); \
+    /* 6393/32768 ~= Sin[Pi/16] ~= 0.19509032201612825 */ \
+    t3 = OD_DCT_MLA_EPI32(t3, ts, 6393, 16384, 15); \
+    /* 3227/32768 ~= Tan[Pi/32] ~= 0.09849140335716425 */ \
+    ts = OD_DCT_MLS_EPI32(ts, t3, 3227, 16384, 15); \
+    /* 17515/32768 ~= Tan[5*Pi/32] ~= 0.5345111359507916 */ \
+    tk = OD_DCT_MLS_EPI32(tk, tb, 17515, 16384, 15); \
+    /* 13623/16384 ~= Sin[5*Pi/16] ~= 0.8314696123025452 */ \
+    tb = OD_DCT_MLA_EPI32(tb, tk, 13623, 8192, 14); \
+    /* 17515/32768 ~= Tan[5*Pi/32] ~= 0.5345111359507916 */ \
+    tk = OD_DCT_MLS_EPI32(tk, tb, 17515, 16384, 15); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.8206787908286602 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, tr, 6723, 4096, 13); \
+    /* 16069/16384 ~= Sin[7*Pi/16] ~= 0.9807852804032304 */ \
+    tr = OD_DCT_MLA_EPI32(tr, t4, 16069, 8192, 14); \
+    /* 6723/8192 ~= Tan[7*Pi/32] ~= 0.8206787908286602 */ \
+    t4 = OD_DCT_MLS_EPI32(t4, tr, 6723, 4096, 13); \
+    \
+    t4 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t4); \
+    \
+    tp = od_mm256_add_epi32(tp, tm); \
+    tm = od_mm256_sub_epi32(tm, od_mm256_unbiased_rshift32(tp, 1)); \
+    t9 = od_mm256_sub_epi32(t9, t6); \
+    t6 = od_mm256_add_epi32(t6, od_mm256_unbiased_rshift32(t9, 1)); \
+    th = od_mm256_sub_epi32(th, t1); \
+    t1 = od_mm256_add_epi32(t1, od_mm256_unbiased_rshift32(th, 1)); \
+    tu = od_mm256_sub_epi32(tu, te); \
+    te = od_mm256_add_epi32(te, od_mm256_unbiased_rshift32(tu, 1)); /* pass */ \
+    t5 = od_mm256_sub_epi32(t5, tl); \
+    tl = od_mm256_add_epi32(tl, od_mm256_unbiased_rshift32(t5, 1)); \
+    ta = od_mm256_add_epi32(ta, tq); \
+    tq = od_mm256_sub_epi32(tq, od_mm256_unbiased_rshift32(ta, 1)); \
+    td = od_mm256_add_epi32(td, tt); \
+    tt = od_mm256_sub_epi32(tt, od_mm256_unbiased_rshift32(td, 1)); \
+    t2 = od_mm256_sub_epi32(t2, ti); \
+    ti = od_mm256_add_epi32(ti, od_mm256_unbiased_rshift32(t2, 1)); /* pass */ \
+    t7 = od_mm256_add_epi32(t7, t8); \
+    t8 = od_mm256_sub_epi32(t8, od_mm256_unbiased_rshift32(t7, 1)); \
+    tn = od_mm256_sub_epi32(tn, to); \
+    to = od_mm256_add_epi32(to, od_mm256_unbiased_rshift32(tn, 1)); \
+    tf = od_mm256_sub_epi32(tf, tv); \
+    tv = od_mm256_add_epi32(tv, od_mm256_unbiased_rshift32(tf, 1)); \
+    t0 = od_mm256_add_epi32(t0, tg); \
+    tg = od_mm256_sub_epi32(tg, od_mm256_unbiased_rshift32(t0, 1)); /* pass */ \
+    tj = od_mm256_sub_epi32(tj, t3); \
+    t3 = od_mm256_add_epi32(t3, od_mm256_unbiased_rshift32(tj, 1)); /* pass */ \
+    ts = od_mm256_sub_epi32(ts, tc); \
+    tc = od_mm256_add_epi32(tc, od_mm256_unbiased_rshift32(ts, 1)); \
+    t4 = od_mm256_sub_epi32(t4, tb); \
+    tb = od_mm256_add_epi32(tb, od_mm256_unbiased_rshift32(t4, 1)); /* pass */ \
+    tk = od_mm256_sub_epi32(tk, tr); \
+    tr = od_mm256_add_epi32(tr, od_mm256_unbiased_rshift32(tk, 1)); \
+    \
+    t1 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t1); \
+    t3 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t3); \
+    t7 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t7); \
+    t8 = od_mm256_sub_epi32(od_mm256_set1_epi32(0), t8); \
+    tg = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tg); \
+    tm = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tm); \
+    to = od_mm256_sub_epi32(od_mm256_set1_epi32(0), to); \
+    \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 14341, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t9 = OD_DCT_MLA_EPI32(t9, tm, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    tm = OD_DCT_MLS_EPI32(tm, t9, 4161, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    tp = OD_DCT_MLS_EPI32(tp, t6, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t6 = OD_DCT_MLA_EPI32(t6, tp, 15137, 8192, 14); \
+    /* 28681/32768 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    tp = OD_DCT_MLS_EPI32(tp, t6, 28681, 16384, 15); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    th = OD_DCT_MLA_EPI32(th, te, 19195, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    te = OD_DCT_MLA_EPI32(te, th, 11585, 8192, 14); \
+    /* 29957/32768 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    th = OD_DCT_MLS_EPI32(th, te, 29957, 16384, 15); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    tq = OD_DCT_MLS_EPI32(tq, t5, 14341, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t5 = OD_DCT_MLA_EPI32(t5, tq, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    tq = OD_DCT_MLS_EPI32(tq, t5, 4161, 8192, 14); \
+    /* 3259/8192 ~= 2*Tan[Pi/16] ~= 0.397824734759316 */ \
+    ta = OD_DCT_MLS_EPI32(ta, tl, 3259, 4096, 13); \
+    /* 3135/16384 ~= Sin[Pi/8]/2 ~= 0.1913417161825449 */ \
+    tl = OD_DCT_MLA_EPI32(tl, ta, 3135, 8192, 14); \
+    /* 3259/8192 ~= 2*Tan[Pi/16] ~= 0.397824734759316 */ \
+    ta = OD_DCT_MLS_EPI32(ta, tl, 3259, 4096, 13); \
+    /* 7489/8192 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    ti = OD_DCT_MLS_EPI32(ti, td, 7489, 4096, 13); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    td = OD_DCT_MLA_EPI32(td, ti, 11585, 8192, 14); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    ti = OD_DCT_MLA_EPI32(ti, td, 19195, 16384, 15); \
+    /* 14341/16384 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    to = OD_DCT_MLS_EPI32(to, t7, 14341, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t7 = OD_DCT_MLA_EPI32(t7, to, 15137, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    to = OD_DCT_MLS_EPI32(to, t7, 4161, 8192, 14); \
+    /* 4161/16384 ~= Tan[3*Pi/16] - Tan[Pi/8] ~= 0.253965075546204 */ \
+    tn = OD_DCT_MLS_EPI32(tn, t8, 4161, 8192, 14); \
+    /* 15137/16384 ~= Sin[3*Pi/8] ~= 0.923879532511287 */ \
+    t8 = OD_DCT_MLA_EPI32(t8, tn, 15137, 8192, 14); \
+    /* 28681/32768 ~= Tan[3*Pi/16] + Tan[Pi/8]/2 ~= 0.875285419105846 */ \
+    tn = OD_DCT_MLS_EPI32(tn, t8, 28681, 16384, 15); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    tf = OD_DCT_MLA_EPI32(tf, tg, 19195, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    tg = OD_DCT_MLA_EPI32(tg, tf, 11585, 8192, 14); \
+    /* 29957/32768 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    tf = OD_DCT_MLS_EPI32(tf, tg, 29957, 16384, 15); \
+    /* -19195/32768 ~= Tan[Pi/8] - Tan[Pi/4] ~= -0.585786437626905 */ \
+    tj = OD_DCT_MLA_EPI32(tj, tc, 19195, 16384, 15); \
+    /* 11585/16384 ~= Sin[Pi/4] ~= 0.707106781186548 */ \
+    tc = OD_DCT_MLA_EPI32(tc, tj, 11585, 8192, 14); \
+    /* 29957/32768 ~= Tan[Pi/8] + Tan[Pi/4]/2 ~= 0.914213562373095 */ \
+    tj = OD_DCT_MLS_EPI32(tj, tc, 29957, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    tk = OD_DCT_MLA_EPI32(tk, tb, 13573, 8192, 14); \
+    /* 11585/32768 ~= Sin[Pi/4]/2 ~= 0.353553390593274 */ \
+    tb = OD_DCT_MLS_EPI32(tb, tk, 11585, 16384, 15); \
+    /* 13573/16384 ~= 2*Tan[Pi/8] ~= 0.828427124746190 */ \
+    tk = OD_DCT_MLA_EPI32(tk, tb, 13573, 8192, 14); \
+    \
+    tf = od_mm256_sub_epi32(od_mm256_set1_epi32(0), tf); \
+    \
+  } \
+  while (0)
+
+#define OD_MM256_FDCT_64(u0, uw, ug, uM, u8, uE, uo, uU, u4, uA, uk, uQ, uc, uI, \
+ us, uY, u2, uy, ui, uO, ua, uG, uq, uW, u6, uC, um, uS, ue, uK, uu, u_, u1, \
+ ux, uh, uN, u9, uF, up, uV, u5, uB, ul, uR, ud, uJ, ut, uZ, u3, uz, uj, uP, \
+ ub, uH, ur, uX, u7, uD, un, uT, uf, uL, uv, u) \
+  /* Embedded 64-point orthonormal Type-II fDCT. */ \
+  do { \
+    od_m256i uwh; \
+    od_m256i uxh; \
+    od_m256i uyh; \
+    od_m256i uzh; \
+    od_m256i uAh; \
+    od_m256i uBh; \
+    od_m256i uCh; \
+    od_m256i uDh; \
+    od_m256i uEh; \
+    od_m256i uFh; \
+    od_m256i uGh; \
+    od_m256i uHh; \
+    od_m256i uIh; \
+    od_m256i uJh; \
+    od_m256i uKh; \
+    od_m256i uLh; \
+    od_m256i uMh; \
+    od_m256i uNh; \
+    od_m256i uOh; \
+    od_m256i uPh; \
+    od_m256i uQh; \
+    od_m256i uRh; \
+    od_m256i uSh; \
+    od_m256i uTh; \
+    od_m256i uUh; \
+    od_m256i uVh; \
+    od_m256i uWh; \
+    od_m256i uXh; \
+    od_m256i uYh; \
+    od_m256i uZh; \
+    od_m256i u_h; \
+    od_m256i uh_; \
+    u = od_mm256_sub_epi32(u0, u); \
+    uh_ = od_mm256_unbiased_rshift32(u, 1); \
+    u0 = od_mm256_sub_epi32(u0, uh_); \
+    u_ = od_mm256_add_epi32(u_, u1); \
+    u_h = od_mm256_unbiased_rshift32(u_, 1); \
+    u1 = od_mm256_sub_epi32(u_h, u1); \
+    uZ = od_mm256_sub_epi32(u2, uZ); \
+    uZh = od_mm256_unbiased_rshift32(uZ, 1); \
+    u2 = od_mm256_sub_epi32(u2, uZh); \
+    uY = od_mm256_add_epi32(uY, u3); \
+    uYh = od_mm256_unbiased_rshift32(uY, 1); \
+    u3 = od_mm256_sub_epi32(uYh, u3); \
+    uX = od_mm256_sub_epi32(u4, uX); \
+    uXh = od_mm256_unbiased_rshift32(uX, 1); \
+    u4 = od_mm256_sub_epi32(u4, uXh); \
+    uW = od_mm256_add_epi32(uW, u5); \
+    uWh = od_mm256_unbiased_rshift32(uW, 1); \
+    u5 = od_mm256_sub_epi32(uWh, u5); \
+    uV = od_mm256_sub_epi32(u6, uV); \
+    uVh = od_mm256_unbiased_rshift32(uV, 1); \
+    u6 = od_mm256_sub_epi32(u6, uVh); \
+    uU = od_mm256_add_epi32(uU, u7); \
+    uUh = od_mm256_unbiased_rshift32(uU, 1); \
+    u7 = od_mm256_sub_epi32(uUh, u7); \
+    uT = od_mm256_sub_epi32(u8, uT); \
+    uTh = od_mm256_unbiased_rshift32(uT, 1); \
+    u8 = od_mm256_sub_epi32(u8, uTh); \
+    uS = od_mm256_add_epi32(uS, u9); \
+    uSh = od_mm256_unbiased_rshift32(uS, 1); \
+    u9 = od_mm256_sub_epi32(uSh, u9); \
+    uR = od_mm256_sub_epi32(ua, uR); \
+    uRh = od_mm256_unbiased_rshift32(uR, 1); \
+    ua = od_mm256_sub_epi32(ua, uRh); \
+    uQ = od_mm256_add_epi32(uQ, ub); \
+    uQh = od_mm256_unbiased_rshift32(uQ, 1); \
+    ub = od_mm256_sub_epi32(uQh, ub); \
+    uP = od_mm256_sub_epi32(uc, uP); \
+    uPh = od_mm256_unbiased_rshift32(uP, 1); \
+    uc = od_mm256_sub_epi32(uc, uPh); \
+    uO = od_mm256_add_epi32(uO, ud); \
+    uOh = od_mm256_unbiased_rshift32(uO, 1); \
+    ud = od_mm256_sub_epi32(uOh, ud); \
+    uN = od_mm256_sub_epi32(ue, uN); \
+    uNh = od_mm256_unbiased_rshift32(uN, 1); \
+    ue = od_mm256_sub_epi32(ue, uNh); \
+    uM = od_mm256_add_epi32(uM, uf); \
+    uMh = od_mm256_unbiased_rshift32(uM, 1); \
+    uf = od_mm256_sub_epi32(uMh, uf); \
+    uL = od_mm256_sub_epi32(ug, uL); \
+    uLh = od_mm256_unbiased_rshift32(uL, 1); \
+    ug = od_mm256_sub_epi32(ug, uLh); \
+    uK = od_mm256_add_epi32(uK, uh); \
+    uKh = od_mm256_unbiased_rshift32(uK, 1); \
+    uh = od_mm256_sub_epi32(uKh, uh); \
+    uJ = od_mm256_sub_epi32(ui, uJ); \
+    uJh = od_mm256_unbiased_rshift32(uJ, 1); \
+    ui = od_mm256_sub_epi32(ui, uJh); \
+    uI = od_mm256_add_epi32(uI, uj); \
+    uIh = od_mm256_unbiased_rshift32(uI, 1); \
+    uj = od_mm256_sub_epi32(uIh, uj); \
+    uH = od_mm256_sub_epi32(uk, uH); \
+    uHh = od_mm256_unbiased_rshift32(uH, 1); \
+    uk = od_mm256_sub_epi32(uk, uHh); \
+    uG = od_mm256_add_epi32(uG, ul); \
+    uGh = od_mm256_unbiased_rshift32(uG, 1); \
+    ul = od_mm256_sub_epi32(uGh, ul); \
+    uF = od_mm256_sub_epi32(um, uF); \
+    uFh = od_mm256_unbiased_rshift32(uF, 1); \
+    um = od_mm256_sub_epi32(um, uFh); \
+    uE = od_mm256_add_epi32(uE, un); \
+    uEh = od_mm256_unbiased_rshift32(uE, 1); \
+    un = od_mm256_sub_epi32(uEh, un); \
+    uD = od_mm256_sub_epi32(uo, uD); \
+    uDh = od_mm256_unbiased_rshift32(uD, 1); \
+    uo = od_mm256_sub_epi32(uo, uDh); \
+    uC = od_mm256_add_epi32(uC, up); \
+    uCh = od_mm256_unbiased_rshift32(uC, 1); \
+    up = od_mm256_sub_epi32(uCh, up); \
+    uB = od_mm256_sub_epi32(uq, uB); \
+    uBh = od_mm256_unbiased_rshift32(uB, 1); \
+    uq = od_mm256_sub_epi32(uq, uBh); \
+    uA = od_mm256_add_epi32(uA, ur); \
+    uAh = od_mm256_unbiased_rshift32(uA, 1); \
+    ur = od_mm256_sub_epi32(uAh, ur); \
+    uz = od_mm256_sub_epi32(us, uz); \
+    uzh = od_mm256_unbiased_rshift32(uz, 1); \
+    us = od_mm256_sub_epi32(us, uzh); \
+    uy = od_mm256_add_epi32(uy, ut); \
+    uyh = od_mm256_unbiased_rshift32(uy, 1); \
+    ut = od_mm256_sub_epi32(uyh, ut); \
+    ux = od_mm256_sub_epi32(uu, ux); \
+    uxh = od_mm256_unbiased_rshift32(ux, 1); \
+    uu = od_mm256_sub_epi32(uu, uxh); \
+    uw = od_mm256_add_epi32(uw, uv); \
+    uwh = od_mm256_unbiased_rshift32(uw, 1); \
+    uv = od_mm256_sub_epi32(uwh, uv); \
+    OD_MM256_FDCT_32_ASYM(u0, uw, uwh, ug, uM, uMh, u8, uE, uEh, uo, uU, uUh, \
+     u4, uA, uAh, uk, uQ, uQh, uc, uI, uIh, us, uY, uYh, u2, uy, uyh, \
+     ui, uO, uOh, ua, uG, uGh, uq, uW, uWh, u6, uC, uCh, um, uS, uSh, \
+     ue, uK, uKh, uu, u_, u_h); \
+    OD_MM256_FDST_32_ASYM(u, uv, uL, uf, uT, un, uD, u7, uX, ur, uH, ub, uP, uj, \
+     uz, u3, uZ, ut, uJ, ud, uR, ul, uB, u5, uV, up, uF, u9, uN, uh, ux, u1); \
+  } \
+  while (0)
+
+#define OD_MM256_IDCT_64(u0, uw, ug, uM, u8, uE, uo, uU, u4, uA, uk, uQ, uc, uI, \
+ us, uY, u2, uy, ui, uO, ua, uG, uq, uW, u6, uC, um, uS, ue, uK, uu, u_, u1, \
+ ux, uh, uN, u9, uF, up, uV, u5, uB, ul, uR, ud, uJ, ut, uZ, u3, uz, uj, uP, \
+ ub, uH, ur, uX, u7, uD, un, uT, uf, uL, uv, u) \
+  /* Embedded 64-point orthonormal Type-II fDCT. */ \
+  do { \
+    od_m256i u1h; \
+    od_m256i u3h; \
+    od_m256i u5h; \
+    od_m256i u7h; \
+    od_m256i u9h; \
+    od_m256i ubh; \
+    od_m256i udh; \
+    od_m256i ufh; \
+    od_m256i uhh; \
+    od_m256i ujh; \
+    od_m256i ulh; \
+    od_m256i unh; \
+    od_m256i uph; \
+    od_m256i urh; \
+    od_m256i uth; \
+    od_m256i uvh; \
+    od_m256i uxh; \
+    od_m256i uzh; \
+    od_m256i uBh; \
+    od_m256i uDh; \
+    od_m256i uFh; \
+    od_m256i uHh; \
+    od_m256i uJh; \
+    od_m256i uLh; \
+    od_m256i uNh; \
+    od_m256i uPh; \
+    od_m256i uRh; \
+    od_m256i uTh; \
+    od_m256i uVh; \
+    od_m256i uXh; \
+    od_m256i uZh; \
+    od_m256i uh_; \
+    OD_MM256_IDST_32_ASYM(u, uL, uT, uD, uX, uH, uP, uz, uZ, uJ, uR, uB, uV, uF, \
+     uN, ux, u_, uK, uS, uC, uW, uG, uO, uy, uY, uI, uQ, uA, uU, uE, uM, uw); \
+    OD_MM256_IDCT_32_ASYM(u0, ug, u8, uo, u4, uk, uc, us, u2, ui, ua, uq, u6, um, \
+     ue, uu, u1, u1h, uh, uhh, u9, u9h, up, uph, u5, u5h, ul, ulh, ud, udh, \
+     ut, uth, u3, u3h, uj, ujh, ub, ubh, ur, urh, u7, u7h, un, unh, uf, ufh, \
+     uv, uvh); \
+    uh_ = od_mm256_unbiased_rshift32(u, 1); \
+    u0 = od_mm256_add_epi32(u0, uh_); \
+    u = od_mm256_sub_epi32(u0, u); \
+    u_ = od_mm256_sub_epi32(u1h, u_); \
+    u1 = od_mm256_sub_epi32(u1, u_); \
+    uZh = od_mm256_unbiased_rshift32(uZ, 1); \
+    u2 = od_mm256_add_epi32(u2, uZh); \
+    uZ = od_mm256_sub_epi32(u2, uZ); \
+    uY = od_mm256_sub_epi32(u3h, uY); \
+    u3 = od_mm256_sub_epi32(u3, uY); \
+    uXh = od_mm256_unbiased_rshift32(uX, 1); \
+    u4 = od_mm256_add_epi32(u4, uXh); \
+    uX = od_mm256_sub_epi32(u4, uX); \
+    uW = od_mm256_sub_epi32(u5h, uW); \
+    u5 = od_mm256_sub_epi32(u5, uW); \
+    uVh = od_mm256_unbiased_rshift32(uV, 1); \
+    u6 = od_mm256_add_epi32(u6, uVh); \
+    uV = od_mm256_sub_epi32(u6, uV); \
+    uU = od_mm256_sub_epi32(u7h, uU); \
+    u7 = od_mm256_sub_epi32(u7, uU); \
+    uTh = od_mm256_unbiased_rshift32(uT, 1); \
+    u8 = od_mm256_add_epi32(u8, uTh); \
+    uT = od_mm256_sub_epi32(u8, uT); \
+    uS = od_mm256_sub_epi32(u9h, uS); \
+    u9 = od_mm256_sub_epi32(u9, uS); \
+    uRh = od_mm256_unbiased_rshift32(uR, 1); \
+    ua = od_mm256_add_epi32(ua, uRh); \
+    uR = od_mm256_sub_epi32(ua, uR); \
+    uQ = od_mm256_sub_epi32(ubh, uQ); \
+    ub = od_mm256_sub_epi32(ub, uQ); \
+    uPh = od_mm256_unbiased_rshift32(uP, 1); \
+    uc = od_mm256_add_epi32(uc, uPh); \
+    uP = od_mm256_sub_epi32(uc, uP); \
+    uO = od_mm256_sub_epi32(udh, uO); \
+    ud = od_mm256_sub_epi32(ud, uO); \
+    uNh = od_mm256_unbiased_rshift32(uN, 1); \
+    ue = od_mm256_add_epi32(ue, uNh); \
+    uN = od_mm256_sub_epi32(ue, uN); \
+    uM = od_mm256_sub_epi32(ufh, uM); \
+    uf = od_mm256_sub_epi32(uf, uM); \
+    uLh = od_mm256_unbiased_rshift32(uL, 1); \
+    ug = od_mm256_add_epi32(ug, uLh); \
+    uL = od_mm256_sub_epi32(ug, uL); \
+    uK = od_mm256_sub_epi32(uhh, uK); \
+    uh = od_mm256_sub_epi32(uh, uK); \
+    uJh = od_mm256_unbiased_rshift32(uJ, 1); \
+    ui = od_mm256_add_epi32(ui, uJh); \
+    uJ = od_mm256_sub_epi32(ui, uJ); \
+    uI = od_mm256_sub_epi32(ujh, uI); \
+    uj = od_mm256_sub_epi32(uj, uI); \
+    uHh = od_mm256_unbiased_rshift32(uH, 1); \
+    uk = od_mm256_add_epi32(uk, uHh); \
+    uH = od_mm256_sub_epi32(uk, uH); \
+    uG = od_mm256_sub_epi32(ulh, uG); \
+    ul = od_mm256_sub_epi32(ul, uG); \
+    uFh = od_mm256_unbiased_rshift32(uF, 1); \
+    um = od_mm256_add_epi32(um, uFh); \
+    uF = od_mm256_sub_epi32(um, uF); \
+    uE = od_mm256_sub_epi32(unh, uE); \
+    un = od_mm256_sub_epi32(un, uE); \
+    uDh = od_mm256_unbiased_rshift32(uD, 1); \
+    uo = od_mm256_add_epi32(uo, uDh); \
+    uD = od_mm256_sub_epi32(uo, uD); \
+    uC = od_mm256_sub_epi32(uph, uC); \
+    up = od_mm256_sub_epi32(up, uC); \
+    uBh = od_mm256_unbiased_rshift32(uB, 1); \
+    uq = od_mm256_add_epi32(uq, uBh); \
+    uB = od_mm256_sub_epi32(uq, uB); \
+    uA = od_mm256_sub_epi32(urh, uA); \
+    ur = od_mm256_sub_epi32(ur, uA); \
+    uzh = od_mm256_unbiased_rshift32(uz, 1); \
+    us = od_mm256_add_epi32(us, uzh); \
+    uz = od_mm256_sub_epi32(us, uz); \
+    uy = od_mm256_sub_epi32(uth, uy); \
+    ut = od_mm256_sub_epi32(ut, uy); \
+    uxh = od_mm256_unbiased_rshift32(ux, 1); \
+    uu = od_mm256_add_epi32(uu, uxh); \
+    ux = od_mm256_sub_epi32(uu, ux); \
+    uw = od_mm256_sub_epi32(uvh, uw); \
+    uv = od_mm256_sub_epi32(uv, uw); \
+  } while (0)
+
+static void fdct32_kernel(od_m256i y[32], const od_m256i x[32]) {
+  /*215 adds, 38 shifts, 87 "muls".*/
+  od_m256i t0;
+  od_m256i t1;
+  od_m256i t2;
+  od_m256i t3;
+  od_m256i t4;
+  od_m256i t5;
+  od_m256i t6;
+  od_m256i t7;
+  od_m256i t8;
+  od_m256i t9;
+  od_m256i ta;
+  od_m256i tb;
+  od_m256i tc;
+  od_m256i td;
+  od_m256i te;
+  od_m256i tf;
+  od_m256i tg;
+  od_m256i th;
+  od_m256i ti;
+  od_m256i tj;
+  od_m256i tk;
+  od_m256i tl;
+  od_m256i tm;
+  od_m256i tn;
+  od_m256i to;
+  od_m256i tp;
+  od_m256i tq;
+  od_m256i tr;
+  od_m256i ts;
+  od_m256i tt;
+  od_m256i tu;
+  od_m256i tv;
+  t0 = x[0];
+  tg = x[1];
+  t8 = x[2];
+  to = x[3];
+  t4 = x[4];
+  tk = x[5];
+  tc = x[6];
+  ts = x[7];
+  t2 = x[8];
+  ti = x[9];
+  ta = x[10];
+  tq = x[11];
+  t6 = x[12];
+  tm = x[13];
+  te = x[14];
+  tu = x[15];
+  t1 = x[16];
+  th = x[17];
+  t9 = x[18];
+  tp = x[19];
+  t5 = x[20];
+  tl = x[21];
+  td = x[22];
+  tt = x[23];
+  t3 = x[24];
+  tj = x[25];
+  tb = x[26];
+  tr = x[27];
+  t7 = x[28];
+  tn = x[29];
+  tf = x[30];
+  tv = x[31];
+  OD_MM256_FDCT_32(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, t6, tm, te, tu,
+   t1, th, t9, tp, t5, tl, td, tt, t3, tj, tb, tr, t7, tn, tf, tv);
+  y[0] = t0;
+  y[1] = t1;
+  y[2] = t2;
+  y[3] = t3;
+  y[4] = t4;
+  y[5] = t5;
+  y[6] = t6;
+  y[7] = t7;
+  y[8] = t8;
+  y[9] = t9;
+  y[10] = ta;
+  y[11] = tb;
+  y[12] = tc;
+  y[13] = td;
+  y[14] = te;
+  y[15] = tf;
+  y[16] = tg;
+  y[17] = th;
+  y[18] = ti;
+  y[19] = tj;
+  y[20] = tk;
+  y[21] = tl;
+  y[22] = tm;
+  y[23] = tn;
+  y[24] = to;
+  y[25] = tp;
+  y[26] = tq;
+  y[27] = tr;
+  y[28] = ts;
+  y[29] = tt;
+  y[30] = tu;
+  y[31] = tv;
+}
+
+static void idct32_kernel(od_m256i x[32], const od_m256i y[32]) {
+  od_m256i t0;
+  od_m256i t1;
+  od_m256i t2;
+  od_m256i t3;
+  od_m256i t4;
+  od_m256i t5;
+  od_m256i t6;
+  od_m256i t7;
+  od_m256i t8;
+  od_m256i t9;
+  od_m256i ta;
+  od_m256i tb;
+  od_m256i tc;
+  od_m256i td;
+  od_m256i te;
+  od_m256i tf;
+  od_m256i tg;
+  od_m256i th;
+  od_m256i ti;
+  od_m256i tj;
+  od_m256i tk;
+  od_m256i tl;
+  od_m256i tm;
+  od_m256i tn;
+  od_m256i to;
+  od_m256i tp;
+  od_m256i tq;
+  od_m256i tr;
+  od_m256i ts;
+  od_m256i tt;
+  od_m256i tu;
+  od_m256i tv;
+  t0 = y[0];
+  tg = y[1];
+  t8 = y[2];
+  to = y[3];
+  t4 = y[4];
+  tk = y[5];
+  tc = y[6];
+  ts = y[7];
+  t2 = y[8];
+  ti = y[9];
+  ta = y[10];
+  tq = y[11];
+  t6 = y[12];
+  tm = y[13];
+  te = y[14];
+  tu = y[15];
+  t1 = y[16];
+  th = y[17];
+  t9 = y[18];
+  tp = y[19];
+  t5 = y[20];
+  tl = y[21];
+  td = y[22];
+  tt = y[23];
+  t3 = y[24];
+  tj = y[25];
+  tb = y[26];
+  tr = y[27];
+  t7 = y[28];
+  tn = y[29];
+  tf = y[30];
+  tv = y[31];
+  OD_MM256_IDCT_32(t0, tg, t8, to, t4, tk, tc, ts, t2, ti, ta, tq, t6, tm, te, tu,
+   t1, th, t9, tp, t5, tl, td, tt, t3, tj, tb, tr, t7, tn, tf, tv);
+  x[0] = t0;
+  x[1] = t1;
+  x[2] = t2;
+  x[3] = t3;
+  x[4] = t4;
+  x[5] = t5;
+  x[6] = t6;
+  x[7] = t7;
+  x[8] = t8;
+  x[9] = t9;
+  x[10] = ta;
+  x[11] = tb;
+  x[12] = tc;
+  x[13] = td;
+  x[14] = te;
+  x[15] = tf;
+  x[16] = tg;
+  x[17] = th;
+  x[18] = ti;
+  x[19] = tj;
+  x[20] = tk;
+  x[21] = tl;
+  x[22] = tm;
+  x[23] = tn;
+  x[24] = to;
+  x[25] = tp;
+  x[26] = tq;
+  x[27] = tr;
+  x[28] = ts;
+  x[29] = tt;
+  x[30] = tu;
+  x[31] = tv;
+}
+
+static void fdct64_kernel(od_m256i y[64], const od_m256i x[64]) {
+  od_m256i t0;
+  od_m256i t1;
+  od_m256i t2;
+  od_m256i t3;
+  od_m256i t4;
+  od_m256i t5;
+  od_m256i t6;
+  od_m256i t7;
+  od_m256i t8;
+  od_m256i t9;
+  od_m256i ta;
+  od_m256i tb;
+  od_m256i tc;
+  od_m256i td;
+  od_m256i te;
+  od_m256i tf;
+  od_m256i tg;
+  od_m256i th;
+  od_m256i ti;
+  od_m256i tj;
+  od_m256i tk;
+  od_m256i tl;
+  od_m256i tm;
+  od_m256i tn;
+  od_m256i to;
+  od_m256i tp;
+  od_m256i tq;
+  od_m256i tr;
+  od_m256i ts;
+  od_m256i tt;
+  od_m256i tu;
+  od_m256i tv;
+  od_m256i tw;
+  od_m256i tx;
+  od_m256i ty;
+  od_m256i tz;
+  od_m256i tA;
+  od_m256i tB;
+  od_m256i tC;
+  od_m256i tD;
+  od_m256i tE;
+  od_m256i tF;
+  od_m256i tG;
+  od_m256i tH;
+  od_m256i tI;
+  od_m256i tJ;
+  od_m256i tK;
+  od_m256i tL;
+  od_m256i tM;
+  od_m256i tN;
+  od_m256i tO;
+  od_m256i tP;
+  od_m256i tQ;
+  od_m256i tR;
+  od_m256i tS;
+  od_m256i tT;
+  od_m256i tU;
+  od_m256i tV;
+  od_m256i tW;
+  od_m256i tX;
+  od_m256i tY;
+  od_m256i tZ;
+  od_m256i t_;
+  od_m256i t;
+  t0 = x[0];
+  tw = x[1];
+  tg = x[2];
+  tM = x[3];
+  t8 = x[4];
+  tE = x[5];
+  to = x[6];
+  tU = x[7];
+  t4 = x[8];
+  tA = x[9];
+  tk = x[10];
+  tQ = x[11];
+  tc = x[12];
+  tI = x[13];
+  ts = x[14];
+  tY = x[15];
+  t2 = x[16];
+  ty = x[17];
+  ti = x[18];
+  tO = x[19];
+  ta = x[20];
+  tG = x[21];
+  tq = x[22];
+  tW = x[23];
+  t6 = x[24];
+  tC = x[25];
+  tm = x[26];
+  tS = x[27];
+  te = x[28];
+  tK = x[29];
+  tu = x[30];
+  t_ = x[31];
+  t1 = x[32];
+  tx = x[33];
+  th = x[34];
+  tN = x[35];
+  t9 = x[36];
+  tF = x[37];
+  tp = x[38];
+  tV = x[39];
+  t5 = x[40];
+  tB = x[41];
+  tl = x[42];
+  tR = x[43];
+  td = x[44];
+  tJ = x[45];
+  tt = x[46];
+  tZ = x[47];
+  t3 = x[48];
+  tz = x[49];
+  tj = x[50];
+  tP = x[51];
+  tb = x[52];
+  tH = x[53];
+  tr = x[54];
+  tX = x[55];
+  t7 = x[56];
+  tD = x[57];
+  tn = x[58];
+  tT = x[59];
+  tf = x[60];
+  tL = x[61];
+  tv = x[62];
+  t = x[63];
+  OD_MM256_FDCT_64(t0, tw, tg, tM, t8, tE, to, tU, t4, tA, tk, tQ, tc, tI, ts, tY,
+   t2, ty, ti, tO, ta, tG, tq, tW, t6, tC, tm, tS, te, tK, tu, t_, t1, tx,
+   th, tN, t9, tF, tp, tV, t5, tB, tl, tR, td, tJ, tt, tZ, t3, tz, tj, tP,
+   tb, tH, tr, tX, t7, tD, tn, tT, tf, tL, tv, t);
+  y[0] = t0;
+  y[1] = t1;
+  y[2] = t2;
+  y[3] = t3;
+  y[4] = t4;
+  y[5] = t5;
+  y[6] = t6;
+  y[7] = t7;
+  y[8] = t8;
+  y[9] = t9;
+  y[10] = ta;
+  y[11] = tb;
+  y[12] = tc;
+  y[13] = td;
+  y[14] = te;
+  y[15] = tf;
+  y[16] = tg;
+  y[17] = th;
+  y[18] = ti;
+  y[19] = tj;
+  y[20] = tk;
+  y[21] = tl;
+  y[22] = tm;
+  y[23] = tn;
+  y[24] = to;
+  y[25] = tp;
+  y[26] = tq;
+  y[27] = tr;
+  y[28] = ts;
+  y[29] = tt;
+  y[30] = tu;
+  y[31] = tv;
+  y[32] = tw;
+  y[33] = tx;
+  y[34] = ty;
+  y[35] = tz;
+  y[36] = tA;
+  y[37] = tB;
+  y[38] = tC;
+  y[39] = tD;
+  y[40] = tE;
+  y[41] = tF;
+  y[41] = tF;
+  y[42] = tG;
+  y[43] = tH;
+  y[44] = tI;
+  y[45] = tJ;
+  y[46] = tK;
+  y[47] = tL;
+  y[48] = tM;
+  y[49] = tN;
+  y[50] = tO;
+  y[51] = tP;
+  y[52] = tQ;
+  y[53] = tR;
+  y[54] = tS;
+  y[55] = tT;
+  y[56] = tU;
+  y[57] = tV;
+  y[58] = tW;
+  y[59] = tX;
+  y[60] = tY;
+  y[61] = tZ;
+  y[62] = t_;
+  y[63] = t;
+}
+
+static void idct64_kernel(od_m256i x[64], const od_m256i y[64]) {
+  od_m256i t0;
+  od_m256i t1;
+  od_m256i t2;
+  od_m256i t3;
+  od_m256i t4;
+  od_m256i t5;
+  od_m256i t6;
+  od_m256i t7;
+  od_m256i t8;
+  od_m256i t9;
+  od_m256i ta;
+  od_m256i tb;
+  od_m256i tc;
+  od_m256i td;
+  od_m256i te;
+  od_m256i tf;
+  od_m256i tg;
+  od_m256i th;
+  od_m256i ti;
+  od_m256i tj;
+  od_m256i tk;
+  od_m256i tl;
+  od_m256i tm;
+  od_m256i tn;
+  od_m256i to;
+  od_m256i tp;
+  od_m256i tq;
+  od_m256i tr;
+  od_m256i ts;
+  od_m256i tt;
+  od_m256i tu;
+  od_m256i tv;
+  od_m256i tw;
+  od_m256i tx;
+  od_m256i ty;
+  od_m256i tz;
+  od_m256i tA;
+  od_m256i tB;
+  od_m256i tC;
+  od_m256i tD;
+  od_m256i tE;
+  od_m256i tF;
+  od_m256i tG;
+  od_m256i tH;
+  od_m256i tI;
+  od_m256i tJ;
+  od_m256i tK;
+  od_m256i tL;
+  od_m256i tM;
+  od_m256i tN;
+  od_m256i tO;
+  od_m256i tP;
+  od_m256i tQ;
+  od_m256i tR;
+  od_m256i tS;
+  od_m256i tT;
+  od_m256i tU;
+  od_m256i tV;
+  od_m256i tW;
+  od_m256i tX;
+  od_m256i tY;
+  od_m256i tZ;
+  od_m256i t_;
+  od_m256i t;
+  t0 = y[0];
+  tw = y[1];
+  tg = y[2];
+  tM = y[3];
+  t8 = y[4];
+  tE = y[5];
+  to = y[6];
+  tU = y[7];
+  t4 = y[8];
+  tA = y[9];
+  tk = y[10];
+  tQ = y[11];
+  tc = y[12];
+  tI = y[13];
+  ts = y[14];
+  tY = y[15];
+  t2 = y[16];
+  ty = y[17];
+  ti = y[18];
+  tO = y[19];
+  ta = y[20];
+  tG = y[21];
+  tq = y[22];
+  tW = y[23];
+  t6 = y[24];
+  tC = y[25];
+  tm = y[26];
+  tS = y[27];
+  te = y[28];
+  tK = y[29];
+  tu = y[30];
+  t_ = y[31];
+  t1 = y[32];
+  tx = y[33];
+  th = y[34];
+  tN = y[35];
+  t9 = y[36];
+  tF = y[37];
+  tp = y[38];
+  tV = y[39];
+  t5 = y[40];
+  tB = y[41];
+  tl = y[42];
+  tR = y[43];
+  td = y[44];
+  tJ = y[45];
+  tt = y[46];
+  tZ = y[47];
+  t3 = y[48];
+  tz = y[49];
+  tj = y[50];
+  tP = y[51];
+  tb = y[52];
+  tH = y[53];
+  tr = y[54];
+  tX = y[55];
+  t7 = y[56];
+  tD = y[57];
+  tn = y[58];
+  tT = y[59];
+  tf = y[60];
+  tL = y[61];
+  tv = y[62];
+  t = y[63];
+  OD_MM256_IDCT_64(t0, tw, tg, tM, t8, tE, to, tU, t4, tA, tk, tQ, tc, tI, ts, tY,
+   t2, ty, ti, tO, ta, tG, tq, tW, t6, tC, tm, tS, te, tK, tu, t_, t1, tx,
+   th, tN, t9, tF, tp, tV, t5, tB, tl, tR, td, tJ, tt, tZ, t3, tz, tj, tP,
+   tb, tH, tr, tX, t7, tD, tn, tT, tf, tL, tv, t);
+  x[0] = t0;
+  x[1] = t1;
+  x[2] = t2;
+  x[3] = t3;
+  x[4] = t4;
+  x[5] = t5;
+  x[6] = t6;
+  x[7] = t7;
+  x[8] = t8;
+  x[9] = t9;
+  x[10] = ta;
+  x[11] = tb;
+  x[12] = tc;
+  x[13] = td;
+  x[14] = te;
+  x[15] = tf;
+  x[16] = tg;
+  x[17] = th;
+  x[18] = ti;
+  x[19] = tj;
+  x[20] = tk;
+  x[21] = tl;
+  x[22] = tm;
+  x[23] = tn;
+  x[24] = to;
+  x[25] = tp;
+  x[26] = tq;
+  x[27] = tr;
+  x[28] = ts;
+  x[29] = tt;
+  x[30] = tu;
+  x[31] = tv;
+  x[32] = tw;
+  x[33] = tx;
+  x[34] = ty;
+  x[35] = tz;
+  x[36] = tA;
+  x[37] = tB;
+  x[38] = tC;
+  x[39] = tD;
+  x[40] = tE;
+  x[41] = tF;
+  x[42] = tG;
+  x[43] = tH;
+  x[44] = tI;
+  x[45] = tJ;
+  x[46] = tK;
+  x[47] = tL;
+  x[48] = tM;
+  x[49] = tN;
+  x[50] = tO;
+  x[51] = tP;
+  x[52] = tQ;
+  x[53] = tR;
+  x[54] = tS;
+  x[55] = tT;
+  x[56] = tU;
+  x[57] = tV;
+  x[58] = tW;
+  x[59] = tX;
+  x[60] = tY;
+  x[61] = tZ;
+  x[62] = t_;
+  x[63] = t;
+}
+
+/*Loads 8 columns from each of n rows, one row per vector.*/
+OD_SIMD_INLINE void od_mm256_load_rows(od_m256i *t, int n,
+ const od_coeff *x, int xstride) {
+  int k;
+  for (k = 0; k < n; k++) {
+    t[k] = od_mm256_loadu_si256((const od_m256i *)(x + k*xstride));
+  }
+}
+
+/*Stores n vectors, one row per vector.*/
+OD_SIMD_INLINE void od_mm256_store_rows(od_coeff *x, int xstride,
+ const od_m256i *t, int n) {
+  int k;
+  for (k = 0; k < n; k++) {
+    od_mm256_storeu_si256((od_m256i *)(x + k*xstride), t[k]);
+  }
+}
+
+/*Loads n columns from each of 8 rows, one column per vector.*/
+OD_SIMD_INLINE void od_mm256_load_cols(od_m256i *t, int n,
+ const od_coeff *x, int xstride) {
+  int k;
+  for (k = 0; k < n; k += 8) {
+    load8(x + k, xstride, t + k + 0, t + k + 1, t + k + 2, t + k + 3,
+     t + k + 4, t + k + 5, t + k + 6, t + k + 7);
+    od_mm256_transpose8(t + k + 0, t + k + 1, t + k + 2, t + k + 3,
+     t + k + 4, t + k + 5, t + k + 6, t + k + 7);
+  }
+}
+
+/*Stores n vectors as the columns of 8 rows.
+  This clobbers t.*/
+OD_SIMD_INLINE void od_mm256_store_cols(od_coeff *x, int xstride,
+ od_m256i *t, int n) {
+  int k;
+  for (k = 0; k < n; k += 8) {
+    od_mm256_transpose8(t + k + 0, t + k + 1, t + k + 2, t + k + 3,
+     t + k + 4, t + k + 5, t + k + 6, t + k + 7);
+    store8(x + k, xstride, t[k + 0], t[k + 1], t[k + 2], t[k + 3],
+     t[k + 4], t[k + 5], t[k + 6], t[k + 7]);
+  }
+}
+
+void od_bin_fdct16x16_x86(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride) {
+  OD_ALIGN16(od_coeff z[16*16]);
+  od_m256i t[16];
+  od_m256i u[16];
+  int i;
+#if defined(OD_CHECKASM)
+  od_coeff ref[16*16];
+  od_bin_fdct16x16(ref, 16, x, xstride);
+#endif
+  for (i = 0; i < 16; i += 8) {
+    od_mm256_load_rows(t, 16, x + i, xstride);
+    fdct16_kernel(u, t);
+    od_mm256_store_cols(z + 16*i, 16, u, 16);
+  }
+  for (i = 0; i < 16; i += 8) {
+    od_mm256_load_rows(t, 16, z + i, 16);
+    fdct16_kernel(u, t);
+    od_mm256_store_cols(y + ystride*i, ystride, u, 16);
+  }
+#if defined(OD_CHECKASM)
+  od_dct_check(2, ref, y, ystride);
+#endif
+}
+
+void od_bin_idct16x16_x86(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride) {
+  OD_ALIGN16(od_coeff z[16*16]);
+  od_m256i t[16];
+  od_m256i u[16];
+  int i;
+#if defined(OD_CHECKASM)
+  od_coeff ref[16*16];
+  od_bin_idct16x16(ref, 16, y, ystride);
+#endif
+  for (i = 0; i < 16; i += 8) {
+    od_mm256_load_cols(t, 16, y + ystride*i, ystride);
+    idct16_kernel(u, t);
+    od_mm256_store_rows(z + i, 16, u, 16);
+  }
+  for (i = 0; i < 16; i += 8) {
+    od_mm256_load_cols(t, 16, z + 16*i, 16);
+    idct16_kernel(u, t);
+    od_mm256_store_rows(x + i, xstride, u, 16);
+  }
+#if defined(OD_CHECKASM)
+  od_dct_check(2, ref, x, xstride);
+#endif
+}
+
+void od_bin_fdct32x32_x86(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride) {
+  OD_ALIGN16(od_coeff z[32*32]);
+  od_m256i t[32];
+  od_m256i u[32];
+  int i;
+#if defined(OD_CHECKASM)
+  od_coeff ref[32*32];
+  od_bin_fdct32x32(ref, 32, x, xstride);
+#endif
+  for (i = 0; i < 32; i += 8) {
+    od_mm256_load_rows(t, 32, x + i, xstride);
+    fdct32_kernel(u, t);
+    od_mm256_store_cols(z + 32*i, 32, u, 32);
+  }
+  for (i = 0; i < 32; i += 8) {
+    od_mm256_load_rows(t, 32, z + i, 32);
+    fdct32_kernel(u, t);
+    od_mm256_store_cols(y + ystride*i, ystride, u, 32);
+  }
+#if defined(OD_CHECKASM)
+  od_dct_check(3, ref, y, ystride);
+#endif
+}
+
+void od_bin_idct32x32_x86(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride) {
+  OD_ALIGN16(od_coeff z[32*32]);
+  od_m256i t[32];
+  od_m256i u[32];
+  int i;
+#if defined(OD_CHECKASM)
+  od_coeff ref[32*32];
+  od_bin_idct32x32(ref, 32, y, ystride);
+#endif
+  for (i = 0; i < 32; i += 8) {
+    od_mm256_load_cols(t, 32, y + ystride*i, ystride);
+    idct32_kernel(u, t);
+    od_mm256_store_rows(z + i, 32, u, 32);
+  }
+  for (i = 0; i < 32; i += 8) {
+    od_mm256_load_cols(t, 32, z + 32*i, 32);
+    idct32_kernel(u, t);
+    od_mm256_store_rows(x + i, xstride, u, 32);
+  }
+#if defined(OD_CHECKASM)
+  od_dct_check(3, ref, x, xstride);
+#endif
+}
+
+void od_bin_fdct64x64_x86(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride) {
+  OD_ALIGN16(od_coeff z[64*64]);
+  od_m256i t[64];
+  od_m256i u[64];
+  int i;
+#if defined(OD_CHECKASM)
+  od_coeff ref[64*64];
+  od_bin_fdct64x64(ref, 64, x, xstride);
+#endif
+  for (i = 0; i < 64; i += 8) {
+    od_mm256_load_rows(t, 64, x + i, xstride);
+    fdct64_kernel(u, t);
+    od_mm256_store_cols(z + 64*i, 64, u, 64);
+  }
+  for (i = 0; i < 64; i += 8) {
+    od_mm256_load_rows(t, 64, z + i, 64);
+    fdct64_kernel(u, t);
+    od_mm256_store_cols(y + ystride*i, ystride, u, 64);
+  }
+#if defined(OD_CHECKASM)
+  od_dct_check(4, ref, y, ystride);
+#endif
+}
+
+void od_bin_idct64x64_x86(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride) {
+  OD_ALIGN16(od_coeff z[64*64]);
+  od_m256i t[64];
+  od_m256i u[64];
+  int i;
+#if defined(OD_CHECKASM)
+  od_coeff ref[64*64];
+  od_bin_idct64x64(ref, 64, y, ystride);
+#endif
+  for (i = 0; i < 64; i += 8) {
+    od_mm256_load_cols(t, 64, y + ystride*i, ystride);
+    idct64_kernel(u, t);
+    od_mm256_store_rows(z + i, 64, u, 64);
+  }
+  for (i = 0; i < 64; i += 8) {
+    od_mm256_load_cols(t, 64, z + 64*i, 64);
+    idct64_kernel(u, t);
+    od_mm256_store_rows(x + i, xstride, u, 64);
+  }
+#if defined(OD_CHECKASM)
+  od_dct_check(4, ref, x, xstride);
+#endif
+}
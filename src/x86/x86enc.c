@@ -48,6 +48,44 @@ void od_enc_opt_vtbl_init_x86(od_enc_ctx *enc) {
      od_mc_compute_satd16_32x32_sse2;
     enc->opt_vtbl.mc_compute_satd_64x64 =
      od_mc_compute_satd16_64x64_sse2;
+#endif
+#if defined(OD_SSE41_INTRINSICS)
+    if (enc->state.cpu_flags & OD_CPU_X86_SSE4_1) {
+      enc->opt_vtbl.mc_compute_sad_4x4 =
+       od_mc_compute_sad16_4x4_sse41;
+      enc->opt_vtbl.mc_compute_sad_8x8 =
+       od_mc_compute_sad16_8x8_sse41;
+      enc->opt_vtbl.mc_compute_sad_16x16 =
+       od_mc_compute_sad16_16x16_sse41;
+      enc->opt_vtbl.mc_compute_sad_32x32 =
+       od_mc_compute_sad16_32x32_sse41;
+      enc->opt_vtbl.mc_compute_sad_64x64 =
+       od_mc_compute_sad16_64x64_sse41;
+    }
+#endif
+#if defined(OD_AVX2_INTRINSICS)
+    if (enc->state.cpu_flags & OD_CPU_X86_AVX2) {
+      enc->opt_vtbl.mc_compute_sad_4x4 =
+       od_mc_compute_sad16_4x4_avx2;
+      enc->opt_vtbl.mc_compute_sad_8x8 =
+       od_mc_compute_sad16_8x8_avx2;
+      enc->opt_vtbl.mc_compute_sad_16x16 =
+       od_mc_compute_sad16_16x16_avx2;
+      enc->opt_vtbl.mc_compute_sad_32x32 =
+       od_mc_compute_sad16_32x32_avx2;
+      enc->opt_vtbl.mc_compute_sad_64x64 =
+       od_mc_compute_sad16_64x64_avx2;
+      enc->opt_vtbl.mc_compute_satd_4x4 =
+       od_mc_compute_satd16_4x4_avx2;
+      enc->opt_vtbl.mc_compute_satd_8x8 =
+       od_mc_compute_satd16_8x8_avx2;
+      enc->opt_vtbl.mc_compute_satd_16x16 =
+       od_mc_compute_satd16_16x16_avx2;
+      enc->opt_vtbl.mc_compute_satd_32x32 =
+       od_mc_compute_satd16_32x32_avx2;
+      enc->opt_vtbl.mc_compute_satd_64x64 =
+       od_mc_compute_satd16_64x64_avx2;
+    }
 #endif
   }
   else {
@@ -82,7 +120,49 @@ void od_enc_opt_vtbl_init_x86(od_enc_ctx *enc) {
        od_mc_compute_satd8_64x64_sse2;
 #endif
     }
+#if defined(OD_AVX2_INTRINSICS)
+    if (enc->state.cpu_flags & OD_CPU_X86_AVX2) {
+      enc->opt_vtbl.mc_compute_sad_4x4 =
+       od_mc_compute_sad8_4x4_avx2;
+      enc->opt_vtbl.mc_compute_sad_8x8 =
+       od_mc_compute_sad8_8x8_avx2;
+      enc->opt_vtbl.mc_compute_sad_16x16 =
+       od_mc_compute_sad8_16x16_avx2;
+      enc->opt_vtbl.mc_compute_sad_32x32 =
+       od_mc_compute_sad8_32x32_avx2;
+      enc->opt_vtbl.mc_compute_sad_64x64 =
+       od_mc_compute_sad8_64x64_avx2;
+      enc->opt_vtbl.mc_compute_satd_4x4 =
+       od_mc_compute_satd8_4x4_avx2;
+      enc->opt_vtbl.mc_compute_satd_8x8 =
+       od_mc_compute_satd8_8x8_avx2;
+      enc->opt_vtbl.mc_compute_satd_16x16 =
+       od_mc_compute_satd8_16x16_avx2;
+      enc->opt_vtbl.mc_compute_satd_32x32 =
+       od_mc_compute_satd8_32x32_avx2;
+      enc->opt_vtbl.mc_compute_satd_64x64 =
+       od_mc_compute_satd8_64x64_avx2;
+    }
+#endif
   }
+#if defined(OD_SSE41_INTRINSICS)
+  if (enc->state.cpu_flags & OD_CPU_X86_SSE4_1) {
+    enc->opt_vtbl.pvq_search_max = od_pvq_search_max_sse41;
+    enc->opt_vtbl.compute_var_8x8 = od_compute_var_8x8_sse41;
+    enc->opt_vtbl.compute_dist_lp = od_compute_dist_lp_sse41;
+    enc->opt_vtbl.block_size.compute_stats = od_compute_stats_sse41;
+    enc->opt_vtbl.block_size.psy_log_sum = od_psy_log_sum_sse41;
+  }
+#endif
+#if defined(OD_AVX2_INTRINSICS)
+  if (enc->state.cpu_flags & OD_CPU_X86_AVX2) {
+    enc->opt_vtbl.pvq_search_max = od_pvq_search_max_avx2;
+    enc->opt_vtbl.compute_var_8x8 = od_compute_var_8x8_avx2;
+    enc->opt_vtbl.compute_dist_lp = od_compute_dist_lp_avx2;
+    enc->opt_vtbl.block_size.compute_stats = od_compute_stats_avx2;
+    enc->opt_vtbl.block_size.psy_log_sum = od_psy_log_sum_avx2;
+  }
+#endif
 }
 
 #endif
@@ -61,4 +61,90 @@ int32_t od_mc_compute_satd16_32x32_sse2(const unsigned char *src, int systride,
 int32_t od_mc_compute_satd16_64x64_sse2(const unsigned char *src, int systride,
  const unsigned char *ref, int dystride);
 
+int32_t od_mc_compute_sad16_4x4_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_8x8_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_16x16_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_32x32_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_64x64_sse41(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+
+int32_t od_mc_compute_sad8_4x4_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad8_8x8_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad8_16x16_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad8_32x32_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad8_64x64_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+
+int32_t od_mc_compute_sad16_4x4_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_8x8_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_16x16_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_32x32_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_sad16_64x64_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+
+int32_t od_mc_compute_satd8_4x4_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd8_8x8_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd8_16x16_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd8_32x32_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd8_64x64_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+
+int32_t od_mc_compute_satd16_4x4_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd16_8x8_avx2(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd16_16x16_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd16_32x32_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+int32_t od_mc_compute_satd16_64x64_avx2(const unsigned char *src,
+ int systride, const unsigned char *ref, int dystride);
+
+int od_pvq_search_max_sse41(const int32_t *x, const int32_t *y,
+ const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+ int shift, int n);
+int od_pvq_search_max_avx2(const int32_t *x, const int32_t *y,
+ const int32_t *rate, const int32_t *rsqrt, const int32_t *xy_rsqrt,
+ int shift, int n);
+
+void od_compute_var_8x8_sse41(int32_t var[9], const od_coeff *x,
+ int stride);
+void od_compute_dist_lp_sse41(double *lp_energy, const od_coeff *x,
+ const od_coeff *y, int n);
+void od_compute_var_8x8_avx2(int32_t var[9], const od_coeff *x, int stride);
+void od_compute_dist_lp_avx2(double *lp_energy, const od_coeff *x,
+ const od_coeff *y, int n);
+
+void od_compute_stats_sse41(const signed char *img, int stride,
+ od_superblock_stats *stats);
+int32_t od_psy_log_sum_sse41(const int32_t *inv_var, int stride, int n,
+ int32_t noise);
+void od_compute_stats_avx2(const signed char *img, int stride,
+ od_superblock_stats *stats);
+int32_t od_psy_log_sum_avx2(const int32_t *inv_var, int stride, int n,
+ int32_t noise);
+
+# if defined(OD_CHECKASM)
+void od_mc_compute_sad8_check(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride, int w, int h, int32_t sad);
+void od_mc_compute_sad16_check(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride, int w, int h, int32_t sad);
+# endif
+
 #endif
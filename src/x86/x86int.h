@@ -47,6 +47,24 @@ void od_mc_blend_full8_sse2(unsigned char *_dst,int _dystride,
  const unsigned char *_src[4],int _log_xblk_sz,int _log_yblk_sz);
 void od_mc_blend_full_split8_sse2(unsigned char *_dst,int _dystride,
  const unsigned char *_src[4],int _c,int _s,int _log_xblk_sz,int _log_yblk_sz);
+void od_mc_blend_full16_sse2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full_split16_sse2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz);
+void od_mc_predict1fmv8_avx2(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz);
+void od_mc_predict1fmv16_avx2(od_state *state, unsigned char *dst,
+ const unsigned char *src, int systride, int32_t mvx, int32_t mvy,
+ int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full8_avx2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full16_avx2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int log_xblk_sz, int log_yblk_sz);
+void od_mc_blend_full_split16_avx2(unsigned char *dst, int dystride,
+ const unsigned char *src[4], int oc, int s,
+ int log_xblk_sz, int log_yblk_sz);
 void od_bin_fdct4x4_sse2(od_coeff *y, int ystride,
  const od_coeff *x, int xstride);
 void od_bin_fdct4x4_sse41(od_coeff *y, int ystride,
@@ -67,12 +85,56 @@ void od_bin_fdct8x8_avx2(od_coeff *y, int ystride,
  const od_coeff *x, int xstride);
 void od_bin_idct8x8_avx2(od_coeff *x, int xstride,
  const od_coeff *y, int ystride);
+void od_bin_fdct16x16_sse2(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct16x16_sse2(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct32x32_sse2(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct32x32_sse2(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct64x64_sse2(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct64x64_sse2(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct16x16_sse41(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct16x16_sse41(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct32x32_sse41(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct32x32_sse41(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct64x64_sse41(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct64x64_sse41(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct16x16_avx2(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct16x16_avx2(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct32x32_avx2(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct32x32_avx2(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
+void od_bin_fdct64x64_avx2(od_coeff *y, int ystride,
+ const od_coeff *x, int xstride);
+void od_bin_idct64x64_avx2(od_coeff *x, int xstride,
+ const od_coeff *y, int ystride);
 void od_copy_16x16_8_sse2(unsigned char *_dst, int _dstride,
  const unsigned char *_src, int _sstride);
 void od_copy_32x32_8_sse2(unsigned char *_dst, int _dstride,
  const unsigned char *_src, int _sstride);
 void od_copy_64x64_8_sse2(unsigned char *_dst, int _dstride,
  const unsigned char *_src, int _sstride);
+void od_ref_buf_to_coeff8_sse2(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+void od_ref_buf_to_coeff16_sse2(od_coeff *dst, int dst_ystride,
+ const unsigned char *src, int src_ystride, int coeff_shift, int w, int h);
+void od_coeff_to_ref_buf8_sse2(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
+void od_coeff_to_ref_buf16_sse2(unsigned char *dst, int dst_ystride,
+ const od_coeff *src, int src_ystride, int coeff_shift, int w, int h);
 void od_filter_dering_direction_4x4_sse2(int16_t *y, int ystride,
  const int16_t *in, int threshold, int dir);
 void od_filter_dering_direction_8x8_sse2(int16_t *y, int ystride,
@@ -81,4 +143,12 @@ void od_filter_dering_orthogonal_4x4_sse2(int16_t *y, int ystride,
  const int16_t *in, const int16_t *x, int xstride, int threshold, int dir);
 void od_filter_dering_orthogonal_8x8_sse2(int16_t *y, int ystride,
  const int16_t *in, const int16_t *x, int xstride, int threshold, int dir);
+int od_dir_find8_sse41(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift);
+int od_dir_find8_avx2(const od_dering_in *img, int stride, int32_t *var,
+ int coeff_shift);
+void od_pre_filter_rows4_sse2(od_coeff *c, int stride, int n);
+void od_pre_filter_cols4_sse2(od_coeff *c, int stride, int n);
+void od_post_filter_rows4_sse2(od_coeff *c, int stride, int n);
+void od_post_filter_cols4_sse2(od_coeff *c, int stride, int n);
 #endif
@@ -45,6 +45,17 @@ void od_mc_compute_sad8_check(const unsigned char *src, int systride,
   }
   OD_ASSERT(sad == c_sad);
 }
+
+void od_mc_compute_sad16_check(const unsigned char *src, int systride,
+ const unsigned char *ref, int dystride, int w, int h, int32_t sad) {
+  int32_t c_sad;
+  c_sad = od_mc_compute_sad16_c(src, systride, ref, dystride, w, h);
+  if (sad != c_sad) {
+    fprintf(stderr, "od_mc_compute_sad16 %ix%i check failed: %i!=%i\n",
+     w, h, sad, c_sad);
+  }
+  OD_ASSERT(sad == c_sad);
+}
 # endif
 
 #if defined(OD_GCC_INLINE_ASSEMBLY)
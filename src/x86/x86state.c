@@ -44,8 +44,17 @@ void od_state_opt_vtbl_init_x86(od_state *_state){
     if (_state->cpu_flags&OD_CPU_X86_SSE2) {
 #if defined(OD_SSE2_INTRINSICS)
       _state->opt_vtbl.mc_predict1fmv = od_mc_predict1fmv16_sse2;
+      _state->opt_vtbl.mc_blend_full = od_mc_blend_full16_sse2;
+      _state->opt_vtbl.mc_blend_full_split = od_mc_blend_full_split16_sse2;
 #endif
     }
+#if defined(OD_AVX2_INTRINSICS)
+    if (_state->cpu_flags&OD_CPU_X86_AVX2) {
+      _state->opt_vtbl.mc_predict1fmv = od_mc_predict1fmv16_avx2;
+      _state->opt_vtbl.mc_blend_full = od_mc_blend_full16_avx2;
+      _state->opt_vtbl.mc_blend_full_split = od_mc_blend_full_split16_avx2;
+    }
+#endif
   }
   else {
     /*8 bit assembly for those functions that work directly on 8-bit
@@ -62,6 +71,14 @@ void od_state_opt_vtbl_init_x86(od_state *_state){
       _state->opt_vtbl.od_copy_nxn[6] = od_copy_64x64_8_sse2;
 #endif
     }
+#if defined(OD_AVX2_INTRINSICS)
+    if (_state->cpu_flags&OD_CPU_X86_AVX2) {
+      _state->opt_vtbl.mc_predict1fmv = od_mc_predict1fmv8_avx2;
+      _state->opt_vtbl.mc_blend_full = od_mc_blend_full8_avx2;
+      /*The inline assembly version of mc_blend_full_split is kept, since it
+         is as fast as the intrinsics can make it.*/
+    }
+#endif
   }
   if (_state->cpu_flags&OD_CPU_X86_SSE2) {
 #if defined(OD_SSE2_INTRINSICS)
@@ -69,10 +86,26 @@ void od_state_opt_vtbl_init_x86(od_state *_state){
     _state->opt_vtbl.idct_2d[0] = od_bin_idct4x4_sse2;
     _state->opt_vtbl.fdct_2d[1] = od_bin_fdct8x8_sse2;
     _state->opt_vtbl.idct_2d[1] = od_bin_idct8x8_sse2;
+    _state->opt_vtbl.fdct_2d[2] = od_bin_fdct16x16_sse2;
+    _state->opt_vtbl.idct_2d[2] = od_bin_idct16x16_sse2;
+    _state->opt_vtbl.fdct_2d[3] = od_bin_fdct32x32_sse2;
+    _state->opt_vtbl.idct_2d[3] = od_bin_idct32x32_sse2;
+    _state->opt_vtbl.fdct_2d[4] = od_bin_fdct64x64_sse2;
+    _state->opt_vtbl.idct_2d[4] = od_bin_idct64x64_sse2;
+    _state->opt_vtbl.ref_buf_to_coeff8 = od_ref_buf_to_coeff8_sse2;
+    _state->opt_vtbl.ref_buf_to_coeff16 = od_ref_buf_to_coeff16_sse2;
+    _state->opt_vtbl.coeff_to_ref_buf8 = od_coeff_to_ref_buf8_sse2;
+    _state->opt_vtbl.coeff_to_ref_buf16 = od_coeff_to_ref_buf16_sse2;
     OD_COPY(_state->opt_vtbl.dering.filter_dering_direction,
      OD_DERING_DIRECTION_SSE2, OD_DERINGSIZES);
     OD_COPY(_state->opt_vtbl.dering.filter_dering_orthogonal,
      OD_DERING_ORTHOGONAL_SSE2, OD_DERINGSIZES);
+# if !OD_DISABLE_FILTER
+    _state->opt_vtbl.filter.pre_filter_rows[0] = od_pre_filter_rows4_sse2;
+    _state->opt_vtbl.filter.pre_filter_cols[0] = od_pre_filter_cols4_sse2;
+    _state->opt_vtbl.filter.post_filter_rows[0] = od_post_filter_rows4_sse2;
+    _state->opt_vtbl.filter.post_filter_cols[0] = od_post_filter_cols4_sse2;
+# endif
 #endif
 #if defined(OD_SSE41_INTRINSICS)
     if (_state->cpu_flags&OD_CPU_X86_SSE4_1) {
@@ -80,12 +113,26 @@ void od_state_opt_vtbl_init_x86(od_state *_state){
       _state->opt_vtbl.idct_2d[0] = od_bin_idct4x4_sse41;
       _state->opt_vtbl.fdct_2d[1] = od_bin_fdct8x8_sse41;
       _state->opt_vtbl.idct_2d[1] = od_bin_idct8x8_sse41;
+      _state->opt_vtbl.fdct_2d[2] = od_bin_fdct16x16_sse41;
+      _state->opt_vtbl.idct_2d[2] = od_bin_idct16x16_sse41;
+      _state->opt_vtbl.fdct_2d[3] = od_bin_fdct32x32_sse41;
+      _state->opt_vtbl.idct_2d[3] = od_bin_idct32x32_sse41;
+      _state->opt_vtbl.fdct_2d[4] = od_bin_fdct64x64_sse41;
+      _state->opt_vtbl.idct_2d[4] = od_bin_idct64x64_sse41;
+      _state->opt_vtbl.dering.dir_find8 = od_dir_find8_sse41;
     }
 #endif
 #if defined(OD_AVX2_INTRINSICS)
     if (_state->cpu_flags & OD_CPU_X86_AVX2) {
       _state->opt_vtbl.fdct_2d[1] = od_bin_fdct8x8_avx2;
       _state->opt_vtbl.idct_2d[1] = od_bin_idct8x8_avx2;
+      _state->opt_vtbl.fdct_2d[2] = od_bin_fdct16x16_avx2;
+      _state->opt_vtbl.idct_2d[2] = od_bin_idct16x16_avx2;
+      _state->opt_vtbl.fdct_2d[3] = od_bin_fdct32x32_avx2;
+      _state->opt_vtbl.idct_2d[3] = od_bin_idct32x32_avx2;
+      _state->opt_vtbl.fdct_2d[4] = od_bin_fdct64x64_avx2;
+      _state->opt_vtbl.idct_2d[4] = od_bin_idct64x64_avx2;
+      _state->opt_vtbl.dering.dir_find8 = od_dir_find8_avx2;
     }
 #endif
   }